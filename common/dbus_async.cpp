@@ -0,0 +1,365 @@
+#include "dbus_async.hpp"
+
+#include <phosphor-logging/lg2.hpp>
+
+#include <algorithm>
+#include <exception>
+#include <memory>
+#include <utility>
+
+PHOSPHOR_LOG2_USING;
+
+namespace pldm
+{
+namespace utils
+{
+
+namespace
+{
+
+/** @brief Invoke a callback, an exception thrown by the callback is logged and
+ *         must not unwind into sd-bus
+ */
+template <typename Callback, typename... Args>
+void invoke(Callback& callback, Args&&... args)
+{
+    try
+    {
+        callback(std::forward<Args>(args)...);
+    }
+    catch (const std::exception& e)
+    {
+        error("D-Bus reply handler failed, ERROR={ERR_EXCEP}", "ERR_EXCEP",
+              e.what());
+    }
+}
+
+std::string serviceKey(const std::string& path, const std::string& interface)
+{
+    return path + '\0' + interface;
+}
+
+std::string propertyKey(const DBusMapping& dBusMap)
+{
+    return serviceKey(dBusMap.objectPath, dBusMap.interface) + '\0' +
+           dBusMap.propertyName;
+}
+
+} // namespace
+
+AsyncDBus& AsyncDBus::get()
+{
+    static AsyncDBus client(DBusHandler::getBus(), DBUS_MAX_CONCURRENT_CALLS);
+    return client;
+}
+
+void AsyncDBus::call(sdbusplus::message_t&& method, ReplyCallback callback)
+{
+    if (inFlight >= maxInFlight)
+    {
+        ++stats.queued;
+    }
+    queue.emplace_back(std::move(method), std::move(callback));
+    pump();
+}
+
+void AsyncDBus::pump()
+{
+    while (inFlight < maxInFlight && !queue.empty())
+    {
+        auto [method, callback] = std::move(queue.front());
+        queue.pop_front();
+
+        auto pending = std::make_unique<Call>(
+            Call{this, std::move(callback), Clock::now()});
+        ++stats.calls;
+        auto rc = sd_bus_call_async(bus.get(), nullptr, method.get(),
+                                    &AsyncDBus::onReply, pending.get(),
+                                    dbusTimeout);
+        if (rc < 0)
+        {
+            error("Failed to send a D-Bus call, ERROR={ERR}", "ERR", -rc);
+            ++stats.errors;
+            invoke(pending->callback, nullptr);
+            continue;
+        }
+
+        // sd-bus owns the call until its reply handler runs
+        pending.release();
+        ++inFlight;
+        stats.maxInFlightSeen = std::max(stats.maxInFlightSeen, inFlight);
+    }
+}
+
+int AsyncDBus::onReply(sd_bus_message* m, void* userdata,
+                       sd_bus_error* /*retError*/)
+{
+    std::unique_ptr<Call> pending(static_cast<Call*>(userdata));
+    auto& client = *pending->client;
+    --client.inFlight;
+    client.record(Clock::now() - pending->start);
+
+    sdbusplus::message_t reply(m);
+    auto callError = sd_bus_message_get_error(m);
+    if (callError)
+    {
+        ++client.stats.errors;
+        if (sd_bus_error_has_name(callError, SD_BUS_ERROR_NO_REPLY) ||
+            sd_bus_error_has_name(callError, SD_BUS_ERROR_TIMEOUT))
+        {
+            ++client.stats.timeouts;
+        }
+        invoke(pending->callback, nullptr);
+    }
+    else
+    {
+        invoke(pending->callback, &reply);
+    }
+
+    client.pump();
+    return 0;
+}
+
+void AsyncDBus::record(Clock::duration latency)
+{
+    auto ms = static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::milliseconds>(latency).count());
+    auto bucket = std::lower_bound(latencyBuckets.begin(),
+                                   latencyBuckets.end(), ms) -
+                  latencyBuckets.begin();
+    ++stats.latency[bucket];
+}
+
+void AsyncDBus::getService(const std::string& path,
+                           const std::string& interface,
+                           ServiceCallback callback)
+{
+    auto key = serviceKey(path, interface);
+    auto cached = services.find(key);
+    if (cached != services.end())
+    {
+        ++stats.cacheHits;
+        invoke(callback, cached->second);
+        return;
+    }
+
+    auto [waiters, first] = serviceWaiters.try_emplace(key);
+    waiters->second.push_back(std::move(callback));
+    if (!first)
+    {
+        ++stats.shared;
+        return;
+    }
+
+    auto method = bus.new_method_call(mapperService, mapperPath,
+                                      mapperInterface, "GetObject");
+    method.append(path, std::vector<std::string>({interface}));
+    call(std::move(method), [this, key](sdbusplus::message_t* reply) {
+        std::optional<std::string> service;
+        if (reply)
+        {
+            try
+            {
+                std::map<std::string, std::vector<std::string>> response;
+                reply->read(response);
+                if (!response.empty())
+                {
+                    service = response.begin()->first;
+                }
+            }
+            catch (const std::exception& e)
+            {
+                error("Failed to read the mapper response, ERROR={ERR_EXCEP}",
+                      "ERR_EXCEP", e.what());
+            }
+        }
+        if (service)
+        {
+            services.emplace(key, *service);
+        }
+
+        auto search = serviceWaiters.find(key);
+        auto waiting = std::move(search->second);
+        serviceWaiters.erase(search);
+        for (auto& waiter : waiting)
+        {
+            invoke(waiter, service);
+        }
+    });
+}
+
+void AsyncDBus::getProperty(const DBusMapping& dBusMap,
+                            PropertyCallback callback)
+{
+    auto key = propertyKey(dBusMap);
+    auto shared = sharedReads.find(key);
+    if (shared != sharedReads.end())
+    {
+        ++stats.shared;
+        propertyReads[shared->second].push_back(std::move(callback));
+        return;
+    }
+
+    auto id = nextReadId++;
+    sharedReads.emplace(key, id);
+    propertyReads[id].push_back(std::move(callback));
+
+    getService(dBusMap.objectPath, dBusMap.interface,
+               [this, key, id, dBusMap](std::optional<std::string> service) {
+        if (!service)
+        {
+            finishProperty(key, id, std::nullopt);
+            return;
+        }
+
+        try
+        {
+            auto method = bus.new_method_call(service->c_str(),
+                                              dBusMap.objectPath.c_str(),
+                                              dbusProperties, "Get");
+            method.append(dBusMap.interface, dBusMap.propertyName);
+            call(std::move(method), [this, key, id,
+                                     dBusMap](sdbusplus::message_t* reply) {
+                std::optional<PropertyValue> value;
+                if (reply)
+                {
+                    try
+                    {
+                        PropertyValue propertyValue;
+                        reply->read(propertyValue);
+                        value = std::move(propertyValue);
+                    }
+                    catch (const std::exception& e)
+                    {
+                        error(
+                            "Failed to read the property {PROPERTY} of {PATH}, ERROR={ERR_EXCEP}",
+                            "PROPERTY", dBusMap.propertyName, "PATH",
+                            dBusMap.objectPath, "ERR_EXCEP", e.what());
+                    }
+                }
+                else
+                {
+                    // The service may have restarted under another name
+                    services.erase(
+                        serviceKey(dBusMap.objectPath, dBusMap.interface));
+                }
+                finishProperty(key, id, std::move(value));
+            });
+        }
+        catch (const std::exception& e)
+        {
+            error("Failed to create the Get call of {PATH}, ERROR={ERR_EXCEP}",
+                  "PATH", dBusMap.objectPath, "ERR_EXCEP", e.what());
+            finishProperty(key, id, std::nullopt);
+        }
+    });
+}
+
+void AsyncDBus::finishProperty(const std::string& key, uint64_t id,
+                               std::optional<PropertyValue>&& value)
+{
+    auto shared = sharedReads.find(key);
+    if (shared != sharedReads.end() && shared->second == id)
+    {
+        sharedReads.erase(shared);
+    }
+
+    auto search = propertyReads.find(id);
+    if (search == propertyReads.end())
+    {
+        return;
+    }
+    auto waiting = std::move(search->second);
+    propertyReads.erase(search);
+    for (auto& waiter : waiting)
+    {
+        invoke(waiter, value);
+    }
+}
+
+void AsyncDBus::getProperties(const std::vector<DBusMapping>& dBusMaps,
+                              PropertiesCallback callback)
+{
+    if (dBusMaps.empty())
+    {
+        invoke(callback, std::vector<std::optional<PropertyValue>>{});
+        return;
+    }
+
+    struct Batch
+    {
+        std::vector<std::optional<PropertyValue>> values;
+        size_t remaining;
+        PropertiesCallback callback;
+    };
+    auto batch = std::make_shared<Batch>(
+        Batch{std::vector<std::optional<PropertyValue>>(dBusMaps.size()),
+              dBusMaps.size(), std::move(callback)});
+
+    // The reads are queued in one go and go out on the next iteration of the
+    // event loop, their replies are awaited together
+    for (size_t index = 0; index < dBusMaps.size(); ++index)
+    {
+        getProperty(dBusMaps[index],
+                    [batch, index](std::optional<PropertyValue> value) {
+            batch->values[index] = std::move(value);
+            if (--batch->remaining == 0)
+            {
+                invoke(batch->callback, std::move(batch->values));
+            }
+        });
+    }
+}
+
+void AsyncDBus::setProperty(const DBusMapping& dBusMap,
+                            const PropertyValue& value, SetCallback callback)
+{
+    // A read in flight may return the value from before the set, the reads
+    // requested from now on are sent after the set
+    sharedReads.erase(propertyKey(dBusMap));
+
+    getService(dBusMap.objectPath, dBusMap.interface,
+               [this, dBusMap, value, callback = std::move(callback)](
+                   std::optional<std::string> service) mutable {
+        std::optional<sdbusplus::message_t> method;
+        if (service)
+        {
+            try
+            {
+                method = makeSetPropertyCall(bus, *service, dBusMap, value);
+            }
+            catch (const std::exception& e)
+            {
+                error(
+                    "Failed to create the Set call of {PROPERTY} of {PATH}, ERROR={ERR_EXCEP}",
+                    "PROPERTY", dBusMap.propertyName, "PATH",
+                    dBusMap.objectPath, "ERR_EXCEP", e.what());
+            }
+        }
+        if (!method)
+        {
+            if (callback)
+            {
+                invoke(callback, false);
+            }
+            return;
+        }
+
+        call(std::move(*method),
+             [this, dBusMap,
+              callback = std::move(callback)](sdbusplus::message_t* reply) {
+            if (!reply)
+            {
+                services.erase(
+                    serviceKey(dBusMap.objectPath, dBusMap.interface));
+            }
+            if (callback)
+            {
+                invoke(callback, reply != nullptr);
+            }
+        });
+    });
+}
+
+} // namespace utils
+} // namespace pldm
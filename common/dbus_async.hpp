@@ -0,0 +1,213 @@
+#pragma once
+
+#include "utils.hpp"
+
+#include <systemd/sd-bus.h>
+
+#include <sdbusplus/bus.hpp>
+#include <sdbusplus/message.hpp>
+
+#include <array>
+#include <chrono>
+#include <deque>
+#include <functional>
+#include <map>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace pldm
+{
+namespace utils
+{
+
+/** @class AsyncDBus
+ *
+ *  @brief Non-blocking D-Bus client of pldmd. The calls are sent with
+ *         sd_bus_call_async and their replies are handled on the event loop
+ *         the bus is attached to, so a slow D-Bus service only delays the
+ *         requests that wait for it instead of the whole PLDM stack.
+ *
+ *         At most maxInFlight calls are outstanding, the others are queued in
+ *         order. The mapper lookups and the property reads already in flight
+ *         are shared by the identical requests, and the services found by the
+ *         mapper are cached until a call to them fails. A property set through
+ *         the client is not followed by a read of the value from before it:
+ *         the later reads do not share the reads already in flight.
+ *
+ *         A callback may be invoked before the request returns, when the
+ *         result is cached.
+ */
+class AsyncDBus
+{
+  public:
+    using Clock = std::chrono::steady_clock;
+
+    /** @brief Handles the reply of a call, nullptr if the call failed */
+    using ReplyCallback = std::function<void(sdbusplus::message_t* reply)>;
+
+    /** @brief Handles a service name, nullopt if the lookup failed */
+    using ServiceCallback =
+        std::function<void(std::optional<std::string> service)>;
+
+    /** @brief Handles the property values of a batch, in the order of the
+     *         request
+     */
+    using PropertiesCallback =
+        std::function<void(std::vector<std::optional<PropertyValue>> values)>;
+
+    /** @brief Upper bounds in milliseconds of the latency histogram buckets,
+     *         the last bucket holds the slower calls
+     */
+    static constexpr std::array<uint32_t, 10> latencyBuckets = {
+        1, 2, 5, 10, 20, 50, 100, 500, 1000, 5000};
+
+    /** @struct Stats
+     *
+     *  Counters of the D-Bus calls
+     */
+    struct Stats
+    {
+        uint64_t calls = 0;         //!< calls sent
+        uint64_t errors = 0;        //!< calls that failed, timeouts included
+        uint64_t timeouts = 0;      //!< calls without a reply in time
+        uint64_t queued = 0;        //!< calls that waited for a free slot
+        uint64_t shared = 0;        //!< requests served by a call in flight
+        uint64_t cacheHits = 0;     //!< mapper lookups served from the cache
+        size_t maxInFlightSeen = 0; //!< most calls outstanding at once
+
+        /** @brief number of calls per latency bucket */
+        std::array<uint64_t, latencyBuckets.size() + 1> latency{};
+    };
+
+    AsyncDBus() = delete;
+    AsyncDBus(const AsyncDBus&) = delete;
+    AsyncDBus(AsyncDBus&&) = delete;
+    AsyncDBus& operator=(const AsyncDBus&) = delete;
+    AsyncDBus& operator=(AsyncDBus&&) = delete;
+    ~AsyncDBus() = default;
+
+    /** @brief Constructor
+     *
+     *  @param[in] bus - D-Bus connection, attached to the event loop
+     *  @param[in] maxInFlight - maximum number of outstanding calls
+     */
+    explicit AsyncDBus(sdbusplus::bus_t& bus, size_t maxInFlight) :
+        bus(bus), maxInFlight(maxInFlight)
+    {}
+
+    /** @brief Get the client of the pldmd D-Bus connection */
+    static AsyncDBus& get();
+
+    /** @brief Send a method call
+     *
+     *  @param[in] method - method call
+     *  @param[in] callback - handles the reply
+     */
+    void call(sdbusplus::message_t&& method, ReplyCallback callback);
+
+    /** @brief Get the service of an object from the mapper
+     *
+     *  @param[in] path - D-Bus object path
+     *  @param[in] interface - D-Bus interface
+     *  @param[in] callback - handles the service name
+     */
+    void getService(const std::string& path, const std::string& interface,
+                    ServiceCallback callback);
+
+    /** @brief Get a property
+     *
+     *  @param[in] dBusMap - object path, interface and property name
+     *  @param[in] callback - handles the property value
+     */
+    void getProperty(const DBusMapping& dBusMap, PropertyCallback callback);
+
+    /** @brief Get a batch of properties, the calls are sent together
+     *
+     *  @param[in] dBusMaps - object paths, interfaces and property names
+     *  @param[in] callback - handles the values once all the reads are done
+     */
+    void getProperties(const std::vector<DBusMapping>& dBusMaps,
+                       PropertiesCallback callback);
+
+    /** @brief Set a property, like DBusHandler::setDbusProperty
+     *
+     *  @param[in] dBusMap - object path, interface, property name and type
+     *  @param[in] value - value to set
+     *  @param[in] callback - handles the result, may be empty
+     */
+    void setProperty(const DBusMapping& dBusMap, const PropertyValue& value,
+                     SetCallback callback);
+
+    /** @brief Counters of the D-Bus calls */
+    const Stats& getStats() const
+    {
+        return stats;
+    }
+
+    /** @brief Number of outstanding calls */
+    size_t inFlightCalls() const
+    {
+        return inFlight;
+    }
+
+  private:
+    /** @struct Call
+     *
+     *  An outstanding method call
+     */
+    struct Call
+    {
+        AsyncDBus* client;
+        ReplyCallback callback;
+        Clock::time_point start;
+    };
+
+    /** @brief sd-bus reply handler of the outstanding calls */
+    static int onReply(sd_bus_message* m, void* userdata,
+                       sd_bus_error* retError);
+
+    /** @brief Send the queued calls while there are free slots */
+    void pump();
+
+    /** @brief Count a call in the latency histogram */
+    void record(Clock::duration latency);
+
+    /** @brief Hand a property value to the requests waiting for a read
+     *
+     *  @param[in] key - property of the read
+     *  @param[in] id - read ID
+     *  @param[in] value - property value, nullopt if the read failed
+     */
+    void finishProperty(const std::string& key, uint64_t id,
+                        std::optional<PropertyValue>&& value);
+
+    sdbusplus::bus_t& bus;
+    size_t maxInFlight;
+    size_t inFlight = 0;
+
+    /** @brief calls waiting for a free slot */
+    std::deque<std::pair<sdbusplus::message_t, ReplyCallback>> queue;
+
+    /** @brief services found by the mapper, by object path and interface */
+    std::map<std::string, std::string> services;
+
+    /** @brief requests waiting for a mapper lookup in flight */
+    std::map<std::string, std::vector<ServiceCallback>> serviceWaiters;
+
+    /** @brief requests waiting for a property read in flight, by read ID */
+    std::map<uint64_t, std::vector<PropertyCallback>> propertyReads;
+
+    /** @brief read in flight that later requests for a property share, by
+     *         object path, interface and property name
+     */
+    std::map<std::string, uint64_t> sharedReads;
+
+    /** @brief ID of the next property read */
+    uint64_t nextReadId = 0;
+
+    Stats stats;
+};
+
+} // namespace utils
+} // namespace pldm
@@ -0,0 +1,111 @@
+#include "json_cache.hpp"
+
+#include <phosphor-logging/lg2.hpp>
+
+#include <fstream>
+#include <utility>
+#include <vector>
+
+PHOSPHOR_LOG2_USING;
+
+namespace pldm
+{
+namespace utils
+{
+
+namespace
+{
+
+std::string key(const fs::path& path)
+{
+    return path.lexically_normal().string();
+}
+
+} // namespace
+
+JsonCache& JsonCache::get()
+{
+    static JsonCache cache;
+    return cache;
+}
+
+Json JsonCache::parseFile(const fs::path& path)
+{
+    std::ifstream file(path);
+    if (!file.is_open())
+    {
+        return Json::parse("", nullptr, false);
+    }
+    return Json::parse(file, nullptr, false);
+}
+
+size_t JsonCache::prefetch(const fs::path& path)
+{
+    std::error_code ec;
+    std::vector<fs::path> files;
+    if (fs::is_directory(path, ec))
+    {
+        for (auto it = fs::directory_iterator(path, ec);
+             !ec && it != fs::directory_iterator(); it.increment(ec))
+        {
+            if (it->is_regular_file(ec) && it->path().extension() == ".json")
+            {
+                files.push_back(it->path());
+            }
+        }
+    }
+    else if (fs::is_regular_file(path, ec))
+    {
+        files.push_back(path);
+    }
+
+    size_t count = 0;
+    for (const auto& file : files)
+    {
+        auto document = parseFile(file);
+        if (document.is_discarded())
+        {
+            continue;
+        }
+        std::lock_guard<std::mutex> guard(lock);
+        documents.insert_or_assign(key(file), std::move(document));
+        ++count;
+    }
+    return count;
+}
+
+std::optional<Json> JsonCache::take(const fs::path& path)
+{
+    std::lock_guard<std::mutex> guard(lock);
+    auto document = documents.find(key(path));
+    if (document == documents.end())
+    {
+        return std::nullopt;
+    }
+    auto result = std::move(document->second);
+    documents.erase(document);
+    return result;
+}
+
+Json JsonCache::parse(const fs::path& path)
+{
+    if (auto document = take(path))
+    {
+        return std::move(*document);
+    }
+    return parseFile(path);
+}
+
+void JsonCache::clear()
+{
+    std::lock_guard<std::mutex> guard(lock);
+    if (!documents.empty())
+    {
+        info("Dropping {COUNT} unused JSON documents", "COUNT",
+             documents.size());
+    }
+    documents.clear();
+}
+
+} // namespace utils
+} // namespace pldm
@@ -0,0 +1,82 @@
+#pragma once
+
+#include <nlohmann/json.hpp>
+
+#include <filesystem>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+
+namespace pldm
+{
+namespace utils
+{
+
+namespace fs = std::filesystem;
+using Json = nlohmann::json;
+
+/** @class JsonCache
+ *
+ *  @brief JSON configuration files parsed ahead of their use. pldmd parses
+ *         its configuration directories on the startup worker threads while
+ *         the main thread sets up D-Bus, the handlers then take the parsed
+ *         documents instead of reading the files again.
+ *
+ *         A document is handed out once, a second parse of the same file reads
+ *         it from the disk. The cache may be used from any thread.
+ */
+class JsonCache
+{
+  public:
+    JsonCache(const JsonCache&) = delete;
+    JsonCache(JsonCache&&) = delete;
+    JsonCache& operator=(const JsonCache&) = delete;
+    JsonCache& operator=(JsonCache&&) = delete;
+
+    /** @brief The JSON cache of the process */
+    static JsonCache& get();
+
+    /** @brief Parse a JSON file, or the *.json files of a directory, into
+     *         the cache. The files that fail to parse are left out, their
+     *         users report the error when they read them.
+     *
+     *  @param[in] path - JSON file or directory
+     *
+     *  @return number of documents cached
+     */
+    size_t prefetch(const fs::path& path);
+
+    /** @brief Take a cached document
+     *
+     *  @param[in] path - path of the JSON file
+     *
+     *  @return the document, std::nullopt if it is not cached
+     */
+    std::optional<Json> take(const fs::path& path);
+
+    /** @brief Take a cached document or parse the file, like
+     *         Json::parse(file, nullptr, false)
+     *
+     *  @param[in] path - path of the JSON file
+     *
+     *  @return the document, discarded if the file is missing or malformed
+     */
+    Json parse(const fs::path& path);
+
+    /** @brief Drop the documents not taken */
+    void clear();
+
+  private:
+    JsonCache() = default;
+    ~JsonCache() = default;
+
+    /** @brief Parse a file, with the lock released */
+    static Json parseFile(const fs::path& path);
+
+    std::mutex lock;
+    std::unordered_map<std::string, Json> documents;
+};
+
+} // namespace utils
+} // namespace pldm
@@ -0,0 +1,108 @@
+#include "state_pdr_index.hpp"
+
+#include "libpldm/platform.h"
+
+namespace pldm
+{
+namespace utils
+{
+
+namespace
+{
+const StatePdrIndex::Pdrs noPdrs{};
+} // namespace
+
+StatePdrIndex::StatePdrIndex(const pldm_pdr* repo,
+                             std::function<void()> onChange) :
+    repo(repo),
+    onChange(std::move(onChange)),
+    watch([this](PdrRepoChange) { changed(); })
+{}
+
+const StatePdrIndex::Pdrs&
+    StatePdrIndex::lookup(uint8_t pdrType, uint16_t entityType,
+                          uint16_t stateSetId)
+{
+    if (!built)
+    {
+        build(PLDM_STATE_EFFECTER_PDR, effecters);
+        build(PLDM_STATE_SENSOR_PDR, sensors);
+        built = true;
+    }
+
+    const auto& index = pdrType == PLDM_STATE_EFFECTER_PDR ? effecters
+                                                           : sensors;
+    auto search = index.find({entityType, stateSetId});
+    return search == index.end() ? noPdrs : search->second;
+}
+
+void StatePdrIndex::changed()
+{
+    effecters.clear();
+    sensors.clear();
+    built = false;
+    ++changes;
+    if (onChange)
+    {
+        onChange();
+    }
+}
+
+void StatePdrIndex::build(uint8_t pdrType, Index& index)
+{
+    uint8_t* outData = nullptr;
+    uint32_t size{};
+    const pldm_pdr_record* record{};
+    do
+    {
+        record = pldm_pdr_find_record_by_type(repo, pdrType, record, &outData,
+                                              &size);
+        if (!record)
+        {
+            break;
+        }
+
+        // The state effecter and state sensor PDRs share the layout up to
+        // the composite count and the possible states
+        uint16_t entityType{};
+        uint8_t compositeCount{};
+        const uint8_t* possibleStatesStart{};
+        if (pdrType == PLDM_STATE_EFFECTER_PDR)
+        {
+            auto pdr = reinterpret_cast<pldm_state_effecter_pdr*>(outData);
+            entityType = pdr->entity_type;
+            compositeCount = pdr->composite_effecter_count;
+            possibleStatesStart = pdr->possible_states;
+        }
+        else
+        {
+            auto pdr = reinterpret_cast<pldm_state_sensor_pdr*>(outData);
+            entityType = pdr->entity_type;
+            compositeCount = pdr->composite_sensor_count;
+            possibleStatesStart = pdr->possible_states;
+        }
+
+        std::span<const uint8_t> pdrData(outData, size);
+        for (auto count = 0; count < compositeCount; ++count)
+        {
+            auto possibleStates =
+                reinterpret_cast<const state_effecter_possible_states*>(
+                    possibleStatesStart);
+            auto setId = possibleStates->state_set_id;
+            auto possibleStateSize = possibleStates->possible_states_size;
+
+            // A PDR is listed once per state set, even if several of its
+            // composite entries use the same state set
+            auto& pdrs = index[{entityType, setId}];
+            if (pdrs.empty() || pdrs.back().data() != pdrData.data())
+            {
+                pdrs.push_back(pdrData);
+            }
+            possibleStatesStart += possibleStateSize + sizeof(setId) +
+                                   sizeof(possibleStateSize);
+        }
+    } while (record);
+}
+
+} // namespace utils
+} // namespace pldm
@@ -0,0 +1,101 @@
+#pragma once
+
+#include "libpldm/pdr.h"
+
+#include "utils.hpp"
+
+#include <stdint.h>
+
+#include <functional>
+#include <map>
+#include <span>
+#include <utility>
+#include <vector>
+
+namespace pldm
+{
+namespace utils
+{
+
+/** @class StatePdrIndex
+ *
+ *  @brief Index of the state effecter and state sensor PDRs of the BMC's
+ *         primary PDR repository by entity type and state set. The index
+ *         points at the record data of the repository: it is dropped as soon
+ *         as a change of the repository is recorded by pdrRepoChanged(), and
+ *         built again on the next lookup.
+ */
+class StatePdrIndex
+{
+  public:
+    using Pdrs = std::vector<std::span<const uint8_t>>;
+
+    StatePdrIndex() = delete;
+    StatePdrIndex(const StatePdrIndex&) = delete;
+    StatePdrIndex& operator=(const StatePdrIndex&) = delete;
+    StatePdrIndex(StatePdrIndex&&) = delete;
+    StatePdrIndex& operator=(StatePdrIndex&&) = delete;
+    ~StatePdrIndex() = default;
+
+    /** @brief Constructor
+     *
+     *  @param[in] repo - BMC's primary PDR repository
+     *  @param[in] onChange - run after each change of the repository, once
+     *                        the change number is incremented
+     */
+    explicit StatePdrIndex(const pldm_pdr* repo,
+                           std::function<void()> onChange = {});
+
+    /** @brief Lookup the PDRs of a type, entity type and state set
+     *
+     *  @param[in] pdrType - PLDM_STATE_EFFECTER_PDR or PLDM_STATE_SENSOR_PDR
+     *  @param[in] entityType - entity type
+     *  @param[in] stateSetId - state set ID
+     *
+     *  @return the PDRs, in repository order, valid until the repository
+     *          changes
+     */
+    const Pdrs& lookup(uint8_t pdrType, uint16_t entityType,
+                       uint16_t stateSetId);
+
+    /** @brief Number of changes of the repository since the index was
+     *         created, lookup results stay the same while it does
+     */
+    uint64_t changeNumber() const
+    {
+        return changes;
+    }
+
+  private:
+    using Key = std::pair<uint16_t, uint16_t>;
+    using Index = std::map<Key, Pdrs>;
+
+    /** @brief Index the PDRs of a type
+     *  @param[in] pdrType - PLDM_STATE_EFFECTER_PDR or PLDM_STATE_SENSOR_PDR
+     *  @param[out] index - index to fill
+     */
+    void build(uint8_t pdrType, Index& index);
+
+    /** @brief Drop the indexes on a change of the repository */
+    void changed();
+
+    const pldm_pdr* repo;
+    std::function<void()> onChange;
+
+    /** @brief state effecter and state sensor PDRs by entity type and state
+     *         set
+     */
+    Index effecters;
+    Index sensors;
+
+    /** @brief true if the indexes match the repository */
+    bool built = false;
+
+    /** @brief number of changes of the repository */
+    uint64_t changes = 0;
+
+    PdrRepoWatch watch;
+};
+
+} // namespace utils
+} // namespace pldm
@@ -0,0 +1,345 @@
+#include "common/dbus_async.hpp"
+
+#include <sys/socket.h>
+#include <systemd/sd-bus.h>
+#include <systemd/sd-event.h>
+#include <unistd.h>
+
+#include <sdbusplus/bus.hpp>
+
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <numeric>
+#include <optional>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using namespace pldm::utils;
+using namespace std::chrono_literals;
+
+namespace
+{
+
+constexpr auto service = "xyz.openbmc_project.Test";
+constexpr auto interface = "xyz.openbmc_project.Test.Value";
+
+DBusMapping mapping(const std::string& path)
+{
+    return {path, interface, "Value", "string"};
+}
+
+} // namespace
+
+/** @brief AsyncDBus on one end of a peer-to-peer connection, the test answers
+ *         the calls received on the other end
+ */
+class TestAsyncDBus : public testing::Test
+{
+  protected:
+    void SetUp() override
+    {
+        int fds[2];
+        ASSERT_EQ(socketpair(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0, fds), 0);
+        ASSERT_GE(sd_event_new(&event), 0);
+
+        sd_id128_t id;
+        ASSERT_GE(sd_id128_randomize(&id), 0);
+        ASSERT_GE(sd_bus_new(&server), 0);
+        ASSERT_GE(sd_bus_set_fd(server, fds[0], fds[0]), 0);
+        ASSERT_GE(sd_bus_set_server(server, 1, id), 0);
+        ASSERT_GE(sd_bus_add_filter(server, nullptr, &TestAsyncDBus::onCall,
+                                    this),
+                  0);
+        ASSERT_GE(sd_bus_start(server), 0);
+        ASSERT_GE(sd_bus_attach_event(server, event, 0), 0);
+
+        sd_bus* client{};
+        ASSERT_GE(sd_bus_new(&client), 0);
+        ASSERT_GE(sd_bus_set_fd(client, fds[1], fds[1]), 0);
+        ASSERT_GE(sd_bus_start(client), 0);
+        ASSERT_GE(sd_bus_attach_event(client, event, 0), 0);
+        bus = std::make_unique<sdbusplus::bus_t>(client, std::false_type{});
+    }
+
+    void TearDown() override
+    {
+        for (auto m : calls)
+        {
+            sd_bus_message_unref(m);
+        }
+        bus.reset();
+        sd_bus_flush_close_unref(server);
+        sd_event_unref(event);
+    }
+
+    /** @brief Record the calls received by the server, they are answered by
+     *         the test
+     */
+    static int onCall(sd_bus_message* m, void* userdata, sd_bus_error*)
+    {
+        if (!sd_bus_message_is_method_call(m, nullptr, nullptr))
+        {
+            return 0;
+        }
+        static_cast<TestAsyncDBus*>(userdata)->calls.push_back(
+            sd_bus_message_ref(m));
+        return 1;
+    }
+
+    /** @brief Run the event loop until a condition holds, or for a while */
+    bool runUntil(const std::function<bool()>& done)
+    {
+        auto end = std::chrono::steady_clock::now() + 2s;
+        while (!done())
+        {
+            if (std::chrono::steady_clock::now() > end)
+            {
+                return false;
+            }
+            sd_event_run(event, 10000);
+        }
+        return true;
+    }
+
+    /** @brief Run the event loop until the server received a number of calls
+     */
+    bool receive(size_t count)
+    {
+        return runUntil([this, count]() { return calls.size() >= count; });
+    }
+
+    /** @brief Run the event loop for a while, to let calls that should not
+     *         be sent reach the server
+     */
+    void settle()
+    {
+        auto end = std::chrono::steady_clock::now() + 50ms;
+        while (std::chrono::steady_clock::now() < end)
+        {
+            sd_event_run(event, 10000);
+        }
+    }
+
+    std::string member(size_t call)
+    {
+        return sd_bus_message_get_member(calls[call]);
+    }
+
+    std::string path(size_t call)
+    {
+        return sd_bus_message_get_path(calls[call]);
+    }
+
+    void reply(size_t call)
+    {
+        EXPECT_GE(sd_bus_reply_method_return(calls[call], ""), 0);
+    }
+
+    void replyError(size_t call)
+    {
+        EXPECT_GE(sd_bus_reply_method_errorf(calls[call],
+                                             SD_BUS_ERROR_FAILED, "failed"),
+                  0);
+    }
+
+    /** @brief Answer a mapper GetObject call with the test service */
+    void replyService(size_t call)
+    {
+        ASSERT_EQ(member(call), "GetObject");
+        EXPECT_GE(sd_bus_reply_method_return(calls[call], "a{sas}", 1,
+                                             service, 1, interface),
+                  0);
+    }
+
+    /** @brief Answer a Properties Get call */
+    void replyValue(size_t call, const char* value)
+    {
+        ASSERT_EQ(member(call), "Get");
+        EXPECT_GE(sd_bus_reply_method_return(calls[call], "v", "s", value),
+                  0);
+    }
+
+    sdbusplus::message_t ping(const std::string& path)
+    {
+        return bus->new_method_call(service, path.c_str(), interface, "Ping");
+    }
+
+    sd_event* event{};
+    sd_bus* server{};
+    std::unique_ptr<sdbusplus::bus_t> bus;
+
+    /** @brief calls received by the server, in order */
+    std::vector<sd_bus_message*> calls;
+};
+
+TEST_F(TestAsyncDBus, ConcurrencyLimit)
+{
+    AsyncDBus client(*bus, 2);
+    std::vector<std::string> replies;
+    for (auto index = 0; index < 5; ++index)
+    {
+        auto path = "/test/" + std::to_string(index);
+        client.call(ping(path), [&replies, path](sdbusplus::message_t* reply) {
+            replies.push_back(reply ? path : "failed");
+        });
+    }
+
+    // The calls over the limit wait for a free slot
+    EXPECT_EQ(client.inFlightCalls(), 2);
+    EXPECT_EQ(client.getStats().calls, 2);
+    EXPECT_EQ(client.getStats().queued, 3);
+    ASSERT_TRUE(receive(2));
+    settle();
+    EXPECT_EQ(calls.size(), 2);
+
+    // A reply frees a slot for the next call, in order, failures included
+    replyError(1);
+    ASSERT_TRUE(receive(3));
+    EXPECT_EQ(path(2), "/test/2");
+    EXPECT_EQ(client.inFlightCalls(), 2);
+    ASSERT_EQ(replies.size(), 1);
+    EXPECT_EQ(replies[0], "failed");
+
+    reply(0);
+    ASSERT_TRUE(receive(4));
+    EXPECT_EQ(path(3), "/test/3");
+    reply(2);
+    reply(3);
+    ASSERT_TRUE(receive(5));
+    EXPECT_EQ(path(4), "/test/4");
+    EXPECT_LE(client.inFlightCalls(), 2);
+    reply(4);
+    ASSERT_TRUE(runUntil([&replies]() { return replies.size() == 5; }));
+
+    EXPECT_EQ(replies, std::vector<std::string>({"failed", "/test/0",
+                                                 "/test/2", "/test/3",
+                                                 "/test/4"}));
+    const auto& stats = client.getStats();
+    EXPECT_EQ(client.inFlightCalls(), 0);
+    EXPECT_EQ(stats.calls, 5);
+    EXPECT_EQ(stats.errors, 1);
+    EXPECT_EQ(stats.timeouts, 0);
+    EXPECT_EQ(stats.maxInFlightSeen, 2);
+}
+
+TEST_F(TestAsyncDBus, SharedReads)
+{
+    AsyncDBus client(*bus, 16);
+    std::vector<std::optional<PropertyValue>> values;
+    auto read = [&values](std::optional<PropertyValue> value) {
+        values.push_back(std::move(value));
+    };
+    for (auto count = 0; count < 3; ++count)
+    {
+        client.getProperty(mapping("/test/0"), read);
+    }
+
+    // One mapper lookup and one read serve the three requests
+    ASSERT_TRUE(receive(1));
+    replyService(0);
+    ASSERT_TRUE(receive(2));
+    replyValue(1, "on");
+    ASSERT_TRUE(runUntil([&values]() { return values.size() == 3; }));
+    settle();
+    EXPECT_EQ(calls.size(), 2);
+    for (const auto& value : values)
+    {
+        ASSERT_TRUE(value);
+        EXPECT_EQ(std::get<std::string>(*value), "on");
+    }
+    EXPECT_EQ(client.getStats().shared, 2);
+
+    // The next read is sent again, to the cached service
+    client.getProperty(mapping("/test/0"), read);
+    ASSERT_TRUE(receive(3));
+    EXPECT_EQ(client.getStats().cacheHits, 1);
+    replyValue(2, "off");
+    ASSERT_TRUE(runUntil([&values]() { return values.size() == 4; }));
+    ASSERT_TRUE(values[3]);
+    EXPECT_EQ(std::get<std::string>(*values[3]), "off");
+    EXPECT_EQ(client.getStats().shared, 2);
+}
+
+TEST_F(TestAsyncDBus, SetInvalidatesReads)
+{
+    AsyncDBus client(*bus, 16);
+    std::optional<PropertyValue> before;
+    std::optional<PropertyValue> after;
+    std::optional<bool> set;
+    client.getProperty(mapping("/test/0"),
+                       [&before](std::optional<PropertyValue> value) {
+        before = std::move(value);
+    });
+    ASSERT_TRUE(receive(1));
+    replyService(0);
+    ASSERT_TRUE(receive(2));
+
+    // The read after the set does not share the read in flight
+    client.setProperty(mapping("/test/0"), std::string("on"),
+                       [&set](bool success) { set = success; });
+    client.getProperty(mapping("/test/0"),
+                       [&after](std::optional<PropertyValue> value) {
+        after = std::move(value);
+    });
+    ASSERT_TRUE(receive(4));
+    EXPECT_EQ(member(2), "Set");
+    EXPECT_EQ(member(3), "Get");
+    EXPECT_EQ(client.getStats().shared, 0);
+
+    replyValue(1, "off");
+    reply(2);
+    replyValue(3, "on");
+    ASSERT_TRUE(runUntil([&]() { return before && set && after; }));
+    EXPECT_EQ(std::get<std::string>(*before), "off");
+    EXPECT_TRUE(*set);
+    EXPECT_EQ(std::get<std::string>(*after), "on");
+
+    // The reads after the one started by the set share it again
+    std::vector<std::optional<PropertyValue>> values;
+    for (auto count = 0; count < 2; ++count)
+    {
+        client.getProperty(mapping("/test/0"),
+                           [&values](std::optional<PropertyValue> value) {
+            values.push_back(std::move(value));
+        });
+    }
+    ASSERT_TRUE(receive(5));
+    replyValue(4, "on");
+    ASSERT_TRUE(runUntil([&values]() { return values.size() == 2; }));
+    settle();
+    EXPECT_EQ(calls.size(), 5);
+    EXPECT_EQ(client.getStats().shared, 1);
+}
+
+TEST_F(TestAsyncDBus, LatencyHistogram)
+{
+    AsyncDBus client(*bus, 16);
+    size_t replies = 0;
+    for (auto index = 0; index < 3; ++index)
+    {
+        client.call(ping("/test/" + std::to_string(index)),
+                    [&replies](sdbusplus::message_t*) { ++replies; });
+    }
+    ASSERT_TRUE(receive(3));
+    reply(0);
+    reply(1);
+    ASSERT_TRUE(runUntil([&replies]() { return replies == 2; }));
+
+    // The last call is answered after more than 50 ms
+    std::this_thread::sleep_for(60ms);
+    reply(2);
+    ASSERT_TRUE(runUntil([&replies]() { return replies == 3; }));
+
+    const auto& latency = client.getStats().latency;
+    EXPECT_EQ(std::accumulate(latency.begin(), latency.end(), uint64_t{}), 3);
+    constexpr size_t over50ms = 6;
+    ASSERT_EQ(AsyncDBus::latencyBuckets[over50ms - 1], 50);
+    EXPECT_EQ(std::accumulate(latency.begin() + over50ms, latency.end(),
+                              uint64_t{}),
+              1);
+}
@@ -39,4 +39,23 @@ class MockdBusHandler : public pldm::utils::DBusHandler
     MOCK_METHOD(pldm::utils::GetSubTreeResponse, getSubtree,
                 (const std::string&, int, const std::vector<std::string>&),
                 (const override));
+
+    /** @brief The asynchronous calls complete immediately with the mocked
+     *         synchronous calls
+     */
+    void getDbusPropertyVariantAsync(
+        const pldm::utils::DBusMapping& dBusMap,
+        pldm::utils::PropertyCallback callback) const override
+    {
+        DBusHandlerInterface::getDbusPropertyVariantAsync(dBusMap,
+                                                          std::move(callback));
+    }
+
+    void setDbusPropertyAsync(const pldm::utils::DBusMapping& dBusMap,
+                              const pldm::utils::PropertyValue& value,
+                              pldm::utils::SetCallback callback) const override
+    {
+        DBusHandlerInterface::setDbusPropertyAsync(dBusMap, value,
+                                                   std::move(callback));
+    }
 };
@@ -1,7 +1,11 @@
 #include "libpldm/platform.h"
 
+#include "common/json_cache.hpp"
 #include "common/utils.hpp"
 
+#include <filesystem>
+#include <fstream>
+
 #include <gtest/gtest.h>
 
 using namespace pldm::utils;
@@ -1012,3 +1016,50 @@ TEST(Split, allTestCases)
     auto results5 = split(s5, "\\");
     EXPECT_EQ(results5[0], "aa");
 }
+
+TEST(PercentileOf, allTestCases)
+{
+    EXPECT_EQ(percentileOf({}, 50), 0);
+
+    std::vector<double> samples{1, 2, 3, 4, 5, 6, 7, 8, 9, 10};
+    EXPECT_EQ(percentileOf(samples, 50), 5);
+    EXPECT_EQ(percentileOf(samples, 99), 10);
+    EXPECT_EQ(percentileOf(samples, 99.9), 10);
+    EXPECT_EQ(percentileOf(samples, 100), 10);
+    EXPECT_EQ(percentileOf(samples, 10), 1);
+    EXPECT_EQ(percentileOf(samples, 11), 2);
+
+    // The rank is at least one
+    EXPECT_EQ(percentileOf(samples, 0.01), 1);
+    EXPECT_EQ(percentileOf({42}, 99.9), 42);
+}
+
+TEST(JsonCache, PrefetchAndTake)
+{
+    char tmpdir[] = "/tmp/pldm_json_cache.XXXXXX";
+    fs::path dir(mkdtemp(tmpdir));
+    std::ofstream(dir / "a.json") << R"({"entries": [1, 2]})";
+    std::ofstream(dir / "b.json") << R"({"entries": )";
+    std::ofstream(dir / "c.txt") << R"({})";
+
+    auto& cache = JsonCache::get();
+    EXPECT_EQ(cache.prefetch(dir), 1);
+
+    // Each document is handed out once
+    auto document = cache.take(dir / "." / "a.json");
+    ASSERT_TRUE(document);
+    EXPECT_EQ(document->at("entries").size(), 2);
+    EXPECT_FALSE(cache.take(dir / "a.json"));
+
+    // Later parses read the file
+    std::ofstream(dir / "a.json") << R"({"entries": []})";
+    EXPECT_TRUE(cache.parse(dir / "a.json").at("entries").empty());
+    EXPECT_TRUE(cache.parse(dir / "b.json").is_discarded());
+    EXPECT_TRUE(cache.parse(dir / "missing.json").is_discarded());
+
+    EXPECT_EQ(cache.prefetch(dir / "a.json"), 1);
+    cache.clear();
+    EXPECT_FALSE(cache.take(dir / "a.json"));
+
+    fs::remove_all(dir);
+}
@@ -0,0 +1,132 @@
+#include "libpldm/platform.h"
+
+#include "common/state_pdr_index.hpp"
+#include "common/utils.hpp"
+
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using namespace pldm::utils;
+
+namespace
+{
+
+/** @brief Add a state effecter or state sensor PDR with one composite entry
+ *         per state set
+ */
+std::vector<uint8_t> addStatePDR(pldm_pdr* repo, uint8_t type,
+                                 uint16_t entityType,
+                                 const std::vector<uint16_t>& stateSetIds,
+                                 bool remote = false)
+{
+    // One byte of possible states per composite entry
+    std::vector<uint8_t> pdr(sizeof(pldm_state_effecter_pdr) - sizeof(uint8_t) +
+                             stateSetIds.size() *
+                                 sizeof(state_effecter_possible_states));
+    auto hdr = reinterpret_cast<pldm_pdr_hdr*>(pdr.data());
+    hdr->type = type;
+    uint8_t* possibleStates{};
+    if (type == PLDM_STATE_EFFECTER_PDR)
+    {
+        auto rec = reinterpret_cast<pldm_state_effecter_pdr*>(pdr.data());
+        rec->entity_type = entityType;
+        rec->composite_effecter_count = stateSetIds.size();
+        possibleStates = rec->possible_states;
+    }
+    else
+    {
+        auto rec = reinterpret_cast<pldm_state_sensor_pdr*>(pdr.data());
+        rec->entity_type = entityType;
+        rec->composite_sensor_count = stateSetIds.size();
+        possibleStates = rec->possible_states;
+    }
+    for (auto stateSetId : stateSetIds)
+    {
+        auto state =
+            reinterpret_cast<state_effecter_possible_states*>(possibleStates);
+        state->state_set_id = stateSetId;
+        state->possible_states_size = 1;
+        possibleStates += sizeof(state_effecter_possible_states);
+    }
+
+    uint32_t handle = 0;
+    EXPECT_EQ(pldm_pdr_add_check(repo, pdr.data(), pdr.size(), remote, 1,
+                                 &handle),
+              0);
+    hdr->record_handle = handle;
+    pdrRepoChanged(PdrRepoChange::added);
+    return pdr;
+}
+
+std::vector<uint8_t> toVector(std::span<const uint8_t> pdr)
+{
+    return {pdr.begin(), pdr.end()};
+}
+
+} // namespace
+
+TEST(StatePdrIndex, lookup)
+{
+    auto repo = pldm_pdr_init();
+    StatePdrIndex index(repo);
+    EXPECT_TRUE(index.lookup(PLDM_STATE_EFFECTER_PDR, 33, 196).empty());
+
+    auto first = addStatePDR(repo, PLDM_STATE_EFFECTER_PDR, 33, {196, 260});
+    auto second = addStatePDR(repo, PLDM_STATE_EFFECTER_PDR, 33, {196, 196});
+    auto sensor = addStatePDR(repo, PLDM_STATE_SENSOR_PDR, 33, {196});
+    addStatePDR(repo, PLDM_STATE_EFFECTER_PDR, 45, {196});
+
+    // A PDR is found once per state set, in repo order
+    const auto& pdrs = index.lookup(PLDM_STATE_EFFECTER_PDR, 33, 196);
+    ASSERT_EQ(pdrs.size(), 2);
+    EXPECT_EQ(toVector(pdrs[0]), first);
+    EXPECT_EQ(toVector(pdrs[1]), second);
+
+    const auto& byStateSet = index.lookup(PLDM_STATE_EFFECTER_PDR, 33, 260);
+    ASSERT_EQ(byStateSet.size(), 1);
+    EXPECT_EQ(toVector(byStateSet[0]), first);
+
+    const auto& sensors = index.lookup(PLDM_STATE_SENSOR_PDR, 33, 196);
+    ASSERT_EQ(sensors.size(), 1);
+    EXPECT_EQ(toVector(sensors[0]), sensor);
+
+    EXPECT_TRUE(index.lookup(PLDM_STATE_SENSOR_PDR, 33, 260).empty());
+    EXPECT_TRUE(index.lookup(PLDM_STATE_EFFECTER_PDR, 34, 196).empty());
+
+    pldm_pdr_destroy(repo);
+}
+
+TEST(StatePdrIndex, changeNumber)
+{
+    auto repo = pldm_pdr_init();
+    size_t signalled = 0;
+    StatePdrIndex index(repo, [&signalled]() { ++signalled; });
+    EXPECT_EQ(index.changeNumber(), 0);
+
+    addStatePDR(repo, PLDM_STATE_EFFECTER_PDR, 33, {196});
+    EXPECT_EQ(index.changeNumber(), 1);
+    EXPECT_EQ(signalled, 1);
+
+    // Lookups alone do not change the number
+    EXPECT_EQ(index.lookup(PLDM_STATE_EFFECTER_PDR, 33, 196).size(), 1);
+    EXPECT_EQ(index.lookup(PLDM_STATE_EFFECTER_PDR, 33, 196).size(), 1);
+    EXPECT_EQ(index.changeNumber(), 1);
+
+    // The change is seen without a lookup
+    auto remote = addStatePDR(repo, PLDM_STATE_EFFECTER_PDR, 33, {196}, true);
+    EXPECT_EQ(index.changeNumber(), 2);
+    EXPECT_EQ(signalled, 2);
+    const auto& pdrs = index.lookup(PLDM_STATE_EFFECTER_PDR, 33, 196);
+    ASSERT_EQ(pdrs.size(), 2);
+    EXPECT_EQ(toVector(pdrs[1]), remote);
+
+    // Removed records are dropped from the index
+    pldm_pdr_remove_remote_pdrs(repo);
+    pdrRepoChanged();
+    EXPECT_EQ(index.changeNumber(), 3);
+    EXPECT_EQ(signalled, 3);
+    EXPECT_EQ(index.lookup(PLDM_STATE_EFFECTER_PDR, 33, 196).size(), 1);
+
+    pldm_pdr_destroy(repo);
+}
@@ -1,5 +1,7 @@
 #include "utils.hpp"
 
+#include "dbus_async.hpp"
+
 #include "libpldm/pdr.h"
 #include "libpldm/pldm_types.h"
 
@@ -17,6 +19,7 @@
 #include <map>
 #include <stdexcept>
 #include <string>
+#include <utility>
 #include <vector>
 
 PHOSPHOR_LOG2_USING;
@@ -26,8 +29,6 @@ namespace pldm
 namespace utils
 {
 constexpr auto mapperBusName = "xyz.openbmc_project.ObjectMapper";
-constexpr auto mapperPath = "/xyz/openbmc_project/object_mapper";
-constexpr auto mapperInterface = "xyz.openbmc_project.ObjectMapper";
 
 std::vector<std::vector<uint8_t>> findStateEffecterPDR(uint8_t /*tid*/,
                                                        uint16_t entityID,
@@ -137,6 +138,30 @@ std::vector<std::vector<uint8_t>> findStateSensorPDR(uint8_t /*tid*/,
     return pdrs;
 }
 
+namespace
+{
+/** @brief live watches of the BMC's primary PDR repository */
+std::vector<PdrRepoWatch*> pdrRepoWatches;
+} // namespace
+
+void pdrRepoChanged(PdrRepoChange change)
+{
+    for (auto watch : pdrRepoWatches)
+    {
+        watch->callback(change);
+    }
+}
+
+PdrRepoWatch::PdrRepoWatch(Callback callback) : callback(std::move(callback))
+{
+    pdrRepoWatches.push_back(this);
+}
+
+PdrRepoWatch::~PdrRepoWatch()
+{
+    std::erase(pdrRepoWatches, this);
+}
+
 uint8_t readHostEID()
 {
     uint8_t eid{};
@@ -317,13 +342,13 @@ void reportError(const char* errorMsg, const Severity& sev)
     }
 }
 
-void DBusHandler::setDbusProperty(const DBusMapping& dBusMap,
-                                  const PropertyValue& value) const
+sdbusplus::message_t makeSetPropertyCall(sdbusplus::bus_t& bus,
+                                         const std::string& service,
+                                         const DBusMapping& dBusMap,
+                                         const PropertyValue& value)
 {
-    auto setDbusValue = [&dBusMap, this](const auto& variant) {
-        auto& bus = getBus();
-        auto service = getService(dBusMap.objectPath.c_str(),
-                                  dBusMap.interface.c_str());
+    auto setDbusValue = [&bus, &dBusMap, &service](
+                            const auto& variant) -> sdbusplus::message_t {
         if (service == "xyz.openbmc_project.Inventory.Manager")
         {
             ObjectValueTree objectValueTree;
@@ -342,7 +367,7 @@ void DBusHandler::setDbusProperty(const DBusMapping& dBusMap,
                 service.c_str(), "/xyz/openbmc_project/inventory",
                 "xyz.openbmc_project.Inventory.Manager", "Notify");
             method.append(std::move(objectValueTree));
-            bus.call_noreply(method, dbusTimeout);
+            return method;
         }
         else
         {
@@ -361,14 +386,14 @@ void DBusHandler::setDbusProperty(const DBusMapping& dBusMap,
             }
             method.append(dBusMap.interface.c_str(),
                           dBusMap.propertyName.c_str(), variant);
-            bus.call_noreply(method, dbusTimeout);
+            return method;
         }
     };
 
     if (dBusMap.propertyType == "uint8_t")
     {
         std::variant<uint8_t> v = std::get<uint8_t>(value);
-        setDbusValue(v);
+        return setDbusValue(v);
     }
     else if (dBusMap.propertyType == "bool")
     {
@@ -391,47 +416,47 @@ void DBusHandler::setDbusProperty(const DBusMapping& dBusMap,
             }
         }
 
-        setDbusValue(v);
+        return setDbusValue(v);
     }
     else if (dBusMap.propertyType == "int16_t")
     {
         std::variant<int16_t> v = std::get<int16_t>(value);
-        setDbusValue(v);
+        return setDbusValue(v);
     }
     else if (dBusMap.propertyType == "uint16_t")
     {
         std::variant<uint16_t> v = std::get<uint16_t>(value);
-        setDbusValue(v);
+        return setDbusValue(v);
     }
     else if (dBusMap.propertyType == "int32_t")
     {
         std::variant<int32_t> v = std::get<int32_t>(value);
-        setDbusValue(v);
+        return setDbusValue(v);
     }
     else if (dBusMap.propertyType == "uint32_t")
     {
         std::variant<uint32_t> v = std::get<uint32_t>(value);
-        setDbusValue(v);
+        return setDbusValue(v);
     }
     else if (dBusMap.propertyType == "int64_t")
     {
         std::variant<int64_t> v = std::get<int64_t>(value);
-        setDbusValue(v);
+        return setDbusValue(v);
     }
     else if (dBusMap.propertyType == "uint64_t")
     {
         std::variant<uint64_t> v = std::get<uint64_t>(value);
-        setDbusValue(v);
+        return setDbusValue(v);
     }
     else if (dBusMap.propertyType == "double")
     {
         std::variant<double> v = std::get<double>(value);
-        setDbusValue(v);
+        return setDbusValue(v);
     }
     else if (dBusMap.propertyType == "string")
     {
         std::variant<std::string> v = std::get<std::string>(value);
-        setDbusValue(v);
+        return setDbusValue(v);
     }
     else
     {
@@ -441,6 +466,28 @@ void DBusHandler::setDbusProperty(const DBusMapping& dBusMap,
     }
 }
 
+void DBusHandler::setDbusProperty(const DBusMapping& dBusMap,
+                                  const PropertyValue& value) const
+{
+    auto service = getService(dBusMap.objectPath.c_str(),
+                              dBusMap.interface.c_str());
+    auto method = makeSetPropertyCall(getBus(), service, dBusMap, value);
+    getBus().call_noreply(method, dbusTimeout);
+}
+
+void DBusHandler::getDbusPropertyVariantAsync(const DBusMapping& dBusMap,
+                                              PropertyCallback callback) const
+{
+    AsyncDBus::get().getProperty(dBusMap, std::move(callback));
+}
+
+void DBusHandler::setDbusPropertyAsync(const DBusMapping& dBusMap,
+                                       const PropertyValue& value,
+                                       SetCallback callback) const
+{
+    AsyncDBus::get().setProperty(dBusMap, value, std::move(callback));
+}
+
 PropertyValue DBusHandler::getDbusPropertyVariant(
     const char* objPath, const char* dbusProp, const char* dbusInterface) const
 {
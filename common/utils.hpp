@@ -15,9 +15,13 @@
 #include <sdbusplus/server.hpp>
 #include <xyz/openbmc_project/Logging/Entry/server.hpp>
 
+#include <algorithm>
+#include <cmath>
 #include <exception>
 #include <filesystem>
+#include <functional>
 #include <iostream>
+#include <optional>
 #include <string>
 #include <variant>
 #include <vector>
@@ -154,6 +158,8 @@ T decimalToBcd(T decimal)
 
 constexpr auto dbusProperties = "org.freedesktop.DBus.Properties";
 constexpr auto mapperService = "xyz.openbmc_project.ObjectMapper";
+constexpr auto mapperPath = "/xyz/openbmc_project/object_mapper";
+constexpr auto mapperInterface = "xyz.openbmc_project.ObjectMapper";
 constexpr auto inventoryService = "xyz.openbmc_project.Inventory.Manager";
 constexpr auto inventoryPath = "/xyz/openbmc_project/inventory";
 
@@ -185,6 +191,32 @@ using PropertyMap = std::map<std::string, PropertyValue>;
 using InterfaceMap = std::map<std::string, PropertyMap>;
 using ObjectValueTree = std::map<sdbusplus::message::object_path, InterfaceMap>;
 
+/** @brief Handles the value of a property read asynchronously, nullopt if the
+ *         read failed
+ */
+using PropertyCallback = std::function<void(std::optional<PropertyValue>)>;
+
+/** @brief Handles the result of a property write done asynchronously */
+using SetCallback = std::function<void(bool success)>;
+
+/** @brief Build the method call that sets a D-Bus property
+ *
+ *  @param[in] bus - D-Bus connection the call is sent on
+ *  @param[in] service - service of the object
+ *  @param[in] dBusMap - Object path, property name, interface and property
+ *                       type for the D-Bus object
+ *  @param[in] value - The value to be set
+ *
+ *  @return the Properties Set call, or the inventory manager Notify call for
+ *          the objects of the inventory manager
+ *
+ *  @throw std::invalid_argument when the property type is not supported
+ */
+sdbusplus::message_t makeSetPropertyCall(sdbusplus::bus_t& bus,
+                                         const std::string& service,
+                                         const DBusMapping& dBusMap,
+                                         const PropertyValue& value);
+
 /**
  * @brief The interface for DBusHandler
  */
@@ -205,6 +237,54 @@ class DBusHandlerInterface
     virtual PropertyValue
         getDbusPropertyVariant(const char* objPath, const char* dbusProp,
                                const char* dbusInterface) const = 0;
+
+    /** @brief Get a property without waiting for the reply, the default
+     *         implementation reads it synchronously
+     *
+     *  @param[in] dBusMap - Object path, property name and interface
+     *  @param[in] callback - handles the value
+     */
+    virtual void getDbusPropertyVariantAsync(const DBusMapping& dBusMap,
+                                             PropertyCallback callback) const
+    {
+        std::optional<PropertyValue> value;
+        try
+        {
+            value = getDbusPropertyVariant(dBusMap.objectPath.c_str(),
+                                           dBusMap.propertyName.c_str(),
+                                           dBusMap.interface.c_str());
+        }
+        catch (const std::exception&)
+        {}
+        callback(std::move(value));
+    }
+
+    /** @brief Set a property without waiting for the reply, the default
+     *         implementation sets it synchronously
+     *
+     *  @param[in] dBusMap - Object path, property name, interface and property
+     *                       type for the D-Bus object
+     *  @param[in] value - The value to be set
+     *  @param[in] callback - handles the result, may be empty
+     */
+    virtual void setDbusPropertyAsync(const DBusMapping& dBusMap,
+                                      const PropertyValue& value,
+                                      SetCallback callback) const
+    {
+        bool success = true;
+        try
+        {
+            setDbusProperty(dBusMap, value);
+        }
+        catch (const std::exception&)
+        {
+            success = false;
+        }
+        if (callback)
+        {
+            callback(success);
+        }
+    }
 };
 
 /**
@@ -304,6 +384,25 @@ class DBusHandler : public DBusHandlerInterface
     void setDbusProperty(const DBusMapping& dBusMap,
                          const PropertyValue& value) const override;
 
+    /** @brief Get a property through the asynchronous D-Bus client
+     *
+     *  @param[in] dBusMap - Object path, property name and interface
+     *  @param[in] callback - handles the value, called on the event loop
+     */
+    void getDbusPropertyVariantAsync(const DBusMapping& dBusMap,
+                                     PropertyCallback callback) const override;
+
+    /** @brief Set a property through the asynchronous D-Bus client
+     *
+     *  @param[in] dBusMap - Object path, property name, interface and property
+     *                       type for the D-Bus object
+     *  @param[in] value - The value to be set
+     *  @param[in] callback - handles the result, may be empty
+     */
+    void setDbusPropertyAsync(const DBusMapping& dBusMap,
+                              const PropertyValue& value,
+                              SetCallback callback) const override;
+
     /** @brief This function will returns all the objectspaths under the service
      * root path, with their interfaces and the properties under those
      * interfaces     *
@@ -340,6 +439,25 @@ inline std::string findParent(const std::string& dbusObj)
     return p.parent_path().string();
 }
 
+/** @brief Nearest rank percentile of sorted samples
+ *
+ *  @param[in] samples - samples in ascending order
+ *  @param[in] percentile - percentile in the range (0, 100]
+ *
+ *  @return the percentile, 0 if there are no samples
+ */
+inline double percentileOf(const std::vector<double>& samples,
+                           double percentile)
+{
+    if (samples.empty())
+    {
+        return 0;
+    }
+    auto rank = static_cast<size_t>(
+        std::ceil(percentile / 100 * static_cast<double>(samples.size())));
+    return samples[std::clamp<size_t>(rank, 1, samples.size()) - 1];
+}
+
 /** @brief Read (static) MCTP EID of host firmware from a file
  *
  *  @return uint8_t - MCTP EID
@@ -379,6 +497,54 @@ std::vector<std::vector<uint8_t>> findStateSensorPDR(uint8_t tid,
                                                      uint16_t stateSetId,
                                                      const pldm_pdr* repo);
 
+/** @brief Kind of change of the BMC's primary PDR repository */
+enum class PdrRepoChange
+{
+    added,    //!< records appended after the last record
+    modified, //!< records removed, modified or replaced
+};
+
+/** @brief Record a change of the BMC's primary PDR repository, to be called
+ *         after each update of the repository. The PdrRepoWatch callbacks
+ *         are run before returning.
+ *
+ *  @param[in] change - kind of change
+ */
+void pdrRepoChanged(PdrRepoChange change = PdrRepoChange::modified);
+
+/** @class PdrRepoWatch
+ *
+ *  @brief Callback run on each change of the BMC's primary PDR repository
+ *         recorded by pdrRepoChanged(), for as long as the watch lives. The
+ *         caches of the repository, such as the PDR index of the D-Bus API
+ *         and the GetPDR arena, drop their state from it.
+ */
+class PdrRepoWatch
+{
+  public:
+    using Callback = std::function<void(PdrRepoChange)>;
+
+    PdrRepoWatch() = delete;
+    PdrRepoWatch(const PdrRepoWatch&) = delete;
+    PdrRepoWatch& operator=(const PdrRepoWatch&) = delete;
+    PdrRepoWatch(PdrRepoWatch&&) = delete;
+    PdrRepoWatch& operator=(PdrRepoWatch&&) = delete;
+
+    /** @brief Constructor
+     *
+     *  @param[in] callback - run after each change, it must not create or
+     *                        destroy a watch
+     */
+    explicit PdrRepoWatch(Callback callback);
+
+    ~PdrRepoWatch();
+
+  private:
+    friend void pdrRepoChanged(PdrRepoChange change);
+
+    Callback callback;
+};
+
 /** @brief Find sensor id from a state sensor PDR
  *
  *  @param[in] pdrRepo - PDR repository
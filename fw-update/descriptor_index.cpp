@@ -0,0 +1,162 @@
+#include "descriptor_index.hpp"
+
+#include <algorithm>
+#include <type_traits>
+#include <variant>
+
+namespace pldm
+{
+
+namespace fw_update
+{
+
+namespace
+{
+
+constexpr uint64_t fnvOffsetBasis = 0xcbf29ce484222325ULL;
+constexpr uint64_t fnvPrime = 0x100000001b3ULL;
+
+/** @brief Fold a byte range into a FNV-1a hash
+ *
+ *  @param[in] hash - running hash value
+ *  @param[in] data - bytes to fold into the hash
+ *  @param[in] length - number of bytes
+ *
+ *  @return updated hash value
+ */
+uint64_t fnv1a(uint64_t hash, const uint8_t* data, size_t length)
+{
+    for (size_t i = 0; i < length; ++i)
+    {
+        hash ^= data[i];
+        hash *= fnvPrime;
+    }
+    return hash;
+}
+
+} // namespace
+
+DescriptorIndex::DescriptorKey
+    DescriptorIndex::makeKey(DescriptorType type, const DescriptorValue& value)
+{
+    uint64_t hash = fnv1a(fnvOffsetBasis, reinterpret_cast<uint8_t*>(&type),
+                          sizeof(type));
+    std::visit(
+        [&hash](const auto& data) {
+        using T = std::decay_t<decltype(data)>;
+        if constexpr (std::is_same_v<T, DescriptorData>)
+        {
+            hash = fnv1a(hash, data.data(), data.size());
+        }
+        else
+        {
+            const auto& [title, vendorData] = data;
+            hash = fnv1a(hash, reinterpret_cast<const uint8_t*>(title.data()),
+                         title.size());
+            // Separate the title from the data, so that moving bytes between
+            // the two does not produce the same key
+            uint8_t separator = 0;
+            hash = fnv1a(hash, &separator, sizeof(separator));
+            hash = fnv1a(hash, vendorData.data(), vendorData.size());
+        }
+    },
+        value);
+    return static_cast<DescriptorKey>(hash);
+}
+
+void DescriptorIndex::add(mctp_eid_t eid, const Descriptors& descriptors)
+{
+    remove(eid);
+
+    std::vector<DescriptorKey> keys;
+    keys.reserve(descriptors.size());
+    for (const auto& [type, value] : descriptors)
+    {
+        auto key = makeKey(type, value);
+        postings[key].emplace(eid);
+        keys.emplace_back(key);
+    }
+    eidKeys.emplace(eid, std::move(keys));
+}
+
+void DescriptorIndex::remove(mctp_eid_t eid)
+{
+    auto search = eidKeys.find(eid);
+    if (search == eidKeys.end())
+    {
+        return;
+    }
+
+    for (const auto& key : search->second)
+    {
+        auto posting = postings.find(key);
+        if (posting == postings.end())
+        {
+            continue;
+        }
+        posting->second.erase(eid);
+        if (posting->second.empty())
+        {
+            postings.erase(posting);
+        }
+    }
+    eidKeys.erase(search);
+}
+
+std::vector<mctp_eid_t>
+    DescriptorIndex::match(const Descriptors& descriptors) const
+{
+    std::vector<mctp_eid_t> eids;
+
+    // Start from the least common descriptor of the record, every matching
+    // FD has to be in its posting list.
+    const std::set<mctp_eid_t>* candidates = nullptr;
+    for (const auto& [type, value] : descriptors)
+    {
+        auto posting = postings.find(makeKey(type, value));
+        if (posting == postings.end())
+        {
+            return eids;
+        }
+        if (!candidates || posting->second.size() < candidates->size())
+        {
+            candidates = &posting->second;
+        }
+    }
+
+    auto includes = [this, &descriptors](mctp_eid_t eid) {
+        auto search = descriptorMap.find(eid);
+        return search != descriptorMap.end() &&
+               std::includes(search->second.begin(), search->second.end(),
+                             descriptors.begin(), descriptors.end());
+    };
+
+    if (!candidates)
+    {
+        // A record without descriptors applies to every FD
+        for (const auto& [eid, keys] : eidKeys)
+        {
+            if (includes(eid))
+            {
+                eids.emplace_back(eid);
+            }
+        }
+        std::sort(eids.begin(), eids.end());
+        return eids;
+    }
+
+    // Confirm the candidates against the device identifiers, this also rules
+    // out hash collisions in the index.
+    for (const auto& eid : *candidates)
+    {
+        if (includes(eid))
+        {
+            eids.emplace_back(eid);
+        }
+    }
+    return eids;
+}
+
+} // namespace fw_update
+
+} // namespace pldm
@@ -0,0 +1,100 @@
+#pragma once
+
+#include "libpldm/base.h"
+
+#include "common/types.hpp"
+
+#include <set>
+#include <unordered_map>
+#include <vector>
+
+namespace pldm
+{
+
+namespace fw_update
+{
+
+/** @class DescriptorIndex
+ *
+ *  DescriptorIndex maintains a reverse index from a firmware device descriptor
+ *  (descriptor type and value) to the MCTP endpoints that reported it in the
+ *  QueryDeviceIdentifiers response. The index is updated incrementally as
+ *  endpoints are discovered and removed, so associating the
+ *  FirmwareDeviceIDRecords in a firmware update package with the firmware
+ *  devices is a lookup instead of a scan of all the devices.
+ */
+class DescriptorIndex
+{
+  public:
+    DescriptorIndex() = delete;
+    DescriptorIndex(const DescriptorIndex&) = delete;
+    DescriptorIndex(DescriptorIndex&&) = delete;
+    DescriptorIndex& operator=(const DescriptorIndex&) = delete;
+    DescriptorIndex& operator=(DescriptorIndex&&) = delete;
+    ~DescriptorIndex() = default;
+
+    /** @brief Constructor
+     *
+     *  @param[in] descriptorMap - Device identifiers of the managed FDs, used
+     *                             to confirm the candidates found in the index
+     */
+    explicit DescriptorIndex(const DescriptorMap& descriptorMap) :
+        descriptorMap(descriptorMap)
+    {}
+
+    /** @brief Index the descriptors of a firmware device, replacing any
+     *         descriptors previously indexed for the endpoint
+     *
+     *  @param[in] eid - MCTP endpoint ID of the FD
+     *  @param[in] descriptors - Descriptors reported by the FD
+     */
+    void add(mctp_eid_t eid, const Descriptors& descriptors);
+
+    /** @brief Remove the descriptors of a firmware device from the index
+     *
+     *  @param[in] eid - MCTP endpoint ID of the FD
+     */
+    void remove(mctp_eid_t eid);
+
+    /** @brief Find the firmware devices whose descriptors include all the
+     *         descriptors of a FirmwareDeviceIDRecord
+     *
+     *  @param[in] descriptors - Descriptors in the FirmwareDeviceIDRecord
+     *
+     *  @return MCTP endpoint IDs of the matching FDs in ascending order
+     */
+    std::vector<mctp_eid_t> match(const Descriptors& descriptors) const;
+
+    /** @brief Number of firmware devices in the index */
+    size_t size() const
+    {
+        return eidKeys.size();
+    }
+
+  private:
+    using DescriptorKey = size_t;
+    using DescriptorValue = Descriptors::mapped_type;
+
+    /** @brief Compute the index key for a descriptor
+     *
+     *  @param[in] type - Descriptor type
+     *  @param[in] value - Descriptor data or vendor defined descriptor info
+     *
+     *  @return index key of the descriptor
+     */
+    static DescriptorKey makeKey(DescriptorType type,
+                                 const DescriptorValue& value);
+
+    /** @brief Device identifiers of the managed FDs */
+    const DescriptorMap& descriptorMap;
+
+    /** @brief Descriptor key to the endpoints that reported the descriptor */
+    std::unordered_map<DescriptorKey, std::set<mctp_eid_t>> postings;
+
+    /** @brief Endpoint to the descriptor keys indexed for the endpoint */
+    std::unordered_map<mctp_eid_t, std::vector<DescriptorKey>> eidKeys;
+};
+
+} // namespace fw_update
+
+} // namespace pldm
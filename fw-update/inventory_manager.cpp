@@ -18,43 +18,164 @@ void InventoryManager::discoverFDs(const std::vector<mctp_eid_t>& eids)
 {
     for (const auto& eid : eids)
     {
-        auto instanceId = requester.getInstanceId(eid);
-        Request requestMsg(sizeof(pldm_msg_hdr) +
-                           PLDM_QUERY_DEVICE_IDENTIFIERS_REQ_BYTES);
-        auto request = reinterpret_cast<pldm_msg*>(requestMsg.data());
-        auto rc = encode_query_device_identifiers_req(
-            instanceId, PLDM_QUERY_DEVICE_IDENTIFIERS_REQ_BYTES, request);
+        auto search = discoveryStates.find(eid);
+        if (search != discoveryStates.end() && !search->second.timedOut)
+        {
+            info("Discovery of the FD already in progress, EID={EID}", "EID",
+                 unsigned(eid));
+            continue;
+        }
+
+        DiscoveryState state{};
+        state.timer = std::make_unique<phosphor::Timer>(
+            event.get(),
+            std::bind(&InventoryManager::discoveryTimeoutCallback, this, eid));
+        discoveryStates.insert_or_assign(eid, std::move(state));
+
+        // Queue both the inventory commands, the request handler sends
+        // GetFirmwareParameters as soon as QueryDeviceIdentifiers completes
+        auto rc = sendQueryDeviceIdentifiersRequest(eid);
         if (rc)
         {
-            requester.markFree(eid, instanceId);
-            error(
-                "encode_query_device_identifiers_req failed, EID={EID}, RC = {RC}",
-                "EID", unsigned(eid), "RC", rc);
+            discoveryStates.erase(eid);
             continue;
         }
 
-        rc = handler.registerRequest(
-            eid, instanceId, PLDM_FWUP, PLDM_QUERY_DEVICE_IDENTIFIERS,
-            std::move(requestMsg),
-            std::move(std::bind_front(&InventoryManager::queryDeviceIdentifiers,
-                                      this)));
+        rc = sendGetFirmwareParametersRequest(eid);
         if (rc)
+        {
+            // The QueryDeviceIdentifiers response completes the discovery
+            discoveryStates[eid].parametersDone = true;
+        }
+
+        try
+        {
+            discoveryStates[eid].timer->start(
+                duration_cast<std::chrono::microseconds>(discoveryTimeout));
+        }
+        catch (const std::runtime_error& e)
         {
             error(
-                "Failed to send QueryDeviceIdentifiers request, EID={EID}, RC = {RC}",
-                "EID", unsigned(eid), "RC", rc);
+                "Failed to start the discovery timer, EID={EID}, ERROR={ERR_EXCEP}",
+                "EID", unsigned(eid), "ERR_EXCEP", e.what());
         }
     }
 }
 
+void InventoryManager::removeFDs(const std::vector<mctp_eid_t>& eids)
+{
+    for (const auto& eid : eids)
+    {
+        discoveryStates.erase(eid);
+        eraseFD(eid);
+    }
+}
+
+int InventoryManager::sendQueryDeviceIdentifiersRequest(mctp_eid_t eid)
+{
+    auto instanceId = requester.getInstanceId(eid);
+    Request requestMsg(sizeof(pldm_msg_hdr) +
+                       PLDM_QUERY_DEVICE_IDENTIFIERS_REQ_BYTES);
+    auto request = reinterpret_cast<pldm_msg*>(requestMsg.data());
+    auto rc = encode_query_device_identifiers_req(
+        instanceId, PLDM_QUERY_DEVICE_IDENTIFIERS_REQ_BYTES, request);
+    if (rc)
+    {
+        requester.markFree(eid, instanceId);
+        error(
+            "encode_query_device_identifiers_req failed, EID={EID}, RC = {RC}",
+            "EID", unsigned(eid), "RC", rc);
+        return rc;
+    }
+
+    rc = handler.registerRequest(
+        eid, instanceId, PLDM_FWUP, PLDM_QUERY_DEVICE_IDENTIFIERS,
+        std::move(requestMsg),
+        std::move(std::bind_front(&InventoryManager::queryDeviceIdentifiers,
+                                  this)));
+    if (rc)
+    {
+        error(
+            "Failed to send QueryDeviceIdentifiers request, EID={EID}, RC = {RC}",
+            "EID", unsigned(eid), "RC", rc);
+    }
+    return rc;
+}
+
+bool InventoryManager::discoveryTimedOut(mctp_eid_t eid) const
+{
+    auto search = discoveryStates.find(eid);
+    return search != discoveryStates.end() && search->second.timedOut;
+}
+
+void InventoryManager::markDiscoveryStep(mctp_eid_t eid, uint8_t command)
+{
+    auto search = discoveryStates.find(eid);
+    if (search == discoveryStates.end())
+    {
+        return;
+    }
+
+    auto& state = search->second;
+    if (command == PLDM_QUERY_DEVICE_IDENTIFIERS)
+    {
+        state.identifiersDone = true;
+    }
+    else
+    {
+        state.parametersDone = true;
+    }
+
+    if (!state.identifiersDone || !state.parametersDone)
+    {
+        return;
+    }
+
+    if (!descriptorMap.contains(eid))
+    {
+        // Component details without the firmware identifiers cannot be
+        // associated with a firmware update package
+        eraseFD(eid);
+    }
+    discoveryStates.erase(search);
+}
+
+void InventoryManager::discoveryTimeoutCallback(mctp_eid_t eid)
+{
+    auto search = discoveryStates.find(eid);
+    if (search == discoveryStates.end())
+    {
+        return;
+    }
+
+    error("Discovery of the FD timed out, EID={EID}", "EID", unsigned(eid));
+    // Keep the state around to drop the late responses, it is cleared when
+    // the FD is rediscovered or removed
+    search->second.timedOut = true;
+    eraseFD(eid);
+}
+
+void InventoryManager::eraseFD(mctp_eid_t eid)
+{
+    descriptorIndex.remove(eid);
+    descriptorMap.erase(eid);
+    componentInfoMap.erase(eid);
+}
+
 void InventoryManager::queryDeviceIdentifiers(mctp_eid_t eid,
                                               const pldm_msg* response,
                                               size_t respMsgLen)
 {
+    if (discoveryTimedOut(eid))
+    {
+        return;
+    }
+
     if (response == nullptr || !respMsgLen)
     {
         error("No response received for QueryDeviceIdentifiers, EID={EID}",
               "EID", unsigned(eid));
+        markDiscoveryStep(eid, PLDM_QUERY_DEVICE_IDENTIFIERS);
         return;
     }
 
@@ -71,6 +192,7 @@ void InventoryManager::queryDeviceIdentifiers(mctp_eid_t eid,
         error(
             "Decoding QueryDeviceIdentifiers response failed, EID={EID}, RC = {RC}",
             "EID", unsigned(eid), "RC", rc);
+        markDiscoveryStep(eid, PLDM_QUERY_DEVICE_IDENTIFIERS);
         return;
     }
 
@@ -79,6 +201,7 @@ void InventoryManager::queryDeviceIdentifiers(mctp_eid_t eid,
         error(
             "QueryDeviceIdentifiers response failed with error completion code, EID={EID}, CC = {CC}",
             "EID", unsigned(eid), "CC", unsigned(completionCode));
+        markDiscoveryStep(eid, PLDM_QUERY_DEVICE_IDENTIFIERS);
         return;
     }
 
@@ -96,6 +219,7 @@ void InventoryManager::queryDeviceIdentifiers(mctp_eid_t eid,
             error(
                 "Decoding descriptor type, length and value failed, EID={EID}, RC = {RC}",
                 "EID", unsigned(eid), "RC", rc);
+            markDiscoveryStep(eid, PLDM_QUERY_DEVICE_IDENTIFIERS);
             return;
         }
 
@@ -120,6 +244,7 @@ void InventoryManager::queryDeviceIdentifiers(mctp_eid_t eid,
                 error(
                     "Decoding Vendor-defined descriptor value failed, EID={EID}, RC = {RC}",
                     "EID", unsigned(eid), "RC", rc);
+                markDiscoveryStep(eid, PLDM_QUERY_DEVICE_IDENTIFIERS);
                 return;
             }
 
@@ -141,13 +266,21 @@ void InventoryManager::queryDeviceIdentifiers(mctp_eid_t eid,
         deviceIdentifiersLen -= nextDescriptorOffset;
     }
 
-    descriptorMap.emplace(eid, std::move(descriptors));
+    descriptorMap.insert_or_assign(eid, std::move(descriptors));
+    descriptorIndex.add(eid, descriptorMap.at(eid));
+
+    if (discoveryStates.contains(eid))
+    {
+        // GetFirmwareParameters is already queued by discoverFDs
+        markDiscoveryStep(eid, PLDM_QUERY_DEVICE_IDENTIFIERS);
+        return;
+    }
 
     // Send GetFirmwareParameters request
     sendGetFirmwareParametersRequest(eid);
 }
 
-void InventoryManager::sendGetFirmwareParametersRequest(mctp_eid_t eid)
+int InventoryManager::sendGetFirmwareParametersRequest(mctp_eid_t eid)
 {
     auto instanceId = requester.getInstanceId(eid);
     Request requestMsg(sizeof(pldm_msg_hdr) +
@@ -160,7 +293,7 @@ void InventoryManager::sendGetFirmwareParametersRequest(mctp_eid_t eid)
         requester.markFree(eid, instanceId);
         error("encode_get_firmware_parameters_req failed, EID={EID}, RC = {RC}",
               "EID", unsigned(eid), "RC", rc);
-        return;
+        return rc;
     }
 
     rc = handler.registerRequest(
@@ -174,17 +307,25 @@ void InventoryManager::sendGetFirmwareParametersRequest(mctp_eid_t eid)
             "Failed to send GetFirmwareParameters request, EID={EID}, RC = {RC}",
             "EID", unsigned(eid), "RC", rc);
     }
+    return rc;
 }
 
 void InventoryManager::getFirmwareParameters(mctp_eid_t eid,
                                              const pldm_msg* response,
                                              size_t respMsgLen)
 {
+    if (discoveryTimedOut(eid))
+    {
+        return;
+    }
+
     if (response == nullptr || !respMsgLen)
     {
         error("No response received for GetFirmwareParameters, EID={EID}",
               "EID", unsigned(eid));
+        descriptorIndex.remove(eid);
         descriptorMap.erase(eid);
+        markDiscoveryStep(eid, PLDM_GET_FIRMWARE_PARAMETERS);
         return;
     }
 
@@ -201,6 +342,7 @@ void InventoryManager::getFirmwareParameters(mctp_eid_t eid,
         error(
             "Decoding GetFirmwareParameters response failed, EID={EID}, RC = {RC}",
             "EID", unsigned(eid), "RC", rc);
+        markDiscoveryStep(eid, PLDM_GET_FIRMWARE_PARAMETERS);
         return;
     }
 
@@ -209,6 +351,7 @@ void InventoryManager::getFirmwareParameters(mctp_eid_t eid,
         error(
             "GetFirmwareParameters response failed with error completion code, EID={EID}, CC = {CC}",
             "EID", unsigned(eid), "CC", unsigned(fwParams.completion_code));
+        markDiscoveryStep(eid, PLDM_GET_FIRMWARE_PARAMETERS);
         return;
     }
 
@@ -229,6 +372,7 @@ void InventoryManager::getFirmwareParameters(mctp_eid_t eid,
             error(
                 "Decoding component parameter table entry failed, EID={EID}, RC = {RC}",
                 "EID", unsigned(eid), "RC", rc);
+            markDiscoveryStep(eid, PLDM_GET_FIRMWARE_PARAMETERS);
             return;
         }
 
@@ -242,7 +386,8 @@ void InventoryManager::getFirmwareParameters(mctp_eid_t eid,
         compParamTableLen -= sizeof(pldm_component_parameter_entry) +
                              activeCompVerStr.length + pendingCompVerStr.length;
     }
-    componentInfoMap.emplace(eid, std::move(componentInfo));
+    componentInfoMap.insert_or_assign(eid, std::move(componentInfo));
+    markDiscoveryStep(eid, PLDM_GET_FIRMWARE_PARAMETERS);
 }
 
 } // namespace fw_update
@@ -3,15 +3,40 @@
 #include "libpldm/pldm.h"
 
 #include "common/types.hpp"
+#include "descriptor_index.hpp"
 #include "pldmd/dbus_impl_requester.hpp"
 #include "requester/handler.hpp"
 
+#include <sdbusplus/timer.hpp>
+#include <sdeventplus/event.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <unordered_map>
+
 namespace pldm
 {
 
 namespace fw_update
 {
 
+/** @brief Longest time the request handler takes to complete a request to an
+ *         FD, with its retries, before the instance ID expires
+ */
+constexpr std::chrono::milliseconds requestCompletionTime =
+    std::max<std::chrono::milliseconds>(
+        std::chrono::seconds(INSTANCE_ID_EXPIRATION_INTERVAL),
+        std::chrono::milliseconds((NUMBER_OF_REQUEST_RETRIES + 1) *
+                                  RESPONSE_TIME_OUT));
+
+/** @brief Default time allowed for the discovery of an FD, the two inventory
+ *         commands are sent one after the other, with the time of one more
+ *         request for the requests already queued to the FD
+ */
+constexpr std::chrono::milliseconds defaultDiscoveryTimeout =
+    3 * requestCompletionTime;
+
 /** @class InventoryManager
  *
  *  InventoryManager class manages the software inventory of firmware devices
@@ -32,32 +57,51 @@ class InventoryManager
 
     /** @brief Constructor
      *
+     *  @param[in] event - reference to PLDM daemon's main event loop
      *  @param[in] handler - PLDM request handler
      *  @param[in] requester - Managing instance ID for PLDM requests
      *  @param[out] descriptorMap - Populate the firmware identifers for the
      *                              FDs managed by the BMC.
      *  @param[out] componentInfoMap - Populate the component info for the FDs
      *                                 managed by the BMC.
+     *  @param[out] descriptorIndex - Index of the firmware identifiers to the
+     *                                FDs managed by the BMC.
+     *  @param[in] discoveryTimeout - time allowed for an FD to answer both
+     *                                the inventory commands
      */
     explicit InventoryManager(
+        sdeventplus::Event& event,
         pldm::requester::Handler<pldm::requester::Request>& handler,
         pldm::dbus_api::Requester& requester, DescriptorMap& descriptorMap,
-        ComponentInfoMap& componentInfoMap) :
-        handler(handler),
-        requester(requester), descriptorMap(descriptorMap),
-        componentInfoMap(componentInfoMap)
+        ComponentInfoMap& componentInfoMap, DescriptorIndex& descriptorIndex,
+        std::chrono::milliseconds discoveryTimeout = defaultDiscoveryTimeout) :
+        event(event),
+        handler(handler), requester(requester), descriptorMap(descriptorMap),
+        componentInfoMap(componentInfoMap), descriptorIndex(descriptorIndex),
+        discoveryTimeout(discoveryTimeout)
     {}
 
     /** @brief Discover the firmware identifiers and component details of FDs
      *
      *  Inventory commands QueryDeviceIdentifiers and GetFirmwareParmeters
      *  commands are sent to every FD and the response is used to populate
-     *  the firmware identifiers and component details of the FDs.
+     *  the firmware identifiers and component details of the FDs. Both the
+     *  commands are queued for every FD up front, so the discovery of an FD
+     *  does not wait on a callback hop and the FDs are discovered
+     *  concurrently. An FD that does not complete the discovery within the
+     *  discovery timeout is dropped from the inventory.
      *
      *  @param[in] eids - MCTP endpoint ID of the FDs
      */
     void discoverFDs(const std::vector<mctp_eid_t>& eids);
 
+    /** @brief Remove the FDs from the inventory, when the MCTP endpoints are
+     *         no longer present
+     *
+     *  @param[in] eids - MCTP endpoint ID of the FDs
+     */
+    void removeFDs(const std::vector<mctp_eid_t>& eids);
+
     /** @brief Handler for QueryDeviceIdentifiers command response
      *
      *  The response of the QueryDeviceIdentifiers is processed and firmware
@@ -84,11 +128,66 @@ class InventoryManager
                                size_t respMsgLen);
 
   private:
+    /** @struct DiscoveryState
+     *
+     *  Tracks the inventory commands outstanding for an FD being discovered
+     *  and the timer bounding the discovery of the FD.
+     */
+    struct DiscoveryState
+    {
+        bool identifiersDone = false; //!< QueryDeviceIdentifiers completed
+        bool parametersDone = false;  //!< GetFirmwareParameters completed
+        bool timedOut = false;        //!< discovery of the FD timed out
+        std::unique_ptr<phosphor::Timer> timer; //!< discovery timer
+    };
+
+    /** @brief Send QueryDeviceIdentifiers command request
+     *
+     *  @param[in] eid - Remote MCTP endpoint
+     *
+     *  @return return PLDM_SUCCESS on success and PLDM_ERROR otherwise
+     */
+    int sendQueryDeviceIdentifiersRequest(mctp_eid_t eid);
+
     /** @brief Send GetFirmwareParameters command request
      *
      *  @param[in] eid - Remote MCTP endpoint
+     *
+     *  @return return PLDM_SUCCESS on success and PLDM_ERROR otherwise
+     */
+    int sendGetFirmwareParametersRequest(mctp_eid_t eid);
+
+    /** @brief Check if the response for an FD has to be dropped because the
+     *         discovery of the FD has timed out
+     *
+     *  @param[in] eid - Remote MCTP endpoint
+     *
+     *  @return true if the discovery of the FD has timed out
+     */
+    bool discoveryTimedOut(mctp_eid_t eid) const;
+
+    /** @brief Mark an inventory command of an FD complete and finish the
+     *         discovery of the FD once both the commands are complete
+     *
+     *  @param[in] eid - Remote MCTP endpoint
+     *  @param[in] command - PLDM inventory command that completed
      */
-    void sendGetFirmwareParametersRequest(mctp_eid_t eid);
+    void markDiscoveryStep(mctp_eid_t eid, uint8_t command);
+
+    /** @brief Callback when an FD does not complete the discovery in time
+     *
+     *  @param[in] eid - Remote MCTP endpoint
+     */
+    void discoveryTimeoutCallback(mctp_eid_t eid);
+
+    /** @brief Drop the inventory details of an FD
+     *
+     *  @param[in] eid - Remote MCTP endpoint
+     */
+    void eraseFD(mctp_eid_t eid);
+
+    /** @brief reference to PLDM daemon's main event loop */
+    sdeventplus::Event& event;
 
     /** @brief PLDM request handler */
     pldm::requester::Handler<pldm::requester::Request>& handler;
@@ -101,6 +200,15 @@ class InventoryManager
 
     /** @brief Component information needed for the update of the managed FDs */
     ComponentInfoMap& componentInfoMap;
+
+    /** @brief Index of the device identifiers to the managed FDs */
+    DescriptorIndex& descriptorIndex;
+
+    /** @brief Time allowed for an FD to complete the discovery */
+    std::chrono::milliseconds discoveryTimeout;
+
+    /** @brief Discovery state of the FDs being discovered */
+    std::unordered_map<mctp_eid_t, DiscoveryState> discoveryStates;
 };
 
 } // namespace fw_update
@@ -4,6 +4,7 @@
 
 #include "activation.hpp"
 #include "common/types.hpp"
+#include "descriptor_index.hpp"
 #include "device_updater.hpp"
 #include "inventory_manager.hpp"
 #include "pldmd/dbus_impl_requester.hpp"
@@ -43,9 +44,11 @@ class Manager
     explicit Manager(Event& event,
                      requester::Handler<requester::Request>& handler,
                      Requester& requester) :
-        inventoryMgr(handler, requester, descriptorMap, componentInfoMap),
+        descriptorIndex(descriptorMap),
+        inventoryMgr(event, handler, requester, descriptorMap,
+                     componentInfoMap, descriptorIndex),
         updateManager(event, handler, requester, descriptorMap,
-                      componentInfoMap)
+                      componentInfoMap, descriptorIndex)
     {}
 
     /** @brief Discover MCTP endpoints that support the PLDM firmware update
@@ -60,6 +63,16 @@ class Manager
         inventoryMgr.discoverFDs(eids);
     }
 
+    /** @brief Remove MCTP endpoints that are no longer present from the
+     *         firmware inventory
+     *
+     *  @param[in] eids - Array of MCTP endpoints
+     */
+    void handleRemovedMCTPEndpoints(const std::vector<mctp_eid_t>& eids)
+    {
+        inventoryMgr.removeFDs(eids);
+    }
+
     /** @brief Handle PLDM request for the commands in the FW update
      *         specification
      *
@@ -82,6 +95,9 @@ class Manager
     /** Component information of all the discovered MCTP endpoints */
     ComponentInfoMap componentInfoMap;
 
+    /** Index of the descriptors to the discovered MCTP endpoints */
+    DescriptorIndex descriptorIndex;
+
     /** @brief PLDM firmware inventory manager */
     InventoryManager inventoryMgr;
 
@@ -0,0 +1,106 @@
+#include "libpldm/firmware_update.h"
+
+#include "fw-update/descriptor_index.hpp"
+
+#include <gtest/gtest.h>
+
+using namespace pldm;
+using namespace pldm::fw_update;
+
+class DescriptorIndexTest : public testing::Test
+{
+  protected:
+    DescriptorIndexTest() : descriptorIndex(descriptorMap)
+    {
+        descriptorMap = {
+            {1,
+             {{PLDM_FWUP_IANA_ENTERPRISE_ID,
+               std::vector<uint8_t>{0x0a, 0x0b, 0x0c, 0x0d}},
+              {PLDM_FWUP_UUID,
+               std::vector<uint8_t>{0x12, 0x44, 0xd2, 0x64, 0x8d, 0x7d, 0x47,
+                                    0x18, 0xa0, 0x30, 0xfc, 0x8a, 0x56, 0x58,
+                                    0x7d, 0x5b}},
+              {PLDM_FWUP_VENDOR_DEFINED,
+               std::make_tuple("OpenBMC", std::vector<uint8_t>{0x01, 0x02})}}},
+            {2,
+             {{PLDM_FWUP_IANA_ENTERPRISE_ID,
+               std::vector<uint8_t>{0x0a, 0x0b, 0x0c, 0x0d}},
+              {PLDM_FWUP_UUID,
+               std::vector<uint8_t>{0xf0, 0x18, 0x87, 0x8c, 0xcb, 0x7d, 0x49,
+                                    0x43, 0x98, 0x00, 0xa0, 0x2f, 0x59, 0x9a,
+                                    0xca, 0x02}}}},
+            {3,
+             {{PLDM_FWUP_IANA_ENTERPRISE_ID,
+               std::vector<uint8_t>{0x0a, 0x0b, 0x0c, 0x0d}},
+              {PLDM_FWUP_UUID,
+               std::vector<uint8_t>{0x12, 0x44, 0xd2, 0x64, 0x8d, 0x7d, 0x47,
+                                    0x18, 0xa0, 0x30, 0xfc, 0x8a, 0x56, 0x58,
+                                    0x7d, 0x5b}}}}};
+        for (const auto& [eid, descriptors] : descriptorMap)
+        {
+            descriptorIndex.add(eid, descriptors);
+        }
+    }
+
+    DescriptorMap descriptorMap;
+    DescriptorIndex descriptorIndex;
+};
+
+TEST_F(DescriptorIndexTest, matchSingleDescriptor)
+{
+    Descriptors record{{PLDM_FWUP_UUID,
+                        std::vector<uint8_t>{0xf0, 0x18, 0x87, 0x8c, 0xcb, 0x7d,
+                                             0x49, 0x43, 0x98, 0x00, 0xa0, 0x2f,
+                                             0x59, 0x9a, 0xca, 0x02}}};
+    EXPECT_EQ(descriptorIndex.match(record), std::vector<mctp_eid_t>{2});
+}
+
+TEST_F(DescriptorIndexTest, matchMultipleDevices)
+{
+    Descriptors record{{PLDM_FWUP_IANA_ENTERPRISE_ID,
+                        std::vector<uint8_t>{0x0a, 0x0b, 0x0c, 0x0d}},
+                       {PLDM_FWUP_UUID,
+                        std::vector<uint8_t>{0x12, 0x44, 0xd2, 0x64, 0x8d, 0x7d,
+                                             0x47, 0x18, 0xa0, 0x30, 0xfc, 0x8a,
+                                             0x56, 0x58, 0x7d, 0x5b}}};
+    EXPECT_EQ(descriptorIndex.match(record),
+              (std::vector<mctp_eid_t>{1, 3}));
+
+    Descriptors vendorRecord{
+        {PLDM_FWUP_VENDOR_DEFINED,
+         std::make_tuple("OpenBMC", std::vector<uint8_t>{0x01, 0x02})}};
+    EXPECT_EQ(descriptorIndex.match(vendorRecord),
+              std::vector<mctp_eid_t>{1});
+}
+
+TEST_F(DescriptorIndexTest, noMatch)
+{
+    Descriptors record{{PLDM_FWUP_IANA_ENTERPRISE_ID,
+                        std::vector<uint8_t>{0x0a, 0x0b, 0x0c, 0x0e}}};
+    EXPECT_TRUE(descriptorIndex.match(record).empty());
+
+    Descriptors vendorRecord{
+        {PLDM_FWUP_VENDOR_DEFINED,
+         std::make_tuple("OpenBMC", std::vector<uint8_t>{0x01, 0x03})}};
+    EXPECT_TRUE(descriptorIndex.match(vendorRecord).empty());
+}
+
+TEST_F(DescriptorIndexTest, removeAndReplaceDevice)
+{
+    Descriptors record{{PLDM_FWUP_IANA_ENTERPRISE_ID,
+                        std::vector<uint8_t>{0x0a, 0x0b, 0x0c, 0x0d}}};
+    EXPECT_EQ(descriptorIndex.match(record),
+              (std::vector<mctp_eid_t>{1, 2, 3}));
+
+    descriptorIndex.remove(2);
+    descriptorMap.erase(2);
+    EXPECT_EQ(descriptorIndex.size(), 2);
+    EXPECT_EQ(descriptorIndex.match(record),
+              (std::vector<mctp_eid_t>{1, 3}));
+
+    descriptorMap[3] = {{PLDM_FWUP_IANA_ENTERPRISE_ID,
+                         std::vector<uint8_t>{0x0a, 0x0b, 0x0c, 0x0e}}};
+    descriptorIndex.add(3, descriptorMap[3]);
+    EXPECT_EQ(descriptorIndex.size(), 2);
+    EXPECT_EQ(descriptorIndex.match(record), std::vector<mctp_eid_t>{1});
+}
@@ -4,6 +4,11 @@
 #include "fw-update/inventory_manager.hpp"
 #include "requester/test/mock_request.hpp"
 
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <optional>
+
 #include <gtest/gtest.h>
 
 using namespace pldm;
@@ -19,17 +24,20 @@ class InventoryManagerTest : public testing::Test
                           "/xyz/openbmc_project/pldm"),
         reqHandler(fd, event, dbusImplRequester, false, 90000, seconds(1), 2,
                    milliseconds(100)),
-        inventoryManager(reqHandler, dbusImplRequester, outDescriptorMap,
-                         outComponentInfoMap)
+        descriptorIndex(outDescriptorMap),
+        inventoryManager(event, reqHandler, dbusImplRequester,
+                         outDescriptorMap, outComponentInfoMap,
+                         descriptorIndex)
     {}
 
     int fd = -1;
     sdeventplus::Event event;
     pldm::dbus_api::Requester dbusImplRequester;
     requester::Handler<requester::Request> reqHandler;
-    InventoryManager inventoryManager;
     DescriptorMap outDescriptorMap{};
     ComponentInfoMap outComponentInfoMap{};
+    DescriptorIndex descriptorIndex;
+    InventoryManager inventoryManager;
 };
 
 TEST_F(InventoryManagerTest, handleQueryDeviceIdentifiersResponse)
@@ -186,3 +194,184 @@ TEST_F(InventoryManagerTest, getFirmwareParametersResponseErrorCC)
     inventoryManager.getFirmwareParameters(1, responseMsg, respPayloadLength);
     EXPECT_EQ(outComponentInfoMap.size(), 0);
 }
+
+class InventoryDiscoveryTest : public testing::Test
+{
+  protected:
+    InventoryDiscoveryTest() :
+        event(sdeventplus::Event::get_default()),
+        dbusImplRequester(pldm::utils::DBusHandler::getBus(),
+                          "/xyz/openbmc_project/pldm"),
+        descriptorIndex(outDescriptorMap)
+    {
+        EXPECT_EQ(socketpair(AF_UNIX, SOCK_SEQPACKET, 0, fds), 0);
+        reqHandler = std::make_unique<requester::Handler<requester::Request>>(
+            fds[1], event, dbusImplRequester, 0, false, seconds(1), 2,
+            milliseconds(100));
+        inventoryManager = std::make_unique<InventoryManager>(
+            event, *reqHandler, dbusImplRequester, outDescriptorMap,
+            outComponentInfoMap, descriptorIndex, discoveryTimeout);
+    }
+
+    ~InventoryDiscoveryTest()
+    {
+        inventoryManager.reset();
+        reqHandler.reset();
+        close(fds[0]);
+        close(fds[1]);
+    }
+
+    /** @brief Request sent to an FD, the EID and MCTP message type followed
+     *         by the PLDM message, std::nullopt if nothing was sent
+     */
+    std::optional<std::vector<uint8_t>> sent()
+    {
+        std::vector<uint8_t> message(UINT16_MAX);
+        auto length = recv(fds[0], message.data(), message.size(),
+                           MSG_DONTWAIT);
+        if (length < 0)
+        {
+            return std::nullopt;
+        }
+        message.resize(length);
+        return message;
+    }
+
+    /** @brief Hand a response to the request handler, as pldmd does */
+    void respond(const std::vector<uint8_t>& request,
+                 std::vector<uint8_t> response)
+    {
+        auto requestMsg = reinterpret_cast<const pldm_msg*>(&request[2]);
+        auto responseMsg = reinterpret_cast<pldm_msg*>(response.data());
+        responseMsg->hdr.instance_id = requestMsg->hdr.instance_id;
+        reqHandler->handleResponse(
+            request[0], requestMsg->hdr.instance_id, requestMsg->hdr.type,
+            requestMsg->hdr.command, responseMsg,
+            response.size() - sizeof(pldm_msg_hdr));
+    }
+
+    void runFor(milliseconds duration)
+    {
+        auto end = steady_clock::now() + duration;
+        while (steady_clock::now() < end)
+        {
+            event.run(microseconds(milliseconds(10)));
+        }
+    }
+
+    static constexpr milliseconds discoveryTimeout{50};
+
+    static std::vector<uint8_t> queryDeviceIdentifiersResp()
+    {
+        return {0x00, 0x00, 0x00, 0x00, 0x2b, 0x00, 0x00, 0x00, 0x03, 0x01,
+                0x00, 0x04, 0x00, 0x0a, 0x0b, 0x0c, 0x0d, 0x02, 0x00, 0x10,
+                0x00, 0x12, 0x44, 0xd2, 0x64, 0x8d, 0x7d, 0x47, 0x18, 0xa0,
+                0x30, 0xfc, 0x8a, 0x56, 0x58, 0x7d, 0x5b, 0xFF, 0xFF, 0x0B,
+                0x00, 0x01, 0x07, 0x4f, 0x70, 0x65, 0x6e, 0x42, 0x4d, 0x43,
+                0x01, 0x02};
+    }
+
+    static std::vector<uint8_t> getFirmwareParametersResp()
+    {
+        return {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00,
+                0x01, 0x0c, 0x00, 0x00, 0x44, 0x65, 0x76, 0x69, 0x63, 0x65,
+                0x56, 0x65, 0x72, 0x32, 0x2e, 0x30, 0x02, 0x00, 0x2e, 0x01,
+                0x28, 0x00, 0x00, 0x00, 0x00, 0x01, 0x09, 0x00, 0x00, 0x00,
+                0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+                0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+                0x02, 0x00, 0x00, 0x00, 0x00, 0x00, 0x43, 0x6f, 0x6d, 0x70,
+                0x33, 0x76, 0x34, 0x2e, 0x30};
+    }
+
+    static uint8_t command(const std::vector<uint8_t>& request)
+    {
+        return reinterpret_cast<const pldm_msg*>(&request[2])->hdr.command;
+    }
+
+    int fds[2] = {-1, -1};
+    sdeventplus::Event event;
+    pldm::dbus_api::Requester dbusImplRequester;
+    std::unique_ptr<requester::Handler<requester::Request>> reqHandler;
+    DescriptorMap outDescriptorMap{};
+    ComponentInfoMap outComponentInfoMap{};
+    DescriptorIndex descriptorIndex;
+    std::unique_ptr<InventoryManager> inventoryManager;
+};
+
+TEST_F(InventoryDiscoveryTest, defaultDiscoveryTimeout)
+{
+    // Both the inventory commands complete with their retries
+    EXPECT_GE(defaultDiscoveryTimeout, 2 * requestCompletionTime);
+    EXPECT_GE(requestCompletionTime,
+              seconds(INSTANCE_ID_EXPIRATION_INTERVAL));
+    EXPECT_GE(requestCompletionTime,
+              milliseconds((NUMBER_OF_REQUEST_RETRIES + 1) *
+                           RESPONSE_TIME_OUT));
+}
+
+TEST_F(InventoryDiscoveryTest, pipelinedDiscovery)
+{
+    inventoryManager->discoverFDs({1, 2});
+
+    // The FDs are queried together, GetFirmwareParameters waits for the
+    // QueryDeviceIdentifiers response of its FD
+    auto request1 = sent();
+    auto request2 = sent();
+    ASSERT_TRUE(request1 && request2);
+    EXPECT_EQ((*request1)[0], 1);
+    EXPECT_EQ(command(*request1), PLDM_QUERY_DEVICE_IDENTIFIERS);
+    EXPECT_EQ((*request2)[0], 2);
+    EXPECT_EQ(command(*request2), PLDM_QUERY_DEVICE_IDENTIFIERS);
+    EXPECT_FALSE(sent());
+
+    respond(*request1, queryDeviceIdentifiersResp());
+    EXPECT_TRUE(outDescriptorMap.contains(1));
+    auto parameters1 = sent();
+    ASSERT_TRUE(parameters1);
+    EXPECT_EQ((*parameters1)[0], 1);
+    EXPECT_EQ(command(*parameters1), PLDM_GET_FIRMWARE_PARAMETERS);
+    EXPECT_FALSE(sent());
+
+    respond(*parameters1, getFirmwareParametersResp());
+    EXPECT_TRUE(outComponentInfoMap.contains(1));
+    EXPECT_EQ(descriptorIndex.match(outDescriptorMap.at(1)),
+              std::vector<mctp_eid_t>{1});
+    EXPECT_FALSE(outDescriptorMap.contains(2));
+}
+
+TEST_F(InventoryDiscoveryTest, discoveryTimeout)
+{
+    inventoryManager->discoverFDs({1});
+    auto request = sent();
+    ASSERT_TRUE(request);
+    EXPECT_EQ(command(*request), PLDM_QUERY_DEVICE_IDENTIFIERS);
+
+    runFor(2 * discoveryTimeout);
+
+    // The responses after the timeout do not add the FD
+    respond(*request, queryDeviceIdentifiersResp());
+    auto parameters = sent();
+    while (parameters && command(*parameters) != PLDM_GET_FIRMWARE_PARAMETERS)
+    {
+        parameters = sent();
+    }
+    ASSERT_TRUE(parameters);
+    respond(*parameters, getFirmwareParametersResp());
+    EXPECT_TRUE(outDescriptorMap.empty());
+    EXPECT_TRUE(outComponentInfoMap.empty());
+
+    // A rediscovery of the FD completes
+    inventoryManager->discoverFDs({1});
+    request = sent();
+    while (request && command(*request) != PLDM_QUERY_DEVICE_IDENTIFIERS)
+    {
+        request = sent();
+    }
+    ASSERT_TRUE(request);
+    respond(*request, queryDeviceIdentifiersResp());
+    parameters = sent();
+    ASSERT_TRUE(parameters);
+    respond(*parameters, getFirmwareParametersResp());
+    EXPECT_TRUE(outDescriptorMap.contains(1));
+    EXPECT_TRUE(outComponentInfoMap.contains(1));
+}
@@ -123,7 +123,7 @@ int UpdateManager::processPackage(const std::filesystem::path& packageFilePath)
     }
 
     auto deviceUpdaterInfos =
-        associatePkgToDevices(parser->getFwDeviceIDRecords(), descriptorMap,
+        associatePkgToDevices(parser->getFwDeviceIDRecords(),
                               totalNumComponentUpdates);
     if (!deviceUpdaterInfos.size())
     {
@@ -145,6 +145,16 @@ int UpdateManager::processPackage(const std::filesystem::path& packageFilePath)
         const auto& fwDeviceIDRecord =
             fwDeviceIDRecords[deviceUpdaterInfo.second];
         auto search = componentInfoMap.find(deviceUpdaterInfo.first);
+        if (search == componentInfoMap.end())
+        {
+            // Discovery of the FD has not completed yet, its components are
+            // not updated
+            error("Component information not found for the FD, EID={EID}",
+                  "EID", unsigned(deviceUpdaterInfo.first));
+            totalNumComponentUpdates -=
+                std::get<ApplicableComponents>(fwDeviceIDRecord).size();
+            continue;
+        }
         deviceUpdaterMap.emplace(
             deviceUpdaterInfo.first,
             std::make_unique<DeviceUpdater>(
@@ -152,6 +162,20 @@ int UpdateManager::processPackage(const std::filesystem::path& packageFilePath)
                 compImageInfos, search->second, MAXIMUM_TRANSFER_SIZE, this));
     }
 
+    if (deviceUpdaterMap.empty())
+    {
+        error(
+            "No matching device has completed discovery, PACKAGE_VERSION={PKG_VERS}",
+            "PKG_VERS", parser->pkgVersion);
+        activation = std::make_unique<Activation>(
+            pldm::utils::DBusHandler::getBus(), objPath,
+            software::Activation::Activations::Invalid, this);
+        totalNumComponentUpdates = 0;
+        package.close();
+        parser.reset();
+        return 0;
+    }
+
     fwPackageFilePath = packageFilePath;
     activation = std::make_unique<Activation>(
         pldm::utils::DBusHandler::getBus(), objPath,
@@ -164,7 +188,6 @@ int UpdateManager::processPackage(const std::filesystem::path& packageFilePath)
 
 DeviceUpdaterInfos UpdateManager::associatePkgToDevices(
     const FirmwareDeviceIDRecords& fwDeviceIDRecords,
-    const DescriptorMap& descriptorMap,
     TotalComponentUpdates& totalNumComponentUpdates)
 {
     DeviceUpdaterInfos deviceUpdaterInfos;
@@ -172,17 +195,12 @@ DeviceUpdaterInfos UpdateManager::associatePkgToDevices(
     {
         const auto& deviceIDDescriptors =
             std::get<Descriptors>(fwDeviceIDRecords[index]);
-        for (const auto& [eid, descriptors] : descriptorMap)
+        for (const auto& eid : descriptorIndex.match(deviceIDDescriptors))
         {
-            if (std::includes(descriptors.begin(), descriptors.end(),
-                              deviceIDDescriptors.begin(),
-                              deviceIDDescriptors.end()))
-            {
-                deviceUpdaterInfos.emplace_back(std::make_pair(eid, index));
-                const auto& applicableComponents =
-                    std::get<ApplicableComponents>(fwDeviceIDRecords[index]);
-                totalNumComponentUpdates += applicableComponents.size();
-            }
+            deviceUpdaterInfos.emplace_back(std::make_pair(eid, index));
+            const auto& applicableComponents =
+                std::get<ApplicableComponents>(fwDeviceIDRecords[index]);
+            totalNumComponentUpdates += applicableComponents.size();
         }
     }
     return deviceUpdaterInfos;
@@ -4,6 +4,7 @@
 #include "libpldm/pldm.h"
 
 #include "common/types.hpp"
+#include "descriptor_index.hpp"
 #include "device_updater.hpp"
 #include "package_parser.hpp"
 #include "pldmd/dbus_impl_requester.hpp"
@@ -49,10 +50,11 @@ class UpdateManager
         Event& event,
         pldm::requester::Handler<pldm::requester::Request>& handler,
         Requester& requester, const DescriptorMap& descriptorMap,
-        const ComponentInfoMap& componentInfoMap) :
+        const ComponentInfoMap& componentInfoMap,
+        const DescriptorIndex& descriptorIndex) :
         event(event),
         handler(handler), requester(requester), descriptorMap(descriptorMap),
-        componentInfoMap(componentInfoMap),
+        componentInfoMap(componentInfoMap), descriptorIndex(descriptorIndex),
         watch(event.get(),
               std::bind_front(&UpdateManager::processPackage, this))
     {}
@@ -84,12 +86,17 @@ class UpdateManager
 
     void clearActivationInfo();
 
-    /** @brief
+    /** @brief Associate the FirmwareDeviceIDRecords in the package with the
+     *         firmware devices, using the descriptor index
      *
+     *  @param[in] fwDeviceIDRecords - FirmwareDeviceIDRecords in the package
+     *  @param[out] totalNumComponentUpdates - Total number of component
+     *                                         updates for the matching FDs
+     *
+     *  @return the matching FDs and the offset of the matching record
      */
     DeviceUpdaterInfos
         associatePkgToDevices(const FirmwareDeviceIDRecords& fwDeviceIDRecords,
-                              const DescriptorMap& descriptorMap,
                               TotalComponentUpdates& totalNumComponentUpdates);
 
     const std::string swRootPath{"/xyz/openbmc_project/software/"};
@@ -103,6 +110,8 @@ class UpdateManager
     const DescriptorMap& descriptorMap;
     /** @brief Component information needed for the update of the managed FDs */
     const ComponentInfoMap& componentInfoMap;
+    /** @brief Index of the device identifiers to the managed FDs */
+    const DescriptorIndex& descriptorIndex;
     Watch watch;
 
     std::unique_ptr<Activation> activation;
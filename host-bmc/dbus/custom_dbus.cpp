@@ -15,21 +15,23 @@ namespace dbus
 {
 void CustomDBus::setLocationCode(const std::string& path, std::string value)
 {
-    if (location.find(path) == location.end())
-    {
-        location.emplace(path,
-                         std::make_unique<LocationCode>(
-                             pldm::utils::DBusHandler::getBus(), path.c_str()));
-    }
-
-    location.at(path)->locationCode(value);
+    materialize(path);
+    implement<LocationCode>(path).locationCode(value);
 }
 
 std::string CustomDBus::getLocationCode(const std::string& path) const
 {
-    if (location.find(path) != location.end())
+    if (auto* location = registry.get<LocationCode>(path))
+    {
+        return location->locationCode();
+    }
+    if (lazyObjects)
     {
-        return location.at(path)->locationCode();
+        auto value = lazyObjects->getProperty(path, "LocationCode");
+        if (value)
+        {
+            return std::get<std::string>(*value);
+        }
     }
 
     return {};
@@ -37,22 +39,23 @@ std::string CustomDBus::getLocationCode(const std::string& path) const
 
 void CustomDBus::setSoftwareVersion(const std::string& path, std::string value)
 {
-    if (softWareVersion.find(path) == softWareVersion.end())
+    materialize(path);
+    auto* softWareVersion = registry.get<SoftWareVersion>(path);
+    if (!softWareVersion)
     {
-        softWareVersion.emplace(
-            path, std::make_unique<SoftWareVersion>(
-                      pldm::utils::DBusHandler::getBus(), path.c_str()));
-        softWareVersion.at(path)->purpose(
+        softWareVersion = &implement<SoftWareVersion>(path);
+        softWareVersion->purpose(
             sdbusplus::xyz::openbmc_project::Software::server::Version::
                 VersionPurpose::Other);
     }
 
-    softWareVersion.at(path)->version(value);
+    softWareVersion->version(value);
 }
 
 void CustomDBus::setOperationalStatus(const std::string& path, bool status,
                                       const std::string& parentChassis)
 {
+    materialize(path);
     if (!status && parentChassis != "")
     {
         // If we get operational status as false for any FRU, then set
@@ -62,21 +65,22 @@ void CustomDBus::setOperationalStatus(const std::string& path, bool status,
         setAssociations(path, associations);
     }
 
-    if (operationalStatus.find(path) == operationalStatus.end())
-    {
-        operationalStatus.emplace(
-            path, std::make_unique<OperationalStatus>(
-                      pldm::utils::DBusHandler::getBus(), path.c_str()));
-    }
-
-    operationalStatus.at(path)->functional(status);
+    implement<OperationalStatus>(path).functional(status);
 }
 
 bool CustomDBus::getOperationalStatus(const std::string& path) const
 {
-    if (operationalStatus.find(path) != operationalStatus.end())
+    if (auto* operationalStatus = registry.get<OperationalStatus>(path))
     {
-        return operationalStatus.at(path)->functional();
+        return operationalStatus->functional();
+    }
+    if (lazyObjects)
+    {
+        auto value = lazyObjects->getProperty(path, "OperationalStatus");
+        if (value)
+        {
+            return std::get<bool>(*value);
+        }
     }
 
     return false;
@@ -84,76 +88,63 @@ bool CustomDBus::getOperationalStatus(const std::string& path) const
 
 size_t CustomDBus::getBusId(const std::string& path) const
 {
-    if (pcieSlot.find(path) != pcieSlot.end())
+    if (auto* pcieSlot = registry.get<PCIeSlot>(path))
     {
-        return pcieSlot.at(path)->busId();
+        return pcieSlot->busId();
     }
     return 0;
 }
 
 void CustomDBus::implementCableInterface(const std::string& path)
 {
-    if (!cable.contains(path))
-    {
-        cable.emplace(
-            path, std::make_unique<Cable>(pldm::utils::DBusHandler::getBus(),
-                                          path.c_str()));
-    }
+    materialize(path);
+    implement<Cable>(path);
 }
 
 void CustomDBus::updateItemPresentStatus(const std::string& path,
                                          bool isPresent)
 {
-    if (presentStatus.find(path) == presentStatus.end())
-    {
-        presentStatus.emplace(
-            path, std::make_unique<InventoryItem>(
-                      pldm::utils::DBusHandler::getBus(), path.c_str()));
-        std::filesystem::path ObjectPath(path);
-
-        // Hardcode the present dbus property to true
-        presentStatus.at(path)->present(true);
-
-        // Set the pretty name dbus property to the filename
-        // form the dbus path object
-        presentStatus.at(path)->prettyName(ObjectPath.filename());
-    }
-    else
+    materialize(path);
+    if (auto* presentStatus = registry.get<InventoryItem>(path))
     {
         // object is already created
-        presentStatus.at(path)->present(isPresent);
+        presentStatus->present(isPresent);
+        return;
     }
+
+    auto& presentStatus = implement<InventoryItem>(path);
+    std::filesystem::path ObjectPath(path);
+
+    // Hardcode the present dbus property to true
+    presentStatus.present(true);
+
+    // Set the pretty name dbus property to the filename
+    // form the dbus path object
+    presentStatus.prettyName(ObjectPath.filename());
 }
 
 void CustomDBus::implementChassisInterface(const std::string& path)
 {
-    if (chassis.find(path) == chassis.end())
-    {
-        chassis.emplace(path,
-                        std::make_unique<ItemChassis>(
-                            pldm::utils::DBusHandler::getBus(), path.c_str()));
-    }
+    materialize(path);
+    implement<ItemChassis>(path);
 }
 
 void CustomDBus::implementPCIeSlotInterface(const std::string& path)
 {
-    if (pcieSlot.find(path) == pcieSlot.end())
-    {
-        pcieSlot.emplace(
-            path, std::make_unique<PCIeSlot>(pldm::utils::DBusHandler::getBus(),
-                                             path.c_str()));
-    }
+    materialize(path);
+    implement<PCIeSlot>(path);
 }
 
 void CustomDBus::setSlotProperties(const std::string& path,
                                    const uint32_t& value,
                                    const std::string& linkState)
 {
+    materialize(path);
     auto linkStatus = pldm::dbus::PCIeSlot::convertStatusFromString(linkState);
-    if (pcieSlot.contains(path))
+    if (auto* pcieSlot = registry.get<PCIeSlot>(path))
     {
-        pcieSlot.at(path)->busId(value);
-        pcieSlot.at(path)->linkStatus(linkStatus);
+        pcieSlot->busId(value);
+        pcieSlot->linkStatus(linkStatus);
     }
 }
 void CustomDBus::setLinkReset(
@@ -161,45 +152,38 @@ void CustomDBus::setLinkReset(
     pldm::host_effecters::HostEffecterParser* hostEffecterParser,
     uint8_t mctpEid)
 {
-    if (!link.contains(path))
-    {
-        link.emplace(path, std::make_unique<Link>(
-                               pldm::utils::DBusHandler::getBus(), path.c_str(),
-                               hostEffecterParser, mctpEid));
-    }
-    link.at(path)->linkReset(value);
+    materialize(path);
+    implement<Link>(path, hostEffecterParser, mctpEid).linkReset(value);
 }
 
 void CustomDBus::setSlotType(const std::string& path,
                              const std::string& slotType)
 {
+    materialize(path);
     auto slottype = pldm::dbus::PCIeSlot::convertSlotTypesFromString(slotType);
-    if (pcieSlot.contains(path))
+    if (auto* pcieSlot = registry.get<PCIeSlot>(path))
     {
-        pcieSlot.at(path)->slotType(slottype);
+        pcieSlot->slotType(slottype);
     }
 }
 
 void CustomDBus::implementPCIeDeviceInterface(const std::string& path)
 {
-    if (!pcieDevice.contains(path))
-    {
-        pcieDevice.emplace(
-            path, std::make_unique<PCIeDevice>(
-                      pldm::utils::DBusHandler::getBus(), path.c_str()));
-    }
+    materialize(path);
+    implement<PCIeDevice>(path);
 }
 
 void CustomDBus::setPCIeDeviceProps(const std::string& path, int64_t lanesInuse,
                                     const std::string& value)
 {
+    materialize(path);
     Generations generationsInuse =
         pldm::dbus::PCIeSlot::convertGenerationsFromString(value);
 
-    if (pcieDevice.contains(path))
+    if (auto* pcieDevice = registry.get<PCIeDevice>(path))
     {
-        pcieDevice.at(path)->lanesInUse(lanesInuse);
-        pcieDevice.at(path)->generationInUse(generationsInuse);
+        pcieDevice->lanesInUse(lanesInuse);
+        pcieDevice->generationInUse(generationsInuse);
     }
 }
 
@@ -207,168 +191,115 @@ void CustomDBus::setCableAttributes(const std::string& path, double length,
                                     const std::string& cableDescription,
                                     const std::string& status)
 {
+    materialize(path);
     pldm::dbus::ItemCable::Status cableStatus =
         pldm::dbus::Cable::convertStatusFromString(status);
-    if (cable.contains(path))
+    if (auto* cable = registry.get<Cable>(path))
     {
-        cable.at(path)->length(length);
-        cable.at(path)->cableTypeDescription(cableDescription);
-        cable.at(path)->cableStatus(cableStatus);
+        cable->length(length);
+        cable->cableTypeDescription(cableDescription);
+        cable->cableStatus(cableStatus);
     }
 }
 
 void CustomDBus::setPartNumber(const std::string& path,
                                const std::string& partNumber)
 {
-    if (asset.contains(path))
+    materialize(path);
+    if (auto* asset = registry.get<Asset>(path))
     {
-        asset.at(path)->partNumber(partNumber);
+        asset->partNumber(partNumber);
     }
 }
 
 void CustomDBus::implementAssetInterface(const std::string& path)
 {
-    if (!asset.contains(path))
-    {
-        asset.emplace(
-            path, std::make_unique<Asset>(pldm::utils::DBusHandler::getBus(),
-                                          path.c_str()));
-    }
+    materialize(path);
+    implement<Asset>(path);
 }
 
 void CustomDBus::implementMotherboardInterface(const std::string& path)
 {
-    if (motherboard.find(path) == motherboard.end())
-    {
-        motherboard.emplace(
-            path, std::make_unique<Motherboard>(
-                      pldm::utils::DBusHandler::getBus(), path.c_str()));
-    }
+    materialize(path);
+    implement<Motherboard>(path);
 }
 void CustomDBus::implementPowerSupplyInterface(const std::string& path)
 {
-    if (powersupply.find(path) == powersupply.end())
-    {
-        powersupply.emplace(
-            path, std::make_unique<PowerSupply>(
-                      pldm::utils::DBusHandler::getBus(), path.c_str()));
-    }
+    materialize(path);
+    implement<PowerSupply>(path);
 }
 
 void CustomDBus::implementFanInterface(const std::string& path)
 {
-    if (fan.find(path) == fan.end())
-    {
-        fan.emplace(path,
-                    std::make_unique<Fan>(pldm::utils::DBusHandler::getBus(),
-                                          path.c_str()));
-    }
+    materialize(path);
+    implement<Fan>(path);
 }
 
 void CustomDBus::implementConnecterInterface(const std::string& path)
 {
-    if (connector.find(path) == connector.end())
-    {
-        connector.emplace(
-            path, std::make_unique<Connector>(
-                      pldm::utils::DBusHandler::getBus(), path.c_str()));
-    }
+    materialize(path);
+    implement<Connector>(path);
 }
 
 void CustomDBus::implementVRMInterface(const std::string& path)
 {
-    if (vrm.find(path) == vrm.end())
-    {
-        vrm.emplace(path,
-                    std::make_unique<VRM>(pldm::utils::DBusHandler::getBus(),
-                                          path.c_str()));
-    }
+    materialize(path);
+    implement<VRM>(path);
 }
 
 void CustomDBus::implementCpuCoreInterface(const std::string& path)
 {
-    if (cpuCore.find(path) == cpuCore.end())
-    {
-        cpuCore.emplace(
-            path, std::make_unique<CPUCore>(pldm::utils::DBusHandler::getBus(),
-                                            path.c_str()));
-    }
+    materialize(path);
+    implement<CPUCore>(path);
 }
 
 void CustomDBus::implementFabricAdapter(const std::string& path)
 {
-    if (fabricAdapter.find(path) == fabricAdapter.end())
-    {
-        fabricAdapter.emplace(
-            path, std::make_unique<FabricAdapter>(
-                      pldm::utils::DBusHandler::getBus(), path.c_str()));
-    }
+    materialize(path);
+    implement<FabricAdapter>(path);
 }
 
 void CustomDBus::implementBoard(const std::string& path)
 {
-    if (board.find(path) == board.end())
-    {
-        board.emplace(
-            path, std::make_unique<Board>(pldm::utils::DBusHandler::getBus(),
-                                          path.c_str()));
-    }
+    materialize(path);
+    implement<Board>(path);
 }
 
 void CustomDBus::implementPanelInterface(const std::string& path)
 {
-    if (panel.find(path) == panel.end())
-    {
-        panel.emplace(
-            path, std::make_unique<Panel>(pldm::utils::DBusHandler::getBus(),
-                                          path.c_str()));
-    }
+    materialize(path);
+    implement<Panel>(path);
 }
 
 void CustomDBus::implementObjectEnableIface(const std::string& path, bool value)
 {
-    if (_enabledStatus.find(path) == _enabledStatus.end())
+    materialize(path);
+    if (!registry.get<Enable>(path))
     {
-        _enabledStatus.emplace(
-            path, std::make_unique<Enable>(pldm::utils::DBusHandler::getBus(),
-                                           path.c_str()));
-        _enabledStatus.at(path)->enabled(value);
+        implement<Enable>(path).enabled(value);
     }
 }
 
 void CustomDBus::implementGlobalInterface(const std::string& path)
 {
-    if (global.find(path) == global.end())
-    {
-        global.emplace(
-            path, std::make_unique<Global>(pldm::utils::DBusHandler::getBus(),
-                                           path.c_str()));
-    }
+    materialize(path);
+    implement<Global>(path);
 }
 
 void CustomDBus::implementPcieTopologyInterface(
     const std::string& path, uint8_t mctpEid,
     pldm::host_effecters::HostEffecterParser* hostEffecterParser)
 {
-    if (pcietopology.find(path) == pcietopology.end())
-    {
-        pcietopology.emplace(path,
-                             std::make_unique<PCIETopology>(
-                                 pldm::utils::DBusHandler::getBus(),
-                                 path.c_str(), hostEffecterParser, mctpEid));
-    }
+    materialize(path);
+    implement<PCIETopology>(path, hostEffecterParser, mctpEid);
 }
 
 void CustomDBus::implementChapDataInterface(
     const std::string& path,
     pldm::responder::oem_fileio::Handler* dbusToFilehandlerObj)
 {
-    if (chapdata.find(path) == chapdata.end())
-    {
-        chapdata.emplace(path, std::make_unique<ChapDatas>(
-                                   pldm::utils::DBusHandler::getBus(),
-                                   path.c_str(), dbusToFilehandlerObj));
-    }
+    materialize(path);
+    implement<ChapDatas>(path, dbusToFilehandlerObj);
 }
 
 void CustomDBus::implementLicInterfaces(
@@ -378,55 +309,39 @@ void CustomDBus::implementLicInterfaces(
     const sdbusplus::com::ibm::License::Entry::server::LicenseEntry::
         AuthorizationType& authtype)
 {
-    if (codLic.find(path) == codLic.end())
-    {
-        codLic.emplace(path,
-                       std::make_unique<LicenseEntry>(
-                           pldm::utils::DBusHandler::getBus(), path.c_str()));
-    }
-
-    codLic.at(path)->authDeviceNumber(authdevno);
-    codLic.at(path)->name(name);
-    codLic.at(path)->serialNumber(serialno);
-    codLic.at(path)->expirationTime(exptime);
-    codLic.at(path)->type(type);
-    codLic.at(path)->authorizationType(authtype);
+    materialize(path);
+    auto& codLic = implement<LicenseEntry>(path);
+    codLic.authDeviceNumber(authdevno);
+    codLic.name(name);
+    codLic.serialNumber(serialno);
+    codLic.expirationTime(exptime);
+    codLic.type(type);
+    codLic.authorizationType(authtype);
 }
 
 void CustomDBus::setAvailabilityState(const std::string& path,
                                       const bool& state)
 {
-    if (availabilityState.find(path) == availabilityState.end())
-    {
-        availabilityState.emplace(
-            path, std::make_unique<Availability>(
-                      pldm::utils::DBusHandler::getBus(), path.c_str()));
-    }
-
-    availabilityState.at(path)->available(state);
+    materialize(path);
+    implement<Availability>(path).available(state);
 }
 void CustomDBus::setAsserted(
     const std::string& path, const pldm_entity& entity, bool value,
     pldm::host_effecters::HostEffecterParser* hostEffecterParser,
     uint8_t mctpEid, bool isTriggerStateEffecterStates)
 {
-    if (ledGroup.find(path) == ledGroup.end())
-    {
-        ledGroup.emplace(
-            path, std::make_unique<LEDGroup>(pldm::utils::DBusHandler::getBus(),
-                                             path.c_str(), hostEffecterParser,
-                                             entity, mctpEid));
-    }
-
-    ledGroup.at(path)->setStateEffecterStatesFlag(isTriggerStateEffecterStates);
-    ledGroup.at(path)->asserted(value);
+    materialize(path);
+    auto& ledGroup =
+        implement<LEDGroup>(path, hostEffecterParser, entity, mctpEid);
+    ledGroup.setStateEffecterStatesFlag(isTriggerStateEffecterStates);
+    ledGroup.asserted(value);
 }
 
 bool CustomDBus::getAsserted(const std::string& path) const
 {
-    if (ledGroup.find(path) != ledGroup.end())
+    if (auto* ledGroup = registry.get<LEDGroup>(path))
     {
-        return ledGroup.at(path)->asserted();
+        return ledGroup->asserted();
     }
 
     return false;
@@ -434,18 +349,18 @@ bool CustomDBus::getAsserted(const std::string& path) const
 
 void CustomDBus::setAssociations(const std::string& path, AssociationsObj assoc)
 {
+    materialize(path);
     using PropVariant = sdbusplus::xyz::openbmc_project::Association::server::
         Definitions::PropertiesVariant;
 
-    if (associations.find(path) == associations.end())
+    auto* associations = registry.get<Associations>(path);
+    if (!associations)
     {
         PropVariant value{std::move(assoc)};
         std::map<std::string, PropVariant> properties;
         properties.emplace("Associations", std::move(value));
 
-        associations.emplace(path, std::make_unique<Associations>(
-                                       pldm::utils::DBusHandler::getBus(),
-                                       path.c_str(), properties));
+        implement<Associations>(path, properties);
     }
     else
     {
@@ -468,163 +383,50 @@ void CustomDBus::setAssociations(const std::string& path, AssociationsObj assoc)
             }
         }
 
-        associations.at(path)->associations(currentAssociations);
+        associations->associations(currentAssociations);
     }
 }
 
 const AssociationsObj CustomDBus::getAssociations(const std::string& path)
 {
-    if (associations.find(path) != associations.end())
+    if (auto* associations = registry.get<Associations>(path))
+    {
+        return associations->associations();
+    }
+    if (lazyObjects)
     {
-        return associations.at(path)->associations();
+        auto value = lazyObjects->getProperty(path, "Associations");
+        if (value)
+        {
+            return std::get<AssociationsObj>(*value);
+        }
     }
     return {};
 }
 
 void CustomDBus::setMicrocode(const std::string& path, uint32_t value)
 {
-    if (cpuCore.find(path) == cpuCore.end())
-    {
-        cpuCore.emplace(
-            path, std::make_unique<CPUCore>(pldm::utils::DBusHandler::getBus(),
-                                            path.c_str()));
-    }
-    cpuCore.at(path)->microcode(value);
+    materialize(path);
+    implement<CPUCore>(path).microcode(value);
 }
 
 void CustomDBus::updateTopologyProperty(bool value)
 {
-    if (pcietopology.contains("/xyz/openbmc_project/pldm"))
+    if (auto* pcietopology =
+            registry.get<PCIETopology>("/xyz/openbmc_project/pldm"))
     {
-        pcietopology.at("/xyz/openbmc_project/pldm")
-            ->pcIeTopologyRefresh(value);
+        pcietopology->pcIeTopologyRefresh(value);
     }
 }
 
 void CustomDBus::deleteObject(const std::string& path)
 {
-    if (location.contains(path))
+    if (lazyObjects)
     {
-        location.erase(location.find(path));
+        lazyObjects->erase(path);
     }
 
-    if (operationalStatus.contains(path))
-    {
-        operationalStatus.erase(operationalStatus.find(path));
-    }
-
-    if (presentStatus.contains(path))
-    {
-        presentStatus.erase(presentStatus.find(path));
-    }
-
-    if (chassis.contains(path))
-    {
-        chassis.erase(chassis.find(path));
-    }
-
-    if (cpuCore.contains(path))
-    {
-        cpuCore.erase(cpuCore.find(path));
-    }
-
-    if (fan.contains(path))
-    {
-        fan.erase(fan.find(path));
-    }
-
-    if (connector.contains(path))
-    {
-        connector.erase(connector.find(path));
-    }
-
-    if (vrm.contains(path))
-    {
-        vrm.erase(vrm.find(path));
-    }
-
-    if (global.contains(path))
-    {
-        global.erase(global.find(path));
-    }
-
-    if (powersupply.contains(path))
-    {
-        powersupply.erase(powersupply.find(path));
-    }
-
-    if (board.contains(path))
-    {
-        board.erase(board.find(path));
-    }
-
-    if (fabricAdapter.contains(path))
-    {
-        fabricAdapter.erase(fabricAdapter.find(path));
-    }
-
-    if (motherboard.contains(path))
-    {
-        motherboard.erase(motherboard.find(path));
-    }
-
-    if (availabilityState.contains(path))
-    {
-        availabilityState.erase(availabilityState.find(path));
-    }
-
-    if (_enabledStatus.contains(path))
-    {
-        _enabledStatus.erase(_enabledStatus.find(path));
-    }
-
-    if (pcieSlot.contains(path))
-    {
-        pcieSlot.erase(pcieSlot.find(path));
-    }
-
-    if (codLic.contains(path))
-    {
-        codLic.erase(codLic.find(path));
-    }
-
-    if (associations.contains(path))
-    {
-        associations.erase(associations.find(path));
-    }
-
-    if (ledGroup.contains(path))
-    {
-        ledGroup.erase(ledGroup.find(path));
-    }
-
-    if (softWareVersion.contains(path))
-    {
-        softWareVersion.erase(softWareVersion.find(path));
-    }
-
-    if (cable.contains(path))
-    {
-        cable.erase(cable.find(path));
-    }
-    if (asset.contains(path))
-    {
-        asset.erase(asset.find(path));
-    }
-
-    if (pcieDevice.contains(path))
-    {
-        pcieDevice.erase(pcieDevice.find(path));
-    }
-
-    if (link.contains(path))
-    {
-        link.erase(link.find(path));
-    }
-    if (panel.contains(path))
-    {
-        panel.erase(panel.find(path));
-    }
+    registry.erase(path);
 }
 
 void CustomDBus::removeDBus(const std::vector<uint16_t> types)
@@ -651,5 +453,18 @@ void CustomDBus::removeDBus(const std::vector<uint16_t> types)
     }
 }
 
+void CustomDBus::setLazyObjects(std::unique_ptr<LazyObjects> objects)
+{
+    lazyObjects = std::move(objects);
+}
+
+void CustomDBus::materialize(const std::string& path)
+{
+    if (lazyObjects)
+    {
+        lazyObjects->materialize(path);
+    }
+}
+
 } // namespace dbus
 } // namespace pldm
@@ -18,11 +18,13 @@
 #include "fan.hpp"
 #include "global.hpp"
 #include "inventory_item.hpp"
+#include "lazy_objects.hpp"
 #include "led_group.hpp"
 #include "license_entry.hpp"
 #include "linkreset.hpp"
 #include "location_code.hpp"
 #include "motherboard.hpp"
+#include "object_registry.hpp"
 #include "operational_status.hpp"
 #include "panel.hpp"
 #include "pcie_device.hpp"
@@ -39,6 +41,7 @@
 #include <map>
 #include <memory>
 #include <string>
+#include <utility>
 
 namespace pldm
 {
@@ -47,6 +50,15 @@ namespace dbus
 
 using ObjectPath = std::string;
 
+/** @brief Interface objects of the PLDM D-Bus objects */
+using Registry =
+    ObjectRegistry<LocationCode, OperationalStatus, InventoryItem, ItemChassis,
+                   CPUCore, Fan, Connector, VRM, Global, PowerSupply, Board,
+                   FabricAdapter, Motherboard, Availability, Enable, PCIeSlot,
+                   LicenseEntry, Associations, LEDGroup, SoftWareVersion,
+                   PCIETopology, ChapDatas, PCIeDevice, Cable, Asset, Link,
+                   Panel>;
+
 /** @class CustomDBus
  *  @brief This is a custom D-Bus object, used to add D-Bus interface and
  * update the corresponding properties value.
@@ -317,39 +329,53 @@ class CustomDBus
         pldm::host_effecters::HostEffecterParser* hostEffecterParser,
         uint8_t instanceId);
 
+    /** @brief Serve the restored objects from a table, an object is
+     *         materialized when it is updated through this class
+     *
+     *  @param[in] objects - restored objects
+     */
+    void setLazyObjects(std::unique_ptr<LazyObjects> objects);
+
+    /** @brief Memory used by the interface objects registry
+     *
+     *  @return the registry stats
+     */
+    Registry::Stats getRegistryStats() const
+    {
+        return registry.stats();
+    }
+
   private:
-    std::unordered_map<ObjectPath, std::unique_ptr<LocationCode>> location;
-    std::unordered_map<ObjectPath, std::unique_ptr<OperationalStatus>>
-        operationalStatus;
-    std::unordered_map<ObjectPath, std::unique_ptr<InventoryItem>>
-        presentStatus;
-    std::unordered_map<ObjectPath, std::unique_ptr<ItemChassis>> chassis;
-    std::unordered_map<ObjectPath, std::unique_ptr<CPUCore>> cpuCore;
-    std::unordered_map<ObjectPath, std::unique_ptr<Fan>> fan;
-    std::unordered_map<ObjectPath, std::unique_ptr<Connector>> connector;
-    std::unordered_map<ObjectPath, std::unique_ptr<VRM>> vrm;
-    std::unordered_map<ObjectPath, std::unique_ptr<Global>> global;
-    std::unordered_map<ObjectPath, std::unique_ptr<PowerSupply>> powersupply;
-    std::unordered_map<ObjectPath, std::unique_ptr<Board>> board;
-    std::unordered_map<ObjectPath, std::unique_ptr<FabricAdapter>>
-        fabricAdapter;
-    std::unordered_map<ObjectPath, std::unique_ptr<Motherboard>> motherboard;
-    std::unordered_map<ObjectPath, std::unique_ptr<Availability>>
-        availabilityState;
-    std::unordered_map<ObjectPath, std::unique_ptr<Enable>> _enabledStatus;
-    std::unordered_map<ObjectPath, std::unique_ptr<PCIeSlot>> pcieSlot;
-    std::unordered_map<ObjectPath, std::unique_ptr<LicenseEntry>> codLic;
-    std::unordered_map<ObjectPath, std::unique_ptr<Associations>> associations;
-    std::unordered_map<ObjectPath, std::unique_ptr<LEDGroup>> ledGroup;
-    std::unordered_map<ObjectPath, std::unique_ptr<SoftWareVersion>>
-        softWareVersion;
-    std::unordered_map<ObjectPath, std::unique_ptr<PCIETopology>> pcietopology;
-    std::unordered_map<ObjectPath, std::unique_ptr<ChapDatas>> chapdata;
-    std::unordered_map<ObjectPath, std::unique_ptr<PCIeDevice>> pcieDevice;
-    std::unordered_map<ObjectPath, std::unique_ptr<Cable>> cable;
-    std::unordered_map<ObjectPath, std::unique_ptr<Asset>> asset;
-    std::unordered_map<ObjectPath, std::unique_ptr<Link>> link;
-    std::unordered_map<ObjectPath, std::unique_ptr<Panel>> panel;
+    /** @brief Create the sdbusplus objects of a restored object served from
+     *         the table, before it is updated
+     *
+     *  @param[in] path - The object path
+     */
+    void materialize(const std::string& path);
+
+    /** @brief Interface object of an object, created if the object does
+     *         not implement the interface yet
+     *
+     *  @param[in] path - The object path
+     *  @param[in] args - constructor arguments after the bus and the path
+     *
+     *  @return the interface object
+     */
+    template <typename T, typename... Args>
+    T& implement(const std::string& path, Args&&... args)
+    {
+        if (auto* object = registry.get<T>(path))
+        {
+            return *object;
+        }
+        auto object = std::make_unique<T>(pldm::utils::DBusHandler::getBus(),
+                                          path.c_str(),
+                                          std::forward<Args>(args)...);
+        return registry.emplace(registry.intern(path), std::move(object));
+    }
+
+    std::unique_ptr<LazyObjects> lazyObjects;
+    Registry registry;
 };
 
 } // namespace dbus
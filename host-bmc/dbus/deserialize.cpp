@@ -2,11 +2,14 @@
 
 #include "libpldm/pdr.h"
 
+#include "common/json_cache.hpp"
 #include "custom_dbus.hpp"
+#include "lazy_objects.hpp"
 #include "serialize.hpp"
 
 #include <nlohmann/json.hpp>
 #include <phosphor-logging/lg2.hpp>
+#include <sdeventplus/event.hpp>
 
 PHOSPHOR_LOG2_USING;
 
@@ -188,8 +191,16 @@ std::pair<std::set<uint16_t>, std::set<uint16_t>>
 
     try
     {
-        std::ifstream jsonFile(path);
-        auto json = Json::parse(jsonFile);
+        Json json;
+        if (auto cached = pldm::utils::JsonCache::get().take(path))
+        {
+            json = std::move(*cached);
+        }
+        else
+        {
+            std::ifstream jsonFile(path);
+            json = Json::parse(jsonFile);
+        }
 
         // define the default JSON as empty
         const std::set<uint16_t> empty{};
@@ -217,6 +228,26 @@ std::pair<std::set<uint16_t>, std::set<uint16_t>>
     return std::make_pair(restoreTypes, storeTypes);
 }
 
+/** @brief Create the sdbusplus objects of a restored object
+ *
+ *  @param[in] path - object path
+ *  @param[in] interfaces - persisted interfaces of the object
+ */
+static void restoreInterfaces(const std::string& path,
+                              const dbus::LazyObjects::Interfaces& interfaces)
+{
+    for (const auto& [name, propertyValue] : interfaces)
+    {
+        if (!ibmDbusHandler.contains(name))
+        {
+            error("name is not in ibmDbusHandler, name = {NAME}", "NAME",
+                  name);
+            continue;
+        }
+        ibmDbusHandler.at(name)(path, propertyValue);
+    }
+}
+
 void restoreDbusObj(HostPDRHandler* hostPDRHandler)
 {
     if (hostPDRHandler == nullptr)
@@ -228,13 +259,24 @@ void restoreDbusObj(HostPDRHandler* hostPDRHandler)
     pldm::serialize::Serialize::getSerialize().setEntityTypes(
         entityTypes.second);
 
-    if (!pldm::serialize::Serialize::getSerialize().deserialize())
+    // The saved objects are read once, when the instance is created
+    if (!pldm::serialize::Serialize::getSerialize().isRestored())
     {
         return;
     }
 
     auto savedObjs = pldm::serialize::Serialize::getSerialize().getSavedObjs();
 
+#ifdef DBUS_LAZY_RESTORE
+    // The inventory objects are served from a table and announced in
+    // batches, they are created when pldmd updates them
+    auto event = sdeventplus::Event::get_default();
+    auto lazyObjects = std::make_unique<dbus::LazyObjects>(
+        pldm::utils::DBusHandler::getBus(), event,
+        "/xyz/openbmc_project/inventory", DBUS_ANNOUNCE_BATCH_SIZE,
+        restoreInterfaces);
+#endif
+
     for (auto& [type, objs] : savedObjs)
     {
         if (!entityTypes.first.contains(type))
@@ -252,18 +294,23 @@ void restoreDbusObj(HostPDRHandler* hostPDRHandler)
             hostPDRHandler->updateObjectPathMaps(
                 path,
                 init_pldm_entity_node(node, parent, 0, nullptr, nullptr, 0));
-            for (auto& [name, propertyValue] : obj)
+#ifdef DBUS_LAZY_RESTORE
+            if (lazyObjects->add(path, obj))
             {
-                if (!ibmDbusHandler.contains(name))
-                {
-                    error("name is not in ibmDbusHandler, name = {NAME}",
-                          "NAME", name);
-                    continue;
-                }
-                ibmDbusHandler.at(name)(path, propertyValue);
+                continue;
             }
+#endif
+            restoreInterfaces(path, obj);
         }
     }
+
+#ifdef DBUS_LAZY_RESTORE
+    info("Serving {COUNT} restored D-Bus objects lazily", "COUNT",
+         lazyObjects->size());
+    lazyObjects->announce();
+    pldm::dbus::CustomDBus::getCustomDBus().setLazyObjects(
+        std::move(lazyObjects));
+#endif
 }
 
 } // namespace deserialize
@@ -0,0 +1,453 @@
+#include "lazy_objects.hpp"
+
+#include <phosphor-logging/lg2.hpp>
+#include <sdbusplus/message.hpp>
+#include <sdbusplus/vtable.hpp>
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <variant>
+
+PHOSPHOR_LOG2_USING;
+
+namespace pldm
+{
+namespace dbus
+{
+
+/** @struct LazyObjects::Interface
+ *
+ *  Interface served lazily. Its persisted property, if it has one, is the
+ *  whole state of the interface, like in the restore of the sdbusplus
+ *  objects.
+ */
+struct LazyObjects::Interface
+{
+    const char* name;      //!< persisted interface name
+    const char* interface; //!< D-Bus interface
+    const char* property;  //!< persisted property, nullptr if none
+    bool required;         //!< the interface is not restored without it
+    const sdbusplus::vtable_t* vtable;
+};
+
+const std::vector<LazyObjects::Interface>& LazyObjects::lazyInterfaces()
+{
+    using namespace sdbusplus::vtable;
+    constexpr auto emits = property_::emits_change;
+
+    static const sdbusplus::vtable_t item[] = {start(), end()};
+    static const sdbusplus::vtable_t locationCode[] = {
+        start(), property("LocationCode", "s", getValue, emits), end()};
+    static const sdbusplus::vtable_t operationalStatus[] = {
+        start(), property("Functional", "b", getValue, emits), end()};
+    static const sdbusplus::vtable_t availability[] = {
+        start(), property("Available", "b", getValue, emits), end()};
+    static const sdbusplus::vtable_t inventoryItem[] = {
+        start(), property("PrettyName", "s", getValue, emits),
+        property("Present", "b", getValue, emits), end()};
+    static const sdbusplus::vtable_t enable[] = {
+        start(), property("Enabled", "b", getValue, setValue, emits), end()};
+    static const sdbusplus::vtable_t cpuCore[] = {
+        start(), property("Microcode", "u", getValue, emits), end()};
+    static const sdbusplus::vtable_t associations[] = {
+        start(),
+        property("Associations", "a(sss)", getValue, setValue, emits), end()};
+
+    static const std::vector<Interface> interfaces = {
+        {"LocationCode", "xyz.openbmc_project.Inventory.Decorator.LocationCode",
+         "locationCode", true, locationCode},
+        {"OperationalStatus",
+         "xyz.openbmc_project.State.Decorator.OperationalStatus", "functional",
+         true, operationalStatus},
+        {"Available", "xyz.openbmc_project.State.Decorator.Availability",
+         "available", true, availability},
+        {"InventoryItem", "xyz.openbmc_project.Inventory.Item", "present",
+         true, inventoryItem},
+        {"Enable", "xyz.openbmc_project.Object.Enable", "enabled", true,
+         enable},
+        {"CPUCore", "xyz.openbmc_project.Inventory.Item.CpuCore", "microcode",
+         false, cpuCore},
+        {"Associations", "xyz.openbmc_project.Association.Definitions",
+         "associations", true, associations},
+        {"Motherboard", "xyz.openbmc_project.Inventory.Item.Board.Motherboard",
+         nullptr, false, item},
+        {"PowerSupply", "xyz.openbmc_project.Inventory.Item.PowerSupply",
+         nullptr, false, item},
+        {"Fan", "xyz.openbmc_project.Inventory.Item.Fan", nullptr, false,
+         item},
+        {"Connector", "xyz.openbmc_project.Inventory.Item.Connector", nullptr,
+         false, item},
+        {"VRM", "xyz.openbmc_project.Inventory.Item.Vrm", nullptr, false,
+         item},
+        {"FabricAdapter", "xyz.openbmc_project.Inventory.Item.FabricAdapter",
+         nullptr, false, item},
+        {"Board", "xyz.openbmc_project.Inventory.Item.Board", nullptr, false,
+         item},
+        {"Global", "xyz.openbmc_project.Inventory.Item.Global", nullptr, false,
+         item},
+    };
+    return interfaces;
+}
+
+LazyObjects::LazyObjects(sdbusplus::bus_t& bus, sdeventplus::Event& event,
+                         const std::string& root, size_t batchSize,
+                         Materializer materializer) :
+    bus(bus),
+    event(event), root(root), batchSize(batchSize),
+    materializer(std::move(materializer))
+{
+    sd_bus_slot* slot = nullptr;
+    auto rc = sd_bus_add_node_enumerator(bus.get(), &slot, root.c_str(),
+                                         enumerate, this);
+    if (rc < 0)
+    {
+        error("Failed to add the node enumerator of {PATH}, RC={RC}", "PATH",
+              root, "RC", rc);
+    }
+    else
+    {
+        slots.emplace_back(slot, sd_bus_slot_unref);
+    }
+
+    for (const auto& interface : lazyInterfaces())
+    {
+        slot = nullptr;
+        rc = sd_bus_add_fallback_vtable(bus.get(), &slot, root.c_str(),
+                                        interface.interface, interface.vtable,
+                                        findObject, this);
+        if (rc < 0)
+        {
+            error("Failed to add the fallback vtable of {INTF}, RC={RC}",
+                  "INTF", interface.interface, "RC", rc);
+            continue;
+        }
+        slots.emplace_back(slot, sd_bus_slot_unref);
+    }
+}
+
+bool LazyObjects::add(const std::string& path, const Interfaces& interfaces)
+{
+    if (!path.starts_with(root + "/"))
+    {
+        return false;
+    }
+
+    const auto& lazy = lazyInterfaces();
+    Object object;
+    for (const auto& [name, properties] : interfaces)
+    {
+        auto interface = std::find_if(lazy.begin(), lazy.end(),
+                                      [&name](const Interface& interface) {
+            return name == interface.name;
+        });
+        if (interface == lazy.end())
+        {
+            return false;
+        }
+
+        Entry entry{static_cast<uint8_t>(interface - lazy.begin()),
+                    std::nullopt};
+        if (interface->property && properties.contains(interface->property))
+        {
+            entry.value = properties.at(interface->property);
+        }
+        else if (interface->required)
+        {
+            // Not restored without its property
+            continue;
+        }
+        object.entries.push_back(std::move(entry));
+    }
+
+    objects.insert_or_assign(path, std::move(object));
+    pending.push_back(path);
+    return true;
+}
+
+void LazyObjects::announce()
+{
+    if (pending.empty() || announceEvent)
+    {
+        return;
+    }
+    announceEvent = std::make_unique<sdeventplus::source::Defer>(
+        event, std::bind_front(std::mem_fn(&LazyObjects::announceBatch), this));
+}
+
+void LazyObjects::announceBatch(sdeventplus::source::EventBase& /*source*/)
+{
+    for (size_t count = 0; count < batchSize && !pending.empty(); ++count)
+    {
+        auto path = std::move(pending.front());
+        pending.pop_front();
+
+        auto object = objects.find(path);
+        if (object == objects.end() || object->second.announced ||
+            object->second.entries.empty())
+        {
+            continue;
+        }
+
+        signal(path, object->second, true);
+        object->second.announced = true;
+    }
+
+    if (pending.empty())
+    {
+        info("Announced {COUNT} restored D-Bus objects", "COUNT",
+             objects.size());
+        announceEvent.reset();
+    }
+}
+
+void LazyObjects::signal(const std::string& path, const Object& object,
+                         bool added)
+{
+    std::vector<char*> interfaces;
+    for (const auto& entry : object.entries)
+    {
+        interfaces.push_back(
+            const_cast<char*>(lazyInterfaces()[entry.interface].interface));
+    }
+    interfaces.push_back(nullptr);
+
+    auto rc = added ? sd_bus_emit_interfaces_added_strv(
+                          bus.get(), path.c_str(), interfaces.data())
+                    : sd_bus_emit_interfaces_removed_strv(
+                          bus.get(), path.c_str(), interfaces.data());
+    if (rc < 0)
+    {
+        error("Failed to signal the interfaces of {PATH}, RC={RC}", "PATH",
+              path, "RC", rc);
+    }
+}
+
+const LazyObjects::Entry* LazyObjects::findEntry(const std::string& path,
+                                                 const char* interface) const
+{
+    auto object = objects.find(path);
+    if (object == objects.end())
+    {
+        return nullptr;
+    }
+    for (const auto& entry : object->second.entries)
+    {
+        if (!std::strcmp(lazyInterfaces()[entry.interface].interface,
+                         interface))
+        {
+            return &entry;
+        }
+    }
+    return nullptr;
+}
+
+std::optional<PropertyValue>
+    LazyObjects::getProperty(const std::string& path,
+                             const std::string& interface) const
+{
+    auto object = objects.find(path);
+    if (object == objects.end())
+    {
+        return std::nullopt;
+    }
+    for (const auto& entry : object->second.entries)
+    {
+        if (lazyInterfaces()[entry.interface].name == interface)
+        {
+            return entry.value;
+        }
+    }
+    return std::nullopt;
+}
+
+void LazyObjects::materialize(const std::string& path)
+{
+    auto object = objects.find(path);
+    if (object == objects.end())
+    {
+        return;
+    }
+
+    // The materializer updates the object through CustomDBus, which
+    // materializes it again unless it is out of the table first
+    Interfaces interfaces;
+    for (const auto& entry : object->second.entries)
+    {
+        const auto& interface = lazyInterfaces()[entry.interface];
+        auto& properties = interfaces[interface.name];
+        if (entry.value)
+        {
+            properties.emplace(interface.property, *entry.value);
+        }
+    }
+    objects.erase(object);
+    materializer(path, interfaces);
+}
+
+void LazyObjects::erase(const std::string& path)
+{
+    auto object = objects.find(path);
+    if (object == objects.end())
+    {
+        return;
+    }
+
+    if (object->second.announced)
+    {
+        signal(path, object->second, false);
+    }
+    objects.erase(object);
+}
+
+int LazyObjects::findObject(sd_bus* /*bus*/, const char* path,
+                            const char* interface, void* userdata,
+                            void** found, sd_bus_error* /*busError*/)
+{
+    auto lazyObjects = static_cast<LazyObjects*>(userdata);
+    if (!lazyObjects->findEntry(path, interface))
+    {
+        return 0;
+    }
+    *found = lazyObjects;
+    return 1;
+}
+
+int LazyObjects::enumerate(sd_bus* /*bus*/, const char* prefix,
+                           void* userdata, char*** nodes,
+                           sd_bus_error* /*busError*/)
+{
+    auto lazyObjects = static_cast<LazyObjects*>(userdata);
+    std::string_view parent(prefix);
+
+    // The list and the paths are freed by sd-bus
+    auto list = static_cast<char**>(
+        std::calloc(lazyObjects->objects.size() + 1, sizeof(char*)));
+    if (!list)
+    {
+        return -ENOMEM;
+    }
+    size_t count = 0;
+    for (const auto& [path, object] : lazyObjects->objects)
+    {
+        if (object.entries.empty() || !path.starts_with(parent))
+        {
+            continue;
+        }
+        list[count] = strdup(path.c_str());
+        if (!list[count])
+        {
+            for (size_t index = 0; index < count; ++index)
+            {
+                std::free(list[index]);
+            }
+            std::free(list);
+            return -ENOMEM;
+        }
+        ++count;
+    }
+    *nodes = list;
+    return 0;
+}
+
+int LazyObjects::getValue(sd_bus* /*bus*/, const char* path,
+                          const char* interface, const char* property,
+                          sd_bus_message* reply, void* userdata,
+                          sd_bus_error* busError)
+{
+    auto lazyObjects = static_cast<LazyObjects*>(userdata);
+    auto entry = lazyObjects->findEntry(path, interface);
+    if (!entry)
+    {
+        return sd_bus_error_set_const(busError, SD_BUS_ERROR_UNKNOWN_OBJECT,
+                                      "Unknown object");
+    }
+
+    sdbusplus::message_t message(reply);
+    try
+    {
+        if (!std::strcmp(property, "PrettyName"))
+        {
+            // Like the sdbusplus object, named after the last path element
+            message.append(std::filesystem::path(path).filename().string());
+        }
+        else if (!std::strcmp(property, "Present"))
+        {
+            // The restored items are present until the host says otherwise
+            message.append(true);
+        }
+        else if (entry->value)
+        {
+            std::visit([&message](const auto& value) { message.append(value); },
+                       *entry->value);
+        }
+        else
+        {
+            // The CPU core without a microcode
+            message.append(uint32_t(0));
+        }
+    }
+    catch (const std::exception& e)
+    {
+        error("Failed to read the property {PROPERTY} of {PATH}, ERROR={ERR}",
+              "PROPERTY", property, "PATH", path, "ERR", e.what());
+        return -EINVAL;
+    }
+    return 1;
+}
+
+int LazyObjects::setValue(sd_bus* /*bus*/, const char* path,
+                          const char* interface, const char* property,
+                          sd_bus_message* value, void* userdata,
+                          sd_bus_error* busError)
+{
+    auto lazyObjects = static_cast<LazyObjects*>(userdata);
+    auto object = lazyObjects->objects.find(path);
+    if (object == lazyObjects->objects.end() ||
+        !lazyObjects->findEntry(path, interface))
+    {
+        return sd_bus_error_set_const(busError, SD_BUS_ERROR_UNKNOWN_OBJECT,
+                                      "Unknown object");
+    }
+
+    // The written value goes to the table, the object is then materialized
+    // with it and handles the next calls
+    sdbusplus::message_t message(value);
+    PropertyValue newValue;
+    try
+    {
+        if (!std::strcmp(property, "Enabled"))
+        {
+            bool enabled{};
+            message.read(enabled);
+            newValue = enabled;
+        }
+        else
+        {
+            AssociationsObj associations;
+            message.read(associations);
+            newValue = std::move(associations);
+        }
+    }
+    catch (const std::exception& e)
+    {
+        return sd_bus_error_set_const(busError, SD_BUS_ERROR_INVALID_ARGS,
+                                      "Invalid value");
+    }
+
+    for (auto& entry : object->second.entries)
+    {
+        if (!std::strcmp(lazyInterfaces()[entry.interface].interface,
+                         interface))
+        {
+            entry.value = std::move(newValue);
+            break;
+        }
+    }
+    lazyObjects->materialize(path);
+    return 1;
+}
+
+} // namespace dbus
+} // namespace pldm
@@ -0,0 +1,198 @@
+#pragma once
+
+#include "type.hpp"
+
+#include <systemd/sd-bus.h>
+
+#include <sdbusplus/bus.hpp>
+#include <sdeventplus/event.hpp>
+#include <sdeventplus/source/event.hpp>
+
+#include <deque>
+#include <functional>
+#include <map>
+#include <memory>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace pldm
+{
+namespace dbus
+{
+
+/** @class LazyObjects
+ *
+ *  @brief D-Bus objects restored from the persisted host inventory, served
+ *         from a table instead of one sdbusplus object per interface.
+ *
+ *         A fallback vtable per interface is registered once under the root
+ *         path. The properties are read from the table when they are asked
+ *         for, and a node enumerator lists the objects for the introspection
+ *         and the object manager. The objects are announced with one
+ *         InterfacesAdded signal each, a batch per event loop iteration,
+ *         instead of one signal per interface and per property.
+ *
+ *         An object is materialized, its sdbusplus objects created by the
+ *         materializer and its entry dropped from the table, when pldmd
+ *         updates it or when a client writes one of its properties.
+ *
+ *         Only the interfaces whose whole state is persisted are served
+ *         lazily, the objects with other interfaces are left to the caller.
+ */
+class LazyObjects
+{
+  public:
+    /** @brief Properties of an interface, by persisted name */
+    using Properties = std::map<std::string, PropertyValue>;
+
+    /** @brief Interfaces of an object, by persisted name */
+    using Interfaces = std::map<std::string, Properties>;
+
+    /** @brief Creates the sdbusplus objects of a restored object */
+    using Materializer =
+        std::function<void(const std::string& path, const Interfaces&)>;
+
+    LazyObjects() = delete;
+    LazyObjects(const LazyObjects&) = delete;
+    LazyObjects(LazyObjects&&) = delete;
+    LazyObjects& operator=(const LazyObjects&) = delete;
+    LazyObjects& operator=(LazyObjects&&) = delete;
+    ~LazyObjects() = default;
+
+    /** @brief Constructor, registers the fallback vtables
+     *
+     *  @param[in] bus - D-Bus the objects are served on
+     *  @param[in] event - event loop the announcements run on
+     *  @param[in] root - path the objects are under
+     *  @param[in] batchSize - objects announced per event loop iteration
+     *  @param[in] materializer - creates the sdbusplus objects of an object
+     */
+    LazyObjects(sdbusplus::bus_t& bus, sdeventplus::Event& event,
+                const std::string& root, size_t batchSize,
+                Materializer materializer);
+
+    /** @brief Add a restored object
+     *
+     *  @param[in] path - object path
+     *  @param[in] interfaces - persisted interfaces of the object
+     *
+     *  @return false if the object is not under the root or has an interface
+     *          that is not served lazily, it is not added then
+     */
+    bool add(const std::string& path, const Interfaces& interfaces);
+
+    /** @brief Announce the objects added since the last call, in batches
+     *         on the event loop
+     */
+    void announce();
+
+    /** @brief Whether an object is served from the table */
+    bool contains(const std::string& path) const
+    {
+        return objects.contains(path);
+    }
+
+    /** @brief Number of objects served from the table */
+    size_t size() const
+    {
+        return objects.size();
+    }
+
+    /** @brief Value of a persisted property of an object of the table
+     *
+     *  @param[in] path - object path
+     *  @param[in] interface - persisted interface name, like "LocationCode"
+     *
+     *  @return the value, std::nullopt if the object or the interface is not
+     *          in the table
+     */
+    std::optional<PropertyValue>
+        getProperty(const std::string& path,
+                    const std::string& interface) const;
+
+    /** @brief Create the sdbusplus objects of an object and drop it from the
+     *         table, nothing is done if the object is not in the table
+     *
+     *  @param[in] path - object path
+     */
+    void materialize(const std::string& path);
+
+    /** @brief Drop an object from the table, its removal is signalled if it
+     *         was announced
+     *
+     *  @param[in] path - object path
+     */
+    void erase(const std::string& path);
+
+  private:
+    /** @struct Interface
+     *
+     *  Interface served lazily
+     */
+    struct Interface;
+
+    /** @brief Interfaces served lazily, their index is stored in the table */
+    static const std::vector<Interface>& lazyInterfaces();
+
+    /** @struct Entry
+     *
+     *  Interface of an object, its persisted property if it has one
+     */
+    struct Entry
+    {
+        uint8_t interface; //!< index in the lazy interfaces
+        std::optional<PropertyValue> value;
+    };
+
+    /** @struct Object
+     *
+     *  Object of the table
+     */
+    struct Object
+    {
+        std::vector<Entry> entries;
+        bool announced = false;
+    };
+
+    /** @brief Announce the next batch of objects */
+    void announceBatch(sdeventplus::source::EventBase& source);
+
+    /** @brief Emit the InterfacesAdded or InterfacesRemoved signal of an
+     *         object
+     */
+    void signal(const std::string& path, const Object& object, bool added);
+
+    const Entry* findEntry(const std::string& path,
+                           const char* interface) const;
+
+    static int findObject(sd_bus* bus, const char* path, const char* interface,
+                          void* userdata, void** found, sd_bus_error* busError);
+    static int enumerate(sd_bus* bus, const char* prefix, void* userdata,
+                         char*** nodes, sd_bus_error* busError);
+    static int getValue(sd_bus* bus, const char* path, const char* interface,
+                        const char* property, sd_bus_message* reply,
+                        void* userdata, sd_bus_error* busError);
+    static int setValue(sd_bus* bus, const char* path, const char* interface,
+                        const char* property, sd_bus_message* value,
+                        void* userdata, sd_bus_error* busError);
+
+    sdbusplus::bus_t& bus;
+    sdeventplus::Event event;
+    std::string root;
+    size_t batchSize;
+    Materializer materializer;
+
+    std::unordered_map<std::string, Object> objects;
+
+    /** @brief Objects waiting for their announcement */
+    std::deque<std::string> pending;
+    std::unique_ptr<sdeventplus::source::Defer> announceEvent;
+
+    std::vector<std::unique_ptr<sd_bus_slot, decltype(&sd_bus_slot_unref)>>
+        slots;
+};
+
+} // namespace dbus
+} // namespace pldm
@@ -0,0 +1,264 @@
+#pragma once
+
+#include <bitset>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+namespace pldm
+{
+namespace dbus
+{
+
+/** @class ObjectRegistry
+ *
+ *  @brief Interface objects of the D-Bus objects, by object path.
+ *
+ *         Each path is stored once in a path table and given an integer ID;
+ *         it is hashed once per lookup, whatever the number of interfaces.
+ *         The interface objects are stored in one column per interface
+ *         type, indexed by the ID, and a bitset per ID records which
+ *         interfaces the object implements. The ID of an erased path is
+ *         reused for the next new path.
+ *
+ *  @tparam Interfaces - interface types, each one at most once
+ */
+template <typename... Interfaces>
+class ObjectRegistry
+{
+  public:
+    using Id = uint32_t;
+    using Implemented = std::bitset<sizeof...(Interfaces)>;
+
+    /** @struct Stats
+     *
+     *  Memory used by the registry
+     */
+    struct Stats
+    {
+        size_t objects;    //!< object paths in the table
+        size_t interfaces; //!< interface objects
+        size_t pathBytes;  //!< length of the paths
+        size_t tableBytes; //!< bytes of the path table, columns and bitsets
+    };
+
+    ObjectRegistry() = default;
+    ObjectRegistry(const ObjectRegistry&) = delete;
+    ObjectRegistry(ObjectRegistry&&) = delete;
+    ObjectRegistry& operator=(const ObjectRegistry&) = delete;
+    ObjectRegistry& operator=(ObjectRegistry&&) = delete;
+    ~ObjectRegistry() = default;
+
+    /** @brief ID of an object path
+     *
+     *  @param[in] path - object path
+     *
+     *  @return the ID, std::nullopt if the path is not in the table
+     */
+    std::optional<Id> find(std::string_view path) const
+    {
+        auto found = ids.find(path);
+        if (found == ids.end())
+        {
+            return std::nullopt;
+        }
+        return found->second;
+    }
+
+    /** @brief ID of an object path, the path is added to the table if it is
+     *         not in it
+     *
+     *  @param[in] path - object path
+     *
+     *  @return the ID
+     */
+    Id intern(std::string_view path)
+    {
+        if (auto id = find(path))
+        {
+            return *id;
+        }
+
+        Id id{};
+        if (!released.empty())
+        {
+            id = released.back();
+            released.pop_back();
+            paths[id] = path;
+        }
+        else
+        {
+            id = paths.size();
+            paths.emplace_back(path);
+            implemented.emplace_back();
+        }
+        ids.emplace(paths[id], id);
+        return id;
+    }
+
+    /** @brief Path of an ID */
+    const std::string& path(Id id) const
+    {
+        return paths[id];
+    }
+
+    /** @brief Interface object of an object
+     *
+     *  @param[in] path - object path
+     *
+     *  @return the interface object, nullptr if the object does not
+     *          implement the interface
+     */
+    template <typename T>
+    T* get(std::string_view path) const
+    {
+        auto id = find(path);
+        return id ? get<T>(*id) : nullptr;
+    }
+
+    /** @brief Interface object of an object, by ID */
+    template <typename T>
+    T* get(Id id) const
+    {
+        if (!implemented[id].test(indexOf<T>()))
+        {
+            return nullptr;
+        }
+        return column<T>()[id].get();
+    }
+
+    /** @brief Add an interface object to an object, it replaces the one the
+     *         object already has
+     *
+     *  @param[in] id - ID of the object
+     *  @param[in] object - interface object
+     *
+     *  @return the interface object
+     */
+    template <typename T>
+    T& emplace(Id id, std::unique_ptr<T> object)
+    {
+        auto& values = column<T>();
+        if (values.size() <= id)
+        {
+            values.resize(id + 1);
+        }
+        values[id] = std::move(object);
+        implemented[id].set(indexOf<T>());
+        return *values[id];
+    }
+
+    /** @brief Interfaces an object implements, empty if the path is not in
+     *         the table
+     */
+    Implemented implements(std::string_view path) const
+    {
+        auto id = find(path);
+        return id ? implemented[*id] : Implemented{};
+    }
+
+    /** @brief Remove all the interface objects of an object and release its
+     *         ID
+     *
+     *  @param[in] path - object path
+     */
+    void erase(std::string_view path)
+    {
+        auto found = ids.find(path);
+        if (found == ids.end())
+        {
+            return;
+        }
+        auto id = found->second;
+        std::apply([id](auto&... values) { (reset(values, id), ...); },
+                   columns);
+        implemented[id].reset();
+        ids.erase(found);
+        paths[id].clear();
+        paths[id].shrink_to_fit();
+        released.push_back(id);
+    }
+
+    /** @brief Memory used by the registry */
+    Stats stats() const
+    {
+        Stats stats{};
+        stats.objects = ids.size();
+        for (const auto& bits : implemented)
+        {
+            stats.interfaces += bits.count();
+        }
+        for (const auto& path : paths)
+        {
+            stats.pathBytes += path.size();
+        }
+        stats.tableBytes =
+            paths.size() * sizeof(std::string) +
+            implemented.capacity() * sizeof(Implemented) +
+            released.capacity() * sizeof(Id) +
+            ids.bucket_count() * sizeof(void*) +
+            ids.size() * (sizeof(std::string_view) + sizeof(Id) +
+                          2 * sizeof(void*));
+        std::apply(
+            [&stats](const auto&... values) {
+            ((stats.tableBytes += values.capacity() * sizeof(values[0])), ...);
+        },
+            columns);
+        return stats;
+    }
+
+  private:
+    template <typename T>
+    static constexpr size_t indexOf()
+    {
+        constexpr bool matches[] = {std::is_same_v<T, Interfaces>...};
+        for (size_t index = 0; index < sizeof...(Interfaces); ++index)
+        {
+            if (matches[index])
+            {
+                return index;
+            }
+        }
+        static_assert((std::is_same_v<T, Interfaces> || ...),
+                      "Interface type not in the registry");
+        return sizeof...(Interfaces);
+    }
+
+    template <typename T>
+    std::vector<std::unique_ptr<T>>& column()
+    {
+        return std::get<indexOf<T>()>(columns);
+    }
+
+    template <typename T>
+    const std::vector<std::unique_ptr<T>>& column() const
+    {
+        return std::get<indexOf<T>()>(columns);
+    }
+
+    template <typename T>
+    static void reset(std::vector<std::unique_ptr<T>>& values, Id id)
+    {
+        if (id < values.size())
+        {
+            values[id].reset();
+        }
+    }
+
+    /** @brief Paths by ID, a deque so that the views in ids stay valid */
+    std::deque<std::string> paths;
+    std::unordered_map<std::string_view, Id> ids;
+    std::vector<Implemented> implemented;
+    std::vector<Id> released;
+    std::tuple<std::vector<std::unique_ptr<Interfaces>>...> columns;
+};
+
+} // namespace dbus
+} // namespace pldm
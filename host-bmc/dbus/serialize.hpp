@@ -25,7 +25,7 @@ class Serialize
   private:
     Serialize()
     {
-        deserialize();
+        restored = deserialize();
     }
 
   public:
@@ -47,6 +47,15 @@ class Serialize
 
     bool deserialize();
 
+    /** @brief Whether the saved objects were read from the persistent file
+     *         when the instance was created, pldmd creates it on a startup
+     *         worker thread ahead of the restore of the D-Bus objects
+     */
+    bool isRestored() const
+    {
+        return restored;
+    }
+
     dbus::SavedObjs getSavedObjs()
     {
         return savedObjs;
@@ -65,6 +74,7 @@ class Serialize
     fs::path filePath{PERSISTENT_FILE};
     std::set<uint16_t> storeEntityTypes;
     std::map<ObjectPath, pldm_entity> entityPathMaps;
+    bool restored = false;
 };
 
 } // namespace serialize
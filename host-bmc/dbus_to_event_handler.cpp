@@ -122,53 +122,28 @@ void DbusToPLDMEvent::sendStateSensorEvent(SensorId sensorId,
             {
                 return;
             }
-            for (const auto& itr : dbusValueMapping)
+            auto state =
+                dbusValueMapping.state(props.at(dbusMapping.propertyName));
+            if (!state)
             {
-                bool findValue = false;
-                if (dbusMapping.propertyType == "string")
-                {
-                    std::string src = std::get<std::string>(itr.second);
-                    std::string dst = std::get<std::string>(
-                        props.at(dbusMapping.propertyName));
-
-                    auto values = pldm::utils::split(src, "||", " ");
-                    for (auto& value : values)
-                    {
-                        if (value == dst)
-                        {
-                            findValue = true;
-                            break;
-                        }
-                    }
-                }
-                else
-                {
-                    findValue = itr.second == props.at(dbusMapping.propertyName)
-                                    ? true
-                                    : false;
-                }
-
-                if (findValue)
-                {
-                    auto eventData =
-                        reinterpret_cast<struct pldm_sensor_event_data*>(
-                            sensorEventDataVec.data());
-                    eventData->event_class[1] = itr.first;
-                    if (sensorCacheMap.contains(sensorId) &&
-                        sensorCacheMap[sensorId][offset] != PLDM_SENSOR_UNKNOWN)
-                    {
-                        previousState = sensorCacheMap[sensorId][offset];
-                    }
-                    else
-                    {
-                        previousState = itr.first;
-                    }
-                    eventData->event_class[2] = previousState;
-                    this->sendEventMsg(PLDM_SENSOR_EVENT, sensorEventDataVec);
-                    updateSensorCacheMaps(sensorId, offset, previousState);
-                    break;
-                }
+                return;
+            }
+
+            auto eventData = reinterpret_cast<struct pldm_sensor_event_data*>(
+                sensorEventDataVec.data());
+            eventData->event_class[1] = *state;
+            if (sensorCacheMap.contains(sensorId) &&
+                sensorCacheMap[sensorId][offset] != PLDM_SENSOR_UNKNOWN)
+            {
+                previousState = sensorCacheMap[sensorId][offset];
+            }
+            else
+            {
+                previousState = *state;
             }
+            eventData->event_class[2] = previousState;
+            this->sendEventMsg(PLDM_SENSOR_EVENT, sensorEventDataVec);
+            updateSensorCacheMaps(sensorId, offset, previousState);
         });
         stateSensorMatchs.emplace_back(std::move(stateSensorMatch));
     }
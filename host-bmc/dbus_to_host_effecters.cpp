@@ -1,5 +1,7 @@
 #include "dbus_to_host_effecters.hpp"
 
+#include "common/json_cache.hpp"
+
 #include "libpldm/pdr.h"
 #include "libpldm/platform.h"
 #include "libpldm/pldm.h"
@@ -54,8 +56,7 @@ void HostEffecterParser::parseEffecterJson(const std::string& jsonPath)
         throw InternalFailure();
     }
 
-    std::ifstream jsonFile(jsonFilePath);
-    auto data = Json::parse(jsonFile, nullptr, false);
+    auto data = pldm::utils::JsonCache::get().parse(jsonFilePath);
     if (data.is_discarded())
     {
         error("Parsing json file failed, FILE = {JSON_PATH}", "JSON_PATH",
@@ -155,33 +156,7 @@ void HostEffecterParser::processHostEffecterChangeNotification(
             return;
         }
     }
-    constexpr auto hostStateInterface =
-        "xyz.openbmc_project.State.Boot.Progress";
-    constexpr auto hostStatePath = "/xyz/openbmc_project/state/host0";
 
-    try
-    {
-        auto propVal = dbusHandler->getDbusPropertyVariant(
-            hostStatePath, "BootProgress", hostStateInterface);
-        const auto& currHostState = std::get<std::string>(propVal);
-        if ((currHostState != "xyz.openbmc_project.State.Boot.Progress."
-                              "ProgressStages.SystemInitComplete") &&
-            (currHostState != "xyz.openbmc_project.State.Boot.Progress."
-                              "ProgressStages.OSRunning") &&
-            (currHostState != "xyz.openbmc_project.State.Boot.Progress."
-                              "ProgressStages.SystemSetup"))
-        {
-            info("Host is not up. Current host state: {CURR_HOST_STATE}",
-                 "CURR_HOST_STATE", currHostState.c_str());
-            return;
-        }
-    }
-    catch (const sdbusplus::exception::exception& e)
-    {
-        error(
-            "Error in getting current host state. Will still continue to set the host effecter {ERR_EXCEP}",
-            "ERR_EXCEP", e.what());
-    }
     uint8_t newState{};
     try
     {
@@ -194,36 +169,103 @@ void HostEffecterParser::processHostEffecterChangeNotification(
               e.what());
         return;
     }
+    queueEffecterChange(effecterInfoIndex, dbusInfoIndex, effecterId,
+                        newState);
+}
 
-    std::vector<set_effecter_state_field> stateField;
-    for (uint8_t i = 0; i < hostEffecterInfo[effecterInfoIndex].compEffecterCnt;
-         i++)
+void HostEffecterParser::queueEffecterChange(size_t effecterInfoIndex,
+                                             size_t dbusInfoIndex,
+                                             uint16_t effecterId,
+                                             uint8_t newState)
+{
+    ++changeStats.changes;
+    auto [pending, added] = pendingChanges.try_emplace(
+        effecterId, PendingEffecterChange{effecterInfoIndex, {}});
+    auto& stateField = pending->second.stateField;
+    if (added)
     {
-        if (i == dbusInfoIndex)
-        {
-            stateField.push_back({PLDM_REQUEST_SET, newState});
-        }
-        else
-        {
-            stateField.push_back({PLDM_NO_CHANGE, 0});
-        }
+        stateField.assign(hostEffecterInfo[effecterInfoIndex].compEffecterCnt,
+                          {PLDM_NO_CHANGE, 0});
     }
-    int rc{};
-    try
+    else
     {
-        rc = setHostStateEffecter(effecterInfoIndex, stateField, effecterId);
+        // A later change of the same composite effecter replaces the state
+        // queued for it
+        ++changeStats.merged;
     }
-    catch (const std::runtime_error& e)
+    if (dbusInfoIndex < stateField.size())
     {
-        error("Could not set host state effecter");
-        return;
+        stateField[dbusInfoIndex] = {PLDM_REQUEST_SET, newState};
     }
-    if (rc != PLDM_SUCCESS)
+
+    if (!sendChangesEvent)
     {
-        error("Could not set the host state effecter, rc= {RC}", "RC", rc);
+        sendChangesEvent = std::make_unique<sdeventplus::source::Defer>(
+            event, [this](sdeventplus::source::EventBase& /*source*/) {
+            sendChangesEvent.reset();
+            sendEffecterChanges();
+        });
     }
 }
 
+void HostEffecterParser::sendEffecterChanges()
+{
+    constexpr auto hostStateInterface =
+        "xyz.openbmc_project.State.Boot.Progress";
+    constexpr auto hostStatePath = "/xyz/openbmc_project/state/host0";
+
+    // The host state is read once for the whole batch, without blocking the
+    // event loop
+    const DBusMapping hostStateMapping{hostStatePath, hostStateInterface,
+                                       "BootProgress", "string"};
+    dbusHandler->getDbusPropertyVariantAsync(
+        hostStateMapping, [this, changes = std::move(pendingChanges)](
+                              std::optional<PropertyValue> propVal) mutable {
+        if (!propVal)
+        {
+            error(
+                "Error in getting current host state. Will still continue to set the host effecter");
+        }
+        else if (auto currHostState = std::get_if<std::string>(&*propVal);
+                 currHostState &&
+                 (*currHostState != "xyz.openbmc_project.State.Boot.Progress."
+                                    "ProgressStages.SystemInitComplete") &&
+                 (*currHostState != "xyz.openbmc_project.State.Boot.Progress."
+                                    "ProgressStages.OSRunning") &&
+                 (*currHostState != "xyz.openbmc_project.State.Boot.Progress."
+                                    "ProgressStages.SystemSetup"))
+        {
+            info("Host is not up. Current host state: {CURR_HOST_STATE}",
+                 "CURR_HOST_STATE", currHostState->c_str());
+            changeStats.dropped += changes.size();
+            return;
+        }
+
+        for (auto& [effecterId, change] : changes)
+        {
+            int rc{};
+            try
+            {
+                rc = setHostStateEffecter(change.effecterInfoIndex,
+                                          change.stateField, effecterId);
+            }
+            catch (const std::runtime_error& e)
+            {
+                error("Could not set host state effecter");
+                continue;
+            }
+            if (rc != PLDM_SUCCESS)
+            {
+                error("Could not set the host state effecter, rc= {RC}", "RC",
+                      rc);
+                continue;
+            }
+            ++changeStats.requests;
+        }
+    });
+    pendingChanges.clear();
+}
+
 uint8_t
     HostEffecterParser::findNewStateValue(size_t effecterInfoIndex,
                                           size_t dbusInfoIndex,
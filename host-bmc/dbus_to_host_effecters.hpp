@@ -6,7 +6,11 @@
 #include "requester/handler.hpp"
 
 #include <phosphor-logging/lg2.hpp>
+#include <sdeventplus/event.hpp>
+#include <sdeventplus/source/event.hpp>
 
+#include <map>
+#include <memory>
 #include <string>
 #include <utility>
 #include <vector>
@@ -55,11 +59,33 @@ struct EffecterInfo
         dbusInfo;            //!< D-Bus information for the effecter id
 };
 
+/** @struct PendingEffecterChange
+ *  Contains the state fields of a host effecter waiting to be set
+ */
+struct PendingEffecterChange
+{
+    size_t effecterInfoIndex; //!< Index of the effecter in hostEffecterInfo
+    std::vector<set_effecter_state_field> stateField; //!< Composite states
+};
+
+/** @struct EffecterChangeStats
+ *  Counters of the D-Bus changes sent to the host effecters
+ */
+struct EffecterChangeStats
+{
+    uint64_t changes = 0;  //!< D-Bus property changes received
+    uint64_t merged = 0;   //!< changes merged into a pending request
+    uint64_t requests = 0; //!< SetStateEffecterStates requests sent
+    uint64_t dropped = 0;  //!< requests dropped as the host was not up
+};
+
 /** @class HostEffecterParser
  *
  *  @brief This class parses the Host Effecter json file and monitors for the
  *         D-Bus changes for the effecters. Upon change, calls the corresponding
- *         setStateEffecterStates on the host
+ *         setStateEffecterStates on the host. The changes received within
+ *         one iteration of the event loop are coalesced, into one request
+ *         per effecter id.
  */
 class HostEffecterParser
 {
@@ -85,7 +111,8 @@ class HostEffecterParser
         const std::string& jsonPath,
         pldm::requester::Handler<pldm::requester::Request>* handler) :
         requester(requester),
-        sockFd(fd), pdrRepo(repo), dbusHandler(dbusHandler), handler(handler)
+        sockFd(fd), pdrRepo(repo), dbusHandler(dbusHandler), handler(handler),
+        event(sdeventplus::Event::get_default())
     {
         try
         {
@@ -118,6 +145,31 @@ class HostEffecterParser
         const DbusChgHostEffecterProps& chProperties, size_t effecterInfoIndex,
         size_t dbusInfoIndex, uint16_t effecterId);
 
+    /* @brief Queue the new state of a host effecter, the states queued for
+     *        the same effecter id are merged and sent on the next iteration
+     *        of the event loop
+     *
+     * @param[in] effecterInfoIndex - index of effecterInfo pointer in
+     *                                hostEffecterInfo
+     * @param[in] dbusInfoIndex - index on dbusInfo pointer in each effecterInfo
+     * @param[in] effecterId - host effecter id
+     * @param[in] newState - the new state of the effecter
+     * @return - none
+     */
+    void queueEffecterChange(size_t effecterInfoIndex, size_t dbusInfoIndex,
+                             uint16_t effecterId, uint8_t newState);
+
+    /* @brief Set the queued host effecter states, if the host is up
+     * @return - none
+     */
+    void sendEffecterChanges();
+
+    /* @brief Counters of the D-Bus changes sent to the host effecters */
+    const EffecterChangeStats& getChangeStats() const
+    {
+        return changeStats;
+    }
+
     /* @brief Populate the property values in each dbusInfo from the json
      *
      * @param[in] dBusValues - json values
@@ -189,6 +241,14 @@ class HostEffecterParser
     const pldm::utils::DBusHandler* dbusHandler; //!< D-bus Handler
     /** @brief PLDM request handler */
     pldm::requester::Handler<pldm::requester::Request>* handler;
+    /** @brief event loop the changes are sent from */
+    sdeventplus::Event event;
+    /** @brief effecter states waiting to be set, by effecter id */
+    std::map<uint16_t, PendingEffecterChange> pendingChanges;
+    /** @brief sends the pending changes on the next loop iteration */
+    std::unique_ptr<sdeventplus::source::Defer> sendChangesEvent;
+    /** @brief counters of the changes sent to the host effecters */
+    EffecterChangeStats changeStats;
 };
 
 } // namespace host_effecters
@@ -1,5 +1,7 @@
 #include "host_associations_parser.hpp"
 
+#include "common/json_cache.hpp"
+
 #include <phosphor-logging/lg2.hpp>
 #include <xyz/openbmc_project/Common/error.hpp>
 
@@ -38,8 +40,7 @@ void HostAssociationsParser::parseHostAssociations(const std::string& jsonPath)
         throw InternalFailure();
     }
 
-    std::ifstream jsonFile(jsonFilePath);
-    auto data = Json::parse(jsonFile, nullptr, false);
+    auto data = pldm::utils::JsonCache::get().parse(jsonFilePath);
     if (data.is_discarded())
     {
         error("Parsing json file failed, FILE = {JSON_PATH}", "JSON_PATH",
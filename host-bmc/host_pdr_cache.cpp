@@ -0,0 +1,256 @@
+#include "host_pdr_cache.hpp"
+
+#include "libpldm/utils.h"
+
+#include "common/utils.hpp"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include <phosphor-logging/lg2.hpp>
+
+#include <cstring>
+#include <fstream>
+#include <memory>
+
+PHOSPHOR_LOG2_USING;
+
+namespace pldm
+{
+
+namespace
+{
+
+constexpr uint32_t cacheMagic = 0x43504850; // "PHPC"
+constexpr uint16_t cacheVersion = 1;
+
+/** @struct CacheHeader
+ *
+ *  Header of the cache file, followed by the records, the integers are in
+ *  host byte order
+ */
+struct CacheHeader
+{
+    uint32_t magic;
+    uint16_t version;
+    uint16_t reserved;
+    uint32_t count; //!< number of records
+    uint32_t size;  //!< size of the records
+    uint32_t crc;   //!< checksum of the records
+    uint32_t recordCount;
+    uint32_t repositorySize;
+    uint8_t updateTime[PLDM_TIMESTAMP104_SIZE];
+    uint8_t oemUpdateTime[PLDM_TIMESTAMP104_SIZE];
+    uint16_t reserved2;
+};
+
+/** @brief Size of the header of a record, the next record handle of the
+ *         GetPDR response and the size of the PDR, followed by the PDR
+ */
+constexpr size_t recordHeaderSize = sizeof(uint32_t) + sizeof(uint16_t);
+
+/** @brief Whether a timestamp104 holds a date, its bytes 8 and 9 are the day
+ *         and the month, 10 and 11 the year
+ */
+bool hasDate(const std::array<uint8_t, PLDM_TIMESTAMP104_SIZE>& timestamp)
+{
+    return timestamp[8] && timestamp[9] && (timestamp[10] || timestamp[11]);
+}
+
+bool matches(const CacheHeader& header, const RepositorySignature& signature)
+{
+    return header.recordCount == signature.recordCount &&
+           header.repositorySize == signature.repositorySize &&
+           !std::memcmp(header.updateTime, signature.updateTime.data(),
+                        signature.updateTime.size()) &&
+           !std::memcmp(header.oemUpdateTime, signature.oemUpdateTime.data(),
+                        signature.oemUpdateTime.size());
+}
+
+} // namespace
+
+bool RepositorySignature::isSpecified() const
+{
+    return hasDate(updateTime) && hasDate(oemUpdateTime);
+}
+
+bool HostPDRCache::load(const RepositorySignature& signature,
+                        const Callback& callback) const
+{
+    if (!signature.isSpecified())
+    {
+        return false;
+    }
+
+    pldm::utils::CustomFD fd(open(path.c_str(), O_RDONLY));
+    if (fd() < 0)
+    {
+        return false;
+    }
+
+    struct stat sb;
+    if (fstat(fd(), &sb) == -1 ||
+        static_cast<size_t>(sb.st_size) < sizeof(CacheHeader))
+    {
+        error("Host PDR cache {PATH} is truncated", "PATH", path.string());
+        return false;
+    }
+    size_t fileSize = sb.st_size;
+
+    void* fileInMemory = mmap(nullptr, fileSize, PROT_READ, MAP_PRIVATE, fd(),
+                              0);
+    if (MAP_FAILED == fileInMemory)
+    {
+        int rc = -errno;
+        error("mmap on host PDR cache {PATH} failed, RC={RC}", "PATH",
+              path.string(), "RC", rc);
+        return false;
+    }
+    auto cacheCleanup = [fileSize](void* fileInMemory) {
+        munmap(fileInMemory, fileSize);
+    };
+    std::unique_ptr<void, decltype(cacheCleanup)> cachePtr(fileInMemory,
+                                                           cacheCleanup);
+
+    std::span<const uint8_t> file(static_cast<const uint8_t*>(fileInMemory),
+                                  fileSize);
+    CacheHeader header{};
+    std::memcpy(&header, file.data(), sizeof(header));
+    auto body = file.subspan(sizeof(header));
+    if (header.magic != cacheMagic || header.version != cacheVersion ||
+        header.size != body.size() ||
+        header.crc != crc32(body.data(), body.size()))
+    {
+        error("Host PDR cache {PATH} is corrupted", "PATH", path.string());
+        return false;
+    }
+    if (!matches(header, signature))
+    {
+        info("Host PDR cache {PATH} is out of date", "PATH", path.string());
+        return false;
+    }
+
+    // Check the record boundaries before passing on any PDR
+    std::vector<size_t> offsets;
+    offsets.reserve(header.count);
+    size_t offset = 0;
+    for (uint32_t record = 0; record < header.count; ++record)
+    {
+        if (body.size() - offset < recordHeaderSize)
+        {
+            break;
+        }
+        uint16_t size = 0;
+        std::memcpy(&size, body.data() + offset + sizeof(uint32_t),
+                    sizeof(size));
+        offsets.push_back(offset);
+        offset += recordHeaderSize + size;
+        if (offset > body.size())
+        {
+            break;
+        }
+    }
+    if (offset != body.size() || offsets.size() != header.count)
+    {
+        error("Host PDR cache {PATH} is malformed", "PATH", path.string());
+        return false;
+    }
+
+    for (auto recordOffset : offsets)
+    {
+        uint32_t next = 0;
+        uint16_t size = 0;
+        std::memcpy(&next, body.data() + recordOffset, sizeof(next));
+        std::memcpy(&size, body.data() + recordOffset + sizeof(next),
+                    sizeof(size));
+        callback(body.subspan(recordOffset + recordHeaderSize, size), next);
+    }
+    return true;
+}
+
+void HostPDRCache::begin(const RepositorySignature& signature)
+{
+    abort();
+    if (signature.isSpecified())
+    {
+        recording = signature;
+    }
+}
+
+void HostPDRCache::add(std::span<const uint8_t> pdr, uint32_t next)
+{
+    if (!recording)
+    {
+        return;
+    }
+    auto size = static_cast<uint16_t>(pdr.size());
+    auto nextBytes = reinterpret_cast<const uint8_t*>(&next);
+    auto sizeBytes = reinterpret_cast<const uint8_t*>(&size);
+    records.insert(records.end(), nextBytes, nextBytes + sizeof(next));
+    records.insert(records.end(), sizeBytes, sizeBytes + sizeof(size));
+    records.insert(records.end(), pdr.begin(), pdr.end());
+    ++count;
+}
+
+bool HostPDRCache::commit()
+{
+    if (!recording)
+    {
+        return false;
+    }
+
+    CacheHeader header{};
+    header.magic = cacheMagic;
+    header.version = cacheVersion;
+    header.count = count;
+    header.size = records.size();
+    header.crc = crc32(records.data(), records.size());
+    header.recordCount = recording->recordCount;
+    header.repositorySize = recording->repositorySize;
+    std::memcpy(header.updateTime, recording->updateTime.data(),
+                sizeof(header.updateTime));
+    std::memcpy(header.oemUpdateTime, recording->oemUpdateTime.data(),
+                sizeof(header.oemUpdateTime));
+
+    // The new cache replaces the old one in one rename
+    std::error_code ec;
+    fs::create_directories(path.parent_path(), ec);
+    auto tempPath = path;
+    tempPath += ".tmp";
+    std::ofstream file(tempPath, std::ios::out | std::ios::binary |
+                                     std::ios::trunc);
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    file.write(reinterpret_cast<const char*>(records.data()), records.size());
+    file.close();
+
+    auto written = count;
+    abort();
+    if (!file)
+    {
+        error("Failed to write the host PDR cache {PATH}", "PATH",
+              tempPath.string());
+        fs::remove(tempPath, ec);
+        return false;
+    }
+    fs::rename(tempPath, path, ec);
+    if (ec)
+    {
+        error("Failed to replace the host PDR cache {PATH}, ERROR={ERR}",
+              "PATH", path.string(), "ERR", ec.message());
+        fs::remove(tempPath, ec);
+        return false;
+    }
+    info("Cached {COUNT} host PDRs in {PATH}", "COUNT", written, "PATH",
+         path.string());
+    return true;
+}
+
+void HostPDRCache::invalidate()
+{
+    abort();
+    std::error_code ec;
+    fs::remove(path, ec);
+}
+
+} // namespace pldm
@@ -0,0 +1,134 @@
+#pragma once
+
+#include "libpldm/platform.h"
+
+#include <array>
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <optional>
+#include <span>
+#include <vector>
+
+namespace pldm
+{
+
+namespace fs = std::filesystem;
+
+/** @struct RepositorySignature
+ *
+ *  State of the host PDR repository, as returned by GetPDRRepositoryInfo.
+ *  The host updates it whenever its PDRs change.
+ */
+struct RepositorySignature
+{
+    std::array<uint8_t, PLDM_TIMESTAMP104_SIZE> updateTime;
+    std::array<uint8_t, PLDM_TIMESTAMP104_SIZE> oemUpdateTime;
+    uint32_t recordCount;
+    uint32_t repositorySize;
+
+    bool operator==(const RepositorySignature&) const = default;
+
+    /** @brief Whether both update times hold a date, a host that leaves them
+     *         zero or unspecified cannot tell its PDRs changed
+     */
+    bool isSpecified() const;
+};
+
+/** @class HostPDRCache
+ *
+ *  @brief The PDRs of the last complete fetch from the host, kept in a
+ *         binary file with the repository signature they were fetched at.
+ *
+ *         The PDRs are recorded as they are received, with the next record
+ *         handle of their GetPDR response, and the file is written once
+ *         the fetch completes. As long as the host reports the same
+ *         signature, the PDRs can be loaded from the file instead of
+ *         fetched again, the handler does it after a BMC reboot with the
+ *         host running. Nothing is cached for a signature without update
+ *         times.
+ */
+class HostPDRCache
+{
+  public:
+    /** @brief Called with each cached PDR and its next record handle */
+    using Callback =
+        std::function<void(std::span<const uint8_t> pdr, uint32_t next)>;
+
+    HostPDRCache() = delete;
+    HostPDRCache(const HostPDRCache&) = delete;
+    HostPDRCache(HostPDRCache&&) = delete;
+    HostPDRCache& operator=(const HostPDRCache&) = delete;
+    HostPDRCache& operator=(HostPDRCache&&) = delete;
+    ~HostPDRCache() = default;
+
+    /** @brief Constructor
+     *
+     *  @param[in] path - path of the cache file
+     */
+    explicit HostPDRCache(const fs::path& path) : path(path) {}
+
+    /** @brief Load the cached PDRs, the file is mapped and checked before
+     *         the first PDR is passed on
+     *
+     *  @param[in] signature - current signature of the host repository
+     *  @param[in] callback - called with each cached PDR, in fetch order
+     *
+     *  @return false if there is no valid cache for the signature, or the
+     *          signature is not specified, the callback is not called then
+     */
+    bool load(const RepositorySignature& signature,
+              const Callback& callback) const;
+
+    /** @brief Start recording a fetch, the one in progress is dropped,
+     *         nothing is recorded if the signature is not specified
+     *
+     *  @param[in] signature - signature of the host repository being fetched
+     */
+    void begin(const RepositorySignature& signature);
+
+    /** @brief Record a fetched PDR, nothing is done if not recording
+     *
+     *  @param[in] pdr - PDR as received from the host
+     *  @param[in] next - next record handle of the GetPDR response
+     */
+    void add(std::span<const uint8_t> pdr, uint32_t next);
+
+    /** @brief Write the recorded fetch to the cache file and stop recording,
+     *         nothing is done if not recording
+     *
+     *  @return true if the file is written
+     */
+    bool commit();
+
+    /** @brief Stop recording, the cache file is kept */
+    void abort()
+    {
+        recording.reset();
+        records.clear();
+        count = 0;
+    }
+
+    /** @brief Remove the cache file and stop recording, once the host PDRs
+     *         merged in the BMC repository differ from a complete fetch
+     */
+    void invalidate();
+
+    /** @brief Whether a fetch is being recorded */
+    bool isRecording() const
+    {
+        return recording.has_value();
+    }
+
+  private:
+    fs::path path;
+
+    /** @brief Signature of the fetch being recorded */
+    std::optional<RepositorySignature> recording;
+
+    /** @brief Records of the fetch being recorded, in the file format */
+    std::vector<uint8_t> records;
+    uint32_t count = 0;
+};
+
+} // namespace pldm
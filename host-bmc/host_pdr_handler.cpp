@@ -10,6 +10,7 @@
 #include "libpldm/pdr_oem_ibm.h"
 #endif
 
+#include "common/json_cache.hpp"
 #include "dbus/custom_dbus.hpp"
 #include "dbus/serialize.hpp"
 #include "host-bmc/dbus/deserialize.hpp"
@@ -22,6 +23,7 @@
 #include <sdeventplus/source/io.hpp>
 #include <sdeventplus/source/time.hpp>
 
+#include <algorithm>
 #include <fstream>
 #include <type_traits>
 
@@ -118,8 +120,7 @@ HostPDRHandler::HostPDRHandler(
         // This will enable a merge of entity associations.
         try
         {
-            std::ifstream jsonFile(hostFruJson);
-            auto data = Json::parse(jsonFile, nullptr, false);
+            auto data = pldm::utils::JsonCache::get().parse(hostFruJson);
             if (data.is_discarded())
             {
                 error("Parsing Host FRU json file failed");
@@ -183,12 +184,17 @@ HostPDRHandler::HostPDRHandler(
                 // state of all the dbus objects to false
                 this->setPresenceFrus();
                 pldm_pdr_remove_remote_pdrs(repo);
+                pldm::utils::pdrRepoChanged();
                 pldm_entity_association_tree_destroy_root(entityTree);
                 pldm_entity_association_tree_copy_root(bmcEntityTree,
                                                        entityTree);
                 this->sensorMap.clear();
+                this->invalidateEventRoutes();
                 this->stateSensorPDRs.clear();
                 this->responseReceived = false;
+#ifdef HOST_PDR_CACHE
+                this->pdrCacheReconnect = false;
+#endif
                 this->mergedHostParents = false;
                 this->objMapIndex = objPathMap.begin();
                 this->sensorIndex = stateSensorPDRs.begin();
@@ -203,6 +209,11 @@ HostPDRHandler::HostPDRHandler(
                 {
                     this->objPathMap[element.first] = nullptr;
                 }
+
+                // The FRU record table fetch ends with the host, its late
+                // parts are dropped
+                fruRecordStream.reset();
+                ++fruFetchGeneration;
                 isHostOff = true;
             }
             else if (propVal ==
@@ -253,17 +264,15 @@ HostPDRHandler::HostPDRHandler(
                         "PowerState", "string"};
                     value =
                         "xyz.openbmc_project.State.Decorator.PowerState.State.Off";
-                    try
-                    {
-                        pldm::utils::DBusHandler().setDbusProperty(dbusMapping,
-                                                                   value);
-                    }
-                    catch (const std::exception& e)
-                    {
-                        error(
-                            "Unable to set the slot power state to Off, ERROR = {ERR_EXCEP}",
-                            "ERR_EXCEP", e.what());
-                    }
+                    pldm::utils::DBusHandler().setDbusPropertyAsync(
+                        dbusMapping, value, [path = objPath](bool success) {
+                        if (!success)
+                        {
+                            error(
+                                "Unable to set the slot power state of {PATH} to Off",
+                                "PATH", path);
+                        }
+                    });
                 }
             }
         }
@@ -317,25 +326,136 @@ void HostPDRHandler::fetchPDR(PDRRecordHandles&& recordHandles, uint8_t tid)
 
     terminusID = tid;
 
-    // Defer the actual fetch of PDRs from the host (by queuing the call on the
-    // main event loop). That way, we can respond to the platform event msg from
-    // the host firmware.
-    pdrFetchEvent = std::make_unique<sdeventplus::source::Defer>(
-        event, std::bind_front(std::mem_fn(&HostPDRHandler::_fetchPDR), this));
+    // A new fetch replaces the one in progress
+    pdrFetch = fetchHostPDRs();
 }
 
-void HostPDRHandler::_fetchPDR(sdeventplus::source::EventBase& /*source*/)
+pldm::requester::Task HostPDRHandler::fetchHostPDRs()
 {
-    getHostPDR();
+    // Defer the actual fetch of PDRs from the host to the next iteration of
+    // the main event loop. That way, we can respond to the platform event msg
+    // from the host firmware.
+    co_await pldm::requester::Yield(event);
+
+#ifdef HOST_PDR_CACHE
+    if (!pdrRecordHandles.empty() || !modifiedPDRRecordHandles.empty())
+    {
+        // Only a complete fetch is cached
+        pdrCache.invalidate();
+    }
+    else
+    {
+        std::vector<uint8_t> requestMsg(sizeof(pldm_msg_hdr));
+        auto request = reinterpret_cast<pldm_msg*>(requestMsg.data());
+        auto instanceId = requester.getInstanceId(mctp_eid);
+        auto rc = encode_pldm_header_only(PLDM_REQUEST, instanceId,
+                                          PLDM_PLATFORM,
+                                          PLDM_GET_PDR_REPOSITORY_INFO,
+                                          request);
+        if (rc != PLDM_SUCCESS)
+        {
+            requester.markFree(mctp_eid, instanceId);
+            error("Failed to encode GetPDRRepositoryInfo, rc = {RC}", "RC",
+                  rc);
+            co_return;
+        }
+
+        auto response = co_await handler->sendRecvMsg(mctp_eid,
+                                                      std::move(requestMsg));
+        RepositorySignature signature{};
+        uint8_t completionCode{};
+        uint8_t repositoryState{};
+        uint32_t largestRecordSize{};
+        uint8_t transferHandleTimeout{};
+        rc = response.empty()
+                 ? PLDM_ERROR
+                 : decode_get_pdr_repository_info_resp(
+                       reinterpret_cast<const pldm_msg*>(response.data()),
+                       response.size() - sizeof(pldm_msg_hdr),
+                       &completionCode, &repositoryState,
+                       signature.updateTime.data(),
+                       signature.oemUpdateTime.data(), &signature.recordCount,
+                       &signature.repositorySize, &largestRecordSize,
+                       &transferHandleTimeout);
+        if (rc != PLDM_SUCCESS || completionCode != PLDM_SUCCESS ||
+            repositoryState != PLDM_AVAILABLE)
+        {
+            // The host PDRs are fetched without the cache
+            info(
+                "No host PDR repository info, rc = {RC}, cc = {CC}, state = {STATE}",
+                "RC", rc, "CC", static_cast<unsigned>(completionCode),
+                "STATE", static_cast<unsigned>(repositoryState));
+            pdrCache.abort();
+        }
+        else if (pdrCacheReconnect &&
+                 pdrCache.load(signature,
+                               [this](std::span<const uint8_t> cached,
+                                      uint32_t next) {
+            std::vector<uint8_t> pdr(cached.begin(), cached.end());
+            processHostPDR(pdr, next);
+        }))
+        {
+            info("Loaded the host PDRs from the PDR cache");
+            pdrCacheReconnect = false;
+            co_return;
+        }
+        else
+        {
+            // Recorded on every complete fetch, loaded on reconnect only
+            pdrCache.begin(signature);
+        }
+        pdrCacheReconnect = false;
+    }
+#endif
+
+    uint32_t nextRecordHandle = 0;
+    do
+    {
+        auto recordHandle = nextPDRRecordHandle(nextRecordHandle);
+        std::vector<uint8_t> requestMsg(sizeof(pldm_msg_hdr) +
+                                        PLDM_GET_PDR_REQ_BYTES);
+        auto request = reinterpret_cast<pldm_msg*>(requestMsg.data());
+        auto instanceId = requester.getInstanceId(mctp_eid);
+
+        auto rc = encode_get_pdr_req(instanceId, recordHandle, 0,
+                                     PLDM_GET_FIRSTPART, UINT16_MAX, 0,
+                                     request, PLDM_GET_PDR_REQ_BYTES);
+        if (rc != PLDM_SUCCESS)
+        {
+            requester.markFree(mctp_eid, instanceId);
+            error("Failed to encode_get_pdr_req, rc = {RC}", "RC", rc);
+            co_return;
+        }
+
+        auto response = co_await handler->sendRecvMsg(mctp_eid,
+                                                      std::move(requestMsg));
+        nextRecordHandle = processHostPDRs(
+            reinterpret_cast<const pldm_msg*>(response.data()),
+            response.empty() ? 0 : response.size() - sizeof(pldm_msg_hdr));
+        if (nextRecordHandle)
+        {
+            // Let the other events in before the next request
+            co_await pldm::requester::Yield(event);
+        }
+    } while (nextRecordHandle);
 }
 
-void HostPDRHandler::getHostPDR(uint32_t nextRecordHandle)
+uint32_t HostPDRHandler::nextPDRRecordHandle(uint32_t nextRecordHandle)
 {
-    pdrFetchEvent.reset();
+    if (nextRecordHandle)
+    {
+        if (!pdrRecordHandles.empty())
+        {
+            nextRecordHandle = pdrRecordHandles.front();
+            pdrRecordHandles.pop_front();
+        }
+        else if (isHostPdrModified && (!modifiedPDRRecordHandles.empty()))
+        {
+            nextRecordHandle = modifiedPDRRecordHandles.front();
+            modifiedPDRRecordHandles.pop_front();
+        }
+    }
 
-    std::vector<uint8_t> requestMsg(sizeof(pldm_msg_hdr) +
-                                    PLDM_GET_PDR_REQ_BYTES);
-    auto request = reinterpret_cast<pldm_msg*>(requestMsg.data());
     uint32_t recordHandle{};
     if (!nextRecordHandle && (!modifiedPDRRecordHandles.empty()) &&
         isHostPdrModified)
@@ -352,27 +472,9 @@ void HostPDRHandler::getHostPDR(uint32_t nextRecordHandle)
     {
         recordHandle = nextRecordHandle;
     }
-    auto instanceId = requester.getInstanceId(mctp_eid);
-
-    auto rc = encode_get_pdr_req(instanceId, recordHandle, 0,
-                                 PLDM_GET_FIRSTPART, UINT16_MAX, 0, request,
-                                 PLDM_GET_PDR_REQ_BYTES);
-    if (rc != PLDM_SUCCESS)
-    {
-        requester.markFree(mctp_eid, instanceId);
-        error("Failed to encode_get_pdr_req, rc = {RC}", "RC", rc);
-        return;
-    }
-
-    rc = handler->registerRequest(
-        mctp_eid, instanceId, PLDM_PLATFORM, PLDM_GET_PDR,
-        std::move(requestMsg),
-        std::move(std::bind_front(&HostPDRHandler::processHostPDRs, this)));
-    if (rc)
-    {
-        error("Failed to send the GetPDR request to Host");
-    }
+    return recordHandle;
 }
+
 std::string HostPDRHandler::updateLedGroupPath(const std::string& path)
 {
     std::string ledGroupPath{};
@@ -390,62 +492,164 @@ int HostPDRHandler::handleStateSensorEvent(
     const std::vector<pldm::pdr::StateSetId>& stateSetId,
     const StateSensorEntry& entry, pdr::EventState state)
 {
-    for (auto& entity : objPathMap)
+    EventRoute route{};
+    route.mapped = true;
+    compileEventRoute(stateSetId, entry, route);
+    return runEventRoute(route, state);
+}
+
+int HostPDRHandler::handleStateSensorEvent(const SensorEntry& sensorEntry,
+                                           pdr::SensorOffset sensorOffset,
+                                           pdr::EventState state)
+{
+    const auto& route = lookupEventRoute(sensorEntry, sensorOffset);
+
+    // If there is no mapping for events return PLDM_SUCCESS
+    if (!route.mapped)
+    {
+        return PLDM_SUCCESS;
+    }
+
+    if (!route.possibleStates.contains(state))
+    {
+        return PLDM_ERROR_INVALID_DATA;
+    }
+
+    return runEventRoute(route, state);
+}
+
+const EventRoute&
+    HostPDRHandler::lookupEventRoute(const SensorEntry& sensorEntry,
+                                     pdr::SensorOffset sensorOffset)
+{
+    auto [it, inserted] = eventRoutes.try_emplace(EventRouteKey{
+        sensorEntry.terminusID, sensorEntry.sensorID, sensorOffset});
+    auto& route = it->second;
+    if (!inserted)
     {
-        pldm_entity node_entity = pldm_entity_extract(entity.second);
+        return route;
+    }
 
-        if (node_entity.entity_type != entry.entityType ||
-            node_entity.entity_instance_num != entry.entityInstance ||
-            node_entity.entity_container_id != entry.containerId)
+    auto sensor = sensorMap.find(sensorEntry);
+    if (sensor == sensorMap.end())
+    {
+        // If there is no mapping for tid, sensorId combination, try
+        // PLDM_TID_RESERVED, sensorId for terminus that is yet to
+        // implement TL PDR.
+        sensor = sensorMap.find({PLDM_TID_RESERVED, sensorEntry.sensorID});
+        if (sensor == sensorMap.end())
         {
-            continue;
+            return route;
         }
+    }
+
+    const auto& [entityInfo, compositeSensorStates, stateSetIds] =
+        sensor->second;
+    route.mapped = true;
 
-        for (const auto& setId : stateSetId)
+    // An invalid sensor offset has no possible states, so every event state
+    // is rejected as invalid data
+    if (sensorOffset >= compositeSensorStates.size() ||
+        sensorOffset >= stateSetIds.size())
+    {
+        return route;
+    }
+    route.possibleStates = compositeSensorStates[sensorOffset];
+
+    const auto& [containerId, entityType, entityInstance] = entityInfo;
+    StateSensorEntry entry{containerId,  entityType, entityInstance,
+                           sensorOffset, false,      stateSetIds[sensorOffset]};
+    compileEventRoute(stateSetIds, entry, route);
+    return route;
+}
+
+void HostPDRHandler::compileEventRoute(
+    const std::vector<pdr::StateSetId>& stateSetIds,
+    const StateSensorEntry& entry, EventRoute& route)
+{
+    if (!entityPathsValid)
+    {
+        entityPaths.clear();
+        for (const auto& [path, node] : objPathMap)
         {
-            if (setId == PLDM_STATE_SET_IDENTIFY_STATE)
+            if (node == nullptr)
             {
-                auto ledGroupPath = updateLedGroupPath(entity.first);
-                if (!ledGroupPath.empty())
-                {
-                    auto currVal =
-                        CustomDBus::getCustomDBus().getAsserted(ledGroupPath)
-                            ? "true"
-                            : "false";
-                    auto newVal =
-                        bool(state == PLDM_STATE_SET_IDENTIFY_STATE_ASSERTED);
-                    info(
-                        "led state event for [ {LED_GRP_PATH} ], [ {ENTITY_TYP}, {ENTITY_NUM}, {ENTITY_ID}] , current value : [ {CURR_VAL} ] new value : [ {NEW_VAL} ]",
-                        "LED_GRP_PATH", ledGroupPath, "ENTITY_TYP",
-                        (unsigned)node_entity.entity_type, "ENTITY_NUM",
-                        (unsigned)node_entity.entity_instance_num, "ENTITY_ID",
-                        (unsigned)node_entity.entity_container_id, "CURR_VAL",
-                        currVal, "NEW_VAL", (unsigned)newVal);
-                    CustomDBus::getCustomDBus().setAsserted(
-                        ledGroupPath, node_entity,
-                        state == PLDM_STATE_SET_IDENTIFY_STATE_ASSERTED,
-                        hostEffecterParser, mctp_eid);
-                }
+                continue;
             }
+            auto entity = pldm_entity_extract(node);
+            entityPaths[{entity.entity_type, entity.entity_instance_num,
+                         entity.entity_container_id}]
+                .push_back(path);
+        }
+        entityPathsValid = true;
+    }
+
+    route.entry = entry;
+    route.sensorStateSetId = stateSetIds.empty() ? 0 : stateSetIds[0];
+    route.identify = std::find(stateSetIds.begin(), stateSetIds.end(),
+                               PLDM_STATE_SET_IDENTIFY_STATE) !=
+                     stateSetIds.end();
+    route.eventInfo = stateSensorHandler.findEventInfo(entry);
+
+    auto paths = entityPaths.find(
+        {entry.entityType, entry.entityInstance, entry.containerId});
+    if (paths == entityPaths.end())
+    {
+        return;
+    }
+    for (const auto& path : paths->second)
+    {
+        route.targets.push_back(
+            {path, route.identify ? updateLedGroupPath(path) : std::string{},
+             getParentChassis(path)});
+    }
+}
+
+int HostPDRHandler::runEventRoute(const EventRoute& route,
+                                  pdr::EventState state)
+{
+    pldm_entity node_entity{route.entry.entityType, route.entry.entityInstance,
+                            route.entry.containerId};
+
+    for (const auto& target : route.targets)
+    {
+        if (route.identify && !target.ledGroupPath.empty())
+        {
+            auto currVal =
+                CustomDBus::getCustomDBus().getAsserted(target.ledGroupPath)
+                    ? "true"
+                    : "false";
+            auto newVal = bool(state == PLDM_STATE_SET_IDENTIFY_STATE_ASSERTED);
+            info(
+                "led state event for [ {LED_GRP_PATH} ], [ {ENTITY_TYP}, {ENTITY_NUM}, {ENTITY_ID}] , current value : [ {CURR_VAL} ] new value : [ {NEW_VAL} ]",
+                "LED_GRP_PATH", target.ledGroupPath, "ENTITY_TYP",
+                (unsigned)node_entity.entity_type, "ENTITY_NUM",
+                (unsigned)node_entity.entity_instance_num, "ENTITY_ID",
+                (unsigned)node_entity.entity_container_id, "CURR_VAL", currVal,
+                "NEW_VAL", (unsigned)newVal);
+            CustomDBus::getCustomDBus().setAsserted(
+                target.ledGroupPath, node_entity,
+                state == PLDM_STATE_SET_IDENTIFY_STATE_ASSERTED,
+                hostEffecterParser, mctp_eid);
         }
 
-        if ((stateSetId[0] == PLDM_STATE_SET_HEALTH_STATE ||
-             stateSetId[0] == PLDM_STATE_SET_OPERATIONAL_FAULT_STATUS))
+        if ((route.sensorStateSetId == PLDM_STATE_SET_HEALTH_STATE ||
+             route.sensorStateSetId == PLDM_STATE_SET_OPERATIONAL_FAULT_STATUS))
         {
             if (!(state == PLDM_OPERATIONAL_NORMAL) &&
-                stateSetId[0] == PLDM_STATE_SET_HEALTH_STATE &&
-                strstr(entity.first.c_str(), "core"))
+                route.sensorStateSetId == PLDM_STATE_SET_HEALTH_STATE &&
+                strstr(target.path.c_str(), "core"))
             {
                 error("Guard event on CORE : [{ENTITY_FIRST}]", "ENTITY_FIRST",
-                      entity.first.c_str());
+                      target.path.c_str());
             }
             CustomDBus::getCustomDBus().setOperationalStatus(
-                entity.first, state == PLDM_OPERATIONAL_NORMAL,
-                getParentChassis(entity.first));
+                target.path, state == PLDM_OPERATIONAL_NORMAL,
+                target.parentChassis);
 
             break;
         }
-        else if (stateSetId[0] == PLDM_STATE_SET_VERSION)
+        else if (route.sensorStateSetId == PLDM_STATE_SET_VERSION)
         {
             // There is a version changed on any of the dbus objects
             info("Got a signal from Host about a possible change in Version");
@@ -454,7 +658,13 @@ int HostPDRHandler::handleStateSensorEvent(
         }
     }
 
-    auto rc = stateSensorHandler.eventAction(entry, state);
+    if (route.eventInfo == nullptr)
+    {
+        // There is no BMC action for this PLDM event
+        return PLDM_SUCCESS;
+    }
+
+    auto rc = StateSensorHandler::eventAction(*route.eventInfo, state);
     if (rc != PLDM_SUCCESS)
     {
         error("Failed to fetch and update D-bus property, rc = {RC}", "RC", rc);
@@ -464,6 +674,13 @@ int HostPDRHandler::handleStateSensorEvent(
     return PLDM_SUCCESS;
 }
 
+void HostPDRHandler::invalidateEventRoutes()
+{
+    eventRoutes.clear();
+    entityPaths.clear();
+    entityPathsValid = false;
+}
+
 void HostPDRHandler::mergeEntityAssociations(
     const std::vector<uint8_t>& pdr, [[maybe_unused]] const uint32_t& size,
     [[maybe_unused]] const uint32_t& record_handle)
@@ -486,6 +703,7 @@ void HostPDRHandler::mergeEntityAssociations(
             // pldm_pdr_add() assert()ed on failure to add a PDR.
             throw std::runtime_error("Failed to add PDR");
         }
+        pldm::utils::pdrRepoChanged(pldm::utils::PdrRepoChange::added);
     }
 #endif
 
@@ -569,6 +787,7 @@ void HostPDRHandler::mergeEntityAssociations(
                     error("Failed to add entity association PDR from node:{RC}",
                           "RC", rc);
                 }
+                pldm::utils::pdrRepoChanged();
             }
             else
             {
@@ -583,6 +802,7 @@ void HostPDRHandler::mergeEntityAssociations(
                     error("Failed to add entity association PDR from node:{RC}",
                           "RC", rc);
                 }
+                pldm::utils::pdrRepoChanged();
             }
         }
     }
@@ -730,22 +950,13 @@ void HostPDRHandler::parseStateSensorPDRs()
         }
         sensorMap.emplace(sensorEntry, std::move(sensorInfo));
     }
+    invalidateEventRoutes();
 }
 
-void HostPDRHandler::processHostPDRs(mctp_eid_t /*eid*/,
-                                     const pldm_msg* response,
-                                     size_t respMsgLen)
+uint32_t HostPDRHandler::processHostPDRs(const pldm_msg* response,
+                                         size_t respMsgLen)
 {
-    static bool merged = false;
     uint32_t nextRecordHandle{};
-    uint32_t prevRh{};
-    uint8_t tlEid = 0;
-    bool tlValid = true;
-    uint32_t rh = 0;
-    uint16_t terminusHandle = 0;
-    uint16_t pdrTerminusHandle = 0;
-    uint8_t tid = 0;
-
     uint8_t completionCode{};
     uint32_t nextDataTransferHandle{};
     uint8_t transferFlag{};
@@ -754,215 +965,239 @@ void HostPDRHandler::processHostPDRs(mctp_eid_t /*eid*/,
     if (response == nullptr || !respMsgLen)
     {
         error("Failed to receive response for the GetPDR command");
-        return;
+#ifdef HOST_PDR_CACHE
+        pdrCache.abort();
+#endif
+        return 0;
     }
 
     auto rc = decode_get_pdr_resp(
         response, respMsgLen /*- sizeof(pldm_msg_hdr)*/, &completionCode,
         &nextRecordHandle, &nextDataTransferHandle, &transferFlag, &respCount,
         nullptr, 0, &transferCRC);
-    std::vector<uint8_t> responsePDRMsg;
-    responsePDRMsg.resize(respMsgLen + sizeof(pldm_msg_hdr));
-    memcpy(responsePDRMsg.data(), response, respMsgLen + sizeof(pldm_msg_hdr));
     if (rc != PLDM_SUCCESS)
     {
         error("Failed to decode_get_pdr_resp, rc = {RC}", "RC", rc);
-        return;
+#ifdef HOST_PDR_CACHE
+        pdrCache.abort();
+#endif
+        return 0;
+    }
+
+    std::vector<uint8_t> pdr(respCount, 0);
+    rc = decode_get_pdr_resp(response, respMsgLen, &completionCode,
+                             &nextRecordHandle, &nextDataTransferHandle,
+                             &transferFlag, &respCount, pdr.data(), respCount,
+                             &transferCRC);
+    if (rc != PLDM_SUCCESS || completionCode != PLDM_SUCCESS ||
+        pdr.size() < sizeof(pldm_pdr_hdr))
+    {
+        error(
+            "Failed to decode_get_pdr_resp: rc = {RC}, NextRecordhandle : {NXT_RECORD_HNDL}, cc = {CC}",
+            "RC", rc, "NXT_RECORD_HNDL", nextRecordHandle, "CC",
+            static_cast<unsigned>(completionCode));
+#ifdef HOST_PDR_CACHE
+        pdrCache.abort();
+#endif
+        return 0;
+    }
+
+#ifdef HOST_PDR_CACHE
+    // Recorded as received, before the container IDs are updated below
+    pdrCache.add(pdr, nextRecordHandle);
+#endif
+    return processHostPDR(pdr, nextRecordHandle);
+}
+
+uint32_t HostPDRHandler::processHostPDR(std::vector<uint8_t>& pdr,
+                                        uint32_t nextRecordHandle)
+{
+    static bool merged = false;
+    uint32_t prevRh{};
+    uint8_t tlEid = 0;
+    bool tlValid = true;
+    uint32_t rh = 0;
+    uint16_t terminusHandle = 0;
+    uint16_t pdrTerminusHandle = 0;
+    uint8_t tid = 0;
+    auto respCount = static_cast<uint16_t>(pdr.size());
+
+    // when nextRecordHandle is 0, we need the recordHandle of the last
+    // PDR and not 0-1.
+    if (!nextRecordHandle)
+    {
+        rh = nextRecordHandle;
+    }
+    else
+    {
+        rh = nextRecordHandle - 1;
+    }
+
+    auto pdrHdr = reinterpret_cast<pldm_pdr_hdr*>(pdr.data());
+    if (!rh)
+    {
+        rh = pdrHdr->record_handle;
+    }
+
+    if (pdrHdr->type == PLDM_PDR_ENTITY_ASSOCIATION)
+    {
+        this->mergeEntityAssociations(pdr, respCount, rh);
+        merged = true;
     }
     else
     {
-        std::vector<uint8_t> pdr(respCount, 0);
-        rc = decode_get_pdr_resp(response, respMsgLen, &completionCode,
-                                 &nextRecordHandle, &nextDataTransferHandle,
-                                 &transferFlag, &respCount, pdr.data(),
-                                 respCount, &transferCRC);
-        if (rc != PLDM_SUCCESS || completionCode != PLDM_SUCCESS)
+        if (pdrHdr->type == PLDM_TERMINUS_LOCATOR_PDR)
         {
+            pdrTerminusHandle =
+                extractTerminusHandle<pldm_terminus_locator_pdr>(pdr);
+            auto tlpdr =
+                reinterpret_cast<const pldm_terminus_locator_pdr*>(pdr.data());
+
+            terminusHandle = tlpdr->terminus_handle;
+            tid = tlpdr->tid;
             error(
-                "Failed to decode_get_pdr_resp: rc = {RC}, NextRecordhandle : {NXT_RECORD_HNDL}, cc = {CC}",
-                "RC", rc, "NXT_RECORD_HNDL", nextRecordHandle, "CC",
-                static_cast<unsigned>(completionCode));
-            return;
-        }
-        else
-        {
-            // when nextRecordHandle is 0, we need the recordHandle of the last
-            // PDR and not 0-1.
-            if (!nextRecordHandle)
+                "Got a terminus Locator PDR with TID: {TID} and Terminus handle: {TERMINUS_HNDL} with Valid bit as: {VALID_BIT}",
+                "TID", (unsigned)tid, "TERMINUS_HNDL", terminusHandle,
+                "VALID_BIT", (unsigned)tlpdr->validity);
+            auto terminus_locator_type = tlpdr->terminus_locator_type;
+            if (terminus_locator_type == PLDM_TERMINUS_LOCATOR_TYPE_MCTP_EID)
             {
-                rh = nextRecordHandle;
+                auto locatorValue = reinterpret_cast<
+                    const pldm_terminus_locator_type_mctp_eid*>(
+                    tlpdr->terminus_locator_value);
+                tlEid = static_cast<uint8_t>(locatorValue->eid);
             }
-            else
+            if (tlpdr->validity == 0)
             {
-                rh = nextRecordHandle - 1;
+                tlValid = false;
             }
+            tlPDRInfo.insert_or_assign(
+                tlpdr->terminus_handle,
+                std::make_tuple(tlpdr->tid, tlEid, tlpdr->validity));
+        }
+        else if (pdrHdr->type == PLDM_STATE_SENSOR_PDR)
+        {
+            pdrTerminusHandle =
+                extractTerminusHandle<pldm_state_sensor_pdr>(pdr);
+            updateContanierId<pldm_state_sensor_pdr>(entityTree, pdr);
+            stateSensorPDRs.emplace_back(pdr);
+        }
+        else if (pdrHdr->type == PLDM_PDR_FRU_RECORD_SET)
+        {
+            pdrTerminusHandle =
+                extractTerminusHandle<pldm_pdr_fru_record_set>(pdr);
+            updateContanierId<pldm_pdr_fru_record_set>(entityTree, pdr);
+            fruRecordSetPDRs.emplace_back(pdr);
+        }
+        else if (pdrHdr->type == PLDM_STATE_EFFECTER_PDR)
+        {
+            pdrTerminusHandle =
+                extractTerminusHandle<pldm_state_effecter_pdr>(pdr);
+            updateContanierId<pldm_state_effecter_pdr>(entityTree, pdr);
+        }
+        else if (pdrHdr->type == PLDM_NUMERIC_EFFECTER_PDR)
+        {
+            pdrTerminusHandle =
+                extractTerminusHandle<pldm_numeric_effecter_value_pdr>(pdr);
+            updateContanierId<pldm_numeric_effecter_value_pdr>(entityTree, pdr);
+        }
 
-            auto pdrHdr = reinterpret_cast<pldm_pdr_hdr*>(pdr.data());
-            if (!rh)
-            {
-                rh = pdrHdr->record_handle;
-            }
+        // if the TLPDR is invalid update the repo accordingly
+        if (!tlValid)
+        {
+            pldm_pdr_update_TL_pdr(repo, terminusHandle, tid, tlEid, tlValid);
+            pldm::utils::pdrRepoChanged();
 
-            if (pdrHdr->type == PLDM_PDR_ENTITY_ASSOCIATION)
+            if (!isHostUp())
             {
-                this->mergeEntityAssociations(pdr, respCount, rh);
-                merged = true;
+                // since HB is sending down the TL PDR in the beginning
+                // of the PDR exchange, do not continue PDR exchange
+                // when the TL PDR is invalid.
+                nextRecordHandle = 0;
+#ifdef HOST_PDR_CACHE
+                pdrCache.abort();
+#endif
             }
-            else
+        }
+        else
+        {
+            if ((isHostPdrModified == true) || !(modifiedCounter == 0))
             {
-                if (pdrHdr->type == PLDM_TERMINUS_LOCATOR_PDR)
+                bool recFound =
+                    pldm_pdr_find_prev_record_handle(repo, rh, &prevRh);
+
+                if (recFound)
                 {
-                    pdrTerminusHandle =
-                        extractTerminusHandle<pldm_terminus_locator_pdr>(pdr);
-                    auto tlpdr =
-                        reinterpret_cast<const pldm_terminus_locator_pdr*>(
-                            pdr.data());
-
-                    terminusHandle = tlpdr->terminus_handle;
-                    tid = tlpdr->tid;
-                    error(
-                        "Got a terminus Locator PDR with TID: {TID} and Terminus handle: {TERMINUS_HNDL} with Valid bit as: {VALID_BIT}",
-                        "TID", (unsigned)tid, "TERMINUS_HNDL", terminusHandle,
-                        "VALID_BIT", (unsigned)tlpdr->validity);
-                    auto terminus_locator_type = tlpdr->terminus_locator_type;
-                    if (terminus_locator_type ==
-                        PLDM_TERMINUS_LOCATOR_TYPE_MCTP_EID)
+                    // pldm_delete_by_record_handle to delete
+                    // the effecter from the repo using record handle.
+                    pldm_delete_by_record_handle(repo, rh, true);
+
+                    // call pldm_pdr_add_after_prev_record to add the
+                    // record into the repo from where it was deleted
+                    pldm_pdr_add_after_prev_record(repo, pdr.data(),
+                                                   respCount, rh, true, prevRh,
+                                                   pdrTerminusHandle);
+                    pldm::utils::pdrRepoChanged();
+
+                    if ((pdrHdr->type == PLDM_STATE_EFFECTER_PDR) &&
+                        (oemPlatformHandler != nullptr))
                     {
-                        auto locatorValue = reinterpret_cast<
-                            const pldm_terminus_locator_type_mctp_eid*>(
-                            tlpdr->terminus_locator_value);
-                        tlEid = static_cast<uint8_t>(locatorValue->eid);
-                    }
-                    if (tlpdr->validity == 0)
-                    {
-                        tlValid = false;
+                        auto effecterPdr =
+                            reinterpret_cast<const pldm_state_effecter_pdr*>(
+                                pdr.data());
+                        auto entityType = effecterPdr->entity_type;
+                        auto statesPtr = effecterPdr->possible_states;
+                        auto compEffCount =
+                            effecterPdr->composite_effecter_count;
+
+                        while (compEffCount--)
+                        {
+                            auto state = reinterpret_cast<
+                                const state_effecter_possible_states*>(
+                                statesPtr);
+                            auto stateSetID = state->state_set_id;
+                            oemPlatformHandler->modifyPDROemActions(
+                                entityType, stateSetID);
+
+                            if (compEffCount)
+                            {
+                                statesPtr +=
+                                    sizeof(state_effecter_possible_states) +
+                                    state->possible_states_size - 1;
+                            }
+                        }
                     }
-                    tlPDRInfo.insert_or_assign(
-                        tlpdr->terminus_handle,
-                        std::make_tuple(tlpdr->tid, tlEid, tlpdr->validity));
-                }
-                else if (pdrHdr->type == PLDM_STATE_SENSOR_PDR)
-                {
-                    pdrTerminusHandle =
-                        extractTerminusHandle<pldm_state_sensor_pdr>(pdr);
-                    updateContanierId<pldm_state_sensor_pdr>(entityTree, pdr);
-                    stateSensorPDRs.emplace_back(pdr);
-                }
-                else if (pdrHdr->type == PLDM_PDR_FRU_RECORD_SET)
-                {
-                    pdrTerminusHandle =
-                        extractTerminusHandle<pldm_pdr_fru_record_set>(pdr);
-                    updateContanierId<pldm_pdr_fru_record_set>(entityTree, pdr);
-                    fruRecordSetPDRs.emplace_back(pdr);
-                }
-                else if (pdrHdr->type == PLDM_STATE_EFFECTER_PDR)
-                {
-                    pdrTerminusHandle =
-                        extractTerminusHandle<pldm_state_effecter_pdr>(pdr);
-                    updateContanierId<pldm_state_effecter_pdr>(entityTree, pdr);
-                }
-                else if (pdrHdr->type == PLDM_NUMERIC_EFFECTER_PDR)
-                {
-                    pdrTerminusHandle =
-                        extractTerminusHandle<pldm_numeric_effecter_value_pdr>(
-                            pdr);
-                    updateContanierId<pldm_numeric_effecter_value_pdr>(
-                        entityTree, pdr);
+                    modifiedCounter--;
                 }
-
-                // if the TLPDR is invalid update the repo accordingly
-                if (!tlValid)
+            }
+            // We need to look for an optimal solution for this, we are
+            // unexpectedly entering this path when we receive multiple
+            // modified PDR repo change events
+            else if ((isHostPdrModified != true) && (modifiedCounter == 0))
+            {
+                bool recFound =
+                    pldm_pdr_find_prev_record_handle(repo, rh, &prevRh);
+                if (recFound)
                 {
-                    pldm_pdr_update_TL_pdr(repo, terminusHandle, tid, tlEid,
-                                           tlValid);
+                    pldm_delete_by_record_handle(repo, rh, true);
 
-                    if (!isHostUp())
-                    {
-                        // since HB is sending down the TL PDR in the beginning
-                        // of the PDR exchange, do not continue PDR exchange
-                        // when the TL PDR is invalid.
-                        nextRecordHandle = 0;
-                    }
+                    pldm_pdr_add_after_prev_record(repo, pdr.data(),
+                                                   respCount, rh, true, prevRh,
+                                                   pdrTerminusHandle);
+                    pldm::utils::pdrRepoChanged();
                 }
                 else
                 {
-                    if ((isHostPdrModified == true) || !(modifiedCounter == 0))
-                    {
-                        bool recFound =
-                            pldm_pdr_find_prev_record_handle(repo, rh, &prevRh);
-
-                        if (recFound)
-                        {
-                            // pldm_delete_by_record_handle to delete
-                            // the effecter from the repo using record handle.
-                            pldm_delete_by_record_handle(repo, rh, true);
-
-                            // call pldm_pdr_add_after_prev_record to add the
-                            // record into the repo from where it was deleted
-                            pldm_pdr_add_after_prev_record(
-                                repo, pdr.data(), respCount, rh, true, prevRh,
-                                pdrTerminusHandle);
-
-                            if ((pdrHdr->type == PLDM_STATE_EFFECTER_PDR) &&
-                                (oemPlatformHandler != nullptr))
-                            {
-                                auto effecterPdr = reinterpret_cast<
-                                    const pldm_state_effecter_pdr*>(pdr.data());
-                                auto entityType = effecterPdr->entity_type;
-                                auto statesPtr = effecterPdr->possible_states;
-                                auto compEffCount =
-                                    effecterPdr->composite_effecter_count;
-
-                                while (compEffCount--)
-                                {
-                                    auto state = reinterpret_cast<
-                                        const state_effecter_possible_states*>(
-                                        statesPtr);
-                                    auto stateSetID = state->state_set_id;
-                                    oemPlatformHandler->modifyPDROemActions(
-                                        entityType, stateSetID);
-
-                                    if (compEffCount)
-                                    {
-                                        statesPtr +=
-                                            sizeof(
-                                                state_effecter_possible_states) +
-                                            state->possible_states_size - 1;
-                                    }
-                                }
-                            }
-                            modifiedCounter--;
-                        }
-                    }
-                    // We need to look for an optimal solution for this, we are
-                    // unexpectedly entering this path when we receive multiple
-                    // modified PDR repo change events
-                    else if ((isHostPdrModified != true) &&
-                             (modifiedCounter == 0))
+                    auto rc = pldm_pdr_add_check(repo, pdr.data(), respCount,
+                                                 true, pdrTerminusHandle, &rh);
+                    if (rc)
                     {
-                        bool recFound =
-                            pldm_pdr_find_prev_record_handle(repo, rh, &prevRh);
-                        if (recFound)
-                        {
-                            pldm_delete_by_record_handle(repo, rh, true);
-
-                            pldm_pdr_add_after_prev_record(
-                                repo, pdr.data(), respCount, rh, true, prevRh,
-                                pdrTerminusHandle);
-                        }
-                        else
-                        {
-                            rc = pldm_pdr_add_check(repo, pdr.data(), respCount,
-                                                    true, pdrTerminusHandle,
-                                                    &rh);
-                            if (rc)
-                            {
-                                // pldm_pdr_add() assert()ed on failure to add a
-                                // PDR.
-                                throw std::runtime_error("Failed to add PDR");
-                            }
-                        }
+                        // pldm_pdr_add() assert()ed on failure to add a
+                        // PDR.
+                        throw std::runtime_error("Failed to add PDR");
                     }
+                    pldm::utils::pdrRepoChanged(
+                        pldm::utils::PdrRepoChange::added);
                 }
             }
         }
@@ -978,6 +1213,7 @@ void HostPDRHandler::processHostPDRs(mctp_eid_t /*eid*/,
               "LAST_REC_HNDL", lastRecord->record_handle);
         pldm::hostbmc::utils::updateEntityAssociation(
             entityAssociations, entityTree, objPathMap, oemPlatformHandler);
+        invalidateEventRoutes();
 
         pldm::serialize::Serialize::getSerialize().setObjectPathMaps(
             objPathMap);
@@ -999,6 +1235,10 @@ void HostPDRHandler::processHostPDRs(mctp_eid_t /*eid*/,
         entityAssociations.clear();
         mergedHostParents = false;
 
+#ifdef HOST_PDR_CACHE
+        pdrCache.commit();
+#endif
+
         if (merged)
         {
             merged = false;
@@ -1018,14 +1258,10 @@ void HostPDRHandler::processHostPDRs(mctp_eid_t /*eid*/,
         }
         else
         {
-            deferredFetchPDREvent =
-                std::make_unique<sdeventplus::source::Defer>(
-                    event,
-                    std::bind(
-                        std::mem_fn((&HostPDRHandler::_processFetchPDREvent)),
-                        this, nextRecordHandle, std::placeholders::_1));
+            return nextRecordHandle;
         }
     }
+    return 0;
 }
 
 void HostPDRHandler::_processPDRRepoChgEvent(
@@ -1041,23 +1277,6 @@ void HostPDRHandler::_processPDRRepoChgEvent(
         FORMAT_IS_PDR_HANDLES);
 }
 
-void HostPDRHandler::_processFetchPDREvent(
-    uint32_t nextRecordHandle, sdeventplus::source::EventBase& /*source */)
-{
-    deferredFetchPDREvent.reset();
-    if (!this->pdrRecordHandles.empty())
-    {
-        nextRecordHandle = this->pdrRecordHandles.front();
-        this->pdrRecordHandles.pop_front();
-    }
-    else if (isHostPdrModified && (!this->modifiedPDRRecordHandles.empty()))
-    {
-        nextRecordHandle = this->modifiedPDRRecordHandles.front();
-        this->modifiedPDRRecordHandles.pop_front();
-    }
-    this->getHostPDR(nextRecordHandle);
-}
-
 void HostPDRHandler::setHostFirmwareCondition()
 {
     responseReceived = false;
@@ -1087,6 +1306,11 @@ void HostPDRHandler::setHostFirmwareCondition()
         error("Getting the response. PLDM RC = {RC}", "RC", lg2::hex,
               (uint16_t)response->payload[0]);
         this->responseReceived = true;
+#ifdef HOST_PDR_CACHE
+        // The BMC was reset with the host running, its PDRs are likely
+        // those cached before the reset
+        this->pdrCacheReconnect = true;
+#endif
     };
     rc = handler->registerRequest(mctp_eid, instanceId, PLDM_BASE,
                                   PLDM_GET_PLDM_VERSION, std::move(requestMsg),
@@ -1372,13 +1596,37 @@ void HostPDRHandler::getFRURecordTableMetadataByHost()
 
 void HostPDRHandler::getFRURecordTableByHost(uint16_t& total_table_records)
 {
-    fruRecordData.clear();
+    fruRecordStream.reset();
 
     if (!total_table_records)
     {
         return;
     }
 
+    fruRecordPaths.clear();
+    for (const auto& [path, node] : objPathMap)
+    {
+        if (node == nullptr)
+        {
+            continue;
+        }
+        pldm_entity entity = pldm_entity_extract(node);
+        fruRecordPaths[getRSI(entity)].emplace_back(path, entity.entity_type);
+    }
+
+    ++fruFetchGeneration;
+    fruTableRecords = total_table_records;
+    changedFruRecords = 0;
+    fruRecordStream.emplace(
+        [this](const responder::pdr_utils::FruRecordView& record) {
+        processFruRecord(record);
+    });
+    getFRURecordTablePart(0, PLDM_GET_FIRSTPART);
+}
+
+void HostPDRHandler::getFRURecordTablePart(uint32_t transferHandle,
+                                           uint8_t transferOpFlag)
+{
     auto instanceId = requester.getInstanceId(mctp_eid);
     std::vector<uint8_t> requestMsg(sizeof(pldm_msg_hdr) +
                                     PLDM_GET_FRU_RECORD_TABLE_REQ_BYTES);
@@ -1386,21 +1634,28 @@ void HostPDRHandler::getFRURecordTableByHost(uint16_t& total_table_records)
     // send the getFruRecordTable command
     auto request = reinterpret_cast<pldm_msg*>(requestMsg.data());
     auto rc = encode_get_fru_record_table_req(
-        instanceId, 0, PLDM_GET_FIRSTPART, request,
+        instanceId, transferHandle, transferOpFlag, request,
         requestMsg.size() - sizeof(pldm_msg_hdr));
     if (rc != PLDM_SUCCESS)
     {
         requester.markFree(mctp_eid, instanceId);
         error("Failed to encode_get_fru_record_table_req, rc = {RC}", "RC", rc);
+        fruRecordStream.reset();
         return;
     }
 
     auto getFruRecordTableResponseHandler =
-        [total_table_records, this](
+        [this, generation = fruFetchGeneration](
             mctp_eid_t /*eid*/, const pldm_msg* response, size_t respMsgLen) {
-        if (response == nullptr || !respMsgLen)
+        if (generation != fruFetchGeneration || !fruRecordStream)
+        {
+            // The part belongs to a fetch that was restarted or ended
+            return;
+        }
+        if (response == nullptr || !respMsgLen || isHostOff)
         {
             error("Failed to receive response for the Get FRU Record Table");
+            fruRecordStream.reset();
             return;
         }
 
@@ -1420,21 +1675,21 @@ void HostPDRHandler::getFRURecordTableByHost(uint16_t& total_table_records)
             error(
                 "Failed to decode get fru record table resp, Message Error: rc = {RC}, cc = {CC}",
                 "RC", rc, "CC", (int)cc);
+            fruRecordStream.reset();
             return;
         }
 
-        fruRecordData = responder::pdr_utils::parseFruRecordTable(
-            fru_record_table_data.data(), fru_record_table_length);
+        // The records are applied as soon as they are decoded, the part
+        // is not kept
+        fruRecordStream->feed(std::span<const uint8_t>(
+            fru_record_table_data.data(), fru_record_table_length));
 
-        if (total_table_records != fruRecordData.size())
+        if (transfer_flag == PLDM_END || transfer_flag == PLDM_START_AND_END)
         {
-            fruRecordData.clear();
-
-            error("failed to parse fru recrod data format.");
+            endFRURecordTableFetch();
             return;
         }
-
-        this->setLocationCode(fruRecordData);
+        getFRURecordTablePart(next_data_transfer_handle, PLDM_GET_NEXTPART);
     };
 
     rc = handler->registerRequest(
@@ -1442,8 +1697,58 @@ void HostPDRHandler::getFRURecordTableByHost(uint16_t& total_table_records)
         std::move(requestMsg), std::move(getFruRecordTableResponseHandler));
     if (rc != PLDM_SUCCESS)
     {
-        error("Failed to send the the Set State Effecter States request");
+        error("Failed to send the Get FRU Record Table request");
+        fruRecordStream.reset();
+    }
+}
+
+void HostPDRHandler::processFruRecord(
+    const responder::pdr_utils::FruRecordView& record)
+{
+    auto paths = fruRecordPaths.find(record.rsi);
+    if (paths == fruRecordPaths.end())
+    {
+        return;
+    }
+
+    auto hash = std::hash<std::string_view>{}(std::string_view(
+        reinterpret_cast<const char*>(record.data.data()), record.data.size()));
+    bool changed = false;
+    for (const auto& [path, entityType] : paths->second)
+    {
+        auto [applied, added] =
+            fruRecordHashes[path].try_emplace(record.type, hash);
+        if (!added && applied->second == hash)
+        {
+            continue;
+        }
+        applied->second = hash;
+        changed = true;
+        setFruRecordProperties(path, entityType, record);
     }
+    changedFruRecords += changed;
+}
+
+void HostPDRHandler::endFRURecordTableFetch()
+{
+    if (!fruRecordStream->complete() ||
+        fruRecordStream->records() != fruTableRecords)
+    {
+        // The records already decoded are applied, the next fetch applies
+        // all the records again
+        error(
+            "failed to parse fru recrod data format, {RECORDS} records of {TOTAL}",
+            "RECORDS", fruRecordStream->records(), "TOTAL", fruTableRecords);
+        fruRecordHashes.clear();
+    }
+    else
+    {
+        info("Fetched {RECORDS} FRU records of the host, {CHANGED} changed",
+             "RECORDS", fruRecordStream->records(), "CHANGED",
+             changedFruRecords);
+    }
+    fruRecordStream.reset();
+    fruRecordPaths.clear();
 }
 
 pdr::EID HostPDRHandler::getMctpEID(const pldm::pdr::TerminusID& tid)
@@ -1609,61 +1914,33 @@ uint16_t HostPDRHandler::getRSI(const pldm_entity& entity)
     return fruRSI;
 }
 
-void HostPDRHandler::setLocationCode(
-    const std::vector<responder::pdr_utils::FruRecordDataFormat>& fruRecordData)
+void HostPDRHandler::setFruRecordProperties(
+    const std::string& path, uint16_t entityType,
+    const responder::pdr_utils::FruRecordView& record)
 {
-    for (auto& entity : objPathMap)
+#ifdef OEM_IBM
+    if (record.type == PLDM_FRU_RECORD_TYPE_OEM)
     {
-        pldm_entity node = pldm_entity_extract(entity.second);
-        auto fruRSI = getRSI(node);
-
-        for (auto& data : fruRecordData)
-        {
-            if (fruRSI != data.fruRSI)
+        record.forEachField([&path](const auto& field) {
+            if (field.type == PLDM_OEM_FRU_FIELD_TYPE_LOCATION_CODE)
             {
-                continue;
-            }
-
-#ifdef OEM_IBM
-            if (data.fruRecType == PLDM_FRU_RECORD_TYPE_OEM)
-            {
-                for (auto& tlv : data.fruTLV)
-                {
-                    if (tlv.fruFieldType ==
-                        PLDM_OEM_FRU_FIELD_TYPE_LOCATION_CODE)
-                    {
-                        CustomDBus::getCustomDBus().setLocationCode(
-                            entity.first,
-                            std::string(reinterpret_cast<const char*>(
-                                            tlv.fruFieldValue.data()),
-                                        tlv.fruFieldLen));
-                    }
-                }
+                CustomDBus::getCustomDBus().setLocationCode(
+                    path, std::string(field.str()));
             }
+        });
+        return;
+    }
 #endif
-            else
-            {
-                for (auto& tlv : data.fruTLV)
-                {
-                    if (tlv.fruFieldType == PLDM_FRU_FIELD_TYPE_VERSION &&
-                        node.entity_type == PLDM_ENTITY_SYSTEM_CHASSIS)
-                    {
-                        auto mex_vers =
-                            std::string(reinterpret_cast<const char*>(
-                                            tlv.fruFieldValue.data()),
-                                        tlv.fruFieldLen);
-                        info("Refreshing the mex firmware version : {MEX_VERS}",
-                             "MEX_VERS", mex_vers);
-                        CustomDBus::getCustomDBus().setSoftwareVersion(
-                            entity.first,
-                            std::string(reinterpret_cast<const char*>(
-                                            tlv.fruFieldValue.data()),
-                                        tlv.fruFieldLen));
-                    }
-                }
-            }
+    record.forEachField([&path, entityType](const auto& field) {
+        if (field.type == PLDM_FRU_FIELD_TYPE_VERSION &&
+            entityType == PLDM_ENTITY_SYSTEM_CHASSIS)
+        {
+            info("Refreshing the mex firmware version : {MEX_VERS}",
+                 "MEX_VERS", field.str());
+            CustomDBus::getCustomDBus().setSoftwareVersion(
+                path, std::string(field.str()));
         }
-    }
+    });
 }
 void HostPDRHandler::setOperationStatus()
 {
@@ -1896,12 +2173,14 @@ void HostPDRHandler::deleteDbusObjects(const std::vector<uint16_t> types)
                 info("Erasing Dbus Path from ObjectMap {DBUS_PATH}",
                      "DBUS_PATH", path.c_str());
                 objPathMap.erase(path);
+                invalidateEventRoutes();
                 // Delete the Mex Led Dbus Object paths
                 auto ledGroupPath = updateLedGroupPath(path);
                 pldm::dbus::CustomDBus::getCustomDBus().deleteObject(
                     ledGroupPath);
             }
             pldm::dbus::CustomDBus::getCustomDBus().deleteObject(path);
+            fruRecordHashes.erase(path);
         }
     }
 }
@@ -1987,13 +2266,19 @@ void HostPDRHandler::deletePDRFromRepo(PDRRecordHandles&& recordHandles)
               recordHandle);
         this->setRecordPresent(recordHandle);
         pldm_delete_by_record_handle(repo, recordHandle, true);
+        pldm::utils::pdrRepoChanged();
     }
+#ifdef HOST_PDR_CACHE
+    // The repo no longer matches a complete fetch
+    pdrCache.invalidate();
+#endif
 }
 
 void HostPDRHandler::updateObjectPathMaps(const std::string& path,
                                           pldm_entity_node* node)
 {
     objPathMap[path] = node;
+    invalidateEventRoutes();
 }
 
 } // namespace pldm
@@ -8,6 +8,7 @@
 #include "common/utils.hpp"
 #include "dbus_to_host_effecters.hpp"
 #include "host_associations_parser.hpp"
+#include "host_pdr_cache.hpp"
 #include "libpldmresponder/event_parser.hpp"
 #include "libpldmresponder/oem_handler.hpp"
 #include "libpldmresponder/pdr_utils.hpp"
@@ -22,8 +23,13 @@
 #include <filesystem>
 #include <map>
 #include <memory>
+#include <optional>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 
+class TestSensorEvent;
+
 namespace pldm
 {
 
@@ -57,6 +63,43 @@ struct SensorEntry
 };
 
 using HostStateSensorMap = std::map<SensorEntry, pdr::SensorInfo>;
+
+/** @struct EventTarget
+ *
+ *  EventTarget is a D-Bus object of the entity that a host state sensor event
+ *  is routed to, with the paths needed by the event actions resolved upfront.
+ */
+struct EventTarget
+{
+    ObjectPath path;           //!< object path of the entity
+    std::string ledGroupPath;  //!< LED group of the entity, empty if none
+    std::string parentChassis; //!< object path of the parent chassis
+};
+
+/** @struct EventRoute
+ *
+ *  EventRoute is the compiled BMC action for a sensor offset of a host state
+ *  sensor, so that a PlatformEventMessage command with sensorEvent type is
+ *  handled without searching the object paths or the event configuration.
+ */
+struct EventRoute
+{
+    bool mapped = false; //!< a host state sensor PDR exists for the sensor
+    pdr::PossibleStates possibleStates; //!< valid event states of the offset
+    pdr::StateSetId sensorStateSetId = 0; //!< state set of the first offset
+    bool identify = false; //!< the sensor has an identify state set
+    pldm::responder::events::StateSensorEntry entry{}; //!< sensor entity
+    std::vector<EventTarget> targets; //!< D-Bus objects of the entity
+    /** @brief D-Bus property configured for the entry, nullptr if none */
+    const pldm::responder::events::EventDBusInfo* eventInfo = nullptr;
+};
+
+using EventRouteKey =
+    std::tuple<pdr::TerminusID, pdr::SensorID, pdr::SensorOffset>;
+using EventRoutes = std::map<EventRouteKey, EventRoute>;
+using EntityKey =
+    std::tuple<pdr::EntityType, pdr::EntityInstance, pdr::ContainerID>;
+using EntityPathIndex = std::map<EntityKey, std::vector<ObjectPath>>;
 using PDRList = std::vector<std::vector<uint8_t>>;
 
 /** @class HostPDRHandler
@@ -148,6 +191,30 @@ class HostPDRHandler
         const pldm::responder::events::StateSensorEntry& entry,
         pdr::EventState state);
 
+    /** @brief Handles state sensor event through the compiled event routes
+     *
+     *  @param[in] sensorEntry - TerminusID and SensorID of the event
+     *  @param[in] sensorOffset - sensor offset of the event
+     *  @param[in] state - event state
+     *
+     *  @return PLDM completion code, PLDM_SUCCESS if there is no host state
+     *          sensor PDR for the sensor
+     */
+    int handleStateSensorEvent(const SensorEntry& sensorEntry,
+                               pdr::SensorOffset sensorOffset,
+                               pdr::EventState state);
+
+    /** @brief Lookup the event route of a host state sensor offset, the
+     *         route is compiled on the first event of the sensor offset
+     *
+     *  @param[in] sensorEntry - TerminusID and SensorID
+     *  @param[in] sensorOffset - sensor offset
+     *
+     *  @return event route of the sensor offset
+     */
+    const EventRoute& lookupEventRoute(const SensorEntry& sensorEntry,
+                                       pdr::SensorOffset sensorOffset);
+
     /** @brief Parse state sensor PDRs and populate the sensorMap lookup data
      *         structure
      *
@@ -157,13 +224,6 @@ class HostPDRHandler
      */
     void parseStateSensorPDRs();
 
-    /** @brief this function sends a GetPDR request to Host firmware.
-     *  And processes the PDRs based on type
-     *
-     *  @param[in] - nextRecordHandle - the next record handle to ask for
-     */
-    void getHostPDR(uint32_t nextRecordHandle = 0);
-
     /** @brief set the Host firmware condition when pldmd starts
      */
     void setHostFirmwareCondition();
@@ -207,6 +267,8 @@ class HostPDRHandler
     void deleteDbusObjects(const std::vector<uint16_t> types);
 
   private:
+    friend class ::TestSensorEvent;
+
     /** @brief set the FRU presence based on the host off signal
      */
     void setPresenceFrus();
@@ -220,12 +282,18 @@ class HostPDRHandler
      */
     void setRecordPresent(uint32_t recorHandle);
 
-    /** @brief deferred function to fetch PDR from Host, scheduled to work on
-     *  the event loop. The PDR exchg with the host is async.
-     *
-     *  @param[in] source - sdeventplus event source
+    /** @brief fetch the PDRs from Host, one GetPDR request at a time. The
+     *  PDR exchg with the host is async, the coroutine runs on the event loop
+     *  and is cancelled when a new fetch starts.
      */
-    void _fetchPDR(sdeventplus::source::EventBase& source);
+    pldm::requester::Task fetchHostPDRs();
+
+    /** @brief pick the record handle of the next GetPDR request
+     *  @param[in] nextRecordHandle - next record handle sent by Host, 0 at
+     *                                the start of the fetch
+     *  @return the record handle to ask for
+     */
+    uint32_t nextPDRRecordHandle(uint32_t nextRecordHandle);
 
     /** @brief Merge host firmware's entity association PDRs into BMC's
      *  @details A merge operation involves adding a pldm_entity under the
@@ -240,40 +308,46 @@ class HostPDRHandler
                                 [[maybe_unused]] const uint32_t& record_handle);
 
     /** @brief process the Host's PDR and add to BMC's PDR repo
-     *  @param[in] eid - MCTP id of Host
      *  @param[in] response - response from Host for GetPDR
      *  @param[in] respMsgLen - response message length
+     *  @return the next record handle to fetch, 0 when the PDR exchange is
+     *          over or failed
      */
-    void processHostPDRs(mctp_eid_t eid, const pldm_msg* response,
-                         size_t respMsgLen);
+    uint32_t processHostPDRs(const pldm_msg* response, size_t respMsgLen);
 
-    /** @brief send PDR Repo change after merging Host's PDR to BMC PDR repo
-     *  @param[in] source - sdeventplus event source
+    /** @brief add a Host's PDR to BMC's PDR repo, for a PDR received or
+     *         loaded from the PDR cache
+     *  @param[in] pdr - the PDR, its container IDs are updated
+     *  @param[in] nextRecordHandle - next record handle of the GetPDR
+     *                                response of the PDR
+     *  @return the next record handle to fetch, 0 when the PDR exchange is
+     *          over
      */
-    void _processPDRRepoChgEvent(sdeventplus::source::EventBase& source);
+    uint32_t processHostPDR(std::vector<uint8_t>& pdr,
+                            uint32_t nextRecordHandle);
 
-    /** @brief fetch the next PDR based on the record handle sent by Host
-     *  @param[in] nextRecordHandle - next record handle
+    /** @brief send PDR Repo change after merging Host's PDR to BMC PDR repo
      *  @param[in] source - sdeventplus event source
      */
-    void _processFetchPDREvent(uint32_t nextRecordHandle,
-                               sdeventplus::source::EventBase& source);
+    void _processPDRRepoChgEvent(sdeventplus::source::EventBase& source);
 
     /** @brief Get FRU record table metadata by host
      */
     void getFRURecordTableMetadataByHost();
 
-    /** @brief Set Location Code in the dbus objects
+    /** @brief Set the properties of a dbus object from a FRU record of the
+     *         host, like the Location Code
      *
-     *  @param[in] fruRecordData - the Fru Record Data
+     *  @param[in] path - object path
+     *  @param[in] entityType - entity type of the object
+     *  @param[in] record - the Fru Record
      */
-
-    void setLocationCode(
-        const std::vector<responder::pdr_utils::FruRecordDataFormat>&
-            fruRecordData);
+    void setFruRecordProperties(
+        const std::string& path, uint16_t entityType,
+        const responder::pdr_utils::FruRecordView& record);
     void setFRUDynamicAssociations();
 
-    /** @brief Get FRU record table by host
+    /** @brief Get FRU record table by host, a part at a time
      *
      *  @param[in] uint16_t    - total table records
      *
@@ -281,6 +355,24 @@ class HostPDRHandler
      */
     void getFRURecordTableByHost(uint16_t& total);
 
+    /** @brief Request a part of the FRU record table
+     *
+     *  @param[in] transferHandle - data transfer handle of the part
+     *  @param[in] transferOpFlag - PLDM_GET_FIRSTPART or PLDM_GET_NEXTPART
+     */
+    void getFRURecordTablePart(uint32_t transferHandle,
+                               uint8_t transferOpFlag);
+
+    /** @brief Update the dbus objects of a FRU record of the host, unless
+     *         the record did not change since the previous fetch
+     *
+     *  @param[in] record - the Fru Record
+     */
+    void processFruRecord(const responder::pdr_utils::FruRecordView& record);
+
+    /** @brief End the FRU record table fetch */
+    void endFRURecordTableFetch();
+
     /** @brief Create DBUS objects
      *
      * @ return
@@ -343,6 +435,33 @@ class HostPDRHandler
      */
     std::string updateLedGroupPath(const std::string& path);
 
+    /** @brief Resolve the D-Bus objects and the configured D-Bus property of
+     *         a state sensor entity
+     *
+     *  @param[in] stateSetIds - state set Ids of the sensor
+     *  @param[in] entry - state sensor entry
+     *  @param[out] route - event route to fill
+     */
+    void compileEventRoute(const std::vector<pdr::StateSetId>& stateSetIds,
+                           const pldm::responder::events::StateSensorEntry&
+                               entry,
+                           EventRoute& route);
+
+    /** @brief Run the BMC actions of an event route
+     *
+     *  @param[in] route - event route
+     *  @param[in] state - event state
+     *
+     *  @return PLDM completion code
+     */
+    int runEventRoute(const EventRoute& route, pdr::EventState state);
+
+    /** @brief Drop the compiled event routes and the entity index, they are
+     *         rebuilt on demand. Called when the host PDRs or the object
+     *         paths change.
+     */
+    void invalidateEventRoutes();
+
     /** @brief fd of MCTP communications socket */
     int mctp_fd;
     /** @brief MCTP EID of host firmware */
@@ -380,8 +499,6 @@ class HostPDRHandler
     pldm::host_associations::HostAssociationsParser* associationsParser;
 
     /** @brief sdeventplus event source */
-    std::unique_ptr<sdeventplus::source::Defer> pdrFetchEvent;
-    std::unique_ptr<sdeventplus::source::Defer> deferredFetchPDREvent;
     std::unique_ptr<sdeventplus::source::Defer> deferredPDRRepoChgEvent;
 
     /** @brief list of PDR record handles pointing to host's PDRs */
@@ -426,13 +543,44 @@ class HostPDRHandler
      */
     ObjectPathMaps objPathMap;
 
+    /** @brief compiled BMC actions of the host state sensor offsets */
+    EventRoutes eventRoutes;
+
+    /** @brief object paths of the entities in objPathMap, built on demand */
+    EntityPathIndex entityPaths;
+
+    /** @brief whether entityPaths reflects objPathMap */
+    bool entityPathsValid = false;
+
     /** @brief maps an entity name to map, maps to entity name to pldm_entity
      */
     EntityAssociations entityAssociations;
 
-    /** @brief the vector of FRU Record Data Format
+    /** @brief decoder of the FRU record table being fetched */
+    std::optional<responder::pdr_utils::FruRecordStream> fruRecordStream;
+
+    /** @brief fetch of the FRU record table, a response to a part
+     *         requested by an earlier fetch is dropped
+     */
+    uint32_t fruFetchGeneration = 0;
+
+    /** @brief total records of the FRU record table being fetched */
+    uint16_t fruTableRecords = 0;
+
+    /** @brief FRU records of the fetch that changed the dbus objects */
+    size_t changedFruRecords = 0;
+
+    /** @brief object paths and entity types by FRU record set identifier,
+     *         for the FRU record table being fetched
      */
-    std::vector<responder::pdr_utils::FruRecordDataFormat> fruRecordData;
+    std::unordered_map<uint16_t,
+                       std::vector<std::pair<std::string, uint16_t>>>
+        fruRecordPaths;
+
+    /** @brief hash of the FRU records applied to the dbus objects, by object
+     *         path and FRU record type
+     */
+    std::unordered_map<std::string, std::map<uint8_t, size_t>> fruRecordHashes;
 
     /** @OEM platform handler */
     pldm::responder::oem_platform::Handler* oemPlatformHandler;
@@ -449,6 +597,23 @@ class HostPDRHandler
 
     /** @brief variable to hold the terminus ID */
     uint16_t terminusID = 0;
+
+#ifdef HOST_PDR_CACHE
+    /** @brief PDRs of the last complete fetch, loaded instead of fetched
+     *  while the host repository is unchanged
+     */
+    HostPDRCache pdrCache{HOST_PDR_CACHE_FILE};
+
+    /** @brief The host was running when pldmd started, the first complete
+     *  fetch may load the PDRs from the cache
+     */
+    bool pdrCacheReconnect = false;
+#endif
+
+    /** @brief PDR fetch in progress, declared last so that it is cancelled
+     *  before the members it uses are destroyed
+     */
+    pldm::requester::Task pdrFetch;
 };
 
 } // namespace pldm
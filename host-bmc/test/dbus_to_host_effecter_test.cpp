@@ -90,3 +90,38 @@ TEST(HostEffecterParser, findNewStateValue)
     ASSERT_THROW(hostEffecterParser.findNewStateValue(0, 0, val2),
                  std::exception);
 }
+
+TEST(HostEffecterParser, coalesceEffecterChanges)
+{
+    MockdBusHandler dbusHandler;
+    int sockfd{};
+    MockHostEffecterParser hostEffecterParser(sockfd, nullptr, &dbusHandler,
+                                              "./host_effecter_jsons/good");
+
+    DbusChgHostEffecterProps props{
+        {"BootMode", PropertyValue{std::in_place_type<std::string>,
+                                   "xyz.openbmc_project.Control.Boot.Mode."
+                                   "Modes.Regular"}}};
+    EXPECT_CALL(hostEffecterParser, setHostStateEffecter(0, testing::_, 4))
+        .WillOnce([](size_t, std::vector<set_effecter_state_field>& stateField,
+                     uint16_t) {
+        EXPECT_EQ(stateField.size(), 1);
+        EXPECT_EQ(stateField[0].set_request, PLDM_REQUEST_SET);
+        EXPECT_EQ(stateField[0].effecter_state, 2);
+        return PLDM_SUCCESS;
+    });
+
+    // Both changes are sent in one request on the next loop iteration
+    hostEffecterParser.processHostEffecterChangeNotification(props, 0, 0, 4);
+    hostEffecterParser.processHostEffecterChangeNotification(props, 0, 0, 4);
+    EXPECT_EQ(hostEffecterParser.getChangeStats().requests, 0);
+
+    auto event = sdeventplus::Event::get_default();
+    event.run(std::chrono::microseconds(0));
+
+    const auto& stats = hostEffecterParser.getChangeStats();
+    EXPECT_EQ(stats.changes, 2);
+    EXPECT_EQ(stats.merged, 1);
+    EXPECT_EQ(stats.requests, 1);
+    EXPECT_EQ(stats.dropped, 0);
+}
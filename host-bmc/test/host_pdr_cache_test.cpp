@@ -0,0 +1,186 @@
+#include "../host_pdr_cache.hpp"
+
+#include <filesystem>
+#include <fstream>
+#include <utility>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace fs = std::filesystem;
+using namespace pldm;
+
+class TestHostPDRCache : public testing::Test
+{
+  public:
+    void SetUp() override
+    {
+        char tmppldm[] = "/tmp/pldm_host_pdr_cache.XXXXXX";
+        dir = fs::path(mkdtemp(tmppldm));
+        file = dir / "cache" / "host_pdr_cache.bin";
+    }
+
+    void TearDown() override
+    {
+        fs::remove_all(dir);
+    }
+
+    static RepositorySignature makeSignature(uint32_t recordCount)
+    {
+        RepositorySignature signature{};
+        signature.updateTime.fill(0x21);
+        signature.oemUpdateTime.fill(0x07);
+        signature.recordCount = recordCount;
+        signature.repositorySize = recordCount * 40;
+        return signature;
+    }
+
+    static std::vector<uint8_t> makePDR(size_t index)
+    {
+        std::vector<uint8_t> pdr(10 + index % 30);
+        for (size_t byte = 0; byte < pdr.size(); ++byte)
+        {
+            pdr[byte] = static_cast<uint8_t>(index + byte);
+        }
+        return pdr;
+    }
+
+    using Loaded = std::vector<std::pair<std::vector<uint8_t>, uint32_t>>;
+
+    bool load(const HostPDRCache& cache, const RepositorySignature& signature,
+              Loaded& loaded)
+    {
+        return cache.load(signature,
+                          [&loaded](std::span<const uint8_t> pdr,
+                                    uint32_t next) {
+            loaded.emplace_back(std::vector<uint8_t>(pdr.begin(), pdr.end()),
+                                next);
+        });
+    }
+
+    void record(HostPDRCache& cache, const RepositorySignature& signature,
+                size_t count)
+    {
+        cache.begin(signature);
+        for (size_t index = 0; index < count; ++index)
+        {
+            cache.add(makePDR(index), index + 1 < count ? index + 2 : 0);
+        }
+        EXPECT_TRUE(cache.commit());
+    }
+
+    fs::path dir;
+    fs::path file;
+};
+
+TEST_F(TestHostPDRCache, CommitAndLoad)
+{
+    constexpr size_t count = 200;
+    auto signature = makeSignature(count);
+    {
+        HostPDRCache cache(file);
+        record(cache, signature, count);
+        EXPECT_FALSE(cache.isRecording());
+    }
+
+    HostPDRCache cache(file);
+    Loaded loaded;
+    EXPECT_TRUE(load(cache, signature, loaded));
+    ASSERT_EQ(loaded.size(), count);
+    for (size_t index = 0; index < count; ++index)
+    {
+        EXPECT_EQ(loaded[index].first, makePDR(index));
+        EXPECT_EQ(loaded[index].second, index + 1 < count ? index + 2 : 0);
+    }
+}
+
+TEST_F(TestHostPDRCache, SignatureChanged)
+{
+    HostPDRCache cache(file);
+    record(cache, makeSignature(10), 10);
+
+    Loaded loaded;
+    EXPECT_FALSE(load(cache, makeSignature(11), loaded));
+    auto signature = makeSignature(10);
+    signature.updateTime[12] = 0x22;
+    EXPECT_FALSE(load(cache, signature, loaded));
+    EXPECT_TRUE(loaded.empty());
+    EXPECT_TRUE(load(cache, makeSignature(10), loaded));
+}
+
+TEST_F(TestHostPDRCache, Corrupted)
+{
+    HostPDRCache cache(file);
+    record(cache, makeSignature(10), 10);
+    auto size = fs::file_size(file);
+    {
+        std::fstream stream(file,
+                            std::ios::in | std::ios::out | std::ios::binary);
+        stream.seekp(size - 3);
+        stream.put(0x5a);
+    }
+
+    Loaded loaded;
+    EXPECT_FALSE(load(cache, makeSignature(10), loaded));
+    EXPECT_TRUE(loaded.empty());
+
+    fs::resize_file(file, 20);
+    EXPECT_FALSE(load(cache, makeSignature(10), loaded));
+    EXPECT_TRUE(loaded.empty());
+}
+
+TEST_F(TestHostPDRCache, AbortAndInvalidate)
+{
+    HostPDRCache cache(file);
+    Loaded loaded;
+    EXPECT_FALSE(load(cache, makeSignature(10), loaded));
+
+    // Nothing is recorded outside a fetch
+    cache.add(makePDR(0), 0);
+    EXPECT_FALSE(cache.commit());
+    EXPECT_FALSE(fs::exists(file));
+
+    record(cache, makeSignature(10), 10);
+
+    // An aborted fetch keeps the previous cache
+    cache.begin(makeSignature(12));
+    cache.add(makePDR(0), 2);
+    cache.abort();
+    EXPECT_FALSE(cache.commit());
+    EXPECT_TRUE(load(cache, makeSignature(10), loaded));
+    EXPECT_EQ(loaded.size(), 10);
+
+    cache.invalidate();
+    EXPECT_FALSE(fs::exists(file));
+    loaded.clear();
+    EXPECT_FALSE(load(cache, makeSignature(10), loaded));
+    EXPECT_TRUE(loaded.empty());
+}
+
+TEST_F(TestHostPDRCache, UnspecifiedUpdateTime)
+{
+    HostPDRCache cache(file);
+    record(cache, makeSignature(10), 10);
+
+    // A host that does not keep its update times is never served the cache
+    for (auto clear : {&RepositorySignature::updateTime,
+                       &RepositorySignature::oemUpdateTime})
+    {
+        auto signature = makeSignature(10);
+        (signature.*clear).fill(0);
+        EXPECT_FALSE(signature.isSpecified());
+
+        Loaded loaded;
+        EXPECT_FALSE(load(cache, signature, loaded));
+        EXPECT_TRUE(loaded.empty());
+
+        cache.begin(signature);
+        EXPECT_FALSE(cache.isRecording());
+        cache.add(makePDR(0), 0);
+        EXPECT_FALSE(cache.commit());
+    }
+
+    Loaded loaded;
+    EXPECT_TRUE(load(cache, makeSignature(10), loaded));
+    EXPECT_EQ(loaded.size(), 10);
+}
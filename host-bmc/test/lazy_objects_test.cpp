@@ -0,0 +1,114 @@
+#include "../dbus/custom_dbus.hpp"
+#include "../dbus/lazy_objects.hpp"
+
+#include <sdeventplus/event.hpp>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using namespace pldm::dbus;
+
+namespace
+{
+
+const std::string root = "/xyz/openbmc_project/inventory";
+const std::string corePath = root + "/system/chassis/motherboard/cpu0/core0";
+
+LazyObjects::Interfaces coreInterfaces()
+{
+    return {{"CPUCore", {}},
+            {"Enable", {{"enabled", true}}},
+            {"InventoryItem", {{"present", true}}},
+            {"LocationCode",
+             {{"locationCode", std::string("U78DA.ND0-P0-C15")}}},
+            {"OperationalStatus", {{"functional", false}}}};
+}
+
+} // namespace
+
+TEST(LazyObjects, AddAndRead)
+{
+    auto event = sdeventplus::Event::get_default();
+    LazyObjects objects(pldm::utils::DBusHandler::getBus(), event, root, 2,
+                        [](const std::string&, const LazyObjects::Interfaces&) {
+    });
+
+    EXPECT_TRUE(objects.add(corePath, coreInterfaces()));
+    for (size_t index = 0; index < 100; ++index)
+    {
+        EXPECT_TRUE(objects.add(root + "/system/dimm" + std::to_string(index),
+                                {{"Available", {{"available", true}}},
+                                 {"InventoryItem", {{"present", true}}}}));
+    }
+    EXPECT_EQ(objects.size(), 101);
+
+    // Outside the root, or with an interface whose state is not persisted
+    EXPECT_FALSE(objects.add("/xyz/openbmc_project/license/entry1",
+                             {{"Available", {{"available", true}}}}));
+    EXPECT_FALSE(objects.add(root + "/system/chassis", {{"ItemChassis", {}}}));
+    EXPECT_FALSE(objects.contains(root + "/system/chassis"));
+
+    auto locationCode = objects.getProperty(corePath, "LocationCode");
+    ASSERT_TRUE(locationCode);
+    EXPECT_EQ(std::get<std::string>(*locationCode), "U78DA.ND0-P0-C15");
+    EXPECT_FALSE(objects.getProperty(corePath, "Available"));
+    EXPECT_FALSE(objects.getProperty(root + "/unknown", "LocationCode"));
+
+    objects.erase(root + "/system/dimm0");
+    EXPECT_EQ(objects.size(), 100);
+}
+
+TEST(LazyObjects, Materialize)
+{
+    auto event = sdeventplus::Event::get_default();
+    std::vector<std::pair<std::string, LazyObjects::Interfaces>> materialized;
+    LazyObjects objects(pldm::utils::DBusHandler::getBus(), event, root, 2,
+                        [&materialized](const std::string& path,
+                                        const LazyObjects::Interfaces& intfs) {
+        materialized.emplace_back(path, intfs);
+    });
+
+    objects.add(corePath, coreInterfaces());
+    objects.materialize(corePath);
+    objects.materialize(corePath);
+
+    ASSERT_EQ(materialized.size(), 1);
+    EXPECT_EQ(materialized[0].first, corePath);
+    EXPECT_EQ(materialized[0].second, coreInterfaces());
+    EXPECT_FALSE(objects.contains(corePath));
+}
+
+TEST(LazyObjects, CustomDBus)
+{
+    auto event = sdeventplus::Event::get_default();
+    auto objects = std::make_unique<LazyObjects>(
+        pldm::utils::DBusHandler::getBus(), event, root, 2,
+        [](const std::string& path, const LazyObjects::Interfaces& intfs) {
+        const auto& status = intfs.at("OperationalStatus").at("functional");
+        CustomDBus::getCustomDBus().setOperationalStatus(
+            path, std::get<bool>(status));
+        const auto& code = intfs.at("LocationCode").at("locationCode");
+        CustomDBus::getCustomDBus().setLocationCode(
+            path, std::get<std::string>(code));
+    });
+    objects->add(corePath, coreInterfaces());
+    CustomDBus::getCustomDBus().setLazyObjects(std::move(objects));
+
+    // Read from the table
+    EXPECT_EQ(CustomDBus::getCustomDBus().getLocationCode(corePath),
+              "U78DA.ND0-P0-C15");
+    EXPECT_FALSE(CustomDBus::getCustomDBus().getOperationalStatus(corePath));
+
+    // An update creates the objects first
+    CustomDBus::getCustomDBus().setOperationalStatus(corePath, true);
+    EXPECT_TRUE(CustomDBus::getCustomDBus().getOperationalStatus(corePath));
+    EXPECT_EQ(CustomDBus::getCustomDBus().getLocationCode(corePath),
+              "U78DA.ND0-P0-C15");
+
+    CustomDBus::getCustomDBus().deleteObject(corePath);
+    EXPECT_EQ(CustomDBus::getCustomDBus().getLocationCode(corePath), "");
+    CustomDBus::getCustomDBus().setLazyObjects(nullptr);
+}
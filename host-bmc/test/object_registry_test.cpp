@@ -0,0 +1,108 @@
+#include "../dbus/object_registry.hpp"
+
+#include <memory>
+#include <string>
+
+#include <gtest/gtest.h>
+
+using namespace pldm::dbus;
+
+namespace
+{
+
+struct Location
+{
+    std::string code;
+};
+
+struct Status
+{
+    bool functional;
+};
+
+struct Destroyed
+{
+    explicit Destroyed(int& count) : count(count) {}
+    ~Destroyed()
+    {
+        ++count;
+    }
+    int& count;
+};
+
+using TestRegistry = ObjectRegistry<Location, Status, Destroyed>;
+
+const std::string core0 =
+    "/xyz/openbmc_project/inventory/system/chassis/motherboard/cpu0/core0";
+const std::string core1 =
+    "/xyz/openbmc_project/inventory/system/chassis/motherboard/cpu0/core1";
+
+} // namespace
+
+TEST(ObjectRegistry, InternAndGet)
+{
+    TestRegistry registry;
+    EXPECT_FALSE(registry.find(core0));
+    EXPECT_EQ(registry.get<Location>(core0), nullptr);
+
+    auto id = registry.intern(core0);
+    EXPECT_EQ(registry.intern(core0), id);
+    EXPECT_EQ(registry.find(core0), id);
+    EXPECT_EQ(registry.path(id), core0);
+
+    registry.emplace(id, std::make_unique<Location>(Location{"U1-P0-C15"}));
+    ASSERT_NE(registry.get<Location>(core0), nullptr);
+    EXPECT_EQ(registry.get<Location>(core0)->code, "U1-P0-C15");
+    EXPECT_EQ(registry.get<Status>(core0), nullptr);
+
+    auto other = registry.intern(core1);
+    EXPECT_NE(other, id);
+    registry.emplace(other, std::make_unique<Status>(Status{true}));
+    EXPECT_EQ(registry.get<Location>(core1), nullptr);
+    EXPECT_TRUE(registry.get<Status>(other)->functional);
+
+    EXPECT_EQ(registry.implements(core0), TestRegistry::Implemented("001"));
+    EXPECT_EQ(registry.implements(core1), TestRegistry::Implemented("010"));
+    EXPECT_TRUE(registry.implements("/unknown").none());
+}
+
+TEST(ObjectRegistry, EraseReleasesTheId)
+{
+    int destroyed = 0;
+    TestRegistry registry;
+    auto id = registry.intern(core0);
+    registry.emplace(id, std::make_unique<Destroyed>(destroyed));
+    registry.emplace(id, std::make_unique<Location>(Location{"U1"}));
+    registry.emplace(registry.intern(core1), std::make_unique<Status>());
+
+    registry.erase(core0);
+    EXPECT_EQ(destroyed, 1);
+    EXPECT_FALSE(registry.find(core0));
+    EXPECT_EQ(registry.get<Location>(core0), nullptr);
+    registry.erase(core0);
+
+    // The ID is reused, without the interfaces of the erased object
+    const std::string core2 = core0 + "2";
+    EXPECT_EQ(registry.intern(core2), id);
+    EXPECT_EQ(registry.get<Location>(core2), nullptr);
+    EXPECT_TRUE(registry.implements(core2).none());
+    EXPECT_NE(registry.get<Status>(core1), nullptr);
+}
+
+TEST(ObjectRegistry, Stats)
+{
+    TestRegistry registry;
+    for (size_t index = 0; index < 100; ++index)
+    {
+        auto id = registry.intern(core0 + std::to_string(index));
+        registry.emplace(id, std::make_unique<Location>());
+        registry.emplace(id, std::make_unique<Status>());
+    }
+    registry.erase(core0 + "0");
+
+    auto stats = registry.stats();
+    EXPECT_EQ(stats.objects, 99);
+    EXPECT_EQ(stats.interfaces, 198);
+    EXPECT_EQ(stats.pathBytes, 99 * core0.size() + 9 + 2 * 90);
+    EXPECT_GT(stats.tableBytes, 0);
+}
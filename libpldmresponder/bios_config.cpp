@@ -5,6 +5,7 @@
 #include "bios_string_attribute.hpp"
 #include "bios_table.hpp"
 #include "common/bios_utils.hpp"
+#include "common/json_cache.hpp"
 
 #include <phosphor-logging/lg2.hpp>
 #include <xyz/openbmc_project/BIOSConfig/Manager/server.hpp>
@@ -689,8 +690,15 @@ void BIOSConfig::load(const fs::path& filePath, ParseHandler handler)
     {
         try
         {
-            file.open(filePath);
-            jsonConf = Json::parse(file);
+            if (auto cached = pldm::utils::JsonCache::get().take(filePath))
+            {
+                jsonConf = std::move(*cached);
+            }
+            else
+            {
+                file.open(filePath);
+                jsonConf = Json::parse(file);
+            }
             auto entries = jsonConf.at("entries");
             for (auto& entry : entries)
             {
@@ -0,0 +1,110 @@
+#include "event_aggregator.hpp"
+
+#include <phosphor-logging/lg2.hpp>
+
+PHOSPHOR_LOG2_USING;
+
+namespace pldm::responder::events
+{
+
+StateSensorEventAggregator::StateSensorEventAggregator(
+    sdeventplus::Event& event, std::chrono::milliseconds window,
+    size_t maxPending, Callback signal, Callback action) :
+    event(event),
+    window(window), maxPending(maxPending), signal(std::move(signal)),
+    action(std::move(action)), windowTimer(event.get(), [this] { flush(); })
+{}
+
+bool StateSensorEventAggregator::add(const StateSensorEvent& sensorEvent)
+{
+    stats.received++;
+
+    if (window == std::chrono::milliseconds::zero())
+    {
+        signal(sensorEvent);
+        action(sensorEvent);
+        stats.dispatched++;
+        return true;
+    }
+
+    SensorKey key{sensorEvent.tid, sensorEvent.sensorId,
+                  sensorEvent.sensorOffset};
+    auto search = windowIndex.find(key);
+    if (search != windowIndex.end())
+    {
+        // Keep the previous state of the first transition, so the collapsed
+        // event spans the whole window
+        windowEvents[search->second].eventState = sensorEvent.eventState;
+        stats.coalesced++;
+        return true;
+    }
+
+    if (pending() >= maxPending)
+    {
+        stats.dropped++;
+        droppedInWindow++;
+        return false;
+    }
+
+    windowIndex.emplace(key, windowEvents.size());
+    windowEvents.push_back(sensorEvent);
+    if (windowEvents.size() == 1)
+    {
+        windowTimer.start(
+            std::chrono::duration_cast<std::chrono::microseconds>(window));
+    }
+    return true;
+}
+
+void StateSensorEventAggregator::flush()
+{
+    windowTimer.stop();
+    if (droppedInWindow)
+    {
+        error(
+            "Dropped {DROPPED} state sensor events, {PENDING} events are pending",
+            "DROPPED", droppedInWindow, "PENDING", pending());
+        droppedInWindow = 0;
+    }
+    if (windowEvents.empty())
+    {
+        return;
+    }
+
+    for (const auto& sensorEvent : windowEvents)
+    {
+        signal(sensorEvent);
+        actions.push_back(sensorEvent);
+    }
+    windowEvents.clear();
+    windowIndex.clear();
+
+    if (!actionEvent)
+    {
+        actionEvent = std::make_unique<sdeventplus::source::Defer>(
+            event, std::bind_front(
+                       std::mem_fn(&StateSensorEventAggregator::runActions),
+                       this));
+    }
+}
+
+void StateSensorEventAggregator::runActions(
+    sdeventplus::source::EventBase& /*source*/)
+{
+    for (size_t count = 0; count < actionsPerIteration && !actions.empty();
+         ++count)
+    {
+        // The action may add events, take it off the queue first
+        auto sensorEvent = actions.front();
+        actions.pop_front();
+        action(sensorEvent);
+        stats.dispatched++;
+    }
+
+    if (actions.empty())
+    {
+        actionEvent.reset();
+    }
+}
+
+} // namespace pldm::responder::events
@@ -0,0 +1,150 @@
+#pragma once
+
+#include "common/types.hpp"
+
+#include <sdbusplus/timer.hpp>
+#include <sdeventplus/event.hpp>
+#include <sdeventplus/source/event.hpp>
+
+#include <chrono>
+#include <deque>
+#include <functional>
+#include <map>
+#include <memory>
+#include <tuple>
+
+namespace pldm::responder::events
+{
+
+/** @struct StateSensorEvent
+ *
+ *  A state sensor event of the PlatformEventMessage command
+ */
+struct StateSensorEvent
+{
+    pdr::TerminusID tid;
+    pdr::SensorID sensorId;
+    pdr::SensorOffset sensorOffset;
+    pdr::EventState eventState;
+    pdr::EventState previousEventState;
+
+    bool operator==(const StateSensorEvent&) const = default;
+};
+
+/** @class StateSensorEventAggregator
+ *
+ *  @brief Sits between the decode of the state sensor events and their
+ *         actions. The transitions of a sensor offset received within the
+ *         coalescing window are collapsed to the last event state, the
+ *         previous event state of the first transition is kept. At the end of
+ *         the window the signals of all the collapsed events are emitted
+ *         together, and the actions are run from the event loop, a bounded
+ *         number per iteration so that the PLDM requests in between are not
+ *         delayed by a burst of events.
+ */
+class StateSensorEventAggregator
+{
+  public:
+    using Callback = std::function<void(const StateSensorEvent&)>;
+
+    /** @struct Stats
+     *
+     *  Counters of the state sensor events
+     */
+    struct Stats
+    {
+        uint64_t received = 0;   //!< events added
+        uint64_t coalesced = 0;  //!< events collapsed into a pending event
+        uint64_t dropped = 0;    //!< events dropped, too many pending events
+        uint64_t dispatched = 0; //!< events whose action was run
+    };
+
+    /** @brief Maximum number of actions run per event loop iteration */
+    static constexpr size_t actionsPerIteration = 16;
+
+    StateSensorEventAggregator() = delete;
+    StateSensorEventAggregator(const StateSensorEventAggregator&) = delete;
+    StateSensorEventAggregator(StateSensorEventAggregator&&) = delete;
+    StateSensorEventAggregator&
+        operator=(const StateSensorEventAggregator&) = delete;
+    StateSensorEventAggregator&
+        operator=(StateSensorEventAggregator&&) = delete;
+    ~StateSensorEventAggregator() = default;
+
+    /** @brief Constructor
+     *
+     *  @param[in] event - reference of main event loop of pldmd
+     *  @param[in] window - coalescing window, 0 runs every event right away
+     *  @param[in] maxPending - maximum number of events waiting for their
+     *                          action, further events are dropped
+     *  @param[in] signal - emits the D-Bus signal of an event
+     *  @param[in] action - runs the BMC action of an event
+     */
+    explicit StateSensorEventAggregator(sdeventplus::Event& event,
+                                        std::chrono::milliseconds window,
+                                        size_t maxPending, Callback signal,
+                                        Callback action);
+
+    /** @brief Add a state sensor event
+     *
+     *  @param[in] sensorEvent - state sensor event
+     *
+     *  @return false if the event was dropped
+     */
+    bool add(const StateSensorEvent& sensorEvent);
+
+    /** @brief Close the coalescing window, emit the signals of the pending
+     *         events and queue their actions
+     */
+    void flush();
+
+    /** @brief Number of events waiting for the signal or the action */
+    size_t pending() const
+    {
+        return windowEvents.size() + actions.size();
+    }
+
+    /** @brief Counters of the state sensor events */
+    const Stats& getStats() const
+    {
+        return stats;
+    }
+
+  private:
+    using SensorKey =
+        std::tuple<pdr::TerminusID, pdr::SensorID, pdr::SensorOffset>;
+
+    /** @brief Run the queued actions, at most actionsPerIteration of them
+     *
+     *  @param[in] source - sdeventplus event source
+     */
+    void runActions(sdeventplus::source::EventBase& source);
+
+    sdeventplus::Event& event;
+    std::chrono::milliseconds window;
+    size_t maxPending;
+    Callback signal;
+    Callback action;
+
+    /** @brief events of the current window in arrival order */
+    std::deque<StateSensorEvent> windowEvents;
+
+    /** @brief index of the sensor offsets in windowEvents */
+    std::map<SensorKey, size_t> windowIndex;
+
+    /** @brief events whose signal was emitted, waiting for the action */
+    std::deque<StateSensorEvent> actions;
+
+    /** @brief closes the coalescing window */
+    phosphor::Timer windowTimer;
+
+    /** @brief runs the queued actions from the event loop */
+    std::unique_ptr<sdeventplus::source::Defer> actionEvent;
+
+    /** @brief events dropped since the last flush */
+    uint64_t droppedInWindow = 0;
+
+    Stats stats;
+};
+
+} // namespace pldm::responder::events
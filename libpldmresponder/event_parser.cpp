@@ -1,5 +1,7 @@
 #include "event_parser.hpp"
 
+#include "common/json_cache.hpp"
+
 #include <phosphor-logging/lg2.hpp>
 #include <xyz/openbmc_project/Common/error.hpp>
 
@@ -36,9 +38,7 @@ StateSensorHandler::StateSensorHandler(const std::string& dirPath)
 
     for (auto& file : fs::directory_iterator(dirPath))
     {
-        std::ifstream jsonFile(file.path());
-
-        auto data = Json::parse(jsonFile, nullptr, false);
+        auto data = pldm::utils::JsonCache::get().parse(file.path());
         if (data.is_discarded())
         {
             error("Parsing Event state sensor JSON file failed, FILE={FILE}",
@@ -99,7 +99,10 @@ StateSensorHandler::StateSensorHandler(const std::string& dirPath)
 
             auto eventStateMap = mapStateToDBusVal(eventStates, propertyValues,
                                                    dbusInfo.propertyType);
-            eventMap.emplace(
+            auto& entryMap = stateSensorEntry.skipContainerCheck
+                                 ? anyContainerEventMap
+                                 : eventMap;
+            entryMap.emplace(
                 stateSensorEntry,
                 std::make_tuple(std::move(dbusInfo), std::move(eventStateMap)));
         }
@@ -122,56 +125,66 @@ StateToDBusValue StateSensorHandler::mapStateToDBusVal(
     return eventStateMap;
 }
 
-int StateSensorHandler::eventAction(StateSensorEntry entry,
+const EventDBusInfo*
+    StateSensorHandler::findEventInfo(const StateSensorEntry& entry) const
+{
+    // An entry without a container id takes precedence over the exact match
+    auto anyContainerEntry = entry;
+    anyContainerEntry.skipContainerCheck = true;
+    auto search = anyContainerEventMap.find(anyContainerEntry);
+    if (search != anyContainerEventMap.end())
+    {
+        return &search->second;
+    }
+
+    auto exactEntry = entry;
+    exactEntry.skipContainerCheck = false;
+    search = eventMap.find(exactEntry);
+    if (search != eventMap.end())
+    {
+        return &search->second;
+    }
+
+    return nullptr;
+}
+
+int StateSensorHandler::eventAction(const StateSensorEntry& entry,
                                     pdr::EventState state)
 {
-    for (const auto& kv : eventMap)
+    auto eventInfo = findEventInfo(entry);
+    if (!eventInfo)
     {
-        if (kv.first.skipContainerCheck &&
-            kv.first.entityType == entry.entityType &&
-            kv.first.entityInstance == entry.entityInstance &&
-            kv.first.stateSetid == entry.stateSetid &&
-            kv.first.sensorOffset == entry.sensorOffset)
-        {
-            entry.skipContainerCheck = true;
-            break;
-        }
+        // There is no BMC action for this PLDM event
+        return PLDM_SUCCESS;
     }
-    try
+    return eventAction(*eventInfo, state);
+}
+
+int StateSensorHandler::eventAction(const EventDBusInfo& eventInfo,
+                                    pdr::EventState state)
+{
+    const auto& [dbusMapping, eventStateMap] = eventInfo;
+    auto propValue = eventStateMap.find(state);
+    if (propValue == eventStateMap.end())
     {
-        const auto& [dbusMapping, eventStateMap] = eventMap.at(entry);
-        utils::PropertyValue propValue{};
-        try
-        {
-            propValue = eventStateMap.at(state);
-        }
-        catch (const std::out_of_range& e)
-        {
-            error("Invalid event state {EVENT_STATE}  ERROR={ERR_EXCEP}",
-                  "EVENT_STATE", static_cast<unsigned>(state), "ERR_EXCEP",
-                  e.what());
-            return PLDM_ERROR_INVALID_DATA;
-        }
+        error("Invalid event state {EVENT_STATE}", "EVENT_STATE",
+              static_cast<unsigned>(state));
+        return PLDM_ERROR_INVALID_DATA;
+    }
 
-        try
-        {
-            pldm::utils::DBusHandler().setDbusProperty(dbusMapping, propValue);
-        }
-        catch (const std::exception& e)
+    // The event is acknowledged once the property write is queued, a slow
+    // D-Bus service does not hold the event loop up
+    pldm::utils::DBusHandler().setDbusPropertyAsync(
+        dbusMapping, propValue->second, [dbusMapping](bool success) {
+        if (!success)
         {
             error(
-                "Error setting property, ERROR={ERR_EXCEP} PROPERTY={DBUS_PROP} INTERFACE={INTF} PATH = {OBJ_PATH}",
-                "ERR_EXCEP", e.what(), "DBUS_PROP", dbusMapping.propertyName,
-                "INTF", dbusMapping.interface, "OBJ_PATH",
+                "Error setting property, PROPERTY={DBUS_PROP} INTERFACE={INTF} PATH = {OBJ_PATH}",
+                "DBUS_PROP", dbusMapping.propertyName, "INTF",
+                dbusMapping.interface, "OBJ_PATH",
                 dbusMapping.objectPath.c_str());
-            return PLDM_ERROR;
         }
-    }
-    catch (const std::out_of_range&)
-    {
-        // There is no BMC action for this PLDM event
-        return PLDM_SUCCESS;
-    }
+    });
     return PLDM_SUCCESS;
 }
 
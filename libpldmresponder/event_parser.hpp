@@ -7,6 +7,7 @@
 
 #include <filesystem>
 #include <map>
+#include <stdexcept>
 #include <string>
 #include <tuple>
 #include <vector>
@@ -106,21 +107,59 @@ class StateSensorHandler
      *
      *  @return PLDM completion code
      */
-    int eventAction(StateSensorEntry entry, pdr::EventState state);
+    int eventAction(const StateSensorEntry& entry, pdr::EventState state);
+
+    /** @brief Set the D-Bus property of an event based on the EventState,
+     *         the property is set asynchronously and a failure to set it is
+     *         logged
+     *
+     *  @param[in] eventInfo - D-Bus information of the state sensor entry
+     *  @param[in] state - event state
+     *
+     *  @return PLDM completion code
+     */
+    static int eventAction(const EventDBusInfo& eventInfo,
+                           pdr::EventState state);
+
+    /** @brief Lookup the D-Bus information for a StateSensorEntry, an entry
+     *         configured without a container id matches any container id
+     *
+     *  @param[in] entry - state sensor entry
+     *
+     *  @return D-Bus information corresponding to the SensorEntry, nullptr
+     *          if there is no BMC action for the entry
+     */
+    const EventDBusInfo* findEventInfo(const StateSensorEntry& entry) const;
 
     /** @brief Helper API to get D-Bus information for a StateSensorEntry
      *
      *  @param[in] entry - state sensor entry
      *
      *  @return D-Bus information corresponding to the SensorEntry
+     *          throw std::out_of_range exception if not found
      */
     const EventDBusInfo& getEventInfo(const StateSensorEntry& entry) const
     {
-        return eventMap.at(entry);
+        auto eventInfo = findEventInfo(entry);
+        if (!eventInfo)
+        {
+            throw std::out_of_range("No D-Bus action for the state sensor");
+        }
+        return *eventInfo;
     }
 
   private:
-    EventMap eventMap; //!< a map of StateSensorEntry to D-Bus information
+    /** @brief a map of StateSensorEntry to D-Bus information, for the entries
+     *         with a container id
+     */
+    EventMap eventMap;
+
+    /** @brief a map of StateSensorEntry to D-Bus information, for the entries
+     *         without a container id. The keys skip the container check, so
+     *         they are kept apart from eventMap to keep both orderings
+     *         consistent.
+     */
+    EventMap anyContainerEventMap;
 
     /** @brief Create a map of EventState to D-Bus property values from
      *         the information provided in the event state configuration
@@ -231,6 +231,7 @@ void FruImpl::buildFRUTable()
               "LIBPLDM_ERROR", rc);
         throw std::runtime_error("Failed to add PLDM entity association PDR");
     }
+    pldm::utils::pdrRepoChanged(pldm::utils::PdrRepoChange::added);
 
     // save a copy of bmc's entity association tree
     pldm_entity_association_tree_copy_root(entityTree, bmcEntityTree);
@@ -358,6 +359,8 @@ uint32_t FruImpl::populateRecords(
                     throw std::runtime_error(
                         "Failed to add PDR FRU record set");
                 }
+                pldm::utils::pdrRepoChanged(
+                    pldm::utils::PdrRepoChange::added);
                 newRcord = bmc_record_handle;
                 objectPathToRSIMap[objectPath] = recordSetIdentifier;
             }
@@ -466,6 +469,7 @@ void FruImpl::removeIndividualFRU(const std::string& fruObjPath)
             handlesTobeDeleted.push_back(delSensorHdl);
         }
     }
+    pldm::utils::pdrRepoChanged();
 
     // need to
     // send both remote and local records. Phyp keeps track of bmc only records
@@ -653,6 +657,7 @@ void FruImpl::buildIndividualFRU(const std::string& fruInterface,
         pldm_entity_association_pdr_add_contained_entity(
             pdrRepo, entity, parentEntity, &hostEventDataOps, true,
             last_bmc_record_handle);
+    pldm::utils::pdrRepoChanged();
 
     // create the relevant state effecter and sensor PDRs for the new fru record
     std::vector<uint32_t> recordHdlList;
@@ -1457,9 +1462,12 @@ uint32_t
     lastHandle = lastLocalRecord->record_handle;
 #endif
     pdrEntry.handle.recordHandle = lastHandle + 1;
-    return pldm_pdr_add_hotplug_record(pdrRepo, pdrEntry.data, pdrEntry.size,
-                                       pdrEntry.handle.recordHandle, false,
-                                       lastHandle, TERMINUS_HANDLE);
+    auto handle = pldm_pdr_add_hotplug_record(
+        pdrRepo, pdrEntry.data, pdrEntry.size, pdrEntry.handle.recordHandle,
+        false, lastHandle, TERMINUS_HANDLE);
+    // The record is inserted after the last BMC record
+    pldm::utils::pdrRepoChanged();
+    return handle;
 }
 
 namespace fru
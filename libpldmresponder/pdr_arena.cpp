@@ -0,0 +1,166 @@
+#include "pdr_arena.hpp"
+
+#include "common/utils.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+namespace pldm
+{
+namespace responder
+{
+namespace pdr_utils
+{
+
+PdrArena::PdrArena() :
+    watch([this](pldm::utils::PdrRepoChange change) {
+    // Appended records keep the arena as a prefix of the repository
+    if (change == pldm::utils::PdrRepoChange::added &&
+        state == SyncState::current)
+    {
+        state = SyncState::appended;
+    }
+    else if (change == pldm::utils::PdrRepoChange::modified)
+    {
+        state = SyncState::stale;
+    }
+})
+{}
+
+void PdrArena::reserve(size_t count, size_t bytes)
+{
+    // Small appends keep the geometric growth of the tables
+    auto total = records.size() + count;
+    if (total > records.capacity())
+    {
+        total = std::max(total, 2 * records.capacity());
+        records.reserve(total);
+        index.reserve(total);
+    }
+    if (!chunks.empty() && chunks.back().size - chunks.back().used >= bytes)
+    {
+        return;
+    }
+    if (bytes)
+    {
+        auto size = std::max(bytes, chunkSize);
+        chunks.push_back(Chunk{std::make_unique<uint8_t[]>(size), size, 0});
+    }
+}
+
+void PdrArena::add(RecordHandle handle, const uint8_t* data, uint32_t size)
+{
+    if (chunks.empty() || chunks.back().size - chunks.back().used < size)
+    {
+        auto chunk = std::max<size_t>(size, chunkSize);
+        chunks.push_back(Chunk{std::make_unique<uint8_t[]>(chunk), chunk, 0});
+    }
+    auto& chunk = chunks.back();
+    auto copy = chunk.data.get() + chunk.used;
+    std::memcpy(copy, data, size);
+    chunk.used += size;
+    used += size;
+
+    if (!records.empty())
+    {
+        records.back().nextHandle = handle;
+    }
+    records.push_back(Record{handle, 0, copy, size});
+    // libpldm finds the first of records sharing a handle
+    index.try_emplace(handle, records.size() - 1);
+}
+
+const PdrArena::Record* PdrArena::find(RecordHandle handle) const
+{
+    if (!handle)
+    {
+        return first();
+    }
+    auto search = index.find(handle);
+    return search == index.end() ? nullptr : &records[search->second];
+}
+
+void PdrArena::clear()
+{
+    chunks.clear();
+    records.clear();
+    index.clear();
+    used = 0;
+    state = SyncState::stale;
+}
+
+bool PdrArena::sync(const pldm_pdr* repo)
+{
+    switch (state)
+    {
+        case SyncState::current:
+            return false;
+        case SyncState::appended:
+            if (!records.empty() && append(repo))
+            {
+                return false;
+            }
+            break;
+        case SyncState::stale:
+            break;
+    }
+
+    rebuild(repo);
+    return true;
+}
+
+bool PdrArena::append(const pldm_pdr* repo)
+{
+    uint8_t* data = nullptr;
+    uint32_t size{};
+    uint32_t nextHandle{};
+    auto record = pldm_pdr_find_record(repo, records.back().handle, &data,
+                                       &size, &nextHandle);
+    if (!record || size != records.back().size)
+    {
+        return false;
+    }
+
+    auto recordCount = pldm_pdr_get_record_count(repo);
+    auto repoSize = pldm_pdr_get_repo_size(repo);
+    if (recordCount < records.size() || repoSize < used)
+    {
+        return false;
+    }
+
+    reserve(recordCount - records.size(), repoSize - used);
+    while ((record = pldm_pdr_get_next_record(repo, record, &data, &size,
+                                              &nextHandle)))
+    {
+        add(pldm_pdr_get_record_handle(repo, record), data, size);
+    }
+    if (records.size() != recordCount || used != repoSize)
+    {
+        return false;
+    }
+
+    state = SyncState::current;
+    return true;
+}
+
+void PdrArena::rebuild(const pldm_pdr* repo)
+{
+    clear();
+    reserve(pldm_pdr_get_record_count(repo), pldm_pdr_get_repo_size(repo));
+
+    uint8_t* data = nullptr;
+    uint32_t size{};
+    uint32_t nextHandle{};
+    auto record = pldm_pdr_find_record(repo, 0, &data, &size, &nextHandle);
+    while (record)
+    {
+        add(pldm_pdr_get_record_handle(repo, record), data, size);
+        record = pldm_pdr_get_next_record(repo, record, &data, &size,
+                                          &nextHandle);
+    }
+    state = SyncState::current;
+}
+
+} // namespace pdr_utils
+} // namespace responder
+} // namespace pldm
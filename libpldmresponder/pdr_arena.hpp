@@ -0,0 +1,175 @@
+#pragma once
+
+#include "libpldm/pdr.h"
+
+#include "common/utils.hpp"
+#include "pdr_utils.hpp"
+
+#include <stdint.h>
+
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+namespace pldm
+{
+namespace responder
+{
+namespace pdr_utils
+{
+
+/** @class PdrArena
+ *
+ *  @brief Contiguous copy of the records of a PDR repository. libpldm keeps
+ *         every record in its own allocation, in a linked list, so that
+ *         finding a record by handle walks the list. The arena stores the
+ *         records back to back in large chunks, in the order of the
+ *         repository, with a table from record handle to record.
+ *
+ *         The pldm_pdr repository stays the reference and its C API is used
+ *         as before to add, update and remove records. The arena follows the
+ *         changes recorded by pldm::utils::pdrRepoChanged() and sync() brings
+ *         it up to date: the records appended to the repository are copied at
+ *         the end of the arena, any other change rebuilds the arena in one
+ *         chunk, which drops the space of the removed records.
+ */
+class PdrArena
+{
+  public:
+    /** @brief Minimum size of a chunk of the arena */
+    static constexpr size_t chunkSize = 64 * 1024;
+
+    /** @struct Record
+     *
+     *  Record of the arena, the data stays valid until the arena is rebuilt
+     *  or cleared
+     */
+    struct Record
+    {
+        RecordHandle handle;
+        RecordHandle nextHandle; //!< 0 for the last record
+        const uint8_t* data;
+        uint32_t size;
+    };
+
+    PdrArena();
+    PdrArena(const PdrArena&) = delete;
+    PdrArena(PdrArena&&) = delete;
+    PdrArena& operator=(const PdrArena&) = delete;
+    PdrArena& operator=(PdrArena&&) = delete;
+    ~PdrArena() = default;
+
+    /** @brief Reserve room for records added next, so that they are stored
+     *         in one chunk
+     *
+     *  @param[in] count - number of records
+     *  @param[in] bytes - total size of the records
+     */
+    void reserve(size_t count, size_t bytes);
+
+    /** @brief Append a copy of a record
+     *
+     *  @param[in] handle - record handle
+     *  @param[in] data - PDR record, header included
+     *  @param[in] size - size of the record
+     */
+    void add(RecordHandle handle, const uint8_t* data, uint32_t size);
+
+    /** @brief Find a record by handle
+     *
+     *  @param[in] handle - record handle, 0 for the first record
+     *
+     *  @return the record, nullptr if it is not found
+     */
+    const Record* find(RecordHandle handle) const;
+
+    /** @brief First record, nullptr if the arena is empty */
+    const Record* first() const
+    {
+        return records.empty() ? nullptr : records.data();
+    }
+
+    /** @brief Record following a record, nullptr after the last one */
+    const Record* next(const Record& record) const
+    {
+        auto next = &record + 1;
+        return next == records.data() + records.size() ? nullptr : next;
+    }
+
+    /** @brief Number of records */
+    size_t size() const
+    {
+        return records.size();
+    }
+
+    /** @brief Size of the records */
+    size_t bytes() const
+    {
+        return used;
+    }
+
+    /** @brief Number of chunks allocated */
+    size_t chunkCount() const
+    {
+        return chunks.size();
+    }
+
+    /** @brief Remove all the records and release the chunks */
+    void clear();
+
+    /** @brief Bring the arena up to date with a PDR repository
+     *
+     *  @param[in] repo - PDR repository
+     *
+     *  @return true if the arena was rebuilt
+     */
+    bool sync(const pldm_pdr* repo);
+
+  private:
+    /** @struct Chunk
+     *
+     *  Block of memory holding records back to back
+     */
+    struct Chunk
+    {
+        std::unique_ptr<uint8_t[]> data;
+        size_t size;
+        size_t used;
+    };
+
+    /** @brief State of the arena against the repository */
+    enum class SyncState
+    {
+        stale,    //!< the arena must be rebuilt
+        appended, //!< records were appended to the repository
+        current,  //!< the arena holds the records of the repository
+    };
+
+    /** @brief Copy the records appended to the repository since the last
+     *         sync
+     *
+     *  @return false if the records of the arena are not a prefix of the
+     *          repository, the arena must be rebuilt
+     */
+    bool append(const pldm_pdr* repo);
+
+    /** @brief Copy all the records of the repository into a fresh arena */
+    void rebuild(const pldm_pdr* repo);
+
+    std::vector<Chunk> chunks;
+    std::vector<Record> records;
+
+    /** @brief position of the records in records, by record handle */
+    std::unordered_map<RecordHandle, size_t> index;
+
+    /** @brief size of the records */
+    size_t used = 0;
+
+    SyncState state = SyncState::stale;
+
+    pldm::utils::PdrRepoWatch watch;
+};
+
+} // namespace pdr_utils
+} // namespace responder
+} // namespace pldm
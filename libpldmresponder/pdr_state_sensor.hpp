@@ -146,6 +146,7 @@ void generateStateSensorPDR(const DBusInterface& dBusIntf, const Json& json,
                     pldm_entity_association_pdr_add_contained_entity(
                         repo.getPdr(), child_entity, parent_entity,
                         &bmcEventDataOps, false, bmc_record_handle);
+                    pldm::utils::pdrRepoChanged();
                 }
             }
         }
@@ -7,6 +7,7 @@
 
 #include <phosphor-logging/lg2.hpp>
 
+#include <algorithm>
 #include <bitset>
 #include <climits>
 
@@ -25,7 +26,9 @@ pldm_pdr* Repo::getPdr() const
     return repo;
 }
 
-RecordHandle Repo::addRecord(const PdrEntry& pdrEntry)
+namespace
+{
+RecordHandle add(pldm_pdr* repo, const PdrEntry& pdrEntry)
 {
     uint32_t handle = pdrEntry.handle.recordHandle;
     int rc = pldm_pdr_add_check(repo, pdrEntry.data, pdrEntry.size, false,
@@ -37,6 +40,48 @@ RecordHandle Repo::addRecord(const PdrEntry& pdrEntry)
     }
     return handle;
 }
+} // namespace
+
+RecordHandle Repo::addRecord(const PdrEntry& pdrEntry)
+{
+    auto handle = add(repo, pdrEntry);
+    pldm::utils::pdrRepoChanged(pldm::utils::PdrRepoChange::added);
+    return handle;
+}
+
+RecordHandle Repo::addRecords(const std::vector<PdrEntry>& pdrEntries)
+{
+    RecordHandle handle = 0;
+    for (const auto& pdrEntry : pdrEntries)
+    {
+        handle = add(repo, pdrEntry);
+    }
+    if (!pdrEntries.empty())
+    {
+        pldm::utils::pdrRepoChanged(pldm::utils::PdrRepoChange::added);
+    }
+    return handle;
+}
+
+void PdrBatch::add(const uint8_t* data, size_t size)
+{
+    entries.emplace_back(arena.size(), size);
+    arena.insert(arena.end(), data, data + size);
+}
+
+RecordHandle PdrBatch::commit(RepoInterface& repo)
+{
+    std::vector<PdrEntry> pdrEntries(entries.size());
+    for (size_t pos = 0; pos < entries.size(); ++pos)
+    {
+        pdrEntries[pos].data = arena.data() + entries[pos].first;
+        pdrEntries[pos].size = entries[pos].second;
+    }
+    auto handle = repo.addRecords(pdrEntries);
+    entries.clear();
+    arena.clear();
+    return handle;
+}
 
 const pldm_pdr_record* Repo::getFirstRecord(PdrEntry& pdrEntry)
 {
@@ -254,6 +299,79 @@ std::vector<FruRecordDataFormat> parseFruRecordTable(const uint8_t* fruData,
 
     return frus;
 }
+namespace
+{
+
+/** @brief Length of the record at the start of data, as far as it is known
+ *         from data. The record is complete if it is not over data.size().
+ */
+size_t fruRecordLength(std::span<const uint8_t> data)
+{
+    // uint16_t(FRU Record Set Identifier), uint8_t(FRU Record Type),
+    // uint8_t(Number of FRU fields), uint8_t(Encoding Type for FRU fields)
+    size_t length = 5;
+    if (data.size() < length)
+    {
+        return length;
+    }
+
+    for (uint8_t field = 0; field < data[3]; ++field)
+    {
+        // uint8_t(FRU Field Type), uint8_t(FRU Field Length)
+        if (data.size() < length + 2)
+        {
+            return length + 2;
+        }
+        length += 2 + data[length + 1];
+    }
+    return length;
+}
+
+} // namespace
+
+void FruRecordStream::feed(std::span<const uint8_t> part)
+{
+    if (!partial.empty())
+    {
+        // Complete the cut record with the start of this part, a field
+        // header at a time until its length is known
+        size_t length = 0;
+        while ((length = fruRecordLength(partial)) > partial.size() &&
+               !part.empty())
+        {
+            auto used = std::min(length - partial.size(), part.size());
+            partial.insert(partial.end(), part.begin(), part.begin() + used);
+            part = part.subspan(used);
+        }
+        if (length > partial.size())
+        {
+            return;
+        }
+        decode(partial);
+        partial.clear();
+    }
+
+    auto decoded = decode(part);
+    partial.assign(part.begin() + decoded, part.end());
+}
+
+size_t FruRecordStream::decode(std::span<const uint8_t> data)
+{
+    size_t offset = 0;
+    size_t length = 0;
+    while ((length = fruRecordLength(data.subspan(offset))) <=
+           data.size() - offset)
+    {
+        auto record = data.subspan(offset, length);
+        callback(FruRecordView{
+            static_cast<uint16_t>(record[0] | (record[1] << 8)), record[2],
+            record[4], record[3], record});
+        ++count;
+        offset += length;
+    }
+    return offset;
+}
+
 std::vector<uint8_t> fetchBitMap(const std::vector<std::vector<uint8_t>>& pdrs)
 {
     std::vector<uint8_t> bitMap;
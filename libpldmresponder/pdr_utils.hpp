@@ -2,8 +2,10 @@
 
 #include "libpldm/pdr.h"
 
+#include "common/json_cache.hpp"
 #include "common/types.hpp"
 #include "common/utils.hpp"
+#include "state_value_table.hpp"
 
 #include <stdint.h>
 
@@ -15,7 +17,9 @@
 #include <fstream>
 #include <functional>
 #include <iostream>
+#include <span>
 #include <string>
+#include <string_view>
 
 PHOSPHOR_LOG2_USING;
 
@@ -80,7 +84,10 @@ using PossibleValues = std::vector<uint8_t>;
 using EffecterId = uint16_t;
 using StatestoDbusVal = std::map<State, pldm::utils::PropertyValue>;
 using DbusMappings = std::vector<pldm::utils::DBusMapping>;
-using DbusValMaps = std::vector<StatestoDbusVal>;
+/** @brief Translation tables of the D-Bus properties, built from their
+ *         StatestoDbusVal
+ */
+using DbusValMaps = std::vector<StateValueTable>;
 using DbusObjMaps = std::map<EffecterId, std::tuple<DbusMappings, DbusValMaps>>;
 using EventStates = std::array<uint8_t, 8>;
 
@@ -98,6 +105,11 @@ inline Json readJson(const std::string& path)
         throw InternalFailure();
     }
 
+    if (auto cached = pldm::utils::JsonCache::get().take(path))
+    {
+        return std::move(*cached);
+    }
+
     std::ifstream jsonFile(path);
     if (!jsonFile.is_open())
     {
@@ -147,6 +159,16 @@ class RepoInterface
      */
     virtual RecordHandle addRecord(const PdrEntry& pdrEntry) = 0;
 
+    /** @brief Add PDR records to a PDR repository, in order
+     *
+     *  @param[in] pdrEntries - PDR records entries(data, size, recordHandle)
+     *
+     *  @return uint32_t - record handle assigned to the last PDR record, 0 if
+     *                     there are no records
+     */
+    virtual RecordHandle
+        addRecords(const std::vector<PdrEntry>& pdrEntries) = 0;
+
     /** @brief Get the first PDR record from a PDR repository
      *
      *  @param[in] pdrEntry - PDR records entry(data, size, nextRecordHandle)
@@ -209,6 +231,8 @@ class Repo : public RepoInterface
 
     RecordHandle addRecord(const PdrEntry& pdrEntry) override;
 
+    RecordHandle addRecords(const std::vector<PdrEntry>& pdrEntries) override;
+
     const pldm_pdr_record* getFirstRecord(PdrEntry& pdrEntry) override;
 
     const pldm_pdr_record* getNextRecord(const pldm_pdr_record* currRecord,
@@ -221,6 +245,56 @@ class Repo : public RepoInterface
     bool empty() override;
 };
 
+/**
+ *  @class PdrBatch
+ *
+ *  PDR records generated together and added to a repository in one go. The
+ *  records are stored back to back in one arena, sized once when the number
+ *  of records is known up front, instead of one allocation per record.
+ */
+class PdrBatch
+{
+  public:
+    /** @brief Reserve the storage of the batch
+     *
+     *  @param[in] records - expected number of records
+     *  @param[in] bytes - expected total size of the records
+     */
+    void reserve(size_t records, size_t bytes)
+    {
+        entries.reserve(records);
+        arena.reserve(bytes);
+    }
+
+    /** @brief Append a copy of a record
+     *
+     *  @param[in] data - PDR record, header included
+     *  @param[in] size - size of the record
+     */
+    void add(const uint8_t* data, size_t size);
+
+    /** @brief Number of records in the batch */
+    size_t size() const
+    {
+        return entries.size();
+    }
+
+    /** @brief Add the records to a repository, in the order they were
+     *         appended, and empty the batch
+     *
+     *  @param[in] repo - PDR repository
+     *
+     *  @return handle of the last record added, 0 if the batch was empty
+     */
+    RecordHandle commit(RepoInterface& repo);
+
+  private:
+    std::vector<uint8_t> arena;
+
+    /** @brief offset and size of the records in the arena */
+    std::vector<std::pair<size_t, size_t>> entries;
+};
+
 /** @brief Parse the State Sensor PDR and return the parsed sensor info which
  *         will be used to lookup the sensor info in the PlatformEventMessage
  *         command of sensorEvent type.
@@ -245,6 +319,115 @@ std::tuple<pldm::pdr::TerminusHandle, pldm::pdr::SensorID,
 std::vector<FruRecordDataFormat> parseFruRecordTable(const uint8_t* fruData,
                                                      size_t fruLen);
 
+/** @struct FruFieldView
+ *
+ *  FRU field of a record, pointing into the record table data
+ */
+struct FruFieldView
+{
+    uint8_t type;
+    std::span<const uint8_t> value;
+
+    /** @brief The value as a string */
+    std::string_view str() const
+    {
+        return {reinterpret_cast<const char*>(value.data()), value.size()};
+    }
+};
+
+/** @struct FruRecordView
+ *
+ *  FRU record of a record table, pointing into the record table data. It is
+ *  valid during the callback of FruRecordStream only.
+ */
+struct FruRecordView
+{
+    uint16_t rsi;
+    uint8_t type;
+    uint8_t encoding;
+    uint8_t numFields;
+    std::span<const uint8_t> data; //!< whole record, header included
+
+    /** @brief Call a function for each field of the record
+     *
+     *  @param[in] function - called with each FruFieldView
+     */
+    template <typename Function>
+    void forEachField(Function function) const
+    {
+        size_t offset = 5;
+        for (uint8_t field = 0; field < numFields; ++field)
+        {
+            uint8_t length = data[offset + 1];
+            function(
+                FruFieldView{data[offset], data.subspan(offset + 2, length)});
+            offset += 2 + length;
+        }
+    }
+};
+
+/** @class FruRecordStream
+ *
+ *  @brief Decodes a FRU record table as its parts arrive, like the parts of
+ *         a multipart GetFRURecordTable transfer. Each record is passed to
+ *         the callback as soon as it is complete, as a view into the part;
+ *         only a record that spans two parts is copied, to join it.
+ */
+class FruRecordStream
+{
+  public:
+    using Callback = std::function<void(const FruRecordView&)>;
+
+    FruRecordStream() = delete;
+    FruRecordStream(const FruRecordStream&) = delete;
+    FruRecordStream(FruRecordStream&&) = default;
+    FruRecordStream& operator=(const FruRecordStream&) = delete;
+    FruRecordStream& operator=(FruRecordStream&&) = default;
+    ~FruRecordStream() = default;
+
+    /** @brief Constructor
+     *
+     *  @param[in] callback - called with each decoded record
+     */
+    explicit FruRecordStream(Callback callback) :
+        callback(std::move(callback))
+    {}
+
+    /** @brief Decode the next part of the table
+     *
+     *  @param[in] part - next part of the record table data
+     */
+    void feed(std::span<const uint8_t> part);
+
+    /** @brief Whether the table ended on a record boundary, to be called
+     *         after the last part
+     */
+    bool complete() const
+    {
+        return partial.empty();
+    }
+
+    /** @brief Number of records decoded */
+    size_t records() const
+    {
+        return count;
+    }
+
+  private:
+    /** @brief Decode the complete records at the start of data
+     *
+     *  @return the number of bytes decoded
+     */
+    size_t decode(std::span<const uint8_t> data);
+
+    Callback callback;
+
+    /** @brief Start of a record cut by the end of the previous part */
+    std::vector<uint8_t> partial;
+
+    size_t count = 0;
+};
+
 /** @brief Method to fetch the bitmap of possible states from a PDR
  *
  *  @param[in] pdrs - The PDR to fetch the bitmap from
@@ -289,12 +289,13 @@ Response Handler::getPDR(const pldm_msg* request, size_t payloadLength)
     }
 
     uint16_t respSizeBytes{};
-    uint8_t* recordData = nullptr;
+    const uint8_t* recordData = nullptr;
     try
     {
-        pdr_utils::PdrEntry e;
-        auto record = pdr::getRecordByHandle(pdrRepo, recordHandle, e);
-        if (record == NULL)
+        // The records are looked up in the arena, the repo itself is a list
+        pdrArena.sync(pdrRepo.getPdr());
+        auto record = pdrArena.find(recordHandle);
+        if (record == nullptr)
         {
             return CmdHandler::ccOnlyResponse(
                 request, PLDM_PLATFORM_INVALID_RECORD_HANDLE);
@@ -302,20 +303,20 @@ Response Handler::getPDR(const pldm_msg* request, size_t payloadLength)
 
         if (reqSizeBytes)
         {
-            respSizeBytes = e.size;
+            respSizeBytes = record->size;
             if (respSizeBytes > reqSizeBytes)
             {
                 respSizeBytes = reqSizeBytes;
             }
-            recordData = e.data;
+            recordData = record->data;
         }
         response.resize(sizeof(pldm_msg_hdr) + PLDM_GET_PDR_MIN_RESP_BYTES +
                             respSizeBytes,
                         0);
         auto responsePtr = reinterpret_cast<pldm_msg*>(response.data());
         rc = encode_get_pdr_resp(
-            request->hdr.instance_id, PLDM_SUCCESS, e.handle.nextRecordHandle,
-            0, PLDM_START_AND_END, respSizeBytes, recordData, 0, responsePtr);
+            request->hdr.instance_id, PLDM_SUCCESS, record->nextHandle, 0,
+            PLDM_START_AND_END, respSizeBytes, recordData, 0, responsePtr);
         if (rc != PLDM_SUCCESS)
         {
             return ccOnlyResponse(request, rc);
@@ -497,63 +498,27 @@ int Handler::sensorEvent(const pldm_msg* request, size_t payloadLength,
             return PLDM_ERROR;
         }
 
-        // Emitting state sensor event signal
-        emitStateSensorEventSignal(tid, sensorId, sensorOffset, eventState,
-                                   previousEventState);
-
-        // If there are no HOST PDR's, there is no further action
-        if (hostPDRHandler == NULL)
-        {
-            return PLDM_SUCCESS;
-        }
-
-        // Handle PLDM events for which PDR is available
-        SensorEntry sensorEntry{tid, sensorId};
-
-        pldm::pdr::EntityInfo entityInfo{};
-        pldm::pdr::CompositeSensorStates compositeSensorStates{};
-        std::vector<pldm::pdr::StateSetId> stateSetIds{};
-
-        try
+        // Validate the event against the host PDRs right away, so the
+        // completion code still reports an invalid event and the invalid
+        // state is neither signalled nor routed
+        if (hostPDRHandler)
         {
-            std::tie(entityInfo, compositeSensorStates, stateSetIds) =
-                hostPDRHandler->lookupSensorInfo(sensorEntry);
-        }
-        catch (const std::out_of_range&)
-        {
-            // If there is no mapping for tid, sensorId combination, try
-            // PLDM_TID_RESERVED, sensorId for terminus that is yet to
-            // implement TL PDR.
-            try
+            const auto& route = hostPDRHandler->lookupEventRoute(
+                SensorEntry{tid, sensorId}, sensorOffset);
+            if (route.mapped && !route.possibleStates.contains(eventState))
             {
-                sensorEntry.terminusID = PLDM_TID_RESERVED;
-                std::tie(entityInfo, compositeSensorStates, stateSetIds) =
-                    hostPDRHandler->lookupSensorInfo(sensorEntry);
+                return PLDM_ERROR_INVALID_DATA;
             }
-            // If there is no mapping for events return PLDM_SUCCESS
-            catch (const std::out_of_range&)
-            {
-                return PLDM_SUCCESS;
-            }
-        }
-
-        if (sensorOffset >= compositeSensorStates.size())
-        {
-            return PLDM_ERROR_INVALID_DATA;
         }
 
-        const auto& possibleStates = compositeSensorStates[sensorOffset];
-        if (possibleStates.find(eventState) == possibleStates.end())
+        // The signal is emitted and the event is routed to the BMC actions
+        // once the coalescing window of the sensor closes
+        if (!sensorEventAggregator.add(
+                {tid, sensorId, sensorOffset, eventState, previousEventState}))
         {
-            return PLDM_ERROR_INVALID_DATA;
+            return PLDM_ERROR_NOT_READY;
         }
-
-        const auto& [containerId, entityType, entityInstance] = entityInfo;
-        events::StateSensorEntry stateSensorEntry{
-            containerId,  entityType, entityInstance,
-            sensorOffset, false,      stateSetIds[sensorOffset]};
-        return hostPDRHandler->handleStateSensorEvent(
-            stateSetIds, stateSensorEntry, eventState);
+        return PLDM_SUCCESS;
     }
     else
     {
@@ -563,6 +528,30 @@ int Handler::sensorEvent(const pldm_msg* request, size_t payloadLength,
     return PLDM_SUCCESS;
 }
 
+void Handler::stateSensorEventAction(
+    const events::StateSensorEvent& sensorEvent)
+{
+    // If there are no HOST PDR's, there is no further action
+    if (hostPDRHandler == NULL)
+    {
+        return;
+    }
+
+    // Handle PLDM events for which PDR is available, the event is routed to
+    // the BMC actions compiled for the sensor offset
+    auto rc = hostPDRHandler->handleStateSensorEvent(
+        SensorEntry{sensorEvent.tid, sensorEvent.sensorId},
+        sensorEvent.sensorOffset, sensorEvent.eventState);
+    // An invalid event state was already reported in the response
+    if (rc != PLDM_SUCCESS && rc != PLDM_ERROR_INVALID_DATA)
+    {
+        error(
+            "Failed to handle state sensor event, TID={TID} SENSOR_ID={SENSOR_ID} RC={RC}",
+            "TID", (unsigned)sensorEvent.tid, "SENSOR_ID", sensorEvent.sensorId,
+            "RC", rc);
+    }
+}
+
 int Handler::pldmPDRRepositoryChgEvent(const pldm_msg* request,
                                        size_t payloadLength,
                                        uint8_t /*formatVersion*/, uint8_t tid,
@@ -668,6 +657,7 @@ int Handler::pldmPDRRepositoryChgEvent(const pldm_msg* request,
                 {
                     pldm_pdr_remove_pdrs_by_terminus_handle(pdrRepo.getPdr(),
                                                             terminusHandle);
+                    pldm::utils::pdrRepoChanged();
                 }
             }
         }
@@ -705,12 +695,13 @@ int Handler::getPDRRecordHandles(const ChangeEntry* changeEntryData,
     return PLDM_SUCCESS;
 }
 
-Response Handler::getNumericEffecterValue(const pldm_msg* request,
-                                          size_t payloadLength)
+void Handler::getNumericEffecterValue(const pldm_msg* request,
+                                      size_t payloadLength, Completer completer)
 {
     if (payloadLength != PLDM_GET_NUMERIC_EFFECTER_VALUE_REQ_BYTES)
     {
-        return ccOnlyResponse(request, PLDM_ERROR_INVALID_LENGTH);
+        completer(ccOnlyResponse(request, PLDM_ERROR_INVALID_LENGTH));
+        return;
     }
 
     uint16_t effecterId{};
@@ -719,7 +710,8 @@ Response Handler::getNumericEffecterValue(const pldm_msg* request,
 
     if (rc != PLDM_SUCCESS)
     {
-        return ccOnlyResponse(request, rc);
+        completer(ccOnlyResponse(request, rc));
+        return;
     }
 
     const pldm::utils::DBusHandler dBusIntf;
@@ -729,13 +721,58 @@ Response Handler::getNumericEffecterValue(const pldm_msg* request,
     real32_t effecterOffset{};
     real32_t effecterResolution{};
     uint8_t effecterDataSize{};
-    pldm::utils::PropertyValue dbusValue;
-    std::string propertyType;
 
-    // Default value - Enabled and Operating, The pending and presentValue
-    // fields return the present numeric setting
-    uint8_t effecterOperationalState =
-        EFFECTER_OPER_STATE_ENABLED_NOUPDATEPENDING;
+    // The request is only valid until the handler returns
+    pldm_msg header{};
+    header.hdr = request->hdr;
+
+    auto respond = [header, effecterId,
+                    completer](int rc, uint8_t effecterDataSize,
+                               const std::string& propertyType,
+                               const pldm::utils::PropertyValue& dbusValue) {
+        if (rc != PLDM_SUCCESS)
+        {
+            completer(ccOnlyResponse(&header, rc));
+            return;
+        }
+
+        // Default value - Enabled and Operating, The pending and
+        // presentValue fields return the present numeric setting
+        uint8_t effecterOperationalState =
+            EFFECTER_OPER_STATE_ENABLED_NOUPDATEPENDING;
+
+        // GetNumericEffecterResponse contains below fields
+        // effecter_data_size, effecterOperationalState, pendingValue and
+        // PresentValue 1 is added for completion code
+        size_t responsePayloadLength = 1 + sizeof(effecterDataSize) +
+                                       sizeof(effecterOperationalState) +
+                                       getEffecterDataSize(effecterDataSize) +
+                                       getEffecterDataSize(effecterDataSize);
+
+        Response response(responsePayloadLength + sizeof(pldm_msg_hdr));
+        auto responsePtr = reinterpret_cast<pldm_msg*>(response.data());
+
+        info(
+            "Return Value [RC]=[{RC}]  EffecterDataSize[{EFFECTERDATASIZE}] OperationalState[{OPERATIONSTATE}] PayloadLength[{PAYLOADLENGTH}]",
+            "RC", rc, "EFFECTERDATASIZE", static_cast<int>(effecterDataSize),
+            "OPERATIONSTATE", static_cast<int>(effecterOperationalState),
+            "PAYLOADLENGTH", static_cast<int>(responsePayloadLength));
+
+        rc = platform_numeric_effecter::getNumericEffecterValueHandler(
+            propertyType, dbusValue, effecterDataSize, responsePtr,
+            responsePayloadLength, header.hdr.instance_id);
+
+        if (rc != PLDM_SUCCESS)
+        {
+            error(
+                "Reponse to GetNumeric Effecter failed RC={RC} for EffectorId={EFFECTERID} ",
+                "RC", rc, "EFFECTERID", effecterId);
+            completer(ccOnlyResponse(&header, rc));
+            return;
+        }
+        completer(std::move(response));
+    };
+
     if (isOemNumericEffecter(*this, effecterId, entityType, entityInstance,
                              effecterDataSize, effecterSemanticId,
                              effecterOffset, effecterResolution) &&
@@ -745,55 +782,19 @@ Response Handler::getNumericEffecterValue(const pldm_msg* request,
         // TODO:  Handle OEM effecter
         error("OEM Effecter is not supported for EFFECTERID={EFFECTERID}",
               "EFFECTERID", effecterId);
+        respond(PLDM_SUCCESS, effecterDataSize, {}, {});
     }
     else
     {
-        rc = platform_numeric_effecter::getNumericEffecterData<
+        platform_numeric_effecter::getNumericEffecterDataAsync<
             pldm::utils::DBusHandler, Handler>(dBusIntf, *this, effecterId,
-                                               effecterDataSize, propertyType,
-                                               dbusValue);
-
-        if (rc != PLDM_SUCCESS)
-        {
-            return ccOnlyResponse(request, rc);
-        }
+                                               std::move(respond));
     }
-    // GetNumericEffecterResponse contains below fields
-    // effecter_data_size, effecterOperationalState, pendingValue and
-    // PresentValue 1 is added for completion code
-    size_t responsePayloadLength = 1 + sizeof(effecterDataSize) +
-                                   sizeof(effecterOperationalState) +
-                                   getEffecterDataSize(effecterDataSize) +
-                                   getEffecterDataSize(effecterDataSize);
-
-    Response response(responsePayloadLength + sizeof(pldm_msg_hdr));
-    auto responsePtr = reinterpret_cast<pldm_msg*>(response.data());
-
-    info(
-        "Return Value [RC]=[{RC}]  EffecterDataSize[{EFFECTERDATASIZE}] OperationalState[{OPERATIONSTATE}] PayloadLength[{PAYLOADLENGTH}]",
-        "RC", rc, "EFFECTERDATASIZE", static_cast<int>(effecterDataSize),
-        "OPERATIONSTATE", static_cast<int>(effecterOperationalState),
-        "PAYLOADLENGTH", static_cast<int>(responsePayloadLength));
-
-    rc = platform_numeric_effecter::getNumericEffecterValueHandler(
-        propertyType, dbusValue, effecterDataSize, responsePtr,
-        responsePayloadLength, request->hdr.instance_id);
-
-    if (rc != PLDM_SUCCESS)
-    {
-        error(
-            "Reponse to GetNumeric Effecter failed RC={RC} for EffectorId={EFFECTERID} ",
-            "RC", rc, "EFFECTERID", effecterId);
-        return ccOnlyResponse(request, rc);
-    }
-    return response;
 }
 
-Response Handler::setNumericEffecterValue(const pldm_msg* request,
-                                          size_t payloadLength)
+void Handler::setNumericEffecterValue(const pldm_msg* request,
+                                      size_t payloadLength, Completer completer)
 {
-    Response response(sizeof(pldm_msg_hdr) +
-                      PLDM_SET_NUMERIC_EFFECTER_VALUE_RESP_BYTES);
     uint16_t effecterId{};
     uint8_t effecterDataSize{};
     uint8_t effecterValue[4] = {};
@@ -802,7 +803,8 @@ Response Handler::setNumericEffecterValue(const pldm_msg* request,
                              sizeof(union_effecter_data_size)) ||
         (payloadLength < sizeof(effecterId) + sizeof(effecterDataSize) + 1))
     {
-        return ccOnlyResponse(request, PLDM_ERROR_INVALID_LENGTH);
+        completer(ccOnlyResponse(request, PLDM_ERROR_INVALID_LENGTH));
+        return;
     }
 
     int rc = decode_set_numeric_effecter_value_req(
@@ -830,16 +832,20 @@ Response Handler::setNumericEffecterValue(const pldm_msg* request,
         rc = oemPlatformHandler->oemSetNumericEffecterValueHandler(
             entityType, entityInstance, effecterSemanticId, effecterDataSize,
             effecterValue, effecterOffset, effecterResolution, effecterId);
+        completer(ccOnlyResponse(request, rc));
     }
     else
     {
-        rc = platform_numeric_effecter::setNumericEffecterValueHandler<
-            pldm::utils::DBusHandler, Handler>(dBusIntf, *this, effecterId,
-                                               effecterDataSize, effecterValue,
-                                               sizeof(effecterValue));
+        // The request is only valid until the handler returns
+        pldm_msg header{};
+        header.hdr = request->hdr;
+        platform_numeric_effecter::setNumericEffecterValueAsync<
+            pldm::utils::DBusHandler, Handler>(
+            dBusIntf, *this, effecterId, effecterDataSize, effecterValue,
+            sizeof(effecterValue), [header, completer](int rc) {
+            completer(ccOnlyResponse(&header, rc));
+        });
     }
-
-    return ccOnlyResponse(request, rc);
 }
 
 void Handler::generateTerminusLocatorPDR(Repo& repo)
@@ -876,8 +882,38 @@ void Handler::generateTerminusLocatorPDR(Repo& repo)
     }
 }
 
-Response Handler::getStateSensorReadings(const pldm_msg* request,
-                                         size_t payloadLength)
+namespace
+{
+
+/** @brief Encode the response of GetStateSensorReadings */
+Response stateSensorReadingsResponse(
+    const pldm_msg* request, int rc, uint8_t comSensorCnt,
+    std::vector<get_sensor_state_field>& stateField)
+{
+    if (rc != PLDM_SUCCESS)
+    {
+        return CmdHandler::ccOnlyResponse(request, rc);
+    }
+
+    Response response(sizeof(pldm_msg_hdr) +
+                      PLDM_GET_STATE_SENSOR_READINGS_MIN_RESP_BYTES +
+                      sizeof(get_sensor_state_field) * comSensorCnt);
+    auto responsePtr = reinterpret_cast<pldm_msg*>(response.data());
+    rc = encode_get_state_sensor_readings_resp(request->hdr.instance_id, rc,
+                                               comSensorCnt, stateField.data(),
+                                               responsePtr);
+    if (rc != PLDM_SUCCESS)
+    {
+        return CmdHandler::ccOnlyResponse(request, rc);
+    }
+
+    return response;
+}
+
+} // namespace
+
+void Handler::getStateSensorReadings(const pldm_msg* request,
+                                     size_t payloadLength, Completer completer)
 {
     uint16_t sensorId{};
     bitfield8_t sensorRearm{};
@@ -885,7 +921,8 @@ Response Handler::getStateSensorReadings(const pldm_msg* request,
 
     if (payloadLength != PLDM_GET_STATE_SENSOR_READINGS_REQ_BYTES)
     {
-        return ccOnlyResponse(request, PLDM_ERROR_INVALID_LENGTH);
+        completer(ccOnlyResponse(request, PLDM_ERROR_INVALID_LENGTH));
+        return;
     }
 
     int rc = decode_get_state_sensor_readings_req(
@@ -893,7 +930,8 @@ Response Handler::getStateSensorReadings(const pldm_msg* request,
 
     if (rc != PLDM_SUCCESS)
     {
-        return ccOnlyResponse(request, rc);
+        completer(ccOnlyResponse(request, rc));
+        return;
     }
 
     // 0x01 to 0x08
@@ -914,33 +952,23 @@ Response Handler::getStateSensorReadings(const pldm_msg* request,
         rc = oemPlatformHandler->getOemStateSensorReadingsHandler(
             entityType, entityInstance, containerId, stateSetId, comSensorCnt,
             sensorId, stateField);
-    }
-    else
-    {
-        rc = platform_state_sensor::getStateSensorReadingsHandler<
-            pldm::utils::DBusHandler, Handler>(
-            dBusIntf, *this, sensorId, sensorRearmCount, comSensorCnt,
-            stateField, dbusToPLDMEventHandler->getSensorCache());
-    }
-
-    if (rc != PLDM_SUCCESS)
-    {
-        return ccOnlyResponse(request, rc);
+        completer(
+            stateSensorReadingsResponse(request, rc, comSensorCnt, stateField));
+        return;
     }
 
-    Response response(sizeof(pldm_msg_hdr) +
-                      PLDM_GET_STATE_SENSOR_READINGS_MIN_RESP_BYTES +
-                      sizeof(get_sensor_state_field) * comSensorCnt);
-    auto responsePtr = reinterpret_cast<pldm_msg*>(response.data());
-    rc = encode_get_state_sensor_readings_resp(request->hdr.instance_id, rc,
-                                               comSensorCnt, stateField.data(),
-                                               responsePtr);
-    if (rc != PLDM_SUCCESS)
-    {
-        return ccOnlyResponse(request, rc);
-    }
-
-    return response;
+    // The request is only valid until the handler returns
+    pldm_msg header{};
+    header.hdr = request->hdr;
+    platform_state_sensor::getStateSensorReadingsAsync<pldm::utils::DBusHandler,
+                                                       Handler>(
+        dBusIntf, *this, sensorId, sensorRearmCount,
+        dbusToPLDMEventHandler->getSensorCache(),
+        [header, completer](int rc, uint8_t comSensorCnt,
+                            std::vector<get_sensor_state_field>&& stateField) {
+        completer(
+            stateSensorReadingsResponse(&header, rc, comSensorCnt, stateField));
+    });
 }
 
 void Handler::_processPostGetPDRActions(sdeventplus::source::EventBase&
@@ -1,11 +1,13 @@
 #pragma once
 
 #include "common/utils.hpp"
+#include "event_aggregator.hpp"
 #include "event_parser.hpp"
 #include "fru.hpp"
 #include "host-bmc/dbus_to_event_handler.hpp"
 #include "host-bmc/host_pdr_handler.hpp"
 #include "libpldmresponder/pdr.hpp"
+#include "libpldmresponder/pdr_arena.hpp"
 #include "libpldmresponder/pdr_utils.hpp"
 #include "oem_handler.hpp"
 #include "pldmd/handler.hpp"
@@ -64,7 +66,18 @@ class Handler : public CmdHandler
         dbusToPLDMEventHandler(dbusToPLDMEventHandler), fruHandler(fruHandler),
         bmcEntityTree(bmcEntityTree), dBusIntf(dBusIntf),
         oemPlatformHandler(oemPlatformHandler), event(event),
-        pdrJsonDir(pdrJsonDir), pdrCreated(false), pdrJsonsDir({pdrJsonDir})
+        pdrJsonDir(pdrJsonDir), pdrCreated(false), pdrJsonsDir({pdrJsonDir}),
+        sensorEventAggregator(
+            event, std::chrono::milliseconds(SENSOR_EVENT_COALESCE_WINDOW),
+            SENSOR_EVENT_MAX_PENDING,
+            [](const events::StateSensorEvent& sensorEvent) {
+        pldm::utils::emitStateSensorEventSignal(
+            sensorEvent.tid, sensorEvent.sensorId, sensorEvent.sensorOffset,
+            sensorEvent.eventState, sensorEvent.previousEventState);
+    },
+            [this](const events::StateSensorEvent& sensorEvent) {
+        this->stateSensorEventAction(sensorEvent);
+    })
     {
         if (!buildPDRLazily)
         {
@@ -77,13 +90,21 @@ class Handler : public CmdHandler
                          [this](const pldm_msg* request, size_t payloadLength) {
             return this->getPDR(request, payloadLength);
         });
-        handlers.emplace(PLDM_SET_NUMERIC_EFFECTER_VALUE,
-                         [this](const pldm_msg* request, size_t payloadLength) {
-            return this->setNumericEffecterValue(request, payloadLength);
+        // The commands backed by D-Bus properties complete when the
+        // property call returns, instead of blocking the event loop on it
+        asyncHandlers.emplace(PLDM_SET_NUMERIC_EFFECTER_VALUE,
+                              [this](const pldm_msg* request,
+                                     size_t payloadLength,
+                                     Completer completer) {
+            this->setNumericEffecterValue(request, payloadLength,
+                                          std::move(completer));
         });
-        handlers.emplace(PLDM_GET_NUMERIC_EFFECTER_VALUE,
-                         [this](const pldm_msg* request, size_t payloadLength) {
-            return this->getNumericEffecterValue(request, payloadLength);
+        asyncHandlers.emplace(PLDM_GET_NUMERIC_EFFECTER_VALUE,
+                              [this](const pldm_msg* request,
+                                     size_t payloadLength,
+                                     Completer completer) {
+            this->getNumericEffecterValue(request, payloadLength,
+                                          std::move(completer));
         });
         handlers.emplace(PLDM_SET_STATE_EFFECTER_STATES,
                          [this](const pldm_msg* request, size_t payloadLength) {
@@ -93,9 +114,12 @@ class Handler : public CmdHandler
                          [this](const pldm_msg* request, size_t payloadLength) {
             return this->platformEventMessage(request, payloadLength);
         });
-        handlers.emplace(PLDM_GET_STATE_SENSOR_READINGS,
-                         [this](const pldm_msg* request, size_t payloadLength) {
-            return this->getStateSensorReadings(request, payloadLength);
+        asyncHandlers.emplace(PLDM_GET_STATE_SENSOR_READINGS,
+                              [this](const pldm_msg* request,
+                                     size_t payloadLength,
+                                     Completer completer) {
+            this->getStateSensorReadings(request, payloadLength,
+                                         std::move(completer));
         });
 
         // Default handler for PLDM Events
@@ -236,28 +260,31 @@ class Handler : public CmdHandler
      *
      *  @param[in] request - Request message
      *  @param[in] payloadLength - Request payload length
-     *  @return Response - PLDM Response message
+     *  @param[in] completer - completes the response once the D-Bus property
+     *                         is set
      */
-    Response setNumericEffecterValue(const pldm_msg* request,
-                                     size_t payloadLength);
+    void setNumericEffecterValue(const pldm_msg* request, size_t payloadLength,
+                                 Completer completer);
 
     /** @brief Handler for getNumericEffecterValue
      *
      *  @param[in] request - Request message
      *  @param[in] payloadLength - Request payload length
-     *  @return Response - PLDM Response message
+     *  @param[in] completer - completes the response once the D-Bus property
+     *                         is read
      */
-    Response getNumericEffecterValue(const pldm_msg* request,
-                                     size_t payloadLength);
+    void getNumericEffecterValue(const pldm_msg* request, size_t payloadLength,
+                                 Completer completer);
 
     /** @brief Handler for getStateSensorReadings
      *
      *  @param[in] request - Request message
      *  @param[in] payloadLength - Request payload length
-     *  @return Response - PLDM Response message
+     *  @param[in] completer - completes the response once the D-Bus
+     *                         properties of the sensor are read
      */
-    Response getStateSensorReadings(const pldm_msg* request,
-                                    size_t payloadLength);
+    void getStateSensorReadings(const pldm_msg* request, size_t payloadLength,
+                                Completer completer);
 
     /** @brief Handler for setStateEffecterStates
      *
@@ -290,6 +317,20 @@ class Handler : public CmdHandler
     int sensorEvent(const pldm_msg* request, size_t payloadLength,
                     uint8_t formatVersion, uint8_t tid, size_t eventDataOffset);
 
+    /** @brief Run the BMC action of a state sensor event, called by the
+     *         event aggregator once the coalescing window closes
+     *
+     *  @param[in] sensorEvent - state sensor event
+     */
+    void stateSensorEventAction(const events::StateSensorEvent& sensorEvent);
+
+    /** @brief Counters of the coalesced and dropped state sensor events */
+    const events::StateSensorEventAggregator::Stats&
+        getSensorEventStats() const
+    {
+        return sensorEventAggregator.getStats();
+    }
+
     /** @brief Handler for pldmPDRRepositoryChgEvent
      *
      *  @param[in] request - Request message
@@ -414,17 +455,21 @@ class Handler : public CmdHandler
                     break;
                 }
                 const DBusMapping& dbusMapping = dbusMappings[currState];
-                const pldm::responder::pdr_utils::StatestoDbusVal&
+                const pldm::responder::pdr_utils::StateValueTable&
                     dbusValToMap = dbusValMaps[currState];
 
                 if (stateField[currState].set_request == PLDM_REQUEST_SET)
                 {
                     try
                     {
-                        dBusIntf.setDbusProperty(
-                            dbusMapping,
-                            dbusValToMap.at(
-                                stateField[currState].effecter_state));
+                        auto value = dbusValToMap.value(
+                            stateField[currState].effecter_state);
+                        if (!value)
+                        {
+                            throw std::out_of_range(
+                                "Effecter state not mapped");
+                        }
+                        dBusIntf.setDbusProperty(dbusMapping, *value);
                     }
                     catch (const std::exception& e)
                     {
@@ -492,6 +537,8 @@ class Handler : public CmdHandler
 
   private:
     pdr_utils::Repo pdrRepo;
+    /** @brief contiguous copy of pdrRepo, serves the GetPDR lookups */
+    pdr_utils::PdrArena pdrArena;
     uint16_t nextEffecterId{};
     uint16_t nextSensorId{};
     pdr_utils::DbusObjMaps effecterDbusObjMaps{};
@@ -513,6 +560,10 @@ class Handler : public CmdHandler
     /** @brief Flag used to delete the cached Mex details and Mex Dbus Objects
      */
     bool clearMexObj = true;
+    /** @brief coalesces the state sensor events and spreads their actions
+     *         over the event loop
+     */
+    events::StateSensorEventAggregator sensorEventAggregator;
 };
 
 /** @brief Function to check if the effecter falls in OEM range
@@ -12,6 +12,7 @@
 
 #include <phosphor-logging/lg2.hpp>
 
+#include <functional>
 #include <map>
 #include <optional>
 
@@ -228,10 +229,9 @@ std::pair<int, std::optional<pldm::utils::PropertyValue>>
     }
 }
 
-/** @brief Function to set the effecter value requested by pldm requester
- *  @tparam[in] DBusInterface - DBus interface type
+/** @brief Function to find the D-Bus property a numeric effecter sets and
+ *         the value to set it to
  *  @tparam[in] Handler - pldm::responder::platform::Handler
- *  @param[in] dBusIntf - The interface object of DBusInterface
  *  @param[in] handler - The interface object of
  *             pldm::responder::platform::Handler
  *  @param[in] effecterId - Effecter ID sent by the requester to act on
@@ -241,15 +241,17 @@ std::pair<int, std::optional<pldm::utils::PropertyValue>>
  * 				requested.
  *  @param[in] effecterValueLength - The setting value length of numeric
  *              effecter being requested.
- *  @return - Success or failure in setting the states. Returns failure in
- * terms of PLDM completion codes if atleast one state fails to be set
+ *  @param[out] dbusMapping - The D-Bus property to set
+ *  @param[out] dbusValue - The value to set
+ *  @return - PLDM_SUCCESS or the PLDM completion code of the failure
  */
-template <class DBusInterface, class Handler>
-int setNumericEffecterValueHandler(const DBusInterface& dBusIntf,
-                                   Handler& handler, uint16_t effecterId,
-                                   uint8_t effecterDataSize,
-                                   uint8_t* effecterValue,
-                                   size_t effecterValueLength)
+template <class Handler>
+int prepareNumericEffecterValue(Handler& handler, uint16_t effecterId,
+                                uint8_t effecterDataSize,
+                                uint8_t* effecterValue,
+                                size_t effecterValueLength,
+                                pldm::utils::DBusMapping& dbusMapping,
+                                pldm::utils::PropertyValue& dbusValue)
 {
     constexpr auto effecterValueArrayLength = 4;
     pldm_numeric_effecter_value_pdr* pdr = nullptr;
@@ -302,30 +304,18 @@ int setNumericEffecterValueHandler(const DBusInterface& dBusIntf,
     {
         const auto& [dbusMappings,
                      dbusValMaps] = handler.getDbusObjMaps(effecterId);
-        pldm::utils::DBusMapping dbusMapping{
+        dbusMapping = pldm::utils::DBusMapping{
             dbusMappings[0].objectPath, dbusMappings[0].interface,
             dbusMappings[0].propertyName, dbusMappings[0].propertyType};
 
         // convert to dbus effectervalue according to the factor
-        auto [rc, dbusValue] = convertToDbusValue(
+        auto [rc, value] = convertToDbusValue(
             pdr, effecterDataSize, effecterValue, dbusMappings[0].propertyType);
         if (rc != PLDM_SUCCESS)
         {
             return rc;
         }
-        try
-        {
-            dBusIntf.setDbusProperty(dbusMapping, dbusValue.value());
-        }
-        catch (const std::exception& e)
-        {
-            error(
-                "Error setting property, ERROR={ERR_EXCEP} PROPERTY={DBUS_PROP} INTERFACE={DBUS_INTF}, PATH={DBUS_OBJ_PATH}",
-                "ERR_EXCEP", e.what(), "DBUS_PROP", dbusMapping.propertyName,
-                "DBUS_INTF", dbusMapping.interface, "DBUS_OBJ_PATH",
-                dbusMapping.objectPath);
-            return PLDM_ERROR;
-        }
+        dbusValue = value.value();
     }
     catch (const std::out_of_range& e)
     {
@@ -337,6 +327,56 @@ int setNumericEffecterValueHandler(const DBusInterface& dBusIntf,
     return PLDM_SUCCESS;
 }
 
+/** @brief Function to set the effecter value requested by pldm requester
+ *         without blocking on D-Bus
+ *  @tparam[in] DBusInterface - DBus interface type
+ *  @tparam[in] Handler - pldm::responder::platform::Handler
+ *  @param[in] dBusIntf - The interface object of DBusInterface
+ *  @param[in] handler - The interface object of
+ *             pldm::responder::platform::Handler
+ *  @param[in] effecterId - Effecter ID sent by the requester to act on
+ *  @param[in] effecterDataSize - The bit width and format of the setting
+ * 				value for the effecter
+ *  @param[in] effecter_value - The setting value of numeric effecter being
+ * 				requested.
+ *  @param[in] effecterValueLength - The setting value length of numeric
+ *              effecter being requested.
+ *  @param[in] callback - handles the PLDM completion code
+ */
+template <class DBusInterface, class Handler>
+void setNumericEffecterValueAsync(const DBusInterface& dBusIntf,
+                                  Handler& handler, uint16_t effecterId,
+                                  uint8_t effecterDataSize,
+                                  uint8_t* effecterValue,
+                                  size_t effecterValueLength,
+                                  std::function<void(int rc)> callback)
+{
+    pldm::utils::DBusMapping dbusMapping{};
+    pldm::utils::PropertyValue dbusValue{};
+    auto rc = prepareNumericEffecterValue(handler, effecterId,
+                                          effecterDataSize, effecterValue,
+                                          effecterValueLength, dbusMapping,
+                                          dbusValue);
+    if (rc != PLDM_SUCCESS)
+    {
+        callback(rc);
+        return;
+    }
+
+    dBusIntf.setDbusPropertyAsync(
+        dbusMapping, dbusValue,
+        [dbusMapping, callback = std::move(callback)](bool success) {
+        if (!success)
+        {
+            error(
+                "Error setting property, PROPERTY={DBUS_PROP} INTERFACE={DBUS_INTF}, PATH={DBUS_OBJ_PATH}",
+                "DBUS_PROP", dbusMapping.propertyName, "DBUS_INTF",
+                dbusMapping.interface, "DBUS_OBJ_PATH", dbusMapping.objectPath);
+        }
+        callback(success ? PLDM_SUCCESS : PLDM_ERROR);
+    });
+}
+
 /** @brief Function to convert the D-Bus value by effecterdataSize and create
  * the response
  *  @for getNumericEffecterValue request.
@@ -455,27 +495,22 @@ int getNumericEffecterValueHandler(std::string propertyType,
     return PLDM_ERROR;
 }
 
-/** @brief Function to get the effecter details as data size, D-Bus property
- * type, D-Bus Value
- *  @tparam[in] DBusInterface - DBus interface type
+/** @brief Function to find the data size and the D-Bus property of a numeric
+ * effecter
  *  @tparam[in] Handler - pldm::responder::platform::Handler
- *  @param[in] dBusIntf - The interface object of DBusInterface
  *  @param[in] handler - The interface object of
  *             pldm::responder::platform::Handler
  *  @param[in] effecterId - Effecter ID sent by the requester to act on
- *  @param[in] effecterDataSize - The bit width and format of the setting
+ *  @param[out] effecterDataSize - The bit width and format of the setting
  * 				value for the effecter
- *  @param[in] propertyType - The data type of the D-Bus value
- *  @param[in] propertyValue - The value of numeric effecter being
- * 				requested.
- *  @return - Success or failure in getting the D-Bus property or the
- *  effecterId not found in the PDR repo
+ *  @param[out] dbusMapping - The D-Bus property of the effecter, nullopt
+ *              when the effecter has none
+ *  @return - Success or the effecterId not found in the PDR repo
  */
-template <class DBusInterface, class Handler>
-int getNumericEffecterData(const DBusInterface& dBusIntf, Handler& handler,
-                           uint16_t effecterId, uint8_t& effecterDataSize,
-                           std::string& propertyType,
-                           pldm::utils::PropertyValue& propertyValue)
+template <class Handler>
+int findNumericEffecter(Handler& handler, uint16_t effecterId,
+                        uint8_t& effecterDataSize,
+                        std::optional<pldm::utils::DBusMapping>& dbusMapping)
 {
     pldm_numeric_effecter_value_pdr* pdr = nullptr;
 
@@ -522,25 +557,9 @@ int getNumericEffecterData(const DBusInterface& dBusIntf, Handler& handler,
                      dbusValMaps] = handler.getDbusObjMaps(effecterId);
         if (dbusMappings.size() > 0)
         {
-            pldm::utils::DBusMapping dbusMapping{
+            dbusMapping = pldm::utils::DBusMapping{
                 dbusMappings[0].objectPath, dbusMappings[0].interface,
                 dbusMappings[0].propertyName, dbusMappings[0].propertyType};
-            try
-            {
-                propertyValue = dBusIntf.getDbusPropertyVariant(
-                    dbusMapping.objectPath.c_str(),
-                    dbusMapping.propertyName.c_str(),
-                    dbusMapping.interface.c_str());
-                propertyType = dbusMappings[0].propertyType;
-            }
-            catch (const std::exception& e)
-            {
-                error(
-                    "Get StateNumericEffecter from dbus Error, interface : {INTF} ,exception : {ERR_EXCEP}",
-                    "INTF", dbusMapping.interface.c_str(), "ERR_EXCEP",
-                    e.what());
-                return PLDM_ERROR;
-            }
         }
     }
     catch (const std::out_of_range& e)
@@ -553,6 +572,61 @@ int getNumericEffecterData(const DBusInterface& dBusIntf, Handler& handler,
     return PLDM_SUCCESS;
 }
 
+/** @brief Callback of the asynchronous numeric effecter read
+ *
+ *  @param[in] rc - PLDM completion code
+ *  @param[in] effecterDataSize - The bit width and format of the setting
+ * 				value for the effecter
+ *  @param[in] propertyType - The data type of the D-Bus value
+ *  @param[in] propertyValue - The value of the numeric effecter
+ */
+using NumericEffecterDataCallback = std::function<void(
+    int rc, uint8_t effecterDataSize, const std::string& propertyType,
+    const pldm::utils::PropertyValue& propertyValue)>;
+
+/** @brief Function to get the effecter details as data size, D-Bus property
+ * type, D-Bus Value without blocking on D-Bus
+ *  @tparam[in] DBusInterface - DBus interface type
+ *  @tparam[in] Handler - pldm::responder::platform::Handler
+ *  @param[in] dBusIntf - The interface object of DBusInterface
+ *  @param[in] handler - The interface object of
+ *             pldm::responder::platform::Handler
+ *  @param[in] effecterId - Effecter ID sent by the requester to act on
+ *  @param[in] callback - handles the effecter details
+ */
+template <class DBusInterface, class Handler>
+void getNumericEffecterDataAsync(const DBusInterface& dBusIntf,
+                                 Handler& handler, uint16_t effecterId,
+                                 NumericEffecterDataCallback callback)
+{
+    uint8_t effecterDataSize{};
+    std::optional<pldm::utils::DBusMapping> dbusMapping;
+    auto rc = findNumericEffecter(handler, effecterId, effecterDataSize,
+                                  dbusMapping);
+    if (rc != PLDM_SUCCESS || !dbusMapping)
+    {
+        callback(rc, effecterDataSize, {}, {});
+        return;
+    }
+
+    dBusIntf.getDbusPropertyVariantAsync(
+        *dbusMapping,
+        [effecterDataSize, dbusMapping = *dbusMapping,
+         callback = std::move(callback)](
+            std::optional<pldm::utils::PropertyValue> value) {
+        if (!value)
+        {
+            error(
+                "Get StateNumericEffecter from dbus Error, interface : {INTF}",
+                "INTF", dbusMapping.interface.c_str());
+            callback(PLDM_ERROR, effecterDataSize, {}, {});
+            return;
+        }
+        callback(PLDM_SUCCESS, effecterDataSize, dbusMapping.propertyType,
+                 *value);
+    });
+}
+
 } // namespace platform_numeric_effecter
 } // namespace responder
 } // namespace pldm
@@ -117,16 +117,20 @@ int setStateEffecterStatesHandler(
                 break;
             }
             const DBusMapping& dbusMapping = dbusMappings[currState];
-            const pldm::responder::pdr_utils::StatestoDbusVal& dbusValToMap =
+            const pldm::responder::pdr_utils::StateValueTable& dbusValToMap =
                 dbusValMaps[currState];
 
             if (stateField[currState].set_request == PLDM_REQUEST_SET)
             {
                 try
                 {
-                    dBusIntf.setDbusProperty(
-                        dbusMapping,
-                        dbusValToMap.at(stateField[currState].effecter_state));
+                    auto value = dbusValToMap.value(
+                        stateField[currState].effecter_state);
+                    if (!value)
+                    {
+                        throw std::out_of_range("Effecter state not mapped");
+                    }
+                    dBusIntf.setDbusProperty(dbusMapping, *value);
                 }
                 catch (const std::exception& e)
                 {
@@ -10,7 +10,10 @@
 #include <phosphor-logging/lg2.hpp>
 
 #include <cstdint>
+#include <functional>
 #include <map>
+#include <memory>
+#include <optional>
 
 PHOSPHOR_LOG2_USING;
 
@@ -20,86 +23,37 @@ namespace responder
 {
 namespace platform_state_sensor
 {
-/** @brief Function to get the sensor state
+/** @brief Function to map a D-Bus property value to the sensor state
  *
- *  @tparam[in] DBusInterface - DBus interface type
- *  @param[in] dBusIntf - The interface object of DBusInterface
- *  @param[in] stateToDbusValue - Map of DBus property State to attribute value
- *  @param[in] dbusMapping - The d-bus object
+ *  @param[in] stateToDbusValue - Translation table of the D-Bus property
+ *  @param[in] propertyValue - The value of the D-Bus property
  *
  *  @return - Enumeration of SensorState
  */
-template <class DBusInterface>
-uint8_t getStateSensorEventState(
-    const DBusInterface& dBusIntf,
-    const std::map<pldm::responder::pdr_utils::State,
-                   pldm::utils::PropertyValue>& stateToDbusValue,
-    const pldm::utils::DBusMapping& dbusMapping)
+inline uint8_t stateSensorEventState(
+    const pldm::responder::pdr_utils::StateValueTable& stateToDbusValue,
+    const pldm::utils::PropertyValue& propertyValue)
 {
-    try
-    {
-        auto propertyValue = dBusIntf.getDbusPropertyVariant(
-            dbusMapping.objectPath.c_str(), dbusMapping.propertyName.c_str(),
-            dbusMapping.interface.c_str());
-
-        for (const auto& stateValue : stateToDbusValue)
-        {
-            // This special condition added to handle the "||" keyword
-            // present in the property value string
-            if (dbusMapping.propertyType == "string")
-            {
-                std::string statValSecStr =
-                    std::get<std::string>(stateValue.second);
-                std::string proValStr = std::get<std::string>(propertyValue);
-
-                if ((std::strstr(statValSecStr.c_str(), "||")) &&
-                    (std::strstr(statValSecStr.c_str(), proValStr.c_str())))
-                {
-                    return stateValue.first;
-                }
-            }
-
-            if (stateValue.second == propertyValue)
-            {
-                return stateValue.first;
-            }
-        }
-    }
-    catch (const std::exception& e)
-    {
-        error(
-            "Get StateSensor EventState from dbus Error, interface : {INTF} ,exception : {ERR_EXCEP}",
-            "INTF", dbusMapping.objectPath.c_str(), "ERR_EXCEP", e.what());
-    }
-
-    return PLDM_SENSOR_UNKNOWN;
+    return stateToDbusValue.state(propertyValue).value_or(PLDM_SENSOR_UNKNOWN);
 }
 
-/** @brief Function to get the state sensor readings requested by pldm requester
+/** @brief Function to find the state sensor PDR of a sensor and check the
+ *         rearm count of the request against it
  *
- *  @tparam[in] DBusInterface - DBus interface type
  *  @tparam[in] Handler - pldm::responder::platform::Handler
- *  @param[in] dBusIntf - The interface object of DBusInterface
  *  @param[in] handler - The interface object of
  *             pldm::responder::platform::Handler
  *  @param[in] sensorId - Sensor ID sent by the requester to act on
- *  @param[in] sensorRearmCnt - Each bit location in this field corresponds to a
- *              particular sensor within the state sensor
+ *  @param[in,out] sensorRearmCnt - rearm count of the request, set to the
+ *                 composite sensor count when 0
  *  @param[out] compSensorCnt - composite sensor count
- *  @param[out] stateField - The state field data for each of the states,
- *              equal to composite sensor count in number
- *  @return - Success or failure in setting the states. Returns failure in
- * terms of PLDM completion codes if atleast one state fails to be set
+ *  @return - PLDM_SUCCESS or the PLDM completion code of the failure
  */
-template <class DBusInterface, class Handler>
-int getStateSensorReadingsHandler(
-    const DBusInterface& dBusIntf, Handler& handler, uint16_t sensorId,
-    uint8_t sensorRearmCnt, uint8_t& compSensorCnt,
-    std::vector<get_sensor_state_field>& stateField,
-    const stateSensorCacheMaps& sensorCache)
+template <class Handler>
+int findStateSensor(Handler& handler, uint16_t sensorId,
+                    uint8_t& sensorRearmCnt, uint8_t& compSensorCnt)
 {
     using namespace pldm::responder::pdr;
-    using namespace pldm::utils;
 
     pldm_state_sensor_pdr* pdr = nullptr;
 
@@ -143,7 +97,6 @@ int getStateSensorReadingsHandler(
         if (sensorRearmCnt == 0)
         {
             sensorRearmCnt = compSensorCnt;
-            stateField.resize(sensorRearmCnt);
         }
 
         break;
@@ -154,63 +107,202 @@ int getStateSensorReadingsHandler(
         return PLDM_PLATFORM_INVALID_SENSOR_ID;
     }
 
-    int rc = PLDM_SUCCESS;
-    try
+    return PLDM_SUCCESS;
+}
+
+/** @brief Function to fill the state fields of the response from the present
+ *         states of the sensor, the sensor cache gives the previous states
+ *
+ *  @tparam[in] Handler - pldm::responder::platform::Handler
+ *  @param[in] handler - The interface object of
+ *             pldm::responder::platform::Handler
+ *  @param[in] sensorId - Sensor ID sent by the requester to act on
+ *  @param[in] sensorEvents - present state of each rearmed sensor
+ *  @param[in] sensorCache - previous states of the sensors
+ *  @param[out] stateField - The state field data for each of the states
+ *
+ *  @throw std::out_of_range when there are more states than the cache holds
+ */
+template <class Handler>
+void fillStateFields(Handler& handler, uint16_t sensorId,
+                     const std::vector<uint8_t>& sensorEvents,
+                     const stateSensorCacheMaps& sensorCache,
+                     std::vector<get_sensor_state_field>& stateField)
+{
+    pldm::responder::pdr_utils::EventStates sensorCacheforSensor{};
+    if (sensorCache.contains(sensorId))
     {
-        const auto& [dbusMappings, dbusValMaps] = handler.getDbusObjMaps(
-            sensorId, pldm::responder::pdr_utils::TypeId::PLDM_SENSOR_ID);
+        sensorCacheforSensor = sensorCache.at(sensorId);
+    }
+
+    stateField.clear();
+    for (std::size_t i{0}; i < sensorEvents.size(); i++)
+    {
+        uint8_t sensorEvent = sensorEvents[i];
+        uint8_t previousState = PLDM_SENSOR_UNKNOWN;
+
+        // if sensor cache is empty, then its the first
+        // get_state_sensor_reading on this sensor, set the previous state
+        // as the current state
 
-        pldm::responder::pdr_utils::EventStates sensorCacheforSensor{};
-        if (sensorCache.contains(sensorId))
+        if (sensorCacheforSensor.at(i) == PLDM_SENSOR_UNKNOWN)
         {
-            sensorCacheforSensor = sensorCache.at(sensorId);
+            previousState = sensorEvent;
+            handler.updateSensorCache(sensorId, i, previousState);
         }
-
-        stateField.clear();
-        for (std::size_t i{0}; i < sensorRearmCnt; i++)
+        else
         {
-            auto& dbusMapping = dbusMappings[i];
-
-            uint8_t sensorEvent = getStateSensorEventState<DBusInterface>(
-                dBusIntf, dbusValMaps[i], dbusMapping);
+            // sensor cache is not empty, so get the previous state from
+            // the sensor cache
+            previousState = sensorCacheforSensor[i];
+        }
 
-            uint8_t previousState = PLDM_SENSOR_UNKNOWN;
+        uint8_t opState = PLDM_SENSOR_ENABLED;
+        if (sensorEvent == PLDM_SENSOR_UNKNOWN)
+        {
+            opState = PLDM_SENSOR_UNAVAILABLE;
+        }
 
-            // if sensor cache is empty, then its the first
-            // get_state_sensor_reading on this sensor, set the previous state
-            // as the current state
+        stateField.push_back(
+            {opState, sensorEvent, previousState, sensorEvent});
+    }
+}
 
-            if (sensorCacheforSensor.at(i) == PLDM_SENSOR_UNKNOWN)
-            {
-                previousState = sensorEvent;
-                handler.updateSensorCache(sensorId, i, previousState);
-            }
-            else
-            {
-                // sensor cache is not empty, so get the previous state from
-                // the sensor cache
-                previousState = sensorCacheforSensor[i];
-            }
+/** @brief Callback of the asynchronous state sensor readings
+ *
+ *  @param[in] rc - PLDM completion code
+ *  @param[in] compSensorCnt - composite sensor count
+ *  @param[in] stateField - The state field data for each of the states
+ */
+using StateSensorReadingsCallback =
+    std::function<void(int rc, uint8_t compSensorCnt,
+                       std::vector<get_sensor_state_field>&& stateField)>;
 
-            uint8_t opState = PLDM_SENSOR_ENABLED;
-            if (sensorEvent == PLDM_SENSOR_UNKNOWN)
-            {
-                opState = PLDM_SENSOR_UNAVAILABLE;
-            }
+/** @brief Function to get the state sensor readings without blocking on
+ *         D-Bus, the properties of the composite sensor are read together
+ *         and the callback runs once all of them are known
+ *
+ *  @tparam[in] DBusInterface - DBus interface type
+ *  @tparam[in] Handler - pldm::responder::platform::Handler
+ *  @param[in] dBusIntf - The interface object of DBusInterface
+ *  @param[in] handler - The interface object of
+ *             pldm::responder::platform::Handler
+ *  @param[in] sensorId - Sensor ID sent by the requester to act on
+ *  @param[in] sensorRearmCnt - Each bit location in this field corresponds to a
+ *              particular sensor within the state sensor
+ *  @param[in] sensorCache - previous states of the sensors, it must outlive
+ *             the request
+ *  @param[in] callback - handles the readings
+ */
+template <class DBusInterface, class Handler>
+void getStateSensorReadingsAsync(const DBusInterface& dBusIntf,
+                                 Handler& handler, uint16_t sensorId,
+                                 uint8_t sensorRearmCnt,
+                                 const stateSensorCacheMaps& sensorCache,
+                                 StateSensorReadingsCallback callback)
+{
+    uint8_t compSensorCnt{};
+    int rc = findStateSensor(handler, sensorId, sensorRearmCnt, compSensorCnt);
+    if (rc != PLDM_SUCCESS)
+    {
+        callback(rc, compSensorCnt, {});
+        return;
+    }
 
-            stateField.push_back(
-                {opState, sensorEvent, previousState, sensorEvent});
+    struct Readings
+    {
+        pldm::responder::pdr_utils::DbusMappings dbusMappings;
+        pldm::responder::pdr_utils::DbusValMaps dbusValMaps;
+        std::vector<uint8_t> sensorEvents;
+        size_t remaining;
+        uint8_t compSensorCnt;
+        StateSensorReadingsCallback callback;
+    };
+    auto readings = std::make_shared<Readings>();
+    try
+    {
+        const auto& [dbusMappings, dbusValMaps] = handler.getDbusObjMaps(
+            sensorId, pldm::responder::pdr_utils::TypeId::PLDM_SENSOR_ID);
+        if (dbusMappings.size() < sensorRearmCnt ||
+            dbusValMaps.size() < sensorRearmCnt)
+        {
+            throw std::out_of_range("Missing D-Bus mappings of the sensor");
         }
+        // The maps are copied, the PDRs may be regenerated while the reads
+        // are in flight
+        readings->dbusMappings.assign(dbusMappings.begin(),
+                                      dbusMappings.begin() + sensorRearmCnt);
+        readings->dbusValMaps.assign(dbusValMaps.begin(),
+                                     dbusValMaps.begin() + sensorRearmCnt);
     }
     catch (const std::out_of_range& e)
     {
         error(
             "the sensorId does not exist. sensor id: {SENSOR_ID}, {ERR_EXCEP}",
             "SENSOR_ID", sensorId, "ERR_EXCEP", e.what());
-        rc = PLDM_ERROR;
+        callback(PLDM_ERROR, compSensorCnt, {});
+        return;
+    }
+    readings->sensorEvents.assign(sensorRearmCnt, PLDM_SENSOR_UNKNOWN);
+    readings->remaining = sensorRearmCnt;
+    readings->compSensorCnt = compSensorCnt;
+    readings->callback = std::move(callback);
+
+    auto finish = [&handler, &sensorCache, sensorId, readings]() {
+        std::vector<get_sensor_state_field> stateField;
+        try
+        {
+            fillStateFields(handler, sensorId, readings->sensorEvents,
+                            sensorCache, stateField);
+        }
+        catch (const std::out_of_range& e)
+        {
+            error(
+                "the sensorId does not exist. sensor id: {SENSOR_ID}, {ERR_EXCEP}",
+                "SENSOR_ID", sensorId, "ERR_EXCEP", e.what());
+            readings->callback(PLDM_ERROR, readings->compSensorCnt, {});
+            return;
+        }
+        readings->callback(PLDM_SUCCESS, readings->compSensorCnt,
+                           std::move(stateField));
+    };
+
+    if (sensorRearmCnt == 0)
+    {
+        finish();
+        return;
     }
 
-    return rc;
+    using pldm::utils::PropertyValue;
+    for (std::size_t i{0}; i < sensorRearmCnt; i++)
+    {
+        dBusIntf.getDbusPropertyVariantAsync(
+            readings->dbusMappings[i],
+            [readings, finish, i](std::optional<PropertyValue> value) {
+            const auto& dbusMapping = readings->dbusMappings[i];
+            try
+            {
+                if (!value)
+                {
+                    throw std::runtime_error("D-Bus property read failed");
+                }
+                readings->sensorEvents[i] =
+                    stateSensorEventState(readings->dbusValMaps[i], *value);
+            }
+            catch (const std::exception& e)
+            {
+                error(
+                    "Get StateSensor EventState from dbus Error, interface : {INTF} ,exception : {ERR_EXCEP}",
+                    "INTF", dbusMapping.objectPath.c_str(), "ERR_EXCEP",
+                    e.what());
+            }
+
+            if (--readings->remaining == 0)
+            {
+                finish();
+            }
+        });
+    }
 }
 
 } // namespace platform_state_sensor
@@ -0,0 +1,273 @@
+#include "state_value_table.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <type_traits>
+
+namespace pldm
+{
+namespace responder
+{
+namespace pdr_utils
+{
+
+namespace
+{
+
+/** @brief Range of the integer values kept in a dense array */
+constexpr uint64_t denseRange = 256;
+
+/** @brief Seeds tried for each size of the string hash table */
+constexpr uint64_t hashSeeds = 64;
+
+/** @brief Largest string hash table, sorted strings are used beyond */
+constexpr size_t maxStringSlots = 1 << 16;
+
+/** @brief Integer value of a property, std::nullopt for the other types */
+std::optional<int64_t> toInteger(const pldm::utils::PropertyValue& value)
+{
+    return std::visit(
+        [](const auto& value) -> std::optional<int64_t> {
+        using T = std::decay_t<decltype(value)>;
+        if constexpr (std::is_integral_v<T>)
+        {
+            return static_cast<int64_t>(value);
+        }
+        return std::nullopt;
+    },
+        value);
+}
+
+/** @brief Sort the keys by value and keep the lowest state of each value,
+ *         the keys are in state order
+ */
+template <typename Key>
+void sortKeys(std::vector<std::pair<Key, uint8_t>>& keys)
+{
+    std::stable_sort(keys.begin(), keys.end(),
+                     [](const auto& a, const auto& b) {
+        return a.first < b.first;
+    });
+    keys.erase(std::unique(keys.begin(), keys.end(),
+                           [](const auto& a, const auto& b) {
+        return a.first == b.first;
+    }),
+               keys.end());
+}
+
+} // namespace
+
+StateValueTable::StateValueTable(
+    const std::map<State, PropertyValue>& stateToValue)
+{
+    if (stateToValue.empty())
+    {
+        return;
+    }
+
+    values.reserve(stateToValue.size());
+    states.reserve(stateToValue.size());
+    stateSlots.assign(stateToValue.rbegin()->first + 1, 0);
+    valueType = stateToValue.begin()->second.index();
+    for (const auto& [state, value] : stateToValue)
+    {
+        if (value.index() != valueType)
+        {
+            valueType = std::variant_npos;
+        }
+        values.push_back(value);
+        states.push_back(state);
+        stateSlots[state] = values.size();
+    }
+    if (valueType == std::variant_npos)
+    {
+        // Values of several types are compared one by one
+        return;
+    }
+
+    if (std::holds_alternative<std::string>(values.front()))
+    {
+        std::vector<std::pair<std::string, State>> keys;
+        for (size_t index = 0; index < values.size(); ++index)
+        {
+            const auto& value = std::get<std::string>(values[index]);
+            if (value.find("||") == std::string::npos)
+            {
+                keys.emplace_back(value, states[index]);
+                continue;
+            }
+            for (auto& alternative : pldm::utils::split(value, "||", " "))
+            {
+                keys.emplace_back(std::move(alternative), states[index]);
+            }
+        }
+        buildStrings(std::move(keys));
+    }
+    else if (toInteger(values.front()))
+    {
+        std::vector<std::pair<int64_t, State>> keys;
+        for (size_t index = 0; index < values.size(); ++index)
+        {
+            keys.emplace_back(*toInteger(values[index]), states[index]);
+        }
+        buildIntegers(std::move(keys));
+    }
+}
+
+std::optional<StateValueTable::State>
+    StateValueTable::state(const PropertyValue& value) const
+{
+    if (valueType != std::variant_npos && value.index() != valueType)
+    {
+        return std::nullopt;
+    }
+
+    switch (lookup)
+    {
+        case Lookup::DenseIntegers:
+        {
+            auto offset = static_cast<uint64_t>(*toInteger(value)) -
+                          static_cast<uint64_t>(integerBase);
+            if (offset >= integerSlots.size() ||
+                integerSlots[offset] == noState)
+            {
+                return std::nullopt;
+            }
+            return static_cast<State>(integerSlots[offset]);
+        }
+        case Lookup::SortedIntegers:
+        {
+            auto key = *toInteger(value);
+            auto found = std::lower_bound(
+                sortedIntegers.begin(), sortedIntegers.end(), key,
+                [](const auto& entry, int64_t key) {
+                return entry.first < key;
+            });
+            if (found == sortedIntegers.end() || found->first != key)
+            {
+                return std::nullopt;
+            }
+            return found->second;
+        }
+        case Lookup::HashedStrings:
+        {
+            const auto& key = std::get<std::string>(value);
+            auto slot =
+                stringSlots[hash(key, stringSeed) & (stringSlots.size() - 1)];
+            if (slot == noState || strings[slot].first != key)
+            {
+                return std::nullopt;
+            }
+            return strings[slot].second;
+        }
+        case Lookup::SortedStrings:
+        {
+            const auto& key = std::get<std::string>(value);
+            auto found = std::lower_bound(
+                strings.begin(), strings.end(), key,
+                [](const auto& entry, const std::string& key) {
+                return entry.first < key;
+            });
+            if (found == strings.end() || found->first != key)
+            {
+                return std::nullopt;
+            }
+            return found->second;
+        }
+        case Lookup::Scan:
+            break;
+    }
+
+    for (size_t index = 0; index < values.size(); ++index)
+    {
+        if (values[index] == value)
+        {
+            return states[index];
+        }
+    }
+    return std::nullopt;
+}
+
+uint64_t StateValueTable::hash(std::string_view key, uint64_t seed)
+{
+    // FNV-1a, seeded, with the 64 bit finalizer of MurmurHash3 so that the
+    // low bits depend on the whole key
+    uint64_t hash = 0xcbf29ce484222325ULL ^ (seed * 0x9e3779b97f4a7c15ULL);
+    for (auto byte : key)
+    {
+        hash ^= static_cast<uint8_t>(byte);
+        hash *= 0x100000001b3ULL;
+    }
+    hash ^= hash >> 33;
+    hash *= 0xff51afd7ed558ccdULL;
+    hash ^= hash >> 33;
+    return hash;
+}
+
+void StateValueTable::buildIntegers(
+    std::vector<std::pair<int64_t, State>>&& keys)
+{
+    sortKeys(keys);
+    integerBase = keys.front().first;
+    auto range = static_cast<uint64_t>(keys.back().first) -
+                 static_cast<uint64_t>(integerBase);
+    if (range < denseRange)
+    {
+        integerSlots.assign(range + 1, noState);
+        for (const auto& [key, state] : keys)
+        {
+            integerSlots[static_cast<uint64_t>(key) -
+                         static_cast<uint64_t>(integerBase)] = state;
+        }
+        lookup = Lookup::DenseIntegers;
+        return;
+    }
+    sortedIntegers = std::move(keys);
+    lookup = Lookup::SortedIntegers;
+}
+
+void StateValueTable::buildStrings(
+    std::vector<std::pair<std::string, State>>&& keys)
+{
+    sortKeys(keys);
+    strings = std::move(keys);
+    if (strings.empty())
+    {
+        return;
+    }
+
+    for (auto size = std::bit_ceil(2 * strings.size()); size <= maxStringSlots;
+         size *= 2)
+    {
+        for (uint64_t seed = 0; seed < hashSeeds; ++seed)
+        {
+            if (hashStrings(size, seed))
+            {
+                lookup = Lookup::HashedStrings;
+                return;
+            }
+        }
+    }
+    stringSlots.clear();
+    lookup = Lookup::SortedStrings;
+}
+
+bool StateValueTable::hashStrings(size_t size, uint64_t seed)
+{
+    stringSlots.assign(size, noState);
+    for (size_t index = 0; index < strings.size(); ++index)
+    {
+        auto& slot = stringSlots[hash(strings[index].first, seed) & (size - 1)];
+        if (slot != noState)
+        {
+            return false;
+        }
+        slot = index;
+    }
+    stringSeed = seed;
+    return true;
+}
+
+} // namespace pdr_utils
+} // namespace responder
+} // namespace pldm
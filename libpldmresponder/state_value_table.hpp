@@ -0,0 +1,134 @@
+#pragma once
+
+#include "common/utils.hpp"
+
+#include <stdint.h>
+
+#include <map>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <variant>
+#include <vector>
+
+namespace pldm
+{
+namespace responder
+{
+namespace pdr_utils
+{
+
+/** @class StateValueTable
+ *
+ *  @brief Translation between the states of a state set and the values of
+ *         the D-Bus property they map to, compiled once from the mapping of
+ *         the PDR JSON.
+ *
+ *         A state is found by value with a single probe of a table of the
+ *         value type: a dense array indexed by the value for the integers, a
+ *         perfect hash for the strings, whose "||" joined alternatives are
+ *         split when the table is built. A value is found by state in a dense
+ *         array indexed by the state. When a value maps to several states,
+ *         the lowest state is found, as with the ordered map.
+ */
+class StateValueTable
+{
+  public:
+    using State = uint8_t;
+    using PropertyValue = pldm::utils::PropertyValue;
+
+    StateValueTable() = default;
+
+    /** @brief Constructor
+     *
+     *  @param[in] stateToValue - D-Bus property value by state, the values
+     *                            are of one type
+     */
+    explicit StateValueTable(
+        const std::map<State, PropertyValue>& stateToValue);
+
+    /** @brief D-Bus property value of a state
+     *
+     *  @param[in] state - state of the state set
+     *
+     *  @return the value, nullptr if the state is not mapped
+     */
+    const PropertyValue* value(State state) const
+    {
+        if (state >= stateSlots.size() || !stateSlots[state])
+        {
+            return nullptr;
+        }
+        return &values[stateSlots[state] - 1];
+    }
+
+    /** @brief State of a D-Bus property value
+     *
+     *  @param[in] value - D-Bus property value
+     *
+     *  @return the state, std::nullopt if no state maps to the value or the
+     *          value is of another type
+     */
+    std::optional<State> state(const PropertyValue& value) const;
+
+    /** @brief Number of mapped states */
+    size_t size() const
+    {
+        return values.size();
+    }
+
+    bool empty() const
+    {
+        return values.empty();
+    }
+
+  private:
+    /** @brief How a state is found by value */
+    enum class Lookup : uint8_t
+    {
+        Scan,           //!< compare with each value
+        DenseIntegers,  //!< integer values in a short range
+        SortedIntegers, //!< other integer values
+        HashedStrings,  //!< strings
+        SortedStrings,  //!< strings without a perfect hash
+    };
+
+    /** @brief Slot of a table that does not hold a state */
+    static constexpr uint16_t noState = UINT16_MAX;
+
+    static uint64_t hash(std::string_view key, uint64_t seed);
+
+    void buildIntegers(std::vector<std::pair<int64_t, State>>&& keys);
+    void buildStrings(std::vector<std::pair<std::string, State>>&& keys);
+    bool hashStrings(size_t size, uint64_t seed);
+
+    /** @brief Values in state order, and their state */
+    std::vector<PropertyValue> values;
+    std::vector<State> states;
+
+    /** @brief Index + 1 of the value of each state, 0 if not mapped */
+    std::vector<uint16_t> stateSlots;
+
+    /** @brief Index of the type of the values in PropertyValue */
+    size_t valueType = std::variant_npos;
+    Lookup lookup = Lookup::Scan;
+
+    /** @brief State by integer value, from the lowest value */
+    int64_t integerBase = 0;
+    std::vector<uint16_t> integerSlots;
+
+    /** @brief Integer values and their state, by value */
+    std::vector<std::pair<int64_t, State>> sortedIntegers;
+
+    /** @brief String values, alternatives split, and their state, by value */
+    std::vector<std::pair<std::string, State>> strings;
+
+    /** @brief Index in strings at the hash slot of each string */
+    std::vector<uint16_t> stringSlots;
+    uint64_t stringSeed = 0;
+};
+
+} // namespace pdr_utils
+} // namespace responder
+} // namespace pldm
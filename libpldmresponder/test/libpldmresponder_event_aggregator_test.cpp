@@ -0,0 +1,105 @@
+#include "libpldmresponder/event_aggregator.hpp"
+
+#include <sdbusplus/timer.hpp>
+#include <sdeventplus/event.hpp>
+
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using namespace pldm::responder::events;
+using namespace std::chrono_literals;
+
+TEST(StateSensorEventAggregator, noWindow)
+{
+    auto event = sdeventplus::Event::get_new();
+    std::vector<StateSensorEvent> signals;
+    std::vector<StateSensorEvent> actions;
+    StateSensorEventAggregator aggregator(
+        event, 0ms, 16,
+        [&signals](const StateSensorEvent& e) { signals.push_back(e); },
+        [&actions](const StateSensorEvent& e) { actions.push_back(e); });
+
+    EXPECT_TRUE(aggregator.add({1, 10, 0, 2, 1}));
+    EXPECT_TRUE(aggregator.add({1, 10, 0, 1, 2}));
+
+    ASSERT_EQ(signals.size(), 2);
+    ASSERT_EQ(actions.size(), 2);
+    EXPECT_EQ(actions[1], (StateSensorEvent{1, 10, 0, 1, 2}));
+    EXPECT_EQ(aggregator.getStats().coalesced, 0);
+    EXPECT_EQ(aggregator.pending(), 0);
+}
+
+TEST(StateSensorEventAggregator, coalesceAndDrop)
+{
+    auto event = sdeventplus::Event::get_new();
+    std::vector<StateSensorEvent> signals;
+    std::vector<StateSensorEvent> actions;
+    StateSensorEventAggregator aggregator(
+        event, 20ms, 2,
+        [&signals](const StateSensorEvent& e) { signals.push_back(e); },
+        [&actions, &event](const StateSensorEvent& e) {
+        actions.push_back(e);
+        if (actions.size() == 2)
+        {
+            event.exit(0);
+        }
+    });
+
+    // Flaps of sensor 10 offset 0 collapse to the last state
+    EXPECT_TRUE(aggregator.add({1, 10, 0, 2, 1}));
+    EXPECT_TRUE(aggregator.add({1, 10, 0, 1, 2}));
+    EXPECT_TRUE(aggregator.add({1, 10, 0, 3, 1}));
+    // Another offset of the same sensor is a separate event
+    EXPECT_TRUE(aggregator.add({1, 10, 1, 4, 5}));
+    // Two events are already pending
+    EXPECT_FALSE(aggregator.add({1, 11, 0, 1, 0}));
+    EXPECT_TRUE(signals.empty());
+
+    phosphor::Timer timeout(event.get(), [&event] { event.exit(0); });
+    timeout.start(std::chrono::seconds(5));
+    event.loop();
+
+    ASSERT_EQ(signals.size(), 2);
+    ASSERT_EQ(actions.size(), 2);
+    EXPECT_EQ(actions[0], (StateSensorEvent{1, 10, 0, 3, 1}));
+    EXPECT_EQ(actions[1], (StateSensorEvent{1, 10, 1, 4, 5}));
+
+    const auto& stats = aggregator.getStats();
+    EXPECT_EQ(stats.received, 5);
+    EXPECT_EQ(stats.coalesced, 2);
+    EXPECT_EQ(stats.dropped, 1);
+    EXPECT_EQ(stats.dispatched, 2);
+    EXPECT_EQ(aggregator.pending(), 0);
+}
+
+TEST(StateSensorEventAggregator, boundedActionsPerIteration)
+{
+    auto event = sdeventplus::Event::get_new();
+    size_t signals = 0;
+    size_t actions = 0;
+    constexpr size_t sensors =
+        StateSensorEventAggregator::actionsPerIteration * 2 + 1;
+    StateSensorEventAggregator aggregator(
+        event, 1ms, sensors, [&signals](const StateSensorEvent&) { signals++; },
+        [&actions](const StateSensorEvent&) { actions++; });
+
+    for (uint16_t sensorId = 0; sensorId < sensors; ++sensorId)
+    {
+        EXPECT_TRUE(aggregator.add({1, sensorId, 0, 1, 0}));
+    }
+    aggregator.flush();
+
+    // All the signals go out together, the actions wait for the event loop
+    EXPECT_EQ(signals, sensors);
+    EXPECT_EQ(actions, 0);
+
+    event.run(std::chrono::microseconds(0));
+    EXPECT_EQ(actions, StateSensorEventAggregator::actionsPerIteration);
+
+    while (aggregator.pending())
+    {
+        event.run(std::chrono::microseconds(0));
+    }
+    EXPECT_EQ(actions, sensors);
+}
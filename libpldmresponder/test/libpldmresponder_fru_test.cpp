@@ -1,4 +1,9 @@
 #include "libpldmresponder/fru_parser.hpp"
+#include "libpldmresponder/pdr_utils.hpp"
+
+#include <algorithm>
+#include <string>
+#include <vector>
 
 #include <gtest/gtest.h>
 TEST(FruParser, allScenarios)
@@ -69,3 +74,59 @@ TEST(FruParser, allScenarios)
         parser.getRecordInfo("xyz.openbmc_project.Inventory.Item.DIMM"),
         std::exception);
 }
+
+TEST(FruRecordStream, Parts)
+{
+    using namespace pldm::responder::pdr_utils;
+
+    // RSI 1: general record, version field "1.0" and serial number "AB12"
+    // RSI 2: OEM record, location code field "U78DA-P0"
+    // RSI 3: record without fields
+    std::vector<uint8_t> table{0x01, 0x00, 0x01, 0x02, 0x01, 0x0a, 0x03,
+                               '1',  '.',  '0',  0x04, 0x04, 'A',  'B',
+                               '1',  '2',  0x02, 0x00, 0xfe, 0x01, 0x01,
+                               0xfe, 0x08, 'U',  '7',  '8',  'D',  'A',
+                               '-',  'P',  '0',  0x03, 0x00, 0x01, 0x00,
+                               0x01};
+    std::vector<std::string> expected{"1:1:10=1.0,4=AB12,",
+                                      "2:254:254=U78DA-P0,", "3:1:"};
+
+    // Every split of the table in parts gives the same records
+    for (size_t partSize = 1; partSize <= table.size(); ++partSize)
+    {
+        std::vector<std::string> records;
+        FruRecordStream stream([&records](const FruRecordView& record) {
+            auto decoded = std::to_string(record.rsi) + ":" +
+                           std::to_string(record.type) + ":";
+            record.forEachField([&decoded](const FruFieldView& field) {
+                decoded += std::to_string(field.type) + "=" +
+                           std::string(field.str()) + ",";
+            });
+            records.push_back(decoded);
+        });
+        for (size_t offset = 0; offset < table.size(); offset += partSize)
+        {
+            stream.feed(std::span<const uint8_t>(table).subspan(
+                offset, std::min(partSize, table.size() - offset)));
+        }
+        EXPECT_TRUE(stream.complete());
+        EXPECT_EQ(stream.records(), 3);
+        EXPECT_EQ(records, expected) << "part size " << partSize;
+    }
+}
+
+TEST(FruRecordStream, CutTable)
+{
+    using namespace pldm::responder::pdr_utils;
+
+    std::vector<uint8_t> table{0x01, 0x00, 0x01, 0x01, 0x01,
+                               0x0a, 0x03, '1',  '.',  '0',
+                               0x02, 0x00, 0x01, 0x01, 0x01,
+                               0x0a, 0x03, '2'};
+    size_t records = 0;
+    FruRecordStream stream([&records](const FruRecordView&) { ++records; });
+    stream.feed(table);
+    EXPECT_EQ(records, 1);
+    EXPECT_EQ(stream.records(), 1);
+    EXPECT_FALSE(stream.complete());
+}
@@ -1,17 +1,21 @@
 #include "common/test/mocked_utils.hpp"
 #include "common/utils.hpp"
 #include "host-bmc/dbus_to_event_handler.hpp"
+#include "host-bmc/host_pdr_handler.hpp"
 #include "libpldmresponder/event_parser.hpp"
 #include "libpldmresponder/pdr.hpp"
+#include "libpldmresponder/pdr_arena.hpp"
 #include "libpldmresponder/pdr_utils.hpp"
 #include "libpldmresponder/platform.hpp"
 #include "libpldmresponder/platform_numeric_effecter.hpp"
 #include "libpldmresponder/platform_state_effecter.hpp"
 #include "libpldmresponder/platform_state_sensor.hpp"
+#include "pldmd/dbus_impl_requester.hpp"
 
 #include <sdbusplus/test/sdbus_mock.hpp>
 #include <sdeventplus/event.hpp>
 
+#include <cstring>
 #include <iostream>
 
 using namespace pldm::pdr;
@@ -317,7 +321,7 @@ TEST(setStateEffecterStatesHandler, testBadRequest)
     pldm_pdr_destroy(outPDRRepo);
 }
 
-TEST(setNumericEffecterValueHandler, testGoodRequest)
+TEST(setNumericEffecterValueAsync, testGoodRequest)
 {
     MockdBusHandler mockedUtils;
     EXPECT_CALL(mockedUtils, getService(StrEq("/foo/bar"), _))
@@ -350,17 +354,19 @@ TEST(setNumericEffecterValueHandler, testGoodRequest)
     EXPECT_CALL(mockedUtils, setDbusProperty(dbusMapping, propertyValue))
         .Times(1);
 
-    auto rc = platform_numeric_effecter::setNumericEffecterValueHandler<
-        MockdBusHandler, Handler>(
+    int rc = -1;
+    platform_numeric_effecter::setNumericEffecterValueAsync<MockdBusHandler,
+                                                            Handler>(
         mockedUtils, handler, effecterId, PLDM_EFFECTER_DATA_SIZE_UINT32,
-        reinterpret_cast<uint8_t*>(&effecterValue), 4);
+        reinterpret_cast<uint8_t*>(&effecterValue), 4,
+        [&rc](int result) { rc = result; });
     ASSERT_EQ(rc, 0);
 
     pldm_pdr_destroy(inPDRRepo);
     pldm_pdr_destroy(numericEffecterPdrRepo);
 }
 
-TEST(setNumericEffecterValueHandler, testBadRequest)
+TEST(setNumericEffecterValueAsync, testBadRequest)
 {
     MockdBusHandler mockedUtils;
     EXPECT_CALL(mockedUtils, getService(StrEq("/foo/bar"), _))
@@ -386,10 +392,12 @@ TEST(setNumericEffecterValueHandler, testBadRequest)
 
     uint16_t effecterId = 3;
     uint64_t effecterValue = 9876543210;
-    auto rc = platform_numeric_effecter::setNumericEffecterValueHandler<
-        MockdBusHandler, Handler>(
+    int rc = -1;
+    platform_numeric_effecter::setNumericEffecterValueAsync<MockdBusHandler,
+                                                            Handler>(
         mockedUtils, handler, effecterId, PLDM_EFFECTER_DATA_SIZE_SINT32,
-        reinterpret_cast<uint8_t*>(&effecterValue), 3);
+        reinterpret_cast<uint8_t*>(&effecterValue), 3,
+        [&rc](int result) { rc = result; });
     ASSERT_EQ(rc, PLDM_ERROR_INVALID_DATA);
 
     pldm_pdr_destroy(inPDRRepo);
@@ -531,10 +539,29 @@ TEST(StateSensorHandler, allScenarios)
         ASSERT_EQ(value1 == propValue1, true);
     }
 
+    // Event Entry 4, configured without a container id
+    {
+        for (uint16_t containerId : {0, 1, 7})
+        {
+            StateSensorEntry entry{containerId, 68, 1, 0, false, 1};
+            const auto eventInfo = handler.findEventInfo(entry);
+            ASSERT_NE(eventInfo, nullptr);
+            DBusMapping mapping{"/xyz/abc/jkl",
+                                "xyz.openbmc_project.example4.value", "value4",
+                                "bool"};
+            ASSERT_EQ(mapping == std::get<0>(*eventInfo), true);
+        }
+    }
+
     // Invalid Entry
     {
         StateSensorEntry entry{0, 0, 0, 0, false, 1};
         ASSERT_THROW(handler.getEventInfo(entry), std::out_of_range);
+        ASSERT_EQ(handler.findEventInfo(entry), nullptr);
+
+        // A different container id than the configured one
+        StateSensorEntry otherContainer{3, 64, 1, 0, false, 1};
+        ASSERT_EQ(handler.findEventInfo(otherContainer), nullptr);
     }
 }
 
@@ -579,7 +606,7 @@ TEST(TerminusLocatorPDR, BMCTerminusLocatorPDR)
     pldm_pdr_destroy(outPDRRepo);
 }
 
-TEST(getStateSensorReadingsHandler, testGoodRequest)
+TEST(getStateSensorReadingsAsync, testGoodRequest)
 {
     MockdBusHandler mockedUtils;
     EXPECT_CALL(mockedUtils, getService(StrEq("/foo/bar"), _))
@@ -604,6 +631,7 @@ TEST(getStateSensorReadingsHandler, testGoodRequest)
     std::vector<get_sensor_state_field> stateField;
     uint8_t compSensorCnt{};
     uint8_t sensorRearmCnt = 1;
+    int rc = -1;
 
     MockdBusHandler handlerObj;
     EXPECT_CALL(handlerObj,
@@ -614,11 +642,18 @@ TEST(getStateSensorReadingsHandler, testGoodRequest)
     EventStates cache = {PLDM_SENSOR_NORMAL};
     pldm::stateSensorCacheMaps sensorCache;
     sensorCache.emplace(0x1, cache);
-    auto rc = platform_state_sensor::getStateSensorReadingsHandler<
-        MockdBusHandler, Handler>(handlerObj, handler, 0x1, sensorRearmCnt,
-                                  compSensorCnt, stateField, sensorCache);
+    platform_state_sensor::getStateSensorReadingsAsync<MockdBusHandler,
+                                                       Handler>(
+        handlerObj, handler, 0x1, sensorRearmCnt, sensorCache,
+        [&](int result, uint8_t count,
+            std::vector<get_sensor_state_field>&& fields) {
+        rc = result;
+        compSensorCnt = count;
+        stateField = std::move(fields);
+    });
     ASSERT_EQ(rc, 0);
     ASSERT_EQ(compSensorCnt, 1);
+    ASSERT_EQ(stateField.size(), 1);
     ASSERT_EQ(stateField[0].sensor_op_state, PLDM_SENSOR_UNAVAILABLE);
     ASSERT_EQ(stateField[0].present_state, PLDM_SENSOR_UNKNOWN);
     ASSERT_EQ(stateField[0].previous_state, PLDM_SENSOR_NORMAL);
@@ -628,7 +663,7 @@ TEST(getStateSensorReadingsHandler, testGoodRequest)
     pldm_pdr_destroy(outPDRRepo);
 }
 
-TEST(getStateSensorReadingsHandler, testBadRequest)
+TEST(getStateSensorReadingsAsync, testBadRequest)
 {
     MockdBusHandler mockedUtils;
     EXPECT_CALL(mockedUtils, getService(StrEq("/foo/bar"), _))
@@ -651,18 +686,274 @@ TEST(getStateSensorReadingsHandler, testBadRequest)
     EXPECT_EQ(pdr->hdr.type, PLDM_STATE_SENSOR_PDR);
 
     std::vector<get_sensor_state_field> stateField;
-    uint8_t compSensorCnt{};
     uint8_t sensorRearmCnt = 3;
+    int rc = -1;
 
     MockdBusHandler handlerObj;
     EventStates cache = {PLDM_SENSOR_NORMAL};
     pldm::stateSensorCacheMaps sensorCache;
     sensorCache.emplace(0x1, cache);
-    auto rc = platform_state_sensor::getStateSensorReadingsHandler<
-        MockdBusHandler, Handler>(handlerObj, handler, 0x1, sensorRearmCnt,
-                                  compSensorCnt, stateField, sensorCache);
+    // The rearm count is checked before any D-Bus read
+    platform_state_sensor::getStateSensorReadingsAsync<MockdBusHandler,
+                                                       Handler>(
+        handlerObj, handler, 0x1, sensorRearmCnt, sensorCache,
+        [&](int result, uint8_t /*compSensorCnt*/,
+            std::vector<get_sensor_state_field>&& fields) {
+        rc = result;
+        stateField = std::move(fields);
+    });
     ASSERT_EQ(rc, PLDM_PLATFORM_REARM_UNAVAILABLE_IN_PRESENT_STATE);
+    EXPECT_TRUE(stateField.empty());
 
     pldm_pdr_destroy(inPDRRepo);
     pldm_pdr_destroy(outPDRRepo);
 }
+
+TEST(PdrBatch, commitInOrder)
+{
+    auto pdrRepo = pldm_pdr_init();
+    Repo repo(pdrRepo);
+
+    PdrBatch batch;
+    batch.reserve(3, 3 * sizeof(pldm_pdr_hdr));
+    for (uint8_t type = 1; type <= 3; ++type)
+    {
+        pldm_pdr_hdr hdr{};
+        hdr.version = 1;
+        hdr.type = type;
+        batch.add(reinterpret_cast<const uint8_t*>(&hdr), sizeof(hdr));
+    }
+    EXPECT_EQ(batch.size(), 3);
+    EXPECT_EQ(repo.getRecordCount(), 0);
+
+    EXPECT_EQ(batch.commit(repo), 3);
+    EXPECT_EQ(batch.size(), 0);
+    ASSERT_EQ(repo.getRecordCount(), 3);
+
+    PdrEntry entry{};
+    auto record = repo.getFirstRecord(entry);
+    for (uint8_t type = 1; type <= 3; ++type)
+    {
+        ASSERT_NE(record, nullptr);
+        auto hdr = reinterpret_cast<const pldm_pdr_hdr*>(entry.data);
+        EXPECT_EQ(hdr->type, type);
+        EXPECT_EQ(hdr->record_handle, type);
+        record = repo.getNextRecord(record, entry);
+    }
+
+    pldm_pdr_destroy(pdrRepo);
+}
+
+TEST(PdrArena, syncWithRepo)
+{
+    auto pdrRepo = pldm_pdr_init();
+    Repo repo(pdrRepo);
+    auto addRecords = [&repo](uint8_t count) {
+        PdrBatch batch;
+        for (uint8_t type = 1; type <= count; ++type)
+        {
+            pldm_pdr_hdr hdr{};
+            hdr.version = 1;
+            hdr.type = type;
+            batch.add(reinterpret_cast<const uint8_t*>(&hdr), sizeof(hdr));
+        }
+        batch.commit(repo);
+    };
+
+    PdrArena arena;
+    addRecords(3);
+    EXPECT_TRUE(arena.sync(pdrRepo));
+    ASSERT_EQ(arena.size(), 3);
+    EXPECT_EQ(arena.find(0), arena.first());
+    EXPECT_EQ(arena.find(2)->nextHandle, 3);
+    EXPECT_EQ(arena.find(3)->nextHandle, 0);
+    EXPECT_EQ(arena.find(4), nullptr);
+    EXPECT_FALSE(arena.sync(pdrRepo));
+
+    // Appended records are copied at the end of the arena
+    addRecords(2);
+    uint32_t handle = 0;
+    pldm_pdr_hdr hdr{};
+    hdr.version = 1;
+    hdr.type = PLDM_STATE_SENSOR_PDR;
+    ASSERT_EQ(pldm_pdr_add_check(pdrRepo, reinterpret_cast<uint8_t*>(&hdr),
+                                 sizeof(hdr), true, 1, &handle),
+              0);
+    pldm::utils::pdrRepoChanged(pldm::utils::PdrRepoChange::added);
+    EXPECT_FALSE(arena.sync(pdrRepo));
+    ASSERT_EQ(arena.size(), 6);
+    EXPECT_EQ(arena.bytes(), 6 * sizeof(pldm_pdr_hdr));
+    EXPECT_EQ(arena.chunkCount(), 1);
+    EXPECT_EQ(arena.find(3)->nextHandle, 4);
+
+    PdrEntry entry{};
+    auto record = repo.getFirstRecord(entry);
+    for (auto arenaRecord = arena.first(); arenaRecord;
+         arenaRecord = arena.next(*arenaRecord))
+    {
+        ASSERT_NE(record, nullptr);
+        EXPECT_EQ(arenaRecord->handle, repo.getRecordHandle(record));
+        EXPECT_EQ(arenaRecord->nextHandle, entry.handle.nextRecordHandle);
+        ASSERT_EQ(arenaRecord->size, entry.size);
+        EXPECT_EQ(std::memcmp(arenaRecord->data, entry.data, entry.size), 0);
+        record = repo.getNextRecord(record, entry);
+    }
+    EXPECT_EQ(record, nullptr);
+
+    // Removing the host PDRs rebuilds the arena without them
+    pldm_pdr_remove_remote_pdrs(pdrRepo);
+    pldm::utils::pdrRepoChanged();
+    EXPECT_TRUE(arena.sync(pdrRepo));
+    EXPECT_EQ(arena.size(), 5);
+    EXPECT_EQ(arena.bytes(), 5 * sizeof(pldm_pdr_hdr));
+    EXPECT_EQ(arena.find(handle), nullptr);
+    EXPECT_EQ(arena.find(5)->nextHandle, 0);
+
+    pldm_pdr_destroy(pdrRepo);
+}
+
+TEST(StateValueTable, stringValues)
+{
+    StateValueTable table(
+        StatestoDbusVal{{0, std::string("xyz.Foo.Off")},
+                        {1, std::string("xyz.Foo.On || xyz.Foo.Standby")},
+                        {2, std::string("xyz.Foo.Fault")},
+                        {5, std::string("xyz.Foo.On")}});
+    ASSERT_EQ(table.size(), 4);
+
+    EXPECT_EQ(table.state(std::string("xyz.Foo.Off")), 0);
+    EXPECT_EQ(table.state(std::string("xyz.Foo.Standby")), 1);
+    EXPECT_EQ(table.state(std::string("xyz.Foo.Fault")), 2);
+    // A value of two states maps to the lowest one
+    EXPECT_EQ(table.state(std::string("xyz.Foo.On")), 1);
+    EXPECT_EQ(table.state(std::string("xyz.Foo")), std::nullopt);
+    EXPECT_EQ(table.state(std::string("")), std::nullopt);
+    EXPECT_EQ(table.state(uint8_t(1)), std::nullopt);
+
+    EXPECT_EQ(*table.value(2), PropertyValue(std::string("xyz.Foo.Fault")));
+    EXPECT_EQ(*table.value(5), PropertyValue(std::string("xyz.Foo.On")));
+    EXPECT_EQ(table.value(3), nullptr);
+    EXPECT_EQ(table.value(6), nullptr);
+    EXPECT_EQ(table.value(255), nullptr);
+
+    // Enough strings for the perfect hash to need a larger table
+    StatestoDbusVal manyValues;
+    for (uint16_t state = 0; state < 256; ++state)
+    {
+        manyValues.emplace(state, "xyz.Foo.State" + std::to_string(state));
+    }
+    StateValueTable manyTable(manyValues);
+    for (uint16_t state = 0; state < 256; ++state)
+    {
+        EXPECT_EQ(manyTable.state("xyz.Foo.State" + std::to_string(state)),
+                  state);
+    }
+    EXPECT_EQ(manyTable.state(std::string("xyz.Foo.State256")), std::nullopt);
+}
+
+TEST(StateValueTable, integerValues)
+{
+    StateValueTable dense(StatestoDbusVal{
+        {1, uint8_t(10)}, {2, uint8_t(12)}, {3, uint8_t(10)}});
+    EXPECT_EQ(dense.state(uint8_t(10)), 1);
+    EXPECT_EQ(dense.state(uint8_t(12)), 2);
+    EXPECT_EQ(dense.state(uint8_t(11)), std::nullopt);
+    EXPECT_EQ(dense.state(uint8_t(9)), std::nullopt);
+    EXPECT_EQ(dense.state(uint8_t(255)), std::nullopt);
+    EXPECT_EQ(dense.state(uint16_t(10)), std::nullopt);
+    EXPECT_EQ(*dense.value(3), PropertyValue(uint8_t(10)));
+
+    StateValueTable sparse(StatestoDbusVal{{0, int64_t(-5000000000)},
+                                           {1, int64_t(0)},
+                                           {2, int64_t(7000000000)}});
+    EXPECT_EQ(sparse.state(int64_t(-5000000000)), 0);
+    EXPECT_EQ(sparse.state(int64_t(0)), 1);
+    EXPECT_EQ(sparse.state(int64_t(7000000000)), 2);
+    EXPECT_EQ(sparse.state(int64_t(1)), std::nullopt);
+
+    StateValueTable wide(
+        StatestoDbusVal{{0, uint64_t(0)}, {1, uint64_t(UINT64_MAX)}});
+    EXPECT_EQ(wide.state(uint64_t(UINT64_MAX)), 1);
+    EXPECT_EQ(wide.state(uint64_t(0)), 0);
+    EXPECT_EQ(wide.state(uint64_t(1)), std::nullopt);
+
+    StateValueTable flags(StatestoDbusVal{{1, true}, {2, false}});
+    EXPECT_EQ(flags.state(true), 1);
+    EXPECT_EQ(flags.state(false), 2);
+
+    StateValueTable doubles(StatestoDbusVal{{1, 0.5}, {2, 1.5}});
+    EXPECT_EQ(doubles.state(1.5), 2);
+    EXPECT_EQ(doubles.state(1.0), std::nullopt);
+
+    StateValueTable empty;
+    EXPECT_TRUE(empty.empty());
+    EXPECT_EQ(empty.state(uint8_t(0)), std::nullopt);
+    EXPECT_EQ(empty.value(0), nullptr);
+}
+
+class TestSensorEvent : public testing::Test
+{
+  public:
+    static void addHostSensor(pldm::HostPDRHandler& hostPDRHandler,
+                              const pldm::SensorEntry& sensorEntry,
+                              SensorInfo&& sensorInfo)
+    {
+        hostPDRHandler.sensorMap.emplace(sensorEntry, std::move(sensorInfo));
+    }
+
+    /** @brief Sensor event data of a state sensor event */
+    static std::vector<uint8_t> makeEvent(uint16_t sensorId, uint8_t offset,
+                                          uint8_t state)
+    {
+        std::vector<uint8_t> request(sizeof(pldm_msg_hdr));
+        request.push_back(sensorId & 0xff);
+        request.push_back(sensorId >> 8);
+        request.push_back(PLDM_STATE_SENSOR_STATE);
+        request.push_back(offset);
+        request.push_back(state);
+        request.push_back(PLDM_SENSOR_UNKNOWN);
+        return request;
+    }
+};
+
+TEST_F(TestSensorEvent, outOfRangeState)
+{
+    MockdBusHandler mockedUtils;
+    auto pdrRepo = pldm_pdr_init();
+    auto entityTree = pldm_entity_association_tree_init();
+    auto bmcEntityTree = pldm_entity_association_tree_init();
+    auto event = sdeventplus::Event::get_default();
+    sdbusplus::bus_t bus(sdbusplus::bus::new_default());
+    pldm::dbus_api::Requester requester(bus, "/abc/def");
+    {
+        pldm::HostPDRHandler hostPDRHandler(
+            -1, 9, event, pdrRepo, "", entityTree, bmcEntityTree, nullptr,
+            requester, nullptr, nullptr, nullptr);
+        addHostSensor(hostPDRHandler, {1, 0x10},
+                      {{0, PLDM_ENTITY_PROC, 1},
+                       {{PLDM_STATE_SET_HEALTH_STATE_NORMAL,
+                         PLDM_STATE_SET_HEALTH_STATE_CRITICAL}},
+                       {PLDM_STATE_SET_HEALTH_STATE}});
+        Handler handler(&mockedUtils, "", pdrRepo, &hostPDRHandler, nullptr,
+                        nullptr, bmcEntityTree, nullptr, event, true);
+
+        // An event state the sensor PDR does not list is rejected before it
+        // is coalesced, so it is neither signalled nor routed
+        auto invalid = makeEvent(0x10, 0, 0x7f);
+        EXPECT_EQ(handler.sensorEvent(
+                      reinterpret_cast<const pldm_msg*>(invalid.data()),
+                      invalid.size() - sizeof(pldm_msg_hdr), 0, 1, 0),
+                  PLDM_ERROR_INVALID_DATA);
+        EXPECT_EQ(handler.getSensorEventStats().received, 0);
+
+        auto valid = makeEvent(0x10, 0, PLDM_STATE_SET_HEALTH_STATE_CRITICAL);
+        EXPECT_EQ(handler.sensorEvent(
+                      reinterpret_cast<const pldm_msg*>(valid.data()),
+                      valid.size() - sizeof(pldm_msg_hdr), 0, 1, 0),
+                  PLDM_SUCCESS);
+        EXPECT_EQ(handler.getSensorEventStats().received, 1);
+    }
+    pldm_entity_association_tree_destroy(bmcEntityTree);
+    pldm_entity_association_tree_destroy(entityTree);
+    pldm_pdr_destroy(pdrRepo);
+}
@@ -0,0 +1,127 @@
+#include "libpldm/pdr.h"
+
+#include "libpldmresponder/pdr_arena.hpp"
+#include "libpldmresponder/pdr_utils.hpp"
+
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <vector>
+
+using namespace pldm::responder::pdr_utils;
+using Clock = std::chrono::steady_clock;
+
+namespace
+{
+
+/** @brief Time a run, in microseconds */
+template <typename Run>
+double measure(Run run)
+{
+    auto start = Clock::now();
+    run();
+    return std::chrono::duration<double, std::micro>(Clock::now() - start)
+        .count();
+}
+
+void report(const char* name, double repoTime, double arenaTime)
+{
+    std::cout << std::left << std::setw(8) << name << std::right
+              << std::fixed << std::setprecision(1) << std::setw(12)
+              << repoTime << std::setw(12) << arenaTime << "\n";
+}
+
+} // namespace
+
+/** @brief Compare the libpldm PDR repo and PdrArena on inserting, walking and
+ *         looking up records
+ *
+ *  Usage: pdr_arena_bench [record count] [lookup count]
+ */
+int main(int argc, char** argv)
+{
+    size_t count = argc > 1 ? std::strtoul(argv[1], nullptr, 0) : 2000;
+    size_t lookups = argc > 2 ? std::strtoul(argv[2], nullptr, 0) : 100000;
+
+    // State sensor and effecter PDRs are a few tens of bytes
+    std::mt19937 random(1);
+    std::vector<std::vector<uint8_t>> pdrs(count);
+    std::vector<PdrEntry> entries(count);
+    size_t bytes = 0;
+    for (size_t pos = 0; pos < count; ++pos)
+    {
+        pdrs[pos].resize(sizeof(pldm_pdr_hdr) + 16 + random() % 48);
+        auto hdr = reinterpret_cast<pldm_pdr_hdr*>(pdrs[pos].data());
+        hdr->version = 1;
+        hdr->type = PLDM_STATE_SENSOR_PDR;
+        entries[pos].data = pdrs[pos].data();
+        entries[pos].size = pdrs[pos].size();
+        bytes += pdrs[pos].size();
+    }
+
+    auto pdrRepo = pldm_pdr_init();
+    Repo repo(pdrRepo);
+    PdrArena arena;
+
+    auto repoInsert = measure([&] { repo.addRecords(entries); });
+    auto arenaInsert = measure([&] {
+        arena.reserve(count, bytes);
+        for (size_t pos = 0; pos < count; ++pos)
+        {
+            arena.add(pos + 1, entries[pos].data, entries[pos].size);
+        }
+    });
+
+    size_t repoSum = 0;
+    size_t arenaSum = 0;
+    auto repoWalk = measure([&] {
+        PdrEntry entry{};
+        for (auto record = repo.getFirstRecord(entry); record;
+             record = repo.getNextRecord(record, entry))
+        {
+            repoSum += entry.data[entry.size - 1];
+        }
+    });
+    auto arenaWalk = measure([&] {
+        for (auto record = arena.first(); record; record = arena.next(*record))
+        {
+            arenaSum += record->data[record->size - 1];
+        }
+    });
+
+    std::vector<RecordHandle> handles(lookups);
+    for (auto& handle : handles)
+    {
+        handle = 1 + random() % count;
+    }
+    auto repoLookup = measure([&] {
+        for (auto handle : handles)
+        {
+            uint8_t* data = nullptr;
+            uint32_t size{};
+            uint32_t nextHandle{};
+            pldm_pdr_find_record(pdrRepo, handle, &data, &size, &nextHandle);
+            repoSum += nextHandle;
+        }
+    });
+    auto arenaLookup = measure([&] {
+        for (auto handle : handles)
+        {
+            arenaSum += arena.find(handle)->nextHandle;
+        }
+    });
+
+    std::cout << count << " records, " << bytes << " bytes, " << lookups
+              << " lookups, times in us\n";
+    std::cout << std::left << std::setw(8) << "" << std::right
+              << std::setw(12) << "pldm_pdr" << std::setw(12) << "arena"
+              << "\n";
+    report("insert", repoInsert, arenaInsert);
+    report("walk", repoWalk, arenaWalk);
+    report("lookup", repoLookup, arenaLookup);
+
+    pldm_pdr_destroy(pdrRepo);
+    return repoSum == arenaSum ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,166 @@
+#include "libpldm/platform.h"
+
+#include "libpldmresponder/pdr_utils.hpp"
+#include "libpldmresponder/state_value_table.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace pldm::responder::pdr_utils;
+using pldm::utils::PropertyValue;
+using Clock = std::chrono::steady_clock;
+
+namespace
+{
+
+/** @brief Time a run, in microseconds */
+template <typename Run>
+double measure(Run run)
+{
+    auto start = Clock::now();
+    run();
+    return std::chrono::duration<double, std::micro>(Clock::now() - start)
+        .count();
+}
+
+void report(const char* name, double mapTime, double tableTime)
+{
+    std::cout << std::left << std::setw(10) << name << std::right
+              << std::fixed << std::setprecision(1) << std::setw(12)
+              << mapTime << std::setw(12) << tableTime << "\n";
+}
+
+/** @brief Sensor state of a value, as found in the map before the tables */
+uint8_t mapState(const StatestoDbusVal& stateToDbusValue,
+                 const std::string& propertyType,
+                 const PropertyValue& propertyValue)
+{
+    for (const auto& stateValue : stateToDbusValue)
+    {
+        if (propertyType == "string")
+        {
+            std::string statValSecStr =
+                std::get<std::string>(stateValue.second);
+            std::string proValStr = std::get<std::string>(propertyValue);
+
+            if ((std::strstr(statValSecStr.c_str(), "||")) &&
+                (std::strstr(statValSecStr.c_str(), proValStr.c_str())))
+            {
+                return stateValue.first;
+            }
+        }
+
+        if (stateValue.second == propertyValue)
+        {
+            return stateValue.first;
+        }
+    }
+
+    return PLDM_SENSOR_UNKNOWN;
+}
+
+} // namespace
+
+/** @brief Compare the state maps and StateValueTable on finding the sensor
+ *         state of D-Bus property values and the D-Bus property value of
+ *         effecter states
+ *
+ *  Usage: state_value_table_bench [state count] [lookup count]
+ */
+int main(int argc, char** argv)
+{
+    size_t count = argc > 1 ? std::strtoul(argv[1], nullptr, 0) : 8;
+    size_t lookups = argc > 2 ? std::strtoul(argv[2], nullptr, 0) : 1000000;
+    count = std::clamp<size_t>(count, 2, 255);
+
+    // State sets map to D-Bus enumerations, a few states, some with
+    // alternative values
+    StatestoDbusVal strings;
+    StatestoDbusVal integers;
+    std::vector<PropertyValue> stringValues;
+    for (size_t state = 1; state <= count; ++state)
+    {
+        auto name = "xyz.openbmc_project.State.Host.HostState.State" +
+                    std::to_string(state);
+        if (state % 4 == 0)
+        {
+            strings.emplace(state, name + "||" + name + "Alt");
+            stringValues.emplace_back(name + "Alt");
+        }
+        else
+        {
+            strings.emplace(state, name);
+        }
+        stringValues.emplace_back(name);
+        integers.emplace(state, static_cast<uint8_t>(state * 2));
+    }
+    StateValueTable stringTable(strings);
+    StateValueTable integerTable(integers);
+
+    std::mt19937 random(1);
+    std::vector<PropertyValue> stringReads(lookups);
+    std::vector<PropertyValue> integerReads(lookups);
+    std::vector<uint8_t> effecterStates(lookups);
+    for (size_t pos = 0; pos < lookups; ++pos)
+    {
+        stringReads[pos] = stringValues[random() % stringValues.size()];
+        integerReads[pos] = static_cast<uint8_t>(random() % (2 * count + 2));
+        effecterStates[pos] = 1 + random() % count;
+    }
+
+    size_t mapSum = 0;
+    size_t tableSum = 0;
+    auto mapString = measure([&] {
+        for (const auto& value : stringReads)
+        {
+            mapSum += mapState(strings, "string", value);
+        }
+    });
+    auto tableString = measure([&] {
+        for (const auto& value : stringReads)
+        {
+            tableSum += stringTable.state(value).value_or(PLDM_SENSOR_UNKNOWN);
+        }
+    });
+    auto mapInteger = measure([&] {
+        for (const auto& value : integerReads)
+        {
+            mapSum += mapState(integers, "uint8_t", value);
+        }
+    });
+    auto tableInteger = measure([&] {
+        for (const auto& value : integerReads)
+        {
+            tableSum +=
+                integerTable.state(value).value_or(PLDM_SENSOR_UNKNOWN);
+        }
+    });
+    auto mapEffecter = measure([&] {
+        for (auto state : effecterStates)
+        {
+            mapSum += strings.at(state).index();
+        }
+    });
+    auto tableEffecter = measure([&] {
+        for (auto state : effecterStates)
+        {
+            tableSum += stringTable.value(state)->index();
+        }
+    });
+
+    std::cout << count << " states, " << lookups << " lookups, times in us\n";
+    std::cout << std::left << std::setw(10) << "" << std::right
+              << std::setw(12) << "map" << std::setw(12) << "table" << "\n";
+    report("string", mapString, tableString);
+    report("integer", mapInteger, tableInteger);
+    report("effecter", mapEffecter, tableEffecter);
+
+    return mapSum == tableSum ? EXIT_SUCCESS : EXIT_FAILURE;
+}
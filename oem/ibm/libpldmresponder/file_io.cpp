@@ -19,6 +19,7 @@
 #include <fstream>
 #include <iostream>
 #include <memory>
+#include <mutex>
 #include <thread>
 
 PHOSPHOR_LOG2_USING;
@@ -50,8 +51,30 @@ struct AspeedXdmaOp
 
 constexpr auto xdmaDev = "/dev/aspeed-xdma";
 
+namespace
+{
+
+/** @brief Serializes the transfers, they share the XDMA memory window */
+std::mutex xdmaWindow;
+
+} // namespace
+
+bool DMA::holdWindow()
+{
+    if (!window.owns_lock())
+    {
+        window = wait ? std::unique_lock(xdmaWindow)
+                      : std::unique_lock(xdmaWindow, std::try_to_lock);
+    }
+    return window.owns_lock();
+}
+
 int DMA::transferHostDataToSocket(int fd, uint32_t length, uint64_t address)
 {
+    if (!holdWindow())
+    {
+        return -EBUSY;
+    }
     socketWriteStatus = NotReady;
     static const size_t pageSize = getpagesize();
     uint32_t numPages = length / pageSize;
@@ -110,8 +133,26 @@ int DMA::transferHostDataToSocket(int fd, uint32_t length, uint64_t address)
         return rc;
     }
 
-    std::thread dumpOffloadThread(writeToUnixSocket, fd,
-                                  static_cast<const char*>(vgaMemDump), length);
+    // The data is copied out of the window before it is written to the
+    // socket, so a slow dump consumer does not hold up the other transfers.
+    // writeToUnixSocket unmaps the copy once written.
+    void* dump = mmap(nullptr, pageAlignedLength, PROT_READ | PROT_WRITE,
+                      MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (MAP_FAILED == dump)
+    {
+        rc = -errno;
+        error(
+            "transferHostDataToSocket : Failed to allocate the dump buffer, RC={RC}",
+            "RC", rc);
+        munmap(vgaMemDump, pageAlignedLength);
+        return rc;
+    }
+    memcpy(dump, vgaMemDump, length);
+    munmap(vgaMemDump, pageAlignedLength);
+
+    std::thread dumpOffloadThread([fd, dump, length] {
+        writeToUnixSocket(fd, static_cast<const char*>(dump), length);
+    });
     dumpOffloadThread.detach();
 
     return 0;
@@ -140,6 +181,10 @@ int DMA::transferDataHost(int fd, uint32_t offset, uint32_t length,
         }
     };
 
+    if (!holdWindow())
+    {
+        return -EBUSY;
+    }
     int dmaFd = -1;
     dmaFd = open(xdmaDev, O_RDWR);
     if (dmaFd < 0)
@@ -240,12 +285,119 @@ int DMA::transferDataHost(int fd, uint32_t offset, uint32_t length,
     return 0;
 }
 
+int DMA::transferHostData(
+    uint32_t length, uint64_t address,
+    const std::function<int(const uint8_t* data, uint32_t length)>& sink)
+{
+    static const size_t pageSize = getpagesize();
+    uint32_t numPages = length / pageSize;
+    uint32_t pageAlignedLength = numPages * pageSize;
+
+    if (length > pageAlignedLength)
+    {
+        pageAlignedLength += pageSize;
+    }
+    int rc = 0;
+    auto mmapCleanup = [pageAlignedLength, &rc](void* vgaMem) {
+        if (rc != -EINTR)
+        {
+            munmap(vgaMem, pageAlignedLength);
+        }
+        else
+        {
+            error("Received interrupt during DMA transfer. Skipping Unmap");
+        }
+    };
+
+    if (!holdWindow())
+    {
+        return -EBUSY;
+    }
+    int dmaFd = open(xdmaDev, O_RDWR);
+    if (dmaFd < 0)
+    {
+        rc = -errno;
+        error("transferHostData : Failed to open the XDMA device, RC={RC}",
+              "RC", rc);
+        return rc;
+    }
+
+    pldm::utils::CustomFD xdmaFd(dmaFd);
+
+    void* vgaMem = mmap(nullptr, pageAlignedLength, PROT_READ, MAP_SHARED,
+                        xdmaFd(), 0);
+    if (MAP_FAILED == vgaMem)
+    {
+        rc = -errno;
+        error("transferHostData : Failed to mmap the XDMA device, RC={RC}",
+              "RC", rc);
+        return rc;
+    }
+
+    std::unique_ptr<void, decltype(mmapCleanup)> vgaMemPtr(vgaMem, mmapCleanup);
+
+    AspeedXdmaOp xdmaOp;
+    xdmaOp.upstream = 0;
+    xdmaOp.hostAddr = address;
+    xdmaOp.len = length;
+
+    rc = write(xdmaFd(), &xdmaOp, sizeof(xdmaOp));
+    if (rc < 0)
+    {
+        rc = -errno;
+        error(
+            "transferHostData : Failed to execute the DMA operation, RC={RC} ADDRESS={ADDR} LENGTH={LEN}",
+            "RC", rc, "ADDR", address, "LEN", length);
+        return rc;
+    }
+
+    rc = sink(static_cast<const uint8_t*>(vgaMemPtr.get()), length);
+    return rc;
+}
+
 } // namespace dma
 
 namespace oem_ibm
 {
+namespace
+{
+
+/** @brief Run a DMA transfer on the calling thread */
+Response runTransfer(Handler::Transfer&& transfer)
+{
+    if (auto work = std::get_if<Completer::Work>(&transfer))
+    {
+        return (*work)();
+    }
+    return std::move(std::get<Response>(transfer));
+}
+
+} // namespace
+
+void Handler::complete(Transfer&& transfer, const Completer& completer)
+{
+    if (auto work = std::get_if<Completer::Work>(&transfer))
+    {
+        completer.post(std::move(*work));
+        return;
+    }
+    completer(std::move(std::get<Response>(transfer)));
+}
+
 Response Handler::readFileIntoMemory(const pldm_msg* request,
                                      size_t payloadLength)
+{
+    return runTransfer(prepareReadFileIntoMemory(request, payloadLength));
+}
+
+Response Handler::writeFileFromMemory(const pldm_msg* request,
+                                      size_t payloadLength)
+{
+    return runTransfer(prepareWriteFileFromMemory(request, payloadLength));
+}
+
+Handler::Transfer Handler::prepareReadFileIntoMemory(const pldm_msg* request,
+                                                     size_t payloadLength)
 {
     uint32_t fileHandle = 0;
     uint32_t offset = 0;
@@ -322,15 +474,17 @@ Response Handler::readFileIntoMemory(const pldm_msg* request,
         return response;
     }
 
-    using namespace dma;
-    DMA intf;
-    return transferAll<DMA>(&intf, PLDM_READ_FILE_INTO_MEMORY, value.fsPath,
-                            offset, length, address, true,
-                            request->hdr.instance_id);
+    return [path = value.fsPath, offset, length, address,
+            instanceId = request->hdr.instance_id]() mutable {
+        dma::DMA intf(true);
+        return dma::transferAll<dma::DMA>(&intf, PLDM_READ_FILE_INTO_MEMORY,
+                                          path, offset, length, address, true,
+                                          instanceId);
+    };
 }
 
-Response Handler::writeFileFromMemory(const pldm_msg* request,
-                                      size_t payloadLength)
+Handler::Transfer Handler::prepareWriteFileFromMemory(const pldm_msg* request,
+                                                      size_t payloadLength)
 {
     uint32_t fileHandle = 0;
     uint32_t offset = 0;
@@ -402,11 +556,13 @@ Response Handler::writeFileFromMemory(const pldm_msg* request,
         return response;
     }
 
-    using namespace dma;
-    DMA intf;
-    return transferAll<DMA>(&intf, PLDM_WRITE_FILE_FROM_MEMORY, value.fsPath,
-                            offset, length, address, false,
-                            request->hdr.instance_id);
+    return [path = value.fsPath, offset, length, address,
+            instanceId = request->hdr.instance_id]() mutable {
+        dma::DMA intf(true);
+        return dma::transferAll<dma::DMA>(&intf, PLDM_WRITE_FILE_FROM_MEMORY,
+                                          path, offset, length, address, false,
+                                          instanceId);
+    };
 }
 
 Response Handler::getFileTable(const pldm_msg* request, size_t payloadLength)
@@ -445,12 +601,8 @@ Response Handler::getFileTable(const pldm_msg* request, size_t payloadLength)
     }
 
     using namespace pldm::filetable;
-    auto table = buildFileTable(FILE_TABLE_JSON);
-    auto attrTable = table();
-    response.resize(response.size() + attrTable.size());
-    responsePtr = reinterpret_cast<pldm_msg*>(response.data());
-
-    if (attrTable.empty())
+    auto& table = buildFileTable(FILE_TABLE_JSON);
+    if (table.isEmpty())
     {
         encode_get_file_table_resp(request->hdr.instance_id,
                                    PLDM_FILE_TABLE_UNAVAILABLE, 0, 0, nullptr,
@@ -458,9 +610,27 @@ Response Handler::getFileTable(const pldm_msg* request, size_t payloadLength)
         return response;
     }
 
-    encode_get_file_table_resp(request->hdr.instance_id, PLDM_SUCCESS, 0,
-                               PLDM_START_AND_END, attrTable.data(),
-                               attrTable.size(), responsePtr);
+    // The parts are sliced from the table kept by FileTable, a stale
+    // transfer handle means the table changed since the first part
+    auto part = table.getPart(transferFlag, transferHandle,
+                              FILE_TABLE_PART_SIZE);
+    if (!part)
+    {
+        error(
+            "Invalid GetFileTable transfer handle {HANDLE}, VERSION={VERSION}",
+            "HANDLE", transferHandle, "VERSION", unsigned(table.getVersion()));
+        encode_get_file_table_resp(request->hdr.instance_id,
+                                   PLDM_ERROR_INVALID_DATA, 0, 0, nullptr, 0,
+                                   responsePtr);
+        return response;
+    }
+
+    response.resize(response.size() + part->data.size());
+    responsePtr = reinterpret_cast<pldm_msg*>(response.data());
+    encode_get_file_table_resp(request->hdr.instance_id, PLDM_SUCCESS,
+                               part->nextHandle, part->transferFlag,
+                               part->data.data(), part->data.size(),
+                               responsePtr);
     return response;
 }
 
@@ -18,7 +18,10 @@
 #include <phosphor-logging/lg2.hpp>
 
 #include <filesystem>
+#include <functional>
 #include <iostream>
+#include <mutex>
+#include <variant>
 #include <vector>
 
 PHOSPHOR_LOG2_USING;
@@ -44,10 +47,23 @@ namespace fs = std::filesystem;
  * This class only exposes the public API transferDataHost to transfer data
  * between BMC and host using DMA. This allows for mocking the transferDataHost
  * for unit testing purposes.
+ *
+ * The transfers share the XDMA memory window. A DMA object holds it from its
+ * first transfer until it is destroyed, so that the parts of a large transfer
+ * are not interleaved with other transfers. The event loop does not wait for
+ * the window held by a transfer running on a worker thread.
  */
 class DMA
 {
   public:
+    /** @brief Constructor
+     *
+     * @param[in] wait - wait for the XDMA memory window while another
+     *                   transfer holds it, only off the event loop. Otherwise
+     *                   the transfer fails with -EBUSY.
+     */
+    explicit DMA(bool wait = false) : wait(wait) {}
+
     /** @brief API to transfer data between BMC and host using DMA
      *
      * @param[in] path     - pathname of the file to transfer data from or to
@@ -57,7 +73,8 @@ class DMA
      * @param[in] upstream - indicates direction of the transfer; true indicates
      *                       transfer to the host
      *
-     * @return returns 0 on success, negative errno on failure
+     * @return returns 0 on success, negative errno on failure, -EBUSY if
+     *         another transfer holds the XDMA memory window
      */
     int transferDataHost(int fd, uint32_t offset, uint32_t length,
                          uint64_t address, bool upstream);
@@ -68,9 +85,38 @@ class DMA
      * @param[in] length   - length of the data to transfer
      * @param[in] address  - DMA address on the host
      *
-     * @return returns 0 on success, negative errno on failure
+     * @return returns 0 on success, negative errno on failure, -EBUSY if
+     *         another transfer holds the XDMA memory window
      */
     int transferHostDataToSocket(int fd, uint32_t length, uint64_t address);
+
+    /** @brief API to transfer data from the host by DMA and hand it over
+     *         without writing it to a file first
+     *
+     * @param[in] length   - length of the data to transfer
+     * @param[in] address  - DMA address on the host
+     * @param[in] sink     - consumes the data, returns 0 on success or a
+     *                       negative errno
+     *
+     * @return returns 0 on success, negative errno on failure, -EBUSY if
+     *         another transfer holds the XDMA memory window
+     */
+    int transferHostData(
+        uint32_t length, uint64_t address,
+        const std::function<int(const uint8_t* data, uint32_t length)>& sink);
+
+  private:
+    /** @brief Hold the XDMA memory window for the transfers of this object
+     *
+     * @return true if the window is held, false if another transfer holds it
+     *         and this one does not wait
+     */
+    bool holdWindow();
+
+    bool wait;
+
+    /** @brief the XDMA memory window, once held */
+    std::unique_lock<std::mutex> window;
 };
 
 /** @brief Transfer the data between BMC and host using DMA.
@@ -178,13 +224,21 @@ class Handler : public CmdHandler
         hostSockFd(hostSockFd), hostEid(hostEid),
         dbusImplReqester(dbusImplReqester), handler(handler), event(event)
     {
-        handlers.emplace(PLDM_READ_FILE_INTO_MEMORY,
-                         [this](const pldm_msg* request, size_t payloadLength) {
-            return this->readFileIntoMemory(request, payloadLength);
+        // The DMA transfers run on the worker pool, the request is validated
+        // on the event loop
+        asyncHandlers.emplace(PLDM_READ_FILE_INTO_MEMORY,
+                              [this](const pldm_msg* request,
+                                     size_t payloadLength,
+                                     Completer completer) {
+            complete(this->prepareReadFileIntoMemory(request, payloadLength),
+                     completer);
         });
-        handlers.emplace(PLDM_WRITE_FILE_FROM_MEMORY,
-                         [this](const pldm_msg* request, size_t payloadLength) {
-            return this->writeFileFromMemory(request, payloadLength);
+        asyncHandlers.emplace(PLDM_WRITE_FILE_FROM_MEMORY,
+                              [this](const pldm_msg* request,
+                                     size_t payloadLength,
+                                     Completer completer) {
+            complete(this->prepareWriteFileFromMemory(request, payloadLength),
+                     completer);
         });
         handlers.emplace(PLDM_WRITE_FILE_BY_TYPE_FROM_MEMORY,
                          [this](const pldm_msg* request, size_t payloadLength) {
@@ -361,6 +415,31 @@ class Handler : public CmdHandler
      */
     Response readFileIntoMemory(const pldm_msg* request, size_t payloadLength);
 
+    /** @brief Error response of a command, or the DMA transfer that produces
+     *         its response
+     */
+    using Transfer = std::variant<Response, Completer::Work>;
+
+    /** @brief Validate a readFileIntoMemory command
+     *
+     *  @param[in] request - pointer to PLDM request payload
+     *  @param[in] payloadLength - length of the message
+     *
+     *  @return the error response or the DMA transfer of the command
+     */
+    Transfer prepareReadFileIntoMemory(const pldm_msg* request,
+                                       size_t payloadLength);
+
+    /** @brief Validate a writeFileFromMemory command
+     *
+     *  @param[in] request - pointer to PLDM request payload
+     *  @param[in] payloadLength - length of the message
+     *
+     *  @return the error response or the DMA transfer of the command
+     */
+    Transfer prepareWriteFileFromMemory(const pldm_msg* request,
+                                        size_t payloadLength);
+
     /** @brief Handler for writeFileIntoMemory command
      *
      *  @param[in] request - pointer to PLDM request payload
@@ -493,6 +572,14 @@ class Handler : public CmdHandler
                            const struct fileack_status_metadata& metaDataObj);
 
   private:
+    /** @brief Send the error response, or run the DMA transfer on the worker
+     *         pool
+     *
+     *  @param[in] transfer - error response or DMA transfer
+     *  @param[in] completer - completes the response of the command
+     */
+    static void complete(Transfer&& transfer, const Completer& completer);
+
     oem_platform::Handler* oemPlatformHandler;
     int hostSockFd;
     uint8_t hostEid;
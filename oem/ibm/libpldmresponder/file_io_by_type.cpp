@@ -4,6 +4,7 @@
 #include "libpldm/file_io.h"
 
 #include "common/utils.hpp"
+#include "file_io_session.hpp"
 #include "file_io_type_cert.hpp"
 #include "file_io_type_chap.hpp"
 #include "file_io_type_dump.hpp"
@@ -22,6 +23,8 @@
 #include <phosphor-logging/lg2.hpp>
 #include <xyz/openbmc_project/Logging/Entry/server.hpp>
 
+#include <algorithm>
+#include <cerrno>
 #include <exception>
 #include <filesystem>
 #include <fstream>
@@ -36,6 +39,19 @@ namespace responder
 {
 using namespace sdbusplus::xyz::openbmc_project::Common::Error;
 
+namespace
+{
+
+/** @brief Completion code of a failed DMA transfer, the host retries when the
+ *         XDMA memory window is held by a transfer running on a worker
+ */
+int dmaCompletionCode(int rc)
+{
+    return rc == -EBUSY ? PLDM_ERROR_NOT_READY : PLDM_ERROR;
+}
+
+} // namespace
+
 int FileHandler::transferFileData(int32_t fd, bool upstream, uint32_t offset,
                                   uint32_t& length, uint64_t address)
 {
@@ -46,7 +62,7 @@ int FileHandler::transferFileData(int32_t fd, bool upstream, uint32_t offset,
                                                  address, upstream);
         if (rc < 0)
         {
-            return PLDM_ERROR;
+            return dmaCompletionCode(rc);
         }
         offset += dma::maxSize;
         length -= dma::maxSize;
@@ -54,7 +70,7 @@ int FileHandler::transferFileData(int32_t fd, bool upstream, uint32_t offset,
     }
     auto rc = xdmaInterface.transferDataHost(fd, offset, length, address,
                                              upstream);
-    return rc < 0 ? PLDM_ERROR : PLDM_SUCCESS;
+    return rc < 0 ? dmaCompletionCode(rc) : PLDM_SUCCESS;
 }
 
 int FileHandler::transferFileDataToSocket(int32_t fd, uint32_t& length,
@@ -67,13 +83,38 @@ int FileHandler::transferFileDataToSocket(int32_t fd, uint32_t& length,
                                                          address);
         if (rc < 0)
         {
-            return PLDM_ERROR;
+            return dmaCompletionCode(rc);
         }
         length -= dma::maxSize;
         address += dma::maxSize;
     }
     auto rc = xdmaInterface.transferHostDataToSocket(fd, length, address);
-    return rc < 0 ? PLDM_ERROR : PLDM_SUCCESS;
+    return rc < 0 ? dmaCompletionCode(rc) : PLDM_SUCCESS;
+}
+
+int FileHandler::transferFileData(const DataSink& sink, uint32_t offset,
+                                  uint32_t length, uint64_t address)
+{
+    dma::DMA xdmaInterface;
+    while (length)
+    {
+        auto chunk = std::min<uint32_t>(length, dma::maxSize);
+        int status = PLDM_SUCCESS;
+        auto rc = xdmaInterface.transferHostData(
+            chunk, address,
+            [&sink, &status, offset](const uint8_t* data, uint32_t size) {
+            status = sink(offset, data, size);
+            return status == PLDM_SUCCESS ? 0 : -EIO;
+        });
+        if (rc < 0)
+        {
+            return status == PLDM_SUCCESS ? dmaCompletionCode(rc) : status;
+        }
+        offset += chunk;
+        length -= chunk;
+        address += chunk;
+    }
+    return PLDM_SUCCESS;
 }
 
 int FileHandler::transferFileData(const fs::path& path, bool upstream,
@@ -214,41 +255,22 @@ std::unique_ptr<FileHandler> getHandlerByType(
 int FileHandler::readFile(const std::string& filePath, uint32_t offset,
                           uint32_t& length, Response& response)
 {
-    if (!fs::exists(filePath))
-    {
-        error("File does not exist, HANDLE={FILE_HNDLE} PATH={PATH}",
-              "FILE_HNDLE", fileHandle, "PATH", filePath.c_str());
-        return PLDM_INVALID_FILE_HANDLE;
-    }
-
-    size_t fileSize = fs::file_size(filePath);
-    if (offset >= fileSize)
-    {
-        error(
-            "FileHandler::readFileData: Offset exceeds file size, OFFSET={OFFSET} FILE_SIZE={FILE_SIZE} FILE_HANDLE={FILE_HANDLE}",
-            "OFFSET", offset, "FILE_SIZE", fileSize, "FILE_HANDLE", fileHandle);
-        return PLDM_DATA_OUT_OF_RANGE;
-    }
-
-    if (offset + length > fileSize)
+    auto session = FileReadSessions::get().open(fs::path(filePath));
+    if (!session)
     {
-        length = fileSize - offset;
+        if (errno == ENOENT)
+        {
+            error("File does not exist, HANDLE={FILE_HNDLE} PATH={PATH}",
+                  "FILE_HNDLE", fileHandle, "PATH", filePath.c_str());
+            return PLDM_INVALID_FILE_HANDLE;
+        }
+        error("Unable to read file, FILE={FILE_PATH} ERROR={ERR}", "FILE_PATH",
+              filePath.c_str(), "ERR", errno);
+        return PLDM_ERROR;
     }
 
-    size_t currSize = response.size();
-    response.resize(currSize + length);
-    auto filePos = reinterpret_cast<char*>(response.data());
-    filePos += currSize;
-    std::ifstream stream(filePath, std::ios::in | std::ios::binary);
-    if (stream)
-    {
-        stream.seekg(offset);
-        stream.read(filePos, length);
-        return PLDM_SUCCESS;
-    }
-    error("Unable to read file, FILE={FILE_PATH}", "FILE_PATH",
-          filePath.c_str());
-    return PLDM_ERROR;
+    return FileReadSessions::read(*session, fileHandle, offset, length,
+                                  response);
 }
 
 } // namespace responder
@@ -157,6 +157,25 @@ class FileHandler
     virtual int transferFileDataToSocket(int fd, uint32_t& length,
                                          uint64_t address);
 
+    /** @brief Consumes the data of a DMA transfer from the host, returns a
+     *         PLDM status code
+     */
+    using DataSink = std::function<int(uint32_t offset, const uint8_t* data,
+                                       uint32_t length)>;
+
+    /** @brief Method to transfer data from host memory over DMA and hand it
+     *  to a sink instead of a file
+     *
+     *  @param[in] sink - consumes the data of each DMA operation
+     *  @param[in] offset - offset of the data in the file
+     *  @param[in] length - length to be written mentioned by Host
+     *  @param[in] address - DMA address
+     *
+     *  @return PLDM status code
+     */
+    virtual int transferFileData(const DataSink& sink, uint32_t offset,
+                                 uint32_t length, uint64_t address);
+
     /** @brief Constructor to create a FileHandler object
      */
     FileHandler(uint32_t fileHandle) : fileHandle(fileHandle) {}
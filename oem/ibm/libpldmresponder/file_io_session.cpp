@@ -0,0 +1,205 @@
+#include "file_io_session.hpp"
+
+#include "libpldm/base.h"
+#include "libpldm/file_io.h"
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <phosphor-logging/lg2.hpp>
+#include <sdeventplus/event.hpp>
+
+#include <cerrno>
+
+PHOSPHOR_LOG2_USING;
+
+namespace pldm
+{
+namespace responder
+{
+
+FileReadSessions::FileReadSessions() :
+    idleTimer(sdeventplus::Event::get_default().get(), [this] { expire(); })
+{}
+
+FileReadSessions& FileReadSessions::get()
+{
+    static FileReadSessions sessions;
+    return sessions;
+}
+
+std::optional<FileReadSessions::Session>
+    FileReadSessions::open(const std::string& key, const Opener& opener)
+{
+    auto search = sessions.find(key);
+    if (search != sessions.end())
+    {
+        return touch(search->second);
+    }
+
+    auto fd = std::make_shared<utils::CustomFD>(opener());
+    struct stat st{};
+    if ((*fd)() < 0 || fstat((*fd)(), &st) == -1)
+    {
+        error("Unable to open the file {KEY}, ERROR={ERR}", "KEY", key, "ERR",
+              errno);
+        return std::nullopt;
+    }
+
+    Entry entry{};
+    entry.key = key;
+    entry.session = {std::move(fd), st.st_size};
+    return insert(std::move(entry));
+}
+
+std::optional<FileReadSessions::Session>
+    FileReadSessions::open(const fs::path& path)
+{
+    struct stat st{};
+    if (stat(path.c_str(), &st) == -1)
+    {
+        return std::nullopt;
+    }
+
+    auto search = sessions.find(path.string());
+    if (search != sessions.end())
+    {
+        const auto& entry = *search->second;
+        if (entry.dev == st.st_dev && entry.ino == st.st_ino &&
+            entry.session.size == st.st_size &&
+            entry.mtime.tv_sec == st.st_mtim.tv_sec &&
+            entry.mtime.tv_nsec == st.st_mtim.tv_nsec)
+        {
+            return touch(search->second);
+        }
+        // The file was replaced or written since it was opened
+        release(path.string());
+    }
+
+    auto fd = std::make_shared<utils::CustomFD>(
+        ::open(path.c_str(), O_RDONLY | O_CLOEXEC));
+    if ((*fd)() < 0)
+    {
+        return std::nullopt;
+    }
+
+    Entry entry{};
+    entry.key = path.string();
+    entry.session = {std::move(fd), st.st_size};
+    entry.isPath = true;
+    entry.dev = st.st_dev;
+    entry.ino = st.st_ino;
+    entry.mtime = st.st_mtim;
+    return insert(std::move(entry));
+}
+
+void FileReadSessions::release(const std::string& key)
+{
+    auto search = sessions.find(key);
+    if (search == sessions.end())
+    {
+        return;
+    }
+    lru.erase(search->second);
+    sessions.erase(search);
+    if (lru.empty())
+    {
+        idleTimer.stop();
+    }
+}
+
+void FileReadSessions::clear()
+{
+    sessions.clear();
+    lru.clear();
+    idleTimer.stop();
+}
+
+const FileReadSessions::Session&
+    FileReadSessions::touch(Entries::iterator it)
+{
+    lru.splice(lru.begin(), lru, it);
+    it->lastUsed = Clock::now();
+    return it->session;
+}
+
+const FileReadSessions::Session& FileReadSessions::insert(Entry&& entry)
+{
+    if (lru.size() >= maxSessions)
+    {
+        sessions.erase(lru.back().key);
+        lru.pop_back();
+    }
+
+    entry.lastUsed = Clock::now();
+    lru.push_front(std::move(entry));
+    sessions.emplace(lru.front().key, lru.begin());
+    if (!idleTimer.isRunning())
+    {
+        idleTimer.start(idleTimeout);
+    }
+    return lru.front().session;
+}
+
+void FileReadSessions::expire()
+{
+    auto now = Clock::now();
+    while (!lru.empty() && now - lru.back().lastUsed >= idleTimeout)
+    {
+        sessions.erase(lru.back().key);
+        lru.pop_back();
+    }
+
+    if (!lru.empty())
+    {
+        // Fire again when the least recently used session becomes idle
+        idleTimer.start(std::chrono::duration_cast<std::chrono::microseconds>(
+            lru.back().lastUsed + idleTimeout - now));
+    }
+}
+
+int FileReadSessions::read(const Session& session, uint32_t fileHandle,
+                           uint32_t offset, uint32_t& length,
+                           Response& response)
+{
+    if (offset >= session.size)
+    {
+        error(
+            "Offset exceeds file size, OFFSET={OFFSET} FILE_SIZE={FILE_SIZE} FILE_HANDLE={FILE_HANDLE}",
+            "OFFSET", offset, "FILE_SIZE", session.size, "FILE_HANDLE",
+            fileHandle);
+        return PLDM_DATA_OUT_OF_RANGE;
+    }
+    if (offset + length > session.size)
+    {
+        length = session.size - offset;
+    }
+
+    size_t currSize = response.size();
+    response.resize(currSize + length);
+    auto filePos = reinterpret_cast<char*>(response.data()) + currSize;
+    size_t count = 0;
+    while (count < length)
+    {
+        auto rc = pread((*session.fd)(), filePos + count, length - count,
+                        offset + count);
+        if (rc == -1 && errno == EINTR)
+        {
+            continue;
+        }
+        if (rc <= 0)
+        {
+            error(
+                "File read failed, FILE_HANDLE={FILE_HANDLE} LENGTH={LEN} COUNT={COUNT} ERROR={ERR}",
+                "FILE_HANDLE", fileHandle, "LEN", length, "COUNT", count,
+                "ERR", rc == -1 ? errno : 0);
+            response.resize(currSize);
+            return PLDM_ERROR;
+        }
+        count += rc;
+    }
+    return PLDM_SUCCESS;
+}
+
+} // namespace responder
+} // namespace pldm
@@ -0,0 +1,164 @@
+#pragma once
+
+#include "common/types.hpp"
+#include "common/utils.hpp"
+
+#include <sys/stat.h>
+#include <sys/types.h>
+
+#include <sdbusplus/timer.hpp>
+
+#include <chrono>
+#include <filesystem>
+#include <functional>
+#include <list>
+#include <memory>
+#include <optional>
+#include <string>
+#include <unordered_map>
+
+namespace pldm
+{
+namespace responder
+{
+
+namespace fs = std::filesystem;
+
+/** @class FileReadSessions
+ *
+ *  @brief The host reads a file in chunks, one PLDM command per chunk, and a
+ *         new file handler is created for every command. The read sessions
+ *         keep the file descriptor of a file open across the chunks, so a
+ *         chunk is a single pread instead of a D-Bus call or an open per
+ *         command. The least recently used session is closed when there are
+ *         too many of them, and the sessions left idle are closed by a timer.
+ */
+class FileReadSessions
+{
+  public:
+    using Clock = std::chrono::steady_clock;
+
+    /** @brief Opens a file, returns a file descriptor owned by the session
+     *         or -1. May throw, the exception is passed to the caller.
+     */
+    using Opener = std::function<int()>;
+
+    /** @struct Session
+     *
+     *  An open file, the descriptor stays valid while it is held even if the
+     *  session is evicted
+     */
+    struct Session
+    {
+        std::shared_ptr<utils::CustomFD> fd;
+        off_t size = 0;
+    };
+
+    /** @brief Maximum number of files kept open */
+    static constexpr size_t maxSessions = 8;
+
+    /** @brief Time a session is kept open after its last read */
+    static constexpr auto idleTimeout = std::chrono::seconds(30);
+
+    FileReadSessions(const FileReadSessions&) = delete;
+    FileReadSessions(FileReadSessions&&) = delete;
+    FileReadSessions& operator=(const FileReadSessions&) = delete;
+    FileReadSessions& operator=(FileReadSessions&&) = delete;
+    ~FileReadSessions() = default;
+
+    /** @brief Get the read sessions of pldmd */
+    static FileReadSessions& get();
+
+    /** @brief Get the session of a file that is not on the file system, like
+     *         a PEL handed out by the logging daemon
+     *
+     *  @param[in] key - unique name of the file
+     *  @param[in] opener - opens the file if there is no session
+     *
+     *  @return the session, or nullopt if the file could not be opened
+     */
+    std::optional<Session> open(const std::string& key, const Opener& opener);
+
+    /** @brief Get the session of a file on the file system. The session is
+     *         reopened if the file was replaced or modified since it was
+     *         opened.
+     *
+     *  @param[in] path - path of the file
+     *
+     *  @return the session, or nullopt with errno set if the file could not be
+     *          opened
+     */
+    std::optional<Session> open(const fs::path& path);
+
+    /** @brief Close the session of a file, if any
+     *
+     *  @param[in] key - unique name or path of the file
+     */
+    void release(const std::string& key);
+
+    /** @brief Close all the sessions */
+    void clear();
+
+    /** @brief Number of open sessions */
+    size_t size() const
+    {
+        return sessions.size();
+    }
+
+    /** @brief Append a chunk of a file to a response
+     *
+     *  @param[in] session - session of the file
+     *  @param[in] fileHandle - file handle, for logging
+     *  @param[in] offset - offset of the chunk
+     *  @param[in/out] length - length of the chunk, trimmed to the end of the
+     *                          file
+     *  @param[out] response - the chunk is appended to it
+     *
+     *  @return PLDM status code
+     */
+    static int read(const Session& session, uint32_t fileHandle,
+                    uint32_t offset, uint32_t& length, Response& response);
+
+  private:
+    FileReadSessions();
+
+    /** @struct Entry
+     *
+     *  A session and what is needed to tell if it is stale
+     */
+    struct Entry
+    {
+        std::string key;
+        Session session;
+        bool isPath = false;
+        dev_t dev = 0;
+        ino_t ino = 0;
+        struct timespec mtime = {};
+        Clock::time_point lastUsed;
+    };
+
+    using Entries = std::list<Entry>;
+
+    /** @brief Move a session to the front of the LRU list and stamp it */
+    const Session& touch(Entries::iterator it);
+
+    /** @brief Add a session at the front of the LRU list, evicting the least
+     *         recently used one if needed
+     */
+    const Session& insert(Entry&& entry);
+
+    /** @brief Close the sessions idle for idleTimeout */
+    void expire();
+
+    /** @brief sessions from the most to the least recently used */
+    Entries lru;
+
+    /** @brief index of the sessions in lru */
+    std::unordered_map<std::string, Entries::iterator> sessions;
+
+    /** @brief closes the idle sessions */
+    phosphor::Timer idleTimer;
+};
+
+} // namespace responder
+} // namespace pldm
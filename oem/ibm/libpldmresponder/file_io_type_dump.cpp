@@ -276,6 +276,10 @@ int DumpHandler::writeFromMemory(uint32_t, uint32_t length, uint64_t address,
 
         DumpHandler::fd = sock;
         auto rc = transferFileDataToSocket(DumpHandler::fd, length, address);
+        if (rc == PLDM_ERROR_NOT_READY)
+        {
+            return rc;
+        }
         if (rc < 0)
         {
             error(
@@ -312,6 +316,10 @@ int DumpHandler::writeFromMemory(uint32_t, uint32_t length, uint64_t address,
     }
 
     auto rc = transferFileDataToSocket(DumpHandler::fd, length, address);
+    if (rc == PLDM_ERROR_NOT_READY)
+    {
+        return rc;
+    }
     if (rc < 0)
     {
         error("DumpHandler::writeFromMemory: transferFileDataToSocket failed");
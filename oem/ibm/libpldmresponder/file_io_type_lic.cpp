@@ -25,13 +25,11 @@ namespace responder
 {
 static constexpr auto codFilePath = "/var/lib/ibm/cod/";
 static constexpr auto licFilePath = "/var/lib/pldm/license/";
-constexpr auto newLicenseFile = "new_license.bin";
 constexpr auto newLicenseJsonFile = "new_license.json";
 
 int LicenseHandler::updateBinFileAndLicObjs(const fs::path& newLicJsonFilePath)
 {
     int rc = PLDM_SUCCESS;
-    fs::path newLicFilePath(fs::path(licFilePath) / newLicenseFile);
     std::ifstream jsonFileNew(newLicJsonFilePath);
 
     auto dataNew = Json::parse(jsonFileNew, nullptr, false);
@@ -42,11 +40,8 @@ int LicenseHandler::updateBinFileAndLicObjs(const fs::path& newLicJsonFilePath)
         throw InternalFailure();
     }
 
-    // Store the json data in a file with binary format
-    convertJsonToBinaryFile(dataNew, newLicFilePath);
-
-    // Create or update the license objects
-    rc = createOrUpdateLicenseObjs();
+    // Update the license store and the license objects
+    rc = createOrUpdateLicenseObjs(dataNew);
     if (rc != PLDM_SUCCESS)
     {
         error("createOrUpdateLicenseObjs failed with rc= {RC}", "RC", rc);
@@ -171,28 +171,104 @@ class LidHandler : public FileHandler
         }
     }
 
+    /** @brief Method to set the LID path to the staging directory, when the
+     *         LID is part of an inband code update or is the marker LID
+     *  @param[in] oemPlatformHandler - OEM platform handler
+     *  @return bool - true if the LID goes through the staging directory
+     */
+    bool constructStagingPath(oem_platform::Handler* oemPlatformHandler)
+    {
+        if (oemPlatformHandler == nullptr)
+        {
+            return false;
+        }
+        pldm::responder::oem_ibm_platform::Handler* oemIbmPlatformHandler =
+            dynamic_cast<pldm::responder::oem_ibm_platform::Handler*>(
+                oemPlatformHandler);
+        if (!oemIbmPlatformHandler->codeUpdate->isCodeUpdateInProgress() &&
+            lidType != PLDM_FILE_TYPE_LID_MARKER)
+        {
+            return false;
+        }
+        std::string dir = LID_STAGING_DIR;
+        std::stringstream stream;
+        stream << std::hex << fileHandle;
+        auto lidName = stream.str() + ".lid";
+        lidPath = std::move(dir) + '/' + lidName;
+        return true;
+    }
+
+    /** @brief Method to finish a LID of the staging directory once its last
+     *         chunk is written: the body is checked and stored without the
+     *         header, and the marker LID is validated
+     *  @param[in] sink - sink of the LID
+     *  @param[in] rc - status of the write of the chunk
+     *  @param[in] length - length of the chunk
+     *  @param[in] oemPlatformHandler - OEM platform handler
+     *  @return PLDM status code
+     */
+    int processLidChunk(LidSink& sink, int rc, uint32_t length,
+                        oem_platform::Handler* oemPlatformHandler)
+    {
+        if (rc != PLDM_SUCCESS)
+        {
+            error("Failed to write the LID {LID_PATH}, RC={RC}", "LID_PATH",
+                  lidPath.c_str(), "RC", rc);
+            sink.abort();
+            releaseLidSink(fileHandle);
+            return rc;
+        }
+        if (lidType == PLDM_FILE_TYPE_LID_MARKER)
+        {
+            markerLIDremainingSize -= length;
+        }
+
+        bool done = false;
+        if (sink.staging())
+        {
+            // The LID is processed from its staging file like before
+            if (lidType == PLDM_FILE_TYPE_LID_MARKER &&
+                markerLIDremainingSize != 0)
+            {
+                return PLDM_SUCCESS;
+            }
+            rc = processCodeUpdateLid(lidPath);
+            done = lidType == PLDM_FILE_TYPE_LID_MARKER ||
+                   rc != PLDM_SUCCESS || !fs::exists(lidPath);
+        }
+        else if (sink.complete())
+        {
+            rc = sink.finish();
+            done = true;
+        }
+
+        if (done)
+        {
+            releaseLidSink(fileHandle);
+            if (rc == PLDM_SUCCESS && lidType == PLDM_FILE_TYPE_LID_MARKER)
+            {
+                validateMarkerLid(oemPlatformHandler);
+            }
+        }
+        return rc;
+    }
+
     virtual int writeFromMemory(uint32_t offset, uint32_t length,
                                 uint64_t address,
                                 oem_platform::Handler* oemPlatformHandler)
     {
         int rc = PLDM_SUCCESS;
-        bool codeUpdateInProgress = false;
-        if (oemPlatformHandler != nullptr)
+        if (constructStagingPath(oemPlatformHandler))
         {
-            pldm::responder::oem_ibm_platform::Handler* oemIbmPlatformHandler =
-                dynamic_cast<pldm::responder::oem_ibm_platform::Handler*>(
-                    oemPlatformHandler);
-            codeUpdateInProgress =
-                oemIbmPlatformHandler->codeUpdate->isCodeUpdateInProgress();
-            if (codeUpdateInProgress || lidType == PLDM_FILE_TYPE_LID_MARKER)
-            {
-                std::string dir = LID_STAGING_DIR;
-                std::stringstream stream;
-                stream << std::hex << fileHandle;
-                auto lidName = stream.str() + ".lid";
-                lidPath = std::move(dir) + '/' + lidName;
-            }
+            auto& sink = getLidSink(fileHandle, lidPath);
+            rc = transferFileData(
+                [&sink](uint32_t chunkOffset, const uint8_t* data,
+                        uint32_t chunkLength) {
+                return sink.write(chunkOffset, data, chunkLength);
+            }, offset, length, address);
+            return processLidChunk(sink, rc, length, oemPlatformHandler);
         }
+
         bool fileExists = fs::exists(lidPath);
         int flags{};
         if (fileExists)
@@ -216,23 +292,6 @@ class LidHandler : public FileHandler
         if (rc != PLDM_SUCCESS)
         {
             error("writeFileFromMemory failed with rc= {RC}", "RC", rc);
-            return rc;
-        }
-        if (lidType == PLDM_FILE_TYPE_LID_MARKER)
-        {
-            markerLIDremainingSize -= length;
-            if (markerLIDremainingSize == 0)
-            {
-                rc = processCodeUpdateLid(lidPath);
-                if (rc == PLDM_SUCCESS)
-                {
-                    validateMarkerLid(oemPlatformHandler);
-                }
-            }
-        }
-        else if (codeUpdateInProgress)
-        {
-            rc = processCodeUpdateLid(lidPath);
         }
         return rc;
     }
@@ -253,23 +312,14 @@ class LidHandler : public FileHandler
                       struct fileack_status_metadata& /*metaDataObj*/)
     {
         int rc = PLDM_SUCCESS;
-        bool codeUpdateInProgress = false;
-        if (oemPlatformHandler != nullptr)
+        if (constructStagingPath(oemPlatformHandler))
         {
-            pldm::responder::oem_ibm_platform::Handler* oemIbmPlatformHandler =
-                dynamic_cast<pldm::responder::oem_ibm_platform::Handler*>(
-                    oemPlatformHandler);
-            codeUpdateInProgress =
-                oemIbmPlatformHandler->codeUpdate->isCodeUpdateInProgress();
-            if (codeUpdateInProgress || lidType == PLDM_FILE_TYPE_LID_MARKER)
-            {
-                std::string dir = LID_STAGING_DIR;
-                std::stringstream stream;
-                stream << std::hex << fileHandle;
-                auto lidName = stream.str() + ".lid";
-                lidPath = std::move(dir) + '/' + lidName;
-            }
+            auto& sink = getLidSink(fileHandle, lidPath);
+            rc = sink.write(offset, reinterpret_cast<const uint8_t*>(buffer),
+                            length);
+            return processLidChunk(sink, rc, length, oemPlatformHandler);
         }
+
         bool fileExists = fs::exists(lidPath);
         int flags{};
         if (fileExists)
@@ -326,23 +376,6 @@ class LidHandler : public FileHandler
         }
         close(fd);
 
-        if (lidType == PLDM_FILE_TYPE_LID_MARKER)
-        {
-            markerLIDremainingSize -= length;
-            if (markerLIDremainingSize == 0)
-            {
-                rc = processCodeUpdateLid(lidPath);
-                if (rc == PLDM_SUCCESS)
-                {
-                    validateMarkerLid(oemPlatformHandler);
-                }
-            }
-        }
-        else if (codeUpdateInProgress)
-        {
-            rc = processCodeUpdateLid(lidPath);
-        }
-
         return rc;
     }
 
@@ -3,6 +3,7 @@
 #include "libpldm/base.h"
 #include "libpldm/file_io.h"
 
+#include "common/dbus_async.hpp"
 #include "common/utils.hpp"
 #include "host-bmc/dbus/custom_dbus.hpp"
 #include "host-bmc/dbus/serialize.hpp"
@@ -12,7 +13,6 @@
 #include <phosphor-logging/lg2.hpp>
 
 #include <iostream>
-#include <ranges>
 
 PHOSPHOR_LOG2_USING;
 
@@ -26,41 +26,36 @@ constexpr auto cableInfoFile = "cableinfo";
 constexpr auto itemPCIeSlot = "xyz.openbmc_project.Inventory.Item.PCIeSlot";
 constexpr auto itemPCIeDevice = "xyz.openbmc_project.Inventory.Item.PCIeDevice";
 constexpr auto itemConnector = "xyz.openbmc_project.Inventory.Item.Connector";
-
-// Slot location code structure contains multiple slot location code
-// suffix structures.
-// Each slot location code suffix structure is as follows
-// {Slot location code suffix size(uint8_t),
-//  Slot location code suffix(variable size)}
-constexpr auto sizeOfSuffixSizeDataMember = 1;
-
-// Each slot location structure contains
-// {
-//   Number of slot location codes (1byte),
-//   Slot location code Common part size (1byte)
-//   Slot location common part (Var)
-// }
-constexpr auto slotLocationDataMemberSize = 2;
+constexpr auto locationCodeIface =
+    "xyz.openbmc_project.Inventory.Decorator.LocationCode";
 
 namespace fs = std::filesystem;
+
+namespace
+{
+
+/** @brief Key of an object by kind and location code */
+std::string locationKey(std::string_view kind, std::string_view locationCode)
+{
+    std::string key;
+    key.reserve(kind.size() + 1 + locationCode.size());
+    key.append(kind).append(1, '\0').append(locationCode);
+    return key;
+}
+
+} // namespace
+
 std::unordered_map<uint16_t, bool> PCIeInfoHandler::receivedFiles;
-std::unordered_map<linkId_t,
-                   std::tuple<linkStatus_t, linkType_t, linkSpeed_t,
-                              linkWidth_t, pcieHostBidgeloc_t, localport_t,
-                              remoteport_t, io_slot_location_t, linkId_t>>
-    PCIeInfoHandler::topologyInformation;
-std::unordered_map<
-    cable_link_no_t,
-    std::tuple<linkId_t, local_port_loc_code_t, io_slot_location_code_t,
-               cable_part_no_t, cable_length_t, cable_type_t, cable_status_t>>
-    PCIeInfoHandler::cableInformation;
+pcie::TopologyModel PCIeInfoHandler::topology;
 std::map<std::string,
          std::tuple<uint16_t, std::string, std::optional<std::string>>>
     PCIeInfoHandler::mexObjectMap;
-
-std::vector<std::string> PCIeInfoHandler::cables;
-std::vector<std::pair<linkId_t, linkId_t>> PCIeInfoHandler::needPostProcessing;
-std::unordered_map<linkId_t, linkType_t> PCIeInfoHandler::linkTypeInfo;
+std::unordered_map<std::string, std::string> PCIeInfoHandler::mexLocations;
+std::unordered_map<std::string, std::string> PCIeInfoHandler::inventoryObjects;
+pldm::utils::ObjectValueTree PCIeInfoHandler::inventory;
+std::map<std::string, PCIeInfoHandler::CableState> PCIeInfoHandler::cables;
+std::vector<linkId_t> PCIeInfoHandler::needPostProcessing;
+pcie::PropertyState PCIeInfoHandler::properties;
 
 PCIeInfoHandler::PCIeInfoHandler(uint32_t fileHandle, uint16_t fileType) :
     FileHandler(fileHandle), infoType(fileType)
@@ -152,24 +147,13 @@ int PCIeInfoHandler::fileAck(uint8_t /*fileStatus*/)
 
             getMexObjects();
 
-            // delete the cable dbus as the cable are dynamic
+            getInventoryObjects();
 
-            for (const auto& cable : cables)
-            {
-                error("Removing cable object [ {CABLE} ]", "CABLE", cable);
-                pldm::dbus::CustomDBus::getCustomDBus().deleteObject(cable);
-            }
-            cables.clear();
-
-            // set topology properties & host cable dbus objects
+            // set topology properties & host cable dbus objects, the
+            // topology property is set back to false once the properties
+            // are set
             setTopologyAttrsOnDbus();
 
-            // even when we fail to parse /set the topology infromation on to
-            // the dbus, we need to set the property back to false - to allow
-            // the redfish/user to be able to ask the topology information again
-            pldm::dbus::CustomDBus::getCustomDBus().updateTopologyProperty(
-                false);
-
             // clear all the cached information
             clearTopologyInfo();
         }
@@ -183,23 +167,8 @@ void PCIeInfoHandler::setProperty(
     const pldm::utils::PropertyValue& propertyValue,
     const std::string& interfaceName, const std::string& propertyType)
 {
-    pldm::utils::PropertyValue value = propertyValue;
-    pldm::utils::DBusMapping dbusMapping;
-    dbusMapping.objectPath = objPath;
-    dbusMapping.interface = interfaceName;
-    dbusMapping.propertyName = propertyName;
-    dbusMapping.propertyType = propertyType;
-    try
-    {
-        pldm::utils::DBusHandler().setDbusProperty(dbusMapping, value);
-    }
-    catch (const std::exception& e)
-    {
-        error(
-            "Failed To set {PROP_NAME} property and path :{OBJ_PATH}, ERROR={ERR_EXCEP}",
-            "PROP_NAME", propertyName, "OBJ_PATH", objPath.c_str(), "ERR_EXCEP",
-            e.what());
-    }
+    properties.set(pcie::PropertyUpdate{
+        {objPath, interfaceName, propertyName, propertyType}, propertyValue});
 }
 
 void PCIeInfoHandler::getMexObjects()
@@ -252,26 +221,102 @@ void PCIeInfoHandler::getMexObjects()
             }
         }
     }
+
+    // Index the objects by location code, the logical slots are found as
+    // slots and the first object of a location code is kept
+    mexLocations.clear();
+    for (const auto& [objectPath, obj] : mexObjectMap)
+    {
+        const auto& [entityType, propertyName, locationCode] = obj;
+        if (propertyName == "locationCode" && locationCode.has_value())
+        {
+            mexLocations.try_emplace(
+                locationKey(std::to_string(entityType & ~0x8000),
+                            *locationCode),
+                objectPath);
+        }
+    }
 }
 
 std::string PCIeInfoHandler::getMexObjectFromLocationCode(
-    const std::string& locationCode, uint16_t entityType)
+    std::string_view locationCode, uint16_t entityType)
 {
-    for (const auto& [objectPath, obj] : mexObjectMap)
+    auto object = mexLocations.find(locationKey(std::to_string(entityType),
+                                                locationCode));
+    return object == mexLocations.end() ? "" : object->second;
+}
+
+void PCIeInfoHandler::getInventoryObjects()
+{
+    inventoryObjects.clear();
+    inventory.clear();
+
+    // The inventory is read at each refresh, its properties are the current
+    // values the properties of the refresh are compared with
+    try
     {
-        // Added the check for logical entity type
-        if (((std::get<0>(obj) == entityType) ||
-             (std::get<0>(obj) == (0x8000 | entityType))) &&
-            (std::get<1>(obj) == "locationCode"))
+        inventory = pldm::utils::DBusHandler::getManagedObj(
+            pldm::utils::inventoryService, pldm::utils::inventoryPath);
+    }
+    catch (const std::exception& e)
+    {
+        error("Look up of inventory objects failed, ERROR={ERR_EXCEP}",
+              "ERR_EXCEP", e.what());
+        return;
+    }
+
+    // One pass over the inventory resolves the location codes of all the
+    // links, the first object of a location code is kept
+    for (const auto& [objectPath, interfaces] : inventory)
+    {
+        auto location = interfaces.find(locationCodeIface);
+        if (location == interfaces.end())
         {
-            if ((std::get<2>(obj)).has_value() &&
-                (std::get<2>(obj)).value() == locationCode)
+            continue;
+        }
+        auto property = location->second.find("LocationCode");
+        if (property == location->second.end())
+        {
+            continue;
+        }
+        auto locationCode = std::get_if<std::string>(&property->second);
+        if (!locationCode)
+        {
+            continue;
+        }
+        for (const auto& itemType :
+             {itemPCIeSlot, itemPCIeDevice, itemConnector})
+        {
+            if (interfaces.contains(itemType))
             {
-                return objectPath;
+                inventoryObjects.try_emplace(
+                    locationKey(itemType, *locationCode), objectPath.str);
             }
         }
     }
-    return "";
+}
+
+std::string PCIeInfoHandler::getInventoryObject(std::string_view locationCode,
+                                                const std::string& itemType)
+{
+    auto object = inventoryObjects.find(locationKey(itemType, locationCode));
+    if (object == inventoryObjects.end())
+    {
+        error("Location not found {LOC_CODE} for Item type {INVEN_ITEM_TYP}",
+              "LOC_CODE", std::string(locationCode), "INVEN_ITEM_TYP",
+              itemType);
+        return "";
+    }
+    return object->second;
+}
+
+std::pair<std::string, std::string> PCIeInfoHandler::getSlotAndAdapterFromPort(
+    std::string_view portLocationCode)
+{
+    std::filesystem::path portPath = getInventoryObject(portLocationCode,
+                                                        itemConnector);
+    return std::make_pair(portPath.parent_path().parent_path(),
+                          portPath.parent_path());
 }
 
 std::string
@@ -442,14 +487,16 @@ void PCIeInfoHandler::setTopologyOnSlotAndAdapter(
         }
     }
 }
-void PCIeInfoHandler::parsePrimaryLink(
-    uint8_t linkType, const io_slot_location_t& ioSlotLocationCode,
-    const localport_t& localPortLocation, const uint32_t& linkId,
-    const std::string& linkStatus, uint8_t linkSpeed, int64_t linkWidth,
-    uint8_t parentLinkId)
+void PCIeInfoHandler::parsePrimaryLink(const pcie::Link& link,
+                                       uint8_t linkType)
 {
+    auto slots = topology.getSlots(link);
+    auto localPort = topology.str(link.localTop);
+    auto linkStatus = link_state_map[link.status];
+    auto linkWidth = link_width[link.width];
+
     // Check the io_slot_location_code size
-    if (!ioSlotLocationCode.size())
+    if (slots.empty())
     {
         // If there is no io slot location code populated
         // then its a cable card that in plugged into one of the
@@ -458,57 +505,51 @@ void PCIeInfoHandler::parsePrimaryLink(
 
         // check the local port and from there obtain the
         // pcie slot information
-        if (!localPortLocation.first.empty())
+        if (!localPort.empty())
         {
             // the local port field can be filled up with slot location
             // code (for the links that have connections to flett)
-            if (localPortLocation.first.find("-T") != std::string::npos)
+            if (localPort.find("-T") != std::string_view::npos)
             {
                 // the top local port is populated with the connector
-                auto slotAndAdapter = pldm::responder::utils::getSlotAndAdapter(
-                    localPortLocation.first);
-                setTopologyOnSlotAndAdapter(linkType, slotAndAdapter, linkId,
-                                            linkStatus, linkSpeed, linkWidth,
+                auto slotAndAdapter = getSlotAndAdapterFromPort(localPort);
+                setTopologyOnSlotAndAdapter(linkType, slotAndAdapter, link.id,
+                                            linkStatus, link.speed, linkWidth,
                                             false);
             }
             else
             {
                 // the slot location code is present in the local port
                 // location code field
-                std::string slotObjectPath =
-                    pldm::responder::utils::getObjectPathByLocationCode(
-                        localPortLocation.first, itemPCIeSlot);
+                std::string slotObjectPath = getInventoryObject(localPort,
+                                                                itemPCIeSlot);
 
                 // get the adapter with the same location code
                 std::string adapterObjPath =
-                    pldm::responder::utils::getObjectPathByLocationCode(
-                        localPortLocation.first, itemPCIeDevice);
+                    getInventoryObject(localPort, itemPCIeDevice);
 
                 // set topology info on both the slot and adapter object
                 setTopologyOnSlotAndAdapter(
                     linkType, std::make_pair(slotObjectPath, adapterObjPath),
-                    linkId, linkStatus, linkSpeed, linkWidth, false);
+                    link.id, linkStatus, link.speed, linkWidth, false);
             }
         }
     }
-    else if (ioSlotLocationCode.size() == 1)
+    else if (slots.size() == 1)
     {
         // If there is just a single slot location code populated
         // then its a clean link that tells that something is
         // plugged into a CEC PCIeSlot
-        std::string slotObjectPath =
-            pldm::responder::utils::getObjectPathByLocationCode(
-                ioSlotLocationCode[0], itemPCIeSlot);
+        auto slot = topology.str(slots[0]);
+        std::string slotObjectPath = getInventoryObject(slot, itemPCIeSlot);
 
         // get the adapter with the same location code
-        std::string adapterObjPath =
-            pldm::responder::utils::getObjectPathByLocationCode(
-                ioSlotLocationCode[0], itemPCIeDevice);
+        std::string adapterObjPath = getInventoryObject(slot, itemPCIeDevice);
 
         // set topology info on both the slot and adapter object
         setTopologyOnSlotAndAdapter(
-            linkType, std::make_pair(slotObjectPath, adapterObjPath), linkId,
-            linkStatus, linkSpeed, linkWidth, false);
+            linkType, std::make_pair(slotObjectPath, adapterObjPath), link.id,
+            linkStatus, link.speed, linkWidth, false);
     }
     else
     {
@@ -516,72 +557,69 @@ void PCIeInfoHandler::parsePrimaryLink(
         // slot connected to a pcie switch or a flett. This link would need
         // additional processing - as we need to check the parent link of this
         // to figure out the slot and the adapter
-        if (!localPortLocation.first.empty())
+        if (!localPort.empty())
         {
             // we have a io slot location code (probably mex or cec), but its a
             // primary link and if we have local ports , then figure out which
             // slot it is connected to
-            if (localPortLocation.first.find("-T") != std::string::npos)
+            if (localPort.find("-T") != std::string_view::npos)
             {
-                auto slotAndAdapter = pldm::responder::utils::getSlotAndAdapter(
-                    localPortLocation.first);
+                auto slotAndAdapter = getSlotAndAdapterFromPort(localPort);
 
-                setTopologyOnSlotAndAdapter(linkType, slotAndAdapter, linkId,
-                                            linkStatus, linkSpeed, linkWidth,
+                setTopologyOnSlotAndAdapter(linkType, slotAndAdapter, link.id,
+                                            linkStatus, link.speed, linkWidth,
                                             false);
             }
             else
             {
                 // check if it is a cec slot first
-                std::string slotObjectPath =
-                    pldm::responder::utils::getObjectPathByLocationCode(
-                        localPortLocation.first, itemPCIeSlot);
+                std::string slotObjectPath = getInventoryObject(localPort,
+                                                                itemPCIeSlot);
 
                 // get the adapter with the same location code
                 std::string adapterObjPath =
-                    pldm::responder::utils::getObjectPathByLocationCode(
-                        localPortLocation.first, itemPCIeDevice);
+                    getInventoryObject(localPort, itemPCIeDevice);
 
                 if (slotObjectPath.empty())
                 {
                     // check if it is a mex slot
                     // if its a slot, then
-                    slotObjectPath =
-                        pldm::responder::utils::getObjectPathByLocationCode(
-                            ioSlotLocationCode[0], itemPCIeSlot);
+                    auto slot = topology.str(slots[0]);
+                    slotObjectPath = getInventoryObject(slot, itemPCIeSlot);
 
                     // get the adapter with the same location code
-                    adapterObjPath =
-                        pldm::responder::utils::getObjectPathByLocationCode(
-                            ioSlotLocationCode[0], itemPCIeDevice);
+                    adapterObjPath = getInventoryObject(slot, itemPCIeDevice);
                 }
 
                 // set topology info on both the slot and adapter object
                 setTopologyOnSlotAndAdapter(
                     linkType, std::make_pair(slotObjectPath, adapterObjPath),
-                    linkId, linkStatus, linkSpeed, linkWidth, false);
+                    link.id, linkStatus, link.speed, linkWidth, false);
             }
         }
         else
         {
             // If there is no local port populated & the io slots are multiple,
             // we would need futher processing for this link
-            needPostProcessing.emplace_back(linkId, parentLinkId);
+            needPostProcessing.push_back(link.id);
         }
     }
 }
-void PCIeInfoHandler::parseSecondaryLink(
-    uint8_t linkType, const io_slot_location_t& ioSlotLocationCode,
-    const localport_t& /*localPortLocation*/,
-    const remoteport_t& remotePortLocation, const uint32_t& linkId,
-    const std::string& linkStatus, uint8_t linkSpeed, int64_t linkWidth)
+
+void PCIeInfoHandler::parseSecondaryLink(const pcie::Link& link,
+                                         uint8_t linkType)
 {
-    if (ioSlotLocationCode.size() == 1)
+    auto slots = topology.getSlots(link);
+    auto linkStatus = link_state_map[link.status];
+    auto linkWidth = link_width[link.width];
+
+    if (slots.size() == 1)
     {
         // if the slot location code is present, it can be either a mex slot or
         // an nvme slot
+        auto slot = topology.str(slots[0]);
         std::string mexSlotpath = getMexObjectFromLocationCode(
-            ioSlotLocationCode[0], PLDM_ENTITY_SLOT);
+            slot, PLDM_ENTITY_SLOT);
 
         if (!mexSlotpath.empty())
         {
@@ -590,36 +628,34 @@ void PCIeInfoHandler::parseSecondaryLink(
             {
                 setTopologyOnSlotAndAdapter(
                     linkType, std::make_pair(mexSlotpath, mexAdapterpath),
-                    linkId, linkStatus, linkSpeed, linkWidth, true);
+                    link.id, linkStatus, link.speed, linkWidth, true);
             }
         }
         else
         {
             // its not a mex slot , check if it matches with any of the CEC nvme
             // slots
-            std::string slotObjectPath =
-                pldm::responder::utils::getObjectPathByLocationCode(
-                    ioSlotLocationCode[0], itemPCIeSlot);
+            std::string slotObjectPath = getInventoryObject(slot,
+                                                            itemPCIeSlot);
 
             // get the adapter with the same location code
-            std::string adapterObjPath =
-                pldm::responder::utils::getObjectPathByLocationCode(
-                    ioSlotLocationCode[0], itemPCIeDevice);
+            std::string adapterObjPath = getInventoryObject(slot,
+                                                            itemPCIeDevice);
 
             // set topology info on both the slot and adapter object
             setTopologyOnSlotAndAdapter(
                 linkType, std::make_pair(slotObjectPath, adapterObjPath),
-                linkId, linkStatus, linkSpeed, linkWidth, false);
+                link.id, linkStatus, link.speed, linkWidth, false);
         }
     }
-    else if (ioSlotLocationCode.size() > 1)
+    else if (slots.size() > 1)
     {
         // its a secondary link (first one that explains that the link is
         // between a pcie switch in side the cable card to a mex drawer use the
         // remote port location code to figure out the mex slot
 
         std::string mexConnecterPath = getMexObjectFromLocationCode(
-            remotePortLocation.first, PLDM_ENTITY_CONNECTOR);
+            topology.str(link.remoteTop), PLDM_ENTITY_CONNECTOR);
 
         std::filesystem::path mexConnecter(mexConnecterPath);
         auto mexSlotandAdapter = getMexSlotandAdapter(mexConnecter);
@@ -628,47 +664,42 @@ void PCIeInfoHandler::parseSecondaryLink(
              "MEX_SLOT_ADAPTER", std::get<1>(mexSlotandAdapter));
         std::vector<std::tuple<std::string, std::string, std::string>>
             associations;
-        for (auto slot : ioSlotLocationCode)
+        associations.reserve(slots.size());
+        for (const auto& slot : slots)
         {
             associations.emplace_back(
                 "containing", "contained_by",
-                getMexObjectFromLocationCode(slot, PLDM_ENTITY_SLOT));
+                getMexObjectFromLocationCode(topology.str(slot),
+                                             PLDM_ENTITY_SLOT));
         }
 
         pldm::dbus::CustomDBus::getCustomDBus().setAssociations(
             std::get<1>(mexSlotandAdapter), associations);
 
         // set topology info on both the slot and adapter object
-        setTopologyOnSlotAndAdapter(linkType, mexSlotandAdapter, linkId,
-                                    linkStatus, linkSpeed, linkWidth, true);
+        setTopologyOnSlotAndAdapter(linkType, mexSlotandAdapter, link.id,
+                                    linkStatus, link.speed, linkWidth, true);
     }
 }
 
-void PCIeInfoHandler::parseSpeciallink(linkId_t linkId,
-                                       linkId_t /*parentLinkId*/)
+void PCIeInfoHandler::parseSpeciallink(const pcie::Link& link)
 {
-    auto linkInfo = topologyInformation[linkId];
-    for (const auto& [link, info] : topologyInformation)
+    // if any link has the link that needs post processing as the parent link,
+    // then check if that link has local port location codes populated
+    for (const auto& child : topology.children(link.id))
     {
-        // if any link has linkId(that link that needs post processing) as the
-        // parent link id, then check if that link has local port location codes
-        // populated
-        if (std::get<8>(info) == linkId)
+        auto localPort = topology.str(child->localTop);
+        if (!localPort.empty())
         {
-            auto localPortLocCode = std::get<5>(info);
-            if (!localPortLocCode.first.empty())
-            {
-                // local port location code is present, using the port to find
-                // out the slot
-                auto slotAndAdapter = pldm::responder::utils::getSlotAndAdapter(
-                    localPortLocCode.first);
-                error("Special processing for link - [{LINK_ID}]", "LINK_ID",
-                      linkId);
-                setTopologyOnSlotAndAdapter(
-                    std::get<1>(linkInfo), slotAndAdapter, linkId,
-                    std::get<0>(linkInfo), std::get<2>(linkInfo),
-                    std::get<3>(linkInfo), false);
-            }
+            // local port location code is present, using the port to find
+            // out the slot
+            auto slotAndAdapter = getSlotAndAdapterFromPort(localPort);
+            error("Special processing for link - [{LINK_ID}]", "LINK_ID",
+                  link.id);
+            setTopologyOnSlotAndAdapter(link.type, slotAndAdapter, link.id,
+                                        link_state_map[link.status],
+                                        link.speed, link_width[link.width],
+                                        false);
         }
     }
 }
@@ -677,121 +708,180 @@ void PCIeInfoHandler::setTopologyAttrsOnDbus()
 {
     // Core Topology Algorithm
     // Iterate through each link and set the link attributes
-    for (const auto& [link, info] : topologyInformation)
+    for (const auto& link : topology.getLinks())
     {
-        // Link type can be either Primary/Secondary/Unkown
-        switch (std::get<1>(info))
+        if (link.type == Unknown)
+        {
+            error("link type is unkown : {LINK}", "LINK", (unsigned)link.id);
+        }
+
+        // Link type can be either Primary/Secondary, a link of unknown type
+        // takes the type last reported for it
+        switch (topology.linkType(link))
         {
             // If the link is primary
             case Primary:
-                parsePrimaryLink(std::get<1>(info), std::get<7>(info),
-                                 std::get<5>(info), static_cast<uint32_t>(link),
-                                 std::get<0>(info), std::get<2>(info),
-                                 std::get<3>(info), std::get<8>(info));
+                parsePrimaryLink(link, topology.linkType(link));
                 break;
             case Secondary:
-                parseSecondaryLink(
-                    std::get<1>(info), std::get<7>(info), std::get<5>(info),
-                    std::get<6>(info), static_cast<uint32_t>(link),
-                    std::get<0>(info), std::get<2>(info), std::get<3>(info));
+                parseSecondaryLink(link, topology.linkType(link));
                 break;
-            case Unknown:
-                error("link type is unkown : {LINK}", "LINK", (unsigned)link);
-                switch (linkTypeInfo[link])
-                {
-                    case Primary:
-                        parsePrimaryLink(linkTypeInfo[link], std::get<7>(info),
-                                         std::get<5>(info),
-                                         static_cast<uint32_t>(link),
-                                         std::get<0>(info), std::get<2>(info),
-                                         std::get<3>(info), std::get<8>(info));
-                        break;
-                    case Secondary:
-                        parseSecondaryLink(
-                            linkTypeInfo[link], std::get<7>(info),
-                            std::get<5>(info), std::get<6>(info),
-                            static_cast<uint32_t>(link), std::get<0>(info),
-                            std::get<2>(info), std::get<3>(info));
-                        break;
-                }
         }
     }
 
     // There are few special links that needs post processing
-    for (const auto& link : needPostProcessing)
+    for (const auto& linkId : needPostProcessing)
     {
-        parseSpeciallink(link.first, link.second);
+        parseSpeciallink(*topology.find(linkId));
     }
 
+    setCablesOnDbus();
+
+    applyProperties();
+}
+
+void PCIeInfoHandler::setCablesOnDbus()
+{
     std::filesystem::path cableBasePath =
         "/xyz/openbmc_project/inventory/system";
-    // Create Cable Dbus objects
-    for (const auto& [cable_no, info] : cableInformation)
+    auto& customDBus = pldm::dbus::CustomDBus::getCustomDBus();
+
+    std::map<std::string, CableState> hostedCables;
+    for (const auto& cable : topology.getCables())
     {
         std::filesystem::path cableObjectPath(cableBasePath);
-        cableObjectPath /= "external_cable_" + std::to_string(cable_no);
+        cableObjectPath /= "external_cable_" + std::to_string(cable.number);
+        auto path = cableObjectPath.string();
+
+        // Frame the necessary associations on each cable
+        // upstream port - connecter on CEC pcie adapter
+        // downstream port - connecter on mex io module
+        // downstream chassis - the mex chassis this cable is plugged into
+        CableState state{std::string(topology.str(cable.partNumber)),
+                         cable.length,
+                         cable.type,
+                         cable.status,
+                         getInventoryObject(topology.str(cable.hostPort),
+                                            itemConnector),
+                         getMexObjectFromLocationCode(
+                             topology.str(cable.ioPort), PLDM_ENTITY_CONNECTOR),
+                         {}};
+        state.downstreamChassis = getDownStreamChassis(state.downstream);
+
+        // A cable that did not change is left as it is, a cable that changed
+        // is hosted again so that its associations are replaced
+        auto hosted = cables.find(path);
+        if (hosted != cables.end())
+        {
+            if (hosted->second == state)
+            {
+                hostedCables.emplace(path, std::move(state));
+                continue;
+            }
+            customDBus.deleteObject(path);
+        }
 
         // Implement Item.Cable Interface on it
-        pldm::dbus::CustomDBus::getCustomDBus().implementCableInterface(
-            cableObjectPath.string());
+        customDBus.implementCableInterface(path);
 
         // Implement Inventory.Item Interface on it
-        pldm::dbus::CustomDBus::getCustomDBus().updateItemPresentStatus(
-            cableObjectPath.string(), true);
+        customDBus.updateItemPresentStatus(path, true);
 
         // Implement Inventory.Decorator.Asset on it
-        pldm::dbus::CustomDBus::getCustomDBus().implementAssetInterface(
-            cableObjectPath.string());
+        customDBus.implementAssetInterface(path);
 
         // set the part Number on the asset interface
-        pldm::dbus::CustomDBus::getCustomDBus().setPartNumber(
-            cableObjectPath.string(), std::get<3>(info));
+        customDBus.setPartNumber(path, state.partNumber);
 
         // Set all the cable attributes on the object
-        pldm::dbus::CustomDBus::getCustomDBus().setCableAttributes(
-            cableObjectPath.string(), std::get<4>(info), std::get<5>(info),
-            std::get<6>(info));
+        customDBus.setCableAttributes(path, cable_length_map[cable.length],
+                                      cable_type_map[cable.type],
+                                      cable_status_map[cable.status]);
 
-        // Frame the necessary associations on each cable
-        // upstream port - connecter on CEC pcie adapter
-        // downstream port - connecter on mex io module
-        // downstream chassis - the mex chassis this cable is plugged into
-        auto upstreamInformation =
-            pldm::responder::utils::getObjectPathByLocationCode(
-                std::get<1>(info), itemConnector);
-        auto downstreamInformation = getMexObjectFromLocationCode(
-            std::get<2>(info), PLDM_ENTITY_CONNECTOR);
-        auto downstreamChassis = getDownStreamChassis(downstreamInformation);
         std::vector<std::tuple<std::string, std::string, std::string>>
             associations{
-                {"upstream_connector", "attached_cables", upstreamInformation},
-                {"downstream_connector", "attached_cables",
-                 downstreamInformation},
-                {"downstream_chassis", "attached_cables", downstreamChassis}};
+                {"upstream_connector", "attached_cables", state.upstream},
+                {"downstream_connector", "attached_cables", state.downstream},
+                {"downstream_chassis", "attached_cables",
+                 state.downstreamChassis}};
 
-        pldm::dbus::CustomDBus::getCustomDBus().setAssociations(
-            cableObjectPath.string(), associations);
+        customDBus.setAssociations(path, associations);
         error(
             "Hosted Cable [ {CABLE_NO} ] Length - [ {LEN} ] Type - [ {CABLE_TYP} ] Status - [ {CABLE_STATUS} ] PN - [ {PN} ]",
-            "CABLE_NO", cable_no, "LEN", std::get<4>(info), "CABLE_TYP",
-            std::get<5>(info), "CABLE_STATUS", std::get<6>(info), "PN",
-            std::get<3>(info));
+            "CABLE_NO", cable.number, "LEN", cable_length_map[cable.length],
+            "CABLE_TYP", cable_type_map[cable.type], "CABLE_STATUS",
+            cable_status_map[cable.status], "PN", state.partNumber);
         error(
             "Hosted Cable [ {CABLE_NO} ] UPConnector - [ {UP_CONN} ] DNConnector - [ {DN_CONN} ] DChassis - [ {D_CHASSIS} ]",
-            "CABLE_NO", cable_no, "UP_CONN", upstreamInformation, "DN_CONN",
-            downstreamInformation, "D_CHASSIS", downstreamChassis);
-        cables.push_back(cableObjectPath.string());
+            "CABLE_NO", cable.number, "UP_CONN", state.upstream, "DN_CONN",
+            state.downstream, "D_CHASSIS", state.downstreamChassis);
+        hostedCables.emplace(path, std::move(state));
     }
+
+    // delete the cable dbus objects of the cables that are gone, the cables
+    // are dynamic
+    for (const auto& [path, state] : cables)
+    {
+        if (!hostedCables.contains(path))
+        {
+            error("Removing cable object [ {CABLE} ]", "CABLE", path);
+            customDBus.deleteObject(path);
+        }
+    }
+    cables = std::move(hostedCables);
 }
 
-void PCIeInfoHandler::clearTopologyInfo()
+void PCIeInfoHandler::applyProperties()
 {
-    topologyInformation.clear();
+    auto updates = properties.take(inventory);
+    info("Setting {COUNT} changed PCIe topology properties", "COUNT",
+         updates.size());
+
+    // even when we fail to parse /set the topology infromation on to the
+    // dbus, we need to set the property back to false - to allow the
+    // redfish/user to be able to ask the topology information again
+    if (updates.empty())
+    {
+        pldm::dbus::CustomDBus::getCustomDBus().updateTopologyProperty(false);
+        return;
+    }
+
+    // The properties are set together without waiting for each reply, the
+    // refresh is over once all of them are answered
+    auto remaining = std::make_shared<size_t>(updates.size());
+    for (const auto& update : updates)
+    {
+        pldm::utils::AsyncDBus::get().setProperty(
+            update.mapping, update.value,
+            [remaining, mapping = update.mapping](bool success) {
+            if (!success)
+            {
+                error(
+                    "Failed To set {PROP_NAME} property and path :{OBJ_PATH}",
+                    "PROP_NAME", mapping.propertyName, "OBJ_PATH",
+                    mapping.objectPath);
+            }
+            if (--*remaining == 0)
+            {
+                pldm::dbus::CustomDBus::getCustomDBus().updateTopologyProperty(
+                    false);
+            }
+        });
+    }
+}
 
-    cableInformation.clear();
+void PCIeInfoHandler::clearTopologyInfo()
+{
+    topology.clear();
 
     mexObjectMap.clear();
 
+    mexLocations.clear();
+
+    inventoryObjects.clear();
+
+    inventory.clear();
+
     needPostProcessing.clear();
 }
 
@@ -829,194 +919,13 @@ void PCIeInfoHandler::parseTopologyData()
     std::unique_ptr<void, decltype(topologyCleanup)> topologyPtr(
         file_in_memory, topologyCleanup);
 
-    auto pcie_link_list =
-        reinterpret_cast<struct topology_blob*>(file_in_memory);
-    uint16_t no_of_links = 0;
-    if (pcie_link_list != nullptr)
-    {
-        no_of_links = htobe16(pcie_link_list->num_pcie_link_entries);
-    }
-    else
-    {
-        error("Parsing of topology file failed : pcie_link_list is null");
-        return;
-    }
-
-    struct pcie_link_entry* single_entry_data =
-        (struct pcie_link_entry*)(((uint8_t*)pcie_link_list) + 8);
-
-    if (single_entry_data == nullptr)
+    if (!topology.parseTopology(std::span<const uint8_t>(
+            static_cast<const uint8_t*>(file_in_memory), sb.st_size)))
     {
-        error("Parsing of topology file failed : single_link is null");
+        error("Parsing of topology file failed");
         return;
     }
 
-    // iterate over every pcie link and get the link specific attributes
-    for ([[maybe_unused]] const auto& link :
-         std::views::iota(0) | std::views::take(no_of_links))
-    {
-        // get the link id
-        auto linkid = htobe16(single_entry_data->link_id);
-
-        // get parent link id
-        auto parentLinkId = htobe16(single_entry_data->parent_link_id);
-
-        // get link status
-        auto linkStatus = single_entry_data->link_status;
-
-        // get link type
-        auto linkType = single_entry_data->link_type;
-        if (linkType != Unknown)
-        {
-            linkTypeInfo[linkid] = linkType;
-        }
-
-        // get link speed
-        auto linkSpeed = single_entry_data->link_speed;
-
-        // get link width
-        auto linkWidth = single_entry_data->link_width;
-
-        // get the PCIe Host Bridge Location
-        size_t pcie_loc_code_size =
-            single_entry_data->PCIehostBridgeLocCodeSize;
-        std::vector<char> pcie_host_bridge_location(
-            (char*)single_entry_data +
-                htobe16(single_entry_data->PCIehostBridgeLocCodeOff),
-            (char*)single_entry_data +
-                htobe16(single_entry_data->PCIehostBridgeLocCodeOff) +
-                (unsigned)pcie_loc_code_size);
-        std::string pcie_host_bridge_location_code(
-            pcie_host_bridge_location.begin(), pcie_host_bridge_location.end());
-
-        // get the local port - top location
-        size_t local_top_port_loc_size =
-            single_entry_data->TopLocalPortLocCodeSize;
-        std::vector<char> local_top_port_location(
-            (char*)single_entry_data +
-                htobe16(single_entry_data->TopLocalPortLocCodeOff),
-            (char*)single_entry_data +
-                htobe16(single_entry_data->TopLocalPortLocCodeOff) +
-                (int)local_top_port_loc_size);
-        std::string local_top_port_location_code(
-            local_top_port_location.begin(), local_top_port_location.end());
-
-        // get the local port - bottom location
-        size_t local_bottom_port_loc_size =
-            single_entry_data->BottomLocalPortLocCodeSize;
-        std::vector<char> local_bottom_port_location(
-            (char*)single_entry_data +
-                htobe16(single_entry_data->BottomLocalPortLocCodeOff),
-            (char*)single_entry_data +
-                htobe16(single_entry_data->BottomLocalPortLocCodeOff) +
-                (int)local_bottom_port_loc_size);
-        std::string local_bottom_port_location_code(
-            local_bottom_port_location.begin(),
-            local_bottom_port_location.end());
-
-        // get the remote port - top location
-        size_t remote_top_port_loc_size =
-            single_entry_data->TopRemotePortLocCodeSize;
-        std::vector<char> remote_top_port_location(
-            (char*)single_entry_data +
-                htobe16(single_entry_data->TopRemotePortLocCodeOff),
-            (char*)single_entry_data +
-                htobe16(single_entry_data->TopRemotePortLocCodeOff) +
-                (int)remote_top_port_loc_size);
-        std::string remote_top_port_location_code(
-            remote_top_port_location.begin(), remote_top_port_location.end());
-
-        // get the remote port - bottom location
-        size_t remote_bottom_loc_size =
-            single_entry_data->BottomRemotePortLocCodeSize;
-        std::vector<char> remote_bottom_port_location(
-            (char*)single_entry_data +
-                htobe16(single_entry_data->BottomRemotePortLocCodeOff),
-            (char*)single_entry_data +
-                htobe16(single_entry_data->BottomRemotePortLocCodeOff) +
-                (int)remote_bottom_loc_size);
-        std::string remote_bottom_port_location_code(
-            remote_bottom_port_location.begin(),
-            remote_bottom_port_location.end());
-
-        struct SlotLocCode_t* slot_data =
-            (struct SlotLocCode_t*)(((uint8_t*)single_entry_data) +
-                                    htobe16(single_entry_data
-                                                ->slot_loc_codes_offset));
-        if (slot_data == nullptr)
-        {
-            error("Parsing the topology file failed : slot_data is null");
-            return;
-        }
-        // get the Slot location code common part
-        size_t no_of_slots = slot_data->numSlotLocCodes;
-        size_t slot_loccode_compart_size = slot_data->slotLocCodesCmnPrtSize;
-        std::vector<char> slot_location((char*)slot_data->slotLocCodesCmnPrt,
-                                        (char*)slot_data->slotLocCodesCmnPrt +
-                                            (int)slot_loccode_compart_size);
-        std::string slot_location_code(slot_location.begin(),
-                                       slot_location.end());
-
-        uint8_t* suffix_data = (uint8_t*)slot_data +
-                               slotLocationDataMemberSize +
-                               slot_data->slotLocCodesCmnPrtSize;
-        if (suffix_data == nullptr)
-        {
-            error("slot location suffix data is nullptr");
-            return;
-        }
-
-        // create the full slot location code by combining common part and
-        // suffix part
-        std::string slot_suffix_location_code;
-        std::vector<std::string> slot_final_location_code{};
-        for ([[maybe_unused]] const auto& slot :
-             std::views::iota(0) | std::views::take(no_of_slots))
-        {
-            struct SlotLocCodeSuf_t* slot_loc_suf_data =
-                (struct SlotLocCodeSuf_t*)suffix_data;
-            if (slot_loc_suf_data == nullptr)
-            {
-                error("slot location suffix data is nullptr");
-                break;
-            }
-
-            size_t slot_loccode_suffix_size = slot_loc_suf_data->slotLocCodeSz;
-            if (slot_loccode_suffix_size > 0)
-            {
-                std::vector<char> slot_suffix_location(
-                    (char*)slot_loc_suf_data + 1,
-                    (char*)slot_loc_suf_data + 1 +
-                        (int)slot_loccode_suffix_size);
-                std::string slot_suff_location_code(
-                    slot_suffix_location.begin(), slot_suffix_location.end());
-
-                slot_suffix_location_code = slot_suff_location_code;
-            }
-            std::string slot_full_location_code = slot_location_code +
-                                                  slot_suffix_location_code;
-            slot_final_location_code.push_back(slot_full_location_code);
-
-            // move the pointer to next slot
-            suffix_data += sizeOfSuffixSizeDataMember +
-                           slot_loccode_suffix_size;
-        }
-
-        // store the information into a map
-        topologyInformation[linkid] = std::make_tuple(
-            link_state_map[linkStatus], linkType, linkSpeed,
-            link_width[linkWidth], pcie_host_bridge_location_code,
-            std::make_pair(local_top_port_location_code,
-                           local_bottom_port_location_code),
-            std::make_pair(remote_top_port_location_code,
-                           remote_bottom_port_location_code),
-            slot_final_location_code, parentLinkId);
-
-        // move the pointer to next link
-        single_entry_data =
-            (struct pcie_link_entry*)((uint8_t*)single_entry_data +
-                                      htons(single_entry_data->entry_length));
-    }
     // Need to call cable info at the end , because we dont want to parse
     // cable info without parsing the successfull topology successfully
     // Having partial information is of no use.
@@ -1058,53 +967,10 @@ void PCIeInfoHandler::parseCableInfo()
     std::unique_ptr<void, decltype(cableInfoCleanup)> cablePtr(
         file_in_memory, cableInfoCleanup);
 
-    auto cable_list =
-        reinterpret_cast<struct cable_attributes_list*>(file_in_memory);
-
-    // get number of cable links
-    auto no_of_cable_links = htobe16(cable_list->no_of_cables);
-
-    struct pcilinkcableattr_t* cable_data =
-        (struct pcilinkcableattr_t*)(((uint8_t*)cable_list) + 8);
-
-    if (cable_data == nullptr)
-    {
-        error("Cable info parsing failed , cable_data = nullptr");
-        return;
-    }
-
-    // iterate over each pci cable link
-    for (const auto& cable :
-         std::views::iota(0) | std::views::take(no_of_cable_links))
+    if (!topology.parseCables(std::span<const uint8_t>(
+            static_cast<const uint8_t*>(file_in_memory), sb.st_size)))
     {
-        // get the link id
-        auto linkid = htobe16(cable_data->link_id);
-
-        std::string local_port_loc_code(
-            (char*)cable_data +
-                htobe16(cable_data->host_port_location_code_offset),
-            cable_data->host_port_location_code_size);
-
-        std::string io_slot_location_code(
-            (char*)cable_data +
-                htobe16(cable_data->io_enclosure_port_location_code_offset),
-            cable_data->io_enclosure_port_location_code_size);
-
-        std::string cable_part_num(
-            (char*)cable_data + htobe16(cable_data->cable_part_number_offset),
-            cable_data->cable_part_number_size);
-
-        // cache the data into a map
-        cableInformation[cable] = std::make_tuple(
-            linkid, local_port_loc_code, io_slot_location_code, cable_part_num,
-            cable_length_map[cable_data->cable_length],
-            cable_type_map[cable_data->cable_type],
-            cable_status_map[cable_data->cable_status]);
-        // move the cable data pointer
-
-        cable_data =
-            (struct pcilinkcableattr_t*)(((uint8_t*)cable_data) +
-                                         ntohs(cable_data->entry_length));
+        error("Cable info parsing failed");
     }
 }
 
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "file_io_by_type.hpp"
+#include "pcie_topology_model.hpp"
 
 #include <arpa/inet.h>
 #include <fcntl.h>
@@ -9,6 +10,8 @@
 #include <unistd.h>
 
 #include <cstring>
+#include <map>
+#include <string_view>
 #include <unordered_map>
 
 namespace pldm
@@ -56,69 +59,6 @@ static std::map<uint8_t, int64_t> link_width{{0x01, 1}, {0x02, 2},  {0x04, 4},
                                              {0x08, 8}, {0x10, 16}, {0xFF, -1},
                                              {0x00, 0}};
 
-struct SlotLocCode_t
-{
-    uint8_t numSlotLocCodes;
-    uint8_t slotLocCodesCmnPrtSize;
-    uint8_t slotLocCodesCmnPrt[1];
-} __attribute__((packed));
-
-struct SlotLocCodeSuf_t
-{
-    uint8_t slotLocCodeSz;
-    uint8_t slotLocCodeSuf[1];
-} __attribute__((packed));
-
-struct pcie_link_entry
-{
-    uint16_t entry_length;
-    uint8_t version;
-    uint8_t reserved_1;
-    uint16_t link_id;
-    uint16_t parent_link_id;
-    uint32_t link_drc_index;
-    uint32_t hub_drc_index;
-    uint8_t link_status;
-    uint8_t link_type;
-    uint16_t reserved_2;
-    uint8_t link_speed;
-    uint8_t link_width;
-    uint8_t PCIehostBridgeLocCodeSize;
-    uint16_t PCIehostBridgeLocCodeOff;
-    uint8_t TopLocalPortLocCodeSize;
-    uint16_t TopLocalPortLocCodeOff;
-    uint8_t BottomLocalPortLocCodeSize;
-    uint16_t BottomLocalPortLocCodeOff;
-    uint8_t TopRemotePortLocCodeSize;
-    uint16_t TopRemotePortLocCodeOff;
-    uint8_t BottomRemotePortLocCodeSize;
-    uint16_t BottomRemotePortLocCodeOff;
-    uint16_t slot_loc_codes_offset;
-    uint8_t pci_link_entry_loc_code[1];
-} __attribute__((packed));
-
-struct topology_blob
-{
-    uint32_t total_data_size;
-    uint16_t num_pcie_link_entries;
-    uint16_t reserved;
-    pcie_link_entry pci_link_entry[1];
-} __attribute__((packed));
-
-using linkId_t = uint16_t;
-using linkStatus_t = std::string;
-using linkType_t = uint8_t;
-using linkSpeed_t = uint8_t;
-using linkWidth_t = int64_t;
-using pcieHostBidgeloc_t = std::string;
-using localport_top_t = std::string;
-using localport_bot_t = std::string;
-using localport_t = std::pair<localport_top_t, localport_bot_t>;
-using remoteport_top_t = std::string;
-using remoteport_bot_t = std::string;
-using remoteport_t = std::pair<remoteport_top_t, remoteport_bot_t>;
-using io_slot_location_t = std::vector<std::string>;
-
 /* Cable Attributes Info */
 
 static std::map<uint8_t, double> cable_length_map{
@@ -134,42 +74,6 @@ static std::map<uint8_t, std::string> cable_status_map{
     {0x02, "xyz.openbmc_project.Inventory.Item.Cable.Status.PoweredOff"},
     {0xFF, "xyz.openbmc_project.Inventory.Item.Cable.Status.Unknown"}};
 
-using cable_link_no_t = unsigned short int;
-using local_port_loc_code_t = std::string;
-using io_slot_location_code_t = std::string;
-using cable_part_no_t = std::string;
-using cable_length_t = double;
-using cable_type_t = std::string;
-using cable_status_t = std::string;
-
-struct pcilinkcableattr_t
-{
-    uint16_t entry_length;
-    uint8_t version;
-    uint8_t reserved_1;
-    uint16_t link_id;
-    uint16_t reserved_2;
-    uint32_t link_drc_index;
-    uint8_t cable_length;
-    uint8_t cable_type;
-    uint8_t cable_status;
-    uint8_t host_port_location_code_size;
-    uint8_t io_enclosure_port_location_code_size;
-    uint8_t cable_part_number_size;
-    uint16_t host_port_location_code_offset;
-    uint16_t io_enclosure_port_location_code_offset;
-    uint16_t cable_part_number_offset;
-    uint8_t cable_attr_loc_code[1];
-};
-
-struct cable_attributes_list
-{
-    uint32_t length_of_response;
-    uint16_t no_of_cables;
-    uint16_t reserved;
-    pcilinkcableattr_t pci_link_cable_attr[1];
-};
-
 /** @class PCIeInfoHandler
  *
  *  @brief Inherits and implements FileHandler. This class is used
@@ -226,36 +130,52 @@ class PCIeInfoHandler : public FileHandler
     /** @brief method to clear the topology cache */
     virtual void clearTopologyInfo();
 
+    /** @brief method to set the topology and the cables on D-Bus, only the
+     *         properties that changed since the last refresh are set
+     */
     virtual void setTopologyAttrsOnDbus();
 
     virtual void getMexObjects();
 
-    virtual void parsePrimaryLink(uint8_t linkType,
-                                  const io_slot_location_t& ioSlotLocationCode,
-                                  const localport_t& localPortLocation,
-                                  const uint32_t& linkId,
-                                  const std::string& linkStatus,
-                                  uint8_t linkSpeed, int64_t linkWidth,
-                                  uint8_t parentLinkId);
-    virtual void parseSecondaryLink(
-        uint8_t linkType, const io_slot_location_t& ioSlotLocationCode,
-        const localport_t& localPortLocation,
-        const remoteport_t& remotePortLocation, const uint32_t& linkId,
-        const std::string& linkStatus, uint8_t linkSpeed, int64_t linkWidth);
+    /** @brief method to read the inventory objects and index them by
+     *         location code, in one pass over the inventory
+     */
+    virtual void getInventoryObjects();
+
+    virtual void parsePrimaryLink(const pcie::Link& link, uint8_t linkType);
+    virtual void parseSecondaryLink(const pcie::Link& link, uint8_t linkType);
     virtual void setTopologyOnSlotAndAdapter(
         uint8_t linkType,
         const std::pair<std::string, std::string>& slotAndAdapter,
         const uint32_t& linkId, const std::string& linkStatus,
         uint8_t linkSpeed, int64_t linkWidth, bool isHostedByPLDM);
 
+    /** @brief method to queue a property of an inventory object, it is set
+     *         with the other properties of the refresh if its value changed
+     */
     virtual void setProperty(const std::string& objPath,
                              const std::string& propertyName,
                              const pldm::utils::PropertyValue& propertyValue,
                              const std::string& interfaceName,
                              const std::string& propertyType);
     virtual std::string
-        getMexObjectFromLocationCode(const std::string& locationCode,
+        getMexObjectFromLocationCode(std::string_view locationCode,
                                      uint16_t entityType);
+
+    /** @brief method to find the inventory object of a location code
+     *
+     *  @param[in] locationCode - location code
+     *  @param[in] itemType - inventory item interface of the object
+     *
+     *  @return the object path, empty if it is not found
+     */
+    virtual std::string getInventoryObject(std::string_view locationCode,
+                                           const std::string& itemType);
+
+    /** @brief method to find the slot and the adapter of a port */
+    virtual std::pair<std::string, std::string>
+        getSlotAndAdapterFromPort(std::string_view portLocationCode);
+
     virtual std::string getAdapterFromSlot(const std::string& mexSlotObject);
 
     virtual std::pair<std::string, std::string>
@@ -263,7 +183,17 @@ class PCIeInfoHandler : public FileHandler
 
     virtual std::string
         getDownStreamChassis(const std::string& slotOrConnecterPath);
-    virtual void parseSpeciallink(linkId_t linkId, linkId_t parentLinkId);
+    virtual void parseSpeciallink(const pcie::Link& link);
+
+    /** @brief method to host the cable objects, the cables that did not
+     *         change are left as they are
+     */
+    virtual void setCablesOnDbus();
+
+    /** @brief method to set the queued properties that changed, the topology
+     *         property is set back to false once they are all answered
+     */
+    virtual void applyProperties();
 
     /** @brief PCIeInfoHandler destructor
      */
@@ -272,23 +202,45 @@ class PCIeInfoHandler : public FileHandler
   private:
     uint16_t infoType; //!< type of the information
     static std::unordered_map<uint16_t, bool> receivedFiles;
-    static std::unordered_map<
-        linkId_t, std::tuple<linkStatus_t, linkType_t, linkSpeed_t, linkWidth_t,
-                             pcieHostBidgeloc_t, localport_t, remoteport_t,
-                             io_slot_location_t, linkId_t>>
-        topologyInformation;
-    static std::unordered_map<
-        cable_link_no_t,
-        std::tuple<linkId_t, local_port_loc_code_t, io_slot_location_code_t,
-                   cable_part_no_t, cable_length_t, cable_type_t,
-                   cable_status_t>>
-        cableInformation;
+
+    /** @struct CableState
+     *
+     *  Attributes of a hosted cable object
+     */
+    struct CableState
+    {
+        std::string partNumber;
+        uint8_t length;
+        uint8_t type;
+        uint8_t status;
+        std::string upstream;
+        std::string downstream;
+        std::string downstreamChassis;
+
+        bool operator==(const CableState&) const = default;
+    };
+
+    /** @brief topology of the refresh in progress */
+    static pcie::TopologyModel topology;
     static std::map<std::string, std::tuple<uint16_t, std::string,
                                             std::optional<std::string>>>
         mexObjectMap;
-    static std::vector<std::string> cables;
-    static std::vector<std::pair<linkId_t, linkId_t>> needPostProcessing;
-    static std::unordered_map<linkId_t, linkType_t> linkTypeInfo;
+
+    /** @brief objects of mexObjectMap by entity type and location code */
+    static std::unordered_map<std::string, std::string> mexLocations;
+
+    /** @brief inventory objects by item interface and location code */
+    static std::unordered_map<std::string, std::string> inventoryObjects;
+
+    /** @brief hosted cable objects, by object path */
+    static std::map<std::string, CableState> cables;
+    static std::vector<linkId_t> needPostProcessing;
+
+    /** @brief inventory objects and their properties, read at the refresh */
+    static pldm::utils::ObjectValueTree inventory;
+
+    /** @brief properties of the inventory objects set by the refresh */
+    static pcie::PropertyState properties;
 
     /** @brief Deletes the topology and cable data
      *
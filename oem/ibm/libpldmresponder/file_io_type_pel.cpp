@@ -93,17 +93,13 @@ Entry::Level getEntryLevelFromPEL(const std::string& pelFileName)
 }
 } // namespace detail
 
-int PelHandler::readIntoMemory(uint32_t offset, uint32_t length,
-                               uint64_t address,
-                               oem_platform::Handler* /*oemPlatformHandler*/)
+std::optional<FileReadSessions::Session> PelHandler::openPel()
 {
     static constexpr auto logObjPath = "/xyz/openbmc_project/logging";
     static constexpr auto logInterface = "org.open_power.Logging.PEL";
 
-    auto& bus = pldm::utils::DBusHandler::getBus();
-
-    try
-    {
+    return FileReadSessions::get().open(sessionKey(), [this]() {
+        auto& bus = pldm::utils::DBusHandler::getBus();
         auto service = pldm::utils::DBusHandler().getService(logObjPath,
                                                              logInterface);
         auto method = bus.new_method_call(service.c_str(), logObjPath,
@@ -112,8 +108,24 @@ int PelHandler::readIntoMemory(uint32_t offset, uint32_t length,
         auto reply = bus.call(method, dbusTimeout);
         sdbusplus::message::unix_fd fd{};
         reply.read(fd);
-        auto rc = transferFileData(fd, true, offset, length, address);
-        return rc;
+        // The descriptor of the reply is closed with the message
+        return dup(fd);
+    });
+}
+
+int PelHandler::readIntoMemory(uint32_t offset, uint32_t length,
+                               uint64_t address,
+                               oem_platform::Handler* /*oemPlatformHandler*/)
+{
+    try
+    {
+        auto session = openPel();
+        if (!session)
+        {
+            return PLDM_ERROR;
+        }
+        return transferFileData((*session->fd)(), true, offset, length,
+                                address);
     }
     catch (const std::exception& e)
     {
@@ -122,69 +134,20 @@ int PelHandler::readIntoMemory(uint32_t offset, uint32_t length,
             "FILE_HNDL", lg2::hex, fileHandle, "ERR_EXCEP", e.what());
         return PLDM_ERROR;
     }
-
-    return PLDM_SUCCESS;
 }
 
 int PelHandler::read(uint32_t offset, uint32_t& length, Response& response,
                      oem_platform::Handler* /*oemPlatformHandler*/)
 {
-    static constexpr auto logObjPath = "/xyz/openbmc_project/logging";
-    static constexpr auto logInterface = "org.open_power.Logging.PEL";
-    auto& bus = pldm::utils::DBusHandler::getBus();
-
     try
     {
-        auto service = pldm::utils::DBusHandler().getService(logObjPath,
-                                                             logInterface);
-        auto method = bus.new_method_call(service.c_str(), logObjPath,
-                                          logInterface, "GetPEL");
-        method.append(fileHandle);
-        auto reply = bus.call(method, dbusTimeout);
-        sdbusplus::message::unix_fd fd{};
-        reply.read(fd);
-
-        off_t fileSize = lseek(fd, 0, SEEK_END);
-        if (fileSize == -1)
+        auto session = openPel();
+        if (!session)
         {
-            error("file seek failed");
-            return PLDM_ERROR;
-        }
-        if (offset >= fileSize)
-        {
-            error(
-                "PelHandler::read: Offset exceeds file size, OFFSET={OFFSET} FILE_SIZE={FILE_SIZE} FILE_HANDLE={FILE_HANDLE}",
-                "OFFSET", offset, "FILE_SIZE", fileSize, "FILE_HANDLE",
-                fileHandle);
-            return PLDM_DATA_OUT_OF_RANGE;
-        }
-        if (offset + length > fileSize)
-        {
-            length = fileSize - offset;
-        }
-        auto rc = lseek(fd, offset, SEEK_SET);
-        if (rc == -1)
-        {
-            error("file seek failed");
-            return PLDM_ERROR;
-        }
-        size_t currSize = response.size();
-        response.resize(currSize + length);
-        auto filePos = reinterpret_cast<char*>(response.data());
-        filePos += currSize;
-        rc = ::read(fd, filePos, length);
-        if (rc == -1)
-        {
-            error("file read failed");
-            return PLDM_ERROR;
-        }
-        if (rc != length)
-        {
-            error(
-                "mismatch between number of characters to read and the length read, LENGTH={LEN} COUNT={COUNT}",
-                "LEN", length, "COUNT", rc);
             return PLDM_ERROR;
         }
+        return FileReadSessions::read(*session, fileHandle, offset, length,
+                                      response);
     }
     catch (const std::exception& e)
     {
@@ -193,7 +156,6 @@ int PelHandler::read(uint32_t offset, uint32_t& length, Response& response,
             "FILE_HNDL", lg2::hex, fileHandle, "ERR_EXCEP", e.what());
         return PLDM_ERROR;
     }
-    return PLDM_SUCCESS;
 }
 
 int PelHandler::writeFromMemory(uint32_t offset, uint32_t length,
@@ -221,6 +183,9 @@ int PelHandler::writeFromMemory(uint32_t offset, uint32_t length,
 
 int PelHandler::fileAck(uint8_t fileStatus)
 {
+    // The host is done with the PEL
+    FileReadSessions::get().release(sessionKey());
+
     static constexpr auto logObjPath = "/xyz/openbmc_project/logging";
     static constexpr auto logInterface = "org.open_power.Logging.PEL";
     static std::string service;
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "file_io_by_type.hpp"
+#include "file_io_session.hpp"
 
 namespace pldm
 {
@@ -74,6 +75,20 @@ class PelHandler : public FileHandler
     /** @brief PelHandler destructor
      */
     ~PelHandler() {}
+
+  private:
+    /** @brief Get the read session of the PEL, the PEL is fetched from the
+     *         logging daemon on the first read
+     *
+     *  @return the session, or nullopt if the PEL could not be opened
+     */
+    std::optional<FileReadSessions::Session> openPel();
+
+    /** @brief Name of the read session of the PEL */
+    std::string sessionKey() const
+    {
+        return "pel:" + std::to_string(fileHandle);
+    }
 };
 
 } // namespace responder
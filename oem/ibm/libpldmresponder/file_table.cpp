@@ -1,11 +1,20 @@
 #include "file_table.hpp"
 
+#include "libpldm/base.h"
 #include "libpldm/utils.h"
 
+#include <sys/epoll.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+
 #include <phosphor-logging/lg2.hpp>
 
+#include <array>
+#include <cstddef>
+#include <cstring>
 #include <fstream>
 #include <iostream>
+#include <system_error>
 
 PHOSPHOR_LOG2_USING;
 
@@ -13,6 +22,17 @@ namespace pldm
 {
 namespace filetable
 {
+
+namespace
+{
+
+// The transfer handle of a part is the version of the table in the high byte
+// and the offset of the part in the low bytes
+constexpr auto offsetBits = 24;
+constexpr uint32_t offsetMask = (1 << offsetBits) - 1;
+
+} // namespace
+
 FileTable::FileTable(const std::string& fileTableConfigPath)
 {
     std::ifstream jsonFile(fileTableConfigPath);
@@ -88,6 +108,7 @@ FileTable::FileTable(const std::string& fileTableConfigPath)
                     fileNameLength, iter);
         std::advance(iter, fileNameLength);
 
+        sizeOffsets.emplace(handle, iter - fileTable.begin());
         std::copy_n(reinterpret_cast<uint8_t*>(&fileSize), sizeof(fileSize),
                     iter);
         std::advance(iter, sizeof(fileSize));
@@ -115,26 +136,196 @@ FileTable::FileTable(const std::string& fileTableConfigPath)
         fileTable.resize(tableSize + padCount, 0);
     }
 
-    // Calculate the checksum
-    checkSum = crc32(fileTable.data(), fileTable.size());
+    // Calculate the checksum, stored after the pad bytes
+    if (!fileTable.empty())
+    {
+        fileTable.resize(fileTable.size() + sizeof(checkSum));
+        updateCheckSum();
+    }
 }
 
-Table FileTable::operator()() const
+void FileTable::updateCheckSum()
 {
-    Table table(fileTable);
-    table.resize(fileTable.size() + sizeof(checkSum));
-    auto iter = table.begin() + fileTable.size();
+    auto tableSize = fileTable.size() - sizeof(checkSum);
+    checkSum = crc32(fileTable.data(), tableSize);
     std::copy_n(reinterpret_cast<const uint8_t*>(&checkSum), sizeof(checkSum),
-                iter);
-    return table;
+                fileTable.begin() + tableSize);
+}
+
+Table FileTable::operator()() const
+{
+    return fileTable;
+}
+
+std::optional<FileTable::Part> FileTable::getPart(uint8_t operationFlag,
+                                                  uint32_t transferHandle,
+                                                  size_t partSize) const
+{
+    if (fileTable.empty() || !partSize)
+    {
+        return std::nullopt;
+    }
+
+    // A transfer handle of 0 asks for the first part whatever the operation
+    // flag, hosts send 0 for both in their first request
+    size_t offset = 0;
+    if (transferHandle && operationFlag == PLDM_GET_NEXTPART)
+    {
+        offset = transferHandle & offsetMask;
+        if ((transferHandle >> offsetBits) != version || !offset ||
+            offset >= fileTable.size())
+        {
+            return std::nullopt;
+        }
+    }
+    else if (transferHandle && operationFlag != PLDM_GET_FIRSTPART)
+    {
+        return std::nullopt;
+    }
+
+    auto size = std::min(partSize, fileTable.size() - offset);
+    auto end = offset + size;
+    Part part{std::span<const uint8_t>(fileTable).subspan(offset, size), 0,
+              PLDM_START_AND_END};
+    if (end < fileTable.size())
+    {
+        part.nextHandle = static_cast<uint32_t>(version) << offsetBits | end;
+        part.transferFlag = offset ? PLDM_MIDDLE : PLDM_START;
+    }
+    else if (offset)
+    {
+        part.transferFlag = PLDM_END;
+    }
+    return part;
+}
+
+bool FileTable::refresh(Handle handle)
+{
+    auto sizeOffset = sizeOffsets.find(handle);
+    if (sizeOffset == sizeOffsets.end())
+    {
+        return false;
+    }
+
+    std::error_code ec;
+    auto fileSize = static_cast<uint32_t>(
+        fs::file_size(tableEntries.at(handle).fsPath, ec));
+    if (ec)
+    {
+        fileSize = 0;
+    }
+
+    auto field = fileTable.begin() + sizeOffset->second;
+    uint32_t tableSize = 0;
+    std::copy_n(field, sizeof(tableSize),
+                reinterpret_cast<uint8_t*>(&tableSize));
+    if (tableSize == fileSize)
+    {
+        return false;
+    }
+
+    std::copy_n(reinterpret_cast<const uint8_t*>(&fileSize), sizeof(fileSize),
+                field);
+    updateCheckSum();
+    ++version;
+    return true;
+}
+
+FileTableWatch::FileTableWatch(sdeventplus::Event& event, FileTable& table) :
+    table(table), fd(inotify_init1(IN_NONBLOCK | IN_CLOEXEC))
+{
+    if (fd == -1)
+    {
+        throw std::system_error(errno, std::generic_category(),
+                                "Failed to initialise the file table watch");
+    }
+
+    for (const auto& [handle, entry] : table.getEntries())
+    {
+        auto dir = entry.fsPath.parent_path();
+        auto wd = inotify_add_watch(fd, dir.c_str(),
+                                    IN_CLOSE_WRITE | IN_MOVED_TO |
+                                        IN_MOVED_FROM | IN_CREATE | IN_DELETE);
+        if (wd == -1)
+        {
+            error("Failed to watch {DIR} for the file table, ERROR={ERR}",
+                  "DIR", dir.string(), "ERR", errno);
+            continue;
+        }
+        watches[wd].emplace(entry.fsPath.filename().string(), handle);
+    }
+
+    io = std::make_unique<sdeventplus::source::IO>(
+        event, fd, EPOLLIN,
+        [this](sdeventplus::source::IO& /*io*/, int /*fd*/,
+               uint32_t /*revents*/) { processEvents(); });
+}
+
+FileTableWatch::~FileTableWatch()
+{
+    io.reset();
+    close(fd);
+}
+
+void FileTableWatch::processEvents()
+{
+    std::array<uint8_t, 4096> buffer;
+    ssize_t length = 0;
+    while ((length = read(fd, buffer.data(), buffer.size())) > 0)
+    {
+        ssize_t offset = 0;
+        while (offset < length)
+        {
+            inotify_event event;
+            std::memcpy(&event, buffer.data() + offset, sizeof(event));
+            auto name = reinterpret_cast<const char*>(
+                buffer.data() + offset + offsetof(inotify_event, name));
+            offset += offsetof(inotify_event, name) + event.len;
+
+            auto watch = watches.find(event.wd);
+            if (watch == watches.end() || !event.len)
+            {
+                continue;
+            }
+            auto [begin, end] = watch->second.equal_range(name);
+            for (auto file = begin; file != end; ++file)
+            {
+                if (table.refresh(file->second))
+                {
+                    info(
+                        "File table entry {HANDLE} refreshed, VERSION={VERSION}",
+                        "HANDLE", file->second, "VERSION",
+                        unsigned(table.getVersion()));
+                }
+            }
+        }
+    }
 }
 
 FileTable& buildFileTable(const std::string& fileTablePath)
 {
     static FileTable table;
+    static std::unique_ptr<FileTableWatch> watch;
     if (table.isEmpty())
     {
-        table = std::move(FileTable(fileTablePath));
+        watch.reset();
+        auto version = table.version;
+        table = FileTable(fileTablePath);
+        table.version = version + 1;
+        if (!table.isEmpty())
+        {
+            try
+            {
+                auto event = sdeventplus::Event::get_default();
+                watch = std::make_unique<FileTableWatch>(event, table);
+            }
+            catch (const std::exception& e)
+            {
+                error(
+                    "File table sizes are not refreshed, ERROR={ERR_EXCEP}",
+                    "ERR_EXCEP", e.what());
+            }
+        }
     }
     return table;
 }
@@ -5,8 +5,16 @@
 #include <stdint.h>
 
 #include <nlohmann/json.hpp>
+#include <sdeventplus/event.hpp>
+#include <sdeventplus/source/io.hpp>
 
 #include <filesystem>
+#include <map>
+#include <memory>
+#include <optional>
+#include <span>
+#include <string>
+#include <unordered_map>
 #include <vector>
 
 namespace pldm
@@ -41,10 +49,25 @@ struct FileEntry
  *  file handle and extract the file attribute table. The file attribute table
  *  comprises of metadata for files. Metadata includes the file handle, file
  *  name, current file size and file traits.
+ *
+ *  The encoded table, checksum included, is kept resident and served in
+ *  parts. The size of an entry can be refreshed in place when its file
+ *  changes, which bumps the version of the table.
  */
 class FileTable
 {
   public:
+    /** @struct Part
+     *
+     *  Part of the file attribute table, for the GetFileTable response
+     */
+    struct Part
+    {
+        std::span<const uint8_t> data; //!< stays valid until the table changes
+        uint32_t nextHandle;           //!< 0 for the last part
+        uint8_t transferFlag;          //!< PLDM_START, PLDM_MIDDLE...
+    };
+
     /** @brief The file table is initialised by parsing the config file
      *         containing information about the files.
      *
@@ -65,6 +88,46 @@ class FileTable
      */
     Table operator()() const;
 
+    /** @brief Get a part of the file attribute table. The transfer handle
+     *         carries the version of the table in its high byte and the
+     *         offset of the part in the low bytes, so that a part of an
+     *         older version of the table is refused.
+     *
+     * @param[in] operationFlag - PLDM_GET_FIRSTPART or PLDM_GET_NEXTPART
+     * @param[in] transferHandle - next transfer handle of the previous part,
+     *                             ignored for the first part, 0 for the
+     *                             first part whatever the operation flag
+     * @param[in] partSize - maximum size of the part
+     *
+     * @return the part, std::nullopt if the table is empty, or the transfer
+     *         handle is stale or invalid
+     */
+    std::optional<Part> getPart(uint8_t operationFlag, uint32_t transferHandle,
+                                size_t partSize) const;
+
+    /** @brief Refresh the file size of an entry from its file, a missing
+     *         file has a size of 0
+     *
+     * @param[in] handle - file handle
+     *
+     * @return bool - true if the size changed, the version is bumped then
+     */
+    bool refresh(Handle handle);
+
+    /** @brief Get the version of the table, bumped on every change of the
+     *         table content
+     */
+    uint8_t getVersion() const
+    {
+        return version;
+    }
+
+    /** @brief Get the file entries, by file handle */
+    const std::unordered_map<Handle, FileEntry>& getEntries() const
+    {
+        return tableEntries;
+    }
+
     /** @brief Get the FileEntry at the file handle
      *
      * @param[in] handle - file handle
@@ -90,17 +153,27 @@ class FileTable
      */
     void clear()
     {
+        ++version;
         tableEntries.clear();
+        sizeOffsets.clear();
         fileTable.clear();
         padCount = 0;
         checkSum = 0;
     }
 
   private:
+    friend FileTable& buildFileTable(const std::string& fileTablePath);
+
+    /** @brief Store the checksum of the table after the pad bytes */
+    void updateCheckSum();
+
     /** @brief handle to FileEntry mappings for lookups based on file handle */
     std::unordered_map<Handle, FileEntry> tableEntries;
 
-    /** @brief file attribute table including the pad bytes, except the checksum
+    /** @brief offset of the file size of each entry in fileTable */
+    std::unordered_map<Handle, size_t> sizeOffsets;
+
+    /** @brief file attribute table including the pad bytes and the checksum
      */
     std::vector<uint8_t> fileTable;
 
@@ -110,6 +183,53 @@ class FileTable
 
     /** @brief the checksum of the file attribute table */
     uint32_t checkSum = 0;
+
+    /** @brief version of the table, bumped when the table is cleared or
+     *         rebuilt so that the transfer handles of the old table are stale
+     */
+    uint8_t version = 0;
+};
+
+/** @class FileTableWatch
+ *
+ *  @brief Refreshes the file sizes of the file table when the files are
+ *         written, replaced or removed. The directories of the files are
+ *         watched with inotify, as the files may not exist yet and are
+ *         often replaced by a rename.
+ */
+class FileTableWatch
+{
+  public:
+    FileTableWatch() = delete;
+    FileTableWatch(const FileTableWatch&) = delete;
+    FileTableWatch(FileTableWatch&&) = delete;
+    FileTableWatch& operator=(const FileTableWatch&) = delete;
+    FileTableWatch& operator=(FileTableWatch&&) = delete;
+
+    /** @brief Watch the files of a file table
+     *
+     *  @param[in] event - event loop the inotify events are read from
+     *  @param[in] table - file table to refresh, must outlive the watch
+     */
+    FileTableWatch(sdeventplus::Event& event, FileTable& table);
+
+    ~FileTableWatch();
+
+    /** @brief Read the pending inotify events and refresh the entries of the
+     *         files they name
+     */
+    void processEvents();
+
+  private:
+    FileTable& table;
+
+    /** @brief inotify file descriptor */
+    int fd = -1;
+
+    /** @brief handles of the files of each watched directory, by name */
+    std::unordered_map<int, std::multimap<std::string, Handle>> watches;
+
+    std::unique_ptr<sdeventplus::source::IO> io;
 };
 
 /** @brief Build the file attribute table if not already built using the
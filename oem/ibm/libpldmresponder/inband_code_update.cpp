@@ -7,13 +7,22 @@
 #include "xyz/openbmc_project/Common/error.hpp"
 
 #include <arpa/inet.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
 
 #include <phosphor-logging/lg2.hpp>
 #include <sdbusplus/server.hpp>
 #include <xyz/openbmc_project/Dump/NewDump/server.hpp>
 
+#include <algorithm>
+#include <array>
+#include <cstring>
 #include <exception>
 #include <fstream>
+#include <optional>
+#include <set>
+#include <sstream>
 
 PHOSPHOR_LOG2_USING;
 
@@ -666,20 +675,134 @@ int setBootSide(uint16_t entityInstance, uint8_t currState,
     return rc;
 }
 
+namespace
+{
+
+constexpr uint16_t lidMagicNumber = 0x0222;
+constexpr uint16_t bmcLidClass = 0x2000;
+
+/** @brief CRC-32 (IEEE 802.3) of every byte value */
+constexpr auto lidCrcTable = [] {
+    std::array<uint32_t, 256> table{};
+    for (uint32_t value = 0; value < table.size(); ++value)
+    {
+        uint32_t crc = value;
+        for (int bit = 0; bit < 8; ++bit)
+        {
+            crc = (crc & 1) ? 0xEDB88320 ^ (crc >> 1) : crc >> 1;
+        }
+        table[value] = crc;
+    }
+    return table;
+}();
+
+/** @brief LIDs being streamed, by file handle */
+std::map<uint32_t, std::unique_ptr<LidSink>> lidSinks;
+
+/** @brief BMC tar images with a hole left by an aborted LID */
+std::set<fs::path> brokenTarImages;
+
+/** @brief Create the directories of the LIDs without a header and of the BMC
+ *         image
+ */
+int createLidDirs(const fs::path& lidDir, const fs::path& imageDir)
+{
+    if (!fs::exists(imageDir))
+    {
+        fs::create_directories(imageDir);
+    }
+    if (!fs::exists(lidDir))
+    {
+        fs::create_directories(lidDir);
+
+        // Set the lid directory permissions to 777
+        std::error_code ec;
+        fs::permissions(lidDir, fs::perms::all, fs::perm_options::replace, ec);
+        if (ec)
+        {
+            error("Failed to set the lid directory permissions:{ERR}", "ERR",
+                  ec.message());
+            return PLDM_ERROR;
+        }
+    }
+    return PLDM_SUCCESS;
+}
+
+/** @brief Set the permissions of a LID file without a header to 440 */
+int setLidFilePermissions(const fs::path& lidFile)
+{
+    std::error_code ec;
+    fs::permissions(lidFile, fs::perms::owner_read | fs::perms::group_read,
+                    fs::perm_options::replace, ec);
+    if (ec)
+    {
+        error("Failed to set the lid file permissions: {ERR}", "ERR",
+              ec.message());
+        return PLDM_ERROR;
+    }
+    return PLDM_SUCCESS;
+}
+
+/** @brief Compute the CRC of a range of a file
+ *
+ *  @return the CRC, nullopt if the range cannot be read
+ */
+std::optional<uint32_t> fileCrc(int fd, off_t offset, uint32_t size)
+{
+    std::vector<uint8_t> buffer(std::min<uint32_t>(size, 64 * 1024));
+    uint32_t crc = 0;
+    while (size)
+    {
+        auto count = pread(fd, buffer.data(),
+                           std::min<size_t>(size, buffer.size()), offset);
+        if (count <= 0)
+        {
+            return std::nullopt;
+        }
+        crc = lidCrc32(crc, buffer.data(), count);
+        offset += count;
+        size -= count;
+    }
+    return crc;
+}
+
+/** @brief Check the CRC of a LID body against its header, a LID without a
+ *         CRC in its header passes
+ *
+ *  @return false if the LID must be rejected
+ */
+bool checkLidCrc(uint32_t lidNumber, uint32_t expected,
+                 std::optional<uint32_t> computed)
+{
+    if (!expected || (computed && *computed == expected))
+    {
+        return true;
+    }
+    error(
+        "CRC mismatch of LID {LID_NUMBER}, HEADER_CRC={HEADER_CRC} CRC={CRC}",
+        "LID_NUMBER", lg2::hex, lidNumber, "HEADER_CRC", lg2::hex, expected,
+        "CRC", lg2::hex, computed.value_or(0));
+#ifdef LID_CRC_CHECK
+    return false;
+#else
+    return true;
+#endif
+}
+
+} // namespace
+
+uint32_t lidCrc32(uint32_t crc, const uint8_t* data, size_t size)
+{
+    crc = ~crc;
+    for (size_t pos = 0; pos < size; ++pos)
+    {
+        crc = lidCrcTable[(crc ^ data[pos]) & 0xFF] ^ (crc >> 8);
+    }
+    return ~crc;
+}
+
 int processCodeUpdateLid(const std::string& filePath)
 {
-    struct LidHeader
-    {
-        uint16_t magicNumber;
-        uint16_t headerVersion;
-        uint32_t lidNumber;
-        uint32_t lidDate;
-        uint16_t lidTime;
-        uint16_t lidClass;
-        uint32_t lidCrc;
-        uint32_t lidSize;
-        uint32_t headerSize;
-    };
     LidHeader header;
 
     std::ifstream ifs(filePath, std::ios::in | std::ios::binary);
@@ -702,8 +825,7 @@ int processCodeUpdateLid(const std::string& filePath)
         return PLDM_SUCCESS;
     }
 
-    constexpr auto magicNumber = 0x0222;
-    if (htons(header.magicNumber) != magicNumber)
+    if (htons(header.magicNumber) != lidMagicNumber)
     {
         error("Invalid magic number: {FILE_PATH}", "FILE_PATH",
               filePath.c_str());
@@ -711,28 +833,22 @@ int processCodeUpdateLid(const std::string& filePath)
         return PLDM_ERROR;
     }
 
-    if (!fs::exists(imageDirPath))
-    {
-        fs::create_directories(imageDirPath);
-    }
-    if (!fs::exists(lidDirPath))
     {
-        fs::create_directories(lidDirPath);
-
-        // Set the lid directory permissions to 777
-        std::error_code ec;
-        fs::permissions(lidDirPath, fs::perms::all, fs::perm_options::replace,
-                        ec);
-        if (ec)
+        pldm::utils::CustomFD fd(open(filePath.c_str(), O_RDONLY));
+        if (!checkLidCrc(htonl(header.lidNumber), htonl(header.lidCrc),
+                         fileCrc(fd(), htonl(header.headerSize),
+                                 htonl(header.lidSize))))
         {
-            error("Failed to set the lid directory permissions:{ERR}", "ERR",
-                  ec.message());
             return PLDM_ERROR;
         }
     }
 
-    constexpr auto bmcClass = 0x2000;
-    if (htons(header.lidClass) == bmcClass)
+    if (createLidDirs(lidDirPath, imageDirPath) != PLDM_SUCCESS)
+    {
+        return PLDM_ERROR;
+    }
+
+    if (htons(header.lidClass) == bmcLidClass)
     {
         // Skip the header and concatenate the BMC LIDs into a tar file
         std::ofstream ofs(tarImagePath,
@@ -754,15 +870,8 @@ int processCodeUpdateLid(const std::string& filePath)
         ofs.flush();
         ofs.close();
 
-        // Set the lid file permissions to 440
-        std::error_code ec;
-        fs::permissions(lidNoHeaderPath,
-                        fs::perms::owner_read | fs::perms::group_read,
-                        fs::perm_options::replace, ec);
-        if (ec)
+        if (setLidFilePermissions(lidNoHeaderPath) != PLDM_SUCCESS)
         {
-            error("Failed to set the lid file permissions: {ERR}", "ERR",
-                  ec.message());
             return PLDM_ERROR;
         }
     }
@@ -772,6 +881,320 @@ int processCodeUpdateLid(const std::string& filePath)
     return PLDM_SUCCESS;
 }
 
+int LidSink::write(uint32_t offset, const uint8_t* data, uint32_t length)
+{
+    switch (mode)
+    {
+        case Mode::header:
+        {
+            if (offset > head.size())
+            {
+                // Only the header tells where the body goes
+                info(
+                    "LID data at offset {OFFSET} came before its header, staging it to {PATH}",
+                    "OFFSET", offset, "PATH", stagingPath.string());
+                mode = Mode::staging;
+                auto rc = stage(0, head.data(), head.size());
+                head.clear();
+                return rc == PLDM_SUCCESS ? stage(offset, data, length) : rc;
+            }
+            // A chunk sent again overlaps the bytes already received
+            auto skip = std::min<uint32_t>(head.size() - offset, length);
+            head.insert(head.end(), data + skip, data + length);
+            return parseHeader();
+        }
+        case Mode::streaming:
+            return writeBody(offset, data, length);
+        case Mode::staging:
+            return stage(offset, data, length);
+        case Mode::done:
+            break;
+    }
+    return PLDM_ERROR;
+}
+
+int LidSink::parseHeader()
+{
+    if (head.size() < sizeof(LidHeader))
+    {
+        return PLDM_SUCCESS;
+    }
+    LidHeader header;
+    std::memcpy(&header, head.data(), sizeof(header));
+    if (ntohs(header.magicNumber) != lidMagicNumber ||
+        ntohl(header.headerSize) < sizeof(LidHeader))
+    {
+        error("Invalid LID header: {FILE_PATH}", "FILE_PATH",
+              stagingPath.string());
+        return PLDM_ERROR;
+    }
+    headerSize = ntohl(header.headerSize);
+    if (head.size() < headerSize)
+    {
+        return PLDM_SUCCESS;
+    }
+
+    lidNumber = ntohl(header.lidNumber);
+    lidSize = ntohl(header.lidSize);
+    lidCrc = ntohl(header.lidCrc);
+    auto rc = openDestination(header);
+    if (rc != PLDM_SUCCESS)
+    {
+        return rc;
+    }
+    mode = Mode::streaming;
+    auto received = std::move(head);
+    return writeBody(0, received.data(), received.size());
+}
+
+int LidSink::openDestination(const LidHeader& header)
+{
+    if (createLidDirs(lidDir, tarImage.parent_path()) != PLDM_SUCCESS)
+    {
+        return PLDM_ERROR;
+    }
+
+    if (ntohs(header.lidClass) == bmcLidClass)
+    {
+        // The BMC LIDs are concatenated into the tar image, in the order
+        // their transfer starts. The region of the LID is reserved right
+        // away so that the next one goes after it.
+        dest = std::make_unique<pldm::utils::CustomFD>(
+            open(tarImage.c_str(), O_RDWR | O_CREAT,
+                 S_IRUSR | S_IWUSR | S_IRGRP | S_IROTH));
+        struct stat st;
+        if ((*dest)() < 0 || fstat((*dest)(), &st) < 0)
+        {
+            error("Failed to open the BMC image {PATH}, ERROR={ERR}", "PATH",
+                  tarImage.string(), "ERR", errno);
+            return PLDM_ERROR;
+        }
+        base = st.st_size;
+        if (lidSize && fallocate((*dest)(), 0, base, lidSize) < 0 &&
+            ftruncate((*dest)(), base + lidSize) < 0)
+        {
+            error("Failed to reserve {SIZE} bytes in {PATH}, ERROR={ERR}",
+                  "SIZE", lidSize, "PATH", tarImage.string(), "ERR", errno);
+            return PLDM_ERROR;
+        }
+        return PLDM_SUCCESS;
+    }
+
+    std::stringstream lidFileName;
+    lidFileName << std::hex << ntohl(header.lidNumber) << ".lid";
+    lidFile = lidDir / lidFileName.str();
+    dest = std::make_unique<pldm::utils::CustomFD>(
+        open(lidFile.c_str(), O_RDWR | O_CREAT | O_TRUNC, S_IRUSR | S_IWUSR));
+    if ((*dest)() < 0)
+    {
+        error("Failed to open the LID file {PATH}, ERROR={ERR}", "PATH",
+              lidFile.string(), "ERR", errno);
+        return PLDM_ERROR;
+    }
+    // Allocating the whole file up front keeps it contiguous, the file is
+    // written in place if the filesystem does not support it
+    if (lidSize)
+    {
+        fallocate((*dest)(), 0, 0, lidSize);
+    }
+    return PLDM_SUCCESS;
+}
+
+int LidSink::writeBody(uint32_t offset, const uint8_t* data, uint32_t length)
+{
+    if (offset < headerSize)
+    {
+        auto skip = std::min(length, headerSize - offset);
+        data += skip;
+        length -= skip;
+        offset += skip;
+    }
+    auto begin = offset - headerSize;
+    if (!length || begin >= lidSize)
+    {
+        return PLDM_SUCCESS;
+    }
+    length = std::min(length, lidSize - begin);
+
+    for (uint32_t done = 0; done < length;)
+    {
+        auto count = pwrite((*dest)(), data + done, length - done,
+                            base + begin + done);
+        if (count < 0)
+        {
+            error(
+                "Failed to write the LID body, ERROR={ERR}, LENGTH={LEN}, OFFSET={OFFSET}",
+                "ERR", errno, "LEN", length, "OFFSET", offset);
+            return PLDM_ERROR;
+        }
+        done += count;
+    }
+
+    auto end = begin + length;
+    if (begin > crcOffset)
+    {
+        crcInOrder = false;
+    }
+    else if (crcInOrder && end > crcOffset)
+    {
+        crc = lidCrc32(crc, data + (crcOffset - begin), end - crcOffset);
+        crcOffset = end;
+    }
+
+    // Merge the range with the ranges it touches
+    auto next = written.upper_bound(begin);
+    if (next != written.begin() && std::prev(next)->second >= begin)
+    {
+        --next;
+        begin = next->first;
+    }
+    while (next != written.end() && next->first <= end)
+    {
+        end = std::max(end, next->second);
+        next = written.erase(next);
+    }
+    written.emplace(begin, end);
+    return PLDM_SUCCESS;
+}
+
+int LidSink::stage(uint32_t offset, const uint8_t* data, uint32_t length)
+{
+    pldm::utils::CustomFD fd(
+        open(stagingPath.c_str(), O_WRONLY | O_CREAT, S_IRUSR));
+    if (fd() < 0)
+    {
+        error("could not open file {LID_PATH}", "LID_PATH",
+              stagingPath.string());
+        return PLDM_ERROR;
+    }
+    for (uint32_t done = 0; done < length;)
+    {
+        auto count = pwrite(fd(), data + done, length - done, offset + done);
+        if (count < 0)
+        {
+            error(
+                "file write failed, ERROR={ERR}, LENGTH={LEN}, OFFSET={OFFSET}",
+                "ERR", errno, "LEN", length, "OFFSET", offset);
+            return PLDM_ERROR;
+        }
+        done += count;
+    }
+    return PLDM_SUCCESS;
+}
+
+bool LidSink::complete() const
+{
+    if (mode != Mode::streaming)
+    {
+        return false;
+    }
+    if (!lidSize)
+    {
+        return true;
+    }
+    return written.size() == 1 && written.begin()->first == 0 &&
+           written.begin()->second == lidSize;
+}
+
+int LidSink::finish()
+{
+    // Data written out of order is read back once
+    std::optional<uint32_t> bodyCrc = crc;
+    if (!crcInOrder || crcOffset != lidSize)
+    {
+        bodyCrc = fileCrc((*dest)(), base, lidSize);
+    }
+
+    if (!checkLidCrc(lidNumber, lidCrc, bodyCrc))
+    {
+        abort();
+        return PLDM_ERROR;
+    }
+    dest.reset();
+    mode = Mode::done;
+    if (!lidFile.empty())
+    {
+        return setLidFilePermissions(lidFile);
+    }
+    return PLDM_SUCCESS;
+}
+
+void LidSink::abort()
+{
+    if (mode != Mode::streaming)
+    {
+        return;
+    }
+    mode = Mode::done;
+
+    if (!lidFile.empty())
+    {
+        dest.reset();
+        std::error_code ec;
+        fs::remove(lidFile, ec);
+        return;
+    }
+
+    // The region reserved for the LID can only be cut if no LID was
+    // reserved after it. A hole of zeros would end the tar archive there and
+    // drop the LIDs after it, so the whole image fails instead.
+    struct stat st;
+    if (fstat((*dest)(), &st) < 0)
+    {
+        error("Failed to discard LID {LID_NUMBER} from {PATH}, ERROR={ERR}",
+              "LID_NUMBER", lg2::hex, lidNumber, "PATH", tarImage.string(),
+              "ERR", errno);
+        brokenTarImages.insert(tarImage);
+    }
+    else if (static_cast<uint64_t>(st.st_size) > uint64_t(base) + lidSize)
+    {
+        error(
+            "LID {LID_NUMBER} leaves a hole of {SIZE} bytes at offset {OFFSET} of {PATH}, the image is discarded",
+            "LID_NUMBER", lg2::hex, lidNumber, "SIZE", lidSize, "OFFSET", base,
+            "PATH", tarImage.string());
+        brokenTarImages.insert(tarImage);
+    }
+    else if (ftruncate((*dest)(), base) < 0)
+    {
+        error("Failed to cut LID {LID_NUMBER} from {PATH}, ERROR={ERR}",
+              "LID_NUMBER", lg2::hex, lidNumber, "PATH", tarImage.string(),
+              "ERR", errno);
+        brokenTarImages.insert(tarImage);
+    }
+    dest.reset();
+}
+
+LidSink& getLidSink(uint32_t fileHandle, const std::string& stagingPath)
+{
+    auto& sink = lidSinks[fileHandle];
+    if (!sink)
+    {
+        sink = std::make_unique<LidSink>(stagingPath, lidDirPath,
+                                         tarImagePath);
+    }
+    return *sink;
+}
+
+void releaseLidSink(uint32_t fileHandle)
+{
+    lidSinks.erase(fileHandle);
+}
+
+bool tarImageBroken(const fs::path& tarImage)
+{
+    return brokenTarImages.contains(tarImage);
+}
+
+void clearLidSinks()
+{
+    for (auto& [fileHandle, sink] : lidSinks)
+    {
+        sink->abort();
+    }
+    lidSinks.clear();
+    brokenTarImages.clear();
+}
+
 int CodeUpdate::assembleCodeUpdateImage()
 {
     static constexpr auto UPDATER_SERVICE =
@@ -779,6 +1202,16 @@ int CodeUpdate::assembleCodeUpdateImage()
     static constexpr auto SOFTWARE_PATH = "/xyz/openbmc_project/software";
     static constexpr auto LID_INTERFACE = "xyz.openbmc_project.Software.LID";
 
+    if (tarImageBroken(tarImagePath))
+    {
+        error(
+            "InbandCodeUpdate: BMC image {PATH} is missing an aborted LID, not assembling it",
+            "PATH", tarImagePath.string());
+        std::error_code ec;
+        fs::remove(tarImagePath, ec);
+        return PLDM_ERROR;
+    }
+
     auto& bus = dBusIntf->getBus();
 
     try
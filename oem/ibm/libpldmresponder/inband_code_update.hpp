@@ -4,7 +4,11 @@
 #include "libpldmresponder/pdr_utils.hpp"
 #include "libpldmresponder/platform.hpp"
 
+#include <filesystem>
+#include <map>
+#include <memory>
 #include <string>
+#include <vector>
 
 namespace pldm
 {
@@ -27,6 +31,11 @@ struct pldm_boot_side_data
     std::string running_version_object;
 };
 
+/** @brief Drop the LIDs being streamed, the update they belong to is over,
+ *         and forget the broken BMC tar images
+ */
+void clearLidSinks();
+
 /** @class CodeUpdate
  *
  *  @brief This class performs the necessary operation in pldm for
@@ -102,6 +111,7 @@ class CodeUpdate
     void setCodeUpdateProgress(bool progress)
     {
         codeUpdateInProgress = progress;
+        clearLidSinks();
     }
 
     /* @brief Method to indicate whether out of band code update
@@ -290,6 +300,188 @@ int setBootSide(uint16_t entityInstance, uint8_t currState,
  */
 int processCodeUpdateLid(const std::string& filePath);
 
+/** @struct LidHeader
+ *
+ *  Header of the LIDs of an inband code update, the fields are big endian
+ */
+struct LidHeader
+{
+    uint16_t magicNumber;
+    uint16_t headerVersion;
+    uint32_t lidNumber;
+    uint32_t lidDate;
+    uint16_t lidTime;
+    uint16_t lidClass;
+    uint32_t lidCrc;
+    uint32_t lidSize;
+    uint32_t headerSize;
+};
+
+/** @brief Extend the CRC-32 of a LID body with the next bytes
+ *
+ *  @param[in] crc - CRC of the previous bytes, 0 to start
+ *  @param[in] data - next bytes
+ *  @param[in] size - number of bytes
+ *
+ *  @return CRC of the bytes so far
+ */
+uint32_t lidCrc32(uint32_t crc, const uint8_t* data, size_t size);
+
+/** @class LidSink
+ *
+ *  @brief Streams a LID of an inband code update to its final location as
+ *         the host writes it. The header is parsed from the first bytes, the
+ *         body goes straight to the BMC tar image or to its file in the lid
+ *         directory, and its CRC is computed on the way. Nothing is written
+ *         to the staging directory and read back.
+ *
+ *         A LID whose first bytes do not come first is written to its staging
+ *         file and left to processCodeUpdateLid, like before.
+ *
+ *         The region of a BMC LID in the tar image is reserved when its
+ *         header arrives, so the BMC LIDs follow each other in the order
+ *         their transfers start. processCodeUpdateLid appends them in the
+ *         order they complete. Both orders are the same when the host sends
+ *         the LIDs one after the other.
+ */
+class LidSink
+{
+  public:
+    LidSink() = delete;
+    LidSink(const LidSink&) = delete;
+    LidSink(LidSink&&) = delete;
+    LidSink& operator=(const LidSink&) = delete;
+    LidSink& operator=(LidSink&&) = delete;
+    ~LidSink() = default;
+
+    /** @brief Constructor
+     *
+     *  @param[in] stagingPath - staging file of the LID, used if the header
+     *                           does not come first
+     *  @param[in] lidDir - directory of the LIDs without a header
+     *  @param[in] tarImage - BMC tar image the BMC LIDs are appended to
+     */
+    LidSink(const std::filesystem::path& stagingPath,
+            const std::filesystem::path& lidDir,
+            const std::filesystem::path& tarImage) :
+        stagingPath(stagingPath),
+        lidDir(lidDir), tarImage(tarImage)
+    {}
+
+    /** @brief Write a chunk of the LID
+     *
+     *  @param[in] offset - offset of the chunk in the LID, header included
+     *  @param[in] data - chunk
+     *  @param[in] length - size of the chunk
+     *
+     *  @return PLDM_SUCCESS or PLDM_ERROR
+     */
+    int write(uint32_t offset, const uint8_t* data, uint32_t length);
+
+    /** @brief Check whether the LID is written to its staging file */
+    bool staging() const
+    {
+        return mode == Mode::staging;
+    }
+
+    /** @brief Check whether the whole body of a streamed LID is written */
+    bool complete() const;
+
+    /** @brief Verify the CRC of the body of a complete LID and close its
+     *         destination, a LID that fails is discarded
+     *
+     *  @return PLDM_SUCCESS, PLDM_ERROR if the CRC does not match
+     */
+    int finish();
+
+    /** @brief Discard the body of a LID that will not be finished: the LID
+     *         file is removed, and the region of a BMC LID is cut from the
+     *         end of the tar image. A BMC LID with other LIDs after it can
+     *         not be cut, the tar image is then marked broken.
+     */
+    void abort();
+
+  private:
+    enum class Mode
+    {
+        header,
+        streaming,
+        staging,
+        done,
+    };
+
+    /** @brief Parse the header once it is received and open the destination
+     *         of the body
+     */
+    int parseHeader();
+
+    /** @brief Open the destination of the body and reserve its space */
+    int openDestination(const LidHeader& header);
+
+    /** @brief Write a chunk to the destination of the body, the part in the
+     *         header is skipped
+     */
+    int writeBody(uint32_t offset, const uint8_t* data, uint32_t length);
+
+    /** @brief Write a chunk to the staging file */
+    int stage(uint32_t offset, const uint8_t* data, uint32_t length);
+
+    std::filesystem::path stagingPath;
+    std::filesystem::path lidDir;
+    std::filesystem::path tarImage;
+    Mode mode = Mode::header;
+
+    /** @brief first bytes of the LID, until the header is complete */
+    std::vector<uint8_t> head;
+
+    uint32_t headerSize = 0;
+    uint32_t lidNumber = 0;
+    uint32_t lidSize = 0;
+    uint32_t lidCrc = 0;
+
+    /** @brief file of a LID that is not a BMC LID */
+    std::filesystem::path lidFile;
+
+    /** @brief destination of the body, at offset base */
+    std::unique_ptr<pldm::utils::CustomFD> dest;
+    off_t base = 0;
+
+    /** @brief CRC of the body up to crcOffset, while it is written in
+     *         order
+     */
+    uint32_t crc = 0;
+    uint32_t crcOffset = 0;
+    bool crcInOrder = true;
+
+    /** @brief ranges of the body written, by begin offset */
+    std::map<uint32_t, uint32_t> written;
+};
+
+/** @brief Get the sink of a LID written during an inband code update, it is
+ *         created by the first chunk
+ *
+ *  @param[in] fileHandle - file handle of the LID
+ *  @param[in] stagingPath - staging file of the LID
+ *
+ *  @return the sink of the LID
+ */
+LidSink& getLidSink(uint32_t fileHandle, const std::string& stagingPath);
+
+/** @brief Drop the sink of a LID once it is finished or aborted
+ *
+ *  @param[in] fileHandle - file handle of the LID
+ */
+void releaseLidSink(uint32_t fileHandle);
+
+/** @brief Check whether an aborted BMC LID left a hole in the middle of a BMC
+ *         tar image, the image can not be assembled then
+ *
+ *  @param[in] tarImage - BMC tar image
+ *
+ *  @return true if the image is broken
+ */
+bool tarImageBroken(const std::filesystem::path& tarImage);
+
 /** @brief Method to assemble the code update tarball and trigger the
  *         phosphor software manager to create a version interface
  *  @return - PLDM_SUCCESS codes
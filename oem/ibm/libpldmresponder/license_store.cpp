@@ -0,0 +1,549 @@
+#include "license_store.hpp"
+
+#include "libpldm/utils.h"
+
+#include "common/utils.hpp"
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <phosphor-logging/lg2.hpp>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <system_error>
+
+PHOSPHOR_LOG2_USING;
+
+namespace pldm
+{
+namespace responder
+{
+namespace license
+{
+
+namespace
+{
+
+constexpr uint32_t snapshotMagic = 0x43494c50; // "PLIC"
+constexpr uint16_t snapshotVersion = 1;
+
+/** @struct SnapshotHeader
+ *
+ *  Header of the snapshot file, followed by the records, each preceded by
+ *  its length
+ */
+struct SnapshotHeader
+{
+    uint32_t magic;
+    uint16_t version;
+    uint16_t reserved;
+    uint32_t count; //!< number of records
+    uint32_t size;  //!< size of the records
+    uint32_t crc;   //!< checksum of the records
+};
+
+/** @struct JournalHeader
+ *
+ *  Header of a record of the journal
+ */
+struct JournalHeader
+{
+    uint32_t size; //!< size of the record
+    uint32_t crc;  //!< checksum of the record
+};
+
+enum class Operation : uint8_t
+{
+    Upsert = 1,
+    Erase = 2,
+};
+
+/** @class Writer
+ *
+ *  Encodes a record, the integers are in host byte order
+ */
+class Writer
+{
+  public:
+    template <typename T>
+    void put(T value)
+    {
+        auto bytes = reinterpret_cast<const uint8_t*>(&value);
+        data.insert(data.end(), bytes, bytes + sizeof(value));
+    }
+
+    void put(std::string_view value)
+    {
+        put(static_cast<uint16_t>(value.size()));
+        data.insert(data.end(), value.begin(), value.end());
+    }
+
+    std::vector<uint8_t> data;
+};
+
+/** @class Reader
+ *
+ *  Decodes a record, a read past the end of the record fails the reader
+ */
+class Reader
+{
+  public:
+    explicit Reader(std::span<const uint8_t> data) : data(data) {}
+
+    template <typename T>
+    T get()
+    {
+        T value{};
+        if (!valid || data.size() - offset < sizeof(value))
+        {
+            valid = false;
+            return value;
+        }
+        std::memcpy(&value, data.data() + offset, sizeof(value));
+        offset += sizeof(value);
+        return value;
+    }
+
+    std::span<const uint8_t> getBytes(size_t size)
+    {
+        if (!valid || data.size() - offset < size)
+        {
+            valid = false;
+            return {};
+        }
+        auto value = data.subspan(offset, size);
+        offset += size;
+        return value;
+    }
+
+    std::string getString()
+    {
+        auto value = getBytes(get<uint16_t>());
+        return std::string(value.begin(), value.end());
+    }
+
+    bool done() const
+    {
+        return valid && offset == data.size();
+    }
+
+  private:
+    std::span<const uint8_t> data;
+    size_t offset = 0;
+    bool valid = true;
+};
+
+std::vector<uint8_t> encodeUpsert(const License& license)
+{
+    Writer writer;
+    writer.put(Operation::Upsert);
+    writer.put(std::string_view(license.id));
+    writer.put(std::string_view(license.name));
+    writer.put(std::string_view(license.serialNumber));
+    writer.put(std::string_view(license.type));
+    writer.put(std::string_view(license.authType));
+    writer.put(license.authDeviceNumber);
+    writer.put(std::string_view(license.expirationTime));
+    writer.put(std::string_view(license.status));
+    return std::move(writer.data);
+}
+
+std::vector<uint8_t> encodeErase(std::string_view id)
+{
+    Writer writer;
+    writer.put(Operation::Erase);
+    writer.put(id);
+    return std::move(writer.data);
+}
+
+/** @brief Write a buffer to a file and flush it to the storage
+ *
+ *  @return 0 on success, errno on failure
+ */
+int writeAndSync(int fd, const std::vector<uint8_t>& data)
+{
+    size_t written = 0;
+    while (written < data.size())
+    {
+        auto rc = write(fd, data.data() + written, data.size() - written);
+        if (rc < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            return errno;
+        }
+        written += rc;
+    }
+    return fsync(fd) ? errno : 0;
+}
+
+/** @brief Flush the entries of a directory to the storage, so that a file
+ *         created or renamed in it survives a power loss
+ *
+ *  @return 0 on success, errno on failure
+ */
+int syncDirectory(const fs::path& path)
+{
+    int fd = open(path.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if (fd < 0)
+    {
+        return errno;
+    }
+    pldm::utils::CustomFD dir(fd);
+    return fsync(dir()) ? errno : 0;
+}
+
+std::vector<uint8_t> readFile(const fs::path& path)
+{
+    std::ifstream file(path, std::ios::in | std::ios::binary);
+    if (!file)
+    {
+        return {};
+    }
+    return std::vector<uint8_t>(std::istreambuf_iterator<char>(file), {});
+}
+
+} // namespace
+
+std::optional<License> License::fromJson(const nlohmann::json& entry)
+{
+    try
+    {
+        License license;
+        license.id = entry.value("Id", "");
+        if (license.id.empty())
+        {
+            error("License entry without ID");
+            return std::nullopt;
+        }
+        license.name = entry.value("Name", "");
+        license.serialNumber = entry.value("SerialNum", "");
+        license.type = entry.value("Type", "");
+        license.authType = entry.value("AuthType", "");
+        license.authDeviceNumber = entry.value("AuthDeviceNumber", 0u);
+        license.expirationTime = entry.value("ExpirationTime", "");
+        license.status = entry.value("Status", "");
+        return license;
+    }
+    catch (const nlohmann::json::exception& e)
+    {
+        error("Malformed license entry, ERROR={ERR_EXCEP}", "ERR_EXCEP",
+              e.what());
+        return std::nullopt;
+    }
+}
+
+LicenseStore::LicenseStore(const fs::path& snapshotPath,
+                           const fs::path& journalPath,
+                           size_t maxJournalRecords) :
+    snapshotPath(snapshotPath),
+    journalPath(journalPath), maxJournalRecords(maxJournalRecords)
+{}
+
+bool LicenseStore::load()
+{
+    licenses.clear();
+    byAuthDeviceNumber.clear();
+    journalCount = 0;
+
+    bool valid = true;
+    auto snapshot = readFile(snapshotPath);
+    if (!snapshot.empty())
+    {
+        SnapshotHeader header{};
+        std::span<const uint8_t> body;
+        if (snapshot.size() >= sizeof(header))
+        {
+            std::memcpy(&header, snapshot.data(), sizeof(header));
+            body = std::span<const uint8_t>(snapshot).subspan(sizeof(header));
+        }
+        valid = header.magic == snapshotMagic &&
+                header.version == snapshotVersion &&
+                header.size == body.size() &&
+                header.crc == crc32(body.data(), body.size());
+
+        Reader reader(body);
+        for (uint32_t count = 0; valid && count < header.count; ++count)
+        {
+            valid = apply(reader.getBytes(reader.get<uint32_t>()));
+        }
+        valid = valid && reader.done();
+        if (!valid)
+        {
+            // Kept aside for analysis, the compaction below replaces it
+            auto corruptedPath = snapshotPath;
+            corruptedPath += ".corrupted";
+            std::error_code ec;
+            fs::rename(snapshotPath, corruptedPath, ec);
+            error("License store {PATH} is corrupted, moved to {CORRUPTED}",
+                  "PATH", snapshotPath.string(), "CORRUPTED",
+                  corruptedPath.string());
+            licenses.clear();
+            byAuthDeviceNumber.clear();
+        }
+    }
+
+    // The journal ends at the first torn record
+    auto records = readFile(journalPath);
+    Reader reader(records);
+    while (!reader.done())
+    {
+        auto header = reader.get<JournalHeader>();
+        auto record = reader.getBytes(header.size);
+        if (record.empty() || header.crc != crc32(record.data(), record.size()))
+        {
+            error("License journal {PATH} is torn after {COUNT} records",
+                  "PATH", journalPath.string(), "COUNT", journalCount);
+            break;
+        }
+        if (!apply(record))
+        {
+            error("License journal record {COUNT} is malformed", "COUNT",
+                  journalCount);
+        }
+        ++journalCount;
+    }
+
+    // Drop the torn record, the next update must not follow it
+    if (!reader.done() || !valid)
+    {
+        compact();
+    }
+    return valid;
+}
+
+bool LicenseStore::apply(std::span<const uint8_t> record)
+{
+    Reader reader(record);
+    auto operation = reader.get<Operation>();
+    if (operation == Operation::Erase)
+    {
+        auto id = reader.getString();
+        if (!reader.done())
+        {
+            return false;
+        }
+        auto license = licenses.find(id);
+        if (license != licenses.end())
+        {
+            unindex(license->second);
+            licenses.erase(license);
+        }
+        return true;
+    }
+    if (operation != Operation::Upsert)
+    {
+        return false;
+    }
+
+    License license;
+    license.id = reader.getString();
+    license.name = reader.getString();
+    license.serialNumber = reader.getString();
+    license.type = reader.getString();
+    license.authType = reader.getString();
+    license.authDeviceNumber = reader.get<uint32_t>();
+    license.expirationTime = reader.getString();
+    license.status = reader.getString();
+    if (!reader.done() || license.id.empty())
+    {
+        return false;
+    }
+
+    auto current = licenses.find(license.id);
+    if (current != licenses.end())
+    {
+        unindex(current->second);
+        current->second = std::move(license);
+        index(current->second);
+    }
+    else
+    {
+        auto id = license.id;
+        index(licenses.emplace(std::move(id), std::move(license))
+                  .first->second);
+    }
+    return true;
+}
+
+void LicenseStore::index(const License& license)
+{
+    byAuthDeviceNumber.emplace(license.authDeviceNumber, license.id);
+}
+
+void LicenseStore::unindex(const License& license)
+{
+    auto [begin, end] = byAuthDeviceNumber.equal_range(
+        license.authDeviceNumber);
+    for (auto entry = begin; entry != end; ++entry)
+    {
+        if (entry->second == license.id)
+        {
+            byAuthDeviceNumber.erase(entry);
+            return;
+        }
+    }
+}
+
+const License* LicenseStore::find(std::string_view id) const
+{
+    auto license = licenses.find(id);
+    return license == licenses.end() ? nullptr : &license->second;
+}
+
+std::vector<const License*>
+    LicenseStore::findByAuthDeviceNumber(uint32_t number) const
+{
+    std::vector<const License*> result;
+    auto [begin, end] = byAuthDeviceNumber.equal_range(number);
+    for (auto entry = begin; entry != end; ++entry)
+    {
+        result.push_back(&licenses.find(entry->second)->second);
+    }
+    std::sort(result.begin(), result.end(),
+              [](const License* a, const License* b) { return a->id < b->id; });
+    return result;
+}
+
+bool LicenseStore::upsert(const License& license)
+{
+    auto current = find(license.id);
+    if (license.id.empty() || (current && *current == license))
+    {
+        return false;
+    }
+    auto record = encodeUpsert(license);
+    journal(record);
+    apply(record);
+    return true;
+}
+
+bool LicenseStore::erase(std::string_view id)
+{
+    if (!find(id))
+    {
+        return false;
+    }
+    auto record = encodeErase(id);
+    journal(record);
+    apply(record);
+    return true;
+}
+
+void LicenseStore::journal(const std::vector<uint8_t>& record)
+{
+    if (journalCount >= maxJournalRecords)
+    {
+        compact();
+    }
+
+    JournalHeader header{static_cast<uint32_t>(record.size()),
+                         crc32(record.data(), record.size())};
+    std::vector<uint8_t> data(sizeof(header));
+    std::memcpy(data.data(), &header, sizeof(header));
+    data.insert(data.end(), record.begin(), record.end());
+
+    bool created = !fs::exists(journalPath);
+    int fd = open(journalPath.c_str(),
+                  O_WRONLY | O_APPEND | O_CREAT | O_CLOEXEC, 0644);
+    if (fd < 0)
+    {
+        throw std::system_error(errno, std::generic_category(),
+                                "Failed to open the license journal " +
+                                    journalPath.string());
+    }
+    pldm::utils::CustomFD file(fd);
+
+    struct stat st
+    {};
+    auto rc = fstat(file(), &st) ? errno : writeAndSync(file(), data);
+    if (!rc && created)
+    {
+        rc = syncDirectory(journalPath.parent_path());
+    }
+    if (rc)
+    {
+        // A partial record would end the journal on load and hide the
+        // records appended after it
+        if (ftruncate(file(), st.st_size))
+        {
+            error("Failed to truncate the license journal {PATH}", "PATH",
+                  journalPath.string());
+        }
+        throw std::system_error(rc, std::generic_category(),
+                                "Failed to write the license journal " +
+                                    journalPath.string());
+    }
+    ++journalCount;
+}
+
+bool LicenseStore::compact()
+{
+    Writer body;
+    for (const auto& [id, license] : licenses)
+    {
+        auto record = encodeUpsert(license);
+        body.put(static_cast<uint32_t>(record.size()));
+        body.data.insert(body.data.end(), record.begin(), record.end());
+    }
+    SnapshotHeader header{snapshotMagic,
+                          snapshotVersion,
+                          0,
+                          static_cast<uint32_t>(licenses.size()),
+                          static_cast<uint32_t>(body.data.size()),
+                          crc32(body.data.data(), body.data.size())};
+    std::vector<uint8_t> data(sizeof(header));
+    std::memcpy(data.data(), &header, sizeof(header));
+    data.insert(data.end(), body.data.begin(), body.data.end());
+
+    // The new snapshot is on the storage before it replaces the old one in
+    // one rename, and the rename before the journal is dropped. Replaying a
+    // journal left by a power loss on the new snapshot changes nothing.
+    auto tempPath = snapshotPath;
+    tempPath += ".tmp";
+    std::error_code ec;
+    int fd = open(tempPath.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC,
+                  0644);
+    int rc = fd < 0 ? errno : 0;
+    if (!rc)
+    {
+        pldm::utils::CustomFD file(fd);
+        rc = writeAndSync(file(), data);
+    }
+    if (rc)
+    {
+        error("Failed to write the license store {PATH}, ERROR={ERR}", "PATH",
+              tempPath.string(), "ERR", std::strerror(rc));
+        fs::remove(tempPath, ec);
+        return false;
+    }
+    fs::rename(tempPath, snapshotPath, ec);
+    if (ec)
+    {
+        error("Failed to replace the license store {PATH}, ERROR={ERR}",
+              "PATH", snapshotPath.string(), "ERR", ec.message());
+        fs::remove(tempPath, ec);
+        return false;
+    }
+    rc = syncDirectory(snapshotPath.parent_path());
+    if (rc)
+    {
+        error("Failed to sync the license store {PATH}, ERROR={ERR}", "PATH",
+              snapshotPath.string(), "ERR", std::strerror(rc));
+        return false;
+    }
+    fs::remove(journalPath, ec);
+    journalCount = 0;
+    return true;
+}
+
+} // namespace license
+} // namespace responder
+} // namespace pldm
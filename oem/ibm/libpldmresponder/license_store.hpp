@@ -0,0 +1,181 @@
+#pragma once
+
+#include <stdint.h>
+
+#include <nlohmann/json.hpp>
+
+#include <filesystem>
+#include <map>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace pldm
+{
+namespace responder
+{
+namespace license
+{
+
+namespace fs = std::filesystem;
+
+/** @struct License
+ *
+ *  License of the license store, the fields keep the values of the license
+ *  JSON sent by the host
+ */
+struct License
+{
+    std::string id;
+    std::string name;
+    std::string serialNumber;
+    std::string type;           //!< "Trial", "Commercial" or "Prototype"
+    std::string authType;       //!< "NumberOfDevice", "Unlimited"...
+    uint32_t authDeviceNumber = 0;
+    std::string expirationTime; //!< "%Y-%m-%dT%H:%M:%SZ", may be empty
+    std::string status;         //!< "Enabled", "Disabled" or "Unknown"
+
+    bool operator==(const License&) const = default;
+
+    /** @brief Read a license from an entry of the "Licenses" array of the
+     *         license JSON
+     *
+     *  @param[in] entry - license JSON entry
+     *
+     *  @return the license, std::nullopt if the entry has no ID
+     */
+    static std::optional<License> fromJson(const nlohmann::json& entry);
+};
+
+/** @class LicenseStore
+ *
+ *  @brief Persistent store of the licenses, indexed by license ID and by
+ *         authorization device number.
+ *
+ *         The store is a snapshot file, a fixed header followed by the
+ *         records, and a journal file the changed records are appended to.
+ *         Each journal record carries its length and checksum, so that a
+ *         record torn by a power loss is dropped on load and every update of
+ *         a license is atomic. Both files are synced to the storage before
+ *         an update returns. The journal is folded into a new snapshot,
+ *         renamed over the old one, once it holds more than
+ *         maxJournalRecords records. A corrupted snapshot is moved aside to
+ *         the ".corrupted" file next to it.
+ */
+class LicenseStore
+{
+  public:
+    LicenseStore() = delete;
+    LicenseStore(const LicenseStore&) = delete;
+    LicenseStore(LicenseStore&&) = delete;
+    LicenseStore& operator=(const LicenseStore&) = delete;
+    LicenseStore& operator=(LicenseStore&&) = delete;
+    ~LicenseStore() = default;
+
+    /** @brief Constructor, the store is empty until it is loaded
+     *
+     *  @param[in] snapshotPath - path of the snapshot file
+     *  @param[in] journalPath - path of the journal file
+     *  @param[in] maxJournalRecords - journal records before a compaction
+     */
+    LicenseStore(const fs::path& snapshotPath, const fs::path& journalPath,
+                 size_t maxJournalRecords = 64);
+
+    /** @brief Load the snapshot and replay the journal
+     *
+     *  @return false if the snapshot is corrupted, the licenses of the
+     *          journal are loaded then
+     */
+    bool load();
+
+    /** @brief Find a license by ID
+     *
+     *  @param[in] id - license ID
+     *
+     *  @return the license, nullptr if it is not found
+     */
+    const License* find(std::string_view id) const;
+
+    /** @brief Find the licenses of an authorization device number
+     *
+     *  @param[in] number - authorization device number
+     *
+     *  @return the licenses, sorted by ID
+     */
+    std::vector<const License*> findByAuthDeviceNumber(uint32_t number) const;
+
+    /** @brief Licenses, by ID */
+    const std::map<std::string, License, std::less<>>& getLicenses() const
+    {
+        return licenses;
+    }
+
+    /** @brief Add or replace a license, nothing is written if the license
+     *         is unchanged
+     *
+     *  @param[in] license - license
+     *
+     *  @return true if the license was added or changed
+     *
+     *  @throw std::system_error if the journal cannot be written, the
+     *         license is not changed then
+     */
+    bool upsert(const License& license);
+
+    /** @brief Remove a license
+     *
+     *  @param[in] id - license ID
+     *
+     *  @return true if the license was removed
+     *
+     *  @throw std::system_error if the journal cannot be written, the
+     *         license is not removed then
+     */
+    bool erase(std::string_view id);
+
+    /** @brief Write all the licenses to a new snapshot and empty the
+     *         journal
+     *
+     *  @return false if the snapshot cannot be written, the previous
+     *          snapshot and the journal are kept then
+     */
+    bool compact();
+
+    /** @brief Number of records in the journal */
+    size_t journalRecords() const
+    {
+        return journalCount;
+    }
+
+  private:
+    /** @brief Append a record to the journal, compacting if it is full
+     *
+     *  @throw std::system_error if the record cannot be written
+     */
+    void journal(const std::vector<uint8_t>& record);
+
+    /** @brief Apply a record of the snapshot or the journal
+     *
+     *  @return false if the record is malformed
+     */
+    bool apply(std::span<const uint8_t> record);
+
+    void index(const License& license);
+    void unindex(const License& license);
+
+    fs::path snapshotPath;
+    fs::path journalPath;
+    size_t maxJournalRecords;
+    size_t journalCount = 0;
+
+    std::map<std::string, License, std::less<>> licenses;
+
+    /** @brief license IDs by authorization device number */
+    std::multimap<uint32_t, std::string> byAuthDeviceNumber;
+};
+
+} // namespace license
+} // namespace responder
+} // namespace pldm
@@ -10,7 +10,9 @@
 
 #include <phosphor-logging/lg2.hpp>
 
+#include <algorithm>
 #include <regex>
+#include <string_view>
 
 PHOSPHOR_LOG2_USING;
 
@@ -23,12 +25,10 @@ namespace responder
 {
 namespace oem_ibm_platform
 {
-std::vector<InstanceInfo> generateProcAndDcmIDs()
+std::vector<InstanceInfo>
+    generateProcAndDcmIDs(const std::vector<std::string>& procObjectPaths)
 {
     std::vector<InstanceInfo> dcmProcInfo;
-    std::vector<std::string> procObjectPaths;
-    procObjectPaths = getProcObjectPaths();
-
     for (const auto& entity_path : procObjectPaths)
     {
         if (entity_path.rfind('/') != std::string::npos)
@@ -45,12 +45,10 @@ std::vector<InstanceInfo> generateProcAndDcmIDs()
     return dcmProcInfo;
 }
 
-std::vector<uint16_t> generateDimmIds()
+std::vector<uint16_t>
+    generateDimmIds(const std::vector<std::string>& dimmObjPaths)
 {
     std::vector<uint16_t> dimmInfo;
-    std::vector<std::string> dimmObjPaths;
-    dimmObjPaths = getDimmObjectPaths();
-
     for (const auto& entity_path : dimmObjPaths)
     {
         if (entity_path.rfind('/') != std::string::npos)
@@ -320,7 +318,8 @@ int pldm::responder::oem_ibm_platform::Handler::
 
 void buildAllCodeUpdateEffecterPDR(oem_ibm_platform::Handler* platformHandler,
                                    uint16_t entityType, uint16_t entityInstance,
-                                   uint16_t stateSetID, pdr_utils::Repo& repo)
+                                   uint16_t stateSetID,
+                                   pdr_utils::PdrBatch& batch)
 {
     size_t pdrSize = 0;
     pdrSize = sizeof(pldm_state_effecter_pdr) +
@@ -363,14 +362,11 @@ void buildAllCodeUpdateEffecterPDR(oem_ibm_platform::Handler* platformHandler,
         state->states[0].byte = 126;
     else if (stateSetID == PLDM_OEM_IBM_SYSTEM_POWER_STATE)
         state->states[0].byte = 2;
-    pldm::responder::pdr_utils::PdrEntry pdrEntry{};
-    pdrEntry.data = entry.data();
-    pdrEntry.size = pdrSize;
-    repo.addRecord(pdrEntry);
+    batch.add(entry.data(), pdrSize);
 }
 
 void buildAllSlotEnabeEffecterPDR(oem_ibm_platform::Handler* platformHandler,
-                                  pdr_utils::Repo& repo,
+                                  pdr_utils::PdrBatch& batch,
                                   const std::vector<std::string>& slotobjpaths)
 {
     size_t pdrSize = 0;
@@ -428,16 +424,14 @@ void buildAllSlotEnabeEffecterPDR(oem_ibm_platform::Handler* platformHandler,
         auto state =
             reinterpret_cast<state_effecter_possible_states*>(possibleStates);
         state->states[0].byte = 14;
-        pldm::responder::pdr_utils::PdrEntry pdrEntry{};
-        pdrEntry.data = entry.data();
-        pdrEntry.size = pdrSize;
-        repo.addRecord(pdrEntry);
+        batch.add(entry.data(), pdrSize);
     }
 }
 
 void buildAllCodeUpdateSensorPDR(oem_ibm_platform::Handler* platformHandler,
                                  uint16_t entityType, uint16_t entityInstance,
-                                 uint16_t stateSetID, pdr_utils::Repo& repo)
+                                 uint16_t stateSetID,
+                                 pdr_utils::PdrBatch& batch)
 {
     size_t pdrSize = 0;
     pdrSize = sizeof(pldm_state_sensor_pdr) +
@@ -478,14 +472,11 @@ void buildAllCodeUpdateSensorPDR(oem_ibm_platform::Handler* platformHandler,
         state->states[0].byte = 6;
     else if (stateSetID == PLDM_OEM_IBM_FIRMWARE_UPDATE_STATE)
         state->states[0].byte = 126;
-    pldm::responder::pdr_utils::PdrEntry pdrEntry{};
-    pdrEntry.data = entry.data();
-    pdrEntry.size = pdrSize;
-    repo.addRecord(pdrEntry);
+    batch.add(entry.data(), pdrSize);
 }
 
 void buildAllSlotEnableSensorPDR(oem_ibm_platform::Handler* platformHandler,
-                                 pdr_utils::Repo& repo,
+                                 pdr_utils::PdrBatch& batch,
                                  const std::vector<std::string>& slotobjpaths)
 {
     size_t pdrSize = 0;
@@ -538,18 +529,16 @@ void buildAllSlotEnableSensorPDR(oem_ibm_platform::Handler* platformHandler,
         auto state =
             reinterpret_cast<state_sensor_possible_states*>(possibleStates);
         state->states[0].byte = 15;
-        pldm::responder::pdr_utils::PdrEntry pdrEntry{};
-        pdrEntry.data = entry.data();
-        pdrEntry.size = pdrSize;
-        repo.addRecord(pdrEntry);
+        batch.add(entry.data(), pdrSize);
     }
 }
 
 void buildAllNumericEffecterPDR(oem_ibm_platform::Handler* platformHandler,
                                 uint16_t entityType, uint16_t entityInstance,
                                 uint16_t effecterSemanticId,
-                                pdr_utils::Repo& repo,
-                                HostEffecterInstanceMap& instanceMap)
+                                pdr_utils::PdrBatch& batch,
+                                HostEffecterInstanceMap& instanceMap,
+                                const std::vector<InstanceInfo>& info)
 {
     size_t pdrSize = 0;
     pdrSize = sizeof(pldm_numeric_effecter_value_pdr);
@@ -564,9 +553,6 @@ void buildAllNumericEffecterPDR(oem_ibm_platform::Handler* platformHandler,
         return;
     }
 
-    std::vector<InstanceInfo> info;
-    info = generateProcAndDcmIDs();
-
     for (auto procDcmInfo : info)
     {
         pdr->hdr.record_handle = 0;
@@ -619,10 +605,7 @@ void buildAllNumericEffecterPDR(oem_ibm_platform::Handler* platformHandler,
         pdr->rated_max.value_u32 = 0;
         pdr->rated_min.value_u32 = 0;
 
-        pldm::responder::pdr_utils::PdrEntry pdrEntry{};
-        pdrEntry.data = entry.data();
-        pdrEntry.size = pdrSize;
-        repo.addRecord(pdrEntry);
+        batch.add(entry.data(), pdrSize);
     }
 }
 
@@ -630,8 +613,9 @@ void buildAllNumericEffecterDimmPDR(oem_ibm_platform::Handler* platformHandler,
                                     uint16_t entityType,
                                     uint16_t entityInstance,
                                     uint16_t effecterSemanticId,
-                                    pdr_utils::Repo& repo,
-                                    HostEffecterDimmMap& instanceDimmMap)
+                                    pdr_utils::PdrBatch& batch,
+                                    HostEffecterDimmMap& instanceDimmMap,
+                                    const std::vector<uint16_t>& dimm_info)
 {
     size_t pdrSize = 0;
     pdrSize = sizeof(pldm_numeric_effecter_value_pdr);
@@ -650,8 +634,6 @@ void buildAllNumericEffecterDimmPDR(oem_ibm_platform::Handler* platformHandler,
     if (entityType == PLDM_ENTITY_MEMORY_MODULE &&
         effecterSemanticId == PLDM_OEM_IBM_SBE_SEMANTIC_ID)
     {
-        std::vector<uint16_t> dimm_info;
-        dimm_info = generateDimmIds();
         for (auto dimm : dimm_info)
         {
             pdr->hdr.record_handle = 0;
@@ -700,17 +682,15 @@ void buildAllNumericEffecterDimmPDR(oem_ibm_platform::Handler* platformHandler,
             pdr->rated_max.value_u32 = 0;
             pdr->rated_min.value_u32 = 0;
 
-            pldm::responder::pdr_utils::PdrEntry pdrEntry{};
-            pdrEntry.data = entry.data();
-            pdrEntry.size = pdrSize;
-            repo.addRecord(pdrEntry);
+            batch.add(entry.data(), pdrSize);
         }
     }
 }
 
 void buildAllDimmSensorPDR(oem_ibm_platform::Handler* platformHandler,
                            uint16_t entityType, uint16_t stateSetID,
-                           pdr_utils::Repo& repo)
+                           pdr_utils::PdrBatch& batch,
+                           const std::vector<uint16_t>& dimm_info)
 {
     size_t pdrSize = 0;
     pdrSize = sizeof(pldm_state_sensor_pdr) +
@@ -725,7 +705,6 @@ void buildAllDimmSensorPDR(oem_ibm_platform::Handler* platformHandler,
               static_cast<unsigned>(PLDM_PLATFORM_INVALID_SENSOR_ID));
         return;
     }
-    auto dimm_info = generateDimmIds();
     for (const auto& dimm : dimm_info)
     {
         pdr->hdr.record_handle = 0;
@@ -752,16 +731,13 @@ void buildAllDimmSensorPDR(oem_ibm_platform::Handler* platformHandler,
             reinterpret_cast<state_sensor_possible_states*>(possibleStates);
         if (stateSetID == PLDM_OEM_IBM_SBE_DUMP_UPDATE_STATE)
             state->states[0].byte = 7;
-        pldm::responder::pdr_utils::PdrEntry pdrEntry{};
-        pdrEntry.data = entry.data();
-        pdrEntry.size = pdrSize;
-        repo.addRecord(pdrEntry);
+        batch.add(entry.data(), pdrSize);
     }
 }
 
 void buildAllSystemPowerStateEffecterPDR(
     oem_ibm_platform::Handler* platformHandler, uint16_t entityType,
-    uint16_t entityInstance, uint16_t stateSetID, pdr_utils::Repo& repo)
+    uint16_t entityInstance, uint16_t stateSetID, pdr_utils::PdrBatch& batch)
 {
     size_t pdrSize = 0;
     pdrSize = sizeof(pldm_state_effecter_pdr) +
@@ -800,24 +776,7 @@ void buildAllSystemPowerStateEffecterPDR(
         reinterpret_cast<state_effecter_possible_states*>(possibleStates);
     state->states[0].byte = 128;
     state->states[1].byte = 6;
-    pldm::responder::pdr_utils::PdrEntry pdrEntry{};
-    pdrEntry.data = entry.data();
-    pdrEntry.size = pdrSize;
-    repo.addRecord(pdrEntry);
-}
-
-std::vector<std::string> getslotPaths()
-{
-    static constexpr auto searchpath = "/xyz/openbmc_project/inventory/system";
-    int depth = 0;
-    pldm::utils::GetSubTreeResponse response =
-        pldm::utils::DBusHandler().getSubtree(
-            searchpath, depth, {"xyz.openbmc_project.Inventory.Item.PCIeSlot"});
-    std::vector<std::string> slotPaths;
-    std::transform(response.begin(), response.end(),
-                   std::back_inserter(slotPaths),
-                   [](const auto& kv) { return kv.first; });
-    return slotPaths;
+    batch.add(entry.data(), pdrSize);
 }
 
 void attachOemEntityToEntityAssociationPDR(
@@ -855,6 +814,7 @@ void attachOemEntityToEntityAssociationPDR(
         pldm_entity_association_pdr_add_contained_entity(
             repo.getPdr(), childEntity, parent_entity, &bmcEventDataOps, false,
             bmc_record_handle);
+        pldm::utils::pdrRepoChanged();
     }
 }
 
@@ -906,7 +866,7 @@ std::filesystem::path pldm::responder::oem_ibm_platform::Handler::getConfigDir()
 
 void buildAllRealSAIEffecterPDR(oem_ibm_platform::Handler* platformHandler,
                                 uint16_t entityType, uint16_t entityInstance,
-                                pdr_utils::Repo& repo)
+                                pdr_utils::PdrBatch& batch)
 
 {
     size_t pdrSize = 0;
@@ -945,15 +905,12 @@ void buildAllRealSAIEffecterPDR(oem_ibm_platform::Handler* platformHandler,
     auto state =
         reinterpret_cast<state_effecter_possible_states*>(possibleStates);
     state->states[0].byte = 2;
-    pldm::responder::pdr_utils::PdrEntry pdrEntry{};
-    pdrEntry.data = entry.data();
-    pdrEntry.size = pdrSize;
-    repo.addRecord(pdrEntry);
+    batch.add(entry.data(), pdrSize);
 }
 
 void buildAllRealSAISensorPDR(oem_ibm_platform::Handler* platformHandler,
                               uint16_t entityType, uint16_t entityInstance,
-                              pdr_utils::Repo& repo)
+                              pdr_utils::PdrBatch& batch)
 {
     size_t pdrSize = 0;
     pdrSize = sizeof(pldm_state_sensor_pdr) +
@@ -990,53 +947,72 @@ void buildAllRealSAISensorPDR(oem_ibm_platform::Handler* platformHandler,
     auto state =
         reinterpret_cast<state_sensor_possible_states*>(possibleStates);
     state->states[0].byte = 6;
-    pldm::responder::pdr_utils::PdrEntry pdrEntry{};
-    pdrEntry.data = entry.data();
-    pdrEntry.size = pdrSize;
-    repo.addRecord(pdrEntry);
+    batch.add(entry.data(), pdrSize);
 }
 
 void pldm::responder::oem_ibm_platform::Handler::buildOEMPDR(
     pdr_utils::Repo& repo)
 {
+    // One mapper query for all the inventory items the PDRs are built for
+    auto inventory = getOemInventoryPaths();
+    auto procDcmInfo = generateProcAndDcmIDs(inventory.procs);
+    auto dimmInfo = generateDimmIds(inventory.dimms);
+
+    // The records are generated into one arena and added to the repo
+    // together, in the order of the effecter and sensor ids
+    constexpr size_t fixedRecords = 9;
+    auto records = fixedRecords + 2 * inventory.slots.size() +
+                   procDcmInfo.size() + 2 * dimmInfo.size();
+    constexpr auto maxRecordSize =
+        std::max({sizeof(pldm_state_effecter_pdr) +
+                      sizeof(state_effecter_possible_states),
+                  sizeof(pldm_state_sensor_pdr) +
+                      sizeof(state_sensor_possible_states),
+                  sizeof(pldm_numeric_effecter_value_pdr)});
+    pdr_utils::PdrBatch batch;
+    batch.reserve(records, records * maxRecordSize);
+
     buildAllCodeUpdateEffecterPDR(this, PLDM_OEM_IBM_ENTITY_FIRMWARE_UPDATE,
                                   ENTITY_INSTANCE_0,
-                                  PLDM_OEM_IBM_FIRMWARE_UPDATE_STATE, repo);
+                                  PLDM_OEM_IBM_FIRMWARE_UPDATE_STATE, batch);
     buildAllCodeUpdateEffecterPDR(this, PLDM_ENTITY_SYSTEM_CHASSIS,
                                   ENTITY_INSTANCE_1,
-                                  PLDM_OEM_IBM_SYSTEM_POWER_STATE, repo);
+                                  PLDM_OEM_IBM_SYSTEM_POWER_STATE, batch);
 
-    buildAllSlotEnabeEffecterPDR(this, repo, getslotPaths());
-    buildAllSlotEnableSensorPDR(this, repo, getslotPaths());
+    buildAllSlotEnabeEffecterPDR(this, batch, inventory.slots);
+    buildAllSlotEnableSensorPDR(this, batch, inventory.slots);
 
     buildAllRealSAIEffecterPDR(this, PLDM_OEM_IBM_ENTITY_REAL_SAI,
-                               ENTITY_INSTANCE_1, repo);
+                               ENTITY_INSTANCE_1, batch);
     buildAllRealSAISensorPDR(this, PLDM_OEM_IBM_ENTITY_REAL_SAI,
-                             ENTITY_INSTANCE_1, repo);
+                             ENTITY_INSTANCE_1, batch);
 
     buildAllCodeUpdateEffecterPDR(this, PLDM_OEM_IBM_ENTITY_FIRMWARE_UPDATE,
                                   ENTITY_INSTANCE_0,
-                                  PLDM_OEM_IBM_BOOT_SIDE_RENAME, repo);
+                                  PLDM_OEM_IBM_BOOT_SIDE_RENAME, batch);
 
     buildAllCodeUpdateSensorPDR(this, PLDM_OEM_IBM_ENTITY_FIRMWARE_UPDATE,
                                 ENTITY_INSTANCE_0,
-                                PLDM_OEM_IBM_FIRMWARE_UPDATE_STATE, repo);
+                                PLDM_OEM_IBM_FIRMWARE_UPDATE_STATE, batch);
     buildAllCodeUpdateSensorPDR(this, PLDM_OEM_IBM_ENTITY_FIRMWARE_UPDATE,
                                 ENTITY_INSTANCE_0,
-                                PLDM_OEM_IBM_VERIFICATION_STATE, repo);
+                                PLDM_OEM_IBM_VERIFICATION_STATE, batch);
     buildAllCodeUpdateSensorPDR(this, PLDM_OEM_IBM_ENTITY_FIRMWARE_UPDATE,
                                 ENTITY_INSTANCE_0,
-                                PLDM_OEM_IBM_BOOT_SIDE_RENAME, repo);
+                                PLDM_OEM_IBM_BOOT_SIDE_RENAME, batch);
     buildAllNumericEffecterPDR(this, PLDM_ENTITY_PROC, ENTITY_INSTANCE_0,
-                               PLDM_OEM_IBM_SBE_SEMANTIC_ID, repo, instanceMap);
+                               PLDM_OEM_IBM_SBE_SEMANTIC_ID, batch,
+                               instanceMap, procDcmInfo);
     buildAllNumericEffecterDimmPDR(
         this, PLDM_ENTITY_MEMORY_MODULE, ENTITY_INSTANCE_0,
-        PLDM_OEM_IBM_SBE_SEMANTIC_ID, repo, instanceDimmMap);
+        PLDM_OEM_IBM_SBE_SEMANTIC_ID, batch, instanceDimmMap, dimmInfo);
     buildAllDimmSensorPDR(this, PLDM_ENTITY_MEMORY_MODULE,
-                          PLDM_OEM_IBM_SBE_DUMP_UPDATE_STATE, repo);
+                          PLDM_OEM_IBM_SBE_DUMP_UPDATE_STATE, batch, dimmInfo);
     buildAllSystemPowerStateEffecterPDR(
         this, PLDM_OEM_IBM_CHASSIS_POWER_CONTROLLER, ENTITY_INSTANCE_0,
-        PLDM_STATE_SET_SYSTEM_POWER_STATE, repo);
+        PLDM_STATE_SET_SYSTEM_POWER_STATE, batch);
+
+    batch.commit(repo);
 
     pldm_entity fwUpEntity = {PLDM_OEM_IBM_ENTITY_FIRMWARE_UPDATE, 0, 1};
     attachOemEntityToEntityAssociationPDR(
@@ -1405,36 +1381,45 @@ int pldm::responder::oem_ibm_platform::Handler::setNumericEffecter(
     return PLDM_SUCCESS;
 }
 
-std::vector<std::string> getProcObjectPaths()
+OemInventoryPaths getOemInventoryPaths()
 {
     static constexpr auto searchpath = "/xyz/openbmc_project/inventory/system";
+    static constexpr auto slotInterface =
+        "xyz.openbmc_project.Inventory.Item.PCIeSlot";
+    static constexpr auto procInterface =
+        "xyz.openbmc_project.Inventory.Item.Cpu";
+    static constexpr auto dimmInterface =
+        "xyz.openbmc_project.Inventory.Item.Dimm";
     int depth = 0;
-    std::vector<std::string> procInterface = {
-        "xyz.openbmc_project.Inventory.Item.Cpu"};
     pldm::utils::GetSubTreeResponse response =
-        pldm::utils::DBusHandler().getSubtree(searchpath, depth, procInterface);
-    std::vector<std::string> procPaths;
-    for (const auto& [objPath, serviceMap] : response)
-    {
-        procPaths.emplace_back(objPath);
-    }
-    return procPaths;
-}
+        pldm::utils::DBusHandler().getSubtree(
+            searchpath, depth, {slotInterface, procInterface, dimmInterface});
 
-std::vector<std::string> getDimmObjectPaths()
-{
-    static constexpr auto searchpath = "/xyz/openbmc_project/inventory/system";
-    static constexpr auto itemPath = "xyz.openbmc_project.Inventory.Item.Dimm";
-    int depth = 0;
-    std::vector<std::string> dimmInterface = {itemPath};
-    pldm::utils::GetSubTreeResponse response =
-        pldm::utils::DBusHandler().getSubtree(searchpath, depth, dimmInterface);
-    std::vector<std::string> dimmPaths;
+    // The paths come sorted, like the ones of the per interface queries
+    OemInventoryPaths paths;
     for (const auto& [objPath, serviceMap] : response)
     {
-        dimmPaths.emplace_back(objPath);
+        auto implements = [&serviceMap](std::string_view interface) {
+            return std::any_of(serviceMap.begin(), serviceMap.end(),
+                               [interface](const auto& service) {
+                return std::find(service.second.begin(), service.second.end(),
+                                 interface) != service.second.end();
+            });
+        };
+        if (implements(slotInterface))
+        {
+            paths.slots.emplace_back(objPath);
+        }
+        if (implements(procInterface))
+        {
+            paths.procs.emplace_back(objPath);
+        }
+        if (implements(dimmInterface))
+        {
+            paths.dimms.emplace_back(objPath);
+        }
     }
-    return dimmPaths;
+    return paths;
 }
 
 void pldm::responder::oem_ibm_platform::Handler::sendStateSensorEvent(
@@ -697,10 +697,21 @@ int encodeEventMsg(uint8_t eventType, const std::vector<uint8_t>& eventDataVec,
 int setNumericEffecter(uint16_t entityInstance,
                        const pldm::utils::PropertyValue& value);
 
-/* @brief method to get the processor object paths*/
-std::vector<std::string> getProcObjectPaths();
-/* @brief method to get the dimm object paths */
-std::vector<std::string> getDimmObjectPaths();
+/** @struct OemInventoryPaths
+ *
+ *  Inventory objects the OEM PDRs are built for
+ */
+struct OemInventoryPaths
+{
+    std::vector<std::string> slots; //!< PCIe slot object paths
+    std::vector<std::string> procs; //!< processor object paths
+    std::vector<std::string> dimms; //!< dimm object paths
+};
+
+/* @brief method to get the slot, processor and dimm object paths with one
+ *        mapper query
+ */
+OemInventoryPaths getOemInventoryPaths();
 } // namespace oem_ibm_platform
 
 } // namespace responder
@@ -0,0 +1,365 @@
+#include "pcie_topology_model.hpp"
+
+#include <endian.h>
+
+#include <phosphor-logging/lg2.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+
+PHOSPHOR_LOG2_USING;
+
+namespace pldm
+{
+namespace responder
+{
+namespace pcie
+{
+
+namespace
+{
+
+// The files are read from memory maps, the entries are not aligned. The
+// entries end with the first byte of their location codes, which may be past
+// the end of the file.
+template <typename T>
+T readEntry(std::span<const uint8_t> data, size_t offset)
+{
+    T entry{};
+    std::memcpy(&entry, data.data() + offset,
+                std::min(sizeof(T), data.size() - offset));
+    return entry;
+}
+
+constexpr auto topologyHeaderSize = offsetof(topology_blob, pci_link_entry);
+constexpr auto linkHeaderSize = offsetof(pcie_link_entry,
+                                         pci_link_entry_loc_code);
+constexpr auto cableListHeaderSize = offsetof(cable_attributes_list,
+                                              pci_link_cable_attr);
+constexpr auto cableHeaderSize = offsetof(pcilinkcableattr_t,
+                                          cable_attr_loc_code);
+
+// Slot location code structure contains multiple slot location code
+// suffix structures.
+// Each slot location code suffix structure is as follows
+// {Slot location code suffix size(uint8_t),
+//  Slot location code suffix(variable size)}
+constexpr auto sizeOfSuffixSizeDataMember = 1;
+
+// Each slot location structure contains
+// {
+//   Number of slot location codes (1byte),
+//   Slot location code Common part size (1byte)
+//   Slot location common part (Var)
+// }
+constexpr auto slotLocationDataMemberSize = 2;
+
+/** @brief Check that a field lies in the file */
+bool inFile(std::span<const uint8_t> data, size_t offset, size_t size)
+{
+    return offset <= data.size() && size <= data.size() - offset;
+}
+
+} // namespace
+
+Text TopologyModel::addText(const uint8_t* data, size_t size)
+{
+    Text value{static_cast<uint32_t>(text.size()),
+               static_cast<uint32_t>(size)};
+    text.append(reinterpret_cast<const char*>(data), size);
+    return value;
+}
+
+bool TopologyModel::parseTopology(std::span<const uint8_t> data)
+{
+    clear();
+
+    if (data.size() < topologyHeaderSize)
+    {
+        error("Topology file is too short, SIZE={SIZE}", "SIZE", data.size());
+        return false;
+    }
+    auto count = be16toh(readEntry<uint16_t>(
+        data, offsetof(topology_blob, num_pcie_link_entries)));
+    links.reserve(count);
+
+    size_t offset = topologyHeaderSize;
+    for (uint16_t index = 0; index < count; ++index)
+    {
+        if (!inFile(data, offset, linkHeaderSize))
+        {
+            error("Topology file is truncated at link {INDEX}", "INDEX",
+                  index);
+            clear();
+            return false;
+        }
+        auto entry = readEntry<pcie_link_entry>(data, offset);
+        auto entryLength = be16toh(entry.entry_length);
+        if (!entryLength)
+        {
+            error("Topology link {INDEX} has no length", "INDEX", index);
+            clear();
+            return false;
+        }
+
+        bool valid = true;
+        auto field = [&](uint16_t fieldOffset, uint8_t size) {
+            auto start = offset + be16toh(fieldOffset);
+            if (!inFile(data, start, size))
+            {
+                valid = false;
+                return Text{};
+            }
+            return addText(data.data() + start, size);
+        };
+
+        Link link{};
+        link.id = be16toh(entry.link_id);
+        link.parentId = be16toh(entry.parent_link_id);
+        link.status = entry.link_status;
+        link.type = entry.link_type;
+        link.speed = entry.link_speed;
+        link.width = entry.link_width;
+        link.hostBridge = field(entry.PCIehostBridgeLocCodeOff,
+                                entry.PCIehostBridgeLocCodeSize);
+        link.localTop = field(entry.TopLocalPortLocCodeOff,
+                              entry.TopLocalPortLocCodeSize);
+        link.localBottom = field(entry.BottomLocalPortLocCodeOff,
+                                 entry.BottomLocalPortLocCodeSize);
+        link.remoteTop = field(entry.TopRemotePortLocCodeOff,
+                               entry.TopRemotePortLocCodeSize);
+        link.remoteBottom = field(entry.BottomRemotePortLocCodeOff,
+                                  entry.BottomRemotePortLocCodeSize);
+
+        // The slot location codes are a common part followed by the suffix
+        // of each slot, a slot without suffix takes the suffix of the slot
+        // before it
+        auto slotOffset = offset + be16toh(entry.slot_loc_codes_offset);
+        link.slotBegin = slots.size();
+        if (inFile(data, slotOffset, slotLocationDataMemberSize))
+        {
+            auto slotCount = data[slotOffset];
+            auto commonSize = data[slotOffset + 1];
+            auto common = slotOffset + slotLocationDataMemberSize;
+            auto suffix = common + commonSize;
+            valid = inFile(data, common, commonSize);
+            size_t lastSuffix = 0;
+            uint8_t lastSuffixSize = 0;
+            for (uint8_t slot = 0; valid && slot < slotCount; ++slot)
+            {
+                if (!inFile(data, suffix, sizeOfSuffixSizeDataMember) ||
+                    !inFile(data, suffix + sizeOfSuffixSizeDataMember,
+                            data[suffix]))
+                {
+                    valid = false;
+                    break;
+                }
+                if (data[suffix])
+                {
+                    lastSuffix = suffix + sizeOfSuffixSizeDataMember;
+                    lastSuffixSize = data[suffix];
+                }
+                auto slotCode = addText(data.data() + common, commonSize);
+                addText(data.data() + lastSuffix, lastSuffixSize);
+                slotCode.size += lastSuffixSize;
+                slots.push_back(slotCode);
+                suffix += sizeOfSuffixSizeDataMember + data[suffix];
+            }
+        }
+        else
+        {
+            valid = false;
+        }
+        link.slotCount = slots.size() - link.slotBegin;
+
+        if (!valid)
+        {
+            error("Topology link {INDEX} is malformed", "INDEX", index);
+            clear();
+            return false;
+        }
+
+        if (link.type != 0xFF)
+        {
+            knownTypes[link.id] = link.type;
+        }
+        links.push_back(link);
+        offset += entryLength;
+    }
+
+    // A link reported twice takes its last entry
+    std::stable_sort(links.begin(), links.end(),
+                     [](const Link& a, const Link& b) { return a.id < b.id; });
+    auto last = std::unique(links.rbegin(), links.rend(),
+                            [](const Link& a, const Link& b) {
+        return a.id == b.id;
+    });
+    links.erase(links.begin(), last.base());
+
+    byParent.reserve(links.size());
+    for (uint32_t index = 0; index < links.size(); ++index)
+    {
+        byParent.emplace_back(links[index].parentId, index);
+    }
+    std::sort(byParent.begin(), byParent.end());
+    return true;
+}
+
+bool TopologyModel::parseCables(std::span<const uint8_t> data)
+{
+    cables.clear();
+
+    if (data.size() < cableListHeaderSize)
+    {
+        error("Cable information file is too short, SIZE={SIZE}", "SIZE",
+              data.size());
+        return false;
+    }
+    auto count = be16toh(readEntry<uint16_t>(
+        data, offsetof(cable_attributes_list, no_of_cables)));
+    cables.reserve(count);
+
+    size_t offset = cableListHeaderSize;
+    for (uint16_t index = 0; index < count; ++index)
+    {
+        if (!inFile(data, offset, cableHeaderSize))
+        {
+            error("Cable information file is truncated at cable {INDEX}",
+                  "INDEX", index);
+            cables.clear();
+            return false;
+        }
+        auto entry = readEntry<pcilinkcableattr_t>(data, offset);
+        auto entryLength = be16toh(entry.entry_length);
+
+        bool valid = entryLength != 0;
+        auto field = [&](uint16_t fieldOffset, uint8_t size) {
+            auto start = offset + be16toh(fieldOffset);
+            if (!inFile(data, start, size))
+            {
+                valid = false;
+                return Text{};
+            }
+            return addText(data.data() + start, size);
+        };
+
+        Cable cable{};
+        cable.number = index;
+        cable.linkId = be16toh(entry.link_id);
+        cable.hostPort = field(entry.host_port_location_code_offset,
+                               entry.host_port_location_code_size);
+        cable.ioPort = field(entry.io_enclosure_port_location_code_offset,
+                             entry.io_enclosure_port_location_code_size);
+        cable.partNumber = field(entry.cable_part_number_offset,
+                                 entry.cable_part_number_size);
+        cable.length = entry.cable_length;
+        cable.type = entry.cable_type;
+        cable.status = entry.cable_status;
+        if (!valid)
+        {
+            error("Cable {INDEX} is malformed", "INDEX", index);
+            cables.clear();
+            return false;
+        }
+
+        cables.push_back(cable);
+        offset += entryLength;
+    }
+    return true;
+}
+
+const Link* TopologyModel::find(linkId_t id) const
+{
+    auto link = std::lower_bound(
+        links.begin(), links.end(), id,
+        [](const Link& link, linkId_t id) { return link.id < id; });
+    return link == links.end() || link->id != id ? nullptr : &*link;
+}
+
+std::vector<const Link*> TopologyModel::children(linkId_t id) const
+{
+    auto [begin, end] = std::equal_range(
+        byParent.begin(), byParent.end(), std::make_pair(id, uint32_t{}),
+        [](const auto& a, const auto& b) { return a.first < b.first; });
+
+    std::vector<const Link*> result;
+    result.reserve(end - begin);
+    for (auto child = begin; child != end; ++child)
+    {
+        result.push_back(&links[child->second]);
+    }
+    return result;
+}
+
+uint8_t TopologyModel::linkType(const Link& link) const
+{
+    if (link.type != 0xFF)
+    {
+        return link.type;
+    }
+    auto known = knownTypes.find(link.id);
+    return known == knownTypes.end() ? 0 : known->second;
+}
+
+void TopologyModel::clear()
+{
+    links.clear();
+    cables.clear();
+    slots.clear();
+    text.clear();
+    byParent.clear();
+}
+
+std::string PropertyState::key(const pldm::utils::DBusMapping& mapping)
+{
+    return mapping.objectPath + '\0' + mapping.interface + '\0' +
+           mapping.propertyName;
+}
+
+void PropertyState::set(PropertyUpdate&& update)
+{
+    auto [queued, first] = pendingIndex.try_emplace(key(update.mapping),
+                                                    pending.size());
+    if (first)
+    {
+        pending.push_back(std::move(update));
+    }
+    else
+    {
+        pending[queued->second] = std::move(update);
+    }
+}
+
+std::vector<PropertyUpdate>
+    PropertyState::take(const pldm::utils::ObjectValueTree& current)
+{
+    std::vector<PropertyUpdate> changed;
+    for (auto& update : pending)
+    {
+        const auto& mapping = update.mapping;
+        auto object =
+            current.find(sdbusplus::message::object_path(mapping.objectPath));
+        if (object != current.end())
+        {
+            auto interface = object->second.find(mapping.interface);
+            if (interface != object->second.end())
+            {
+                auto value = interface->second.find(mapping.propertyName);
+                if (value != interface->second.end() &&
+                    value->second == update.value)
+                {
+                    continue;
+                }
+            }
+        }
+        changed.push_back(std::move(update));
+    }
+    pending.clear();
+    pendingIndex.clear();
+    return changed;
+}
+
+} // namespace pcie
+} // namespace responder
+} // namespace pldm
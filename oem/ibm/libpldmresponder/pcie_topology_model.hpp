@@ -0,0 +1,314 @@
+#pragma once
+
+#include "common/utils.hpp"
+
+#include <stdint.h>
+
+#include <span>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace pldm
+{
+namespace responder
+{
+
+/* Layout of the topology and cable information files sent by the host, the
+ * multi-byte fields are big endian
+ */
+
+struct SlotLocCode_t
+{
+    uint8_t numSlotLocCodes;
+    uint8_t slotLocCodesCmnPrtSize;
+    uint8_t slotLocCodesCmnPrt[1];
+} __attribute__((packed));
+
+struct SlotLocCodeSuf_t
+{
+    uint8_t slotLocCodeSz;
+    uint8_t slotLocCodeSuf[1];
+} __attribute__((packed));
+
+struct pcie_link_entry
+{
+    uint16_t entry_length;
+    uint8_t version;
+    uint8_t reserved_1;
+    uint16_t link_id;
+    uint16_t parent_link_id;
+    uint32_t link_drc_index;
+    uint32_t hub_drc_index;
+    uint8_t link_status;
+    uint8_t link_type;
+    uint16_t reserved_2;
+    uint8_t link_speed;
+    uint8_t link_width;
+    uint8_t PCIehostBridgeLocCodeSize;
+    uint16_t PCIehostBridgeLocCodeOff;
+    uint8_t TopLocalPortLocCodeSize;
+    uint16_t TopLocalPortLocCodeOff;
+    uint8_t BottomLocalPortLocCodeSize;
+    uint16_t BottomLocalPortLocCodeOff;
+    uint8_t TopRemotePortLocCodeSize;
+    uint16_t TopRemotePortLocCodeOff;
+    uint8_t BottomRemotePortLocCodeSize;
+    uint16_t BottomRemotePortLocCodeOff;
+    uint16_t slot_loc_codes_offset;
+    uint8_t pci_link_entry_loc_code[1];
+} __attribute__((packed));
+
+struct topology_blob
+{
+    uint32_t total_data_size;
+    uint16_t num_pcie_link_entries;
+    uint16_t reserved;
+    pcie_link_entry pci_link_entry[1];
+} __attribute__((packed));
+
+struct pcilinkcableattr_t
+{
+    uint16_t entry_length;
+    uint8_t version;
+    uint8_t reserved_1;
+    uint16_t link_id;
+    uint16_t reserved_2;
+    uint32_t link_drc_index;
+    uint8_t cable_length;
+    uint8_t cable_type;
+    uint8_t cable_status;
+    uint8_t host_port_location_code_size;
+    uint8_t io_enclosure_port_location_code_size;
+    uint8_t cable_part_number_size;
+    uint16_t host_port_location_code_offset;
+    uint16_t io_enclosure_port_location_code_offset;
+    uint16_t cable_part_number_offset;
+    uint8_t cable_attr_loc_code[1];
+};
+
+struct cable_attributes_list
+{
+    uint32_t length_of_response;
+    uint16_t no_of_cables;
+    uint16_t reserved;
+    pcilinkcableattr_t pci_link_cable_attr[1];
+};
+
+using linkId_t = uint16_t;
+
+namespace pcie
+{
+
+/** @struct Text
+ *
+ *  Location code or part number, stored in the text of the topology model
+ */
+struct Text
+{
+    uint32_t offset = 0;
+    uint32_t size = 0;
+
+    bool empty() const
+    {
+        return !size;
+    }
+};
+
+/** @struct Link
+ *
+ *  PCIe link of the topology, the codes are the raw values sent by the host
+ */
+struct Link
+{
+    linkId_t id;
+    linkId_t parentId;
+    uint8_t status;
+    uint8_t type;
+    uint8_t speed;
+    uint8_t width;
+    Text hostBridge;
+    Text localTop;
+    Text localBottom;
+    Text remoteTop;
+    Text remoteBottom;
+    uint32_t slotBegin; //!< first IO slot location code of the link in slots
+    uint32_t slotCount; //!< number of IO slot location codes
+};
+
+/** @struct Cable
+ *
+ *  Cable of the cable information, the codes are the raw values sent by the
+ *  host
+ */
+struct Cable
+{
+    uint16_t number; //!< position of the cable in the cable information
+    linkId_t linkId;
+    Text hostPort;
+    Text ioPort;
+    Text partNumber;
+    uint8_t length;
+    uint8_t type;
+    uint8_t status;
+};
+
+/** @class TopologyModel
+ *
+ *  @brief Typed copy of the PCIe topology and cable information files. The
+ *         links are kept sorted by link ID in one vector, with an index of the
+ *         links by parent link, and the location codes of all the links and
+ *         cables are stored back to back in one string.
+ *
+ *         The type last reported for each link ID is kept across refreshes,
+ *         the host reports some links with an unknown type.
+ */
+class TopologyModel
+{
+  public:
+    TopologyModel() = default;
+    TopologyModel(const TopologyModel&) = delete;
+    TopologyModel(TopologyModel&&) = default;
+    TopologyModel& operator=(const TopologyModel&) = delete;
+    TopologyModel& operator=(TopologyModel&&) = default;
+    ~TopologyModel() = default;
+
+    /** @brief Parse the topology file, replaces the links of the model and
+     *         drops its cables, the cable information is parsed next
+     *
+     *  @param[in] data - content of the topology file
+     *
+     *  @return false if the file is malformed, the model has no link then
+     */
+    bool parseTopology(std::span<const uint8_t> data);
+
+    /** @brief Parse the cable information file, replaces the cables of the
+     *         model
+     *
+     *  @param[in] data - content of the cable information file
+     *
+     *  @return false if the file is malformed, the model has no cable then
+     */
+    bool parseCables(std::span<const uint8_t> data);
+
+    /** @brief Links, sorted by link ID */
+    const std::vector<Link>& getLinks() const
+    {
+        return links;
+    }
+
+    /** @brief Cables, in the order of the cable information */
+    const std::vector<Cable>& getCables() const
+    {
+        return cables;
+    }
+
+    /** @brief Find a link
+     *
+     *  @param[in] id - link ID
+     *
+     *  @return the link, nullptr if it is not found
+     */
+    const Link* find(linkId_t id) const;
+
+    /** @brief Links whose parent link is a link, sorted by link ID
+     *
+     *  @param[in] id - link ID of the parent link
+     */
+    std::vector<const Link*> children(linkId_t id) const;
+
+    /** @brief Type of a link, the type last reported for the link ID if the
+     *         host reports an unknown type. Links never reported with a type
+     *         are primary links.
+     */
+    uint8_t linkType(const Link& link) const;
+
+    /** @brief IO slot location codes of a link */
+    std::span<const Text> getSlots(const Link& link) const
+    {
+        return std::span<const Text>(slots).subspan(link.slotBegin,
+                                                    link.slotCount);
+    }
+
+    /** @brief Content of a location code or part number */
+    std::string_view str(const Text& value) const
+    {
+        return std::string_view(text).substr(value.offset, value.size);
+    }
+
+    /** @brief Remove the links and cables, the link types are kept */
+    void clear();
+
+  private:
+    /** @brief Append a string to the text of the model */
+    Text addText(const uint8_t* data, size_t size);
+
+    std::vector<Link> links;
+    std::vector<Cable> cables;
+    std::vector<Text> slots;
+    std::string text;
+
+    /** @brief parent link ID and position in links of each link, sorted */
+    std::vector<std::pair<linkId_t, uint32_t>> byParent;
+
+    /** @brief type last reported for each link ID */
+    std::unordered_map<linkId_t, uint8_t> knownTypes;
+};
+
+/** @struct PropertyUpdate
+ *
+ *  Value of a D-Bus property of an inventory object
+ */
+struct PropertyUpdate
+{
+    pldm::utils::DBusMapping mapping;
+    pldm::utils::PropertyValue value;
+};
+
+/** @class PropertyState
+ *
+ *  @brief Values of the D-Bus properties set by a topology refresh. The
+ *         refresh queues the values of all the properties it sets, and only
+ *         the values that differ from the current values of the properties
+ *         are taken to be sent. A property set more than once in a refresh
+ *         takes the last value.
+ */
+class PropertyState
+{
+  public:
+    /** @brief Queue the value of a property
+     *
+     *  @param[in] update - object, interface, property and value
+     */
+    void set(PropertyUpdate&& update);
+
+    /** @brief Take the queued values that differ from the current values
+     *
+     *  @param[in] current - objects with their current properties, a
+     *                       property that is not found there is sent
+     *
+     *  @return the updates to send, in the order they were first queued
+     */
+    std::vector<PropertyUpdate>
+        take(const pldm::utils::ObjectValueTree& current);
+
+    /** @brief Number of queued values */
+    size_t size() const
+    {
+        return pending.size();
+    }
+
+  private:
+    static std::string key(const pldm::utils::DBusMapping& mapping);
+
+    std::vector<PropertyUpdate> pending;
+
+    /** @brief positions of the queued values in pending, by property */
+    std::unordered_map<std::string, size_t> pendingIndex;
+};
+
+} // namespace pcie
+} // namespace responder
+} // namespace pldm
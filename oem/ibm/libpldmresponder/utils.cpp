@@ -18,6 +18,7 @@
 #include <fstream>
 #include <iostream>
 #include <mutex>
+#include <system_error>
 
 PHOSPHOR_LOG2_USING;
 
@@ -36,15 +37,15 @@ static constexpr auto curLicFilePath =
 static constexpr auto newLicFilePath = "/var/lib/pldm/license/new_license.bin";
 static constexpr auto newLicJsonFilePath =
     "/var/lib/pldm/license/new_license.json";
+static constexpr auto licStoreFilePath = "/var/lib/pldm/license/licenses.bin";
+static constexpr auto licJournalFilePath =
+    "/var/lib/pldm/license/licenses.journal";
 static constexpr auto licEntryPath = "/xyz/openbmc_project/license/entry";
-static constexpr uint8_t createLic = 1;
 static constexpr uint8_t clearLicStatus = 2;
 
 using InternalFailure =
     sdbusplus::xyz::openbmc_project::Common::Error::InternalFailure;
 
-using LicJsonObjMap = std::map<fs::path, nlohmann::json>;
-LicJsonObjMap licJsonMap;
 using PropertyValue =
     std::variant<bool, uint8_t, int16_t, uint16_t, int32_t, uint32_t, int64_t,
                  uint64_t, double, std::string, std::vector<uint8_t>,
@@ -212,203 +213,189 @@ Json convertBinFileToJson(const fs::path& path)
     return Json::from_bson(vJson);
 }
 
-void convertJsonToBinaryFile(const Json& jsonData, const fs::path& path)
-{
-    // Covert the json data to binary format and copy to vector
-    std::vector<uint8_t> vJson = {};
-    vJson = Json::to_bson(jsonData);
-
-    // Copy the vector to file
-    std::ofstream licout(path, std::ios::out | std::ios::binary);
-    size_t size = vJson.size();
-    licout.write(reinterpret_cast<char*>(&vJson[0]), size * sizeof(vJson[0]));
-}
-
-void clearLicenseStatus()
+/** @brief Move the licenses of the BSON license file of older releases to
+ *         the license store
+ */
+static void importBsonLicenses(license::LicenseStore& store)
 {
     if (!fs::exists(curLicFilePath))
     {
         return;
     }
 
-    auto data = convertBinFileToJson(curLicFilePath);
-
-    const Json empty{};
-    const std::vector<Json> emptyList{};
-
-    auto entries = data.value("Licenses", emptyList);
-    fs::path path{licEntryPath};
-
-    for (const auto& entry : entries)
-    {
-        auto licId = entry.value("Id", empty);
-        fs::path l_path = path / licId;
-        licJsonMap.emplace(l_path, entry);
-    }
-
-    createOrUpdateLicenseDbusPaths(clearLicStatus);
-}
-
-int createOrUpdateLicenseDbusPaths(const uint8_t& flag)
-{
-    const Json empty{};
-    std::string authTypeAsNoOfDev = "NumberOfDevice";
-    struct tm tm;
-    time_t licTimeSinceEpoch = 0;
-
-    sdbusplus::com::ibm::License::Entry::server::LicenseEntry::Type licType =
-        sdbusplus::com::ibm::License::Entry::server::LicenseEntry::Type::
-            Prototype;
-    sdbusplus::com::ibm::License::Entry::server::LicenseEntry::AuthorizationType
-        licAuthType = sdbusplus::com::ibm::License::Entry::server::
-            LicenseEntry::AuthorizationType::Device;
-    for (const auto& [key, licJson] : licJsonMap)
+    try
     {
-        auto licName = licJson.value("Name", empty);
-
-        auto type = licJson.value("Type", empty);
-        if (type == "Trial")
-        {
-            licType = sdbusplus::com::ibm::License::Entry::server::
-                LicenseEntry::Type::Trial;
-        }
-        else if (type == "Commercial")
-        {
-            licType = sdbusplus::com::ibm::License::Entry::server::
-                LicenseEntry::Type::Purchased;
-        }
-        else
+        auto data = convertBinFileToJson(curLicFilePath);
+        const std::vector<Json> emptyList{};
+        for (const auto& entry : data.value("Licenses", emptyList))
         {
-            licType = sdbusplus::com::ibm::License::Entry::server::
-                LicenseEntry::Type::Prototype;
-        }
-
-        auto authType = licJson.value("AuthType", empty);
-        if (authType == "NumberOfDevice")
-        {
-            licAuthType = sdbusplus::com::ibm::License::Entry::server::
-                LicenseEntry::AuthorizationType::Capacity;
-        }
-        else if (authType == "Unlimited")
-        {
-            licAuthType = sdbusplus::com::ibm::License::Entry::server::
-                LicenseEntry::AuthorizationType::Unlimited;
-        }
-        else
-        {
-            licAuthType = sdbusplus::com::ibm::License::Entry::server::
-                LicenseEntry::AuthorizationType::Device;
-        }
-
-        uint32_t licAuthDevNo = 0;
-        if (authType == authTypeAsNoOfDev)
-        {
-            licAuthDevNo = licJson.value("AuthDeviceNumber", 0);
+            auto license = license::License::fromJson(entry);
+            if (license)
+            {
+                store.upsert(*license);
+            }
         }
-
-        auto licSerialNo = licJson.value("SerialNum", "");
-
-        auto expTime = licJson.value("ExpirationTime", "");
-        if (!expTime.empty())
+        if (!store.compact())
         {
-            memset(&tm, 0, sizeof(tm));
-            strptime(expTime.c_str(), "%Y-%m-%dT%H:%M:%SZ", &tm);
-            licTimeSinceEpoch = mktime(&tm);
+            // The file is imported again on the next start
+            return;
         }
+    }
+    catch (const std::exception& e)
+    {
+        error("Failed to import the license file {FILE}, ERROR={ERR_EXCEP}",
+              "FILE", curLicFilePath, "ERR_EXCEP", e.what());
+        return;
+    }
+    std::error_code ec;
+    fs::remove(curLicFilePath, ec);
+    fs::remove(newLicFilePath, ec);
+}
 
-        CustomDBus::getCustomDBus().implementLicInterfaces(
-            key, licAuthDevNo, licName, licSerialNo, licTimeSinceEpoch, licType,
-            licAuthType);
-
-        auto status = licJson.value("Status", empty);
-
-        // License status is a single entry which needs to be mapped to
-        // OperationalStatus and Availability dbus interfaces
-        auto licOpStatus = false;
-        auto licAvailState = false;
-        if ((flag == clearLicStatus) || (status == "Unknown"))
-        {
-            licOpStatus = false;
-            licAvailState = false;
-        }
-        else if (status == "Enabled")
-        {
-            licOpStatus = true;
-            licAvailState = true;
-        }
-        else if (status == "Disabled")
-        {
-            licOpStatus = false;
-            licAvailState = true;
-        }
+license::LicenseStore& getLicenseStore()
+{
+    // Loaded in the initialization of the static, pldmd loads the store on
+    // a startup worker thread
+    static license::LicenseStore& store = []() -> license::LicenseStore& {
+        static license::LicenseStore licenses(licStoreFilePath,
+                                              licJournalFilePath);
+        licenses.load();
+        importBsonLicenses(licenses);
+        return licenses;
+    }();
+    return store;
+}
 
-        CustomDBus::getCustomDBus().setOperationalStatus(key, licOpStatus, "");
-        CustomDBus::getCustomDBus().setAvailabilityState(key, licAvailState);
+/** @brief Set the status of a license on its D-Bus object
+ *
+ *  @param[in] path - object path of the license
+ *  @param[in] status - license status, "Unknown" if it is cleared
+ */
+static void publishLicenseStatus(const std::string& path,
+                                 const std::string& status)
+{
+    // License status is a single entry which needs to be mapped to
+    // OperationalStatus and Availability dbus interfaces
+    auto licOpStatus = false;
+    auto licAvailState = false;
+    if (status == "Enabled")
+    {
+        licOpStatus = true;
+        licAvailState = true;
+    }
+    else if (status == "Disabled")
+    {
+        licOpStatus = false;
+        licAvailState = true;
     }
 
-    return PLDM_SUCCESS;
+    CustomDBus::getCustomDBus().setOperationalStatus(path, licOpStatus, "");
+    CustomDBus::getCustomDBus().setAvailabilityState(path, licAvailState);
 }
 
-int createOrUpdateLicenseObjs()
+/** @brief Create or update the D-Bus object of a license
+ *
+ *  @param[in] lic - license
+ *  @param[in] clearStatus - publish the license with an unknown status
+ */
+static void publishLicense(const license::License& lic, bool clearStatus)
 {
-    bool l_curFilePresent = true;
-    const Json empty{};
-    const std::vector<Json> emptyList{};
-    std::ifstream jsonFileCurrent;
-    Json dataCurrent;
-    Json entries;
+    using LicenseEntry = sdbusplus::com::ibm::License::Entry::server::
+        LicenseEntry;
 
-    if (!fs::exists(curLicFilePath))
+    auto licType = LicenseEntry::Type::Prototype;
+    if (lic.type == "Trial")
     {
-        l_curFilePresent = false;
+        licType = LicenseEntry::Type::Trial;
     }
-
-    if (l_curFilePresent == true)
+    else if (lic.type == "Commercial")
     {
-        dataCurrent = convertBinFileToJson(curLicFilePath);
+        licType = LicenseEntry::Type::Purchased;
     }
 
-    auto dataNew = convertBinFileToJson(newLicFilePath);
-
-    if (l_curFilePresent == true)
+    auto licAuthType = LicenseEntry::AuthorizationType::Device;
+    uint32_t licAuthDevNo = 0;
+    if (lic.authType == "NumberOfDevice")
     {
-        dataCurrent.merge_patch(dataNew);
-        convertJsonToBinaryFile(dataCurrent, curLicFilePath);
-        entries = dataCurrent.value("Licenses", emptyList);
+        licAuthType = LicenseEntry::AuthorizationType::Capacity;
+        licAuthDevNo = lic.authDeviceNumber;
     }
-    else
+    else if (lic.authType == "Unlimited")
     {
-        convertJsonToBinaryFile(dataNew, curLicFilePath);
-        entries = dataNew.value("Licenses", emptyList);
+        licAuthType = LicenseEntry::AuthorizationType::Unlimited;
     }
 
-    fs::path path{licEntryPath};
-
-    for (const auto& entry : entries)
+    time_t licTimeSinceEpoch = 0;
+    if (!lic.expirationTime.empty())
     {
-        auto licId = entry.value("Id", empty);
-        fs::path l_path = path / licId;
-        licJsonMap.insert_or_assign(l_path, entry);
+        struct tm tm;
+        memset(&tm, 0, sizeof(tm));
+        strptime(lic.expirationTime.c_str(), "%Y-%m-%dT%H:%M:%SZ", &tm);
+        licTimeSinceEpoch = mktime(&tm);
     }
 
-    int rc = createOrUpdateLicenseDbusPaths(createLic);
-    if (rc == PLDM_SUCCESS)
-    {
-        fs::copy_file(newLicFilePath, curLicFilePath,
-                      fs::copy_options::overwrite_existing);
+    auto path = (fs::path(licEntryPath) / lic.id).string();
+    CustomDBus::getCustomDBus().implementLicInterfaces(
+        path, licAuthDevNo, lic.name, lic.serialNumber, licTimeSinceEpoch,
+        licType, licAuthType);
+    publishLicenseStatus(path, clearStatus ? "Unknown" : lic.status);
+}
 
-        if (fs::exists(newLicFilePath))
-        {
-            fs::remove_all(newLicFilePath);
-        }
+void clearLicenseStatus()
+{
+    createOrUpdateLicenseDbusPaths(clearLicStatus);
+}
+
+int createOrUpdateLicenseDbusPaths(const uint8_t& flag)
+{
+    for (const auto& [id, lic] : getLicenseStore().getLicenses())
+    {
+        publishLicense(lic, flag == clearLicStatus);
+    }
+    return PLDM_SUCCESS;
+}
 
-        if (fs::exists(newLicJsonFilePath))
+int createOrUpdateLicenseObjs(const Json& licenseData)
+{
+    auto& store = getLicenseStore();
+    auto entries = licenseData.find("Licenses");
+    if (entries != licenseData.end() && entries->is_array())
+    {
+        // Only the licenses that changed are written to the store and
+        // published again, the others may only have their status restored
+        for (const auto& entry : *entries)
         {
-            fs::remove_all(newLicJsonFilePath);
+            auto lic = license::License::fromJson(entry);
+            if (!lic)
+            {
+                continue;
+            }
+            bool changed = false;
+            try
+            {
+                changed = store.upsert(*lic);
+            }
+            catch (const std::system_error& e)
+            {
+                error("Failed to store the license {ID}, ERROR={ERR_EXCEP}",
+                      "ID", lic->id, "ERR_EXCEP", e.what());
+                return PLDM_ERROR;
+            }
+            if (changed)
+            {
+                publishLicense(*lic, false);
+            }
+            else
+            {
+                publishLicenseStatus(
+                    (fs::path(licEntryPath) / lic->id).string(), lic->status);
+            }
         }
     }
 
-    return rc;
+    std::error_code ec;
+    fs::remove(newLicJsonFilePath, ec);
+    return PLDM_SUCCESS;
 }
 
 bool checkIfIBMCableCard(const std::string& objPath)
@@ -2,6 +2,7 @@
 
 #include "../../../libpldmresponder/oem_handler.hpp"
 #include "host-bmc/dbus_to_host_effecters.hpp"
+#include "license_store.hpp"
 #include "oem/ibm/requester/dbus_to_file_handler.hpp"
 
 #include <nlohmann/json.hpp>
@@ -76,16 +77,13 @@ void writeToUnixSocket(const int sock, const char* buf,
  */
 Json convertBinFileToJson(const fs::path& path);
 
-/** @brief Converts a json data in to a binary file
- *  This function converts the json data to a binary json(bson)
- *  format and copies it to specified destination file.
+/** @brief Get the license store
+ *  The store is loaded on the first call, the licenses of the BSON license
+ *  file of older releases are moved to the store then.
  *
- *  @param[in] jsonData - nlohmann json data
- *  @param[in] path     - destination path to store the bson data
- *
- *  @return   None
+ *  @return   reference to the license store
  */
-void convertJsonToBinaryFile(const Json& jsonData, const fs::path& path);
+license::LicenseStore& getLicenseStore();
 
 /** @brief Clear License Status
  *  This function clears all the license status to "Unknown" during
@@ -118,12 +116,15 @@ int createOrUpdateLicenseDbusPaths(const uint8_t& flag);
 
 /** @brief Create or update the license bjects
  *  This function creates or updates the license objects as per the data passed
- *  from host.
+ *  from host. The licenses are added to the license store, only the ones that
+ *  changed are written.
+ *
+ *  @param[in] licenseData - license JSON sent by the host
  *
  *  @return   on success returns PLDM_SUCCESS
  *            on failure returns -1
  */
-int createOrUpdateLicenseObjs();
+int createOrUpdateLicenseObjs(const Json& licenseData);
 
 /** @brief checks if a pcie adapter is IBM specific
  *         cable card
@@ -1,18 +1,25 @@
 #include "libpldm/base.h"
 #include "libpldm/file_io.h"
+#include "libpldm/utils.h"
 
 #include "libpldmresponder/file_io.hpp"
 #include "libpldmresponder/file_io_by_type.hpp"
+#include "libpldmresponder/file_io_session.hpp"
 #include "libpldmresponder/file_io_type_cert.hpp"
 #include "libpldmresponder/file_io_type_dump.hpp"
 #include "libpldmresponder/file_io_type_lid.hpp"
+#include "libpldmresponder/file_io_type_pcie.hpp"
 #include "libpldmresponder/file_io_type_pel.hpp"
 #include "libpldmresponder/file_io_type_smsmenu.hpp"
 #include "libpldmresponder/file_table.hpp"
 #include "xyz/openbmc_project/Common/error.hpp"
 
 #include <nlohmann/json.hpp>
+#include <sdeventplus/event.hpp>
 
+#include <chrono>
+#include <cstddef>
+#include <cstring>
 #include <filesystem>
 #include <fstream>
 
@@ -997,3 +1004,466 @@ TEST(readFileByType, testReadFile)
     ASSERT_EQ(response.size(), in.size());
     ASSERT_EQ(std::equal(in.begin(), in.end(), response.begin()), true);
 }
+
+TEST(FileReadSessions, reuseAndReopen)
+{
+    auto& sessions = FileReadSessions::get();
+    sessions.clear();
+
+    char tmplt[] = "/tmp/lid.XXXXXX";
+    auto fd = mkstemp(tmplt);
+    std::vector<uint8_t> in = {1, 2, 3, 4, 5, 6, 7, 8};
+    ASSERT_EQ(write(fd, in.data(), in.size()), (ssize_t)in.size());
+    close(fd);
+
+    LidHandler handler(0, true);
+    Response response;
+    uint32_t length = 4;
+    ASSERT_EQ(handler.readFile(tmplt, 0, length, response), PLDM_SUCCESS);
+    length = 8;
+    ASSERT_EQ(handler.readFile(tmplt, 4, length, response), PLDM_SUCCESS);
+    ASSERT_EQ(length, 4);
+    ASSERT_EQ(response, in);
+    ASSERT_EQ(sessions.size(), 1);
+
+    length = 1;
+    ASSERT_EQ(handler.readFile(tmplt, 8, length, response),
+              PLDM_DATA_OUT_OF_RANGE);
+
+    // A replaced file is reopened
+    std::vector<uint8_t> replaced = {9, 10};
+    std::ofstream file(tmplt, std::ios::binary | std::ios::trunc);
+    file.write(reinterpret_cast<const char*>(replaced.data()),
+               replaced.size());
+    file.close();
+    response.clear();
+    length = 8;
+    ASSERT_EQ(handler.readFile(tmplt, 0, length, response), PLDM_SUCCESS);
+    ASSERT_EQ(response, replaced);
+    ASSERT_EQ(sessions.size(), 1);
+
+    fs::remove(tmplt);
+    sessions.clear();
+}
+
+TEST(FileReadSessions, evictLeastRecentlyUsed)
+{
+    auto& sessions = FileReadSessions::get();
+    sessions.clear();
+
+    size_t opened = 0;
+    auto opener = [&opened]() {
+        opened++;
+        return ::open("/dev/null", O_RDONLY);
+    };
+    for (size_t i = 0; i <= FileReadSessions::maxSessions; ++i)
+    {
+        ASSERT_TRUE(sessions.open(std::to_string(i), opener));
+    }
+    ASSERT_EQ(sessions.size(), FileReadSessions::maxSessions);
+
+    // "0" was evicted, "1" is still open
+    ASSERT_TRUE(sessions.open(std::string("1"), opener));
+    ASSERT_EQ(opened, FileReadSessions::maxSessions + 1);
+    ASSERT_TRUE(sessions.open(std::string("0"), opener));
+    ASSERT_EQ(opened, FileReadSessions::maxSessions + 2);
+
+    sessions.release("0");
+    ASSERT_EQ(sessions.size(), FileReadSessions::maxSessions - 1);
+    sessions.clear();
+}
+
+TEST(PCIeTopologyModel, parseTopologyAndCables)
+{
+    using namespace pldm::responder::pcie;
+
+    auto put16 = [](std::vector<uint8_t>& data, size_t offset,
+                    uint16_t value) {
+        data[offset] = value >> 8;
+        data[offset + 1] = value & 0xFF;
+    };
+
+    // Link entry with a local port and IO slots sharing a common part, the
+    // second slot has no suffix and takes the suffix of the first one
+    auto linkEntry = [&](uint16_t id, uint16_t parentId, uint8_t type,
+                         const std::string& localPort,
+                         const std::vector<std::string>& suffixes) {
+        constexpr size_t header = offsetof(pcie_link_entry,
+                                           pci_link_entry_loc_code);
+        std::vector<uint8_t> entry(header);
+        put16(entry, offsetof(pcie_link_entry, link_id), id);
+        put16(entry, offsetof(pcie_link_entry, parent_link_id), parentId);
+        entry[offsetof(pcie_link_entry, link_status)] = 0x00;
+        entry[offsetof(pcie_link_entry, link_type)] = type;
+        entry[offsetof(pcie_link_entry, link_speed)] = 0x03;
+        entry[offsetof(pcie_link_entry, link_width)] = 0x10;
+        entry[offsetof(pcie_link_entry, TopLocalPortLocCodeSize)] =
+            localPort.size();
+        put16(entry, offsetof(pcie_link_entry, TopLocalPortLocCodeOff),
+              entry.size());
+        entry.insert(entry.end(), localPort.begin(), localPort.end());
+
+        put16(entry, offsetof(pcie_link_entry, slot_loc_codes_offset),
+              entry.size());
+        std::string common = "U78DA.ND0.1234567-P1-C";
+        entry.push_back(suffixes.size());
+        entry.push_back(common.size());
+        entry.insert(entry.end(), common.begin(), common.end());
+        for (const auto& suffix : suffixes)
+        {
+            entry.push_back(suffix.size());
+            entry.insert(entry.end(), suffix.begin(), suffix.end());
+        }
+        put16(entry, offsetof(pcie_link_entry, entry_length), entry.size());
+        return entry;
+    };
+
+    std::vector<uint8_t> blob(offsetof(topology_blob, pci_link_entry));
+    put16(blob, offsetof(topology_blob, num_pcie_link_entries), 4);
+    for (const auto& entry :
+         {linkEntry(0x20, 0x10, 0xFF, "", {"1", ""}),
+          linkEntry(0x10, 0x00, Secondary, "", {}),
+          linkEntry(0x30, 0x10, Primary, "U78DA.ND0.1234567-P1-C2-T1", {"2"}),
+          linkEntry(0x10, 0x00, Primary, "", {})})
+    {
+        blob.insert(blob.end(), entry.begin(), entry.end());
+    }
+
+    TopologyModel model;
+    ASSERT_TRUE(model.parseTopology(blob));
+
+    // Sorted by link ID, the link reported twice takes its last entry
+    const auto& links = model.getLinks();
+    ASSERT_EQ(links.size(), 3);
+    EXPECT_EQ(links[0].id, 0x10);
+    EXPECT_EQ(links[0].type, Primary);
+    EXPECT_EQ(links[1].id, 0x20);
+    EXPECT_EQ(links[2].id, 0x30);
+    EXPECT_EQ(links[2].speed, 0x03);
+    EXPECT_EQ(links[2].width, 0x10);
+    EXPECT_EQ(model.str(links[2].localTop), "U78DA.ND0.1234567-P1-C2-T1");
+    EXPECT_TRUE(links[0].localTop.empty());
+
+    auto slots = model.getSlots(links[1]);
+    ASSERT_EQ(slots.size(), 2);
+    EXPECT_EQ(model.str(slots[0]), "U78DA.ND0.1234567-P1-C1");
+    EXPECT_EQ(model.str(slots[1]), "U78DA.ND0.1234567-P1-C1");
+    EXPECT_TRUE(model.getSlots(links[0]).empty());
+
+    ASSERT_NE(model.find(0x30), nullptr);
+    EXPECT_EQ(model.find(0x30)->id, 0x30);
+    EXPECT_EQ(model.find(0x40), nullptr);
+
+    auto children = model.children(0x10);
+    ASSERT_EQ(children.size(), 2);
+    EXPECT_EQ(children[0]->id, 0x20);
+    EXPECT_EQ(children[1]->id, 0x30);
+    EXPECT_TRUE(model.children(0x30).empty());
+
+    // A link of unknown type takes the type last reported for it
+    EXPECT_EQ(model.linkType(links[1]), Primary);
+    std::vector<uint8_t> secondary(offsetof(topology_blob, pci_link_entry));
+    put16(secondary, offsetof(topology_blob, num_pcie_link_entries), 1);
+    auto entry = linkEntry(0x20, 0x10, Secondary, "", {});
+    secondary.insert(secondary.end(), entry.begin(), entry.end());
+    ASSERT_TRUE(model.parseTopology(secondary));
+    ASSERT_TRUE(model.parseTopology(blob));
+    EXPECT_EQ(model.linkType(*model.find(0x20)), Secondary);
+
+    // Cable information
+    std::string hostPort = "U78DA.ND0.1234567-P1-C2-T1";
+    std::string ioPort = "U78D4.ND1.7654321-P1-C1-T1";
+    std::string partNumber = "03JK567";
+    constexpr size_t cableHeader = offsetof(pcilinkcableattr_t,
+                                            cable_attr_loc_code);
+    std::vector<uint8_t> cable(cableHeader);
+    put16(cable, offsetof(pcilinkcableattr_t, link_id), 0x30);
+    cable[offsetof(pcilinkcableattr_t, cable_length)] = 0x02;
+    cable[offsetof(pcilinkcableattr_t, cable_type)] = 0x01;
+    cable[offsetof(pcilinkcableattr_t, cable_status)] = 0x01;
+    cable[offsetof(pcilinkcableattr_t, host_port_location_code_size)] =
+        hostPort.size();
+    put16(cable, offsetof(pcilinkcableattr_t, host_port_location_code_offset),
+          cable.size());
+    cable.insert(cable.end(), hostPort.begin(), hostPort.end());
+    cable[offsetof(pcilinkcableattr_t,
+                   io_enclosure_port_location_code_size)] = ioPort.size();
+    put16(cable,
+          offsetof(pcilinkcableattr_t, io_enclosure_port_location_code_offset),
+          cable.size());
+    cable.insert(cable.end(), ioPort.begin(), ioPort.end());
+    cable[offsetof(pcilinkcableattr_t, cable_part_number_size)] =
+        partNumber.size();
+    put16(cable, offsetof(pcilinkcableattr_t, cable_part_number_offset),
+          cable.size());
+    cable.insert(cable.end(), partNumber.begin(), partNumber.end());
+    put16(cable, offsetof(pcilinkcableattr_t, entry_length), cable.size());
+
+    std::vector<uint8_t> cableInfo(
+        offsetof(cable_attributes_list, pci_link_cable_attr));
+    put16(cableInfo, offsetof(cable_attributes_list, no_of_cables), 2);
+    cableInfo.insert(cableInfo.end(), cable.begin(), cable.end());
+    cableInfo.insert(cableInfo.end(), cable.begin(), cable.end());
+    ASSERT_TRUE(model.parseCables(cableInfo));
+    ASSERT_EQ(model.getCables().size(), 2);
+    const auto& parsed = model.getCables()[1];
+    EXPECT_EQ(parsed.number, 1);
+    EXPECT_EQ(parsed.linkId, 0x30);
+    EXPECT_EQ(model.str(parsed.hostPort), hostPort);
+    EXPECT_EQ(model.str(parsed.ioPort), ioPort);
+    EXPECT_EQ(model.str(parsed.partNumber), partNumber);
+    EXPECT_EQ(parsed.length, 0x02);
+    EXPECT_EQ(parsed.type, 0x01);
+    // the links are kept
+    EXPECT_EQ(model.str(model.find(0x30)->localTop), hostPort);
+
+    // A truncated file leaves an empty model
+    blob.resize(blob.size() - 3);
+    EXPECT_FALSE(model.parseTopology(blob));
+    EXPECT_TRUE(model.getLinks().empty());
+    EXPECT_TRUE(model.getCables().empty());
+    cableInfo.resize(cableInfo.size() - cable.size() - 1);
+    EXPECT_FALSE(model.parseCables(cableInfo));
+    EXPECT_TRUE(model.getCables().empty());
+}
+
+TEST(PCIeTopologyModel, changedProperties)
+{
+    using namespace pldm::responder::pcie;
+    using pldm::utils::DBusMapping;
+
+    DBusMapping busId{"/inventory/slot1", "Item.PCIeSlot", "BusId",
+                      "uint32_t"};
+    DBusMapping status{"/inventory/slot1", "Item.PCIeSlot", "LinkStatus",
+                       "string"};
+    DBusMapping lanes{"/inventory/adapter1", "Item.PCIeDevice", "LanesInUse",
+                      "int64_t"};
+
+    pldm::utils::ObjectValueTree current;
+    PropertyState state;
+    state.set({busId, uint32_t(0x10)});
+    state.set({status, std::string("Operational")});
+    // the last value queued in a refresh is set
+    state.set({busId, uint32_t(0x11)});
+    EXPECT_EQ(state.size(), 2);
+    auto updates = state.take(current);
+    ASSERT_EQ(updates.size(), 2);
+    EXPECT_EQ(updates[0].mapping.propertyName, "BusId");
+    EXPECT_EQ(std::get<uint32_t>(updates[0].value), 0x11);
+    EXPECT_EQ(updates[1].mapping.propertyName, "LinkStatus");
+    EXPECT_EQ(state.size(), 0);
+
+    // Only the properties that differ from their current value are set
+    current[sdbusplus::message::object_path("/inventory/slot1")]
+           ["Item.PCIeSlot"] = {{"BusId", uint32_t(0x11)},
+                                {"LinkStatus", std::string("Operational")}};
+    current[sdbusplus::message::object_path("/inventory/adapter1")]
+           ["Item.PCIeDevice"] = {{"LanesInUse", int64_t(8)}};
+    state.set({busId, uint32_t(0x11)});
+    state.set({status, std::string("Degraded")});
+    state.set({lanes, int64_t(16)});
+    updates = state.take(current);
+    ASSERT_EQ(updates.size(), 2);
+    EXPECT_EQ(updates[0].mapping.propertyName, "LinkStatus");
+    EXPECT_EQ(updates[1].mapping.propertyName, "LanesInUse");
+
+    state.set({busId, uint32_t(0x11)});
+    EXPECT_TRUE(state.take(current).empty());
+
+    // A property changed by another application, or that could not be set,
+    // is set again
+    current[sdbusplus::message::object_path("/inventory/slot1")]
+           ["Item.PCIeSlot"]["BusId"] = uint32_t(0x12);
+    state.set({busId, uint32_t(0x11)});
+    state.set({lanes, int64_t(8)});
+    updates = state.take(current);
+    ASSERT_EQ(updates.size(), 1);
+    EXPECT_EQ(updates[0].mapping.propertyName, "BusId");
+}
+
+class LargeFileTable : public testing::Test
+{
+  public:
+    void SetUp() override
+    {
+        char tmppldm[] = "/tmp/pldm_fileio_large_table.XXXXXX";
+        dir = fs::path(mkdtemp(tmppldm));
+
+        auto jsonObjects = Json::array();
+        for (size_t index = 0; index < fileCount; ++index)
+        {
+            auto path = dir / ("file-" + std::to_string(index));
+            std::ofstream(path) << std::string(index, 'x');
+            auto obj = Json::object();
+            obj["path"] = path.c_str();
+            obj["file_traits"] = index % 4;
+            jsonObjects.push_back(obj);
+        }
+
+        fileTableConfig = dir / "configFile.json";
+        std::ofstream file(fileTableConfig.c_str());
+        file << jsonObjects << std::endl;
+    }
+
+    void TearDown() override
+    {
+        fs::remove_all(dir);
+    }
+
+    /** @brief Fetch the table in parts, checking the transfer flags */
+    static Table fetch(const FileTable& table, size_t partSize)
+    {
+        Table data;
+        auto part = table.getPart(PLDM_GET_FIRSTPART, 0, partSize);
+        EXPECT_TRUE(part);
+        while (part)
+        {
+            data.insert(data.end(), part->data.begin(), part->data.end());
+            if (!part->nextHandle)
+            {
+                EXPECT_TRUE(part->transferFlag == PLDM_END ||
+                            part->transferFlag == PLDM_START_AND_END);
+                break;
+            }
+            EXPECT_EQ(part->transferFlag,
+                      data.size() == part->data.size() ? PLDM_START
+                                                       : PLDM_MIDDLE);
+            EXPECT_EQ(part->data.size(), partSize);
+            part = table.getPart(PLDM_GET_NEXTPART, part->nextHandle,
+                                 partSize);
+            EXPECT_TRUE(part);
+        }
+        return data;
+    }
+
+    /** @brief File size of the entry of a file handle, from the table */
+    static uint32_t fileSize(const Table& data, Handle handle)
+    {
+        size_t offset = 0;
+        while (offset + sizeof(Handle) + sizeof(uint16_t) <= data.size())
+        {
+            Handle entryHandle{};
+            uint16_t nameLength{};
+            std::memcpy(&entryHandle, data.data() + offset, sizeof(Handle));
+            std::memcpy(&nameLength, data.data() + offset + sizeof(Handle),
+                        sizeof(nameLength));
+            offset += sizeof(Handle) + sizeof(nameLength) + nameLength;
+            uint32_t size{};
+            std::memcpy(&size, data.data() + offset, sizeof(size));
+            if (entryHandle == handle)
+            {
+                return size;
+            }
+            offset += sizeof(size) + sizeof(uint32_t);
+        }
+        ADD_FAILURE() << "No entry for handle " << handle;
+        return 0;
+    }
+
+    static constexpr size_t fileCount = 500;
+    fs::path dir;
+    fs::path fileTableConfig;
+};
+
+TEST_F(LargeFileTable, MultipartTransfer)
+{
+    FileTable table(fileTableConfig.c_str());
+    auto image = table();
+    ASSERT_GT(image.size(), 10000);
+    EXPECT_EQ(image.size() % 4, 0);
+
+    // The table ends with the checksum of the entries and pad bytes
+    uint32_t checkSum{};
+    std::memcpy(&checkSum, image.data() + image.size() - sizeof(checkSum),
+                sizeof(checkSum));
+    EXPECT_EQ(checkSum, crc32(image.data(), image.size() - sizeof(checkSum)));
+
+    for (size_t partSize : {16, 100, 1024, 65536})
+    {
+        EXPECT_EQ(fetch(table, partSize), image);
+    }
+    EXPECT_EQ(fileSize(image, 0), 0);
+    EXPECT_EQ(fileSize(image, 123), 123);
+    EXPECT_EQ(fileSize(image, fileCount - 1), fileCount - 1);
+
+    // The parts are slices of the table kept by FileTable
+    auto part = table.getPart(PLDM_GET_FIRSTPART, 0, 64);
+    ASSERT_TRUE(part);
+    EXPECT_EQ(part->data.data(),
+              table.getPart(PLDM_GET_FIRSTPART, 0, 64)->data.data());
+
+    // A transfer handle of 0 is the first part, whatever the operation flag
+    for (uint8_t operationFlag : {PLDM_GET_NEXTPART, 2})
+    {
+        auto first = table.getPart(operationFlag, 0, 64);
+        ASSERT_TRUE(first);
+        EXPECT_EQ(first->data.data(), part->data.data());
+        EXPECT_EQ(first->nextHandle, part->nextHandle);
+    }
+
+    // Bad transfer handles and operation flags
+    EXPECT_FALSE(table.getPart(PLDM_GET_NEXTPART,
+                               part->nextHandle + image.size(), 64));
+    EXPECT_FALSE(table.getPart(2, part->nextHandle, 64));
+    EXPECT_FALSE(table.getPart(PLDM_GET_FIRSTPART, 0, 0));
+}
+
+TEST_F(LargeFileTable, RefreshEntry)
+{
+    FileTable table(fileTableConfig.c_str());
+    auto version = table.getVersion();
+    auto part = table.getPart(PLDM_GET_FIRSTPART, 0, 256);
+    ASSERT_TRUE(part);
+
+    // Unchanged file
+    EXPECT_FALSE(table.refresh(42));
+    EXPECT_EQ(table.getVersion(), version);
+    EXPECT_FALSE(table.refresh(fileCount));
+
+    std::ofstream(dir / "file-42", std::ios::app) << std::string(1000, 'y');
+    EXPECT_TRUE(table.refresh(42));
+    EXPECT_EQ(table.getVersion(), version + 1);
+    auto image = table();
+    EXPECT_EQ(fileSize(image, 42), 1042);
+    EXPECT_EQ(fileSize(image, 43), 43);
+    uint32_t checkSum{};
+    std::memcpy(&checkSum, image.data() + image.size() - sizeof(checkSum),
+                sizeof(checkSum));
+    EXPECT_EQ(checkSum, crc32(image.data(), image.size() - sizeof(checkSum)));
+
+    // The parts of the previous version are refused, the host starts over
+    EXPECT_FALSE(table.getPart(PLDM_GET_NEXTPART, part->nextHandle, 256));
+    EXPECT_EQ(fetch(table, 256), image);
+
+    // A removed file has a size of 0
+    fs::remove(dir / "file-42");
+    EXPECT_TRUE(table.refresh(42));
+    EXPECT_EQ(fileSize(table(), 42), 0);
+    EXPECT_EQ(table.getVersion(), version + 2);
+}
+
+TEST_F(LargeFileTable, WatchFiles)
+{
+    FileTable table(fileTableConfig.c_str());
+    auto event = sdeventplus::Event::get_default();
+    FileTableWatch watch(event, table);
+    auto version = table.getVersion();
+
+    // Written in place
+    std::ofstream(dir / "file-7", std::ios::app) << std::string(93, 'y');
+    // Replaced by a rename
+    std::ofstream(dir / "file-300.tmp") << "short";
+    fs::rename(dir / "file-300.tmp", dir / "file-300");
+    // Rewritten with the same size
+    std::ofstream(dir / "file-8") << std::string(8, 'z');
+    // Not in the table
+    std::ofstream(dir / "other") << "other";
+
+    event.run(std::chrono::microseconds(0));
+    auto image = table();
+    EXPECT_EQ(fileSize(image, 7), 100);
+    EXPECT_EQ(fileSize(image, 300), 5);
+    EXPECT_EQ(fileSize(image, 8), 8);
+    EXPECT_EQ(table.getVersion(), version + 2);
+    EXPECT_EQ(fetch(table, 512), image);
+}
@@ -0,0 +1,239 @@
+#include "libpldmresponder/license_store.hpp"
+
+#include <nlohmann/json.hpp>
+
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <system_error>
+
+#include <gtest/gtest.h>
+
+namespace fs = std::filesystem;
+using namespace pldm::responder::license;
+
+class TestLicenseStore : public testing::Test
+{
+  public:
+    void SetUp() override
+    {
+        char tmppldm[] = "/tmp/pldm_license_store.XXXXXX";
+        dir = fs::path(mkdtemp(tmppldm));
+        snapshot = dir / "licenses.bin";
+        journal = dir / "licenses.journal";
+    }
+
+    void TearDown() override
+    {
+        fs::remove_all(dir);
+    }
+
+    static License makeLicense(size_t index)
+    {
+        License license;
+        license.id = "LIC-" + std::to_string(index);
+        license.name = "License " + std::to_string(index);
+        license.serialNumber = "SN" + std::to_string(index * 7);
+        license.type = index % 2 ? "Trial" : "Commercial";
+        license.authType = index % 3 ? "NumberOfDevice" : "Unlimited";
+        license.authDeviceNumber = index % 10;
+        license.expirationTime = index % 5 ? "2030-01-01T00:00:00Z" : "";
+        license.status = index % 4 ? "Enabled" : "Disabled";
+        return license;
+    }
+
+    static std::string readAll(const fs::path& path)
+    {
+        std::ifstream file(path, std::ios::in | std::ios::binary);
+        return std::string(std::istreambuf_iterator<char>(file), {});
+    }
+
+    fs::path dir;
+    fs::path snapshot;
+    fs::path journal;
+};
+
+TEST_F(TestLicenseStore, UpsertAndReload)
+{
+    constexpr size_t count = 300;
+    {
+        LicenseStore store(snapshot, journal, 1000);
+        EXPECT_TRUE(store.load());
+        EXPECT_TRUE(store.getLicenses().empty());
+        for (size_t index = 0; index < count; ++index)
+        {
+            EXPECT_TRUE(store.upsert(makeLicense(index)));
+        }
+        EXPECT_EQ(store.journalRecords(), count);
+
+        // Unchanged licenses are not written
+        EXPECT_FALSE(store.upsert(makeLicense(42)));
+        EXPECT_EQ(store.journalRecords(), count);
+
+        auto license = makeLicense(42);
+        license.status = "Unknown";
+        EXPECT_TRUE(store.upsert(license));
+        EXPECT_TRUE(store.erase("LIC-43"));
+        EXPECT_FALSE(store.erase("LIC-43"));
+        EXPECT_EQ(store.journalRecords(), count + 2);
+    }
+
+    LicenseStore store(snapshot, journal, 1000);
+    EXPECT_TRUE(store.load());
+    EXPECT_EQ(store.getLicenses().size(), count - 1);
+    ASSERT_NE(store.find("LIC-42"), nullptr);
+    EXPECT_EQ(store.find("LIC-42")->status, "Unknown");
+    EXPECT_EQ(store.find("LIC-43"), nullptr);
+    ASSERT_NE(store.find("LIC-299"), nullptr);
+    EXPECT_EQ(*store.find("LIC-299"), makeLicense(299));
+
+    // LIC-3, LIC-13... LIC-293, without LIC-43
+    auto byNumber = store.findByAuthDeviceNumber(3);
+    EXPECT_EQ(byNumber.size(), count / 10 - 1);
+    for (const auto* license : byNumber)
+    {
+        EXPECT_EQ(license->authDeviceNumber, 3);
+        EXPECT_NE(license->id, "LIC-43");
+    }
+    EXPECT_TRUE(store.findByAuthDeviceNumber(10).empty());
+}
+
+TEST_F(TestLicenseStore, Compaction)
+{
+    {
+        LicenseStore store(snapshot, journal, 4);
+        store.load();
+        for (size_t index = 0; index < 10; ++index)
+        {
+            store.upsert(makeLicense(index));
+            EXPECT_LE(store.journalRecords(), 4);
+        }
+        store.erase("LIC-0");
+    }
+    EXPECT_TRUE(fs::exists(snapshot));
+
+    LicenseStore store(snapshot, journal, 4);
+    EXPECT_TRUE(store.load());
+    EXPECT_EQ(store.getLicenses().size(), 9);
+    EXPECT_EQ(store.find("LIC-0"), nullptr);
+    EXPECT_EQ(*store.find("LIC-9"), makeLicense(9));
+
+    store.compact();
+    EXPECT_EQ(store.journalRecords(), 0);
+    EXPECT_FALSE(fs::exists(journal));
+    EXPECT_TRUE(store.load());
+    EXPECT_EQ(store.getLicenses().size(), 9);
+}
+
+TEST_F(TestLicenseStore, TornJournal)
+{
+    {
+        LicenseStore store(snapshot, journal);
+        store.load();
+        for (size_t index = 0; index < 3; ++index)
+        {
+            store.upsert(makeLicense(index));
+        }
+    }
+
+    // Power loss in the middle of the last record
+    fs::resize_file(journal, fs::file_size(journal) - 3);
+    {
+        LicenseStore store(snapshot, journal);
+        EXPECT_TRUE(store.load());
+        EXPECT_EQ(store.getLicenses().size(), 2);
+        EXPECT_EQ(store.find("LIC-2"), nullptr);
+
+        // The records written after the torn one are kept
+        EXPECT_TRUE(store.upsert(makeLicense(7)));
+    }
+
+    LicenseStore store(snapshot, journal);
+    EXPECT_TRUE(store.load());
+    EXPECT_EQ(store.getLicenses().size(), 3);
+    EXPECT_NE(store.find("LIC-7"), nullptr);
+}
+
+TEST_F(TestLicenseStore, CorruptedSnapshot)
+{
+    {
+        LicenseStore store(snapshot, journal);
+        store.load();
+        store.upsert(makeLicense(1));
+        store.compact();
+    }
+    {
+        std::fstream file(snapshot,
+                          std::ios::in | std::ios::out | std::ios::binary);
+        file.seekp(-1, std::ios::end);
+        file.put('?');
+    }
+
+    auto corrupted = readAll(snapshot);
+
+    LicenseStore store(snapshot, journal);
+    EXPECT_FALSE(store.load());
+    EXPECT_TRUE(store.getLicenses().empty());
+
+    // The corrupted snapshot is kept aside, not overwritten
+    auto corruptedPath = snapshot;
+    corruptedPath += ".corrupted";
+    EXPECT_EQ(readAll(corruptedPath), corrupted);
+    EXPECT_NE(readAll(snapshot), corrupted);
+}
+
+TEST_F(TestLicenseStore, WriteFailure)
+{
+    LicenseStore store(snapshot, journal);
+    store.load();
+    EXPECT_TRUE(store.upsert(makeLicense(1)));
+    EXPECT_TRUE(store.compact());
+
+    // A journal that cannot be written fails the update
+    fs::create_directory(journal);
+    EXPECT_THROW(store.upsert(makeLicense(2)), std::system_error);
+    EXPECT_THROW(store.erase("LIC-1"), std::system_error);
+    EXPECT_EQ(store.find("LIC-2"), nullptr);
+    EXPECT_NE(store.find("LIC-1"), nullptr);
+    fs::remove(journal);
+
+    // A snapshot that cannot be written keeps the previous one and the
+    // journal
+    EXPECT_TRUE(store.upsert(makeLicense(3)));
+    auto tempPath = snapshot;
+    tempPath += ".tmp";
+    fs::create_directory(tempPath);
+    EXPECT_FALSE(store.compact());
+    EXPECT_EQ(store.journalRecords(), 1);
+    fs::remove(tempPath);
+
+    LicenseStore reloaded(snapshot, journal);
+    EXPECT_TRUE(reloaded.load());
+    EXPECT_EQ(reloaded.getLicenses().size(), 2);
+    EXPECT_NE(reloaded.find("LIC-3"), nullptr);
+}
+
+TEST(License, FromJson)
+{
+    auto entry = nlohmann::json::parse(R"({
+        "Id": "LIC-1",
+        "Name": "Capacity",
+        "SerialNum": "1234",
+        "Type": "Trial",
+        "AuthType": "NumberOfDevice",
+        "AuthDeviceNumber": 16,
+        "ExpirationTime": "2030-01-01T00:00:00Z",
+        "Status": "Enabled"
+    })");
+    auto license = License::fromJson(entry);
+    ASSERT_TRUE(license);
+    EXPECT_EQ(license->id, "LIC-1");
+    EXPECT_EQ(license->serialNumber, "1234");
+    EXPECT_EQ(license->authDeviceNumber, 16);
+    EXPECT_EQ(license->status, "Enabled");
+
+    EXPECT_FALSE(License::fromJson(nlohmann::json::parse(R"({"Name": "x"})")));
+    EXPECT_FALSE(
+        License::fromJson(nlohmann::json::parse(R"({"Id": "x", "Name": 1})")));
+}
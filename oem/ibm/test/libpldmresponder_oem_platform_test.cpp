@@ -10,10 +10,13 @@
 #include "oem/ibm/libpldmresponder/inband_code_update.hpp"
 #include "oem/ibm/libpldmresponder/oem_ibm_handler.hpp"
 
+#include <arpa/inet.h>
 #include <libpldm/entity_oem_ibm.h>
 
 #include <sdeventplus/event.hpp>
 
+#include <cstring>
+#include <fstream>
 #include <iostream>
 
 using namespace pldm::dbus_api;
@@ -200,6 +203,217 @@ TEST(clearDirPath, testClearDirPath)
     ASSERT_EQ(stat(dirPath, &buffer), 0);
 }
 
+TEST(LidSink, streamLidBody)
+{
+    fs::path dir("/tmp/testLidSink");
+    fs::remove_all(dir);
+    fs::create_directories(dir / "staging");
+    auto lidDir = dir / "lid";
+    auto tarImage = dir / "image" / "image.tar";
+
+    // CRC-32 check value
+    const std::string body = "123456789";
+    EXPECT_EQ(lidCrc32(0, reinterpret_cast<const uint8_t*>(body.data()), 4),
+              lidCrc32(0, reinterpret_cast<const uint8_t*>("1234"), 4));
+    auto crc = lidCrc32(0, reinterpret_cast<const uint8_t*>(body.data()),
+                        body.size());
+    EXPECT_EQ(crc, 0xCBF43926);
+
+    auto makeLid = [&body](uint32_t lidNumber, uint16_t lidClass,
+                           uint32_t lidCrc) {
+        LidHeader header{};
+        header.magicNumber = htons(0x0222);
+        header.lidNumber = htonl(lidNumber);
+        header.lidClass = htons(lidClass);
+        header.lidCrc = htonl(lidCrc);
+        header.lidSize = htonl(body.size());
+        header.headerSize = htonl(sizeof(header) + 4);
+        std::vector<uint8_t> lid(sizeof(header) + 4);
+        std::memcpy(lid.data(), &header, sizeof(header));
+        lid.insert(lid.end(), body.begin(), body.end());
+        return lid;
+    };
+    auto readFile = [](const fs::path& path) {
+        std::ifstream file(path, std::ios::binary);
+        return std::string(std::istreambuf_iterator<char>(file), {});
+    };
+
+    // The header is split across chunks, and the body comes out of order
+    auto lid = makeLid(0x81e00640, 0x1000, crc);
+    auto bodyStart = lid.size() - body.size();
+    LidSink sink(dir / "staging" / "1.lid", lidDir, tarImage);
+    ASSERT_EQ(sink.write(0, lid.data(), 10), PLDM_SUCCESS);
+    ASSERT_EQ(sink.write(10, lid.data() + 10, bodyStart - 6), PLDM_SUCCESS);
+    ASSERT_EQ(sink.write(lid.size() - 3, lid.data() + lid.size() - 3, 3),
+              PLDM_SUCCESS);
+    EXPECT_FALSE(sink.complete());
+    ASSERT_EQ(sink.write(bodyStart + 4, lid.data() + bodyStart + 4, 2),
+              PLDM_SUCCESS);
+    EXPECT_TRUE(sink.complete());
+    EXPECT_FALSE(sink.staging());
+    EXPECT_EQ(sink.finish(), PLDM_SUCCESS);
+    EXPECT_EQ(readFile(lidDir / "81e00640.lid"), body);
+    EXPECT_FALSE(fs::exists(dir / "staging" / "1.lid"));
+
+    // BMC LIDs are appended to the tar image
+    for (int count = 0; count < 2; ++count)
+    {
+        auto bmcLid = makeLid(0x81e00700 + count, 0x2000, crc);
+        LidSink bmcSink(dir / "staging" / "2.lid", lidDir, tarImage);
+        ASSERT_EQ(bmcSink.write(0, bmcLid.data(), bmcLid.size()),
+                  PLDM_SUCCESS);
+        ASSERT_TRUE(bmcSink.complete());
+        EXPECT_EQ(bmcSink.finish(), PLDM_SUCCESS);
+    }
+    EXPECT_EQ(readFile(tarImage), body + body);
+
+    // A LID whose header does not come first is staged
+    LidSink stagedSink(dir / "staging" / "3.lid", lidDir, tarImage);
+    ASSERT_EQ(stagedSink.write(4, lid.data() + 4, lid.size() - 4),
+              PLDM_SUCCESS);
+    ASSERT_EQ(stagedSink.write(0, lid.data(), 4), PLDM_SUCCESS);
+    EXPECT_TRUE(stagedSink.staging());
+    EXPECT_FALSE(stagedSink.complete());
+    auto staged = readFile(dir / "staging" / "3.lid");
+    EXPECT_EQ(staged, std::string(lid.begin(), lid.end()));
+
+#ifdef LID_CRC_CHECK
+    auto badLid = makeLid(0x81e00641, 0x1000, crc + 1);
+    LidSink badSink(dir / "staging" / "4.lid", lidDir, tarImage);
+    ASSERT_EQ(badSink.write(0, badLid.data(), badLid.size()), PLDM_SUCCESS);
+    EXPECT_EQ(badSink.finish(), PLDM_ERROR);
+    EXPECT_FALSE(fs::exists(lidDir / "81e00641.lid"));
+#endif
+
+    fs::remove_all(dir);
+}
+
+TEST(LidSink, lidHeaderLayout)
+{
+    fs::path dir("/tmp/testLidHeader");
+    fs::remove_all(dir);
+    fs::create_directories(dir / "staging");
+    auto lidDir = dir / "lid";
+    auto tarImage = dir / "image" / "image.tar";
+    auto readFile = [](const fs::path& path) {
+        std::ifstream file(path, std::ios::binary);
+        return std::string(std::istreambuf_iterator<char>(file), {});
+    };
+
+    // LID 81e00650 of class 0x1000, written out byte by byte in the big
+    // endian layout of its header: magic number, header version, LID
+    // number, date, time, class, CRC-32 of the body, body size and header
+    // size, the header is followed by a section table
+    const std::string body = "123456789";
+    std::vector<uint8_t> lid{0x02, 0x22, 0x00, 0x01, 0x81, 0xe0, 0x06, 0x50,
+                             0x20, 0x26, 0x10, 0x19, 0x12, 0x00, 0x10, 0x00,
+                             0xcb, 0xf4, 0x39, 0x26, 0x00, 0x00, 0x00, 0x09,
+                             0x00, 0x00, 0x00, 0x20, 0x00, 0x00, 0x00, 0x00};
+    ASSERT_EQ(sizeof(LidHeader) + 4, lid.size());
+    lid.insert(lid.end(), body.begin(), body.end());
+
+    LidSink sink(dir / "staging" / "1.lid", lidDir, tarImage);
+    ASSERT_EQ(sink.write(0, lid.data(), lid.size()), PLDM_SUCCESS);
+    ASSERT_TRUE(sink.complete());
+    EXPECT_EQ(sink.finish(), PLDM_SUCCESS);
+    EXPECT_EQ(readFile(lidDir / "81e00650.lid"), body);
+    fs::remove(lidDir / "81e00650.lid");
+
+    // A body that does not match the CRC of the header is only rejected
+    // with the CRC check
+    lid.back() ^= 0xff;
+    LidSink badSink(dir / "staging" / "2.lid", lidDir, tarImage);
+    ASSERT_EQ(badSink.write(0, lid.data(), lid.size()), PLDM_SUCCESS);
+    ASSERT_TRUE(badSink.complete());
+#ifdef LID_CRC_CHECK
+    EXPECT_EQ(badSink.finish(), PLDM_ERROR);
+    EXPECT_FALSE(fs::exists(lidDir / "81e00650.lid"));
+#else
+    EXPECT_EQ(badSink.finish(), PLDM_SUCCESS);
+    EXPECT_EQ(readFile(lidDir / "81e00650.lid"),
+              std::string(lid.end() - body.size(), lid.end()));
+    fs::remove(lidDir / "81e00650.lid");
+#endif
+
+    // A LID without a CRC in its header is taken as it is
+    std::fill(lid.begin() + 16, lid.begin() + 20, 0);
+    LidSink uncheckedSink(dir / "staging" / "3.lid", lidDir, tarImage);
+    ASSERT_EQ(uncheckedSink.write(0, lid.data(), lid.size()), PLDM_SUCCESS);
+    ASSERT_TRUE(uncheckedSink.complete());
+    EXPECT_EQ(uncheckedSink.finish(), PLDM_SUCCESS);
+    EXPECT_TRUE(fs::exists(lidDir / "81e00650.lid"));
+
+    fs::remove_all(dir);
+}
+
+TEST(LidSink, abortDiscardsBody)
+{
+    fs::path dir("/tmp/testLidSinkAbort");
+    fs::remove_all(dir);
+    fs::create_directories(dir / "staging");
+    auto lidDir = dir / "lid";
+    auto tarImage = dir / "image" / "image.tar";
+
+    const std::string body(64, 'b');
+    auto makeLid = [&body](uint32_t lidNumber, uint16_t lidClass) {
+        LidHeader header{};
+        header.magicNumber = htons(0x0222);
+        header.lidNumber = htonl(lidNumber);
+        header.lidClass = htons(lidClass);
+        header.lidSize = htonl(body.size());
+        header.headerSize = htonl(sizeof(header));
+        std::vector<uint8_t> lid(sizeof(header));
+        std::memcpy(lid.data(), &header, sizeof(header));
+        lid.insert(lid.end(), body.begin(), body.end());
+        return lid;
+    };
+
+    // A finished BMC LID is kept
+    auto first = makeLid(0x81e00700, 0x2000);
+    LidSink firstSink(dir / "staging" / "1.lid", lidDir, tarImage);
+    ASSERT_EQ(firstSink.write(0, first.data(), first.size()), PLDM_SUCCESS);
+    ASSERT_EQ(firstSink.finish(), PLDM_SUCCESS);
+    firstSink.abort();
+    EXPECT_EQ(fs::file_size(tarImage), body.size());
+    EXPECT_EQ(firstSink.write(0, first.data(), first.size()), PLDM_ERROR);
+
+    // The region reserved for an aborted BMC LID is cut from the image
+    auto second = makeLid(0x81e00701, 0x2000);
+    LidSink secondSink(dir / "staging" / "2.lid", lidDir, tarImage);
+    ASSERT_EQ(secondSink.write(0, second.data(), sizeof(LidHeader) + 8),
+              PLDM_SUCCESS);
+    EXPECT_EQ(fs::file_size(tarImage), 2 * body.size());
+    secondSink.abort();
+    EXPECT_EQ(fs::file_size(tarImage), body.size());
+    EXPECT_FALSE(tarImageBroken(tarImage));
+
+    // Unless another LID is reserved after it, the image is broken then
+    LidSink thirdSink(dir / "staging" / "3.lid", lidDir, tarImage);
+    LidSink fourthSink(dir / "staging" / "4.lid", lidDir, tarImage);
+    ASSERT_EQ(thirdSink.write(0, second.data(), sizeof(LidHeader)),
+              PLDM_SUCCESS);
+    ASSERT_EQ(fourthSink.write(0, second.data(), sizeof(LidHeader)),
+              PLDM_SUCCESS);
+    thirdSink.abort();
+    EXPECT_EQ(fs::file_size(tarImage), 3 * body.size());
+    EXPECT_TRUE(tarImageBroken(tarImage));
+    fourthSink.abort();
+    EXPECT_EQ(fs::file_size(tarImage), 2 * body.size());
+    clearLidSinks();
+    EXPECT_FALSE(tarImageBroken(tarImage));
+
+    // The file of an aborted LID is removed
+    auto lid = makeLid(0x81e00642, 0x1000);
+    LidSink lidSink(dir / "staging" / "5.lid", lidDir, tarImage);
+    ASSERT_EQ(lidSink.write(0, lid.data(), sizeof(LidHeader) + 8),
+              PLDM_SUCCESS);
+    EXPECT_TRUE(fs::exists(lidDir / "81e00642.lid"));
+    lidSink.abort();
+    EXPECT_FALSE(fs::exists(lidDir / "81e00642.lid"));
+
+    fs::remove_all(dir);
+}
+
 TEST(generateStateEffecterOEMPDR, testGoodRequest)
 {
     auto inPDRRepo = pldm_pdr_init();
@@ -0,0 +1,316 @@
+#include "async_responder.hpp"
+
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+#include <phosphor-logging/lg2.hpp>
+
+#include <algorithm>
+#include <cerrno>
+#include <system_error>
+
+PHOSPHOR_LOG2_USING;
+
+namespace pldm
+{
+
+namespace responder
+{
+
+namespace
+{
+
+/** @brief Offset of the PLDM message in a request, after the EID and the MCTP
+ *         message type
+ */
+constexpr size_t pldmMsgOffset = 2;
+
+const pldm_msg* requestMsg(const AsyncResponder::Message& request)
+{
+    return reinterpret_cast<const pldm_msg*>(request.data() + pldmMsgOffset);
+}
+
+} // namespace
+
+AsyncResponder::AsyncResponder(sdeventplus::Event& event, size_t workerCount,
+                               std::chrono::milliseconds deadline, Send send,
+                               Dispatch dispatch) :
+    deadline(deadline),
+    send(std::move(send)), dispatch(std::move(dispatch)),
+    completionFd(eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC)),
+    deadlineTimer(event.get(), [this] { expire(); })
+{
+    if (completionFd == -1)
+    {
+        throw std::system_error(errno, std::generic_category(),
+                                "Failed to create the completion eventfd");
+    }
+    completionIO = std::make_unique<sdeventplus::source::IO>(
+        event, completionFd, EPOLLIN,
+        [this](sdeventplus::source::IO& /*io*/, int /*fd*/,
+               uint32_t /*revents*/) { processCompletions(); });
+
+    for (size_t count = 0; count < workerCount; ++count)
+    {
+        workers.emplace_back(&AsyncResponder::work, this);
+    }
+}
+
+AsyncResponder::~AsyncResponder()
+{
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        stopping = true;
+    }
+    jobReady.notify_all();
+    for (auto& worker : workers)
+    {
+        worker.join();
+    }
+    completionIO.reset();
+    close(completionFd);
+}
+
+void AsyncResponder::defer(const Message& request)
+{
+    waiting[request[0]].push_back(request);
+}
+
+Completer AsyncResponder::begin(const Message& request)
+{
+    auto id = nextId++;
+    auto headerEnd = request.begin() +
+                     std::min(request.size(),
+                              pldmMsgOffset + sizeof(pldm_msg_hdr));
+    commands.emplace(id, PendingCommand{Message(request.begin(), headerEnd),
+                                        Clock::now() + deadline});
+    active[request[0]] = id;
+    if (!deadlineTimer.isRunning())
+    {
+        scheduleExpiry();
+    }
+
+    return Completer(
+        [this, id](Response&& response) { complete(id, std::move(response)); },
+        [this, id](Completer::Work&& work) { post(id, std::move(work)); });
+}
+
+void AsyncResponder::complete(uint64_t id, Response&& response)
+{
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        running.erase(id);
+        completions.emplace_back(id, std::move(response));
+    }
+    uint64_t one = 1;
+    if (write(completionFd, &one, sizeof(one)) == -1 && errno != EAGAIN)
+    {
+        error("Failed to signal the completion of command {ID}, ERROR={ERR}",
+              "ID", id, "ERR", errno);
+    }
+}
+
+void AsyncResponder::post(uint64_t id, Completer::Work&& work)
+{
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        if (stopping)
+        {
+            return;
+        }
+        jobs.emplace_back(id, std::move(work));
+    }
+    jobReady.notify_one();
+}
+
+void AsyncResponder::work()
+{
+    while (true)
+    {
+        std::pair<uint64_t, Completer::Work> job;
+        {
+            std::unique_lock<std::mutex> guard(lock);
+            jobReady.wait(guard, [this] { return stopping || !jobs.empty(); });
+            if (stopping)
+            {
+                return;
+            }
+            job = std::move(jobs.front());
+            jobs.pop_front();
+            running.insert(job.first);
+        }
+
+        Response response;
+        try
+        {
+            response = job.second();
+        }
+        catch (const std::exception& e)
+        {
+            error("Asynchronous command {ID} failed, ERROR={ERR_EXCEP}", "ID",
+                  job.first, "ERR_EXCEP", e.what());
+        }
+        complete(job.first, std::move(response));
+    }
+}
+
+void AsyncResponder::processCompletions()
+{
+    uint64_t count = 0;
+    if (read(completionFd, &count, sizeof(count)) == -1 && errno != EAGAIN)
+    {
+        error("Failed to read the completion eventfd, ERROR={ERR}", "ERR",
+              errno);
+    }
+
+    std::deque<std::pair<uint64_t, Response>> done;
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        done.swap(completions);
+    }
+    for (auto& [id, response] : done)
+    {
+        finish(id, std::move(response));
+    }
+}
+
+void AsyncResponder::finish(uint64_t id, Response&& response)
+{
+    auto search = commands.find(id);
+    if (search == commands.end())
+    {
+        info(
+            "Dropping the response of command {ID}, it was already answered or missed its deadline",
+            "ID", id);
+        return;
+    }
+    auto request = std::move(search->second.request);
+    commands.erase(search);
+
+    auto hdr = requestMsg(request);
+    if (response.size() < sizeof(pldm_msg_hdr))
+    {
+        response = CmdHandler::ccOnlyResponse(hdr, PLDM_ERROR);
+    }
+    else
+    {
+        auto responseHdr = reinterpret_cast<pldm_msg_hdr*>(response.data());
+        if (responseHdr->instance_id != hdr->hdr.instance_id)
+        {
+            error(
+                "Response of command {CMD} has instance id {RESP_ID} instead of {REQ_ID}",
+                "CMD", hdr->hdr.command, "RESP_ID",
+                unsigned(responseHdr->instance_id), "REQ_ID",
+                unsigned(hdr->hdr.instance_id));
+            responseHdr->instance_id = hdr->hdr.instance_id;
+        }
+    }
+
+    send(request, response);
+    active.erase(request[0]);
+    drain(request[0]);
+}
+
+void AsyncResponder::expire()
+{
+    auto now = Clock::now();
+    for (auto search = commands.begin(); search != commands.end();)
+    {
+        auto id = search->first;
+        auto& command = search->second;
+        if (command.waited || command.deadline > now)
+        {
+            ++search;
+            continue;
+        }
+
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            if (running.contains(id))
+            {
+                // The transfer is under way, answering now would let the
+                // endpoint retry it while the worker still changes the data
+                command.waited = true;
+            }
+            else
+            {
+                std::erase_if(jobs,
+                              [id](const auto& job) { return job.first == id; });
+            }
+        }
+        if (command.waited)
+        {
+            auto hdr = requestMsg(command.request);
+            error(
+                "Command {TYPE}:{CMD} of EID {EID} missed its deadline, waiting for its work to complete",
+                "TYPE", unsigned(hdr->hdr.type), "CMD",
+                unsigned(hdr->hdr.command), "EID",
+                unsigned(command.request[0]));
+            ++search;
+            continue;
+        }
+
+        auto request = std::move(command.request);
+        search = commands.erase(search);
+        auto hdr = requestMsg(request);
+        error(
+            "Command {TYPE}:{CMD} of EID {EID} missed its deadline, responding ERROR_NOT_READY",
+            "TYPE", unsigned(hdr->hdr.type), "CMD", unsigned(hdr->hdr.command),
+            "EID", unsigned(request[0]));
+        send(request, CmdHandler::ccOnlyResponse(hdr, PLDM_ERROR_NOT_READY));
+        active.erase(request[0]);
+        drain(request[0]);
+    }
+    scheduleExpiry();
+}
+
+void AsyncResponder::scheduleExpiry()
+{
+    auto earliest = Clock::time_point::max();
+    for (const auto& [id, command] : commands)
+    {
+        if (!command.waited)
+        {
+            earliest = std::min(earliest, command.deadline);
+        }
+    }
+    if (earliest == Clock::time_point::max())
+    {
+        return;
+    }
+    auto wait = std::chrono::duration_cast<std::chrono::microseconds>(
+        earliest - Clock::now());
+    deadlineTimer.start(std::max(wait, std::chrono::microseconds::zero()));
+}
+
+void AsyncResponder::drain(uint8_t eid)
+{
+    auto search = waiting.find(eid);
+    if (search == waiting.end())
+    {
+        return;
+    }
+    auto queue = std::move(search->second);
+    waiting.erase(search);
+
+    while (!queue.empty())
+    {
+        auto request = std::move(queue.front());
+        queue.pop_front();
+        dispatch(request);
+        if (active.contains(eid))
+        {
+            // The request started another asynchronous command, the rest
+            // waits for it
+            if (!queue.empty())
+            {
+                waiting.emplace(eid, std::move(queue));
+            }
+            return;
+        }
+    }
+}
+
+} // namespace responder
+
+} // namespace pldm
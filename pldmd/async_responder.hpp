@@ -0,0 +1,190 @@
+#pragma once
+
+#include "libpldm/base.h"
+
+#include "handler.hpp"
+
+#include <sdbusplus/timer.hpp>
+#include <sdeventplus/event.hpp>
+#include <sdeventplus/source/io.hpp>
+
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <vector>
+
+namespace pldm
+{
+
+namespace responder
+{
+
+/** @class AsyncResponder
+ *
+ *  @brief Tracks the commands whose handler completes the response later,
+ *         from the worker pool or from an asynchronous D-Bus call, so that
+ *         the event loop keeps serving the other endpoints and the responses
+ *         to the requests of pldmd in the meantime.
+ *
+ *         The requests of an endpoint are still answered in the order they
+ *         were received: while a command of the endpoint is pending, its
+ *         further requests are queued and dispatched once the response is
+ *         sent. A command not completed within the deadline is answered with
+ *         PLDM_ERROR_NOT_READY, so the endpoint retries it, and its work
+ *         still queued for the worker pool is dropped. Work already running
+ *         on a worker cannot be stopped, it may be changing host memory or a
+ *         file, so its command is not answered before the work completes.
+ */
+class AsyncResponder
+{
+  public:
+    using Clock = std::chrono::steady_clock;
+
+    /** @brief request prefixed with the EID and the MCTP message type */
+    using Message = std::vector<uint8_t>;
+
+    /** @brief sends the response of a request */
+    using Send =
+        std::function<void(const Message& request, const Response& response)>;
+
+    /** @brief dispatches a request that waited for a pending command */
+    using Dispatch = std::function<void(const Message& request)>;
+
+    AsyncResponder() = delete;
+    AsyncResponder(const AsyncResponder&) = delete;
+    AsyncResponder(AsyncResponder&&) = delete;
+    AsyncResponder& operator=(const AsyncResponder&) = delete;
+    AsyncResponder& operator=(AsyncResponder&&) = delete;
+
+    /** @brief Constructor
+     *
+     *  @param[in] event - reference of main event loop of pldmd
+     *  @param[in] workerCount - number of worker threads
+     *  @param[in] deadline - time a command has to complete its response
+     *  @param[in] send - sends a response
+     *  @param[in] dispatch - dispatches a queued request
+     */
+    explicit AsyncResponder(sdeventplus::Event& event, size_t workerCount,
+                            std::chrono::milliseconds deadline, Send send,
+                            Dispatch dispatch);
+
+    /** @brief Stops the worker pool, the work in progress is waited for and
+     *         its response dropped
+     */
+    ~AsyncResponder();
+
+    /** @brief Check if the requests of an endpoint have to wait
+     *
+     *  @param[in] eid - MCTP endpoint ID
+     *  @return true if a command of the endpoint is pending or requests of
+     *          the endpoint are already waiting
+     */
+    bool busy(uint8_t eid) const
+    {
+        return active.contains(eid) || waiting.contains(eid);
+    }
+
+    /** @brief Queue a request until the pending command of its endpoint
+     *         completes
+     *
+     *  @param[in] request - request prefixed with EID and MCTP type
+     */
+    void defer(const Message& request);
+
+    /** @brief Start an asynchronous command
+     *
+     *  @param[in] request - request prefixed with EID and MCTP type
+     *  @return the completer to hand to the handler
+     */
+    Completer begin(const Message& request);
+
+    /** @brief Number of pending commands */
+    size_t pending() const
+    {
+        return commands.size();
+    }
+
+  private:
+    /** @struct PendingCommand
+     *
+     *  A command waiting for its response
+     */
+    struct PendingCommand
+    {
+        Message request; //!< EID, MCTP type and PLDM header of the request
+        Clock::time_point deadline;
+        bool waited = false; //!< past its deadline, its work is running
+    };
+
+    /** @brief Queue the response of a command, called from any thread */
+    void complete(uint64_t id, Response&& response);
+
+    /** @brief Queue work on the worker pool, called from any thread */
+    void post(uint64_t id, Completer::Work&& work);
+
+    /** @brief Worker thread */
+    void work();
+
+    /** @brief Send the queued responses, runs on the event loop */
+    void processCompletions();
+
+    /** @brief Send the response of a command and dispatch the requests that
+     *         waited for it
+     */
+    void finish(uint64_t id, Response&& response);
+
+    /** @brief Answer the commands past their deadline */
+    void expire();
+
+    /** @brief Arm the timer for the earliest deadline of the commands not
+     *         waited for
+     */
+    void scheduleExpiry();
+
+    /** @brief Dispatch the requests waiting for an endpoint */
+    void drain(uint8_t eid);
+
+    std::chrono::milliseconds deadline;
+    Send send;
+    Dispatch dispatch;
+
+    /** @brief pending commands, the id increases with the start time */
+    std::map<uint64_t, PendingCommand> commands;
+
+    /** @brief pending command of each endpoint */
+    std::map<uint8_t, uint64_t> active;
+
+    /** @brief requests waiting for the pending command of their endpoint */
+    std::map<uint8_t, std::deque<Message>> waiting;
+
+    uint64_t nextId = 0;
+
+    /** @brief guards completions, jobs and stopping */
+    std::mutex lock;
+    std::condition_variable jobReady;
+    std::deque<std::pair<uint64_t, Response>> completions;
+    std::deque<std::pair<uint64_t, Completer::Work>> jobs;
+
+    /** @brief commands whose work runs on a worker */
+    std::set<uint64_t> running;
+    bool stopping = false;
+
+    /** @brief wakes the event loop up when a response is queued */
+    int completionFd = -1;
+    std::unique_ptr<sdeventplus::source::IO> completionIO;
+
+    /** @brief answers the commands past their deadline */
+    phosphor::Timer deadlineTimer;
+
+    std::vector<std::thread> workers;
+};
+
+} // namespace responder
+
+} // namespace pldm
@@ -6,8 +6,14 @@
 #include "common/utils.hpp"
 #include "xyz/openbmc_project/Common/error.hpp"
 
+#include <phosphor-logging/lg2.hpp>
+
+#include <cstring>
+#include <functional>
 #include <iostream>
 
+PHOSPHOR_LOG2_USING;
+
 using namespace sdbusplus::xyz::openbmc_project::Common::Error;
 
 namespace pldm
@@ -15,31 +21,144 @@ namespace pldm
 namespace dbus_api
 {
 
+namespace
+{
+std::vector<std::vector<uint8_t>>
+    copyPdrs(const std::vector<std::span<const uint8_t>>& pdrs)
+{
+    std::vector<std::vector<uint8_t>> copies;
+    copies.reserve(pdrs.size());
+    for (const auto& pdr : pdrs)
+    {
+        copies.emplace_back(pdr.begin(), pdr.end());
+    }
+    return copies;
+}
+} // namespace
+
 std::vector<std::vector<uint8_t>> Pdr::findStateEffecterPDR(uint8_t tid,
                                                             uint16_t entityID,
                                                             uint16_t stateSetId)
 {
-    auto pdrs = pldm::utils::findStateEffecterPDR(tid, entityID, stateSetId,
-                                                  pdrRepo);
-
+    const auto& pdrs = lookupStateEffecterPDR(tid, entityID, stateSetId);
     if (pdrs.empty())
     {
         throw ResourceNotFound();
     }
 
-    return pdrs;
+    return copyPdrs(pdrs);
 }
 
 std::vector<std::vector<uint8_t>>
     Pdr::findStateSensorPDR(uint8_t tid, uint16_t entityID, uint16_t stateSetId)
 {
-    auto pdrs = pldm::utils::findStateSensorPDR(tid, entityID, stateSetId,
-                                                pdrRepo);
+    const auto& pdrs = lookupStateSensorPDR(tid, entityID, stateSetId);
     if (pdrs.empty())
     {
         throw ResourceNotFound();
     }
-    return pdrs;
+    return copyPdrs(pdrs);
 }
+
+const std::vector<std::span<const uint8_t>>&
+    Pdr::lookupStateEffecterPDR(uint8_t /*tid*/, uint16_t entityID,
+                                uint16_t stateSetId)
+{
+    return index.lookup(PLDM_STATE_EFFECTER_PDR, entityID, stateSetId);
+}
+
+const std::vector<std::span<const uint8_t>>&
+    Pdr::lookupStateSensorPDR(uint8_t /*tid*/, uint16_t entityID,
+                              uint16_t stateSetId)
+{
+    return index.lookup(PLDM_STATE_SENSOR_PDR, entityID, stateSetId);
+}
+
+void Pdr::changed()
+{
+    // A PDR exchange changes the repo once per record, the changes are
+    // signalled together
+    if (!changeSignal)
+    {
+        changeSignal = std::make_unique<sdeventplus::source::Defer>(
+            event, std::bind_front(&Pdr::signalChange, this));
+    }
+}
+
+void Pdr::signalChange(sdeventplus::source::EventBase& /*source*/)
+{
+    changeSignal.reset();
+    batchIntf.property_changed("ChangeNumber");
+}
+
+int Pdr::findPDRsCallback(sd_bus_message* msg, void* context,
+                          sd_bus_error* error)
+{
+    auto pdr = static_cast<Pdr*>(context);
+    try
+    {
+        sdbusplus::message_t m{msg};
+        std::vector<PdrQuery> queries;
+        m.read(queries);
+        bool effecters = std::strcmp(m.get_member(),
+                                     "FindStateEffecterPDRs") == 0;
+
+        // The PDRs are copied from the repo straight into the reply
+        auto reply = m.new_method_return();
+        auto r = sd_bus_message_open_container(reply.get(), 'a', "aay");
+        for (const auto& [tid, entityID, stateSetId] : queries)
+        {
+            if (r < 0)
+            {
+                break;
+            }
+            const auto& pdrs =
+                effecters ? pdr->lookupStateEffecterPDR(tid, entityID,
+                                                        stateSetId)
+                          : pdr->lookupStateSensorPDR(tid, entityID,
+                                                      stateSetId);
+            r = sd_bus_message_open_container(reply.get(), 'a', "ay");
+            for (const auto& data : pdrs)
+            {
+                if (r < 0)
+                {
+                    break;
+                }
+                r = sd_bus_message_append_array(reply.get(), 'y', data.data(),
+                                                data.size());
+            }
+            if (r >= 0)
+            {
+                r = sd_bus_message_close_container(reply.get());
+            }
+        }
+        if (r >= 0)
+        {
+            r = sd_bus_message_close_container(reply.get());
+        }
+        if (r < 0)
+        {
+            error("Failed to build the PDR query reply, RC={RC}", "RC", r);
+            return r;
+        }
+        reply.method_return();
+    }
+    catch (const sdbusplus::exception_t& e)
+    {
+        return sd_bus_error_set(error, e.name(), e.description());
+    }
+
+    return 1;
+}
+
+int Pdr::changeNumberCallback(sd_bus* /*bus*/, const char* /*path*/,
+                              const char* /*interface*/,
+                              const char* /*property*/, sd_bus_message* reply,
+                              void* context, sd_bus_error* /*error*/)
+{
+    auto pdr = static_cast<Pdr*>(context);
+    return sd_bus_message_append(reply, "t", pdr->getChangeNumber());
+}
+
 } // namespace dbus_api
 } // namespace pldm
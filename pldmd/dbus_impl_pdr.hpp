@@ -3,11 +3,19 @@
 #include "libpldm/pdr.h"
 #include "libpldm/platform.h"
 
+#include "common/state_pdr_index.hpp"
 #include "xyz/openbmc_project/PLDM/PDR/server.hpp"
 
 #include <sdbusplus/bus.hpp>
+#include <sdbusplus/server/interface.hpp>
 #include <sdbusplus/server/object.hpp>
+#include <sdbusplus/vtable.hpp>
+#include <sdeventplus/event.hpp>
+#include <sdeventplus/source/event.hpp>
 
+#include <memory>
+#include <span>
+#include <tuple>
 #include <vector>
 
 namespace pldm
@@ -18,6 +26,12 @@ namespace dbus_api
 using PdrIntf = sdbusplus::server::object_t<
     sdbusplus::xyz::openbmc_project::PLDM::server::PDR>;
 
+/** @brief D-Bus interface with the batched PDR queries */
+constexpr auto pdrBatchIntf = "xyz.openbmc_project.PLDM.PDR.Batch";
+
+/** @brief PLDM terminus ID, entity type and state set id of a query */
+using PdrQuery = std::tuple<uint8_t, uint16_t, uint16_t>;
+
 /** @class Pdr
  *  @brief OpenBMC PLDM.PDR Implementation
  *  @details A concrete implementation for the
@@ -37,9 +51,13 @@ class Pdr : public PdrIntf
      *  @param[in] bus - Bus to attach to.
      *  @param[in] path - Path to attach at.
      *  @param[in] repo - pointer to BMC's primary PDR repo
+     *  @param[in] event - event loop on which ChangeNumber is signalled
      */
-    Pdr(sdbusplus::bus_t& bus, const std::string& path, const pldm_pdr* repo) :
-        PdrIntf(bus, path.c_str()), pdrRepo(repo){};
+    Pdr(sdbusplus::bus_t& bus, const std::string& path, const pldm_pdr* repo,
+        sdeventplus::Event& event) :
+        PdrIntf(bus, path.c_str()),
+        batchIntf(bus, path.c_str(), pdrBatchIntf, batchVtable, this),
+        event(event), index(repo, [this]() { changed(); }){};
 
     /** @brief Implementation for PdrIntf.FindStateEffecterPDR
      *  @param[in] tid - PLDM terminus ID.
@@ -59,9 +77,81 @@ class Pdr : public PdrIntf
         findStateSensorPDR(uint8_t tid, uint16_t entityID,
                            uint16_t stateSetId) override;
 
+    /** @brief Lookup the state effecter PDRs of an entity type and state set
+     *  @param[in] tid - PLDM terminus ID.
+     *  @param[in] entityID - entity that can be associated with PLDM State set.
+     *  @param[in] stateSetId - value that identifies PLDM State set.
+     *  @return the PDRs, they point into the repo and are valid until the
+     *          repo changes
+     */
+    const std::vector<std::span<const uint8_t>>&
+        lookupStateEffecterPDR(uint8_t tid, uint16_t entityID,
+                               uint16_t stateSetId);
+
+    /** @brief Lookup the state sensor PDRs of an entity type and state set
+     *  @param[in] tid - PLDM terminus ID.
+     *  @param[in] entityID - entity that can be associated with PLDM State set.
+     *  @param[in] stateSetId - value that identifies PLDM State set.
+     *  @return the PDRs, they point into the repo and are valid until the
+     *          repo changes
+     */
+    const std::vector<std::span<const uint8_t>>&
+        lookupStateSensorPDR(uint8_t tid, uint16_t entityID,
+                             uint16_t stateSetId);
+
+    /** @brief Number of times the PDR repo changed, a client can keep its
+     *         query results while this number stays the same
+     */
+    uint64_t getChangeNumber() const
+    {
+        return index.changeNumber();
+    }
+
   private:
-    /** @brief pointer to BMC's primary PDR repo */
-    const pldm_pdr* pdrRepo;
+    /** @brief Signal the new ChangeNumber once the changes of the current
+     *         event loop iteration are done
+     */
+    void changed();
+
+    /** @brief Emit PropertiesChanged for ChangeNumber */
+    void signalChange(sdeventplus::source::EventBase& source);
+
+    /** @brief D-Bus method handler of PDR.Batch.FindStateEffecterPDRs and
+     *         PDR.Batch.FindStateSensorPDRs
+     */
+    static int findPDRsCallback(sd_bus_message* msg, void* context,
+                                sd_bus_error* error);
+
+    /** @brief D-Bus property getter of PDR.Batch.ChangeNumber */
+    static int changeNumberCallback(sd_bus* bus, const char* path,
+                                    const char* interface,
+                                    const char* property,
+                                    sd_bus_message* reply, void* context,
+                                    sd_bus_error* error);
+
+    static constexpr sdbusplus::vtable_t batchVtable[] = {
+        sdbusplus::vtable::start(),
+        sdbusplus::vtable::method("FindStateEffecterPDRs", "a(yqq)", "aaay",
+                                  findPDRsCallback),
+        sdbusplus::vtable::method("FindStateSensorPDRs", "a(yqq)", "aaay",
+                                  findPDRsCallback),
+        sdbusplus::vtable::property("ChangeNumber", "t", changeNumberCallback,
+                                    sdbusplus::vtable::property_::emits_change),
+        sdbusplus::vtable::end()};
+
+    /** @brief PDR.Batch interface on the PDR object */
+    sdbusplus::server::interface_t batchIntf;
+
+    /** @brief event loop of the daemon */
+    sdeventplus::Event& event;
+
+    /** @brief state effecter and state sensor PDRs of the BMC's primary PDR
+     *         repo by entity type and state set
+     */
+    pldm::utils::StatePdrIndex index;
+
+    /** @brief pending PropertiesChanged of ChangeNumber */
+    std::unique_ptr<sdeventplus::source::Defer> changeSignal;
 };
 
 } // namespace dbus_api
@@ -2,8 +2,13 @@
 
 #include "xyz/openbmc_project/Common/error.hpp"
 
+#include <phosphor-logging/lg2.hpp>
+
+#include <algorithm>
 #include <iostream>
 
+PHOSPHOR_LOG2_USING;
+
 using namespace sdbusplus::xyz::openbmc_project::Common::Error;
 
 namespace pldm
@@ -13,12 +18,6 @@ namespace dbus_api
 
 uint8_t Requester::getInstanceId(uint8_t eid)
 {
-    if (ids.find(eid) == ids.end())
-    {
-        InstanceId id;
-        ids.emplace(eid, InstanceId());
-    }
-
     uint8_t id{};
     try
     {
@@ -29,8 +28,108 @@ uint8_t Requester::getInstanceId(uint8_t eid)
         throw TooManyResources();
     }
 
+    scheduleExpiry();
     return id;
 }
 
+std::vector<uint8_t> Requester::getInstanceIds(uint8_t eid, uint8_t count)
+{
+    if (!count || count > maxBatchInstanceIds)
+    {
+        throw InvalidArgument();
+    }
+
+    auto& instanceIds = ids[eid];
+    std::vector<uint8_t> reserved;
+    reserved.reserve(count);
+    try
+    {
+        while (reserved.size() < count)
+        {
+            reserved.push_back(instanceIds.next());
+        }
+    }
+    catch (const std::runtime_error&)
+    {
+        for (auto id : reserved)
+        {
+            instanceIds.markFree(id);
+        }
+        throw TooManyResources();
+    }
+
+    scheduleExpiry();
+    return reserved;
+}
+
+int Requester::getInstanceIdsCallback(sd_bus_message* msg, void* context,
+                                      sd_bus_error* error)
+{
+    auto requester = static_cast<Requester*>(context);
+    try
+    {
+        sdbusplus::message_t m{msg};
+        uint8_t eid{};
+        uint8_t count{};
+        m.read(eid, count);
+
+        auto reserved = requester->getInstanceIds(eid, count);
+
+        auto reply = m.new_method_return();
+        reply.append(reserved);
+        reply.method_return();
+    }
+    catch (const sdbusplus::exception_t& e)
+    {
+        return sd_bus_error_set(error, e.name(), e.description());
+    }
+
+    return 1;
+}
+
+void Requester::expireInstanceIds()
+{
+    auto now = InstanceId::Clock::now();
+    for (auto& [eid, instanceIds] : ids)
+    {
+        auto count = instanceIds.expire(now);
+        if (count)
+        {
+            info("Released {COUNT} expired instance ids of EID {EID}", "COUNT",
+                 count, "EID", unsigned(eid));
+        }
+    }
+    scheduleExpiry();
+}
+
+void Requester::scheduleExpiry()
+{
+    // A new or resumed instance id never expires before the ones already in
+    // use, so a running timer is already armed for the oldest one
+    if (expiryTimer.isRunning())
+    {
+        return;
+    }
+
+    std::optional<InstanceId::Clock::time_point> next;
+    for (const auto& [eid, instanceIds] : ids)
+    {
+        auto expiry = instanceIds.nextExpiry();
+        if (expiry && (!next || *expiry < *next))
+        {
+            next = expiry;
+        }
+    }
+    if (!next)
+    {
+        return;
+    }
+
+    auto delay = std::max(*next - InstanceId::Clock::now(),
+                          InstanceId::Clock::duration::zero());
+    expiryTimer.start(
+        std::chrono::duration_cast<std::chrono::microseconds>(delay));
+}
+
 } // namespace dbus_api
 } // namespace pldm
@@ -4,9 +4,14 @@
 #include "xyz/openbmc_project/PLDM/Requester/server.hpp"
 
 #include <sdbusplus/bus.hpp>
+#include <sdbusplus/server/interface.hpp>
 #include <sdbusplus/server/object.hpp>
+#include <sdbusplus/timer.hpp>
+#include <sdbusplus/vtable.hpp>
+#include <sdeventplus/event.hpp>
 
 #include <map>
+#include <vector>
 
 namespace pldm
 {
@@ -16,6 +21,12 @@ namespace dbus_api
 using RequesterIntf = sdbusplus::server::object_t<
     sdbusplus::xyz::openbmc_project::PLDM::server::Requester>;
 
+/** @brief D-Bus interface with the batched instance id method */
+constexpr auto requesterBatchIntf = "xyz.openbmc_project.PLDM.Requester.Batch";
+
+/** @brief Maximum number of instance ids reserved by one GetInstanceIds */
+constexpr uint8_t maxBatchInstanceIds = 8;
+
 /** @class Requester
  *  @brief OpenBMC PLDM.Requester implementation.
  *  @details A concrete implementation for the
@@ -36,11 +47,24 @@ class Requester : public RequesterIntf
      *  @param[in] path - Path to attach at.
      */
     Requester(sdbusplus::bus_t& bus, const std::string& path) :
-        RequesterIntf(bus, path.c_str()){};
+        RequesterIntf(bus, path.c_str()),
+        batchIntf(bus, path.c_str(), requesterBatchIntf, batchVtable, this),
+        expiryTimer(sdeventplus::Event::get_default().get(),
+                    [this] { expireInstanceIds(); }){};
 
     /** @brief Implementation for RequesterIntf.GetInstanceId */
     uint8_t getInstanceId(uint8_t eid) override;
 
+    /** @brief Implementation for Requester.Batch.GetInstanceIds, reserve
+     *         several instance ids of an endpoint in one call
+     *  @param[in] eid - MCTP eid
+     *  @param[in] count - number of instance ids, 1 to maxBatchInstanceIds
+     *  @return - PLDM instance ids
+     *  @note will throw TooManyResources if there are not enough instance ids,
+     *        none of the instance ids are reserved in that case
+     */
+    std::vector<uint8_t> getInstanceIds(uint8_t eid, uint8_t count);
+
     /** @brief Mark an instance id as unused
      *  @param[in] eid - MCTP eid to which this instance id belongs
      *  @param[in] instanceId - PLDM instance id to be freed
@@ -51,9 +75,64 @@ class Requester : public RequesterIntf
         ids[eid].markFree(instanceId);
     }
 
+    /** @brief Keep an instance id from expiring while its request is queued
+     *  @param[in] eid - MCTP eid to which this instance id belongs
+     *  @param[in] instanceId - PLDM instance id
+     */
+    void suspendExpiry(uint8_t eid, uint8_t instanceId)
+    {
+        ids[eid].suspendExpiry(instanceId);
+    }
+
+    /** @brief Start the expiry of an instance id over when its request is
+     *         sent
+     *  @param[in] eid - MCTP eid to which this instance id belongs
+     *  @param[in] instanceId - PLDM instance id
+     */
+    void resumeExpiry(uint8_t eid, uint8_t instanceId)
+    {
+        ids[eid].resumeExpiry(instanceId);
+        scheduleExpiry();
+    }
+
+    /** @brief Allocation counters of an endpoint
+     *  @param[in] eid - MCTP eid
+     *  @return - counters, all zero if the endpoint has no instance ids
+     */
+    InstanceId::Stats getStats(uint8_t eid) const
+    {
+        auto search = ids.find(eid);
+        return search == ids.end() ? InstanceId::Stats{}
+                                   : search->second.getStats();
+    }
+
   private:
+    /** @brief D-Bus method handler of Requester.Batch.GetInstanceIds */
+    static int getInstanceIdsCallback(sd_bus_message* msg, void* context,
+                                      sd_bus_error* error);
+
+    /** @brief Release the expired instance ids of all the endpoints and arm
+     *         the timer for the next expiry
+     */
+    void expireInstanceIds();
+
+    /** @brief Arm the expiry timer for the oldest instance id in use */
+    void scheduleExpiry();
+
+    static constexpr sdbusplus::vtable_t batchVtable[] = {
+        sdbusplus::vtable::start(),
+        sdbusplus::vtable::method("GetInstanceIds", "yy", "ay",
+                                  getInstanceIdsCallback),
+        sdbusplus::vtable::end()};
+
     /** @brief EID to PLDM Instance ID map */
     std::map<uint8_t, InstanceId> ids;
+
+    /** @brief Requester.Batch interface on the requester object */
+    sdbusplus::server::interface_t batchIntf;
+
+    /** @brief releases the instance ids that were never freed */
+    phosphor::Timer expiryTimer;
 };
 
 } // namespace dbus_api
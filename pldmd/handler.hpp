@@ -20,6 +20,56 @@ class CmdHandler;
 using HandlerFunc =
     std::function<Response(const pldm_msg* request, size_t reqMsgLen)>;
 
+/** @class Completer
+ *
+ *  @brief Completes the response of an asynchronous command. It can be called
+ *         from any thread. Only the first response of a command is sent, a
+ *         response that comes after the deadline of the command is dropped.
+ */
+class Completer
+{
+  public:
+    using Work = std::function<Response()>;
+    using Complete = std::function<void(Response&& response)>;
+    using Post = std::function<void(Work&& work)>;
+
+    Completer(Complete complete, Post post) :
+        complete(std::move(complete)), postWork(std::move(post))
+    {}
+
+    /** @brief Send the response of the command
+     *
+     *  @param[in] response - PLDM response message, an empty response is sent
+     *                        as PLDM_ERROR
+     */
+    void operator()(Response&& response) const
+    {
+        complete(std::move(response));
+    }
+
+    /** @brief Run the work on the worker pool, the response it returns is the
+     *         response of the command
+     *
+     *  @param[in] work - runs on a worker thread, it must not use the D-Bus
+     *                    connection or the state owned by the event loop
+     */
+    void post(Work&& work) const
+    {
+        postWork(std::move(work));
+    }
+
+  private:
+    Complete complete;
+    Post postWork;
+};
+
+/** @brief Handler of an asynchronous command. It runs on the event loop, the
+ *         request is only valid until it returns, and the response is sent
+ *         later with the completer.
+ */
+using AsyncHandlerFunc = std::function<void(
+    const pldm_msg* request, size_t reqMsgLen, Completer completer)>;
+
 class CmdHandler
 {
   public:
@@ -38,6 +88,30 @@ class CmdHandler
         return handlers.at(pldmCommand)(request, reqMsgLen);
     }
 
+    /** @brief Check if a PLDM command is handled asynchronously
+     *
+     *  @param[in] pldmCommand - PLDM command code
+     *  @return true if the command has an asynchronous handler
+     */
+    bool isAsync(Command pldmCommand) const
+    {
+        return asyncHandlers.contains(pldmCommand);
+    }
+
+    /** @brief Invoke an asynchronous PLDM command handler
+     *
+     *  @param[in] pldmCommand - PLDM command code
+     *  @param[in] request - PLDM request message
+     *  @param[in] reqMsgLen - PLDM request message size
+     *  @param[in] completer - completes the response of the command
+     */
+    void handle(Command pldmCommand, const pldm_msg* request,
+                size_t reqMsgLen, Completer completer)
+    {
+        asyncHandlers.at(pldmCommand)(request, reqMsgLen,
+                                      std::move(completer));
+    }
+
     /** @brief Create a response message containing only cc
      *
      *  @param[in] request - PLDM request message
@@ -60,6 +134,11 @@ class CmdHandler
      *         classes.
      */
     std::map<Command, HandlerFunc> handlers;
+
+    /** @brief map of PLDM command code to asynchronous handler, a command in
+     *         this map is not looked up in handlers
+     */
+    std::map<Command, AsyncHandlerFunc> asyncHandlers;
 };
 
 } // namespace responder
@@ -0,0 +1,209 @@
+#include "init_graph.hpp"
+
+#include <phosphor-logging/lg2.hpp>
+
+#include <algorithm>
+#include <exception>
+#include <stdexcept>
+
+PHOSPHOR_LOG2_USING;
+
+namespace pldm
+{
+
+namespace
+{
+
+long long toMilliseconds(InitGraph::Clock::duration duration)
+{
+    return std::chrono::duration_cast<std::chrono::milliseconds>(duration)
+        .count();
+}
+
+} // namespace
+
+InitGraph::~InitGraph()
+{
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        stopping = true;
+    }
+    changed.notify_all();
+    for (auto& worker : workers)
+    {
+        worker.join();
+    }
+}
+
+void InitGraph::add(const std::string& name,
+                    const std::vector<std::string>& dependencies, Task task)
+{
+    if (index.contains(name))
+    {
+        throw std::invalid_argument("Duplicate startup task " + name);
+    }
+
+    Node node{};
+    node.name = name;
+    node.task = std::move(task);
+    for (const auto& dependency : dependencies)
+    {
+        auto found = index.find(dependency);
+        if (found == index.end())
+        {
+            throw std::invalid_argument("Startup task " + name +
+                                        " depends on unknown task " +
+                                        dependency);
+        }
+        nodes[found->second].dependents.push_back(nodes.size());
+        ++node.waitingFor;
+    }
+    if (!node.waitingFor)
+    {
+        ready.push_back(nodes.size());
+    }
+    index.emplace(name, nodes.size());
+    nodes.push_back(std::move(node));
+    ++remaining;
+}
+
+void InitGraph::start(size_t workerCount)
+{
+    started = Clock::now();
+    if (!workerCount)
+    {
+        work();
+        return;
+    }
+    workerCount = std::min(workerCount, nodes.size());
+    for (size_t count = 0; count < workerCount; ++count)
+    {
+        workers.emplace_back(&InitGraph::work, this);
+    }
+}
+
+void InitGraph::work()
+{
+    std::unique_lock<std::mutex> guard(lock);
+    while (true)
+    {
+        changed.wait(guard,
+                     [this] { return stopping || !remaining || !ready.empty(); });
+        if (stopping || !remaining)
+        {
+            return;
+        }
+
+        auto current = ready.back();
+        ready.pop_back();
+        auto& node = nodes[current];
+        node.state = State::Running;
+        node.begin = Clock::now();
+        auto task = std::move(node.task);
+        guard.unlock();
+
+        bool succeeded = true;
+        try
+        {
+            task();
+        }
+        catch (const std::exception& e)
+        {
+            error("Startup task {TASK} failed, ERROR={ERR_EXCEP}", "TASK",
+                  nodes[current].name, "ERR_EXCEP", e.what());
+            succeeded = false;
+        }
+
+        guard.lock();
+        finish(current, succeeded);
+    }
+}
+
+void InitGraph::finish(size_t current, bool succeeded)
+{
+    auto& node = nodes[current];
+    node.end = Clock::now();
+    node.state = succeeded ? State::Succeeded : State::Failed;
+    --remaining;
+    for (auto dependent : node.dependents)
+    {
+        if (!succeeded)
+        {
+            skip(dependent);
+        }
+        else if (nodes[dependent].state == State::Pending &&
+                 !--nodes[dependent].waitingFor)
+        {
+            ready.push_back(dependent);
+        }
+    }
+    changed.notify_all();
+}
+
+void InitGraph::skip(size_t current)
+{
+    auto& node = nodes[current];
+    if (node.state != State::Pending)
+    {
+        return;
+    }
+    error("Startup task {TASK} is skipped", "TASK", node.name);
+    node.state = State::Skipped;
+    node.begin = node.end = Clock::now();
+    --remaining;
+    for (auto dependent : node.dependents)
+    {
+        skip(dependent);
+    }
+}
+
+bool InitGraph::wait(const std::string& name)
+{
+    std::unique_lock<std::mutex> guard(lock);
+    auto& node = nodes.at(index.at(name));
+    changed.wait(guard, [this, &node] { return done(node); });
+    return node.state == State::Succeeded;
+}
+
+void InitGraph::join()
+{
+    std::unique_lock<std::mutex> guard(lock);
+    changed.wait(guard, [this] { return !remaining; });
+}
+
+InitGraph::State InitGraph::state(const std::string& name) const
+{
+    std::lock_guard<std::mutex> guard(lock);
+    return nodes.at(index.at(name)).state;
+}
+
+void InitGraph::mark(const std::string& name)
+{
+    auto now = Clock::now();
+    std::lock_guard<std::mutex> guard(lock);
+    steps.push_back(
+        Step{name, steps.empty() ? started : steps.back().end, now});
+}
+
+void InitGraph::report() const
+{
+    std::lock_guard<std::mutex> guard(lock);
+    for (const auto& node : nodes)
+    {
+        info(
+            "Startup task {TASK} took {TIME}ms, started at {START}ms, SUCCESS={SUCCESS}",
+            "TASK", node.name, "TIME", toMilliseconds(node.end - node.begin),
+            "START", toMilliseconds(node.begin - started), "SUCCESS",
+            node.state == State::Succeeded);
+    }
+    for (const auto& step : steps)
+    {
+        info("Startup step {STEP} took {TIME}ms, started at {START}ms", "STEP",
+             step.name, "TIME", toMilliseconds(step.end - step.begin), "START",
+             toMilliseconds(step.begin - started));
+    }
+    auto end = steps.empty() ? Clock::now() : steps.back().end;
+    info("PLDM startup took {TIME}ms", "TIME", toMilliseconds(end - started));
+}
+
+} // namespace pldm
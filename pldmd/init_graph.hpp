@@ -0,0 +1,158 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace pldm
+{
+
+/** @class InitGraph
+ *
+ *  @brief Startup tasks of pldmd and their dependencies. The tasks that only
+ *         read files, like the JSON config parsing and the loading of the
+ *         persisted state, run on a pool of worker threads while the main
+ *         thread goes on with the D-Bus and event loop setup, which must stay
+ *         on the main thread. The main thread waits for a task right before
+ *         it needs its result.
+ *
+ *         A task runs once all its dependencies succeeded, the dependents of
+ *         a task that threw are skipped. The steps of the main thread are
+ *         timed with mark() and reported with the tasks.
+ */
+class InitGraph
+{
+  public:
+    using Clock = std::chrono::steady_clock;
+    using Task = std::function<void()>;
+
+    InitGraph() = default;
+    InitGraph(const InitGraph&) = delete;
+    InitGraph(InitGraph&&) = delete;
+    InitGraph& operator=(const InitGraph&) = delete;
+    InitGraph& operator=(InitGraph&&) = delete;
+
+    /** @brief Joins the workers, the tasks not started yet are skipped */
+    ~InitGraph();
+
+    /** @brief Add a task, before start()
+     *
+     *  @param[in] name - name of the task, unique among tasks and steps
+     *  @param[in] dependencies - tasks that must succeed first, added before
+     *  @param[in] task - task, run on a worker thread
+     */
+    void add(const std::string& name,
+             const std::vector<std::string>& dependencies, Task task);
+
+    /** @brief Start running the tasks
+     *
+     *  @param[in] workerCount - number of worker threads, 0 runs all the
+     *                           tasks on the calling thread before returning
+     */
+    void start(size_t workerCount);
+
+    /** @brief Wait for a task
+     *
+     *  @param[in] name - name of the task
+     *
+     *  @return true if the task succeeded
+     */
+    bool wait(const std::string& name);
+
+    /** @brief Wait for all the tasks */
+    void join();
+
+    /** @brief Record a step of the main thread, which ran since the previous
+     *         step or since start()
+     *
+     *  @param[in] name - name of the step
+     */
+    void mark(const std::string& name);
+
+    /** @brief Log the time taken by the tasks and the steps, and the total
+     *         time since start()
+     */
+    void report() const;
+
+    /** @enum State
+     *
+     *  State of a task
+     */
+    enum class State
+    {
+        Pending,
+        Running,
+        Succeeded,
+        Failed,
+        Skipped,
+    };
+
+    /** @brief State of a task */
+    State state(const std::string& name) const;
+
+  private:
+    /** @struct Node
+     *
+     *  Task of the graph
+     */
+    struct Node
+    {
+        std::string name;
+        Task task;
+        std::vector<size_t> dependents;
+        size_t waitingFor = 0; //!< dependencies not done yet
+        State state = State::Pending;
+        Clock::time_point begin;
+        Clock::time_point end;
+    };
+
+    /** @struct Step
+     *
+     *  Step of the main thread
+     */
+    struct Step
+    {
+        std::string name;
+        Clock::time_point begin;
+        Clock::time_point end;
+    };
+
+    /** @brief Run the ready tasks until all the tasks are done, or until
+     *         stopping
+     */
+    void work();
+
+    /** @brief Record the end of a task and release its dependents, with the
+     *         lock held
+     */
+    void finish(size_t index, bool succeeded);
+
+    /** @brief Skip a task and its dependents, with the lock held */
+    void skip(size_t index);
+
+    bool done(const Node& node) const
+    {
+        return node.state == State::Succeeded ||
+               node.state == State::Failed || node.state == State::Skipped;
+    }
+
+    std::vector<Node> nodes;
+    std::map<std::string, size_t, std::less<>> index;
+    std::vector<size_t> ready;
+    size_t remaining = 0;
+    bool stopping = false;
+
+    std::vector<Step> steps;
+    Clock::time_point started;
+
+    mutable std::mutex lock;
+    std::condition_variable changed;
+    std::vector<std::thread> workers;
+};
+
+} // namespace pldm
@@ -2,6 +2,7 @@
 
 #include <phosphor-logging/lg2.hpp>
 
+#include <bit>
 #include <stdexcept>
 
 PHOSPHOR_LOG2_USING;
@@ -10,70 +11,163 @@ namespace pldm
 {
 uint8_t InstanceId::next()
 {
-    uint8_t idx = 0;
-    while (idx < id.size() && id.test(idx))
+    if (used == UINT32_MAX)
     {
-        ++idx;
-    }
-
-    if (idx == id.size())
-    {
-        // check all the instance ids and free up the one
-        // that is acquired oldest
-        error("lg2 all the Instance ids are exhausted");
-
+        // Take over the oldest instance id, if it has expired
         auto instance = returnOldestId();
-        if (instance.has_value())
-        {
-            idx = instance.value();
-            // forcefully release the instance id
-            markFree(idx);
-        }
-        else
+        if (!instance.has_value())
         {
+            stats.exhaustions++;
+            error(
+                "All the instance ids are in use and none is older than the expiration time, EXHAUSTIONS={COUNT}",
+                "COUNT", stats.exhaustions);
             throw std::runtime_error(
                 "Instance Id older than instance id expiration time could not be found");
         }
+
+        auto age = std::chrono::duration_cast<std::chrono::milliseconds>(
+            Clock::now() - timestamp[*instance]);
+        info("Forcefully releasing instance id {ID}, in use for {AGE} ms", "ID",
+             unsigned(*instance), "AGE", age.count());
+        markFree(*instance);
+        stats.forcedFrees++;
     }
 
-    id.set(idx);
-    timestamp[idx] = std::chrono::system_clock::now();
+    uint8_t idx = static_cast<uint8_t>(std::countr_one(used));
+    used |= (1u << idx);
+    timestamp[idx] = Clock::now();
+    link(idx);
+    stats.allocations++;
     return idx;
 }
 
-std::optional<uint8_t> InstanceId::returnOldestId()
+std::optional<uint8_t> InstanceId::returnOldestId() const
 {
-    uint8_t idx = 0;
-    bool skipInstance = true;
-    auto now = std::chrono::system_clock::now();
-    std::chrono::duration<double> elapsedtime{};
+    if (head == none || Clock::now() - timestamp[head] <= expirationInterval)
+    {
+        return std::nullopt;
+    }
+    return head;
+}
 
-    for (const auto& [instanceId, timepoint] : timestamp)
+void InstanceId::markFree(uint8_t instanceId)
+{
+    if (instanceId >= maxInstanceIds)
     {
-        std::chrono::duration<double> instanceTime = now - timepoint;
-        if (instanceTime >
-            std::chrono::seconds(INSTANCE_ID_EXPIRATION_INTERVAL))
-        {
-            skipInstance = false;
-        }
-        if (instanceTime > elapsedtime)
-        {
-            elapsedtime = instanceTime;
-            idx = instanceId;
-        }
+        throw std::out_of_range("Invalid instance id");
+    }
+    if (!(used & (1u << instanceId)))
+    {
+        return;
+    }
+    used &= ~(1u << instanceId);
+    if (suspended & (1u << instanceId))
+    {
+        suspended &= ~(1u << instanceId);
+    }
+    else
+    {
+        unlink(instanceId);
+    }
+}
+
+void InstanceId::suspendExpiry(uint8_t instanceId)
+{
+    if (instanceId >= maxInstanceIds)
+    {
+        throw std::out_of_range("Invalid instance id");
+    }
+    uint32_t bit = 1u << instanceId;
+    if (!(used & bit) || (suspended & bit))
+    {
+        return;
+    }
+    unlink(instanceId);
+    suspended |= bit;
+}
+
+void InstanceId::resumeExpiry(uint8_t instanceId)
+{
+    if (instanceId >= maxInstanceIds)
+    {
+        throw std::out_of_range("Invalid instance id");
     }
-    if (skipInstance)
+    uint32_t bit = 1u << instanceId;
+    if (!(used & bit))
+    {
+        return;
+    }
+    if (suspended & bit)
+    {
+        suspended &= ~bit;
+    }
+    else
+    {
+        unlink(instanceId);
+    }
+    timestamp[instanceId] = Clock::now();
+    link(instanceId);
+}
+
+size_t InstanceId::expire(Clock::time_point now)
+{
+    size_t count = 0;
+    while (head != none &&
+           now - timestamp[head] > expirationInterval + expiryGracePeriod)
+    {
+        markFree(head);
+        ++count;
+    }
+    stats.expirations += count;
+    return count;
+}
+
+std::optional<InstanceId::Clock::time_point> InstanceId::nextExpiry() const
+{
+    if (head == none)
     {
-        error(
-            "lg2 None of the instance id's are older then the pldm instance id expiration time");
         return std::nullopt;
     }
-    const std::time_t t_c =
-        std::chrono::system_clock::to_time_t(timestamp[idx]);
-    std::cerr << "Forcefully releasing Instance ID :" << (unsigned)idx
-              << " Last used at timestamp : "
-              << std::put_time(std::localtime(&t_c), "%F %T\n") << std::flush;
-    return idx;
+    return timestamp[head] + expirationInterval + expiryGracePeriod;
+}
+
+void InstanceId::link(uint8_t instanceId)
+{
+    older[instanceId] = tail;
+    newer[instanceId] = none;
+    if (tail != none)
+    {
+        newer[tail] = instanceId;
+    }
+    else
+    {
+        head = instanceId;
+    }
+    tail = instanceId;
+}
+
+void InstanceId::unlink(uint8_t instanceId)
+{
+    auto prev = older[instanceId];
+    auto next = newer[instanceId];
+    if (prev != none)
+    {
+        newer[prev] = next;
+    }
+    else
+    {
+        head = next;
+    }
+    if (next != none)
+    {
+        older[next] = prev;
+    }
+    else
+    {
+        tail = prev;
+    }
+    older[instanceId] = none;
+    newer[instanceId] = none;
 }
 
 } // namespace pldm
@@ -1,7 +1,9 @@
 #pragma once
 
+#include <array>
 #include <bitset>
 #include <chrono>
+#include <cstdint>
 #include <ctime>
 #include <iomanip>
 #include <iostream>
@@ -15,34 +17,120 @@ constexpr size_t maxInstanceIds = 32;
 
 /** @class InstanceId
  *  @brief Implementation of PLDM instance id as per DSP0240 v1.0.0
+ *
+ *  The instance ids in use are kept in a bitmask, so allocation is a find
+ *  first zero. The ids in use are also linked in the order they were handed
+ *  out, so the oldest id is found without a scan when the ids run out or
+ *  expire. The expiry of an id can be suspended while its request is queued,
+ *  and resumed when the request is sent.
  */
 class InstanceId
 {
   public:
+    using Clock = std::chrono::steady_clock;
+
+    /** @struct Stats
+     *
+     *  Allocation counters of an endpoint
+     */
+    struct Stats
+    {
+        uint64_t allocations = 0; //!< instance ids handed out
+        uint64_t exhaustions = 0; //!< allocations that failed, no id free
+        uint64_t forcedFrees = 0; //!< expired ids taken over when exhausted
+        uint64_t expirations = 0; //!< expired ids released by expire()
+    };
+
+    InstanceId()
+    {
+        older.fill(none);
+        newer.fill(none);
+    }
+
     /** @brief Get next unused instance id
      *  @return - PLDM instance id
+     *  @note will throw std::runtime_error if all the instance ids are in use
+     *        and none of them has expired
      */
     uint8_t next();
 
-    /** @brief Get the oldest instance id based on timestamp
+    /** @brief Get the oldest instance id if it has expired
      *  @return - Oldest PLDM instance id or nullopt
      */
-    std::optional<uint8_t> returnOldestId();
+    std::optional<uint8_t> returnOldestId() const;
 
     /** @brief Mark an instance id as unused
      *  @param[in] instanceId - PLDM instance id to be freed
+     *  @note will throw std::out_of_range if instanceId > 31
+     */
+    void markFree(uint8_t instanceId);
+
+    /** @brief Keep an instance id in use from expiring until resumeExpiry(),
+     *         while the request it was handed out for waits to be sent
+     *  @param[in] instanceId - PLDM instance id
+     */
+    void suspendExpiry(uint8_t instanceId);
+
+    /** @brief Start the expiry of an instance id in use over from now, when
+     *         the request it was handed out for is sent
+     *  @param[in] instanceId - PLDM instance id
+     */
+    void resumeExpiry(uint8_t instanceId);
+
+    /** @brief Release the instance ids that were not freed by their owner
+     *         within the instance id expiration interval and a grace period
+     *  @param[in] now - current time
+     *  @return - number of instance ids released
+     *  @note the grace period lets requester::Handler free its expired ids
+     *        first, so only the ids nobody released are reclaimed
      */
-    void markFree(uint8_t instanceId)
+    size_t expire(Clock::time_point now);
+
+    /** @brief Time the oldest instance id in use is released by expire()
+     *  @return - expiry time or nullopt if no instance id is in use
+     */
+    std::optional<Clock::time_point> nextExpiry() const;
+
+    /** @brief Allocation counters of the endpoint */
+    const Stats& getStats() const
     {
-        id.set(instanceId, false);
-        // Clear the time stamp associated with the instance id
-        timestamp.erase(instanceId);
+        return stats;
     }
 
   private:
-    std::bitset<maxInstanceIds> id;
-    std::map<uint8_t, std::chrono::time_point<std::chrono::system_clock>>
-        timestamp;
+    static constexpr uint8_t none = maxInstanceIds;
+    static constexpr auto expirationInterval =
+        std::chrono::seconds(INSTANCE_ID_EXPIRATION_INTERVAL);
+    static constexpr auto expiryGracePeriod = std::chrono::seconds(1);
+
+    /** @brief Append an instance id to the allocation order */
+    void link(uint8_t instanceId);
+
+    /** @brief Remove an instance id from the allocation order */
+    void unlink(uint8_t instanceId);
+
+    /** @brief bit n is set if instance id n is in use */
+    uint32_t used = 0;
+
+    /** @brief bit n is set if instance id n does not expire, it is then not
+     *         in the allocation order
+     */
+    uint32_t suspended = 0;
+
+    /** @brief time each instance id in use was handed out, or its expiry
+     *         resumed
+     */
+    std::array<Clock::time_point, maxInstanceIds> timestamp{};
+
+    /** @brief allocation order of the instance ids in use that can expire,
+     *         from the oldest (head) to the newest (tail)
+     */
+    std::array<uint8_t, maxInstanceIds> older{};
+    std::array<uint8_t, maxInstanceIds> newer{};
+    uint8_t head = none;
+    uint8_t tail = none;
+
+    Stats stats;
 };
 
 } // namespace pldm
@@ -42,6 +42,33 @@ class Invoker
         return handlers.at(pldmType)->handle(pldmCommand, request, reqMsgLen);
     }
 
+    /** @brief Check if a PLDM command is handled asynchronously
+     *
+     *  @param[in] pldmType - PLDM type code
+     *  @param[in] pldmCommand - PLDM command code
+     *  @return true if the command has an asynchronous handler
+     */
+    bool isAsync(Type pldmType, Command pldmCommand) const
+    {
+        auto search = handlers.find(pldmType);
+        return search != handlers.end() && search->second->isAsync(pldmCommand);
+    }
+
+    /** @brief Invoke an asynchronous PLDM command handler
+     *
+     *  @param[in] pldmType - PLDM type code
+     *  @param[in] pldmCommand - PLDM command code
+     *  @param[in] request - PLDM request message
+     *  @param[in] reqMsgLen - PLDM request message size
+     *  @param[in] completer - completes the response of the command
+     */
+    void handle(Type pldmType, Command pldmCommand, const pldm_msg* request,
+                size_t reqMsgLen, Completer completer)
+    {
+        handlers.at(pldmType)->handle(pldmCommand, request, reqMsgLen,
+                                      std::move(completer));
+    }
+
   private:
     std::map<Type, std::unique_ptr<CmdHandler>> handlers;
 };
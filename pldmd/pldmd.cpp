@@ -3,12 +3,16 @@
 #include "libpldm/pdr.h"
 #include "libpldm/platform.h"
 
+#include "async_responder.hpp"
 #include "common/flight_recorder.hpp"
+#include "common/json_cache.hpp"
 #include "common/utils.hpp"
 #include "dbus_impl_requester.hpp"
 #include "fw-update/manager.hpp"
 #include "host-bmc/dbus/deserialize.hpp"
+#include "init_graph.hpp"
 #include "invoker.hpp"
+#include "replay.hpp"
 #include "requester/handler.hpp"
 #include "requester/mctp_endpoint_discovery.hpp"
 #include "requester/request.hpp"
@@ -43,6 +47,7 @@
 
 #ifdef LIBPLDMRESPONDER
 #include "dbus_impl_pdr.hpp"
+#include "host-bmc/dbus/serialize.hpp"
 #include "host-bmc/dbus_to_event_handler.hpp"
 #include "host-bmc/dbus_to_host_effecters.hpp"
 #include "host-bmc/host_associations_parser.hpp"
@@ -61,6 +66,7 @@
 #include "libpldmresponder/file_io.hpp"
 #include "libpldmresponder/fru_oem_ibm.hpp"
 #include "libpldmresponder/oem_ibm_handler.hpp"
+#include "libpldmresponder/utils.hpp"
 #include "oem/ibm/host-bmc/host_lamp_test.hpp"
 #endif
 
@@ -95,7 +101,7 @@ void requestPLDMServiceName()
 static std::optional<Response>
     processRxMsg(const std::vector<uint8_t>& requestMsg, Invoker& invoker,
                  requester::Handler<requester::Request>& handler,
-                 fw_update::Manager* fwManager)
+                 fw_update::Manager* fwManager, AsyncResponder& asyncResponder)
 {
     using type = uint8_t;
     uint8_t eid = requestMsg[0];
@@ -111,13 +117,39 @@ static std::optional<Response>
 
     if (PLDM_RESPONSE != hdrFields.msg_type)
     {
+        // The requests of an endpoint are answered in order, wait for its
+        // asynchronous command
+        if (asyncResponder.busy(eid))
+        {
+            asyncResponder.defer(requestMsg);
+            return std::nullopt;
+        }
+
         Response response;
         auto request = reinterpret_cast<const pldm_msg*>(hdr);
         size_t requestLen = requestMsg.size() - sizeof(struct pldm_msg_hdr) -
                             sizeof(eid) - sizeof(type);
         try
         {
-            if (hdrFields.pldm_type != PLDM_FWUP)
+            if (hdrFields.pldm_type != PLDM_FWUP &&
+                invoker.isAsync(hdrFields.pldm_type, hdrFields.command))
+            {
+                auto completer = asyncResponder.begin(requestMsg);
+                try
+                {
+                    invoker.handle(hdrFields.pldm_type, hdrFields.command,
+                                   request, requestLen, completer);
+                }
+                catch (const std::exception& e)
+                {
+                    error("Asynchronous command {CMD} failed, ERROR={ERR_EXCEP}",
+                          "CMD", unsigned(hdrFields.command), "ERR_EXCEP",
+                          e.what());
+                    completer({});
+                }
+                return std::nullopt;
+            }
+            else if (hdrFields.pldm_type != PLDM_FWUP)
             {
                 response = invoker.handle(hdrFields.pldm_type,
                                           hdrFields.command, request,
@@ -160,34 +192,157 @@ static std::optional<Response>
     return std::nullopt;
 }
 
+/** @brief Send the response of a request
+ *
+ *  @param[in] fd - socket to mctp-mux
+ *  @param[in] requestMsg - request prefixed with EID and MCTP type
+ *  @param[in] response - PLDM response message
+ *  @param[in/out] currentSendbuffSize - send buffer size of the socket
+ *  @param[in] verbose - print the response
+ */
+static void sendResponse(int fd, const std::vector<uint8_t>& requestMsg,
+                         const Response& response, int& currentSendbuffSize,
+                         bool verbose)
+{
+    FlightRecorder::GetInstance().saveRecord(response, true);
+    if (verbose)
+    {
+        printBuffer(Tx, response);
+    }
+
+    // Outgoing message.
+    struct iovec iov[2]{};
+
+    // This structure contains the parameter information for the response
+    // message.
+    struct msghdr msg
+    {};
+
+    iov[0].iov_base = const_cast<uint8_t*>(&requestMsg[0]);
+    iov[0].iov_len = sizeof(requestMsg[0]) + sizeof(requestMsg[1]);
+    iov[1].iov_base = const_cast<uint8_t*>(response.data());
+    iov[1].iov_len = response.size();
+
+    msg.msg_iov = iov;
+    msg.msg_iovlen = sizeof(iov) / sizeof(iov[0]);
+    if (currentSendbuffSize >= 0 &&
+        (size_t)currentSendbuffSize < response.size())
+    {
+        int oldBuffSize = currentSendbuffSize;
+        currentSendbuffSize = response.size();
+        int res = setsockopt(fd, SOL_SOCKET, SO_SNDBUF, &currentSendbuffSize,
+                             sizeof(currentSendbuffSize));
+        if (res == -1)
+        {
+            error(
+                "Responder : Failed to set the new send buffer size [bytes] : {CUR_BUFF_SIZE} from current size [bytes] : {OLD_BUFF_SIZE}, Error : {ERR}",
+                "CUR_BUFF_SIZE", currentSendbuffSize, "OLD_BUFF_SIZE",
+                oldBuffSize, "ERR", strerror(errno));
+            return;
+        }
+    }
+
+    int result = sendmsg(fd, &msg, 0);
+    if (-1 == result)
+    {
+        error("sendto system call failed, RC= {RC}", "RC", -errno);
+    }
+}
+
 void optionUsage(void)
 {
     error("Usage: pldmd [options]");
     error("Options:");
     error(" [--verbose] - would enable verbosity");
+    error(" [--replay <file>] - replay a flight recorder dump and exit");
+    error(" [--replay-speed <factor>] - speed up the replay timing, 0 sends "
+          "the requests back to back");
 }
 
 int main(int argc, char** argv)
 {
     bool verbose = false;
-    static struct option long_options[] = {{"verbose", no_argument, 0, 'v'},
-                                           {0, 0, 0, 0}};
-
-    auto argflag = getopt_long(argc, argv, "v", long_options, nullptr);
-    switch (argflag)
+    std::string replayPath;
+    double replaySpeed = 1;
+    static struct option long_options[] = {
+        {"verbose", no_argument, 0, 'v'},
+        {"replay", required_argument, 0, 'r'},
+        {"replay-speed", required_argument, 0, 's'},
+        {0, 0, 0, 0}};
+
+    int argflag = 0;
+    while ((argflag = getopt_long(argc, argv, "vr:s:", long_options,
+                                  nullptr)) != -1)
     {
-        case 'v':
-            verbose = true;
-            break;
-        case -1:
-            break;
-        default:
-            optionUsage();
-            exit(EXIT_FAILURE);
+        switch (argflag)
+        {
+            case 'v':
+                verbose = true;
+                break;
+            case 'r':
+                replayPath = optarg;
+                break;
+            case 's':
+                replaySpeed = std::strtod(optarg, nullptr);
+                break;
+            default:
+                optionUsage();
+                exit(EXIT_FAILURE);
+        }
     }
-    /* Create local socket. */
+
+    // The JSON configuration and the persisted state are read on worker
+    // threads while the main thread sets up the socket and D-Bus. The
+    // handlers are still created in order on the main thread, each one waits
+    // for the files it reads, which are then taken from the JSON cache.
+    InitGraph initGraph;
+#ifdef LIBPLDMRESPONDER
+#ifndef SYSTEM_SPECIFIC_BIOS_JSON
+    // The system specific BIOS JSONs are in a directory named after the
+    // system type, which is known only once Entity Manager publishes it, so
+    // they are not prefetched
+    initGraph.add("bios-config", {},
+                  [] { JsonCache::get().prefetch(BIOS_JSONS_DIR); });
+#endif
+    initGraph.add("host-config", {},
+                  [] { JsonCache::get().prefetch(HOST_JSONS_DIR); });
+    initGraph.add("events-config", {},
+                  [] { JsonCache::get().prefetch(EVENTS_JSONS_DIR); });
+    initGraph.add("fru-config", {}, [] {
+        JsonCache::get().prefetch(FRU_MASTER_JSON);
+        JsonCache::get().prefetch(FRU_JSONS_DIR);
+    });
+    initGraph.add("dbus-config", {},
+                  [] { JsonCache::get().prefetch(DBUS_JSON_FILE); });
+    initGraph.add("persisted-objects", {},
+                  [] { pldm::serialize::Serialize::getSerialize(); });
+#ifdef OEM_IBM
+    initGraph.add("license-store", {},
+                  [] { pldm::responder::utils::getLicenseStore(); });
+#endif
+#endif
+    initGraph.start(STARTUP_WORKERS);
+
+    /* Create local socket. In the replay mode the socket is one end of a
+     * socketpair, the replayer sends the recorded requests on the other end
+     * instead of mctp-mux.
+     */
     int returnCode = 0;
-    int sockfd = socket(AF_UNIX, SOCK_SEQPACKET, 0);
+    int sockfd = -1;
+    int replayFd = -1;
+    if (replayPath.empty())
+    {
+        sockfd = socket(AF_UNIX, SOCK_SEQPACKET, 0);
+    }
+    else
+    {
+        int fds[2];
+        if (0 == socketpair(AF_UNIX, SOCK_SEQPACKET, 0, fds))
+        {
+            sockfd = fds[0];
+            replayFd = fds[1];
+        }
+    }
     if (-1 == sockfd)
     {
         returnCode = -errno;
@@ -222,6 +377,7 @@ int main(int argc, char** argv)
     Invoker invoker{};
     requester::Handler<requester::Request> reqHandler(
         sockfd, event, dbusImplReq, currentSendbuffSize, verbose);
+    initGraph.mark("dbus");
 
 #ifdef LIBPLDMRESPONDER
     using namespace pldm::state_sensor;
@@ -259,15 +415,20 @@ int main(int argc, char** argv)
     DBusHandler dbusHandler;
     auto hostEID = pldm::utils::readHostEID();
     auto platformConfigHandler = std::make_unique<platform_config::Handler>();
+#ifndef SYSTEM_SPECIFIC_BIOS_JSON
+    initGraph.wait("bios-config");
+#endif
     auto biosHandler = std::make_unique<bios::Handler>(
         sockfd, hostEID, &dbusImplReq, &reqHandler, platformConfigHandler.get(),
         requestPLDMServiceName);
     invoker.registerHandler(PLDM_BIOS, std::move(biosHandler));
     std::unique_ptr<oem_platform::Handler> oemPlatformHandler{};
     std::unique_ptr<oem_fru::Handler> oemFruHandler{};
+    initGraph.mark("bios");
 
     if (hostEID)
     {
+        initGraph.wait("host-config");
         hostEffecterParser =
             std::make_unique<pldm::host_effecters::HostEffecterParser>(
                 &dbusImplReq, sockfd, pdrRepo.get(), &dbusHandler,
@@ -280,6 +441,7 @@ int main(int argc, char** argv)
     std::unique_ptr<pldm::responder::SlotHandler> slotHandler =
         std::make_unique<pldm::responder::SlotHandler>(event, pdrRepo.get());
     codeUpdate->clearDirPath(LID_STAGING_DIR);
+    initGraph.wait("license-store");
     oemPlatformHandler = std::make_unique<oem_ibm_platform::Handler>(
         &dbusHandler, codeUpdate.get(), slotHandler.get(), sockfd, hostEID,
         dbusImplReq, event, pdrRepo.get(), &reqHandler, bmcEntityTree.get(),
@@ -298,9 +460,11 @@ int main(int argc, char** argv)
         std::make_unique<pldm::led::HostLampTest>(
             bus, "/xyz/openbmc_project/led/groups/host_lamp_test", sockfd,
             hostEID, dbusImplReq, pdrRepo.get(), reqHandler);
+    initGraph.mark("oem");
 #endif
     if (hostEID)
     {
+        initGraph.wait("events-config");
         associationsParser =
             std::make_unique<pldm::host_associations::HostAssociationsParser>(
                 HOST_JSONS_DIR);
@@ -316,7 +480,9 @@ int main(int argc, char** argv)
         dbusToPLDMEventHandler = std::make_unique<DbusToPLDMEvent>(
             sockfd, hostEID, dbusImplReq, &reqHandler);
     }
+    initGraph.mark("host");
 
+    initGraph.wait("fru-config");
     auto fruHandler = std::make_unique<fru::Handler>(
         FRU_JSONS_DIR, FRU_MASTER_JSON, pdrRepo.get(), entityTree.get(),
         bmcEntityTree.get(), oemFruHandler.get(), dbusImplReq, &reqHandler,
@@ -346,38 +512,50 @@ int main(int argc, char** argv)
         std::make_unique<base::Handler>(hostEID, dbusImplReq, event,
                                         oemPlatformHandler.get(), &reqHandler));
     invoker.registerHandler(PLDM_FRU, std::move(fruHandler));
-    dbus_api::Pdr dbusImplPdr(bus, "/xyz/openbmc_project/pldm", pdrRepo.get());
+    dbus_api::Pdr dbusImplPdr(bus, "/xyz/openbmc_project/pldm", pdrRepo.get(),
+                              event);
     sdbusplus::xyz::openbmc_project::PLDM::server::Event dbusImplEvent(
         bus, "/xyz/openbmc_project/pldm");
 
+    initGraph.mark("handlers");
+
+    initGraph.wait("dbus-config");
+    initGraph.wait("persisted-objects");
     pldm::deserialize::restoreDbusObj(hostPDRHandler.get());
+    initGraph.mark("restore");
 
 #endif
 
     pldm::utils::CustomFD socketFd(sockfd);
 
-    struct sockaddr_un addr
-    {};
-    addr.sun_family = AF_UNIX;
-    const char path[] = "\0mctp-mux";
-    memcpy(addr.sun_path, path, sizeof(path) - 1);
-    int result = connect(socketFd(), reinterpret_cast<struct sockaddr*>(&addr),
-                         sizeof(path) + sizeof(addr.sun_family) - 1);
-    if (-1 == result)
+    if (replayPath.empty())
     {
-        returnCode = -errno;
-        error("Failed to connect to the socket, RC= {RC}", "RC", returnCode);
-        exit(EXIT_FAILURE);
-    }
+        struct sockaddr_un addr
+        {};
+        addr.sun_family = AF_UNIX;
+        const char path[] = "\0mctp-mux";
+        memcpy(addr.sun_path, path, sizeof(path) - 1);
+        int result = connect(socketFd(),
+                             reinterpret_cast<struct sockaddr*>(&addr),
+                             sizeof(path) + sizeof(addr.sun_family) - 1);
+        if (-1 == result)
+        {
+            returnCode = -errno;
+            error("Failed to connect to the socket, RC= {RC}", "RC",
+                  returnCode);
+            exit(EXIT_FAILURE);
+        }
 
-    result = write(socketFd(), &MCTP_MSG_TYPE_PLDM, sizeof(MCTP_MSG_TYPE_PLDM));
-    if (-1 == result)
-    {
-        returnCode = -errno;
-        error("Failed to send message type as pldm to mctp, RC= {RC}", "RC",
-              returnCode);
+        result = write(socketFd(), &MCTP_MSG_TYPE_PLDM,
+                       sizeof(MCTP_MSG_TYPE_PLDM));
+        if (-1 == result)
+        {
+            returnCode = -errno;
+            error("Failed to send message type as pldm to mctp, RC= {RC}",
+                  "RC", returnCode);
 
-        exit(EXIT_FAILURE);
+            exit(EXIT_FAILURE);
+        }
     }
 
     std::unique_ptr<fw_update::Manager> fwManager =
@@ -385,21 +563,38 @@ int main(int argc, char** argv)
     std::unique_ptr<MctpDiscovery> mctpDiscoveryHandler =
         std::make_unique<MctpDiscovery>(bus, fwManager.get());
 
-    auto callback = [verbose, &invoker, &reqHandler, currentSendbuffSize,
-                     &fwManager](IO& io, int fd, uint32_t revents) mutable {
+    // Handlers of asynchronous commands complete their response later, from
+    // the worker pool or from an asynchronous D-Bus call
+    std::unique_ptr<AsyncResponder> asyncResponder;
+    auto processRequest = [verbose, &invoker, &reqHandler, &currentSendbuffSize,
+                           &fwManager, &asyncResponder,
+                           &socketFd](const std::vector<uint8_t>& requestMsg) {
+        // process message and send response
+        auto response = processRxMsg(requestMsg, invoker, reqHandler,
+                                     fwManager.get(), *asyncResponder);
+        if (response.has_value())
+        {
+            sendResponse(socketFd(), requestMsg, *response,
+                         currentSendbuffSize, verbose);
+        }
+    };
+    asyncResponder = std::make_unique<AsyncResponder>(
+        event, RESPONDER_WORKERS, std::chrono::milliseconds(RESPONDER_DEADLINE),
+        [verbose, &currentSendbuffSize,
+         &socketFd](const std::vector<uint8_t>& requestMsg,
+                    const Response& response) {
+        sendResponse(socketFd(), requestMsg, response, currentSendbuffSize,
+                     verbose);
+    },
+        processRequest);
+
+    auto callback = [verbose, &processRequest](IO& io, int fd,
+                                               uint32_t revents) {
         if (!(revents & EPOLLIN))
         {
             return;
         }
 
-        // Outgoing message.
-        struct iovec iov[2]{};
-
-        // This structure contains the parameter information for the response
-        // message.
-        struct msghdr msg
-        {};
-
         int returnCode = 0;
         ssize_t peekedLength = recv(fd, nullptr, 0, MSG_PEEK | MSG_TRUNC);
         if (0 == peekedLength)
@@ -436,53 +631,7 @@ int main(int argc, char** argv)
                 }
                 else
                 {
-                    // process message and send response
-                    auto response = processRxMsg(requestMsg, invoker,
-                                                 reqHandler, fwManager.get());
-                    if (response.has_value())
-                    {
-                        FlightRecorder::GetInstance().saveRecord(*response,
-                                                                 true);
-                        if (verbose)
-                        {
-                            printBuffer(Tx, *response);
-                        }
-
-                        iov[0].iov_base = &requestMsg[0];
-                        iov[0].iov_len = sizeof(requestMsg[0]) +
-                                         sizeof(requestMsg[1]);
-                        iov[1].iov_base = (*response).data();
-                        iov[1].iov_len = (*response).size();
-
-                        msg.msg_iov = iov;
-                        msg.msg_iovlen = sizeof(iov) / sizeof(iov[0]);
-                        if (currentSendbuffSize >= 0 &&
-                            (size_t)currentSendbuffSize < (*response).size())
-                        {
-                            int oldBuffSize = currentSendbuffSize;
-                            currentSendbuffSize = (*response).size();
-                            int res = setsockopt(fd, SOL_SOCKET, SO_SNDBUF,
-                                                 &currentSendbuffSize,
-                                                 sizeof(currentSendbuffSize));
-                            if (res == -1)
-                            {
-                                error(
-                                    "Responder : Failed to set the new send buffer size [bytes] : {CUR_BUFF_SIZE} from current size [bytes] : {OLD_BUFF_SIZE}, Error : {ERR}",
-                                    "CUR_BUFF_SIZE", currentSendbuffSize,
-                                    "OLD_BUFF_SIZE", oldBuffSize, "ERR",
-                                    strerror(errno));
-                                return;
-                            }
-                        }
-
-                        int result = sendmsg(fd, &msg, 0);
-                        if (-1 == result)
-                        {
-                            returnCode = -errno;
-                            error("sendto system call failed, RC= {RC}", "RC",
-                                  returnCode);
-                        }
-                    }
+                    processRequest(requestMsg);
                 }
             }
             else
@@ -509,6 +658,43 @@ int main(int argc, char** argv)
     stdplus::signal::block(SIGUSR1);
     sdeventplus::source::Signal sigUsr1(
         event, SIGUSR1, std::bind_front(&interruptFlightRecorderCallBack));
+
+    std::unique_ptr<pldm::utils::CustomFD> replaySocket;
+    std::unique_ptr<replay::Replayer> replayer;
+    if (!replayPath.empty())
+    {
+        replaySocket = std::make_unique<pldm::utils::CustomFD>(replayFd);
+        std::ifstream dump(replayPath);
+        if (!dump.is_open())
+        {
+            error("Failed to open the replay file {PATH}", "PATH", replayPath);
+            exit(EXIT_FAILURE);
+        }
+        auto capture = replay::buildCapture(replay::parseRecorderDump(dump));
+        info("Replaying {COUNT} requests from {PATH}", "COUNT",
+             capture.exchanges.size(), "PATH", replayPath);
+        replayer = std::make_unique<replay::Replayer>(
+            event, replayFd, std::move(capture), replaySpeed,
+            std::chrono::milliseconds(RESPONSE_TIME_OUT), [&]() {
+            std::cout << replayer->report().dump(4) << std::endl;
+            event.exit(0);
+        });
+        replayer->start();
+    }
+
+    initGraph.mark("event-loop-setup");
+    initGraph.join();
+    initGraph.report();
+    JsonCache::get().clear();
+
+    auto registryStats =
+        pldm::dbus::CustomDBus::getCustomDBus().getRegistryStats();
+    info(
+        "D-Bus registry holds {INTERFACES} interfaces of {OBJECTS} objects, {PATH_BYTES} path bytes, {TABLE_BYTES} table bytes",
+        "INTERFACES", registryStats.interfaces, "OBJECTS",
+        registryStats.objects, "PATH_BYTES", registryStats.pathBytes,
+        "TABLE_BYTES", registryStats.tableBytes);
+
     returnCode = event.loop();
 
     if (shutdown(sockfd, SHUT_RDWR))
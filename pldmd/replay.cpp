@@ -0,0 +1,425 @@
+#include "replay.hpp"
+
+#include "common/utils.hpp"
+
+#include <sys/socket.h>
+
+#include <phosphor-logging/lg2.hpp>
+
+#include <algorithm>
+#include <ctime>
+#include <iomanip>
+#include <sstream>
+
+PHOSPHOR_LOG2_USING;
+
+namespace pldm
+{
+
+namespace replay
+{
+
+namespace
+{
+
+constexpr uint8_t mctpMsgTypePldm = 1;
+constexpr size_t mctpPrefixSize = 2;
+
+/** @brief Parse the timestamp of a flight recorder record
+ *
+ *  The timestamp is written by pldm::utils::getCurrentSystemTime as
+ *  "YYYY-MM-DD <zone> HH:MM:SS.<microseconds>".
+ *
+ *  @param[in] text - timestamp text
+ *
+ *  @return time since the epoch, std::nullopt if the text is not a timestamp
+ */
+std::optional<std::chrono::microseconds> parseTimestamp(const std::string& text)
+{
+    std::istringstream input(text);
+    std::string date;
+    std::string zone;
+    std::string time;
+    if (!(input >> date >> zone >> time))
+    {
+        return std::nullopt;
+    }
+
+    std::tm tm{};
+    char dot = 0;
+    long micros = 0;
+    std::istringstream dateInput(date + " " + time);
+    dateInput >> std::get_time(&tm, "%Y-%m-%d %H:%M:%S") >> dot >> micros;
+    if (dateInput.fail() || dot != '.')
+    {
+        return std::nullopt;
+    }
+
+    // Only the time between the records matters, the zone does not change
+    // within a dump
+    auto seconds = timegm(&tm);
+    return std::chrono::seconds(seconds) + std::chrono::microseconds(micros);
+}
+
+/** @brief Parse the hex bytes of a flight recorder record
+ *
+ *  @param[in] text - bytes as hex separated by spaces
+ *
+ *  @return the bytes
+ */
+Message parseBytes(const std::string& text)
+{
+    Message data;
+    std::istringstream input(text);
+    unsigned byte = 0;
+    while (input >> std::hex >> byte)
+    {
+        data.emplace_back(static_cast<uint8_t>(byte));
+    }
+    return data;
+}
+
+} // namespace
+
+std::vector<Record> parseRecorderDump(std::istream& input)
+{
+    std::vector<Record> records;
+    std::string header;
+    std::string bytes;
+    while (std::getline(input, header))
+    {
+        auto separator = header.find(" : ");
+        if (separator == std::string::npos)
+        {
+            continue;
+        }
+        bool tx = header.find("Tx :", separator) != std::string::npos;
+        if (!std::getline(input, bytes))
+        {
+            break;
+        }
+
+        auto timestamp = parseTimestamp(header.substr(0, separator));
+        auto data = parseBytes(bytes);
+        if (!timestamp || data.size() < sizeof(pldm_msg_hdr))
+        {
+            // Slot of the recorder that was never written
+            continue;
+        }
+        records.emplace_back(Record{*timestamp, tx, std::move(data)});
+    }
+
+    std::stable_sort(records.begin(), records.end(),
+                     [](const Record& lhs, const Record& rhs) {
+        return lhs.timestamp < rhs.timestamp;
+    });
+    return records;
+}
+
+Capture buildCapture(const std::vector<Record>& records)
+{
+    Capture capture;
+    std::optional<std::chrono::microseconds> firstRequest;
+
+    // Index of the last request waiting for the response, by instance ID,
+    // PLDM type and command
+    std::map<std::tuple<uint8_t, uint8_t, uint8_t>, size_t> unanswered;
+
+    for (const auto& record : records)
+    {
+        if (record.tx)
+        {
+            // Messages sent by pldmd are recorded without the MCTP prefix
+            auto hdr =
+                reinterpret_cast<const pldm_msg_hdr*>(record.data.data());
+            if (hdr->request)
+            {
+                continue;
+            }
+            auto search = unanswered.find(
+                std::make_tuple(static_cast<uint8_t>(hdr->instance_id),
+                                static_cast<uint8_t>(hdr->type),
+                                static_cast<uint8_t>(hdr->command)));
+            if (search != unanswered.end())
+            {
+                capture.exchanges[search->second].expectedResponse =
+                    record.data;
+                unanswered.erase(search);
+            }
+            continue;
+        }
+
+        if (record.data.size() < mctpPrefixSize + sizeof(pldm_msg_hdr) ||
+            record.data[1] != mctpMsgTypePldm)
+        {
+            continue;
+        }
+        auto hdr = reinterpret_cast<const pldm_msg_hdr*>(record.data.data() +
+                                                         mctpPrefixSize);
+        if (!hdr->request)
+        {
+            // Response of a remote endpoint to a request of pldmd
+            capture.responses[{hdr->type, hdr->command}].emplace_back(
+                record.data.begin() + mctpPrefixSize, record.data.end());
+            continue;
+        }
+
+        if (!firstRequest)
+        {
+            firstRequest = record.timestamp;
+        }
+        unanswered[std::make_tuple(static_cast<uint8_t>(hdr->instance_id),
+                                   static_cast<uint8_t>(hdr->type),
+                                   static_cast<uint8_t>(hdr->command))] =
+            capture.exchanges.size();
+        capture.exchanges.emplace_back(
+            Exchange{record.timestamp - *firstRequest, record.data, {}});
+    }
+    return capture;
+}
+
+Replayer::Replayer(sdeventplus::Event& event, int fd, Capture&& capture,
+                   double speed, std::chrono::milliseconds timeout,
+                   std::function<void()> done) :
+    event(event),
+    fd(fd), capture(std::move(capture)), speed(speed), timeout(timeout),
+    done(std::move(done)), timer(event.get(), [this] { process(); })
+{}
+
+void Replayer::start()
+{
+    io = std::make_unique<sdeventplus::source::IO>(
+        event, fd, EPOLLIN,
+        [this](sdeventplus::source::IO& source, int fd, uint32_t revents) {
+        if (!(revents & EPOLLIN))
+        {
+            return;
+        }
+        ssize_t peekedLength = recv(fd, nullptr, 0, MSG_PEEK | MSG_TRUNC);
+        if (peekedLength <= 0)
+        {
+            error("Replay socket closed or failed, RC={RC}", "RC",
+                  peekedLength);
+            source.set_enabled(sdeventplus::source::Enabled::Off);
+            return;
+        }
+        Message message(peekedLength);
+        if (recv(fd, message.data(), message.size(), 0) != peekedLength)
+        {
+            error("Failure to read the replayed message");
+            return;
+        }
+        handleMessage(message);
+    });
+
+    startTime = Clock::now();
+    nextExchange = 0;
+    process();
+}
+
+Replayer::PendingKey Replayer::pendingKey(const Message& message)
+{
+    auto hdr = reinterpret_cast<const pldm_msg_hdr*>(message.data() +
+                                                     mctpPrefixSize);
+    return std::make_tuple(message[0], static_cast<uint8_t>(hdr->instance_id),
+                           static_cast<uint8_t>(hdr->type),
+                           static_cast<uint8_t>(hdr->command));
+}
+
+void Replayer::process()
+{
+    auto now = Clock::now();
+
+    for (auto it = pending.begin(); it != pending.end();)
+    {
+        if (it->second.deadline > now)
+        {
+            ++it;
+            continue;
+        }
+        const auto& request = capture.exchanges[it->second.exchange].request;
+        auto hdr = reinterpret_cast<const pldm_msg_hdr*>(request.data() +
+                                                         mctpPrefixSize);
+        stats[{hdr->type, hdr->command}].timeouts++;
+        it = pending.erase(it);
+    }
+
+    while (nextExchange < capture.exchanges.size())
+    {
+        const auto& exchange = capture.exchanges[nextExchange];
+        if (speed > 0)
+        {
+            auto due = startTime +
+                       std::chrono::duration_cast<Clock::duration>(
+                           exchange.offset / speed);
+            if (due > now)
+            {
+                break;
+            }
+        }
+        else if (!pending.empty())
+        {
+            break;
+        }
+
+        // A request can only be sent once the response of the earlier
+        // request with the same instance ID has arrived
+        auto key = pendingKey(exchange.request);
+        if (pending.contains(key))
+        {
+            break;
+        }
+
+        if (send(fd, exchange.request.data(), exchange.request.size(), 0) < 0)
+        {
+            error("Failed to send the replayed request, ERRNO={ERRNO}",
+                  "ERRNO", errno);
+        }
+        auto hdr = reinterpret_cast<const pldm_msg_hdr*>(
+            exchange.request.data() + mctpPrefixSize);
+        stats[{hdr->type, hdr->command}].requests++;
+        pending.emplace(key, Pending{nextExchange, now, now + timeout});
+        ++nextExchange;
+    }
+
+    if (finished())
+    {
+        timer.stop();
+        endTime = now;
+        if (done)
+        {
+            done();
+        }
+        return;
+    }
+
+    auto wakeUp = Clock::time_point::max();
+    for (const auto& [key, request] : pending)
+    {
+        wakeUp = std::min(wakeUp, request.deadline);
+    }
+    if (speed > 0 && nextExchange < capture.exchanges.size())
+    {
+        wakeUp = std::min(
+            wakeUp, startTime + std::chrono::duration_cast<Clock::duration>(
+                                    capture.exchanges[nextExchange].offset /
+                                    speed));
+    }
+    if (wakeUp != Clock::time_point::max())
+    {
+        timer.start(std::chrono::duration_cast<std::chrono::microseconds>(
+            std::max(wakeUp - now, Clock::duration::zero())));
+    }
+}
+
+void Replayer::handleMessage(const Message& message)
+{
+    if (message.size() < mctpPrefixSize + sizeof(pldm_msg_hdr) ||
+        message[1] != mctpMsgTypePldm)
+    {
+        return;
+    }
+    auto hdr = reinterpret_cast<const pldm_msg_hdr*>(message.data() +
+                                                     mctpPrefixSize);
+    if (hdr->request)
+    {
+        answerRequest(message);
+        return;
+    }
+
+    auto search = pending.find(pendingKey(message));
+    if (search == pending.end())
+    {
+        // Response after the request timed out
+        return;
+    }
+
+    auto& commandStats = stats[{hdr->type, hdr->command}];
+    commandStats.latencies.emplace_back(
+        std::chrono::duration<double, std::micro>(Clock::now() -
+                                                  search->second.sent)
+            .count());
+
+    const auto& expected =
+        capture.exchanges[search->second.exchange].expectedResponse;
+    if (expected.empty())
+    {
+        commandStats.unchecked++;
+    }
+    else if (std::equal(message.begin() + mctpPrefixSize, message.end(),
+                        expected.begin(), expected.end()))
+    {
+        commandStats.matched++;
+    }
+    else
+    {
+        commandStats.mismatched++;
+    }
+    pending.erase(search);
+
+    process();
+}
+
+void Replayer::answerRequest(const Message& message)
+{
+    auto hdr = reinterpret_cast<const pldm_msg_hdr*>(message.data() +
+                                                     mctpPrefixSize);
+    auto search = capture.responses.find({hdr->type, hdr->command});
+    if (search == capture.responses.end() || search->second.empty())
+    {
+        unansweredRequests++;
+        return;
+    }
+
+    Message response(message.begin(), message.begin() + mctpPrefixSize);
+    response.insert(response.end(), search->second.front().begin(),
+                    search->second.front().end());
+    search->second.pop_front();
+
+    auto responseHdr =
+        reinterpret_cast<pldm_msg_hdr*>(response.data() + mctpPrefixSize);
+    responseHdr->instance_id = hdr->instance_id;
+    if (send(fd, response.data(), response.size(), 0) < 0)
+    {
+        error("Failed to send the recorded response, ERRNO={ERRNO}", "ERRNO",
+              errno);
+    }
+}
+
+nlohmann::ordered_json Replayer::report() const
+{
+    nlohmann::ordered_json commands = nlohmann::ordered_json::array();
+    for (const auto& [typeCommand, commandStats] : stats)
+    {
+        auto latencies = commandStats.latencies;
+        std::sort(latencies.begin(), latencies.end());
+
+        nlohmann::ordered_json entry;
+        entry["PLDMType"] = typeCommand.first;
+        entry["Command"] = typeCommand.second;
+        entry["Requests"] = commandStats.requests;
+        entry["Matched"] = commandStats.matched;
+        entry["Mismatched"] = commandStats.mismatched;
+        entry["Unchecked"] = commandStats.unchecked;
+        entry["Timeouts"] = commandStats.timeouts;
+        entry["LatencyUs"] = {
+            {"P50", pldm::utils::percentileOf(latencies, 50)},
+            {"P99", pldm::utils::percentileOf(latencies, 99)},
+            {"Max", latencies.empty() ? 0 : latencies.back()}};
+        commands.emplace_back(std::move(entry));
+    }
+
+    nlohmann::ordered_json data;
+    data["Requests"] = capture.exchanges.size();
+    data["DurationSeconds"] =
+        std::chrono::duration<double>((finished() ? endTime : Clock::now()) -
+                                      startTime)
+            .count();
+    data["UnansweredRequests"] = unansweredRequests;
+    data["Commands"] = commands;
+    return data;
+}
+
+} // namespace replay
+
+} // namespace pldm
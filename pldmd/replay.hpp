@@ -0,0 +1,218 @@
+#pragma once
+
+#include "libpldm/base.h"
+
+#include <sdbusplus/timer.hpp>
+#include <sdeventplus/event.hpp>
+#include <sdeventplus/source/io.hpp>
+
+#include <chrono>
+#include <deque>
+#include <functional>
+#include <istream>
+#include <map>
+#include <memory>
+#include <nlohmann/json.hpp>
+#include <optional>
+#include <tuple>
+#include <vector>
+
+namespace pldm
+{
+
+namespace replay
+{
+
+using Clock = std::chrono::steady_clock;
+using Message = std::vector<uint8_t>;
+using TypeCommand = std::pair<uint8_t, uint8_t>;
+
+/** @struct Record
+ *
+ *  A message of a flight recorder dump
+ */
+struct Record
+{
+    std::chrono::microseconds timestamp; //!< time the message was recorded
+    bool tx;                             //!< message was sent by pldmd
+    Message data;                        //!< recorded message bytes
+};
+
+/** @struct Exchange
+ *
+ *  A request received by pldmd and the response pldmd sent for it
+ */
+struct Exchange
+{
+    std::chrono::microseconds offset; //!< time since the first request
+    Message request;          //!< request prefixed with EID and MCTP type
+    Message expectedResponse; //!< recorded response, empty if not recorded
+};
+
+/** @struct Capture
+ *
+ *  Message stream of a flight recorder dump, ready to be replayed
+ */
+struct Capture
+{
+    /** @brief requests to pldmd in the order they were received */
+    std::vector<Exchange> exchanges;
+
+    /** @brief responses of the remote endpoints to the requests sent by
+     *         pldmd, used to answer pldmd during the replay
+     */
+    std::map<TypeCommand, std::deque<Message>> responses;
+};
+
+/** @brief Parse the dump written by FlightRecorder::playRecorder
+ *
+ *  @param[in] input - flight recorder dump
+ *
+ *  @return the recorded messages sorted by time, empty slots of the
+ *          recorder are skipped
+ */
+std::vector<Record> parseRecorderDump(std::istream& input);
+
+/** @brief Pair the requests received by pldmd with the recorded responses
+ *
+ *  @param[in] records - recorded messages sorted by time
+ *
+ *  @return the capture to replay
+ */
+Capture buildCapture(const std::vector<Record>& records);
+
+/** @class Replayer
+ *
+ *  Replayer sends the requests of a capture on a socket connected to the
+ *  responder, at the recorded timing scaled by a speed factor, and checks
+ *  the responses against the recorded responses. Requests sent by the
+ *  responder are answered with the recorded responses of the same PLDM type
+ *  and command. The latency of the responses is collected per PLDM type and
+ *  command.
+ */
+class Replayer
+{
+  public:
+    Replayer() = delete;
+    Replayer(const Replayer&) = delete;
+    Replayer(Replayer&&) = delete;
+    Replayer& operator=(const Replayer&) = delete;
+    Replayer& operator=(Replayer&&) = delete;
+    ~Replayer() = default;
+
+    /** @brief Constructor
+     *
+     *  @param[in] event - reference to the PLDM daemon's main event loop
+     *  @param[in] fd - socket connected to the responder
+     *  @param[in] capture - message stream to replay
+     *  @param[in] speed - factor the recorded timing is sped up by, 0 sends
+     *                     the next request once the previous one is done
+     *  @param[in] timeout - time to wait for a response
+     *  @param[in] done - called when all the requests are done
+     */
+    explicit Replayer(sdeventplus::Event& event, int fd, Capture&& capture,
+                      double speed, std::chrono::milliseconds timeout,
+                      std::function<void()> done);
+
+    /** @brief Start sending the requests */
+    void start();
+
+    /** @brief Check if all the requests are done */
+    bool finished() const
+    {
+        return nextExchange == capture.exchanges.size() && pending.empty();
+    }
+
+    /** @brief Report of the replay
+     *
+     *  @return per command counts of the matched, mismatched and missing
+     *          responses and the latency distribution in microseconds
+     */
+    nlohmann::ordered_json report() const;
+
+  private:
+    using PendingKey = std::tuple<uint8_t, uint8_t, uint8_t, uint8_t>;
+
+    /** @struct Pending
+     *
+     *  Request waiting for the response
+     */
+    struct Pending
+    {
+        size_t exchange;            //!< index of the exchange
+        Clock::time_point sent;     //!< time the request was sent
+        Clock::time_point deadline; //!< time the request times out
+    };
+
+    /** @struct CommandStats
+     *
+     *  Results of the replay for a PLDM type and command
+     */
+    struct CommandStats
+    {
+        uint64_t requests = 0;
+        uint64_t matched = 0;
+        uint64_t mismatched = 0;
+        uint64_t unchecked = 0;
+        uint64_t timeouts = 0;
+        std::vector<double> latencies;
+    };
+
+    /** @brief Key of a request in flight
+     *
+     *  @param[in] message - message prefixed with EID and MCTP type
+     *
+     *  @return EID, instance ID, PLDM type and command of the message
+     */
+    static PendingKey pendingKey(const Message& message);
+
+    /** @brief Send the requests that are due, expire the requests without a
+     *         response and arm the timer for the next step
+     */
+    void process();
+
+    /** @brief Handle a message from the responder
+     *
+     *  @param[in] message - message prefixed with EID and MCTP type
+     */
+    void handleMessage(const Message& message);
+
+    /** @brief Answer a request sent by the responder from the capture
+     *
+     *  @param[in] message - request prefixed with EID and MCTP type
+     */
+    void answerRequest(const Message& message);
+
+    sdeventplus::Event& event;
+    int fd;
+    Capture capture;
+    double speed;
+    std::chrono::milliseconds timeout;
+    std::function<void()> done;
+
+    /** @brief reads the messages from the responder */
+    std::unique_ptr<sdeventplus::source::IO> io;
+
+    /** @brief fires when the next request is due or times out */
+    phosphor::Timer timer;
+
+    /** @brief time the replay started and finished */
+    Clock::time_point startTime;
+    Clock::time_point endTime;
+
+    /** @brief index of the next exchange to send */
+    size_t nextExchange = 0;
+
+    /** @brief requests waiting for the response */
+    std::map<PendingKey, Pending> pending;
+
+    /** @brief results per PLDM type and command */
+    std::map<TypeCommand, CommandStats> stats;
+
+    /** @brief requests of the responder without a recorded response */
+    uint64_t unansweredRequests = 0;
+};
+
+} // namespace replay
+
+} // namespace pldm
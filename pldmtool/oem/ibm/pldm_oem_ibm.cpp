@@ -206,6 +206,8 @@ class GetFileTable : public CommandInterface
 
 void registerCommand(CLI::App& app)
 {
+    commands.clear();
+
     auto oem_ibm = app.add_subcommand("oem-ibm", "oem type command");
     oem_ibm->require_subcommand(1);
 
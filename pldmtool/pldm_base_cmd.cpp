@@ -347,6 +347,8 @@ class GetPLDMCommands : public CommandInterface
 
 void registerCommand(CLI::App& app)
 {
+    commands.clear();
+
     auto base = app.add_subcommand("base", "base type command");
     base->require_subcommand(1);
 
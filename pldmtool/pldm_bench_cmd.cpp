@@ -0,0 +1,904 @@
+#include "pldm_bench_cmd.hpp"
+
+#include "pldm_cmd_helper.hpp"
+
+#include <poll.h>
+
+#include <phosphor-logging/lg2.hpp>
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <numeric>
+#include <optional>
+#include <sstream>
+#include <thread>
+
+PHOSPHOR_LOG2_USING;
+
+namespace pldmtool
+{
+
+namespace bench
+{
+
+namespace
+{
+
+using namespace pldmtool::helper;
+using namespace pldm::utils;
+using Clock = std::chrono::steady_clock;
+
+/** @brief Time the instance IDs reserved with pldmd are used for new requests,
+ *         the requests sent last have the rest of the pldmd expiration
+ *         interval to complete before pldmd can hand the IDs out again
+ */
+constexpr auto reservationLifetime =
+    std::chrono::seconds(INSTANCE_ID_EXPIRATION_INTERVAL) / 2;
+
+/** @brief Kind of the requests generated by a workload */
+enum class WorkloadType
+{
+    GetPDR,
+    GetStateSensorReadings,
+    GetBIOSTable,
+    GetFRURecordTable,
+    Raw,
+};
+
+/** @struct Workload
+ *
+ *  One entry of the request mix, parsed from the --workload option. The
+ *  latencies of the responses are kept per workload for the report.
+ */
+struct Workload
+{
+    std::string name;
+    WorkloadType type;
+    uint16_t sensorId = 0;
+    uint8_t tableType = PLDM_BIOS_STRING_TABLE;
+    std::vector<uint8_t> rawData;
+    uint32_t nextRecordHandle = 0;
+    uint64_t errors = 0;
+    std::vector<double> latencies;
+};
+
+/** @struct InFlight
+ *
+ *  Request waiting for its response, indexed by the instance ID
+ */
+struct InFlight
+{
+    bool active = false;
+    bool timedOut = false;
+    size_t workload = 0;
+    bool measured = false;
+    Clock::time_point start;
+    Clock::time_point deadline;
+};
+
+/** @brief Parse a workload of the request mix
+ *
+ *  The format is <name>[:<argument>][*<weight>], where name is one of
+ *  getpdr, statesensor:<sensor id>, biostable:<table type>, frutable and
+ *  raw:<comma separated request bytes>.
+ *
+ *  @param[in] spec - workload specification
+ *  @param[out] weight - number of slots of the workload in the mix
+ *
+ *  @return the workload, std::nullopt if the specification is invalid
+ */
+std::optional<Workload> parseWorkload(const std::string& spec, size_t& weight)
+{
+    std::string name = spec;
+    weight = 1;
+    auto star = name.rfind('*');
+    if (star != std::string::npos)
+    {
+        try
+        {
+            weight = std::stoul(name.substr(star + 1), nullptr, 0);
+        }
+        catch (const std::exception&)
+        {
+            return std::nullopt;
+        }
+        name.resize(star);
+    }
+
+    std::string argument;
+    auto colon = name.find(':');
+    if (colon != std::string::npos)
+    {
+        argument = name.substr(colon + 1);
+        name.resize(colon);
+    }
+
+    Workload workload{};
+    workload.name = spec.substr(0, star);
+    try
+    {
+        if (name == "getpdr")
+        {
+            workload.type = WorkloadType::GetPDR;
+        }
+        else if (name == "statesensor")
+        {
+            workload.type = WorkloadType::GetStateSensorReadings;
+            workload.sensorId = std::stoul(argument, nullptr, 0);
+        }
+        else if (name == "biostable")
+        {
+            workload.type = WorkloadType::GetBIOSTable;
+            if (!argument.empty())
+            {
+                workload.tableType = std::stoul(argument, nullptr, 0);
+            }
+        }
+        else if (name == "frutable")
+        {
+            workload.type = WorkloadType::GetFRURecordTable;
+        }
+        else if (name == "raw")
+        {
+            workload.type = WorkloadType::Raw;
+            std::stringstream bytes(argument);
+            std::string byte;
+            while (std::getline(bytes, byte, ','))
+            {
+                workload.rawData.emplace_back(std::stoul(byte, nullptr, 0));
+            }
+            if (workload.rawData.size() < sizeof(pldm_msg_hdr))
+            {
+                return std::nullopt;
+            }
+        }
+        else
+        {
+            return std::nullopt;
+        }
+    }
+    catch (const std::exception&)
+    {
+        return std::nullopt;
+    }
+    return workload;
+}
+
+/** @brief Summary of the latencies in microseconds
+ *
+ *  @param[in] samples - latencies, sorted by this function
+ *
+ *  @return JSON object with the latency distribution
+ */
+ordered_json latencySummary(std::vector<double>& samples)
+{
+    std::sort(samples.begin(), samples.end());
+    double sum = 0;
+    for (const auto& sample : samples)
+    {
+        sum += sample;
+    }
+
+    ordered_json summary;
+    summary["Min"] = samples.empty() ? 0 : samples.front();
+    summary["Mean"] = samples.empty() ? 0 : sum / samples.size();
+    summary["P50"] = percentileOf(samples, 50);
+    summary["P99"] = percentileOf(samples, 99);
+    summary["P999"] = percentileOf(samples, 99.9);
+    summary["Max"] = samples.empty() ? 0 : samples.back();
+    return summary;
+}
+
+/** @brief Stand-in for pldmd on one end of a socketpair, answers every
+ *         request with a success completion code until the socket is closed
+ *
+ *  @param[in] fd - responder end of the socketpair
+ */
+void standInResponder(int fd)
+{
+    std::vector<uint8_t> buffer(UINT16_MAX);
+    while (true)
+    {
+        auto length = recv(fd, buffer.data(), buffer.size(), 0);
+        if (length <= 0)
+        {
+            break;
+        }
+        if (static_cast<size_t>(length) < 2 + sizeof(pldm_msg_hdr))
+        {
+            continue;
+        }
+
+        // EID and MCTP message type are echoed, the PLDM header is turned
+        // into a response header
+        std::vector<uint8_t> response(
+            buffer.begin(), buffer.begin() + 2 + sizeof(pldm_msg_hdr));
+        auto hdr = reinterpret_cast<pldm_msg_hdr*>(&response[2]);
+        hdr->request = PLDM_RESPONSE;
+        hdr->datagram = 0;
+        response.emplace_back(PLDM_SUCCESS);
+        if (send(fd, response.data(), response.size(), 0) < 0)
+        {
+            break;
+        }
+    }
+    close(fd);
+}
+
+class Bench
+{
+  public:
+    Bench() = delete;
+    Bench(const Bench&) = delete;
+    Bench(Bench&&) = delete;
+    Bench& operator=(const Bench&) = delete;
+    Bench& operator=(Bench&&) = delete;
+    ~Bench() = default;
+
+    explicit Bench(CLI::App* app)
+    {
+        app->add_option("-m,--mctp_eid", mctp_eid, "MCTP endpoint ID");
+        app->add_option(
+               "-w,--workload", workloadSpecs,
+               "request mix, each entry is <name>[:<arg>][*<weight>] where "
+               "name is getpdr, statesensor:<sensor id>, biostable:<table "
+               "type>, frutable or raw:<comma separated request bytes>")
+            ->expected(-1);
+        app->add_option("-n,--count", count,
+                        "number of measured requests, default 1000");
+        app->add_option("-d,--duration", duration,
+                        "run for the given seconds instead of a request "
+                        "count");
+        app->add_option("-c,--concurrency", concurrency,
+                        "closed loop: requests kept in flight, open loop: "
+                        "most requests in flight, 1 to 32")
+            ->check(CLI::Range(1, static_cast<int>(maxInstanceIds)));
+        app->add_option("-r,--rate", rate,
+                        "open loop: requests per second, latency is measured "
+                        "from the scheduled send time");
+        app->add_option("-t,--timeout", timeoutMs,
+                        "response timeout in milliseconds, default 2000");
+        app->add_option("--warmup", warmup,
+                        "requests sent before the measurement starts");
+        app->add_flag("-s,--socketpair", useSocketPair,
+                      "answer the requests by a local stand-in responder "
+                      "instead of pldmd, to measure the tool overhead");
+        app->add_flag("-v, --verbose", pldmVerbose);
+        app->callback([&]() { exec(); });
+    }
+
+    void exec()
+    {
+        if (!parseWorkloads())
+        {
+            return;
+        }
+
+        std::thread responder;
+        if (useSocketPair)
+        {
+            int fds[2];
+            if (socketpair(AF_UNIX, SOCK_SEQPACKET, 0, fds) < 0)
+            {
+                error("Failed to create the socketpair : RC = {KEY0}", "KEY0",
+                      -errno);
+                return;
+            }
+            fd = fds[0];
+            responder = std::thread(standInResponder, fds[1]);
+
+            // The stand-in responder shares the instance IDs with nobody
+            instanceIds.resize(concurrency);
+            std::iota(instanceIds.begin(), instanceIds.end(), 0);
+            nextInstanceId = 0;
+        }
+        else
+        {
+            fd = Session::getSession().getMuxFd(pldmVerbose);
+            if (fd < 0 || !reserveInstanceIds())
+            {
+                return;
+            }
+        }
+
+        auto elapsed = run();
+
+        if (useSocketPair)
+        {
+            shutdown(fd, SHUT_RDWR);
+            responder.join();
+            close(fd);
+        }
+        fd = -1;
+
+        report(elapsed);
+    }
+
+  private:
+    /** @brief Build the request mix from the --workload options
+     *
+     *  @return true on success
+     */
+    bool parseWorkloads()
+    {
+        if (workloadSpecs.empty())
+        {
+            workloadSpecs.emplace_back("getpdr");
+        }
+
+        workloads.clear();
+        schedule.clear();
+        for (const auto& spec : workloadSpecs)
+        {
+            size_t weight = 1;
+            auto workload = parseWorkload(spec, weight);
+            if (!workload)
+            {
+                std::cerr << "Invalid workload " << spec << std::endl;
+                return false;
+            }
+            workloads.emplace_back(std::move(*workload));
+            schedule.insert(schedule.end(), weight, workloads.size() - 1);
+        }
+        if (schedule.empty())
+        {
+            std::cerr << "The request mix has no requests" << std::endl;
+            return false;
+        }
+        return true;
+    }
+
+    /** @brief Encode the next request of a workload
+     *
+     *  @param[in] workload - workload of the request
+     *  @param[in] instanceId - PLDM instance ID of the request
+     *  @param[out] requestMsg - request prefixed with the EID and the MCTP
+     *                           message type
+     *
+     *  @return PLDM_SUCCESS on success, the encoder error otherwise
+     */
+    int encodeRequest(const Workload& workload, uint8_t instanceId,
+                      std::vector<uint8_t>& requestMsg)
+    {
+        size_t payloadLength = 0;
+        switch (workload.type)
+        {
+            case WorkloadType::GetPDR:
+                payloadLength = PLDM_GET_PDR_REQ_BYTES;
+                break;
+            case WorkloadType::GetStateSensorReadings:
+                payloadLength = PLDM_GET_STATE_SENSOR_READINGS_REQ_BYTES;
+                break;
+            case WorkloadType::GetBIOSTable:
+                payloadLength = PLDM_GET_BIOS_TABLE_REQ_BYTES;
+                break;
+            case WorkloadType::GetFRURecordTable:
+                payloadLength = PLDM_GET_FRU_RECORD_TABLE_REQ_BYTES;
+                break;
+            case WorkloadType::Raw:
+                payloadLength = workload.rawData.size() - sizeof(pldm_msg_hdr);
+                break;
+        }
+
+        requestMsg.assign(2 + sizeof(pldm_msg_hdr) + payloadLength, 0);
+        requestMsg[0] = mctp_eid;
+        requestMsg[1] = MCTP_MSG_TYPE_PLDM;
+        auto request = reinterpret_cast<pldm_msg*>(&requestMsg[2]);
+
+        int rc = PLDM_SUCCESS;
+        switch (workload.type)
+        {
+            case WorkloadType::GetPDR:
+                rc = encode_get_pdr_req(instanceId, workload.nextRecordHandle,
+                                        0, PLDM_GET_FIRSTPART, UINT16_MAX, 0,
+                                        request, PLDM_GET_PDR_REQ_BYTES);
+                break;
+            case WorkloadType::GetStateSensorReadings:
+            {
+                bitfield8_t rearm{};
+                rc = encode_get_state_sensor_readings_req(
+                    instanceId, workload.sensorId, rearm, 0, request);
+                break;
+            }
+            case WorkloadType::GetBIOSTable:
+                rc = encode_get_bios_table_req(
+                    instanceId, 0, PLDM_GET_FIRSTPART, workload.tableType,
+                    request);
+                break;
+            case WorkloadType::GetFRURecordTable:
+                rc = encode_get_fru_record_table_req(
+                    instanceId, 0, PLDM_START_AND_END, request, payloadLength);
+                break;
+            case WorkloadType::Raw:
+                std::copy(workload.rawData.begin(), workload.rawData.end(),
+                          requestMsg.begin() + 2);
+                request->hdr.instance_id = instanceId;
+                break;
+        }
+        return rc;
+    }
+
+    /** @brief Send the request of the next slot of the mix
+     *
+     *  @param[in] instanceId - free PLDM instance ID
+     *  @param[in] start - time the latency is measured from
+     *
+     *  @return true if the request was sent
+     */
+    bool issue(uint8_t instanceId, Clock::time_point start)
+    {
+        auto index = schedule[issued % schedule.size()];
+        auto& workload = workloads[index];
+
+        std::vector<uint8_t> requestMsg;
+        auto rc = encodeRequest(workload, instanceId, requestMsg);
+        if (rc != PLDM_SUCCESS)
+        {
+            error("Failed to encode the {KEY0} request, rc = {KEY1}", "KEY0",
+                  workload.name, "KEY1", rc);
+            return false;
+        }
+        if (pldmVerbose)
+        {
+            std::cout << "pldmtool: ";
+            printBuffer(Tx, requestMsg);
+        }
+
+        if (send(fd, requestMsg.data(), requestMsg.size(), 0) < 0)
+        {
+            error("Write to socket failure : RC = {KEY0}", "KEY0", -errno);
+            return false;
+        }
+
+        auto& entry = inFlight[instanceId];
+        entry.active = true;
+        entry.timedOut = false;
+        entry.workload = index;
+        entry.measured = issued >= warmup;
+        entry.start = start;
+        entry.deadline = Clock::now() + std::chrono::milliseconds(timeoutMs);
+        ++issued;
+        ++outstanding;
+        return true;
+    }
+
+    /** @brief Reserve with pldmd the instance IDs for the requests in flight
+     *
+     *  @return false if pldmd reserved none
+     */
+    bool reserveInstanceIds()
+    {
+        instanceIds = Session::getSession().reserveInstanceIds(
+            mctp_eid, static_cast<uint8_t>(concurrency));
+        reservedAt = Clock::now();
+        nextInstanceId = 0;
+        if (instanceIds.empty())
+        {
+            error("Failed to reserve instance IDs, MCTP id = {KEY0}", "KEY0",
+                  (unsigned)mctp_eid);
+            return false;
+        }
+        if (instanceIds.size() < concurrency)
+        {
+            info("Reserved {KEY0} of {KEY1} instance IDs, MCTP id = {KEY2}",
+                 "KEY0", instanceIds.size(), "KEY1", concurrency, "KEY2",
+                 (unsigned)mctp_eid);
+        }
+        return true;
+    }
+
+    /** @brief Reserve new instance IDs once the reserved ones are used for
+     *         the reservation lifetime
+     *
+     *  The old IDs of the requests still in flight stay in use until their
+     *  response or timeout, pldmd does not hand them out before they expire.
+     *
+     *  @param[in] now - current time
+     *
+     *  @return false if pldmd reserved none
+     */
+    bool renewInstanceIds(Clock::time_point now)
+    {
+        if (useSocketPair || now - reservedAt < reservationLifetime)
+        {
+            return true;
+        }
+        return reserveInstanceIds();
+    }
+
+    /** @brief Find a free instance ID, the reserved IDs are used in sequence
+     *
+     *  @return the instance ID, std::nullopt if all the IDs are in flight
+     */
+    std::optional<uint8_t> freeInstanceId()
+    {
+        for (size_t i = 0; i < instanceIds.size(); ++i)
+        {
+            auto index = (nextInstanceId + i) % instanceIds.size();
+            auto id = instanceIds[index];
+            if (!inFlight[id].active)
+            {
+                nextInstanceId = (index + 1) % instanceIds.size();
+                return id;
+            }
+        }
+        return std::nullopt;
+    }
+
+    /** @brief Process a message received on the socket
+     *
+     *  @param[in] responseMsg - message prefixed with the EID and the MCTP
+     *                           message type
+     */
+    void complete(const std::vector<uint8_t>& responseMsg)
+    {
+        if (responseMsg.size() < 2 + sizeof(pldm_msg_hdr))
+        {
+            return;
+        }
+        auto response = reinterpret_cast<const pldm_msg*>(&responseMsg[2]);
+        auto& entry = inFlight[response->hdr.instance_id];
+        if (response->hdr.request == PLDM_REQUEST || !entry.active)
+        {
+            return;
+        }
+
+        entry.active = false;
+        if (entry.timedOut)
+        {
+            // Late response of a request already counted as timed out, the
+            // instance ID can be used again
+            return;
+        }
+        --outstanding;
+
+        auto latency = std::chrono::duration<double, std::micro>(
+                           Clock::now() - entry.start)
+                           .count();
+        auto& workload = workloads[entry.workload];
+        auto payloadLength = responseMsg.size() - 2 - sizeof(pldm_msg_hdr);
+        bool success = payloadLength &&
+                       response->payload[0] == PLDM_SUCCESS;
+
+        if (success && workload.type == WorkloadType::GetPDR)
+        {
+            uint8_t completionCode = 0;
+            uint32_t nextDataTransferHndl = 0;
+            uint8_t transferFlag = 0;
+            uint16_t respCnt = 0;
+            uint8_t transferCRC = 0;
+            auto rc = decode_get_pdr_resp(
+                response, payloadLength, &completionCode,
+                &workload.nextRecordHandle, &nextDataTransferHndl,
+                &transferFlag, &respCnt, recordData.data(), recordData.size(),
+                &transferCRC);
+            if (rc != PLDM_SUCCESS)
+            {
+                // Restart the walk from the first PDR
+                workload.nextRecordHandle = 0;
+            }
+        }
+
+        if (!entry.measured)
+        {
+            return;
+        }
+        ++completed;
+        if (!success)
+        {
+            ++workload.errors;
+        }
+        workload.latencies.emplace_back(latency);
+    }
+
+    /** @brief Read the messages queued on the socket
+     *
+     *  @return false if the socket failed
+     */
+    bool receive()
+    {
+        std::vector<uint8_t> responseMsg;
+        while (true)
+        {
+            auto peekedLength = recv(fd, nullptr, 0,
+                                     MSG_PEEK | MSG_TRUNC | MSG_DONTWAIT);
+            if (peekedLength < 0)
+            {
+                if (errno == EAGAIN || errno == EWOULDBLOCK)
+                {
+                    return true;
+                }
+                error("recv() system call failed : RC = {KEY0}", "KEY0",
+                      -errno);
+                return false;
+            }
+            if (peekedLength == 0)
+            {
+                error("Socket is closed");
+                return false;
+            }
+
+            responseMsg.resize(peekedLength);
+            auto length = recv(fd, responseMsg.data(), responseMsg.size(),
+                               MSG_DONTWAIT);
+            if (length != peekedLength)
+            {
+                error("Failure to read response length packet: length = "
+                      "{KEY0}",
+                      "KEY0", length);
+                return false;
+            }
+            if (pldmVerbose)
+            {
+                std::cout << "pldmtool: ";
+                printBuffer(Rx, responseMsg);
+            }
+            complete(responseMsg);
+        }
+    }
+
+    /** @brief Expire the requests past their deadline
+     *
+     *  A timed out request keeps its instance ID for another timeout period,
+     *  so that a late response is not taken for the response of a new
+     *  request.
+     *
+     *  @param[in] now - current time
+     */
+    void expire(Clock::time_point now)
+    {
+        for (auto& entry : inFlight)
+        {
+            if (!entry.active || entry.deadline > now)
+            {
+                continue;
+            }
+            if (entry.timedOut)
+            {
+                entry.active = false;
+                continue;
+            }
+            entry.timedOut = true;
+            entry.deadline = now + std::chrono::milliseconds(timeoutMs);
+            --outstanding;
+            if (entry.measured)
+            {
+                ++timeouts;
+            }
+        }
+    }
+
+    /** @brief Earliest deadline of the requests in flight */
+    Clock::time_point nextDeadline() const
+    {
+        auto deadline = Clock::time_point::max();
+        for (const auto& entry : inFlight)
+        {
+            if (entry.active)
+            {
+                deadline = std::min(deadline, entry.deadline);
+            }
+        }
+        return deadline;
+    }
+
+    /** @brief Generate the load and collect the latencies
+     *
+     *  @return duration of the measurement
+     */
+    Clock::duration run()
+    {
+        issued = 0;
+        outstanding = 0;
+        completed = 0;
+        timeouts = 0;
+        inFlight.fill({});
+
+        const uint64_t total = warmup + count;
+        const auto period =
+            rate > 0 ? std::chrono::duration_cast<Clock::duration>(
+                           std::chrono::duration<double>(1.0 / rate))
+                     : Clock::duration::zero();
+        auto measureStart = Clock::now();
+        auto stopAt = Clock::time_point::max();
+        auto nextSend = measureStart;
+        bool measuring = false;
+        bool stopped = false;
+
+        while (true)
+        {
+            auto now = Clock::now();
+            if (!measuring && issued >= warmup && outstanding == 0)
+            {
+                // The warm-up requests are answered, start the measurement
+                measuring = true;
+                measureStart = now;
+                nextSend = now;
+                if (duration > 0)
+                {
+                    stopAt = now + std::chrono::seconds(duration);
+                }
+            }
+
+            auto moreRequests = [&]() {
+                if (!measuring)
+                {
+                    return issued < warmup;
+                }
+                return duration > 0 ? now < stopAt : issued < total;
+            };
+
+            while (!stopped && moreRequests())
+            {
+                if (rate > 0 ? now < nextSend : outstanding >= concurrency)
+                {
+                    break;
+                }
+                if (!renewInstanceIds(now))
+                {
+                    stopped = true;
+                    break;
+                }
+                auto instanceId = freeInstanceId();
+                if (!instanceId)
+                {
+                    break;
+                }
+                if (!issue(*instanceId, rate > 0 ? nextSend : now))
+                {
+                    stopped = true;
+                    break;
+                }
+                nextSend += period;
+            }
+
+            bool more = !stopped && moreRequests();
+            if ((stopped || (measuring && !more)) && outstanding == 0)
+            {
+                break;
+            }
+
+            auto wakeUp = nextDeadline();
+            if (more && rate > 0)
+            {
+                wakeUp = std::min(wakeUp, nextSend);
+            }
+            if (more && measuring && duration > 0)
+            {
+                wakeUp = std::min(wakeUp, stopAt);
+            }
+
+            timespec timeout{};
+            if (wakeUp > now)
+            {
+                auto wait =
+                    std::chrono::duration_cast<std::chrono::nanoseconds>(
+                        std::min<Clock::duration>(wakeUp - now,
+                                                  std::chrono::seconds(1)));
+                timeout.tv_sec = wait.count() / 1000000000;
+                timeout.tv_nsec = wait.count() % 1000000000;
+            }
+            pollfd pfd{fd, POLLIN, 0};
+            auto rc = ppoll(&pfd, 1, &timeout, nullptr);
+            if (rc < 0 && errno != EINTR)
+            {
+                error("ppoll() system call failed : RC = {KEY0}", "KEY0",
+                      -errno);
+                break;
+            }
+            if (rc > 0 && !receive())
+            {
+                break;
+            }
+            expire(Clock::now());
+        }
+        return Clock::now() - measureStart;
+    }
+
+    /** @brief Print the throughput and the latency distribution
+     *
+     *  @param[in] elapsed - duration of the measurement
+     */
+    void report(Clock::duration elapsed)
+    {
+        auto seconds = std::chrono::duration<double>(elapsed).count();
+        ordered_json data;
+        data["Mode"] = rate > 0 ? "open-loop" : "closed-loop";
+        if (rate > 0)
+        {
+            data["TargetRate"] = rate;
+        }
+        else
+        {
+            data["Concurrency"] = concurrency;
+        }
+        data["Transport"] = useSocketPair ? "socketpair" : "mctp-mux";
+        data["Requests"] = issued > warmup ? issued - warmup : 0;
+        data["Completed"] = completed;
+        data["Timeouts"] = timeouts;
+        data["DurationSeconds"] = seconds;
+        data["Throughput"] = seconds > 0 ? completed / seconds : 0;
+
+        std::vector<double> all;
+        uint64_t errors = 0;
+        ordered_json workloadData;
+        for (auto& workload : workloads)
+        {
+            all.insert(all.end(), workload.latencies.begin(),
+                       workload.latencies.end());
+            errors += workload.errors;
+
+            ordered_json entry;
+            entry["Completed"] = workload.latencies.size();
+            entry["Errors"] = workload.errors;
+            entry["LatencyUs"] = latencySummary(workload.latencies);
+            workloadData[workload.name] = entry;
+        }
+        data["Errors"] = errors;
+        data["LatencyUs"] = latencySummary(all);
+        data["Workloads"] = workloadData;
+        DisplayInJson(data);
+    }
+
+    uint8_t mctp_eid = PLDM_ENTITY_ID;
+    std::vector<std::string> workloadSpecs;
+    uint64_t count = 1000;
+    uint32_t duration = 0;
+    uint64_t concurrency = 1;
+    double rate = 0;
+    uint32_t timeoutMs = 2000;
+    uint64_t warmup = 0;
+    bool useSocketPair = false;
+    bool pldmVerbose = false;
+
+    /** @brief socket the requests are sent on */
+    int fd = -1;
+
+    /** @brief workloads of the request mix */
+    std::vector<Workload> workloads;
+
+    /** @brief weighted round robin order of the workloads */
+    std::vector<size_t> schedule;
+
+    /** @brief requests in flight, indexed by the instance ID */
+    std::array<InFlight, maxInstanceIds> inFlight{};
+
+    /** @brief instance IDs reserved for the requests */
+    std::vector<uint8_t> instanceIds;
+
+    /** @brief time the instance IDs were reserved */
+    Clock::time_point reservedAt;
+
+    /** @brief index of the next instance ID to try */
+    size_t nextInstanceId = 0;
+
+    /** @brief requests sent, including the warm-up requests */
+    uint64_t issued = 0;
+
+    /** @brief requests in flight, not counting the timed out requests */
+    uint64_t outstanding = 0;
+
+    /** @brief measured requests answered and timed out */
+    uint64_t completed = 0;
+    uint64_t timeouts = 0;
+
+    /** @brief buffer for the PDR data of the GetPDR responses */
+    std::vector<uint8_t> recordData = std::vector<uint8_t>(UINT16_MAX);
+};
+
+std::unique_ptr<Bench> bench;
+
+} // namespace
+
+void registerCommand(CLI::App& app)
+{
+    auto benchCmd = app.add_subcommand(
+        "bench", "generate load on the PLDM responder and report the "
+                 "throughput and the latency distribution");
+    bench = std::make_unique<Bench>(benchCmd);
+}
+
+} // namespace bench
+
+} // namespace pldmtool
@@ -972,6 +972,8 @@ class SetBIOSAttributeCurrentValue : public GetBIOSTableHandler
 
 void registerCommand(CLI::App& app)
 {
+    commands.clear();
+
     auto bios = app.add_subcommand("bios", "bios type command");
     bios->require_subcommand(1);
     auto getDateTime = bios->add_subcommand("GetDateTime", "get date time");
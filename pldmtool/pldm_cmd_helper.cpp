@@ -9,6 +9,8 @@
 #include <sdbusplus/server.hpp>
 #include <xyz/openbmc_project/Logging/Entry/server.hpp>
 
+#include <algorithm>
+#include <cstring>
 #include <exception>
 
 PHOSPHOR_LOG2_USING;
@@ -20,12 +22,155 @@ namespace pldmtool
 
 namespace helper
 {
+
+namespace
+{
+
+constexpr auto pldmObjPath = "/xyz/openbmc_project/pldm";
+constexpr auto pldmRequester = "xyz.openbmc_project.PLDM.Requester";
+
+} // namespace
+
 /*
- * Initialize the socket, send pldm command & recieve response from socket
+ * Send pldm command & recieve response on the session socket
  *
  */
 int mctpSockSendRecv(const std::vector<uint8_t>& requestMsg,
                      std::vector<uint8_t>& responseMsg, bool pldmVerbose)
+{
+    return Session::getSession().sendRecv(requestMsg, responseMsg,
+                                          pldmVerbose);
+}
+
+Session::~Session()
+{
+    closeMux();
+    if (libpldmFd >= 0)
+    {
+        close(libpldmFd);
+    }
+}
+
+int Session::getInstanceId(uint8_t eid, uint8_t& instanceId)
+{
+    auto ids = reserveInstanceIds(eid, 1);
+    if (ids.empty())
+    {
+        return PLDM_ERROR;
+    }
+    instanceId = ids.front();
+    return PLDM_SUCCESS;
+}
+
+bool Session::findPldmService()
+{
+    if (!pldmService.empty())
+    {
+        return true;
+    }
+
+    try
+    {
+        pldmService = pldm::utils::DBusHandler().getService(pldmObjPath,
+                                                            pldmRequester);
+    }
+    catch (const std::exception& e)
+    {
+        error("Failed to find the PLDM requester service, error = {KEY0}",
+              "KEY0", e.what());
+        return false;
+    }
+    return true;
+}
+
+std::vector<uint8_t> Session::reserveInstanceIds(uint8_t eid, uint8_t count)
+{
+    // Requester.Batch GetInstanceIds reserves at most this many IDs per call
+    static constexpr uint8_t maxBatch = 8;
+    static constexpr auto pldmRequesterBatch =
+        "xyz.openbmc_project.PLDM.Requester.Batch";
+
+    std::vector<uint8_t> ids;
+    if (!findPldmService())
+    {
+        return ids;
+    }
+
+    auto& bus = pldm::utils::DBusHandler::getBus();
+    while (batchReservation && count - ids.size() > 1)
+    {
+        try
+        {
+            uint8_t batch = std::min<size_t>(count - ids.size(), maxBatch);
+            auto method = bus.new_method_call(pldmService.c_str(),
+                                              pldmObjPath, pldmRequesterBatch,
+                                              "GetInstanceIds");
+            method.append(eid, batch);
+            auto reply = bus.call(method, dbusTimeout);
+            std::vector<uint8_t> reserved;
+            reply.read(reserved);
+            ids.insert(ids.end(), reserved.begin(), reserved.end());
+        }
+        catch (const sdbusplus::exception_t& e)
+        {
+            // A pldmd without the batch interface, or short of free IDs for
+            // a batch, reserves one ID per call
+            if (e.name() &&
+                (!std::strcmp(e.name(), SD_BUS_ERROR_UNKNOWN_INTERFACE) ||
+                 !std::strcmp(e.name(), SD_BUS_ERROR_UNKNOWN_METHOD)))
+            {
+                batchReservation = false;
+            }
+            break;
+        }
+    }
+
+    while (ids.size() < count)
+    {
+        try
+        {
+            uint8_t instanceId = 0;
+            auto method = bus.new_method_call(pldmService.c_str(), pldmObjPath,
+                                              pldmRequester, "GetInstanceId");
+            method.append(eid);
+            auto reply = bus.call(method, dbusTimeout);
+            reply.read(instanceId);
+            ids.push_back(instanceId);
+        }
+        catch (const std::exception& e)
+        {
+            error(
+                "GetInstanceId D-Bus call failed, MCTP id = {KEY0}, error = {KEY1}",
+                "KEY0", (unsigned)eid, "KEY1", e.what());
+            break;
+        }
+    }
+    return ids;
+}
+
+int Session::getLibpldmFd()
+{
+    if (libpldmFd < 0)
+    {
+        libpldmFd = pldm_open();
+    }
+    return libpldmFd;
+}
+
+int Session::getMuxFd(bool pldmVerbose)
+{
+    if (muxFd < 0)
+    {
+        auto rc = connectMux(pldmVerbose);
+        if (rc)
+        {
+            return rc;
+        }
+    }
+    return muxFd;
+}
+
+int Session::connectMux(bool pldmVerbose)
 {
     const char devPath[] = "\0mctp-mux";
     int returnCode = 0;
@@ -45,115 +190,129 @@ int mctpSockSendRecv(const std::vector<uint8_t>& requestMsg,
 
     memcpy(addr.sun_path, devPath, sizeof(devPath) - 1);
 
-    CustomFD socketFd(sockFd);
-    int result = connect(socketFd(), reinterpret_cast<struct sockaddr*>(&addr),
+    int result = connect(sockFd, reinterpret_cast<struct sockaddr*>(&addr),
                          sizeof(devPath) + sizeof(addr.sun_family) - 1);
     if (-1 == result)
     {
         returnCode = -errno;
         error("Failed to connect to socket : RC = {KEY0}", "KEY0", returnCode);
-
+        close(sockFd);
         return returnCode;
     }
     Logger(pldmVerbose, "Success in connecting to socket : RC = ", returnCode);
 
     auto pldmType = MCTP_MSG_TYPE_PLDM;
-    result = write(socketFd(), &pldmType, sizeof(pldmType));
+    result = write(sockFd, &pldmType, sizeof(pldmType));
     if (-1 == result)
     {
         returnCode = -errno;
         error("Failed to send message type as pldm to mctp : RC = {KEY0}",
               "KEY0", returnCode);
+        close(sockFd);
         return returnCode;
     }
     Logger(
         pldmVerbose,
         "Success in sending message type as pldm to mctp : RC = ", returnCode);
 
-    result = send(socketFd(), requestMsg.data(), requestMsg.size(), 0);
-    if (-1 == result)
-    {
-        returnCode = -errno;
-        error("Write to socket failure : RC = {KEY0}", "KEY0", returnCode);
-        return returnCode;
-    }
-    Logger(pldmVerbose, "Write to socket successful : RC = ", result);
+    muxFd = sockFd;
+    return PLDM_SUCCESS;
+}
 
-    // Read the response from socket
-    ssize_t peekedLength = recv(socketFd(), nullptr, 0, MSG_TRUNC | MSG_PEEK);
-    if (0 == peekedLength)
+void Session::closeMux()
+{
+    if (muxFd < 0)
     {
-        error("Socket is closed : peekedLength = {KEY0}", "KEY0", peekedLength);
-
-        return returnCode;
+        return;
     }
-    else if (peekedLength <= -1)
+
+    if (-1 == shutdown(muxFd, SHUT_RDWR))
     {
-        returnCode = -errno;
-        error("recv() system call failed : RC = {KEY0}", "KEY0", returnCode);
-        return returnCode;
+        error("Failed to shutdown the socket : RC ={KEY0}", "KEY0", -errno);
     }
-    else
+    close(muxFd);
+    muxFd = -1;
+}
+
+int Session::sendRecv(const std::vector<uint8_t>& requestMsg,
+                      std::vector<uint8_t>& responseMsg, bool pldmVerbose)
+{
+    int returnCode = 0;
+    if (muxFd < 0)
     {
-        auto reqhdr = reinterpret_cast<const pldm_msg_hdr*>(&requestMsg[2]);
-        do
+        returnCode = connectMux(pldmVerbose);
+        if (returnCode)
         {
-            ssize_t peekedLength = recv(socketFd(), nullptr, 0,
-                                        MSG_PEEK | MSG_TRUNC);
-            responseMsg.resize(peekedLength);
-            auto recvDataLength =
-                recv(socketFd(), reinterpret_cast<void*>(responseMsg.data()),
-                     peekedLength, 0);
-            auto resphdr =
-                reinterpret_cast<const pldm_msg_hdr*>(&responseMsg[2]);
-            if (recvDataLength == peekedLength &&
-                resphdr->instance_id == reqhdr->instance_id &&
-                resphdr->request != PLDM_REQUEST)
-            {
-                Logger(pldmVerbose, "Total length:", recvDataLength);
-                break;
-            }
-            else if (recvDataLength != peekedLength)
-            {
-                error("Failure to read response length packet: length = {KEY0}",
-                      "KEY0", recvDataLength);
-                return returnCode;
-            }
-        } while (1);
+            return returnCode;
+        }
     }
 
-    returnCode = shutdown(socketFd(), SHUT_RDWR);
-    if (-1 == returnCode)
+    int result = send(muxFd, requestMsg.data(), requestMsg.size(), 0);
+    if (-1 == result)
     {
         returnCode = -errno;
-        error("Failed to shutdown the socket : RC ={KEY0}", "KEY0", returnCode);
+        error("Write to socket failure : RC = {KEY0}", "KEY0", returnCode);
+        closeMux();
         return returnCode;
     }
+    Logger(pldmVerbose, "Write to socket successful : RC = ", result);
+
+    // Read the response from socket, the messages for the other PLDM
+    // requesters are skipped
+    auto reqhdr = reinterpret_cast<const pldm_msg_hdr*>(&requestMsg[2]);
+    do
+    {
+        ssize_t peekedLength = recv(muxFd, nullptr, 0, MSG_PEEK | MSG_TRUNC);
+        if (0 == peekedLength)
+        {
+            error("Socket is closed : peekedLength = {KEY0}", "KEY0",
+                  peekedLength);
+            closeMux();
+            return -1;
+        }
+        else if (peekedLength <= -1)
+        {
+            returnCode = -errno;
+            error("recv() system call failed : RC = {KEY0}", "KEY0",
+                  returnCode);
+            closeMux();
+            return returnCode;
+        }
+
+        responseMsg.resize(peekedLength);
+        auto recvDataLength = recv(muxFd,
+                                   reinterpret_cast<void*>(responseMsg.data()),
+                                   peekedLength, 0);
+        if (recvDataLength != peekedLength)
+        {
+            error("Failure to read response length packet: length = {KEY0}",
+                  "KEY0", recvDataLength);
+            closeMux();
+            return -1;
+        }
+
+        if (responseMsg.size() < 2 + sizeof(pldm_msg_hdr))
+        {
+            continue;
+        }
+
+        auto resphdr = reinterpret_cast<const pldm_msg_hdr*>(&responseMsg[2]);
+        if (resphdr->instance_id == reqhdr->instance_id &&
+            resphdr->request != PLDM_REQUEST)
+        {
+            Logger(pldmVerbose, "Total length:", recvDataLength);
+            break;
+        }
+    } while (1);
 
-    Logger(pldmVerbose, "Shutdown Socket successful :  RC = ", returnCode);
     return PLDM_SUCCESS;
 }
 
 void CommandInterface::exec()
 {
-    static constexpr auto pldmObjPath = "/xyz/openbmc_project/pldm";
-    static constexpr auto pldmRequester = "xyz.openbmc_project.PLDM.Requester";
-    auto& bus = pldm::utils::DBusHandler::getBus();
-    try
-    {
-        auto service = pldm::utils::DBusHandler().getService(pldmObjPath,
-                                                             pldmRequester);
-        auto method = bus.new_method_call(service.c_str(), pldmObjPath,
-                                          pldmRequester, "GetInstanceId");
-        method.append(mctp_eid);
-        auto reply = bus.call(method, dbusTimeout);
-        reply.read(instanceId);
-    }
-    catch (const std::exception& e)
+    if (Session::getSession().getInstanceId(mctp_eid, instanceId) !=
+        PLDM_SUCCESS)
     {
-        error(
-            "GetInstanceId D-Bus call failed, MCTP id = {KEY0}, error = {KEY1}",
-            "KEY0", (unsigned)mctp_eid, "KEY1", e.what());
         return;
     }
     auto [rc, requestMsg] = createRequestMsg();
@@ -202,7 +361,7 @@ int CommandInterface::pldmSendRecv(std::vector<uint8_t>& requestMsg,
 
     if (mctp_eid != PLDM_ENTITY_ID)
     {
-        int fd = pldm_open();
+        int fd = Session::getSession().getLibpldmFd();
         if (-1 == fd)
         {
             error("failed to init mctp ");
@@ -227,7 +386,12 @@ int CommandInterface::pldmSendRecv(std::vector<uint8_t>& requestMsg,
     }
     else
     {
-        mctpSockSendRecv(requestMsg, responseMsg, mctpVerbose);
+        auto rc = mctpSockSendRecv(requestMsg, responseMsg, mctpVerbose);
+        if (rc != PLDM_SUCCESS || responseMsg.size() < 2)
+        {
+            error("Failed to receive the response : RC = {KEY0}", "KEY0", rc);
+            return PLDM_ERROR;
+        }
         if (pldmVerbose)
         {
             std::cout << "pldmtool: ";
@@ -18,7 +18,9 @@
 #include <cstring>
 #include <iomanip>
 #include <iostream>
+#include <string>
 #include <utility>
+#include <vector>
 
 namespace pldmtool
 {
@@ -28,8 +30,21 @@ namespace helper
 
 constexpr uint8_t PLDM_ENTITY_ID = 8;
 constexpr uint8_t MCTP_MSG_TYPE_PLDM = 1;
+constexpr uint8_t maxInstanceIds = 32;
+
 using ordered_json = nlohmann::ordered_json;
 
+/** @brief Output format switch for the JSON output of the commands
+ *
+ *  @return reference to the flag, true if every JSON document is printed on
+ *          a single line (JSON lines) instead of being pretty printed
+ */
+inline bool& jsonLinesOutput()
+{
+    static bool jsonLines = false;
+    return jsonLines;
+}
+
 /** @brief print the input message if pldmverbose is enabled
  *
  *  @param[in]  pldmVerbose - verbosity flag - true/false
@@ -58,6 +73,11 @@ void Logger(bool pldmverbose, const char* msg, const T& data)
  */
 static inline void DisplayInJson(const ordered_json& data)
 {
+    if (jsonLinesOutput())
+    {
+        std::cout << data.dump() << std::endl;
+        return;
+    }
     std::cout << data.dump(4) << std::endl;
 }
 
@@ -74,6 +94,115 @@ static inline void DisplayInJson(const ordered_json& data)
 int mctpSockSendRecv(const std::vector<uint8_t>& requestMsg,
                      std::vector<uint8_t>& responseMsg, bool pldmVerbose);
 
+/** @class Session
+ *
+ *  Session keeps the connection to mctp-mux (or the libpldm MCTP socket) and
+ *  the PLDM instance IDs for the lifetime of pldmtool, so that the commands
+ *  run by one pldmtool invocation (GetPDR --all, the session subcommand)
+ *  share one socket. Every request uses an instance ID reserved with pldmd
+ *  just before it is sent. Only the IDs a command actually uses are
+ *  reserved, pldmd has no call to free an ID early, so an ID reserved and
+ *  left unused would be lost to pldmd until it expires.
+ */
+class Session
+{
+  public:
+    Session(const Session&) = delete;
+    Session(Session&&) = delete;
+    Session& operator=(const Session&) = delete;
+    Session& operator=(Session&&) = delete;
+    ~Session();
+
+    /** @brief Get the session of this pldmtool process */
+    static Session& getSession()
+    {
+        static Session session;
+        return session;
+    }
+
+    /** @brief Reserve the instance ID for the next request to an endpoint
+     *
+     *  @param[in] eid - MCTP endpoint ID
+     *  @param[out] instanceId - PLDM instance ID
+     *
+     *  @return PLDM_SUCCESS on success and PLDM_ERROR otherwise
+     */
+    int getInstanceId(uint8_t eid, uint8_t& instanceId);
+
+    /** @brief Reserve several instance IDs of an endpoint with pldmd, for a
+     *         command that keeps that many requests in flight
+     *
+     *  @param[in] eid - MCTP endpoint ID
+     *  @param[in] count - number of instance IDs
+     *
+     *  @return the reserved instance IDs, fewer than count if pldmd is short
+     *          of free IDs, empty on failure
+     */
+    std::vector<uint8_t> reserveInstanceIds(uint8_t eid, uint8_t count);
+
+    /** @brief Send a request on the mctp-mux socket and wait for the response
+     *
+     *  @param[in] requestMsg - Request message prefixed with the EID and the
+     *                          MCTP message type
+     *  @param[out] responseMsg - Response message prefixed with the EID and
+     *                            the MCTP message type
+     *  @param[in] pldmVerbose - verbosity flag - true/false
+     *
+     *  @return 0 on success, -1 or -errno on failure
+     */
+    int sendRecv(const std::vector<uint8_t>& requestMsg,
+                 std::vector<uint8_t>& responseMsg, bool pldmVerbose);
+
+    /** @brief Get the libpldm MCTP socket, opened on the first call
+     *
+     *  @return socket fd on success and -1 on failure
+     */
+    int getLibpldmFd();
+
+    /** @brief Get the socket connected to mctp-mux, connected on the first
+     *         call
+     *
+     *  @param[in] pldmVerbose - verbosity flag - true/false
+     *
+     *  @return socket fd on success, -1 or -errno on failure
+     */
+    int getMuxFd(bool pldmVerbose);
+
+  private:
+    Session() = default;
+
+    /** @brief Connect to mctp-mux and register for PLDM messages
+     *
+     *  @param[in] pldmVerbose - verbosity flag - true/false
+     *
+     *  @return 0 on success, -errno on failure
+     */
+    int connectMux(bool pldmVerbose);
+
+    /** @brief Close the mctp-mux connection */
+    void closeMux();
+
+    /** @brief socket connected to mctp-mux */
+    int muxFd = -1;
+
+    /** @brief libpldm MCTP socket */
+    int libpldmFd = -1;
+
+    /** @brief Look up the pldmd service name on the first reservation
+     *
+     *  @return false if pldmd is not found
+     */
+    bool findPldmService();
+
+    /** @brief pldmd service name, looked up on the first reservation */
+    std::string pldmService;
+
+    /** @brief false once pldmd is found without the Requester.Batch
+     *         interface
+     */
+    bool batchReservation = true;
+};
+
 class CommandInterface
 {
   public:
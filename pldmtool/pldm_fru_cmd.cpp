@@ -453,6 +453,8 @@ class GetFruRecordTable : public CommandInterface
 
 void registerCommand(CLI::App& app)
 {
+    commands.clear();
+
     auto fru = app.add_subcommand("fru", "FRU type command");
     fru->require_subcommand(1);
     auto getFruRecordTableMetadata = fru->add_subcommand(
@@ -395,6 +395,8 @@ class GetFwParams : public CommandInterface
 
 void registerCommand(CLI::App& app)
 {
+    commands.clear();
+
     auto fwUpdate = app.add_subcommand("fw_update",
                                        "firmware update type commands");
     fwUpdate->require_subcommand(1);
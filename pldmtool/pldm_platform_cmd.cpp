@@ -100,8 +100,13 @@ class GetPDR : public CommandInterface
                                pdrRecType.begin(), tolower);
             }
 
-            // start the array
-            std::cout << "[\n";
+            // start the array, with JSON lines output every record is a
+            // document of its own
+            auto jsonLines = jsonLinesOutput();
+            if (!jsonLines)
+            {
+                std::cout << "[\n";
+            }
 
             // Retrieve all PDR records starting from the first
             recordHandle = 0;
@@ -131,7 +136,7 @@ class GetPDR : public CommandInterface
                 }
                 prevRecordHandle = recordHandle;
 
-                if (recordHandle != 0)
+                if (recordHandle != 0 && !jsonLines)
                 {
                     // close the array
                     std::cout << ",";
@@ -139,7 +144,10 @@ class GetPDR : public CommandInterface
             } while (recordHandle != 0);
 
             // close the array
-            std::cout << "]\n";
+            if (!jsonLines)
+            {
+                std::cout << "]\n";
+            }
         }
         else
         {
@@ -1499,6 +1507,8 @@ class GetNumericEffecterValue : public CommandInterface
 
 void registerCommand(CLI::App& app)
 {
+    commands.clear();
+
     auto platform = app.add_subcommand("platform", "platform type command");
     platform->require_subcommand(1);
 
@@ -1,4 +1,5 @@
 #include "pldm_base_cmd.hpp"
+#include "pldm_bench_cmd.hpp"
 #include "pldm_bios_cmd.hpp"
 #include "pldm_cmd_helper.hpp"
 #include "pldm_fru_cmd.hpp"
@@ -8,6 +9,10 @@
 
 #include <CLI/CLI.hpp>
 
+#include <fstream>
+#include <iostream>
+#include <string>
+
 namespace pldmtool
 {
 
@@ -54,30 +59,138 @@ class RawOp : public CommandInterface
 
 void registerCommand(CLI::App& app)
 {
+    commands.clear();
+
     auto raw = app.add_subcommand("raw",
                                   "send a raw request and print response");
     commands.push_back(std::make_unique<RawOp>("raw", "raw", raw));
 }
 
 } // namespace raw
+
+/** @brief Register the commands of all the PLDM types
+ *
+ *  @param[in] app - CLI11 app to register the commands with
+ */
+void registerCommands(CLI::App& app)
+{
+    raw::registerCommand(app);
+    base::registerCommand(app);
+    bios::registerCommand(app);
+    platform::registerCommand(app);
+    fru::registerCommand(app);
+    fw_update::registerCommand(app);
+    bench::registerCommand(app);
+
+#ifdef OEM_IBM
+    oem_ibm::registerCommand(app);
+#endif
+}
+
+namespace session
+{
+
+/** @brief Run one command line of a session
+ *
+ *  Every line is parsed by a CLI11 app of its own, so that the options of a
+ *  command do not leak into the next line. Registering the commands again
+ *  drops the commands of the previous line. The socket and the instance IDs
+ *  are kept by helper::Session across the lines.
+ *
+ *  @param[in] line - command line without the program name
+ *
+ *  @return 0 on success and the CLI11 exit code otherwise
+ */
+int runCommandLine(const std::string& line)
+{
+    CLI::App app{"PLDM requester tool for OpenBMC"};
+    app.require_subcommand(1)->ignore_case();
+    registerCommands(app);
+
+    try
+    {
+        app.parse(line, false);
+    }
+    catch (const CLI::ParseError& e)
+    {
+        return app.exit(e);
+    }
+    return 0;
+}
+
+/** @brief Run the commands read from a script or stdin, one command per line
+ *
+ *  Empty lines and lines starting with '#' are skipped.
+ *
+ *  @param[in] scriptPath - path of the command script, stdin when empty
+ *  @param[in] stopOnError - stop at the first line that fails to parse
+ *
+ *  @return 0 on success and non-zero otherwise
+ */
+int runSession(const std::string& scriptPath, bool stopOnError)
+{
+    std::ifstream script;
+    if (!scriptPath.empty())
+    {
+        script.open(scriptPath);
+        if (!script.is_open())
+        {
+            std::cerr << "Failed to open the command script " << scriptPath
+                      << std::endl;
+            return 1;
+        }
+    }
+    std::istream& input = scriptPath.empty() ? std::cin : script;
+
+    int rc = 0;
+    std::string line;
+    while (std::getline(input, line))
+    {
+        auto first = line.find_first_not_of(" \t");
+        if (first == std::string::npos || line[first] == '#')
+        {
+            continue;
+        }
+
+        if (runCommandLine(line.substr(first)))
+        {
+            rc = 1;
+            if (stopOnError)
+            {
+                break;
+            }
+        }
+    }
+    return rc;
+}
+
+} // namespace session
 } // namespace pldmtool
 
 int main(int argc, char** argv)
 {
     CLI::App app{"PLDM requester tool for OpenBMC"};
     app.require_subcommand(1)->ignore_case();
+    app.add_flag("-j,--jsonl", pldmtool::helper::jsonLinesOutput(),
+                 "print every JSON output on a single line (JSON lines)");
 
-    pldmtool::raw::registerCommand(app);
-    pldmtool::base::registerCommand(app);
-    pldmtool::bios::registerCommand(app);
-    pldmtool::platform::registerCommand(app);
-    pldmtool::fru::registerCommand(app);
-    pldmtool::fw_update::registerCommand(app);
+    pldmtool::registerCommands(app);
 
-#ifdef OEM_IBM
-    pldmtool::oem_ibm::registerCommand(app);
-#endif
+    std::string scriptPath;
+    bool stopOnError = false;
+    auto session = app.add_subcommand(
+        "session", "run commands from a script or stdin, one per line, "
+                   "sharing one MCTP socket and instance ID sequence");
+    session->add_option("-f,--file", scriptPath,
+                        "command script, stdin if not specified");
+    session->add_flag("-s,--stop-on-error", stopOnError,
+                      "stop at the first command that fails to parse");
 
     CLI11_PARSE(app, argc, argv);
+
+    if (session->parsed())
+    {
+        return pldmtool::session::runSession(scriptPath, stopOnError);
+    }
     return 0;
 }
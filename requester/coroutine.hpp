@@ -0,0 +1,356 @@
+#pragma once
+
+#include "common/types.hpp"
+
+#include <libpldm/base.h>
+#include <libpldm/pldm.h>
+
+#include <phosphor-logging/lg2.hpp>
+#include <sdbusplus/timer.hpp>
+#include <sdeventplus/event.hpp>
+#include <sdeventplus/source/event.hpp>
+
+#include <chrono>
+#include <coroutine>
+#include <exception>
+#include <memory>
+#include <utility>
+
+PHOSPHOR_LOG2_USING;
+
+namespace pldm
+{
+namespace requester
+{
+
+/** @class Task
+ *
+ *  @brief Coroutine of a PLDM requester flow. The coroutine runs as soon as
+ *         it is called, up to its first co_await, and is resumed from the
+ *         event loop afterwards.
+ *
+ *         The Task owns the coroutine: destroying or reassigning it cancels
+ *         the flow at the co_await it is suspended on, and the response that
+ *         arrives later is dropped.
+ */
+class Task
+{
+  public:
+    struct promise_type
+    {
+        Task get_return_object()
+        {
+            return Task(
+                std::coroutine_handle<promise_type>::from_promise(*this));
+        }
+
+        std::suspend_never initial_suspend() noexcept
+        {
+            return {};
+        }
+
+        /** @brief The frame is kept until the Task is destroyed */
+        std::suspend_always final_suspend() noexcept
+        {
+            return {};
+        }
+
+        void return_void() noexcept {}
+
+        /** @brief An exception ends the flow, it must not unwind into the
+         *         event loop
+         */
+        void unhandled_exception() noexcept
+        {
+            try
+            {
+                std::rethrow_exception(std::current_exception());
+            }
+            catch (const std::exception& e)
+            {
+                error("PLDM requester coroutine failed, ERROR={ERR_EXCEP}",
+                      "ERR_EXCEP", e.what());
+            }
+            catch (...)
+            {
+                error("PLDM requester coroutine failed");
+            }
+        }
+    };
+
+    Task() = default;
+    Task(const Task&) = delete;
+    Task& operator=(const Task&) = delete;
+
+    Task(Task&& other) noexcept : handle(std::exchange(other.handle, nullptr))
+    {}
+
+    Task& operator=(Task&& other) noexcept
+    {
+        if (this != &other)
+        {
+            cancel();
+            handle = std::exchange(other.handle, nullptr);
+        }
+        return *this;
+    }
+
+    ~Task()
+    {
+        cancel();
+    }
+
+    /** @brief Check if the flow is over, or was never started */
+    bool done() const
+    {
+        return !handle || handle.done();
+    }
+
+    /** @brief Cancel the flow, nothing happens if it is over */
+    void cancel()
+    {
+        if (handle)
+        {
+            handle.destroy();
+            handle = nullptr;
+        }
+    }
+
+  private:
+    explicit Task(std::coroutine_handle<promise_type> handle) : handle(handle)
+    {}
+
+    std::coroutine_handle<promise_type> handle;
+};
+
+/** @class Yield
+ *
+ *  @brief Awaitable that resumes the coroutine on the next iteration of the
+ *         event loop, so that the events already pending are served first
+ */
+class Yield
+{
+  public:
+    Yield() = delete;
+    Yield(const Yield&) = delete;
+    Yield(Yield&&) = delete;
+    Yield& operator=(const Yield&) = delete;
+    Yield& operator=(Yield&&) = delete;
+    ~Yield() = default;
+
+    /** @brief Constructor
+     *
+     *  @param[in] event - reference to PLDM daemon's main event loop
+     */
+    explicit Yield(sdeventplus::Event& event) : event(event) {}
+
+    bool await_ready() const noexcept
+    {
+        return false;
+    }
+
+    void await_suspend(std::coroutine_handle<> waiter)
+    {
+        resume = std::make_unique<sdeventplus::source::Defer>(
+            event,
+            [waiter](sdeventplus::source::EventBase& /*source*/) {
+            waiter.resume();
+        });
+    }
+
+    void await_resume() const noexcept {}
+
+  private:
+    sdeventplus::Event& event;
+
+    /** @brief resumes the coroutine, released with the awaitable once the
+     *         coroutine goes on
+     */
+    std::unique_ptr<sdeventplus::source::Defer> resume;
+};
+
+/** @class SendRecvAwaiter
+ *
+ *  @brief Awaitable of a PLDM request, returned by Handler::sendRecvMsg. The
+ *         coroutine is resumed on the event loop with the response message,
+ *         PLDM header included, or with an empty response if the request
+ *         could not be sent, was not answered before the instance ID expiry,
+ *         or timed out. A request that timed out or whose coroutine was
+ *         cancelled is unregistered from the handler, which goes on
+ *         with the next request to the endpoint. Its instance ID is freed
+ *         once the late response comes in or the instance ID expires.
+ *
+ *  @tparam RequestHandler - requester Handler type
+ */
+template <class RequestHandler>
+class SendRecvAwaiter
+{
+  public:
+    SendRecvAwaiter() = delete;
+    SendRecvAwaiter(const SendRecvAwaiter&) = delete;
+    SendRecvAwaiter(SendRecvAwaiter&&) = delete;
+    SendRecvAwaiter& operator=(const SendRecvAwaiter&) = delete;
+    SendRecvAwaiter& operator=(SendRecvAwaiter&&) = delete;
+
+    /** @brief Constructor
+     *
+     *  @param[in] handler - requester handler that sends the request
+     *  @param[in] event - reference to PLDM daemon's main event loop
+     *  @param[in] eid - endpoint ID of the remote MCTP endpoint
+     *  @param[in] request - PLDM request message
+     *  @param[in] timeout - time to wait for the response, zero to wait for
+     *                       the instance ID expiry
+     */
+    explicit SendRecvAwaiter(RequestHandler& handler,
+                             sdeventplus::Event& event, mctp_eid_t eid,
+                             pldm::Request&& request,
+                             std::chrono::milliseconds timeout) :
+        handler(handler),
+        eid(eid), request(std::move(request)), timeout(timeout),
+        state(std::make_shared<State>(event))
+    {}
+
+    /** @brief A cancelled coroutine gives up its request, unless it was
+     *         already answered
+     */
+    ~SendRecvAwaiter()
+    {
+        state->waiter = nullptr;
+        state->timer.reset();
+        state->resume.reset();
+        if (registered && !state->done)
+        {
+            state->done = true;
+            handler.unregisterRequest(eid, instanceId, type, command);
+        }
+    }
+
+    bool await_ready() const noexcept
+    {
+        return false;
+    }
+
+    /** @brief Register the request, the coroutine goes on right away with an
+     *         empty response if it fails
+     */
+    bool await_suspend(std::coroutine_handle<> waiter)
+    {
+        if (request.size() < sizeof(pldm_msg_hdr))
+        {
+            error("PLDM request to EID {EID} is too short, LENGTH={LEN}",
+                  "EID", unsigned(eid), "LEN", request.size());
+            return false;
+        }
+        auto hdr = reinterpret_cast<const pldm_msg_hdr*>(request.data());
+        instanceId = hdr->instance_id;
+        type = hdr->type;
+        command = hdr->command;
+
+        state->waiter = waiter;
+        auto rc = handler.registerRequest(
+            eid, instanceId, type, command, std::move(request),
+            [state = state](mctp_eid_t /*eid*/, const pldm_msg* response,
+                            size_t respMsgLen) {
+            if (response != nullptr && respMsgLen)
+            {
+                auto begin = reinterpret_cast<const uint8_t*>(response);
+                state->response.assign(begin, begin + sizeof(pldm_msg_hdr) +
+                                                  respMsgLen);
+            }
+            complete(*state);
+        });
+        if (rc != PLDM_SUCCESS)
+        {
+            error(
+                "Failed to send the PLDM request to EID {EID}, TYPE={TYPE} CMD={CMD}",
+                "EID", unsigned(eid), "TYPE", unsigned(type), "CMD",
+                unsigned(command));
+            state->waiter = nullptr;
+            return false;
+        }
+        registered = true;
+
+        if (timeout.count() > 0)
+        {
+            // The timer goes away with the awaitable
+            state->timer =
+                std::make_unique<phosphor::Timer>(state->event.get(), [this] {
+                error("PLDM request timed out, TIMEOUT={TIMEOUT}ms",
+                      "TIMEOUT", this->timeout.count());
+                state->response.clear();
+                complete(*state);
+                handler.unregisterRequest(eid, instanceId, type, command);
+            });
+            state->timer->start(
+                std::chrono::duration_cast<std::chrono::microseconds>(
+                    timeout));
+        }
+        return true;
+    }
+
+    pldm::Response await_resume() noexcept
+    {
+        return std::move(state->response);
+    }
+
+  private:
+    /** @struct State
+     *
+     *  Shared by the awaitable and the response handler, which can outlive
+     *  the coroutine
+     */
+    struct State
+    {
+        explicit State(sdeventplus::Event& event) : event(event) {}
+
+        sdeventplus::Event& event;
+        std::coroutine_handle<> waiter;
+        pldm::Response response;
+        bool done = false;
+        std::unique_ptr<phosphor::Timer> timer;
+        std::unique_ptr<sdeventplus::source::Defer> resume;
+    };
+
+    /** @brief Resume the coroutine on the event loop with the response, the
+     *         first of the response and the timeout wins. Resuming from a
+     *         deferred event keeps the coroutine out of the requester
+     *         handler, which may still be updating its queues.
+     */
+    static void complete(State& state)
+    {
+        if (state.done)
+        {
+            return;
+        }
+        state.done = true;
+        if (state.timer)
+        {
+            state.timer->stop();
+        }
+        if (!state.waiter)
+        {
+            return;
+        }
+        state.resume = std::make_unique<sdeventplus::source::Defer>(
+            state.event,
+            [&state](sdeventplus::source::EventBase& /*source*/) {
+            std::exchange(state.waiter, nullptr).resume();
+        });
+    }
+
+    RequestHandler& handler;
+    mctp_eid_t eid;
+    pldm::Request request;
+    std::chrono::milliseconds timeout;
+    std::shared_ptr<State> state;
+
+    /** @brief Key of the request in the handler, once registered */
+    bool registered = false;
+    uint8_t instanceId = 0;
+    uint8_t type = 0;
+    uint8_t command = 0;
+};
+
+} // namespace requester
+
+} // namespace pldm
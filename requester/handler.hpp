@@ -1,6 +1,7 @@
 #pragma once
 
 #include "common/types.hpp"
+#include "coroutine.hpp"
 #include "pldmd/dbus_impl_requester.hpp"
 #include "request.hpp"
 
@@ -14,6 +15,7 @@
 #include <sdeventplus/event.hpp>
 #include <sdeventplus/source/event.hpp>
 
+#include <algorithm>
 #include <cassert>
 #include <chrono>
 #include <deque>
@@ -21,6 +23,7 @@
 #include <mutex>
 #include <tuple>
 #include <unordered_map>
+#include <unordered_set>
 
 PHOSPHOR_LOG2_USING;
 
@@ -168,6 +171,11 @@ class Handler
                 key,
                 std::make_unique<sdeventplus::source::Defer>(
                     event, std::bind(&Handler::removeRequestEntry, this, key)));
+            if (abandonedRequests.erase(key))
+            {
+                // The endpoint went on when the request was unregistered
+                return;
+            }
             endpointMessageQueues[eid]->activeRequest = false;
 
             /* try to send new request if the endpoint is free */
@@ -213,6 +221,9 @@ class Handler
             endpointMessageQueues[eid]->activeRequest = false;
             return rc;
         }
+        // The instance ID expires counting from now, like the timer below
+        requester.resumeExpiry(requestMsg->key.eid,
+                               requestMsg->key.instanceId);
 
         try
         {
@@ -260,6 +271,10 @@ class Handler
             return PLDM_ERROR;
         }
 
+        // The request may wait behind others to the endpoint, its instance ID
+        // must not expire before it is sent
+        requester.suspendExpiry(eid, instanceId);
+
         auto inputRequest = std::make_shared<RegisteredRequest>(
             key, std::move(requestMsg), std::move(responseHandler));
         if (endpointMessageQueues.contains(eid))
@@ -280,6 +295,85 @@ class Handler
         return PLDM_SUCCESS;
     }
 
+    /** @brief Unregister a PLDM request message whose response is no longer
+     *         awaited, the response handler is not invoked. A queued request
+     *         is dropped and its instance ID freed. A request in flight is
+     *         not retried and the next request queued to the endpoint is
+     *         sent, but its instance ID stays reserved until the late
+     *         response or the instance ID expiry, so that a late response
+     *         is not taken for the response of a new request.
+     *
+     *  @param[in] eid - endpoint ID of the remote MCTP endpoint
+     *  @param[in] instanceId - instance ID to match request and response
+     *  @param[in] type - PLDM type
+     *  @param[in] command - PLDM command
+     */
+    void unregisterRequest(mctp_eid_t eid, uint8_t instanceId, uint8_t type,
+                           uint8_t command)
+    {
+        RequestKey key{eid, instanceId, type, command};
+        if (removeRequestContainer.contains(key))
+        {
+            // The instance ID expired, the entry is being removed
+            return;
+        }
+
+        auto search = handlers.find(key);
+        if (search != handlers.end())
+        {
+            if (!abandonedRequests.emplace(key).second)
+            {
+                return;
+            }
+            auto& [request, responseHandler, timerInstance] = search->second;
+            request->stop();
+            responseHandler = [](mctp_eid_t, const pldm_msg*, size_t) {};
+
+            endpointMessageQueues[eid]->activeRequest = false;
+            /* try to send new request if the endpoint is free */
+            pollEndpointQueue(eid);
+            return;
+        }
+
+        auto queue = endpointMessageQueues.find(eid);
+        if (queue == endpointMessageQueues.end())
+        {
+            return;
+        }
+        auto& requestQueue = queue->second->requestQueue;
+        auto queued = std::find_if(requestQueue.begin(), requestQueue.end(),
+                                   [&key](const auto& registered) {
+            return registered->key == key;
+        });
+        if (queued != requestQueue.end())
+        {
+            requestQueue.erase(queued);
+            requester.markFree(key.eid, key.instanceId);
+        }
+    }
+
+    /** @brief Send a PLDM request message from a coroutine
+     *
+     *  co_await on the result registers the request and suspends the
+     *  coroutine until the response, the instance ID, PLDM type and command
+     *  are taken from the header of the request.
+     *
+     *  @param[in] eid - endpoint ID of the remote MCTP endpoint
+     *  @param[in] request - PLDM request message
+     *  @param[in] timeout - time to wait for the response, zero to wait for
+     *                       the instance ID expiry
+     *
+     *  @return the awaitable, which gives the response message with its
+     *          header, or an empty response on failure
+     */
+    SendRecvAwaiter<Handler> sendRecvMsg(
+        mctp_eid_t eid, pldm::Request&& request,
+        std::chrono::milliseconds timeout = std::chrono::milliseconds::zero())
+    {
+        return SendRecvAwaiter<Handler>(*this, event, eid, std::move(request),
+                                        timeout);
+    }
+
     /** @brief Handle PLDM response message
      *
      *  @param[in] eid - endpoint ID of the remote MCTP endpoint
@@ -307,6 +401,11 @@ class Handler
             responseHandler(eid, response, respMsgLen);
             requester.markFree(key.eid, key.instanceId);
             handlers.erase(key);
+            if (abandonedRequests.erase(key))
+            {
+                // The endpoint went on when the request was unregistered
+                return;
+            }
 
             endpointMessageQueues[eid]->activeRequest = false;
             /* try to send new request if the endpoint is free */
@@ -349,6 +448,12 @@ class Handler
     /** @brief Container for storing the PLDM request entries */
     std::unordered_map<RequestKey, RequestValue, RequestKeyHasher> handlers;
 
+    /** @brief Requests in flight that were unregistered, their entries and
+     *         instance IDs are kept until the response or the instance ID
+     *         expiry
+     */
+    std::unordered_set<RequestKey, RequestKeyHasher> abandonedRequests;
+
     /** @brief Container to store information about the request entries to be
      *         removed after the instance ID timer expires
      */
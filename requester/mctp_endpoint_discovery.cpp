@@ -21,7 +21,12 @@ MctpDiscovery::MctpDiscovery(sdbusplus::bus_t& bus,
     mctpEndpointSignal(bus,
                        sdbusplus::bus::match::rules::interfacesAdded(
                            "/xyz/openbmc_project/mctp"),
-                       std::bind_front(&MctpDiscovery::dicoverEndpoints, this))
+                       std::bind_front(&MctpDiscovery::dicoverEndpoints, this)),
+    mctpEndpointRemovedSignal(
+        bus,
+        sdbusplus::bus::match::rules::interfacesRemoved(
+            "/xyz/openbmc_project/mctp"),
+        std::bind_front(&MctpDiscovery::removeEndpoints, this))
 {
     dbus::ObjectValueTree objects;
 
@@ -59,6 +64,7 @@ MctpDiscovery::MctpDiscovery(sdbusplus::bus_t& bus,
                         types.end())
                     {
                         eids.emplace_back(eid);
+                        endpointPaths.insert_or_assign(objectPath.str, eid);
                     }
                 }
             }
@@ -95,6 +101,7 @@ void MctpDiscovery::dicoverEndpoints(sdbusplus::message_t& msg)
                     types.end())
                 {
                     eids.emplace_back(eid);
+                    endpointPaths.insert_or_assign(objPath.str, eid);
                 }
             }
         }
@@ -106,4 +113,32 @@ void MctpDiscovery::dicoverEndpoints(sdbusplus::message_t& msg)
     }
 }
 
+void MctpDiscovery::removeEndpoints(sdbusplus::message_t& msg)
+{
+    std::vector<mctp_eid_t> eids;
+
+    sdbusplus::message::object_path objPath;
+    std::vector<std::string> interfaces;
+    msg.read(objPath, interfaces);
+
+    if (std::find(interfaces.begin(), interfaces.end(),
+                  mctpEndpointIntfName) == interfaces.end())
+    {
+        return;
+    }
+
+    auto search = endpointPaths.find(objPath.str);
+    if (search == endpointPaths.end())
+    {
+        return;
+    }
+    eids.emplace_back(search->second);
+    endpointPaths.erase(search);
+
+    if (fwManager)
+    {
+        fwManager->handleRemovedMCTPEndpoints(eids);
+    }
+}
+
 } // namespace pldm
@@ -4,6 +4,9 @@
 
 #include <sdbusplus/bus/match.hpp>
 
+#include <map>
+#include <string>
+
 namespace pldm
 {
 
@@ -35,8 +38,23 @@ class MctpDiscovery
     /** @brief Used to watch for new MCTP endpoints */
     sdbusplus::bus::match_t mctpEndpointSignal;
 
+    /** @brief Used to watch for MCTP endpoints going away */
+    sdbusplus::bus::match_t mctpEndpointRemovedSignal;
+
+    /** @brief MCTP endpoint object path to the EID of the PLDM endpoints
+     *         reported to the firmware manager
+     */
+    std::map<std::string, mctp_eid_t> endpointPaths;
+
     void dicoverEndpoints(sdbusplus::message_t& msg);
 
+    /** @brief Callback when MCTP endpoints are removed, the firmware manager
+     *         drops the endpoints from the inventory
+     *
+     *  @param[in] msg - InterfacesRemoved signal
+     */
+    void removeEndpoints(sdbusplus::message_t& msg);
+
     static constexpr uint8_t mctpTypePLDM = 1;
 
     static constexpr std::string_view mctpEndpointIntfName{
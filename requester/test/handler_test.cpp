@@ -151,3 +151,127 @@ TEST_F(HandlerTest, multipleRequestResponseScenario)
     EXPECT_EQ(callbackCount, 2);
     EXPECT_EQ(instanceId, dbusImplReq.getInstanceId(eid));
 }
+
+TEST_F(HandlerTest, coroutineRequestResponse)
+{
+    Handler<NiceMock<MockRequest>> reqHandler(
+        fd, event, dbusImplReq, false, 90000, seconds(1), 2, milliseconds(100));
+    auto instanceId = dbusImplReq.getInstanceId(eid);
+    pldm::Request request(sizeof(pldm_msg_hdr));
+    auto hdr = reinterpret_cast<pldm_msg_hdr*>(request.data());
+    hdr->instance_id = instanceId;
+
+    pldm::Response received;
+    bool resumed = false;
+    auto flow = [&]() -> Task {
+        received = co_await reqHandler.sendRecvMsg(eid, std::move(request));
+        resumed = true;
+    };
+    auto task = flow();
+    EXPECT_FALSE(task.done());
+
+    pldm::Response response(sizeof(pldm_msg_hdr) + sizeof(uint8_t), 0xAB);
+    auto responsePtr = reinterpret_cast<const pldm_msg*>(response.data());
+    reqHandler.handleResponse(eid, instanceId, 0, 0, responsePtr,
+                              response.size() - sizeof(pldm_msg_hdr));
+
+    // The coroutine is resumed from the event loop
+    EXPECT_FALSE(resumed);
+    waitEventExpiry(milliseconds(100));
+    EXPECT_TRUE(resumed);
+    EXPECT_TRUE(task.done());
+    EXPECT_EQ(received, response);
+}
+
+TEST_F(HandlerTest, coroutineCancelAndTimeout)
+{
+    Handler<NiceMock<MockRequest>> reqHandler(
+        fd, event, dbusImplReq, false, 90000, seconds(2), 2, milliseconds(100));
+    auto instanceId = dbusImplReq.getInstanceId(eid);
+    pldm::Request request(sizeof(pldm_msg_hdr));
+    reinterpret_cast<pldm_msg_hdr*>(request.data())->instance_id = instanceId;
+
+    int resumed = 0;
+    auto flow = [&](pldm::Request msg, milliseconds timeout) -> Task {
+        auto received = co_await reqHandler.sendRecvMsg(eid, std::move(msg),
+                                                        timeout);
+        EXPECT_TRUE(received.empty());
+        resumed++;
+    };
+
+    // The response to a cancelled coroutine is dropped
+    auto task = flow(request, milliseconds::zero());
+    task.cancel();
+    pldm::Response response(sizeof(pldm_msg_hdr) + sizeof(uint8_t));
+    auto responsePtr = reinterpret_cast<const pldm_msg*>(response.data());
+    reqHandler.handleResponse(eid, instanceId, 0, 0, responsePtr,
+                              response.size() - sizeof(pldm_msg_hdr));
+    waitEventExpiry(milliseconds(100));
+    EXPECT_EQ(resumed, 0);
+
+    // Without a response, the coroutine goes on after its timeout
+    instanceId = dbusImplReq.getInstanceId(eid);
+    reinterpret_cast<pldm_msg_hdr*>(request.data())->instance_id = instanceId;
+    task = flow(request, milliseconds(100));
+    waitEventExpiry(milliseconds(500));
+    EXPECT_EQ(resumed, 1);
+    EXPECT_TRUE(task.done());
+}
+
+TEST_F(HandlerTest, coroutineTimeoutAndCancelReleaseEndpoint)
+{
+    Handler<NiceMock<MockRequest>> reqHandler(
+        fd, event, dbusImplReq, false, 90000, seconds(5), 2, milliseconds(100));
+    auto instanceId = dbusImplReq.getInstanceId(eid);
+    pldm::Request request(sizeof(pldm_msg_hdr));
+    reinterpret_cast<pldm_msg_hdr*>(request.data())->instance_id = instanceId;
+
+    int resumed = 0;
+    auto flow = [&](pldm::Request msg, milliseconds timeout) -> Task {
+        auto received = co_await reqHandler.sendRecvMsg(eid, std::move(msg),
+                                                        timeout);
+        EXPECT_TRUE(received.empty());
+        resumed++;
+    };
+    pldm::Response response(sizeof(pldm_msg_hdr) + sizeof(uint8_t));
+    auto responsePtr = reinterpret_cast<const pldm_msg*>(response.data());
+
+    // The timed out request frees the endpoint before the instance ID expiry,
+    // the next request is sent right away with another instance ID
+    auto task = flow(request, milliseconds(100));
+    waitEventExpiry(milliseconds(300));
+    EXPECT_EQ(resumed, 1);
+    auto nextInstanceId = dbusImplReq.getInstanceId(eid);
+    EXPECT_NE(nextInstanceId, instanceId);
+    auto rc = reqHandler.registerRequest(
+        eid, nextInstanceId, 0, 0, pldm::Request{},
+        std::move(std::bind_front(&HandlerTest::pldmResponseCallBack, this)));
+    EXPECT_EQ(rc, PLDM_SUCCESS);
+
+    // The late response to the timed out request is dropped and frees its
+    // instance ID
+    reqHandler.handleResponse(eid, instanceId, 0, 0, responsePtr,
+                              response.size() - sizeof(pldm_msg_hdr));
+    EXPECT_EQ(callbackCount, 0);
+    reqHandler.handleResponse(eid, nextInstanceId, 0, 0, responsePtr,
+                              response.size() - sizeof(pldm_msg_hdr));
+    EXPECT_TRUE(validResponse);
+    EXPECT_EQ(callbackCount, 1);
+    EXPECT_EQ(instanceId, dbusImplReq.getInstanceId(eid));
+
+    // The request queued behind a cancelled coroutine is sent on the cancel,
+    // the cancelled request keeps its instance ID until the expiry
+    reinterpret_cast<pldm_msg_hdr*>(request.data())->instance_id = instanceId;
+    task = flow(request, milliseconds::zero());
+    nextInstanceId = dbusImplReq.getInstanceId(eid);
+    rc = reqHandler.registerRequest(
+        eid, nextInstanceId, 0, 0, pldm::Request{},
+        std::move(std::bind_front(&HandlerTest::pldmResponseCallBack, this)));
+    EXPECT_EQ(rc, PLDM_SUCCESS);
+    task.cancel();
+    reqHandler.handleResponse(eid, nextInstanceId, 0, 0, responsePtr,
+                              response.size() - sizeof(pldm_msg_hdr));
+    EXPECT_EQ(callbackCount, 2);
+    EXPECT_EQ(resumed, 1);
+    EXPECT_EQ(nextInstanceId, dbusImplReq.getInstanceId(eid));
+}
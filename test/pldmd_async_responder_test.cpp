@@ -0,0 +1,201 @@
+#include "libpldm/base.h"
+
+#include "pldmd/async_responder.hpp"
+
+#include <sdbusplus/timer.hpp>
+#include <sdeventplus/event.hpp>
+
+#include <atomic>
+#include <future>
+#include <utility>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using namespace pldm::responder;
+using namespace std::chrono_literals;
+
+using Message = AsyncResponder::Message;
+
+static Message makeRequest(uint8_t eid, uint8_t instanceId, uint8_t command)
+{
+    Message request(2 + sizeof(pldm_msg_hdr) + 1, 0);
+    request[0] = eid;
+    request[1] = 1;
+    auto hdr = reinterpret_cast<pldm_msg_hdr*>(request.data() + 2);
+    hdr->request = 1;
+    hdr->instance_id = instanceId;
+    hdr->type = PLDM_OEM;
+    hdr->command = command;
+    return request;
+}
+
+static const pldm_msg* pldmMsg(const Message& message)
+{
+    return reinterpret_cast<const pldm_msg*>(message.data() + 2);
+}
+
+class AsyncResponderTest : public testing::Test
+{
+  protected:
+    AsyncResponderTest() :
+        event(sdeventplus::Event::get_new()),
+        timeout(event.get(), [this] { event.exit(0); })
+    {}
+
+    /** @brief Run the event loop until the expected number of responses is
+     *         sent, or a timeout
+     */
+    void runUntil(size_t responses)
+    {
+        expected = responses;
+        timeout.start(std::chrono::seconds(5));
+        event.loop();
+        timeout.stop();
+    }
+
+    void create(std::chrono::milliseconds deadline)
+    {
+        responder = std::make_unique<AsyncResponder>(
+            event, 2, deadline,
+            [this](const Message& request, const Response& response) {
+            sent.emplace_back(request, response);
+            if (sent.size() == expected)
+            {
+                event.exit(0);
+            }
+        }, [this](const Message& request) { dispatched.push_back(request); });
+    }
+
+    sdeventplus::Event event;
+    phosphor::Timer timeout;
+    size_t expected = 0;
+    std::vector<std::pair<Message, Response>> sent;
+    std::vector<Message> dispatched;
+    std::unique_ptr<AsyncResponder> responder;
+};
+
+TEST_F(AsyncResponderTest, completeFromWorker)
+{
+    create(1000ms);
+
+    auto request = makeRequest(9, 3, 0x10);
+    auto completer = responder->begin(request);
+    EXPECT_TRUE(responder->busy(9));
+    EXPECT_FALSE(responder->busy(10));
+
+    // Requests of the same endpoint wait for the pending command
+    auto next = makeRequest(9, 4, 0x11);
+    responder->defer(next);
+
+    Message header(request);
+    completer.post([header]() {
+        return CmdHandler::ccOnlyResponse(pldmMsg(header), PLDM_SUCCESS);
+    });
+    runUntil(1);
+
+    ASSERT_EQ(sent.size(), 1);
+    EXPECT_EQ(sent[0].second,
+              CmdHandler::ccOnlyResponse(pldmMsg(request), PLDM_SUCCESS));
+    ASSERT_EQ(dispatched.size(), 1);
+    EXPECT_EQ(dispatched[0], next);
+    EXPECT_FALSE(responder->busy(9));
+    EXPECT_EQ(responder->pending(), 0);
+}
+
+TEST_F(AsyncResponderTest, emptyResponseAndWrongInstanceId)
+{
+    create(1000ms);
+
+    auto request = makeRequest(9, 3, 0x10);
+    auto other = makeRequest(10, 5, 0x10);
+    responder->begin(request).post([]() { return Response{}; });
+    responder->begin(other)(
+        CmdHandler::ccOnlyResponse(pldmMsg(makeRequest(10, 6, 0x10)),
+                                   PLDM_SUCCESS));
+    runUntil(2);
+
+    ASSERT_EQ(sent.size(), 2);
+    for (const auto& [sentRequest, response] : sent)
+    {
+        auto expectedCc = sentRequest[0] == 9 ? PLDM_ERROR : PLDM_SUCCESS;
+        EXPECT_EQ(response, CmdHandler::ccOnlyResponse(pldmMsg(sentRequest),
+                                                       expectedCc));
+    }
+}
+
+TEST_F(AsyncResponderTest, deadline)
+{
+    create(10ms);
+
+    auto request = makeRequest(9, 3, 0x10);
+    auto completer = responder->begin(request);
+    runUntil(1);
+
+    ASSERT_EQ(sent.size(), 1);
+    EXPECT_EQ(sent[0].second, CmdHandler::ccOnlyResponse(pldmMsg(request),
+                                                         PLDM_ERROR_NOT_READY));
+    EXPECT_FALSE(responder->busy(9));
+
+    // The late response is dropped
+    completer(CmdHandler::ccOnlyResponse(pldmMsg(request), PLDM_SUCCESS));
+    event.run(std::chrono::microseconds(100ms));
+    EXPECT_EQ(sent.size(), 1);
+}
+
+TEST_F(AsyncResponderTest, deadlineWhileWorkRuns)
+{
+    create(10ms);
+
+    // Both workers are busy past the deadline, the work of the third
+    // command is still queued
+    std::promise<void> release;
+    auto released = release.get_future().share();
+    std::promise<void> started[2];
+    std::vector<Message> requests;
+    for (uint8_t eid = 9; eid < 11; ++eid)
+    {
+        requests.push_back(makeRequest(eid, 3, 0x10));
+        auto completer = responder->begin(requests.back());
+        auto& ready = started[eid - 9];
+        completer.post([&ready, released, request = requests.back()] {
+            ready.set_value();
+            released.wait();
+            return CmdHandler::ccOnlyResponse(pldmMsg(request), PLDM_SUCCESS);
+        });
+    }
+    started[0].get_future().wait();
+    started[1].get_future().wait();
+
+    std::atomic<bool> ran = false;
+    auto queued = makeRequest(11, 3, 0x10);
+    responder->begin(queued).post([&ran, &queued] {
+        ran = true;
+        return CmdHandler::ccOnlyResponse(pldmMsg(queued), PLDM_SUCCESS);
+    });
+
+    // Only the command whose work did not start is answered
+    runUntil(1);
+    ASSERT_EQ(sent.size(), 1);
+    EXPECT_EQ(sent[0].first[0], 11);
+    EXPECT_EQ(sent[0].second, CmdHandler::ccOnlyResponse(pldmMsg(queued),
+                                                         PLDM_ERROR_NOT_READY));
+    event.run(std::chrono::microseconds(50ms));
+    EXPECT_EQ(sent.size(), 1);
+    EXPECT_TRUE(responder->busy(9));
+    EXPECT_TRUE(responder->busy(10));
+
+    // The running work is answered once it completes
+    release.set_value();
+    runUntil(3);
+    ASSERT_EQ(sent.size(), 3);
+    for (size_t index = 1; index < sent.size(); ++index)
+    {
+        EXPECT_EQ(sent[index].second,
+                  CmdHandler::ccOnlyResponse(pldmMsg(sent[index].first),
+                                             PLDM_SUCCESS));
+    }
+    EXPECT_FALSE(responder->busy(9));
+    EXPECT_FALSE(responder->busy(10));
+    EXPECT_FALSE(ran);
+}
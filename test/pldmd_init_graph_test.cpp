@@ -0,0 +1,141 @@
+#include "pldmd/init_graph.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using namespace pldm;
+using namespace std::chrono_literals;
+
+using State = InitGraph::State;
+
+TEST(InitGraph, DependencyOrder)
+{
+    std::mutex lock;
+    std::vector<std::string> order;
+    auto record = [&](const std::string& name) {
+        return [&, name] {
+            std::lock_guard<std::mutex> guard(lock);
+            order.push_back(name);
+        };
+    };
+
+    InitGraph graph;
+    graph.add("a", {}, record("a"));
+    graph.add("b", {"a"}, record("b"));
+    graph.add("c", {"a"}, record("c"));
+    graph.add("d", {"b", "c"}, record("d"));
+    graph.start(4);
+    graph.join();
+
+    ASSERT_EQ(order.size(), 4);
+    EXPECT_EQ(order.front(), "a");
+    EXPECT_EQ(order.back(), "d");
+    EXPECT_EQ(graph.state("d"), State::Succeeded);
+}
+
+TEST(InitGraph, TasksRunInParallel)
+{
+    // Both tasks only finish once the other one started
+    std::atomic<int> started = 0;
+    auto task = [&] {
+        ++started;
+        auto deadline = std::chrono::steady_clock::now() + 5s;
+        while (started < 2 && std::chrono::steady_clock::now() < deadline)
+        {
+            std::this_thread::sleep_for(1ms);
+        }
+        if (started < 2)
+        {
+            throw std::runtime_error("Tasks ran one after the other");
+        }
+    };
+
+    InitGraph graph;
+    graph.add("a", {}, task);
+    graph.add("b", {}, task);
+    graph.start(2);
+    EXPECT_TRUE(graph.wait("a"));
+    EXPECT_TRUE(graph.wait("b"));
+}
+
+TEST(InitGraph, FailureSkipsDependents)
+{
+    bool dependentRan = false;
+    bool otherRan = false;
+
+    InitGraph graph;
+    graph.add("fails", {}, [] { throw std::runtime_error("no file"); });
+    graph.add("dependent", {"fails"}, [&] { dependentRan = true; });
+    graph.add("transitive", {"dependent"}, [&] { dependentRan = true; });
+    graph.add("other", {}, [&] { otherRan = true; });
+    graph.start(2);
+
+    EXPECT_FALSE(graph.wait("transitive"));
+    EXPECT_TRUE(graph.wait("other"));
+    graph.join();
+
+    EXPECT_FALSE(dependentRan);
+    EXPECT_TRUE(otherRan);
+    EXPECT_EQ(graph.state("fails"), State::Failed);
+    EXPECT_EQ(graph.state("dependent"), State::Skipped);
+    EXPECT_EQ(graph.state("transitive"), State::Skipped);
+}
+
+TEST(InitGraph, WaitBlocksUntilDone)
+{
+    std::atomic<bool> release = false;
+    std::atomic<bool> done = false;
+
+    InitGraph graph;
+    graph.add("slow", {}, [&] {
+        while (!release)
+        {
+            std::this_thread::sleep_for(1ms);
+        }
+        done = true;
+    });
+    graph.start(1);
+
+    std::thread releaser([&] {
+        std::this_thread::sleep_for(20ms);
+        release = true;
+    });
+    EXPECT_TRUE(graph.wait("slow"));
+    EXPECT_TRUE(done);
+    releaser.join();
+}
+
+TEST(InitGraph, Inline)
+{
+    auto caller = std::this_thread::get_id();
+    std::vector<std::thread::id> threads;
+
+    InitGraph graph;
+    graph.add("a", {}, [&] { threads.push_back(std::this_thread::get_id()); });
+    graph.add("b", {"a"},
+              [&] { threads.push_back(std::this_thread::get_id()); });
+    graph.start(0);
+
+    // All the tasks are done when start() returns
+    ASSERT_EQ(threads.size(), 2);
+    EXPECT_EQ(threads[0], caller);
+    EXPECT_EQ(threads[1], caller);
+    EXPECT_EQ(graph.state("b"), State::Succeeded);
+    graph.mark("step");
+    graph.report();
+}
+
+TEST(InitGraph, InvalidTasks)
+{
+    InitGraph graph;
+    graph.add("a", {}, [] {});
+    EXPECT_THROW(graph.add("a", {}, [] {}), std::invalid_argument);
+    EXPECT_THROW(graph.add("b", {"unknown"}, [] {}), std::invalid_argument);
+}
@@ -37,3 +37,93 @@ TEST(InstanceId, testMarkfree)
     EXPECT_THROW(id.next(), std::runtime_error);
     EXPECT_THROW(id.markFree(32), std::out_of_range);
 }
+
+TEST(InstanceId, testExpire)
+{
+    InstanceId id;
+    EXPECT_FALSE(id.nextExpiry().has_value());
+    for (size_t i = 0; i < 4; ++i)
+    {
+        ASSERT_EQ(id.next(), i);
+    }
+    auto expiry = id.nextExpiry();
+    ASSERT_TRUE(expiry.has_value());
+
+    // The oldest ids expire first, freed ids are skipped
+    id.markFree(1);
+    EXPECT_EQ(id.expire(*expiry - std::chrono::seconds(1)), 0);
+    EXPECT_EQ(id.expire(*expiry + std::chrono::seconds(1)), 3);
+    EXPECT_FALSE(id.nextExpiry().has_value());
+    ASSERT_EQ(id.next(), 0);
+
+    const auto& stats = id.getStats();
+    EXPECT_EQ(stats.allocations, 5);
+    EXPECT_EQ(stats.expirations, 3);
+    EXPECT_EQ(stats.exhaustions, 0);
+}
+
+TEST(InstanceId, testOldestId)
+{
+    InstanceId id;
+    for (size_t i = 0; i < maxInstanceIds; ++i)
+    {
+        ASSERT_EQ(id.next(), i);
+    }
+    EXPECT_FALSE(id.returnOldestId().has_value());
+    EXPECT_THROW(id.next(), std::runtime_error);
+    EXPECT_EQ(id.getStats().exhaustions, 1);
+
+    id.markFree(0);
+    ASSERT_EQ(id.next(), 0);
+    EXPECT_EQ(id.expire(*id.nextExpiry() + std::chrono::seconds(1)),
+              maxInstanceIds);
+    ASSERT_EQ(id.next(), 0);
+    EXPECT_EQ(id.getStats().allocations, maxInstanceIds + 2);
+}
+
+TEST(InstanceId, testSuspendExpiry)
+{
+    InstanceId id;
+    for (size_t i = 0; i < 3; ++i)
+    {
+        ASSERT_EQ(id.next(), i);
+    }
+
+    // A suspended id does not expire
+    id.suspendExpiry(1);
+    auto expiry = id.nextExpiry();
+    ASSERT_TRUE(expiry.has_value());
+    EXPECT_EQ(id.expire(*expiry + std::chrono::seconds(1)), 2);
+    EXPECT_FALSE(id.nextExpiry().has_value());
+    ASSERT_EQ(id.next(), 0);
+    ASSERT_EQ(id.next(), 2);
+
+    // A resumed id expires again, a suspended id is freed as usual
+    id.resumeExpiry(1);
+    id.suspendExpiry(2);
+    id.markFree(2);
+    expiry = id.nextExpiry();
+    ASSERT_TRUE(expiry.has_value());
+    EXPECT_EQ(id.expire(*expiry + std::chrono::seconds(1)), 2);
+    EXPECT_FALSE(id.nextExpiry().has_value());
+    ASSERT_EQ(id.next(), 0);
+    EXPECT_THROW(id.suspendExpiry(32), std::out_of_range);
+}
+
+TEST(InstanceId, testSuspendedNotTakenOver)
+{
+    InstanceId id;
+    for (size_t i = 0; i < maxInstanceIds; ++i)
+    {
+        ASSERT_EQ(id.next(), i);
+    }
+    for (uint8_t i = 0; i < maxInstanceIds; ++i)
+    {
+        id.suspendExpiry(i);
+    }
+
+    // Without an id that can expire, none is taken over
+    EXPECT_FALSE(id.nextExpiry().has_value());
+    EXPECT_FALSE(id.returnOldestId().has_value());
+    EXPECT_THROW(id.next(), std::runtime_error);
+}
@@ -0,0 +1,176 @@
+#include "libpldm/base.h"
+
+#include "pldmd/invoker.hpp"
+#include "pldmd/replay.hpp"
+
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <sdeventplus/event.hpp>
+#include <sdeventplus/source/io.hpp>
+
+#include <sstream>
+#include <stdexcept>
+
+#include <gtest/gtest.h>
+
+using namespace pldm;
+using namespace pldm::replay;
+using namespace pldm::responder;
+
+namespace
+{
+
+constexpr Command getTID = 0x02;
+
+/** @brief Recorder dump, the records are in the order of the ring buffer and
+ *         the first slot was never written
+ */
+constexpr auto recorderDump =
+    " : Rx : \n"
+    "\n"
+    "2023-01-01 UTC 10:00:00.300000 : Rx : \n"
+    "09 01 83 00 03 \n"
+    "2023-01-01 UTC 10:00:00.100000 : Rx : \n"
+    "09 01 81 00 02 \n"
+    "2023-01-01 UTC 10:00:00.100250 : Tx : \n"
+    "01 00 02 00 \n"
+    "2023-01-01 UTC 10:00:00.200000 : Rx : \n"
+    "09 01 82 00 02 \n"
+    "2023-01-01 UTC 10:00:00.200250 : Tx : \n"
+    "02 00 02 01 \n"
+    "2023-01-01 UTC 10:00:00.250000 : Tx : \n"
+    "85 02 51 \n"
+    "2023-01-01 UTC 10:00:00.260000 : Rx : \n"
+    "09 01 05 02 51 00 \n";
+
+class TestHandler : public CmdHandler
+{
+  public:
+    TestHandler()
+    {
+        handlers.emplace(getTID,
+                         [](const pldm_msg* request, size_t /*reqMsgLen*/) {
+            return ccOnlyResponse(request, PLDM_SUCCESS);
+        });
+    }
+};
+
+} // namespace
+
+TEST(ParseRecorderDump, sortedByTime)
+{
+    std::istringstream dump(recorderDump);
+    auto records = parseRecorderDump(dump);
+    ASSERT_EQ(records.size(), 7);
+
+    EXPECT_FALSE(records[0].tx);
+    EXPECT_EQ(records[0].data, (Message{0x09, 0x01, 0x81, 0x00, 0x02}));
+    EXPECT_TRUE(records[1].tx);
+    EXPECT_EQ(records[1].timestamp - records[0].timestamp,
+              std::chrono::microseconds(250));
+    EXPECT_EQ(records[6].data, (Message{0x09, 0x01, 0x83, 0x00, 0x03}));
+}
+
+TEST(BuildCapture, pairRequestsAndResponses)
+{
+    std::istringstream dump(recorderDump);
+    auto capture = buildCapture(parseRecorderDump(dump));
+    ASSERT_EQ(capture.exchanges.size(), 3);
+
+    EXPECT_EQ(capture.exchanges[0].offset, std::chrono::microseconds(0));
+    EXPECT_EQ(capture.exchanges[0].expectedResponse,
+              (Message{0x01, 0x00, 0x02, 0x00}));
+    EXPECT_EQ(capture.exchanges[1].offset, std::chrono::milliseconds(100));
+    EXPECT_EQ(capture.exchanges[1].expectedResponse,
+              (Message{0x02, 0x00, 0x02, 0x01}));
+    EXPECT_EQ(capture.exchanges[2].offset, std::chrono::milliseconds(200));
+    EXPECT_TRUE(capture.exchanges[2].expectedResponse.empty());
+
+    ASSERT_EQ(capture.responses.size(), 1);
+    EXPECT_EQ(capture.responses.at({PLDM_PLATFORM, 0x51}).front(),
+              (Message{0x05, 0x02, 0x51, 0x00}));
+}
+
+TEST(Replayer, replayAgainstInvoker)
+{
+    int fds[2];
+    ASSERT_EQ(socketpair(AF_UNIX, SOCK_SEQPACKET, 0, fds), 0);
+    auto event = sdeventplus::Event::get_new();
+
+    Invoker invoker{};
+    invoker.registerHandler(PLDM_BASE, std::make_unique<TestHandler>());
+
+    // Responder side, serves the requests with the invoker and collects the
+    // responses to its own request
+    std::vector<Message> responses;
+    sdeventplus::source::IO responder(
+        event, fds[0], EPOLLIN,
+        [&invoker, &responses](sdeventplus::source::IO&, int fd,
+                               uint32_t /*revents*/) {
+        Message message(UINT16_MAX);
+        auto length = recv(fd, message.data(), message.size(), 0);
+        ASSERT_GT(length, 0);
+        message.resize(length);
+
+        auto msg = reinterpret_cast<const pldm_msg*>(message.data() + 2);
+        if (!msg->hdr.request)
+        {
+            responses.emplace_back(message);
+            return;
+        }
+        try
+        {
+            Message response(message.begin(), message.begin() + 2);
+            auto payload = invoker.handle(msg->hdr.type, msg->hdr.command, msg,
+                                          message.size() - 2 -
+                                              sizeof(pldm_msg_hdr));
+            response.insert(response.end(), payload.begin(), payload.end());
+            send(fd, response.data(), response.size(), 0);
+        }
+        catch (const std::out_of_range&)
+        {
+            // Unsupported command, let the request time out
+        }
+    });
+
+    // A request of the responder, answered from the capture
+    Message request{0x09, 0x01, 0x87, 0x02, 0x51};
+    ASSERT_EQ(send(fds[0], request.data(), request.size(), 0),
+              static_cast<ssize_t>(request.size()));
+
+    std::istringstream dump(recorderDump);
+    bool done = false;
+    Replayer replayer(event, fds[1], buildCapture(parseRecorderDump(dump)), 0,
+                      std::chrono::milliseconds(100), [&]() {
+        done = true;
+        event.exit(0);
+    });
+    replayer.start();
+    event.loop();
+
+    EXPECT_TRUE(done);
+    EXPECT_TRUE(replayer.finished());
+
+    ASSERT_EQ(responses.size(), 1);
+    EXPECT_EQ(responses[0], (Message{0x09, 0x01, 0x07, 0x02, 0x51, 0x00}));
+
+    auto report = replayer.report();
+    EXPECT_EQ(report["Requests"], 3);
+    EXPECT_EQ(report["UnansweredRequests"], 0);
+    ASSERT_EQ(report["Commands"].size(), 2);
+
+    const auto& tid = report["Commands"][0];
+    EXPECT_EQ(tid["Command"], getTID);
+    EXPECT_EQ(tid["Requests"], 2);
+    EXPECT_EQ(tid["Matched"], 1);
+    EXPECT_EQ(tid["Mismatched"], 1);
+    EXPECT_EQ(tid["Timeouts"], 0);
+
+    const auto& unsupported = report["Commands"][1];
+    EXPECT_EQ(unsupported["Requests"], 1);
+    EXPECT_EQ(unsupported["Timeouts"], 1);
+
+    close(fds[0]);
+    close(fds[1]);
+}
@@ -0,0 +1,89 @@
+#include "pldmd/dbus_impl_requester.hpp"
+#include "xyz/openbmc_project/Common/error.hpp"
+
+#include <sdbusplus/bus.hpp>
+#include <sdeventplus/event.hpp>
+
+#include <chrono>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using namespace pldm::dbus_api;
+using namespace sdbusplus::xyz::openbmc_project::Common::Error;
+using namespace std::chrono_literals;
+
+class RequesterTest : public testing::Test
+{
+  protected:
+    RequesterTest() :
+        bus(sdbusplus::bus::new_default()),
+        event(sdeventplus::Event::get_default()),
+        requester(bus, "/xyz/openbmc_project/pldm")
+    {}
+
+    /** @brief Run the event loop for a while */
+    void runFor(std::chrono::milliseconds duration)
+    {
+        auto end = std::chrono::steady_clock::now() + duration;
+        for (auto now = std::chrono::steady_clock::now(); now < end;
+             now = std::chrono::steady_clock::now())
+        {
+            sd_event_run(
+                event.get(),
+                std::chrono::duration_cast<std::chrono::microseconds>(end -
+                                                                      now)
+                    .count());
+        }
+    }
+
+    static constexpr uint8_t eid = 9;
+    sdbusplus::bus_t bus;
+    sdeventplus::Event event;
+    Requester requester;
+};
+
+TEST_F(RequesterTest, getInstanceIds)
+{
+    EXPECT_EQ(requester.getInstanceIds(eid, 3),
+              std::vector<uint8_t>({0, 1, 2}));
+    EXPECT_EQ(requester.getInstanceId(eid), 3);
+    EXPECT_EQ(requester.getInstanceIds(eid + 1, 2),
+              std::vector<uint8_t>({0, 1}));
+
+    EXPECT_THROW(requester.getInstanceIds(eid, 0), InvalidArgument);
+    EXPECT_THROW(requester.getInstanceIds(eid, maxBatchInstanceIds + 1),
+                 InvalidArgument);
+
+    // All or none of the instance ids are reserved
+    for (auto count = 0; count < 3; ++count)
+    {
+        EXPECT_EQ(requester.getInstanceIds(eid, maxBatchInstanceIds).size(),
+                  maxBatchInstanceIds);
+    }
+    EXPECT_THROW(requester.getInstanceIds(eid, 5), TooManyResources);
+    EXPECT_EQ(requester.getInstanceIds(eid, 4),
+              std::vector<uint8_t>({28, 29, 30, 31}));
+    EXPECT_THROW(requester.getInstanceId(eid), TooManyResources);
+
+    requester.markFree(eid, 2);
+    requester.markFree(eid, 30);
+    EXPECT_EQ(requester.getInstanceIds(eid, 2), std::vector<uint8_t>({2, 30}));
+    EXPECT_EQ(requester.getStats(eid).exhaustions, 2);
+}
+
+TEST_F(RequesterTest, expiryTimer)
+{
+    EXPECT_EQ(requester.getInstanceIds(eid, 2), std::vector<uint8_t>({0, 1}));
+    auto queued = requester.getInstanceId(eid);
+    requester.suspendExpiry(eid, queued);
+
+    // The timer releases the instance ids nobody freed, once the expiration
+    // interval and the grace period are over, but not the suspended one
+    runFor(std::chrono::seconds(INSTANCE_ID_EXPIRATION_INTERVAL) + 500ms);
+    EXPECT_EQ(requester.getStats(eid).expirations, 0);
+    runFor(1500ms);
+    EXPECT_EQ(requester.getStats(eid).expirations, 2);
+    EXPECT_EQ(requester.getInstanceIds(eid, 3),
+              std::vector<uint8_t>({0, 1, 3}));
+}